@@ -53,6 +53,17 @@
  * int  evIsContainer     (int type)
  * char *evPerror         (int error)
  * const char *evGetTypename (int type)
+ *
+ * Reentrant routines, on a caller owned context instead of a handle:
+ * int  evOpen_r          (char *filename, char *flags, EVFILE **ctx)
+ * int  evOpenBuffer_r    (char *buffer, int bufLen, char *flags, EVFILE **ctx)
+ * int  evOpenSocket_r    (int sockFd, char *flags, EVFILE **ctx)
+ * int  evRead_r          (EVFILE *ctx, uint32_t *buffer, int size)
+ * int  evReadAlloc_r     (EVFILE *ctx, uint32_t **buffer, int *buflen)
+ * int  evReadNoCopy_r    (EVFILE *ctx, const uint32_t **buffer, int *buflen)
+ * int  evWrite_r         (EVFILE *ctx, const uint32_t *buffer)
+ * int  evIoctl_r         (EVFILE *ctx, char *request, void *argp)
+ * int  evClose_r         (EVFILE *ctx)
  */
 
 
@@ -66,7 +77,7 @@
  * This structure contains information about file
  * opened for either reading or writing.
  */
-typedef struct evfilestruct {
+struct evfilestruct {
   FILE    *file;         /**< pointer to file. */
   uint32_t *buf;          /**< pointer to buffer of block being read/written. */
   uint32_t *next;         /**< pointer to next word in block to be read/written. */
@@ -104,7 +115,12 @@ typedef struct evfilestruct {
   /* dictionary */
   char *dictionary;      /**< xml format dictionary to either read or write. */
 
-} EVFILE;
+  /* swapping */
+  uint32_t *swapBuf;     /**< scratch buffer for events read from byte swapped data. */
+  int   swapBufSize;     /**< size of swapBuf in 32 bit words. */
+  int   lazySwap;        /**< if 1 only container headers of read events are swapped. */
+
+};
 
 
 /* A few items to make the code more readable */
@@ -295,6 +311,13 @@ typedef struct evfilestruct {
 
 /* Prototypes for static routines */
 static  int      evOpenImpl(char *srcDest, int bufLen, int sockFd, char *flags, int *handle);
+static  int      evOpenContext(char *srcDest, int bufLen, int sockFd, char *flags, EVFILE **ctx);
+static  int      evReadImpl(EVFILE *a, uint32_t *buffer, int buflen);
+static  int      evReadNoCopyImpl(EVFILE *a, const uint32_t **buffer, int *buflen);
+static  int      evWriteImpl(EVFILE *a, const uint32_t *buffer);
+static  int      evCloseImpl(EVFILE *a);
+static  int      evIoctlImpl(EVFILE *a, char *request, void *argp);
+static  int      evSwapBuffer(EVFILE *a, int words);
 static  int      evGetNewBuffer(EVFILE *a);
 static  int      evFlush(EVFILE *a);
 static  void     initBlockHeader(EVFILE *a);
@@ -634,17 +657,78 @@ int evOpenSocket(int sockFd, char *flags, int *handle)
  *                            (increase MAXHANDLES in evio.c and recompile)
  */
 static int evOpenImpl(char *srcDest, int bufLen, int sockFd, char *flags, int *handle)
+{
+    EVFILE *a;
+    int ihandle, status;
+
+    /* Check args */
+    if (handle == NULL) {
+        return(S_EVFILE_BADARG);
+    }
+    *handle = 0;
+
+    status = evOpenContext(srcDest, bufLen, sockFd, flags, &a);
+    if (status != S_SUCCESS) {
+        return(status);
+    }
+
+    for (ihandle=0; ihandle < MAXHANDLES; ihandle++) {
+        /* If a slot is available ... */
+        if (handle_list[ihandle] == 0) {
+            handle_list[ihandle] = a;
+            *handle = ihandle+1;
+            return(S_SUCCESS);
+        }
+    }
+
+    /* No slots left */
+    if (a->rw == EV_WRITEFILE || a->rw == EV_READFILE) {
+        fclose(a->file);
+    }
+    else if (a->rw == EV_WRITEPIPE || a->rw == EV_READPIPE) {
+        pclose(a->file);
+    }
+    if (a->dictionary != NULL) free(a->dictionary);
+    free(a->buf);
+    free(a);
+    return(S_EVFILE_BADHANDLE);        /* A better error code would help */
+}
+
+
+/**
+ * This routine does the work of the open routines: it allocates and
+ * initializes the structure of a file, buffer or socket opened for either
+ * reading or writing. The structure is owned by the caller and is not
+ * entered in the handle table.
+ *
+ * @param srcDest name of file if flags = "w" or "r";
+ *                pointer to buffer if flags = "wb" or "rb"
+ * @param bufLen  length of buffer (srcDest) if flags = "wb" or "rb"
+ * @param sockFd  socket file descriptor if flags = "ws" or "rs"
+ * @param flags   pointer to case-independent string of "w", "r", "wb", "rb", "ws", or "rs"
+ * @param ctx     pointer which gets filled with the structure
+ *
+ * @return S_SUCCESS          if successful
+ * @return S_EVFILE_BADARG    if flags or ctx arg is NULL; unrecognizable flags;
+ *                            buffer size too small when using buffer
+ * @return S_EVFILE_ALLOCFAIL if memory allocation failed
+ * @return S_EVFILE_BADFILE   if error reading file, unsupported version,
+ *                            or contradictory data in file
+ * @return errno              if file could not be opened (handle = 0)
+ */
+static int evOpenContext(char *srcDest, int bufLen, int sockFd, char *flags, EVFILE **ctx)
 {
     EVFILE *a;
     char *filename, *buffer;
     int useFile=0, useBuffer=0, useSocket=0, reading=0;
-    int i, nBytes, rwBufSize, blk_size, hdr_size, version, ihandle, bytesToRead;
+    int i, nBytes, rwBufSize, blk_size, hdr_size, version, bytesToRead;
     int32_t temp, header[EV_HDSIZ], headerInfo;
 
     /* Check args */
-    if (flags == NULL || handle == NULL) {
+    if (flags == NULL || ctx == NULL) {
         return(S_EVFILE_BADARG);
     }
+    *ctx = NULL;
 
     
     /* Are we dealing with a file, buffer, or socket? */
@@ -740,7 +824,6 @@ static int evOpenImpl(char *srcDest, int bufLen, int sockFd, char *flags, int *h
                 fprintf(stderr,"evOpen: Error opening file %s, flag %s\n", filename,flags);
                 perror(NULL);
 #endif
-                *handle = 0;
                 free(filename);
                 return(errno);
             }
@@ -1004,7 +1087,6 @@ printf("HAVE DICTIONARY\n");
                 fprintf(stderr,"evOpen: Error opening file %s, flag %s\n", filename,flags);
                 perror(NULL);
 #endif
-                *handle = 0;
                 free(filename);
                 return(errno);
             }
@@ -1065,32 +1147,11 @@ printf("HAVE DICTIONARY\n");
     /* Store general info in handle structure */
     a->blknum = a->buf[EV_HD_BLKNUM];
 
-    for (ihandle=0; ihandle < MAXHANDLES; ihandle++) {
-        /* If a slot is available ... */
-        if (handle_list[ihandle] == 0) {
-            handle_list[ihandle] = a;
-            *handle = ihandle+1;
-            if (useFile) {
-                free(filename);
-            }
-            return(S_SUCCESS);
-        }
-    }
-
-    /* No slots left */
-    *handle = 0;
     if (useFile) {
-        if (a->rw == EV_WRITEFILE || a->rw == EV_READFILE) {
-            fclose(a->file);
-        }
-        else if (a->rw == EV_WRITEPIPE || a->rw == EV_READPIPE) {
-            pclose(a->file);
-        }
         free(filename);
     }
-    free(a->buf);
-    free(a);
-    return(S_EVFILE_BADHANDLE);        /* A better error code would help */
+    *ctx = a;
+    return(S_SUCCESS);
 }
 
 
@@ -1454,7 +1515,12 @@ static int evReadAllocImpl(EVFILE *a, uint32_t **buffer, int *buflen)
 
     /* Swap event in place if necessary */
     if (a->byte_swapped) {
-        evioswap(buf, 1, NULL);
+        if (a->lazySwap) {
+            evioswap_headers(buf, 1, NULL);
+        }
+        else {
+            evioswap(buf, 1, NULL);
+        }
     }
 
     /* Return allocated buffer with event inside and its inclusive len (with full header) */
@@ -1541,9 +1607,6 @@ int evread_
 int evRead(int handle, uint32_t *buffer, int buflen)
 {
     EVFILE *a;
-    int     nleft, ncopy, error, status;
-    uint32_t *temp_buffer, *temp_ptr=NULL;
-
 
     if (buffer == NULL || buflen < 3) {
         return(S_EVFILE_BADARG);
@@ -1557,6 +1620,61 @@ int evRead(int handle, uint32_t *buffer, int buflen)
         return(S_EVFILE_BADHANDLE);
     }
 
+    return evReadImpl(a, buffer, buflen);
+}
+
+
+/**
+ * Make the swap scratch buffer of a file structure hold at least the given
+ * number of words. The buffer is kept until the structure is closed.
+ *
+ * @param a     pointer file structure
+ * @param words number of 32 bit words needed
+ *
+ * @return S_SUCCESS          if successful
+ * @return S_EVFILE_ALLOCFAIL if memory cannot be allocated
+ */
+static int evSwapBuffer(EVFILE *a, int words)
+{
+    uint32_t *newBuf;
+
+    if (a->swapBufSize >= words) {
+        return(S_SUCCESS);
+    }
+
+    newBuf = (uint32_t *) malloc(words*sizeof(uint32_t));
+    if (newBuf == NULL) {
+        return(S_EVFILE_ALLOCFAIL);
+    }
+    if (a->swapBuf != NULL) free(a->swapBuf);
+    a->swapBuf = newBuf;
+    a->swapBufSize = words;
+
+    return(S_SUCCESS);
+}
+
+
+/**
+ * This routine does the work of {@link evRead} and {@link evRead_r}.
+ * Byte swapped events are assembled in the swap scratch buffer of the
+ * file structure and swapped from there into the caller's buffer.
+ *
+ * @param a      pointer file structure
+ * @param buffer pointer to buffer
+ * @param buflen length of buffer in 32 bit words
+ *
+ * @return see {@link evRead}
+ */
+static int evReadImpl(EVFILE *a, uint32_t *buffer, int buflen)
+{
+    int     nleft, ncopy, status;
+    uint32_t *temp_buffer = NULL;
+
+
+    if (buffer == NULL || buflen < 3) {
+        return(S_EVFILE_BADARG);
+    }
+
     /* Check magic # */
     if (a->magic != EV_MAGIC) {
         return(S_EVFILE_BADHANDLE);
@@ -1578,9 +1696,6 @@ int evRead(int handle, uint32_t *buffer, int buflen)
 
     /* Find number of words to read in next event (including header) */
     if (a->byte_swapped) {
-        /* Create temp buffer for swapping */
-        temp_ptr = temp_buffer = (uint32_t *) malloc(buflen*sizeof(uint32_t));
-        if (temp_ptr == NULL) return(S_EVFILE_ALLOCFAIL);
         /* Value at pointer to next event (bank) header = length of bank - 1 */
         nleft = EVIO_SWAP32(*(a->next)) + 1;
     }
@@ -1593,10 +1708,18 @@ int evRead(int handle, uint32_t *buffer, int buflen)
     if (nleft > buflen) {
         /* Buffer too small, just return error.
          * Previous evio lib tried to swap truncated event!? */
-        if (temp_ptr != NULL) free(temp_ptr);
         return(S_EVFILE_TRUNC);
     }
 
+    /* Swapped events are put together in the scratch buffer first */
+    if (a->byte_swapped) {
+        status = evSwapBuffer(a, nleft);
+        if (status != S_SUCCESS) {
+            return(status);
+        }
+        temp_buffer = a->swapBuf;
+    }
+
     /* While there is more event data left to read ... */
     while (nleft > 0) {
 
@@ -1604,7 +1727,6 @@ int evRead(int handle, uint32_t *buffer, int buflen)
         if (a->left <= 0) {
             status = evGetNewBuffer(a);
             if (status != S_SUCCESS) {
-                if (temp_ptr != NULL) free(temp_ptr);
                 return(status);
             }
         }
@@ -1630,8 +1752,12 @@ int evRead(int handle, uint32_t *buffer, int buflen)
 
     /* Swap event if necessary */
     if (a->byte_swapped) {
-        evioswap((uint32_t*)temp_ptr, 1, (uint32_t*)buffer);
-        free(temp_ptr);
+        if (a->lazySwap) {
+            evioswap_headers(a->swapBuf, 1, buffer);
+        }
+        else {
+            evioswap(a->swapBuf, 1, buffer);
+        }
     }
     
     return(S_SUCCESS);
@@ -1641,11 +1767,10 @@ int evRead(int handle, uint32_t *buffer, int buflen)
 /**
  * This routine reads from an evio format file/buffer/socket opened with routine
  * {@link evOpen} and returns a pointer to the next event residing in an internal buffer.
- * If the data needs to be swapped, it is stored in a static buffer. Thus any other
- * call to read routines will cause the swapped data to be overwritten.
+ * If the data needs to be swapped, it is stored in a scratch buffer of the handle.
+ * Thus any other call to read routines will cause the swapped data to be overwritten.
  * No writing to the returned pointer is allowed.
  * Works only with evio version 4 and up. A status is returned.
- * NOTE: a bug is that the last event read which needs swapping, does NOT get freed
  *
  * @param handle evio handle
  * @param buffer pointer to pointer to buffer gets filled with pointer to location in
@@ -1671,13 +1796,6 @@ int evRead(int handle, uint32_t *buffer, int buflen)
 int evReadNoCopy(int handle, const uint32_t **buffer, int *buflen)
 {
     EVFILE *a;
-    int     nleft, status;
-    static uint32_t *tempBuf = NULL;
-
-
-    if (buffer == NULL || buflen == NULL) {
-        return(S_EVFILE_BADARG);
-    }
 
     /* Look up file struct (which contains block buffer) from handle */
     a = handle_list[handle-1];
@@ -1687,6 +1805,29 @@ int evReadNoCopy(int handle, const uint32_t **buffer, int *buflen)
         return(S_EVFILE_BADHANDLE);
     }
 
+    return evReadNoCopyImpl(a, buffer, buflen);
+}
+
+
+/**
+ * This routine does the work of {@link evReadNoCopy} and {@link evReadNoCopy_r}.
+ * Swapped events go to the swap scratch buffer of the file structure.
+ *
+ * @param a      pointer file structure
+ * @param buffer pointer to pointer to buffer gets filled with pointer to the event
+ * @param buflen pointer to int gets filled with length of buffer in 32 bit words
+ *
+ * @return see {@link evReadNoCopy}
+ */
+static int evReadNoCopyImpl(EVFILE *a, const uint32_t **buffer, int *buflen)
+{
+    int     nleft, status;
+
+
+    if (buffer == NULL || buflen == NULL) {
+        return(S_EVFILE_BADARG);
+    }
+
     /* Returning a pointer into a block only works in evio version 4 and
      * up since in earlier versions events may be split between blocks. */
     if (a->version < 4) {
@@ -1712,26 +1853,27 @@ int evReadNoCopy(int handle, const uint32_t **buffer, int *buflen)
         }
     }
 
-    /* Get rid of the last event read in & swapped. */
-    if (tempBuf != NULL) {
-        free(tempBuf);
-        tempBuf = NULL;
-    }
-
     /* Find number of words to read in next event (including header) */
     if (a->byte_swapped) {
         /* Length of next bank, including header, in 32 bit words */
         nleft = EVIO_SWAP32(*(a->next)) + 1;
         
-        /* Create temp buffer for swapping */
-        tempBuf = (uint32_t *) malloc(nleft*sizeof(uint32_t));
-        if (tempBuf == NULL) return(S_EVFILE_ALLOCFAIL);
+        /* Make room in the scratch buffer for swapping */
+        status = evSwapBuffer(a, nleft);
+        if (status != S_SUCCESS) {
+            return(status);
+        }
                 
         /* swap data into buffer */
-        evioswap(a->next, 1, tempBuf);
+        if (a->lazySwap) {
+            evioswap_headers(a->next, 1, a->swapBuf);
+        }
+        else {
+            evioswap(a->next, 1, a->swapBuf);
+        }
 
-        /* return location of this temp buffer */
-        *buffer = tempBuf;
+        /* return location of the scratch buffer */
+        *buffer = a->swapBuf;
     }
     else {
         /* Length of next bank, including header, in 32 bit words */
@@ -2043,7 +2185,6 @@ int evwrite_
 int evWrite(int handle, const uint32_t *buffer)
 {
     EVFILE *a;
-    int     nToWrite, ncopy, status;
     
     /* Look up file struct (which contains block buffer) from handle */
     a = handle_list[handle-1];
@@ -2053,6 +2194,22 @@ int evWrite(int handle, const uint32_t *buffer)
         return(S_EVFILE_BADHANDLE);
     }
 
+    return evWriteImpl(a, buffer);
+}
+
+
+/**
+ * This routine does the work of {@link evWrite} and {@link evWrite_r}.
+ *
+ * @param a      pointer file structure
+ * @param buffer pointer to buffer containing event to write
+ *
+ * @return see {@link evWrite}
+ */
+static int evWriteImpl(EVFILE *a, const uint32_t *buffer)
+{
+    int     nToWrite, ncopy, status;
+
     if (buffer == NULL) {
         return(S_EVFILE_BADARG);
     }
@@ -2279,6 +2436,10 @@ int evioctl_
  * It returns the version number if request arg = v or V.<p>
  * It changes the maximum number of events/block if request arg = n or N,
  * used only in version 4.<p>
+ * It turns lazy swapping of read events on (1) or off (0) if request arg = l or L:
+ * events of byte swapped data then have only their container headers swapped,
+ * and the reader swaps the leaf data it uses with evioswap_data().<p>
+ * It returns 1 if the data read is byte swapped, else 0, if request arg = e or E.<p>
  * It returns a pointer to the 8 block header ints if request arg = h or H.
  * This pointer must be freed by the caller to avoid a memory leak.
  * Used only in version 4.<p>
@@ -2288,10 +2449,14 @@ int evioctl_
  *                "v" or "V" for getting evio version #;
  *                "n" or "N" for setting max # of events/block;
  *                "h" or "H" for getting 8 ints of block header info;
+ *                "l" or "L" for setting lazy swapping of read events;
+ *                "e" or "E" for getting whether the data read is byte swapped;
  * @param argp    pointer to 32 bit int:
  *                  1) containing new block size if request = b or B, or
  *                  2) containing new max number of events/block if request = n or N, or
  *                  3) returning version # if request = v or V, or
+ *                  5) containing 1 or 0 to turn lazy swapping on or off if request = l or L, or
+ *                  6) returning 1 if the data is byte swapped, else 0, if request = e or E, or
  *                address of pointer to 32 bit int:
  *                  4) returning pointer to 8 ints of block header if request = h or H.
  *                     This pointer must be freed by caller since it points
@@ -2310,8 +2475,6 @@ int evioctl_
 int evIoctl(int handle, char *request, void *argp)
 {
     EVFILE *a;
-    uint32_t *newBuf, *pHeader;
-    int eventsMax, blockSize;
 
     /* Look up file struct from handle */
     a = handle_list[handle-1];
@@ -2320,7 +2483,25 @@ int evIoctl(int handle, char *request, void *argp)
     if (a == NULL) {
         return(S_EVFILE_BADHANDLE);
     }
-    
+
+    return(evIoctlImpl(a, request, argp));
+}
+
+
+/**
+ * This routine does the work of {@link evIoctl} and {@link evIoctl_r}.
+ *
+ * @param a       pointer file structure
+ * @param request see {@link evIoctl}
+ * @param argp    see {@link evIoctl}
+ *
+ * @return see {@link evIoctl}
+ */
+static int evIoctlImpl(EVFILE *a, char *request, void *argp)
+{
+    uint32_t *newBuf, *pHeader;
+    int eventsMax, blockSize;
+
     if (request == NULL) {
         return(S_EVFILE_BADARG);
     }
@@ -2447,6 +2628,30 @@ int evIoctl(int handle, char *request, void *argp)
             a->eventsMax = eventsMax;
             break;
 
+            /****************************/
+            /* Setting lazy swap mode   */
+            /****************************/
+        case 'l':
+        case 'L':
+            if (argp == NULL) {
+                return(S_EVFILE_BADARG);
+            }
+
+            a->lazySwap = (*(int *) argp != 0);
+            break;
+
+            /****************************/
+            /* Getting swapped state    */
+            /****************************/
+        case 'e':
+        case 'E':
+            if (argp == NULL) {
+                return(S_EVFILE_BADARG);
+            }
+
+            *((int32_t *) argp) = a->byte_swapped;
+            break;
+
         default:
             return(S_EVFILE_UNKOPTION);
     }
@@ -2660,7 +2865,7 @@ int evclose_
 int evClose(int handle)
 {
     EVFILE *a;
-    int status = S_SUCCESS, status2 = S_SUCCESS;
+    int status;
     
     /* Look up file struct from handle */
     a = handle_list[handle-1];
@@ -2670,6 +2875,27 @@ int evClose(int handle)
         return(S_EVFILE_BADHANDLE);
     }
 
+    status = evCloseImpl(a);
+    if (status != S_EVFILE_BADHANDLE) {
+        handle_list[handle-1] = 0;
+    }
+    return(status);
+}
+
+
+/**
+ * This routine does the work of {@link evClose} and {@link evClose_r}:
+ * it flushes any data being written, closes the file and frees the
+ * file structure.
+ *
+ * @param a pointer file structure
+ *
+ * @return see {@link evClose}
+ */
+static int evCloseImpl(EVFILE *a)
+{
+    int status = S_SUCCESS, status2 = S_SUCCESS;
+
     /* Check magic # */
     if (a->magic != EV_MAGIC) {
         return(S_EVFILE_BADHANDLE);
@@ -2697,9 +2923,9 @@ int evClose(int handle)
     }
 
     /* Free up resources */
-    handle_list[handle-1] = 0;
     if (a->buf != NULL) free((void *)(a->buf));
     if (a->dictionary != NULL) free(a->dictionary);
+    if (a->swapBuf != NULL) free(a->swapBuf);
     free((void *)a);
     
     if (status == S_SUCCESS) {
@@ -2710,6 +2936,195 @@ int evClose(int handle)
 }
 
 
+/**
+ * Reentrant version of {@link evOpen}: the file is opened into a structure
+ * owned by the caller instead of the handle table, so there is no limit on
+ * the number of open files and different structures can be used from
+ * different threads. Every call with the structure must come from one
+ * thread at a time; it is freed by {@link evClose_r}.
+ *
+ * @param filename name of file
+ * @param flags    pointer to case-independent string of "w" for writing
+ *                 or "r" for reading
+ * @param ctx      pointer which gets filled with the file structure
+ *
+ * @return see {@link evOpen}
+ */
+int evOpen_r(char *filename, char *flags, EVFILE **ctx)
+{
+    if (strcasecmp(flags, "w") != 0 && strcasecmp(flags, "r") != 0) {
+        return(S_EVFILE_BADARG);
+    }
+    return(evOpenContext(filename, 0, 0, flags, ctx));
+}
+
+
+/**
+ * Reentrant version of {@link evOpenBuffer}.
+ *
+ * @param buffer pointer to buffer
+ * @param bufLen length of buffer in 32 bit ints
+ * @param flags  pointer to case-independent string of "w" or "r"
+ * @param ctx    pointer which gets filled with the file structure
+ *
+ * @return see {@link evOpenBuffer}
+ */
+int evOpenBuffer_r(char *buffer, int bufLen, char *flags, EVFILE **ctx)
+{
+    char *flag;
+
+    /* Convert flags to internal use */
+    if (strcasecmp(flags, "w") == 0) {
+        flag = "wb";
+    }
+    else if (strcasecmp(flags, "r") == 0) {
+        flag = "rb";
+    }
+    else {
+        return(S_EVFILE_BADARG);
+    }
+
+    return(evOpenContext(buffer, bufLen, 0, flag, ctx));
+}
+
+
+/**
+ * Reentrant version of {@link evOpenSocket}.
+ *
+ * @param sockFd socket file descriptor
+ * @param flags  pointer to case-independent string of "w" or "r"
+ * @param ctx    pointer which gets filled with the file structure
+ *
+ * @return see {@link evOpenSocket}
+ */
+int evOpenSocket_r(int sockFd, char *flags, EVFILE **ctx)
+{
+    char *flag;
+
+    /* Convert flags to internal use */
+    if (strcasecmp(flags, "w") == 0) {
+        flag = "ws";
+    }
+    else if (strcasecmp(flags, "r") == 0) {
+        flag = "rs";
+    }
+    else {
+        return(S_EVFILE_BADARG);
+    }
+
+    return(evOpenContext(NULL, 0, sockFd, flag, ctx));
+}
+
+
+/**
+ * Reentrant version of {@link evRead}. Byte swapped events are put together
+ * in a scratch buffer of the structure, nothing is allocated per event.
+ *
+ * @param ctx    file structure from {@link evOpen_r}
+ * @param buffer pointer to buffer
+ * @param buflen length of buffer in 32 bit words
+ *
+ * @return see {@link evRead}
+ */
+int evRead_r(EVFILE *ctx, uint32_t *buffer, int buflen)
+{
+    if (ctx == NULL) {
+        return(S_EVFILE_BADHANDLE);
+    }
+    return(evReadImpl(ctx, buffer, buflen));
+}
+
+
+/**
+ * Reentrant version of {@link evReadAlloc}.
+ *
+ * @param ctx    file structure from {@link evOpen_r}
+ * @param buffer pointer to pointer to buffer gets filled with
+ *               pointer to allocated buffer (caller must free)
+ * @param buflen pointer to int gets filled with length of buffer in 32 bit words
+ *
+ * @return see {@link evReadAlloc}
+ */
+int evReadAlloc_r(EVFILE *ctx, uint32_t **buffer, int *buflen)
+{
+    if (ctx == NULL) {
+        return(S_EVFILE_BADHANDLE);
+    }
+    return(evReadAllocImpl(ctx, buffer, buflen));
+}
+
+
+/**
+ * Reentrant version of {@link evReadNoCopy}. The returned pointer is valid
+ * until the next read with the same structure.
+ *
+ * @param ctx    file structure from {@link evOpen_r}
+ * @param buffer pointer to pointer to buffer gets filled with pointer to the event
+ * @param buflen pointer to int gets filled with length of buffer in 32 bit words
+ *
+ * @return see {@link evReadNoCopy}
+ */
+int evReadNoCopy_r(EVFILE *ctx, const uint32_t **buffer, int *buflen)
+{
+    if (ctx == NULL) {
+        return(S_EVFILE_BADHANDLE);
+    }
+    return(evReadNoCopyImpl(ctx, buffer, buflen));
+}
+
+
+/**
+ * Reentrant version of {@link evWrite}.
+ *
+ * @param ctx    file structure from {@link evOpen_r}
+ * @param buffer pointer to buffer containing event to write
+ *
+ * @return see {@link evWrite}
+ */
+int evWrite_r(EVFILE *ctx, const uint32_t *buffer)
+{
+    if (ctx == NULL) {
+        return(S_EVFILE_BADHANDLE);
+    }
+    return(evWriteImpl(ctx, buffer));
+}
+
+
+/**
+ * Reentrant version of {@link evIoctl}.
+ *
+ * @param ctx     file structure from one of the evOpen*_r routines
+ * @param request see {@link evIoctl}
+ * @param argp    see {@link evIoctl}
+ *
+ * @return see {@link evIoctl}
+ */
+int evIoctl_r(EVFILE *ctx, char *request, void *argp)
+{
+    if (ctx == NULL) {
+        return(S_EVFILE_BADHANDLE);
+    }
+    return(evIoctlImpl(ctx, request, argp));
+}
+
+
+/**
+ * Reentrant version of {@link evClose}: flushes any data being written,
+ * closes the file and frees the structure.
+ *
+ * @param ctx file structure from {@link evOpen_r}
+ *
+ * @return see {@link evClose}
+ */
+int evClose_r(EVFILE *ctx)
+{
+    if (ctx == NULL) {
+        return(S_EVFILE_BADHANDLE);
+    }
+    return(evCloseImpl(ctx));
+}
+
+
 /**
  * This routine returns a string representation of an evio type.
  *
@@ -71,6 +71,8 @@ extern "C" {
 
 void set_user_frag_select_func( int32_t (*f) (int32_t tag) );
 void evioswap(uint32_t *buffer, int tolocal, uint32_t *dest);
+void evioswap_headers(uint32_t *buffer, int tolocal, uint32_t *dest);
+void evioswap_data(uint32_t *data, int type, int length, int tolocal, uint32_t *dest);
 
 int evOpen(char *filename, char *flags, int *handle);
 int evOpenBuffer(char *buffer, int bufLen, char *flags, int *handle);
@@ -88,6 +90,21 @@ int evGetBufferLength(int handle, int *length);
 int evGetDictionary(int handle, char **dictionary, int *len);
 int evWriteDictionary(int handle, char *xmlDictionary);
 
+/* Reentrant interface: the structure of an open file is owned by the caller
+ * instead of being kept in a global handle table. Different structures
+ * share no state and can be used from different threads. */
+typedef struct evfilestruct EVFILE;
+
+int evOpen_r(char *filename, char *flags, EVFILE **ctx);
+int evOpenBuffer_r(char *buffer, int bufLen, char *flags, EVFILE **ctx);
+int evOpenSocket_r(int sockFd, char *flags, EVFILE **ctx);
+int evRead_r(EVFILE *ctx, uint32_t *buffer, int size);
+int evReadAlloc_r(EVFILE *ctx, uint32_t **buffer, int *buflen);
+int evReadNoCopy_r(EVFILE *ctx, const uint32_t **buffer, int *buflen);
+int evWrite_r(EVFILE *ctx, const uint32_t *buffer);
+int evIoctl_r(EVFILE *ctx, char *request, void *argp);
+int evClose_r(EVFILE *ctx);
+
 int evIsContainer(int type);
 const char *evGetTypename(int type);
 char *evPerror(int error);
@@ -8,6 +8,9 @@
  *   swap_int2_t_val() swaps one int32_t, call by val
  *   swap_int32_t() swaps an array of uint32_t's
  *
+ *   evioswap_headers() swaps only the container headers of an event, leaving
+ *       the leaf data to be swapped on access with evioswap_data()
+ *
  *   thread safe
  *
  *
@@ -26,6 +29,11 @@
  *      - simplify swapping routines
  *      - make compatible with evio version 4 (padding info in data type)
  *
+ *   10/19/2026
+ *      - swap contiguous 16, 32 and 64 bit data with SSSE3/AVX2 byte shuffles
+ *        when the cpu has them, chosen once at load time
+ *      - add header only swapping for readers that touch a few banks
+ *
  */
 
 
@@ -72,6 +80,11 @@
 #include <stdlib.h>
 #include <stdio.h>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define EVIO_SWAP_SIMD
+#include <immintrin.h>
+#endif
+
 
 // from Sergey's composite swap library
 int eviofmt(char *fmt, unsigned char *ifmt, int ifmtLen);
@@ -81,15 +94,18 @@ int eviofmtswap(int *iarr, int nwrd, unsigned char *ifmt, int nfmt, int tolocal)
 
 /* entry points */
 void evioswap(uint32_t *buffer, int tolocal, uint32_t*dest);
+void evioswap_headers(uint32_t *buffer, int tolocal, uint32_t *dest);
+void evioswap_data(uint32_t *data, int type, int length, int tolocal, uint32_t *dest);
 int32_t swap_int32_t_value(int32_t val);
 uint32_t *swap_int32_t(uint32_t *data, unsigned int length, uint32_t *dest);
 
 
 /* internal prototypes */
-static void swap_bank(uint32_t *buf, int tolocal, uint32_t *dest);
-static void swap_segment(uint32_t *buf, int tolocal, uint32_t *dest);
-static void swap_tagsegment(uint32_t *buf, int tolocal, uint32_t *dest);
-static void swap_data(uint32_t *data, int type, int length, int tolocal, uint32_t *dest);
+static void swap_bank(uint32_t *buf, int tolocal, uint32_t *dest, int leaves);
+static void swap_segment(uint32_t *buf, int tolocal, uint32_t *dest, int leaves);
+static void swap_tagsegment(uint32_t *buf, int tolocal, uint32_t *dest, int leaves);
+static void swap_data(uint32_t *data, int type, int length, int tolocal, uint32_t *dest, int leaves);
+static unsigned int swap_bytes_fast(const void *data, void *dest, unsigned int bytes, int width);
 static void swap_int64_t(uint64_t *data, int length, uint64_t *dest);
 static void swap_short(uint16_t *data, int length, uint16_t *dest);
 static void copy_data(uint32_t *data, int length, uint32_t *dest);
@@ -98,6 +114,109 @@ static void swap_composite_t(uint32_t *data, int tolocal, uint32_t *dest);
 
 /*--------------------------------------------------------------------------*/
 
+
+#ifdef EVIO_SWAP_SIMD
+
+/** Byte shuffle masks reversing the bytes of each 16, 32 or 64 bit word of 16 bytes. */
+static const unsigned char swap_masks[3][16] = {
+    { 1,0, 3,2, 5,4, 7,6, 9,8, 11,10, 13,12, 15,14 },
+    { 3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12 },
+    { 7,6,5,4,3,2,1,0, 15,14,13,12,11,10,9,8 }
+};
+
+/** Widest byte shuffle of this cpu: 0 none, 1 SSSE3 (16 bytes), 2 AVX2 (32 bytes). */
+static int swap_simd_level = 0;
+
+/**
+ * Pick the byte shuffle for this cpu once, when the library is loaded,
+ * so the swap routines stay thread safe.
+ */
+__attribute__((constructor)) static void swap_simd_init(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        swap_simd_level = 2;
+    }
+    else if (__builtin_cpu_supports("ssse3")) {
+        swap_simd_level = 1;
+    }
+}
+
+
+/**
+ * Swap whole 16 byte blocks with pshufb.
+ *
+ * @param data   bytes to be swapped
+ * @param dest   where swapped bytes go, may be data
+ * @param blocks number of 16 byte blocks
+ * @param mask   one of swap_masks
+ */
+__attribute__((target("ssse3")))
+static void swap_blocks_ssse3(const unsigned char *data, unsigned char *dest,
+                              unsigned int blocks, const unsigned char *mask) {
+
+    unsigned int i;
+    __m128i m = _mm_loadu_si128((const __m128i *) mask);
+
+    for (i=0; i < blocks; i++) {
+        __m128i v = _mm_loadu_si128((const __m128i *) (data + 16*i));
+        _mm_storeu_si128((__m128i *) (dest + 16*i), _mm_shuffle_epi8(v, m));
+    }
+}
+
+
+/**
+ * Swap whole 32 byte blocks with vpshufb.
+ *
+ * @param data   bytes to be swapped
+ * @param dest   where swapped bytes go, may be data
+ * @param blocks number of 32 byte blocks
+ * @param mask   one of swap_masks
+ */
+__attribute__((target("avx2")))
+static void swap_blocks_avx2(const unsigned char *data, unsigned char *dest,
+                             unsigned int blocks, const unsigned char *mask) {
+
+    unsigned int i;
+    __m256i m = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *) mask));
+
+    for (i=0; i < blocks; i++) {
+        __m256i v = _mm256_loadu_si256((const __m256i *) (data + 32*i));
+        _mm256_storeu_si256((__m256i *) (dest + 32*i), _mm256_shuffle_epi8(v, m));
+    }
+}
+
+#endif
+
+
+/**
+ * Swap as much of a buffer as the cpu's byte shuffle allows, in whole
+ * blocks of 16 or 32 bytes. The caller swaps the remaining words.
+ *
+ * @param data  pointer to data to be swapped
+ * @param dest  pointer to where swapped data goes, may be data
+ * @param bytes number of bytes in the buffer
+ * @param width word size in bytes: 2, 4 or 8
+ * @return number of bytes swapped
+ */
+static unsigned int swap_bytes_fast(const void *data, void *dest, unsigned int bytes, int width) {
+
+#ifdef EVIO_SWAP_SIMD
+    const unsigned char *mask = swap_masks[(width == 2) ? 0 : (width == 4) ? 1 : 2];
+
+    if (swap_simd_level == 2) {
+        swap_blocks_avx2((const unsigned char *) data, (unsigned char *) dest, bytes/32, mask);
+        return((bytes/32)*32);
+    }
+    if (swap_simd_level == 1) {
+        swap_blocks_ssse3((const unsigned char *) data, (unsigned char *) dest, bytes/16, mask);
+        return((bytes/16)*16);
+    }
+#endif
+    return(0);
+}
+
+
+
 /**
  * Routine to swap the endianness of an evio event (bank).
  *
@@ -109,7 +228,49 @@ static void swap_composite_t(uint32_t *data, int tolocal, uint32_t *dest);
  */
 void evioswap(uint32_t *buf, int tolocal, uint32_t *dest) {
 
-  swap_bank(buf, tolocal, dest);
+  swap_bank(buf, tolocal, dest, 1);
+
+  return;
+}
+
+
+
+/**
+ * Routine to swap only the container headers of an evio event (bank).
+ * The data of the leaf banks, segments and tagsegments are copied to dest
+ * (or left in place) unswapped, to be swapped with {@link evioswap_data}
+ * by readers that only look at a few of them.
+ *
+ * @param buf     buffer of evio event data to be swapped
+ * @param tolocal if 0 buf contains data of same endian as local host,
+ *                else buf has data of opposite endian
+ * @param dest    buffer to place swapped data into.
+ *                If this is NULL, then dest = buf.
+ */
+void evioswap_headers(uint32_t *buf, int tolocal, uint32_t *dest) {
+
+  swap_bank(buf, tolocal, dest, 0);
+
+  return;
+}
+
+
+
+/**
+ * Routine to swap the data of one leaf bank, segment or tagsegment,
+ * for events swapped with {@link evioswap_headers}.
+ *
+ * @param data    data following the header
+ * @param type    evio type of the data, from the header
+ * @param length  length of the data in 32 bit words
+ * @param tolocal if 0 data is of same endian as local host,
+ *                else data is of opposite endian
+ * @param dest    buffer to place swapped data into.
+ *                If this is NULL, then dest = data.
+ */
+void evioswap_data(uint32_t *data, int type, int length, int tolocal, uint32_t *dest) {
+
+  swap_data(data, type & 0x3f, length, tolocal, dest, 1);
 
   return;
 }
@@ -124,8 +285,9 @@ void evioswap(uint32_t *buf, int tolocal, uint32_t *dest) {
  *                else buf has data of opposite endian
  * @param dest    buffer to place swapped data into.
  *                If this is NULL, then dest = buf.
+ * @param leaves  if 0 only container headers are swapped
  */
-static void swap_bank(uint32_t *buf, int tolocal, uint32_t *dest) {
+static void swap_bank(uint32_t *buf, int tolocal, uint32_t *dest, int leaves) {
 
     uint32_t data_length, data_type;
     uint32_t *p=buf;
@@ -144,7 +306,7 @@ static void swap_bank(uint32_t *buf, int tolocal, uint32_t *dest) {
     }
     
     /* Swap non-header bank data */
-    swap_data(&buf[2], data_type, data_length, tolocal, ((dest==NULL) ? NULL: &dest[2]));
+    swap_data(&buf[2], data_type, data_length, tolocal, ((dest==NULL) ? NULL: &dest[2]), leaves);
 
     return;
 }
@@ -159,8 +321,9 @@ static void swap_bank(uint32_t *buf, int tolocal, uint32_t *dest) {
  *                else buf has data of opposite endian
  * @param dest    buffer to place swapped data into.
  *                If this is NULL, then dest = buf.
+ * @param leaves  if 0 only container headers are swapped
  */
-static void swap_segment(uint32_t *buf, int tolocal, uint32_t *dest) {
+static void swap_segment(uint32_t *buf, int tolocal, uint32_t *dest, int leaves) {
 
     uint32_t data_length,data_type;
     uint32_t *p=buf;
@@ -179,7 +342,7 @@ static void swap_segment(uint32_t *buf, int tolocal, uint32_t *dest) {
     }
   
     /* Swap non-header segment data */
-    swap_data(&buf[1], data_type, data_length, tolocal, ((dest==NULL) ? NULL : &dest[1]));
+    swap_data(&buf[1], data_type, data_length, tolocal, ((dest==NULL) ? NULL : &dest[1]), leaves);
   
     return;
 }
@@ -194,8 +357,9 @@ static void swap_segment(uint32_t *buf, int tolocal, uint32_t *dest) {
  *                else buf has data of opposite endian
  * @param dest    buffer to place swapped data into.
  *                If this is NULL, then dest = buf.
+ * @param leaves  if 0 only container headers are swapped
  */
-static void swap_tagsegment(uint32_t *buf, int tolocal, uint32_t *dest) {
+static void swap_tagsegment(uint32_t *buf, int tolocal, uint32_t *dest, int leaves) {
 
     uint32_t data_length,data_type;
     uint32_t *p=buf;
@@ -214,7 +378,7 @@ static void swap_tagsegment(uint32_t *buf, int tolocal, uint32_t *dest) {
     }
     
     /* Swap non-header tagsegment data */
-    swap_data(&buf[1], data_type, data_length, tolocal, ((dest==NULL)? NULL : &dest[1]));
+    swap_data(&buf[1], data_type, data_length, tolocal, ((dest==NULL)? NULL : &dest[1]), leaves);
   
     return;
 }
@@ -231,12 +395,19 @@ static void swap_tagsegment(uint32_t *buf, int tolocal, uint32_t *dest) {
  *                else data is of opposite endian
  * @param dest    buffer to place swapped data into.
  *                If this is NULL, then dest = data.
+ * @param leaves  if 0 only container headers are swapped, other data is copied
  */
-static void swap_data(uint32_t *data, int type, int length, int tolocal, uint32_t *dest) {
+static void swap_data(uint32_t *data, int type, int length, int tolocal, uint32_t *dest, int leaves) {
     uint32_t fraglen;
     uint32_t l=0;
 
 
+    /* Leaf data is copied as is when only headers are swapped */
+    if (!leaves && !evIsContainer(type)) {
+        copy_data(data, length, dest);
+        return;
+    }
+
     /* Swap the data or call swap_fragment */
     switch (type) {
 
@@ -290,12 +461,12 @@ static void swap_data(uint32_t *data, int type, int length, int tolocal, uint32_
                 /* data is opposite local endian */
                 if (tolocal) {
                     /* swap bank */
-                    swap_bank(&data[l], tolocal, (dest==NULL) ? NULL : &dest[l]);
+                    swap_bank(&data[l], tolocal, (dest==NULL) ? NULL : &dest[l], leaves);
                     /* bank was this long (32 bit words) including header */
                     fraglen = (dest==NULL) ? data[l]+1: dest[l]+1;
                 } else {
                     fraglen = data[l] + 1;
-                    swap_bank(&data[l], tolocal, (dest==NULL) ? NULL : &dest[l]);
+                    swap_bank(&data[l], tolocal, (dest==NULL) ? NULL : &dest[l], leaves);
                 }
                 l += fraglen;
             }
@@ -307,11 +478,11 @@ static void swap_data(uint32_t *data, int type, int length, int tolocal, uint32_
         case 0x20:
             while (l < length) {
                 if (tolocal) {
-                    swap_segment(&data[l], tolocal, (dest==NULL) ? NULL : &dest[l]);
+                    swap_segment(&data[l], tolocal, (dest==NULL) ? NULL : &dest[l], leaves);
                     fraglen = (dest==NULL) ? (data[l]&0xffff)+1: (dest[l]&0xffff)+1;
                 } else {
                     fraglen = (data[l] & 0xffff) + 1;
-                    swap_segment(&data[l], tolocal, (dest==NULL) ? NULL : &dest[l]);
+                    swap_segment(&data[l], tolocal, (dest==NULL) ? NULL : &dest[l], leaves);
                 }
                 l += fraglen;
             }
@@ -322,11 +493,11 @@ static void swap_data(uint32_t *data, int type, int length, int tolocal, uint32_
         case 0xc:
             while (l < length) {
                 if (tolocal) {
-                    swap_tagsegment(&data[l], tolocal, (dest==NULL) ? NULL : &dest[l]);
+                    swap_tagsegment(&data[l], tolocal, (dest==NULL) ? NULL : &dest[l], leaves);
                     fraglen = (dest==NULL)?(data[l]&0xffff)+1:(dest[l]&0xffff)+1;
                 } else {
                     fraglen = (data[l] & 0xffff) + 1;
-                    swap_tagsegment(&data[l], tolocal, (dest==NULL) ? NULL : &dest[l]);
+                    swap_tagsegment(&data[l], tolocal, (dest==NULL) ? NULL : &dest[l], leaves);
                 }
                 l += fraglen;
             }
@@ -453,7 +624,8 @@ uint32_t *swap_int32_t(uint32_t *data, unsigned int length, uint32_t *dest) {
         dest = data;
     }
 
-    for (i=0; i < length; i++) {
+    i = swap_bytes_fast(data, dest, length*4, 4)/4;
+    for (; i < length; i++) {
         dest[i] = EVIO_SWAP32(data[i]);
     }
     
@@ -478,7 +650,8 @@ static void swap_int64_t(uint64_t *data, int length, uint64_t *dest) {
         dest = data;
     }
 
-    for (i=0; i < length; i++) {
+    i = swap_bytes_fast(data, dest, length*8, 8)/8;
+    for (; i < length; i++) {
         dest[i] = EVIO_SWAP64(data[i]);
     }
 }
@@ -501,7 +674,8 @@ static void swap_short(uint16_t *data, int length, uint16_t *dest) {
         dest = data;
     }
 
-    for (i=0; i < length; i++) {
+    i = swap_bytes_fast(data, dest, length*2, 2)/2;
+    for (; i < length; i++) {
         dest[i] = EVIO_SWAP16(data[i]);
     }
 }
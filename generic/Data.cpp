@@ -97,6 +97,35 @@ void Data::copy ( uint *data, uint size ) {
    update();
 }
 
+// Append data from buffer
+void Data::append ( uint *data, uint size ) {
+   memcpy(extend(size),data,size*sizeof(uint));
+}
+
+// Grow data and return pointer to the new words
+uint *Data::extend ( uint size ) {
+   uint *ret;
+
+   reserve(size_+size);
+   ret = data_ + size_;
+   size_ += size;
+   update();
+   return(ret);
+}
+
+// Make sure the buffer can hold size words
+void Data::reserve ( uint size ) {
+   if ( size > alloc_ ) {
+      alloc_ = size;
+      data_ = (uint *)realloc(data_,alloc_ * sizeof(uint));
+   }
+}
+
+// Get allocated buffer size
+uint Data::capacity ( ) {
+   return(alloc_);
+}
+
 // Get pointer to data buffer
 uint *Data::data ( ) {
    return(data_);
@@ -89,6 +89,28 @@ class Data {
       */
       void copy ( uint *data, uint size );
 
+      //! Append data from buffer
+      /*! 
+       * \param data Data pointer
+       * \param size Data size
+      */
+      void append ( uint *data, uint size );
+
+      //! Grow data by size words and return pointer to the new words
+      /*! 
+       * \param size Number of words to add
+      */
+      uint *extend ( uint size );
+
+      //! Make sure the buffer can hold size words, keeps contents
+      /*! 
+       * \param size Data size
+      */
+      void reserve ( uint size );
+
+      //! Get allocated buffer size
+      uint capacity ( );
+
       //! Get pointer to data buffer
       uint *data ( );
 
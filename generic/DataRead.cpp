@@ -34,7 +34,9 @@ DataRead::DataRead ( ) {
    sawRunTime_  = false;
    rdAddr_      = 0;
    rdCount_     = 0;
+   smemDropped_ = 0;
    smem_        = NULL;
+   keepXml_     = false;
 }
 
 // Deconstructor
@@ -68,6 +70,8 @@ void DataRead::xmlParse ( uint size, char *data ) {
    }
    buff[mySize-1] = 0;
 
+   if ( keepXml_ ) xmlRecords_.push_back(make_pair(myType,string(buff)));
+
    if ( myType == Data::XmlConfig   ) config_.parse("config",buff);
    if ( myType == Data::XmlStatus   ) status_.parse("status",buff);
    if ( myType == Data::XmlRunStart ) {
@@ -92,6 +96,19 @@ void DataRead::xmlParse ( uint size, char *data ) {
    free(buff);
 }
 
+// Process a config or status XML string found in the data
+// Each store only reads a document whose root matches its type.
+void DataRead::parseXml ( const char *xml ) {
+   if ( keepXml_ ) {
+      const char *root = xml;
+      while ( (root = strchr(root,'<')) != NULL && (root[1] == '?' || root[1] == '!') ) root++;
+      uint type = (root != NULL && strncmp(root,"<status",7) == 0) ? Data::XmlStatus : Data::XmlConfig;
+      xmlRecords_.push_back(make_pair(type,string(xml)));
+   }
+   config_.parse("config",xml);
+   status_.parse("status",xml);
+}
+
 // Open file
 bool DataRead::open ( string file, bool compressed ) {
    int    bzerror;
@@ -184,9 +201,13 @@ bool DataRead::next (Data *data) {
 
       // First read frame size from data file
       if ( smem_ != NULL ) {
+         uint last = rdCount_;
          if ( dataSharedRead((DataSharedMemory *)smem_,&rdAddr_,&rdCount_, &size, &shBuff ) == 0 ) {
             return(false);
          }
+
+         // The read pointer was moved up to the writer, the records in between are lost
+         if ( last != 0 && rdCount_ > last + 1 ) smemDropped_ += rdCount_ - last - 1;
       } 
       else if ( bzEnable_ ) {
          cout << "Reading size field" << endl;
@@ -247,6 +268,21 @@ bool DataRead::next (Data *data) {
    }
 }
 
+// Keep XML records
+void DataRead::setKeepXml ( bool enable ) {
+   keepXml_ = enable;
+   if ( ! enable ) xmlRecords_.clear();
+}
+
+// Get the oldest kept XML record
+bool DataRead::takeXml ( uint &type, string &xml ) {
+   if ( xmlRecords_.empty() ) return(false);
+   type = xmlRecords_.front().first;
+   xml  = xmlRecords_.front().second;
+   xmlRecords_.pop_front();
+   return(true);
+}
+
 // Get next data record
 Data *DataRead::next ( ) {
    Data *tmp = new Data;
@@ -277,6 +313,36 @@ uint DataRead::getStatusInt ( string var ) {
    return(status_.getInt(var));
 }
 
+// Get a config handle
+uint DataRead::configHandle ( string var ) {
+   return(config_.handle(var));
+}
+
+// Get a config value
+string DataRead::getConfig ( uint handle ) {
+   return(config_.get(handle));
+}
+
+// Get a config value
+uint DataRead::getConfigInt ( uint handle ) {
+   return(config_.getInt(handle));
+}
+
+// Get a status handle
+uint DataRead::statusHandle ( string var ) {
+   return(status_.handle(var));
+}
+
+// Get a status value
+string DataRead::getStatus ( uint handle ) {
+   return(status_.get(handle));
+}
+
+// Get a status value
+uint DataRead::getStatusInt ( uint handle ) {
+   return(status_.getInt(handle));
+}
+
 // Dump config
 void DataRead::dumpConfig ( ostream &out ) {
    out << "Dumping current config variables:" << endl;
@@ -375,7 +441,23 @@ void DataRead::openShared ( string system, uint id, int uid ) {
       smem_ = NULL;
       throw string("CommLink::enabledSharedMemory -> Failed to open shared memory");
    }
-   rdAddr_  = 0;
-   rdCount_ = 0;
+   rdAddr_      = 0;
+   rdCount_     = 0;
+   smemDropped_ = 0;
+}
+
+// Records lost by the shared memory reader
+unsigned long DataRead::sharedDropped ( ) {
+   return(smemDropped_);
+}
+
+// Records not read yet
+uint DataRead::sharedLag ( ) {
+   uint wrCount;
+
+   if ( smem_ == NULL ) return(0);
+   wrCount = ((DataSharedMemory *)smem_)->wrCount;
+   if ( rdCount_ > wrCount ) return(0);
+   return(wrCount - rdCount_);
 }
 
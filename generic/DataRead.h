@@ -18,6 +18,7 @@
 
 #include <string>
 #include <map>
+#include <deque>
 #include <Data.h>
 #include <bzlib.h>
 #include <sys/mman.h>
@@ -43,6 +44,7 @@ class DataRead {
       void *smem_;
       uint rdAddr_;
       uint rdCount_;
+      unsigned long smemDropped_;
 
       // File size
       off_t size_;
@@ -61,6 +63,10 @@ class DataRead {
       XmlVariables stop_;
       XmlVariables time_;
 
+      // XML records kept for takeXml(), type and document
+      bool                       keepXml_;
+      deque< pair<uint,string> > xmlRecords_;
+
       // Start/Stop flags
       bool sawRunStart_;
       bool sawRunStop_;
@@ -71,6 +77,9 @@ class DataRead {
       // File descriptor
       int fd_;
 
+      // Process a config or status XML string found in the data
+      void parseXml ( const char *xml );
+
    public:
 
       //! Constructor
@@ -92,6 +101,12 @@ class DataRead {
       */
       void openShared ( string system, uint id, int uid=-1 );
 
+      //! Records the writer overwrote before this reader got to them
+      unsigned long sharedDropped ( );
+
+      //! Records written to shared memory and not read yet
+      uint sharedLag ( );
+
       //! Close File
       virtual void close ( );
 
@@ -108,6 +123,21 @@ class DataRead {
       */
       virtual bool next ( Data *data );
 
+      //! Keep the XML records read by next() for takeXml(), off by default
+      /*! 
+       * \param enable Keep records
+      */
+      void setKeepXml ( bool enable );
+
+      //! Get the oldest kept XML record, returns false if there is none
+      /*! 
+       * Records come out in file order. Those read by a next() call preceded
+       * the frame it returned.
+       * \param type Record type, Data::XmlConfig ... Data::XmlRunTime
+       * \param xml XML document
+      */
+      bool takeXml ( uint &type, string &xml );
+
       //! Get next data record & create new data object
       /*! 
        * Returns NULL on failure
@@ -138,6 +168,42 @@ class DataRead {
       */
       uint getStatusInt ( string var );
 
+      //! Get a handle for a config value, valid across files
+      /*! 
+       * \param var Config variable name
+      */
+      uint configHandle ( string var );
+
+      //! Get a config value by handle
+      /*! 
+       * \param handle Handle from configHandle()
+      */
+      string getConfig ( uint handle );
+
+      //! Get a config value as integer by handle
+      /*! 
+       * \param handle Handle from configHandle()
+      */
+      uint getConfigInt ( uint handle );
+
+      //! Get a handle for a status value, valid across files
+      /*! 
+       * \param var Status variable name
+      */
+      uint statusHandle ( string var );
+
+      //! Get a status value by handle
+      /*! 
+       * \param handle Handle from statusHandle()
+      */
+      string getStatus ( uint handle );
+
+      //! Get a status value as integer by handle
+      /*! 
+       * \param handle Handle from statusHandle()
+      */
+      uint getStatusInt ( uint handle );
+
       //! Dump config
       void dumpConfig ( ostream &out=cout );
 
@@ -0,0 +1,262 @@
+//-----------------------------------------------------------------------------
+// File          : DataWrite.cpp
+// Created       : 10/19/2026
+// Project       : General Purpose
+//-----------------------------------------------------------------------------
+// Description :
+// Write data & configuration to disk in the format read by DataRead.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+
+#include <DataWrite.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <iostream>
+using namespace std;
+
+// Buffer alignment
+#define DATA_WRITE_ALIGN 4096
+
+// Constructor
+DataWrite::DataWrite ( ) {
+   fd_         = -1;
+   file_       = NULL;
+   bzFile_     = NULL;
+   bzEnable_   = false;
+   bufferSize_ = 0;
+   buffers_[0] = NULL;
+   buffers_[1] = NULL;
+   fill_[0]    = 0;
+   fill_[1]    = 0;
+   current_    = 0;
+   running_    = false;
+   pending_    = false;
+   stop_       = false;
+   error_      = false;
+   bytes_      = 0;
+   pthread_mutex_init(&mutex_,NULL);
+   pthread_cond_init(&cond_,NULL);
+}
+
+// Deconstructor
+DataWrite::~DataWrite ( ) {
+   close();
+   pthread_mutex_destroy(&mutex_);
+   pthread_cond_destroy(&cond_);
+}
+
+// Writer thread
+void *DataWrite::run ( void *arg ) {
+   DataWrite *dw = (DataWrite *)arg;
+   uint      idx;
+   bool      ok;
+
+   pthread_mutex_lock(&dw->mutex_);
+   while ( true ) {
+      while ( ! dw->pending_ && ! dw->stop_ ) pthread_cond_wait(&dw->cond_,&dw->mutex_);
+      if ( ! dw->pending_ ) break;
+
+      // The pending buffer is the one the caller is not filling
+      idx = dw->current_ ^ 1;
+      pthread_mutex_unlock(&dw->mutex_);
+
+      ok = dw->writeBuffer(dw->buffers_[idx],dw->fill_[idx]);
+
+      pthread_mutex_lock(&dw->mutex_);
+      if ( ! ok ) dw->error_ = true;
+      dw->fill_[idx] = 0;
+      dw->pending_ = false;
+      pthread_cond_broadcast(&dw->cond_);
+   }
+   pthread_mutex_unlock(&dw->mutex_);
+   return(NULL);
+}
+
+// Write a buffer to the file
+bool DataWrite::writeBuffer ( char *buffer, uint size ) {
+   int bzerror;
+   int ret;
+
+   if ( bzEnable_ ) {
+      BZ2_bzWrite(&bzerror,bzFile_,buffer,size);
+      return(bzerror == BZ_OK);
+   }
+   while ( size > 0 ) {
+      ret = ::write(fd_,buffer,size);
+      if ( ret <= 0 ) return(false);
+      buffer += ret;
+      size   -= ret;
+   }
+   return(true);
+}
+
+// Hand the current buffer to the writer thread
+void DataWrite::flush ( ) {
+   if ( fill_[current_] == 0 ) return;
+
+   pthread_mutex_lock(&mutex_);
+   while ( pending_ ) pthread_cond_wait(&cond_,&mutex_);
+   current_ ^= 1;
+   pending_ = true;
+   pthread_cond_broadcast(&cond_);
+   pthread_mutex_unlock(&mutex_);
+}
+
+// Copy bytes into the buffers
+void DataWrite::put ( const void *data, uint size ) {
+   const char *src = (const char *)data;
+   uint       len;
+
+   bytes_ += size;
+   while ( size > 0 ) {
+      len = bufferSize_ - fill_[current_];
+      if ( len > size ) len = size;
+      memcpy(buffers_[current_]+fill_[current_],src,len);
+      fill_[current_] += len;
+      src  += len;
+      size -= len;
+      if ( fill_[current_] == bufferSize_ ) flush();
+   }
+}
+
+// Open file
+bool DataWrite::open ( string file, bool compressed, uint bufferSize ) {
+   int bzerror;
+
+   close();
+
+   bufferSize_ = (bufferSize + DATA_WRITE_ALIGN - 1) & ~(DATA_WRITE_ALIGN - 1);
+   if ( bufferSize_ == 0 ) bufferSize_ = DATA_WRITE_ALIGN;
+   bzEnable_   = compressed;
+
+   if ( bzEnable_ ) {
+      file_ = fopen(file.c_str(),"w");
+      if ( file_ != NULL ) {
+         bzFile_ = BZ2_bzWriteOpen(&bzerror,file_,9,0,0);
+         if ( bzerror != BZ_OK ) {
+            fclose(file_);
+            file_ = NULL;
+         }
+      }
+      if ( file_ == NULL ) {
+         cout << "DataWrite::open -> Failed to open compressed file: " << file << endl;
+         return(false);
+      }
+   }
+   else {
+#ifdef O_LARGEFILE
+      fd_ = ::open(file.c_str(),O_WRONLY | O_CREAT | O_TRUNC | O_LARGEFILE,0644);
+#else
+      fd_ = ::open(file.c_str(),O_WRONLY | O_CREAT | O_TRUNC,0644);
+#endif
+      if ( fd_ < 0 ) {
+         cout << "DataWrite::open -> Failed to open file: " << file << endl;
+         return(false);
+      }
+   }
+
+   if ( posix_memalign((void **)&buffers_[0],DATA_WRITE_ALIGN,bufferSize_) != 0 ||
+        posix_memalign((void **)&buffers_[1],DATA_WRITE_ALIGN,bufferSize_) != 0 ) {
+      cout << "DataWrite::open -> Failed to allocate buffers" << endl;
+      close();
+      return(false);
+   }
+   fill_[0] = 0;
+   fill_[1] = 0;
+   current_ = 0;
+   pending_ = false;
+   stop_    = false;
+   error_   = false;
+   bytes_   = 0;
+
+   if ( pthread_create(&thread_,NULL,run,this) != 0 ) {
+      cout << "DataWrite::open -> Failed to start writer thread" << endl;
+      close();
+      return(false);
+   }
+   running_ = true;
+   return(true);
+}
+
+// Close file
+bool DataWrite::close ( ) {
+   int  bzerror;
+   bool ok;
+
+   if ( running_ ) {
+      flush();
+      pthread_mutex_lock(&mutex_);
+      stop_ = true;
+      pthread_cond_broadcast(&cond_);
+      pthread_mutex_unlock(&mutex_);
+      pthread_join(thread_,NULL);
+      running_ = false;
+   }
+   ok = ! error_;
+
+   if ( bzFile_ != NULL ) {
+      BZ2_bzWriteClose(&bzerror,bzFile_,0,NULL,NULL);
+      if ( bzerror != BZ_OK ) ok = false;
+      bzFile_ = NULL;
+   }
+   if ( file_ != NULL ) {
+      if ( fclose(file_) != 0 ) ok = false;
+      file_ = NULL;
+   }
+   if ( fd_ >= 0 ) {
+      if ( ::close(fd_) != 0 ) ok = false;
+      fd_ = -1;
+   }
+   free(buffers_[0]);
+   free(buffers_[1]);
+   buffers_[0] = NULL;
+   buffers_[1] = NULL;
+   bzEnable_   = false;
+   return(ok);
+}
+
+// Write a data record
+void DataWrite::writeData ( const uint *data, uint size ) {
+   uint header = (Data::RawData << 28) | (size & 0x0FFFFFFF);
+
+   if ( ! running_ ) return;
+   put(&header,4);
+   put(data,size*4);
+}
+
+// Write a data record
+void DataWrite::writeData ( Data *data ) {
+   writeData(data->data(),data->size());
+}
+
+// Write an XML record, the size counts the terminating NUL that DataRead overwrites
+void DataWrite::writeXml ( uint type, string xml ) {
+   uint size   = xml.length() + 1;
+   uint header = ((type & 0xF) << 28) | (size & 0x0FFFFFFF);
+
+   if ( ! running_ ) return;
+   put(&header,4);
+   put(xml.c_str(),size);
+}
+
+// Bytes written
+unsigned long long DataWrite::bytes ( ) {
+   return(bytes_);
+}
+
+// True if a write failed
+bool DataWrite::error ( ) {
+   bool ret;
+
+   pthread_mutex_lock(&mutex_);
+   ret = error_;
+   pthread_mutex_unlock(&mutex_);
+   return(ret);
+}
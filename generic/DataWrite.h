@@ -0,0 +1,124 @@
+//-----------------------------------------------------------------------------
+// File          : DataWrite.h
+// Created       : 10/19/2026
+// Project       : General Purpose
+//-----------------------------------------------------------------------------
+// Description :
+// Write data & configuration to disk in the format read by DataRead.
+//
+// Records are packed into large page aligned buffers. A full buffer is
+// handed to a writer thread, which compresses it (optional, bzip2 as read
+// by DataRead::open(file,true)) and writes it while the caller fills the
+// other buffer. Each open file has its own thread, so the compression of
+// several outputs runs in parallel.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#ifndef __DATA_WRITE_H__
+#define __DATA_WRITE_H__
+
+#include <string>
+#include <stdio.h>
+#include <pthread.h>
+#include <bzlib.h>
+#include <sys/types.h>
+#include <Data.h>
+using namespace std;
+
+#ifdef __CINT__
+#define uint unsigned int
+#endif
+
+//! Class to write data records to disk
+class DataWrite {
+
+      // Output file
+      int    fd_;
+      FILE   *file_;
+      BZFILE *bzFile_;
+      bool   bzEnable_;
+
+      // Buffers, one filled by the caller while the other one is written
+      uint bufferSize_;
+      char *buffers_[2];
+      uint fill_[2];
+      uint current_;
+
+      // Writer thread
+      pthread_t       thread_;
+      pthread_mutex_t mutex_;
+      pthread_cond_t  cond_;
+      bool            running_;
+      bool            pending_;
+      bool            stop_;
+      bool            error_;
+
+      // Bytes written, before compression
+      unsigned long long bytes_;
+
+      // Writer thread
+      static void *run ( void *arg );
+
+      // Write a buffer to the file, called by the writer thread
+      bool writeBuffer ( char *buffer, uint size );
+
+      // Hand the current buffer to the writer thread
+      void flush ( );
+
+      // Copy bytes into the buffers
+      void put ( const void *data, uint size );
+
+   public:
+
+      //! Default buffer size in bytes
+      static const uint DefaultBuffer = 4 << 20;
+
+      //! Constructor
+      DataWrite ( );
+
+      //! Deconstructor
+      ~DataWrite ( );
+
+      //! Open file, returns false if it can not be created
+      /*!
+       * \param file Filename
+       * \param compressed Write a bzip2 compressed file
+       * \param bufferSize Size of each of the two buffers in bytes
+      */
+      bool open ( string file, bool compressed = false, uint bufferSize = DefaultBuffer );
+
+      //! Write out pending data and close the file, returns false if a write failed
+      bool close ( );
+
+      //! Write a data record
+      /*!
+       * \param data Data words
+       * \param size Number of words
+      */
+      void writeData ( const uint *data, uint size );
+
+      //! Write a data record
+      /*!
+       * \param data Data object
+      */
+      void writeData ( Data *data );
+
+      //! Write an XML record
+      /*!
+       * \param type Record type, Data::XmlConfig ... Data::XmlRunTime
+       * \param xml XML document
+      */
+      void writeXml ( uint type, string xml );
+
+      //! Bytes written, before compression
+      unsigned long long bytes ( );
+
+      //! True if a write failed
+      bool error ( );
+};
+
+#endif
@@ -0,0 +1,290 @@
+//-----------------------------------------------------------------------------
+// File          : PlotRecord.cpp
+// Created       : 10/19/2026
+// Project       : General Purpose
+//-----------------------------------------------------------------------------
+// Description :
+// Deferred plots.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <string.h>
+#include <iostream>
+#include "PlotRecord.h"
+using namespace std;
+
+// Largest plot record accepted by the reader
+#define PLOT_RECORD_MAX_BYTES (64 << 20)
+
+// Append a word
+static void packUint ( string &buffer, uint value ) {
+   buffer.append((const char *)&value,sizeof(value));
+}
+
+// Append a string
+static void packString ( string &buffer, const string &value ) {
+   packUint(buffer,value.size());
+   buffer.append(value);
+}
+
+// Read a word
+static bool unpackUint ( const string &buffer, uint &pos, uint &value ) {
+   if ( pos + sizeof(value) > buffer.size() ) return(false);
+   memcpy(&value,buffer.data() + pos,sizeof(value));
+   pos += sizeof(value);
+   return(true);
+}
+
+// Read a string
+static bool unpackString ( const string &buffer, uint &pos, string &value ) {
+   uint size;
+   if ( ! unpackUint(buffer,pos,size) || size > buffer.size() - pos ) return(false);
+   value.assign(buffer.data() + pos,size);
+   pos += size;
+   return(true);
+}
+
+// Constructor
+PlotRecord::PlotRecord ( ) {
+   flags = 0;
+}
+
+// Clear
+void PlotRecord::clear ( ) {
+   name  = "";
+   title = "";
+   flags = 0;
+   items.clear();
+}
+
+// Add a graph with errors
+void PlotRecord::addGraph ( string option, uint n, const double *x, const double *y, const double *ey ) {
+   Item item;
+   item.type      = PlotItemGraph;
+   item.option    = option;
+   item.lineColor = 1;
+   item.lineStyle = 1;
+   item.lineWidth = 1;
+   item.values.reserve(1 + 3 * n);
+   item.values.push_back(n);
+   item.values.insert(item.values.end(),x,x + n);
+   item.values.insert(item.values.end(),y,y + n);
+   if ( ey != NULL ) item.values.insert(item.values.end(),ey,ey + n);
+   else item.values.resize(1 + 3 * n,0.0);
+   items.push_back(item);
+}
+
+// Add a 2D histogram
+void PlotRecord::addHist2 ( string option, uint nx, double xlow, double xhigh, uint ny, double ylow, double yhigh,
+                            double ymin, double ymax ) {
+   Item item;
+   item.type      = PlotItemHist2;
+   item.option    = option;
+   item.lineColor = 1;
+   item.lineStyle = 1;
+   item.lineWidth = 1;
+   item.values.push_back(nx);
+   item.values.push_back(xlow);
+   item.values.push_back(xhigh);
+   item.values.push_back(ny);
+   item.values.push_back(ylow);
+   item.values.push_back(yhigh);
+   item.values.push_back(ymin);
+   item.values.push_back(ymax);
+   items.push_back(item);
+}
+
+// Fill the last added 2D histogram
+void PlotRecord::fillHist2 ( double x, double y, double weight ) {
+   if ( items.empty() || items.back().type != PlotItemHist2 ) return;
+   items.back().values.push_back(x);
+   items.back().values.push_back(y);
+   items.back().values.push_back(weight);
+}
+
+// Add a function
+void PlotRecord::addFunction ( string option, uint function, double xlow, double xhigh, uint npar,
+                               const double *par ) {
+   Item item;
+   item.type      = PlotItemFunction;
+   item.option    = option;
+   item.lineColor = 1;
+   item.lineStyle = 1;
+   item.lineWidth = 1;
+   item.values.push_back(function);
+   item.values.push_back(xlow);
+   item.values.push_back(xhigh);
+   item.values.insert(item.values.end(),par,par + npar);
+   items.push_back(item);
+}
+
+// Set the line style of the last added item
+void PlotRecord::setLine ( uint color, uint style, uint width ) {
+   if ( items.empty() ) return;
+   items.back().lineColor = color;
+   items.back().lineStyle = style;
+   items.back().lineWidth = width;
+}
+
+// Pack: histogram fills are stored as floats, everything else as doubles
+void PlotRecord::pack ( string &buffer ) {
+   buffer.clear();
+   packString(buffer,name);
+   packString(buffer,title);
+   packUint(buffer,flags);
+   packUint(buffer,items.size());
+   for (uint i=0; i < items.size(); i++) {
+      Item &item = items[i];
+      uint exact = (item.type == PlotItemHist2) ? 8 : item.values.size();
+      if ( exact > item.values.size() ) exact = item.values.size();
+
+      packUint(buffer,item.type);
+      packString(buffer,item.option);
+      packUint(buffer,item.lineColor);
+      packUint(buffer,item.lineStyle);
+      packUint(buffer,item.lineWidth);
+      packUint(buffer,exact);
+      packUint(buffer,item.values.size() - exact);
+      if ( exact > 0 ) buffer.append((const char *)&item.values[0],exact * sizeof(double));
+      for (uint j=exact; j < item.values.size(); j++) {
+         float value = item.values[j];
+         buffer.append((const char *)&value,sizeof(value));
+      }
+   }
+}
+
+// Unpack
+bool PlotRecord::unpack ( const string &buffer ) {
+   uint pos = 0;
+   uint count, exact, rounded;
+
+   clear();
+   if ( ! unpackString(buffer,pos,name) || ! unpackString(buffer,pos,title) ||
+        ! unpackUint(buffer,pos,flags) || ! unpackUint(buffer,pos,count) ) return(false);
+   for (uint i=0; i < count; i++) {
+      Item item;
+      if ( ! unpackUint(buffer,pos,item.type) || ! unpackString(buffer,pos,item.option) ||
+           ! unpackUint(buffer,pos,item.lineColor) || ! unpackUint(buffer,pos,item.lineStyle) ||
+           ! unpackUint(buffer,pos,item.lineWidth) || ! unpackUint(buffer,pos,exact) ||
+           ! unpackUint(buffer,pos,rounded) ) return(false);
+      if ( exact > (buffer.size() - pos) / sizeof(double) ) return(false);
+      item.values.resize(exact);
+      if ( exact > 0 ) memcpy(&item.values[0],buffer.data() + pos,exact * sizeof(double));
+      pos += exact * sizeof(double);
+      if ( rounded > (buffer.size() - pos) / sizeof(float) ) return(false);
+      for (uint j=0; j < rounded; j++) {
+         float value;
+         memcpy(&value,buffer.data() + pos,sizeof(value));
+         pos += sizeof(value);
+         item.values.push_back(value);
+      }
+      items.push_back(item);
+   }
+   return(pos == buffer.size());
+}
+
+// Constructor
+PlotWriter::PlotWriter ( ) {
+   file_  = NULL;
+   plots_ = 0;
+}
+
+// Deconstructor
+PlotWriter::~PlotWriter ( ) {
+   close();
+}
+
+// Create the file
+bool PlotWriter::open ( string file ) {
+   uint header[2] = { PlotFileMagic, PlotFileVersion };
+
+   close();
+   plots_ = 0;
+   if ( (file_ = fopen(file.c_str(),"w")) == NULL ) {
+      cout << "PlotWriter::open -> Failed to open file: " << file << endl;
+      return(false);
+   }
+   fwrite(header,sizeof(header),1,file_);
+   return(true);
+}
+
+// Append a plot
+bool PlotWriter::write ( PlotRecord &plot ) {
+   string buffer;
+   uint   header[2];
+
+   if ( file_ == NULL ) return(false);
+   plot.pack(buffer);
+   header[0] = PlotRecordMagic;
+   header[1] = buffer.size();
+   if ( fwrite(header,sizeof(header),1,file_) != 1 ||
+        fwrite(buffer.data(),buffer.size(),1,file_) != 1 ) return(false);
+   plots_++;
+   return(true);
+}
+
+// Close the file
+bool PlotWriter::close ( ) {
+   bool ok = true;
+   if ( file_ != NULL ) ok = (ferror(file_) == 0) && (fclose(file_) == 0);
+   file_ = NULL;
+   return(ok);
+}
+
+// Plots written
+uint PlotWriter::plots ( ) {
+   return(plots_);
+}
+
+// Constructor
+PlotReader::PlotReader ( ) {
+   file_ = NULL;
+}
+
+// Deconstructor
+PlotReader::~PlotReader ( ) {
+   close();
+}
+
+// Open the file
+bool PlotReader::open ( string file ) {
+   uint header[2];
+
+   close();
+   if ( (file_ = fopen(file.c_str(),"r")) == NULL ) return(false);
+   if ( fread(header,sizeof(header),1,file_) != 1 || header[0] != PlotFileMagic || header[1] != PlotFileVersion ) {
+      cout << "PlotReader::open -> Not a plots file: " << file << endl;
+      close();
+      return(false);
+   }
+   return(true);
+}
+
+// Read the next plot
+bool PlotReader::next ( PlotRecord &plot ) {
+   string buffer;
+   uint   header[2];
+
+   if ( file_ == NULL || fread(header,sizeof(header),1,file_) != 1 ) return(false);
+   if ( header[0] != PlotRecordMagic || header[1] > PLOT_RECORD_MAX_BYTES ) {
+      cout << "PlotReader::next -> Bad plot record" << endl;
+      return(false);
+   }
+   buffer.resize(header[1]);
+   if ( header[1] > 0 && fread(&buffer[0],header[1],1,file_) != 1 ) return(false);
+   if ( ! plot.unpack(buffer) ) {
+      cout << "PlotReader::next -> Bad plot record" << endl;
+      return(false);
+   }
+   return(true);
+}
+
+// Close the file
+void PlotReader::close ( ) {
+   if ( file_ != NULL ) fclose(file_);
+   file_ = NULL;
+}
@@ -0,0 +1,190 @@
+//-----------------------------------------------------------------------------
+// File          : PlotRecord.h
+// Created       : 10/19/2026
+// Project       : General Purpose
+//-----------------------------------------------------------------------------
+// Description :
+// Deferred plots: the inputs of a plot are recorded during the analysis and
+// drawn later, by meeg_render, in parallel or only for the plots wanted.
+//
+// A PlotRecord holds the output image name, the title and the drawn items in
+// drawing order: graphs with errors, 2D histograms as a list of filled
+// points, and functions as a known function with its parameters and range,
+// each with its draw option and line style. A .plots file is a header
+// followed by the packed records, each prefixed by its size, so a reader can
+// skip to the plots it needs.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#ifndef __PLOT_RECORD_H__
+#define __PLOT_RECORD_H__
+
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <sys/types.h>
+using namespace std;
+
+//! Plots file identifier
+#define PlotFileMagic 0x504C5446
+
+//! Plot record identifier
+#define PlotRecordMagic 0x504C4F54
+
+//! Plots file layout version
+#define PlotFileVersion 1
+
+//! Item types
+enum PlotItemType {
+   PlotItemGraph    = 1,   //!< n, x[n], y[n], ey[n]
+   PlotItemHist2    = 2,   //!< nx, xlow, xhigh, ny, ylow, yhigh, ymin, ymax, then (x, y, weight) fills
+   PlotItemFunction = 3    //!< function, xlow, xhigh, parameters
+};
+
+//! Functions of function items
+enum PlotFunction {
+   PlotFunctionFourPole = 1   //!< fitf_4pole, 5 parameters
+};
+
+//! Plot flags
+enum PlotFlags {
+   PlotNoStats = 0x1   //!< Draw without the statistics box
+};
+
+//! Inputs of one plot
+class PlotRecord {
+
+   public:
+
+      //! One drawn item
+      struct Item {
+         uint           type;
+         string         option;
+         uint           lineColor;
+         uint           lineStyle;
+         uint           lineWidth;
+         vector<double> values;
+      };
+
+      //! Output image file name, without directory
+      string name;
+
+      //! Title, with axis titles after ';' as in ROOT
+      string title;
+
+      //! PlotFlags
+      uint flags;
+
+      //! Items in drawing order
+      vector<Item> items;
+
+      //! Constructor
+      PlotRecord ( );
+
+      //! Clear name, title and items
+      void clear ( );
+
+      //! Add a graph with errors
+      /*!
+       * \param option Draw option
+       * \param n Number of points
+       * \param x X values
+       * \param y Y values
+       * \param ey Y errors, NULL for none
+      */
+      void addGraph ( string option, uint n, const double *x, const double *y, const double *ey );
+
+      //! Add a 2D histogram, filled with fillHist2()
+      /*!
+       * \param option Draw option
+       * \param nx X bins
+       * \param xlow X low edge
+       * \param xhigh X high edge
+       * \param ny Y bins
+       * \param ylow Y low edge
+       * \param yhigh Y high edge
+       * \param ymin Y axis range low
+       * \param ymax Y axis range high
+      */
+      void addHist2 ( string option, uint nx, double xlow, double xhigh, uint ny, double ylow, double yhigh,
+                      double ymin, double ymax );
+
+      //! Fill the last added 2D histogram
+      void fillHist2 ( double x, double y, double weight );
+
+      //! Add a function
+      /*!
+       * \param option Draw option
+       * \param function PlotFunction
+       * \param xlow Range low
+       * \param xhigh Range high
+       * \param npar Number of parameters
+       * \param par Parameters
+      */
+      void addFunction ( string option, uint function, double xlow, double xhigh, uint npar, const double *par );
+
+      //! Set the line style of the last added item
+      void setLine ( uint color, uint style, uint width );
+
+      //! Pack into a buffer
+      void pack ( string &buffer );
+
+      //! Unpack from a buffer, returns false if it is malformed
+      bool unpack ( const string &buffer );
+};
+
+//! Writer of a .plots file
+class PlotWriter {
+
+      FILE *file_;
+      uint plots_;
+
+   public:
+
+      //! Constructor
+      PlotWriter ( );
+
+      //! Deconstructor
+      ~PlotWriter ( );
+
+      //! Create the file, returns false on failure
+      bool open ( string file );
+
+      //! Append a plot, returns false on failure
+      bool write ( PlotRecord &plot );
+
+      //! Close the file, returns false if a write failed
+      bool close ( );
+
+      //! Plots written
+      uint plots ( );
+};
+
+//! Reader of a .plots file
+class PlotReader {
+
+      FILE *file_;
+
+   public:
+
+      //! Constructor
+      PlotReader ( );
+
+      //! Deconstructor
+      ~PlotReader ( );
+
+      //! Open the file, returns false if it is missing or not a plots file
+      bool open ( string file );
+
+      //! Read the next plot, returns false at the end of the file
+      bool next ( PlotRecord &plot );
+
+      //! Close the file
+      void close ( );
+};
+
+#endif
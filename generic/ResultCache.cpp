@@ -0,0 +1,330 @@
+//-----------------------------------------------------------------------------
+// File          : ResultCache.cpp
+// Created       : 10/19/2026
+// Project       : General Purpose
+//-----------------------------------------------------------------------------
+// Description :
+// Persistent cache of derived results keyed by input file content.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <ResultCache.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <utime.h>
+#include <sys/stat.h>
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+// FNV-1a parameters
+#define FNV_OFFSET 0xcbf29ce484222325ULL
+#define FNV_PRIME  0x100000001b3ULL
+
+// Blob header
+#define BLOB_MAGIC   0x43535048
+#define BLOB_VERSION 1
+
+// Read buffer for hashing
+#define HASH_BUFFER  (1 << 20)
+
+// Hash a buffer, 8 bytes at a time where possible
+static unsigned long long hashBuffer ( unsigned long long hash, const void *data, uint size ) {
+   const unsigned char *bytes = (const unsigned char *)data;
+   unsigned long long   word;
+   uint                 i;
+
+   for (i=0; i+8 <= size; i += 8) {
+      memcpy(&word,bytes+i,8);
+      hash ^= word;
+      hash *= FNV_PRIME;
+   }
+   for (; i < size; i++) {
+      hash ^= bytes[i];
+      hash *= FNV_PRIME;
+   }
+   return(hash);
+}
+
+// Constructor
+CacheKey::CacheKey ( ) {
+   hash_ = FNV_OFFSET;
+}
+
+// Mix in bytes
+void CacheKey::addBytes ( const void *data, uint size ) {
+   hash_ = hashBuffer(hash_,data,size);
+   hash_ = hashBuffer(hash_,&size,sizeof(size));
+}
+
+// Add contents of a file
+bool CacheKey::addFile ( string file ) {
+   unsigned long long hash;
+   unsigned long long total;
+   char               *buff;
+   int                fd;
+   int                ret;
+
+   if ( (fd = ::open(file.c_str(),O_RDONLY)) < 0 ) {
+      addString("missing file");
+      return(false);
+   }
+
+   buff  = (char *)malloc(HASH_BUFFER);
+   hash  = FNV_OFFSET;
+   total = 0;
+   while ( (ret = ::read(fd,buff,HASH_BUFFER)) > 0 ) {
+      hash = hashBuffer(hash,buff,ret);
+      total += ret;
+   }
+   ::close(fd);
+   free(buff);
+
+   if ( ret < 0 ) {
+      addString("unreadable file");
+      return(false);
+   }
+   addBytes(&hash,sizeof(hash));
+   addBytes(&total,sizeof(total));
+   return(true);
+}
+
+// Add a string option
+void CacheKey::addString ( string value ) {
+   addBytes(value.data(),value.size());
+}
+
+// Add an integer option
+void CacheKey::addInt ( long value ) {
+   addBytes(&value,sizeof(value));
+}
+
+// Add a floating point option
+void CacheKey::addDouble ( double value ) {
+   addBytes(&value,sizeof(value));
+}
+
+// Get key string
+string CacheKey::str ( ) {
+   char buff[20];
+   sprintf(buff,"%016llx",hash_);
+   return(string(buff));
+}
+
+// One file in the cache directory
+typedef struct {
+   string             name;
+   unsigned long long size;
+   time_t             used;
+} CacheEntry;
+
+static bool entryOlder ( const CacheEntry &a, const CacheEntry &b ) {
+   if ( a.used != b.used ) return(a.used < b.used);
+   return(a.name < b.name);
+}
+
+// Read all product entries of a cache directory
+static void readEntries ( string dir, vector<CacheEntry> &entries ) {
+   DIR           *dp;
+   struct dirent *ent;
+   struct stat    st;
+   CacheEntry     entry;
+
+   entries.clear();
+   if ( (dp = opendir(dir.c_str())) == NULL ) return;
+   while ( (ent = readdir(dp)) != NULL ) {
+      entry.name = ent->d_name;
+
+      // Products are named <16 hex digit key>.<product>
+      if ( entry.name.size() < 18 || entry.name[16] != '.' ) continue;
+      if ( stat((dir + "/" + entry.name).c_str(),&st) != 0 || ! S_ISREG(st.st_mode) ) continue;
+      entry.size = st.st_size;
+      entry.used = st.st_mtime;
+      entries.push_back(entry);
+   }
+   closedir(dp);
+   sort(entries.begin(),entries.end(),entryOlder);
+}
+
+// Constructor
+ResultCache::ResultCache ( string dir, unsigned long long maxBytes ) {
+   dir_      = dir;
+   maxBytes_ = maxBytes;
+   if ( mkdir(dir_.c_str(),0755) != 0 && access(dir_.c_str(),W_OK) != 0 )
+      cout << "ResultCache::ResultCache -> Can't use cache directory " << dir_ << endl;
+}
+
+// Get cache directory
+string ResultCache::dir ( ) {
+   return(dir_);
+}
+
+// Product file name
+string ResultCache::fileName ( string key, string product ) {
+   return(dir_ + "/" + key + "." + product);
+}
+
+// Product exists
+bool ResultCache::exists ( string key, string product ) {
+   return(access(fileName(key,product).c_str(),R_OK) == 0);
+}
+
+// Path of an existing product, marks it as used
+string ResultCache::path ( string key, string product ) {
+   string name = fileName(key,product);
+   utime(name.c_str(),NULL);
+   return(name);
+}
+
+// Temporary path, the pid keeps concurrent writers apart
+string ResultCache::tempPath ( string key, string product ) {
+   char buff[20];
+   sprintf(buff,".%d.tmp",getpid());
+   return(dir_ + "/tmp." + key + "." + product + buff);
+}
+
+// Move a product into place
+bool ResultCache::commit ( string key, string product ) {
+   if ( rename(tempPath(key,product).c_str(),fileName(key,product).c_str()) != 0 ) {
+      cout << "ResultCache::commit -> Failed to store " << key << "." << product << endl;
+      unlink(tempPath(key,product).c_str());
+      return(false);
+   }
+   evict(maxBytes_,key + "." + product);
+   return(true);
+}
+
+// Read a blob product
+bool ResultCache::read ( string key, string product, string &data ) {
+   unsigned long long header[3];
+   unsigned long long hash;
+   FILE               *fp;
+   bool               ok;
+
+   if ( (fp = fopen(path(key,product).c_str(),"rb")) == NULL ) return(false);
+
+   ok = false;
+   if ( fread(header,sizeof(header),1,fp) == 1 && header[0] == ((unsigned long long)BLOB_VERSION << 32 | BLOB_MAGIC) ) {
+      data.resize(header[1]);
+      if ( header[1] == 0 || fread(&data[0],header[1],1,fp) == 1 ) {
+         hash = hashBuffer(FNV_OFFSET,data.data(),data.size());
+         ok = (hash == header[2]);
+      }
+   }
+   fclose(fp);
+
+   if ( ! ok ) {
+      cout << "ResultCache::read -> Discarding corrupt " << key << "." << product << endl;
+      unlink(fileName(key,product).c_str());
+      data.clear();
+   }
+   return(ok);
+}
+
+// Write a blob product
+bool ResultCache::write ( string key, string product, const string &data ) {
+   unsigned long long header[3];
+   FILE               *fp;
+   bool               ok;
+
+   header[0] = ((unsigned long long)BLOB_VERSION << 32 | BLOB_MAGIC);
+   header[1] = data.size();
+   header[2] = hashBuffer(FNV_OFFSET,data.data(),data.size());
+
+   if ( (fp = fopen(tempPath(key,product).c_str(),"wb")) == NULL ) {
+      cout << "ResultCache::write -> Can't write to " << dir_ << endl;
+      return(false);
+   }
+   ok = (fwrite(header,sizeof(header),1,fp) == 1);
+   if ( ok && data.size() > 0 ) ok = (fwrite(data.data(),data.size(),1,fp) == 1);
+   if ( fclose(fp) != 0 ) ok = false;
+
+   if ( ! ok ) {
+      cout << "ResultCache::write -> Write error for " << key << "." << product << endl;
+      unlink(tempPath(key,product).c_str());
+      return(false);
+   }
+   return(commit(key,product));
+}
+
+// Remove all entries starting with prefix
+unsigned long long ResultCache::remove ( string prefix ) {
+   vector<CacheEntry> entries;
+   unsigned long long removed;
+
+   removed = 0;
+   readEntries(dir_,entries);
+   for (uint i=0; i < entries.size(); i++) {
+      if ( entries[i].name.compare(0,prefix.size(),prefix) != 0 ) continue;
+      if ( unlink((dir_ + "/" + entries[i].name).c_str()) == 0 ) removed += entries[i].size;
+   }
+   return(removed);
+}
+
+// Remove all products of a key
+void ResultCache::invalidate ( string key ) {
+   remove(key + ".");
+}
+
+// Remove all products
+void ResultCache::clear ( ) {
+   remove("");
+}
+
+// Evict least recently used products
+unsigned long long ResultCache::evict ( unsigned long long maxBytes ) {
+   return(evict(maxBytes,""));
+}
+
+// Evict, never removing the named entry
+unsigned long long ResultCache::evict ( unsigned long long maxBytes, string keep ) {
+   vector<CacheEntry> entries;
+   unsigned long long total;
+   unsigned long long removed;
+
+   if ( maxBytes == 0 ) maxBytes = maxBytes_;
+
+   readEntries(dir_,entries);
+   total = 0;
+   for (uint i=0; i < entries.size(); i++) total += entries[i].size;
+
+   removed = 0;
+   for (uint i=0; i < entries.size() && total > maxBytes; i++) {
+      if ( entries[i].name == keep ) continue;
+      if ( unlink((dir_ + "/" + entries[i].name).c_str()) != 0 ) continue;
+      total   -= entries[i].size;
+      removed += entries[i].size;
+   }
+   return(removed);
+}
+
+// Total size of all products
+unsigned long long ResultCache::totalBytes ( ) {
+   vector<CacheEntry> entries;
+   unsigned long long total;
+
+   readEntries(dir_,entries);
+   total = 0;
+   for (uint i=0; i < entries.size(); i++) total += entries[i].size;
+   return(total);
+}
+
+// List products
+void ResultCache::list ( ostream &out ) {
+   vector<CacheEntry> entries;
+   char               buff[40];
+
+   readEntries(dir_,entries);
+   for (uint i=0; i < entries.size(); i++) {
+      strftime(buff,sizeof(buff),"%Y-%m-%d %H:%M:%S",localtime(&(entries[i].used)));
+      out << buff << "\t" << entries[i].size << "\t" << entries[i].name << endl;
+   }
+}
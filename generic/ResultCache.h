@@ -0,0 +1,148 @@
+//-----------------------------------------------------------------------------
+// File          : ResultCache.h
+// Created       : 10/19/2026
+// Project       : General Purpose
+//-----------------------------------------------------------------------------
+// Description :
+// Persistent cache of derived results keyed by input file content.
+//
+// A CacheKey is a 64 bit hash built from the contents of the input files and
+// the options that influence a result. Products stored under a key are plain
+// files named <key>.<product> in the cache directory; they can be written as
+// checksummed binary blobs (read/write) or by any other means through
+// tempPath() followed by commit().
+//
+// The cache directory is bounded in size. Reading a product marks it as
+// recently used, and commit() evicts the least recently used products until
+// the directory fits the limit again.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#ifndef __RESULT_CACHE_H__
+#define __RESULT_CACHE_H__
+
+#include <iostream>
+#include <string>
+#include <sys/types.h>
+using namespace std;
+
+//! Hash of input file contents and options
+class CacheKey {
+
+      // Running hash
+      unsigned long long hash_;
+
+      // Mix in bytes
+      void addBytes ( const void *data, uint size );
+
+   public:
+
+      //! Constructor
+      CacheKey ( );
+
+      //! Add contents of a file, returns false if it can't be read
+      /*!
+       * A missing file is recorded as missing, so creating it changes the key.
+       * \param file File name
+      */
+      bool addFile ( string file );
+
+      //! Add a string option
+      void addString ( string value );
+
+      //! Add an integer option
+      void addInt ( long value );
+
+      //! Add a floating point option
+      void addDouble ( double value );
+
+      //! Get key as 16 hex digits
+      string str ( );
+};
+
+//! Directory of cached products
+class ResultCache {
+
+      // Cache directory
+      string dir_;
+
+      // Size limit in bytes
+      unsigned long long maxBytes_;
+
+      // Product file name
+      string fileName ( string key, string product );
+
+      // Remove all entries starting with prefix, returns bytes removed
+      unsigned long long remove ( string prefix );
+
+      // Evict, never removing the named entry
+      unsigned long long evict ( unsigned long long maxBytes, string keep );
+
+   public:
+
+      //! Default size limit, 4 GB
+      static const unsigned long long DefaultMaxBytes = 4ULL << 30;
+
+      //! Constructor, creates the directory if needed
+      /*!
+       * \param dir Cache directory
+       * \param maxBytes Size limit
+      */
+      ResultCache ( string dir, unsigned long long maxBytes = DefaultMaxBytes );
+
+      //! Get cache directory
+      string dir ( );
+
+      //! Product exists
+      bool exists ( string key, string product );
+
+      //! Path of an existing product, marks it as used
+      string path ( string key, string product );
+
+      //! Temporary path to write a product to before commit()
+      string tempPath ( string key, string product );
+
+      //! Move a product written to tempPath() into place and evict
+      bool commit ( string key, string product );
+
+      //! Read a blob product, returns false if missing or corrupt
+      /*!
+       * \param key Key string
+       * \param product Product name
+       * \param data Filled with the blob
+      */
+      bool read ( string key, string product, string &data );
+
+      //! Write a blob product
+      /*!
+       * \param key Key string
+       * \param product Product name
+       * \param data Blob
+      */
+      bool write ( string key, string product, const string &data );
+
+      //! Remove all products of a key
+      void invalidate ( string key );
+
+      //! Remove all products
+      void clear ( );
+
+      //! Evict least recently used products until the size is below maxBytes
+      /*!
+       * Returns bytes removed
+       * \param maxBytes Size limit, 0 to use the limit given to the constructor
+      */
+      unsigned long long evict ( unsigned long long maxBytes = 0 );
+
+      //! Total size of all products in bytes
+      unsigned long long totalBytes ( );
+
+      //! List products, least recently used first
+      void list ( ostream &out=cout );
+};
+
+#endif
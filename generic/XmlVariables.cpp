@@ -25,59 +25,190 @@
 #include <fstream>
 #include <iomanip>
 #include <libxml/tree.h>
+#include <libxml/parser.h>
 using namespace std;
 
 // Constructor
 XmlVariables::XmlVariables ( ) {
    xmlInitParser();
-   vars_.clear();  
+   depth_     = 0;
+   rootDepth_ = 0;
+   matched_   = false;
+   ctxt_      = NULL;
 }
 
 // Deconstructor
-XmlVariables::~XmlVariables ( ) { 
-   xmlCleanupParser();
-   xmlMemoryDump();
-}
+// The parser library is shared with other instances and threads, it is not
+// cleaned up here.
+XmlVariables::~XmlVariables ( ) { }
 
 // Clear
 void XmlVariables::clear() {
-   vars_.clear();
+   vector<Entry>::iterator entryIter;
+
+   for ( entryIter = entries_.begin(); entryIter != entries_.end(); entryIter++ ) {
+      entryIter->value       = "";
+      entryIter->set         = false;
+      entryIter->intValid    = false;
+      entryIter->doubleValid = false;
+   }
+   last_.clear();
+}
+
+// Get or create the index of a variable
+uint XmlVariables::intern ( const string &var ) {
+   map<string,uint>::iterator idIter;
+   Entry                      entry;
+
+   idIter = ids_.find(var);
+   if ( idIter != ids_.end() ) return(idIter->second);
+
+   entry.set         = false;
+   entry.intValid    = false;
+   entry.intValue    = 0;
+   entry.doubleValid = false;
+   entry.doubleValue = 0;
+   entries_.push_back(entry);
+   ids_[var] = entries_.size() - 1;
+   return(entries_.size() - 1);
+}
+
+// Store a value, unchanged values are left alone
+void XmlVariables::set ( const string &var, const string &value ) {
+   Entry &entry = entries_[intern(var)];
+
+   if ( entry.set && entry.value == value ) return;
+   entry.value       = value;
+   entry.set         = true;
+   entry.intValid    = false;
+   entry.doubleValid = false;
 }
 
-// Remove whitespace and newlines
-string XmlVariables::removeWhite ( string str ) {
-   string temp;
-   uint   i;
+// Store pending text if it is not only spaces and newlines
+void XmlVariables::flushText ( ) {
+   uint i;
 
-   temp = "";
+   if ( text_.empty() ) return;
+   for (i=0; i < text_.length(); i++) {
+      if ( text_[i] != ' ' && text_[i] != '\n' ) {
+         set(path_,text_);
+         break;
+      }
+   }
+   text_.clear();
+}
 
-   for (i=0; i < str.length(); i++) {
-      if ( str[i] != ' ' && str[i] != '\n' ) 
-         temp += str[i];
+// Element start
+void XmlVariables::saxStart ( void *ctx, const xmlChar *localname, const xmlChar *prefix,
+                              const xmlChar *URI, int nb_namespaces, const xmlChar **namespaces,
+                              int nb_attributes, int nb_defaulted, const xmlChar **attributes ) {
+   XmlVariables *vars = (XmlVariables *)ctx;
+   const char   *name = (const char *)localname;
+   int          x;
+
+   vars->flushText();
+   vars->depth_++;
+
+   // Find the root, either <type> or <system><type>
+   if ( vars->rootDepth_ == 0 ) {
+      if ( vars->depth_ <= 2 && vars->type_ == name ) {
+         vars->rootDepth_ = vars->depth_;
+         vars->matched_   = true;
+      }
+      else if ( vars->depth_ == 1 && strcmp(name,"system") != 0 ) xmlStopParser((xmlParserCtxtPtr)vars->ctxt_);
+      return;
    }
-   return(temp);
+
+   // Append name and index
+   vars->pathLen_.push_back(vars->path_.length());
+   if ( vars->depth_ > vars->rootDepth_ + 1 ) vars->path_.append(":");
+   vars->path_.append(name);
+   for (x=0; x < nb_attributes; x++) {
+      if ( strcmp((const char *)attributes[x*5],"index") == 0 ) {
+         vars->path_.append("(");
+         vars->path_.append((const char *)attributes[x*5+3],attributes[x*5+4]-attributes[x*5+3]);
+         vars->path_.append(")");
+         break;
+      }
+   }
+}
+
+// Element end
+void XmlVariables::saxEnd ( void *ctx, const xmlChar *localname, const xmlChar *prefix, const xmlChar *URI ) {
+   XmlVariables *vars = (XmlVariables *)ctx;
+
+   vars->flushText();
+   if ( vars->rootDepth_ != 0 ) {
+      if ( vars->depth_ > vars->rootDepth_ ) {
+         vars->path_.resize(vars->pathLen_.back());
+         vars->pathLen_.pop_back();
+      }
+      else vars->rootDepth_ = 0;
+   }
+   vars->depth_--;
+}
+
+// Text, possibly in several pieces
+void XmlVariables::saxCharacters ( void *ctx, const xmlChar *ch, int len ) {
+   XmlVariables *vars = (XmlVariables *)ctx;
+
+   if ( vars->rootDepth_ != 0 ) vars->text_.append((const char *)ch,len);
+}
+
+// Comments and entity references end a text node
+void XmlVariables::saxBreak ( void *ctx, const xmlChar *value ) {
+   ((XmlVariables *)ctx)->flushText();
+}
+
+// CDATA sections end a text node and are not stored
+void XmlVariables::saxCdata ( void *ctx, const xmlChar *value, int len ) {
+   ((XmlVariables *)ctx)->flushText();
 }
 
 // Process xml
+// Values seen before a parse error are kept.
 bool XmlVariables::parse ( string type, const char *str ) {
-   xmlDocPtr    doc;
-   xmlNodePtr   node;
-   string       name;
+   xmlSAXHandler    handler;
+   xmlParserCtxtPtr ctxt;
+   bool             ret;
+   map<string,string>::iterator lastIter;
+
+   // Same document as last time
+   lastIter = last_.find(type);
+   if ( lastIter != last_.end() && lastIter->second == str ) return(true);
+
+   memset(&handler,0,sizeof(handler));
+   handler.initialized    = XML_SAX2_MAGIC;
+   handler.startElementNs = saxStart;
+   handler.endElementNs   = saxEnd;
+   handler.characters     = saxCharacters;
+   handler.comment        = saxBreak;
+   handler.reference      = saxBreak;
+   handler.cdataBlock     = saxCdata;
+   handler.warning        = xmlParserWarning;
+   handler.error          = xmlParserError;
+   handler.fatalError     = xmlParserError;
+
+   ctxt = xmlCreatePushParserCtxt(&handler,this,NULL,0,"string.xml");
+   if ( ctxt == NULL ) return(false);
+
+   type_      = type;
+   path_      = "";
+   text_      = "";
+   depth_     = 0;
+   rootDepth_ = 0;
+   matched_   = false;
+   ctxt_      = ctxt;
+   pathLen_.clear();
 
    // Parse string
-   doc = xmlReadMemory(str, strlen(str), "string.xml", NULL, 0);
-   if (doc == NULL) return (false);
+   xmlParseChunk(ctxt,str,strlen(str),1);
+   ret = (ctxt->wellFormed || ctxt->errNo == XML_ERR_USER_STOP);
+   xmlFreeParserCtxt(ctxt);
+   ctxt_ = NULL;
 
-   // get the root element node
-   node = xmlDocGetRootElement(doc);
-   name = (char *)node->name;
-
-   // Process
-   if ( name == type ) xmlLevel(node,"");
-
-   // Cleanup
-   xmlFreeDoc(doc);
-   return(true);
+   if ( ret && matched_ ) last_[type] = str;
+   return(ret);
 }
 
 // Process xml file
@@ -96,105 +227,85 @@ bool XmlVariables::parseFile ( string type, string file ) {
    return(parse(type,buffer.str().c_str()));
 }
 
-// Process level
-void XmlVariables::xmlLevel( xmlNode *node, string curr ) {
-   xmlNode    *childNode;
-   const char *nodeName;
-   char       *nodeValue;
-   string     nameStr;
-   string     valStr;
-   char       *attrValue;
-   string     idxStr;
-
-   // Look for child nodes
-   for ( childNode = node->children; childNode; childNode = childNode->next ) {
-
-      // Copy incoming string
-      nameStr = curr;
-
-      if ( childNode->type == XML_ELEMENT_NODE ) {
-
-         // Extract name
-         nodeName  = (const char *)childNode->name;
-
-         // Append name
-         if ( nameStr != "" ) nameStr.append(":");
-         nameStr.append(nodeName);
-
-         // Append index
-         attrValue = (char *)xmlGetProp(childNode,(const xmlChar*)"index");
-         if ( attrValue != NULL ) {
-            idxStr = attrValue;
-            nameStr.append("(");
-            nameStr.append(idxStr);
-            nameStr.append(")");
-         }
-
-         // Process children
-         xmlLevel(childNode,nameStr);
-      }
-      else if ( childNode->type == XML_TEXT_NODE ) {
-         nodeValue = (char *)childNode->content;
-         if ( nodeValue != NULL ) {
-            valStr = nodeValue;
-            if ( removeWhite(valStr) != "" ) vars_[nameStr] = valStr;
-         }
-      }
-   }
-}
-
 // Get
 string XmlVariables::get ( string var ) {
-   VariableHolder::iterator varMapIter;
+   map<string,uint>::iterator idIter;
 
    // Look for variable
-   varMapIter = vars_.find(var);
+   idIter = ids_.find(var);
 
    // Variable was not found
-   if ( varMapIter == vars_.end() ) return("");
-   else return(varMapIter->second);
+   if ( idIter == ids_.end() ) return("");
+   else return(get(idIter->second));
 }
 
 // Get
 uint XmlVariables::getInt ( string var ) {
-   VariableHolder::iterator varMapIter;
-   uint                     ret;
-   string                   value;
-   const char               *sptr;
-   char                     *eptr;
+   map<string,uint>::iterator idIter;
 
    // Look for variable
-   varMapIter = vars_.find(var);
+   idIter = ids_.find(var);
 
    // Variable was not found
-   if ( varMapIter == vars_.end() ) return(0);
-
-   value = varMapIter->second;
-   sptr = value.c_str();
-   ret = (uint)strtoul(sptr,&eptr,0);
-   if ( *eptr != '\0' || eptr == sptr ) ret = 0;
-   return(ret);
+   if ( idIter == ids_.end() ) return(0);
+   else return(getInt(idIter->second));
 }
 
 // Get
 double XmlVariables::getDouble ( string var ) {
-   VariableHolder::iterator varMapIter;
-   double                   ret;
-   string                   value;
-   const char               *sptr;
-   char                     *eptr;
+   map<string,uint>::iterator idIter;
 
    // Look for variable
-   varMapIter = vars_.find(var);
+   idIter = ids_.find(var);
 
    // Variable was not found
-   if ( varMapIter == vars_.end() ) return(0);
+   if ( idIter == ids_.end() ) return(0);
+   else return(getDouble(idIter->second));
+}
 
-   value = varMapIter->second;
-   sptr = value.c_str();
-   ret = strtod(sptr,&eptr);
-   if ( *eptr != '\0' || eptr == sptr ) ret = 0;
-   return(ret);
+// Get handle
+uint XmlVariables::handle ( string var ) {
+   return(intern(var));
+}
+
+// Get by handle
+string XmlVariables::get ( uint handle ) {
+   if ( handle >= entries_.size() || ! entries_[handle].set ) return("");
+   return(entries_[handle].value);
+}
+
+// Get by handle, converted once per value
+uint XmlVariables::getInt ( uint handle ) {
+   const char *sptr;
+   char       *eptr;
+
+   if ( handle >= entries_.size() || ! entries_[handle].set ) return(0);
+   Entry &entry = entries_[handle];
+
+   if ( ! entry.intValid ) {
+      sptr = entry.value.c_str();
+      entry.intValue = (uint)strtoul(sptr,&eptr,0);
+      if ( *eptr != '\0' || eptr == sptr ) entry.intValue = 0;
+      entry.intValid = true;
+   }
+   return(entry.intValue);
+}
+
+// Get by handle, converted once per value
+double XmlVariables::getDouble ( uint handle ) {
+   const char *sptr;
+   char       *eptr;
+
+   if ( handle >= entries_.size() || ! entries_[handle].set ) return(0);
+   Entry &entry = entries_[handle];
+
+   if ( ! entry.doubleValid ) {
+      sptr = entry.value.c_str();
+      entry.doubleValue = strtod(sptr,&eptr);
+      if ( *eptr != '\0' || eptr == sptr ) entry.doubleValue = 0;
+      entry.doubleValid = true;
+   }
+   return(entry.doubleValue);
 }
 
 // get list
@@ -202,10 +313,11 @@ string XmlVariables::getList ( string prefix ) {
    stringstream ret;
    ret.str("");
 
-   VariableHolder::iterator varMapIter;
+   map<string,uint>::iterator idIter;
 
-   for ( varMapIter = vars_.begin(); varMapIter != vars_.end(); varMapIter++ ) {
-      ret << prefix << varMapIter->first << " = " << varMapIter->second << endl;
+   for ( idIter = ids_.begin(); idIter != ids_.end(); idIter++ ) {
+      if ( ! entries_[idIter->second].set ) continue;
+      ret << prefix << idIter->first << " = " << entries_[idIter->second].value << endl;
    }
    return(ret.str());
 }
@@ -317,11 +429,12 @@ string XmlVariables::getXml ( ) {
    currName = "";
    nextName = "";
 
-   VariableHolder::iterator varMapIter;
+   map<string,uint>::iterator idIter;
 
-   for ( varMapIter = vars_.begin(); varMapIter != vars_.end(); varMapIter++ ) {
-      nextName  = varMapIter->first;
-      nextValue = varMapIter->second;
+   for ( idIter = ids_.begin(); idIter != ids_.end(); idIter++ ) {
+      if ( ! entries_[idIter->second].set ) continue;
+      nextName  = idIter->first;
+      nextValue = entries_[idIter->second].value;
 
       if ( currName != "" ) ret << genXmlString(prevName,currName,currValue,nextName);
 
@@ -337,7 +450,7 @@ string XmlVariables::getXml ( ) {
 
 // get xml
 string XmlVariables::getXml ( string variable ) {
-   VariableHolder::iterator varMapIter;
+   map<string,uint>::iterator idIter;
    stringstream    ret;
    string          currName;
    string          currValue;
@@ -345,12 +458,12 @@ string XmlVariables::getXml ( string variable ) {
    ret.str("");
 
    // Look for variable
-   varMapIter = vars_.find(variable);
+   idIter = ids_.find(variable);
 
    // Variable was not found
-   if ( varMapIter == vars_.end() ) return("");
+   if ( idIter == ids_.end() || ! entries_[idIter->second].set ) return("");
 
-   ret << genXmlString("",varMapIter->first,varMapIter->second,"");
+   ret << genXmlString("",idIter->first,entries_[idIter->second].value,"");
 
    return(ret.str());
 }
@@ -18,8 +18,10 @@
 
 #include <string>
 #include <map>
+#include <vector>
 #include <sys/types.h>
 #include <libxml/tree.h>
+#include <libxml/parser.h>
 using namespace std;
 
 #ifdef __CINT__
@@ -30,16 +32,64 @@ using namespace std;
 typedef map<string,string> VariableHolder;
 
 //! Class to contain generic register data.
+/*!
+ * Variable names are interned: each name maps to a fixed index that stays
+ * valid across clear() and later parses, so hot lookups can resolve the name
+ * once with handle() and read through the index. Integer and double values
+ * are converted once and cached until the value changes.
+ *
+ * Parsing is a streaming SAX pass, no document tree is built. A document
+ * identical to the last one parsed is skipped, and otherwise only values
+ * that differ from the stored ones are rewritten.
+*/
 class XmlVariables {
 
-      // Strip whitespace
-      string removeWhite ( string str );
-
-      // Process level
-      void xmlLevel( xmlNode *node, string curr );
-
-      // Variable list
-      VariableHolder vars_;
+      // One interned variable
+      struct Entry {
+         string value;
+         bool   set;
+         bool   intValid;
+         uint   intValue;
+         bool   doubleValid;
+         double doubleValue;
+      };
+
+      // Name to index, sorted by name
+      map<string,uint> ids_;
+
+      // Variables by index
+      vector<Entry> entries_;
+
+      // Last document parsed, per type
+      map<string,string> last_;
+
+      // SAX state
+      string type_;
+      string path_;
+      string text_;
+      vector<uint> pathLen_;
+      uint   depth_;
+      uint   rootDepth_;
+      bool   matched_;
+      void   *ctxt_;
+
+      // Get or create the index of a variable
+      uint intern ( const string &var );
+
+      // Store a value
+      void set ( const string &var, const string &value );
+
+      // Store pending text at the current path
+      void flushText ( );
+
+      // Parser callbacks
+      static void saxStart ( void *ctx, const xmlChar *localname, const xmlChar *prefix,
+                             const xmlChar *URI, int nb_namespaces, const xmlChar **namespaces,
+                             int nb_attributes, int nb_defaulted, const xmlChar **attributes );
+      static void saxEnd ( void *ctx, const xmlChar *localname, const xmlChar *prefix, const xmlChar *URI );
+      static void saxCharacters ( void *ctx, const xmlChar *ch, int len );
+      static void saxBreak ( void *ctx, const xmlChar *value );
+      static void saxCdata ( void *ctx, const xmlChar *value, int len );
 
    public:
 
@@ -52,11 +102,12 @@ class XmlVariables {
       //! Deconstructor
       ~XmlVariables ( );
 
-      //! Clear variable list
+      //! Clear variable values, handles stay valid
       void clear();
 
       //! Parse XML string
       /*! 
+       * The root element must be type, or system with a type child.
        * \param type Type of variable to parse, config or status
        * \param xml XML String
       */
@@ -87,6 +138,30 @@ class XmlVariables {
       */
       double getDouble ( string var );
 
+      //! Get a handle for a variable, valid even before the variable is set
+      /*! 
+       * \param var Variable name
+      */
+      uint handle ( string var );
+
+      //! Get a variable value by handle
+      /*! 
+       * \param handle Handle from handle()
+      */
+      string get ( uint handle );
+
+      //! Get a variable value as integer by handle
+      /*! 
+       * \param handle Handle from handle()
+      */
+      uint getInt ( uint handle );
+
+      //! Get a variable value as double by handle
+      /*! 
+       * \param handle Handle from handle()
+      */
+      double getDouble ( uint handle );
+
       //! Return variable list
       /*! 
        * \param prefix List prefix
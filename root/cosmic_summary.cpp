@@ -28,6 +28,7 @@
 #include <DevboardSample.h>
 #include <Data.h>
 #include <DataRead.h>
+#include "meeg_utils.hh"
 using namespace std;
 
 // Process the data
@@ -39,6 +40,7 @@ int main ( int argc, char **argv ) {
    TH2F            *histCosHgh;
    TH2F            *histCosPos;
    TH1F            *histSng[640];
+   GaussPeakResult gausFit[640];
    double          histMin[640];
    double          histMax[640];
    double          histCosMin;
@@ -174,14 +176,13 @@ int main ( int argc, char **argv ) {
    }
 
    // Fit histograms
+   fitGausPeaks(640,histSng,gausFit,true);
    grCount = 0;
    for(channel = 0; channel < 640; channel++) {
       if ( valid[channel] ) {
-         histSng[channel]->Fit("gaus");
          histSng[channel]->GetXaxis()->SetRangeUser(histMin[channel],histMax[channel]);
-         histSng[channel]->Draw();
-         grMean[channel]  = histSng[channel]->GetFunction("gaus")->GetParameter(1);
-         grSigma[channel] = histSng[channel]->GetFunction("gaus")->GetParameter(2);
+         grMean[channel]  = gausFit[channel].mean;
+         grSigma[channel] = gausFit[channel].sigma;
          grChan[channel]  = channel;
       } else {
          grMean[channel]  = 0;
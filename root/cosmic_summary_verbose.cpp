@@ -29,19 +29,26 @@
 #include <DevboardSample.h>
 #include <Data.h>
 #include <DataRead.h>
+#include <StripClusterer.h>
+#include "meeg_utils.hh"
 #include "cosmic_utils.hh"
 using namespace std;
 
 // Process the data
 // Pass root file to open as first and only arg.
 int main ( int argc, char **argv ) {
-  TCanvas         *c1, *c2, *c3, *c4, *c5, *c6, *c7, *c8, *c9,*c10, *c11;
+  TCanvas         *c1, *c2, *c3, *c4, *c5, *c6, *c7, *c8, *c9,*c10, *c11, *c12, *c13;
    TH2F            *histAll;
    TH2F            *histCos;
    TH2F            *histCosHgh;
    TH2F            *histCosPeak;
    TH2F            *histCosPos;
    TH1F            *histSng[640];
+   TH1F            *histClusAmp;
+   TH2F            *histClusPos;
+   StripClusterer  clusterer;
+   uint            clusterCount = 0;
+   GaussPeakResult gausFit[640];
    double          histMin[640];
    double          histMax[640];
    double          histCosMin;
@@ -86,6 +93,7 @@ int main ( int argc, char **argv ) {
    uint            samplesAboveThres = 3;
    uint            consecutiveSamplesAboveThres = 3;
    uint            thresh = 3;
+   uint            seedThresh = 5;
    double          peakSample = -1;
    bool            hasZeroSample = false;
 
@@ -111,6 +119,8 @@ int main ( int argc, char **argv ) {
    histCosHgh = new TH2F("Value_Hist_Cos_Hgh","Value_Hist_Cos_Hgh",16384,-8192,8192,640,0,640);
    histCosPeak = new TH2F("Value_Hist_Cos_Peak","Value_Hist_Cos_Peak",16384,-8192,8192,640,0,640);
    histCosPos = new TH2F("Value_Hist_Cos_Pos","Value_Hist_Cos_Pos",16384,-8192,8192,640,0,640);
+   histClusAmp = new TH1F("Cluster_Amp","Cluster_Amp",1100,-100,1000);
+   histClusPos = new TH2F("Cluster_Pos","Cluster_Pos",1100,-100,1000,640,0,640);
 
    for (channel=0; channel < 640; channel++) {
       sprintf(name,"%i",channel);
@@ -197,14 +207,13 @@ int main ( int argc, char **argv ) {
    if (ofs.is_open() ) {
      ofs << tarFpga << "," << tarHybrid << "," << 0 << endl;
    }
+   fitGausPeaks(640,histSng,gausFit,true);
    grCount = 0;
    for(channel = 0; channel < 640; channel++) {
       if ( valid[channel] ) {
-         histSng[channel]->Fit("gaus");
          histSng[channel]->GetXaxis()->SetRangeUser(histMin[channel],histMax[channel]);
-         histSng[channel]->Draw();
-         grMean[channel]  = histSng[channel]->GetFunction("gaus")->GetParameter(1);
-         grSigma[channel] = histSng[channel]->GetFunction("gaus")->GetParameter(2);
+         grMean[channel]  = gausFit[channel].mean;
+         grSigma[channel] = gausFit[channel].sigma;
          grChan[channel]  = channel;
       } else {
          grMean[channel]  = 0;
@@ -214,7 +223,12 @@ int main ( int argc, char **argv ) {
       
       ofs << channel << "," << grMean[channel] << endl;
 
+      // Clusters of APVs 1-4, seeds above seedThresh sigma, neighbors above thresh sigma
+      clusterer.setNoise(channel,(channel >= 128) ? grSigma[channel] : 0);
    }
+   clusterer.setThresholds(seedThresh,thresh);
+   clusterer.setMinSamples(samplesAboveThres);
+   clusterer.setTiming(SAMPLE_INTERVAL);
 
    ofs.close();
 
@@ -272,6 +286,7 @@ int main ( int argc, char **argv ) {
 
       if ( eventCount % 1000 == 0 ) cout << "Processing event " << eventCount << endl;
 
+      clusterer.clear();
       for (x=0; x < event.count(); x++) {
 
          // Check for matching FPGA
@@ -310,6 +325,7 @@ int main ( int argc, char **argv ) {
 		    
 		    
                   }
+		  clusterer.addStrip(channel,svalue);
 		  
 		  if ( !hasZeroSample ) { // remove events which has a zero sample...?
 		    
@@ -374,6 +390,23 @@ int main ( int argc, char **argv ) {
             }
          }
       }
+
+      // Clusters
+      clusterer.process();
+      for ( y=0; y < clusterer.count(); y++ ) {
+         const StripCluster *cluster = clusterer.cluster(y);
+         histClusAmp->Fill(cluster->amplitude);
+         histClusPos->Fill(cluster->amplitude,cluster->position);
+         if ( verbose_level > 0 ) {
+            cout << "Found cluster."
+                 << " Position=" << cluster->position
+                 << ", Size=" << dec << cluster->size
+                 << ", Amplitude=" << cluster->amplitude
+                 << ", T0=" << cluster->t0
+                 << ", Event=" << dec << eventCount << endl;
+         }
+      }
+      clusterCount += clusterer.count();
       eventCount++;
    } //event loop
    ++nfread;
@@ -425,6 +458,15 @@ int main ( int argc, char **argv ) {
    histCosPeakPrj->GetXaxis()->SetRangeUser(-100,1000);
    histCosPeakPrj->Draw("");
 
+   c12 = new TCanvas("c12","c12");
+   c12->cd();
+   histClusAmp->Draw("");
+
+   c13 = new TCanvas("c13","c13");
+   c13->cd();
+   histClusPos->Draw("colz");
+
+   cout << "Found " << dec << ecnt << " hits and " << clusterCount << " clusters" << endl;
 
 
    if ( save ) {
@@ -450,6 +492,10 @@ int main ( int argc, char **argv ) {
      c10->SaveAs(buf);
      sprintf(buf,"%s.pdf",c11->GetName());
      c11->SaveAs(buf);
+     sprintf(buf,"%s.pdf",c12->GetName());
+     c12->SaveAs(buf);
+     sprintf(buf,"%s.pdf",c13->GetName());
+     c13->SaveAs(buf);
    }
    // Start X-Windows
    theApp.Run();
@@ -28,6 +28,7 @@
 #include <DevboardSample.h>
 #include <Data.h>
 #include <DataRead.h>
+#include "meeg_utils.hh"
 using namespace std;
 
 // Process the data
@@ -36,6 +37,7 @@ int main ( int argc, char **argv ) {
    TCanvas         *c1, *c2, *c3;
    TH2F            *histAll;
    TH1F            *histSng[640];
+   GaussPeakResult gausFit[640];
    double          histMin[640];
    double          histMax[640];
    double          allMin;
@@ -136,13 +138,12 @@ int main ( int argc, char **argv ) {
    }
 
    // Fit histograms
+   fitGausPeaks(640,histSng,gausFit,true);
    grCount = 0;
    for(channel = 0; channel < 640; channel++) {
       if ( valid[channel] ) {
-         histSng[channel]->Fit("gaus");
          histSng[channel]->GetXaxis()->SetRangeUser(histMin[channel],histMax[channel]);
-         histSng[channel]->Draw();
-         grSigma[grCount] = histSng[channel]->GetFunction("gaus")->GetParameter(2);
+         grSigma[grCount] = gausFit[channel].sigma;
          grChan[grCount]  = channel;
          grCount++;
       }
@@ -20,11 +20,12 @@
 #include "DataReadEvio.h"
 #include "TiTriggerEvent.h"
 #include "TriggerSample.h"
+#include "SvtEventBuilder.h"
 
 
 using namespace std;
 
-TiTriggerEvent triggerEvent;
+TiTriggerEvent* triggerEvent;
 TriggerSample* triggerSample;
 int eventCount;
 int sampleCount;
@@ -39,6 +40,69 @@ int debug;
 int errorCountAll;
 int errorCountHead;
 
+// Count the error bits of a bank, called by the event builder for every bank it reads
+static void checkBank(TiTriggerEvent* bank, int tag, void* arg) {
+
+  triggerEvent = bank;
+
+  if( debug > 0 || (eventCount % 10000 == 0) ) cout << "read bank " << eventCount << " tag " << tag << endl;
+
+  sampleCount = triggerEvent->count();
+
+  if( debug > 0) cout << "sampleCount: " << sampleCount << endl;
+
+  for( int iSampleCount=0; iSampleCount!=sampleCount; ++iSampleCount) {
+  
+    if( debug > 0) cout << "iSampleCount: " << iSampleCount << endl;
+  
+    triggerEvent->sample(iSampleCount, triggerSample);
+
+    rce = triggerSample->rceAddress();
+    feb = triggerSample->febAddress();
+    hybrid = triggerSample->hybrid();
+    apv = triggerSample->apv();
+    channel = triggerSample->channel();
+  
+
+
+    if( debug > 0) 
+      cout << "rce: " << rce << " feb: " << feb << " hybrid: " << hybrid << " apv: " << apv << " channel: " << channel << endl;
+  
+  
+    if( debug > 0) {
+      cout << "HEAD " << (triggerSample->head() ? 1 : 0) << " TAIL " << (triggerSample->tail() ? 1 : 0) << " ERR " << (triggerSample->error() ? 1 : 0);
+      cout << " ADC samples: ";
+      for(int y = 0; y < 6; ++y) {
+        uint val = triggerSample->value( y );
+        cout << " " << val;
+      } 
+      cout << endl;
+    }
+
+  
+    // Count the error bits
+  
+    if( triggerSample->error() ) {
+      cout << "error found: " << rce << " feb: " << feb << " hybrid: " << hybrid << " apv: " << apv << " channel: " << channel << endl;
+      errorCountAll++;
+    }
+  
+    if( triggerSample->head() ) {
+      if( triggerSample->error() ) {
+        cout << "head error found: " << rce << " feb: " << feb << " hybrid: " << hybrid << " apv: " << apv << " channel: " << channel << endl;
+        errorCountHead++;
+      }
+    }
+  
+  
+  
+  
+  
+  } // iSampleCount
+
+  eventCount++;
+}
+
 int main(int argc, char**argv ) {
 
   printf("JUST GO\n");
@@ -87,87 +151,35 @@ int main(int argc, char**argv ) {
 
   triggerSample = new TriggerSample();
 
-  int tiEventNumber;
-  int tiEventNumberPrev = -1;
   int tiEvents = 0;
+  bool done = false;
+
+  // Group the RCE banks of each TI event
+  SvtEventBuilder builder(dataRead);
+  SvtBuiltEvent* builtEvent;
+
+  // Errors are counted on every bank read, including those the builder drops
+  builder.setBankCallback(checkBank);
   
-  while( dataRead->next(&triggerEvent) == true ) {
-    
-    if( debug > 0 || (tiEvents % 10000 == 0) ) cout << "read event " << eventCount << " tiEvents " << tiEvents << endl;
-
-    if( numEvents > 0 && eventCount > numEvents )
-      break;
-    
-    tiEventNumber = triggerEvent.tiEventNumber();
-    if(tiEventNumber > tiEventNumberPrev) {
-      tiEventNumberPrev = tiEventNumber;
-      tiEvents++;
-    }
-    
-    sampleCount = triggerEvent.count();
-    
-    if( debug > 0) cout << "sampleCount: " << sampleCount << endl;
-    
-    for( int iSampleCount=0; iSampleCount!=sampleCount; ++iSampleCount) {
-      
-      if( debug > 0) cout << "iSampleCount: " << iSampleCount << endl;
-      
-      triggerEvent.sample(iSampleCount, triggerSample);
-
-      rce = triggerSample->rceAddress();
-      feb = triggerSample->febAddress();
-      hybrid = triggerSample->hybrid();
-      apv = triggerSample->apv();
-      channel = triggerSample->channel();
-      
-
-
-      if( debug > 0) 
-        cout << "rce: " << rce << " feb: " << feb << " hybrid: " << hybrid << " apv: " << apv << " channel: " << channel << endl;
-      
-      
-      if( debug > 0) {
-        cout << "HEAD " << (triggerSample->head() ? 1 : 0) << " TAIL " << (triggerSample->tail() ? 1 : 0) << " ERR " << (triggerSample->error() ? 1 : 0);
-        cout << " ADC samples: ";
-        for(int y = 0; y < 6; ++y) {
-          uint val = triggerSample->value( y );
-          cout << " " << val;
-        } 
-        cout << endl;
-      }
+  while( !done && (builtEvent = builder.next()) != NULL ) {
 
-      
-      // Count the error bits
-      
-      if( triggerSample->error() ) {
-        cout << "error found: " << rce << " feb: " << feb << " hybrid: " << hybrid << " apv: " << apv << " channel: " << channel << endl;
-        errorCountAll++;
-      }
-      
-      if( triggerSample->head() ) {
-        if( triggerSample->error() ) {
-          cout << "head error found: " << rce << " feb: " << feb << " hybrid: " << hybrid << " apv: " << apv << " channel: " << channel << endl;
-          errorCountHead++;
-        }
-      }
-      
-      
-      
-      
-      
-    } // iSampleCount
-    
-    
-    eventCount++;
+    tiEvents++;
+
+    if( debug > 0 && !builtEvent->complete() )
+      cout << "TI event " << builtEvent->tiEventNumber() << " is missing " << builtEvent->missing() << " banks" << endl;
+
+    if( numEvents > 0 && eventCount > numEvents ) done = true;
   } // while data read OK
   
   
   printf("Clean data read\n");
+  builder.dumpStats();
   dataRead->close();
   delete dataRead;
   delete triggerSample;
   
-  cout << "File " << argv[1] << " tiEvents " << tiEvents << " errorCountAll " << errorCountAll << " errorCountHead: " << errorCountHead << endl;
+  cout << "File " << argv[1] << " tiEvents " << tiEvents << " banks " << eventCount << " errorCountAll " << errorCountAll << " errorCountHead: " << errorCountHead << endl;
+  cout << "Banks not built into events: late " << builder.lateCount() << " without TI data " << builder.noTiCount() << " duplicated " << builder.duplicateCount() << endl;
 
   return 0;
 
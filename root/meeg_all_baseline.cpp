@@ -37,6 +37,8 @@
 #include <Data.h>
 #include <DataRead.h>
 #include <DataReadEvio.h>
+#include <RunningStats.h>
+#include <SvtConditions.h>
 #include <unistd.h>
 using namespace std;
 
@@ -48,6 +50,16 @@ using namespace std;
 //#define corr1 604
 //#define corr2 500
 
+// Next event; in live mode wait for data until the run stops
+bool nextEvent(DataRead *dataRead, Data *event, bool live)
+{
+    while (true) {
+        if (dataRead->next(event)) return true;
+        if (!live || dataRead->sawRunStop()) return false;
+        usleep(1000);
+    }
+}
+
 // Process the data
 // Pass root file to open as first and only arg.
 int main ( int argc, char **argv ) {
@@ -61,6 +73,11 @@ int main ( int argc, char **argv ) {
     int use_hybrid = -1;
     int num_events = -1;
     double threshold_sigma = 2.0;
+    double mean_target = 0.0;
+    double sigma_target = 0.0;
+    bool stopped_early = false;
+    string shared_system = "";
+    int shared_id = 1;
     int c;
     TCanvas         *c1;
     int chanMap[128];
@@ -73,6 +90,7 @@ int main ( int argc, char **argv ) {
     int *channelAllCount[MAX_RCE][MAX_FEB][MAX_HYB];
     double *channelMean[7][MAX_RCE][MAX_FEB][MAX_HYB];
     double *channelVariance[7][MAX_RCE][MAX_FEB][MAX_HYB];
+    RunningStats *channelStats[MAX_RCE][MAX_FEB][MAX_HYB];
     for (int rce = 0;rce<MAX_RCE;rce++)
         for (int fpga = 0;fpga<MAX_FEB;fpga++)
             for (int hyb = 0;hyb<MAX_HYB;hyb++) {
@@ -98,7 +116,7 @@ int main ( int argc, char **argv ) {
     TGraph          *graph[7];
     TMultiGraph *mg;
 
-    while ((c = getopt(argc,argv,"ho:nmct:H:F:e:Es:b:V")) !=-1)
+    while ((c = getopt(argc,argv,"ho:nmct:H:F:e:Es:b:Va:r:L:i:")) !=-1)
         switch (c)
         {
             case 'h':
@@ -115,6 +133,10 @@ int main ( int argc, char **argv ) {
                 printf("-s: number of sigmas for threshold file (default 2)\n");
                 printf("-b: EVIO bank number for SVT (default 3)\n");
                 printf("-V: use TriggerEvent event format\n");
+                printf("-a: stop once the error on every channel's mean is below specified ADC counts\n");
+                printf("-r: stop once the relative error on every channel's sigma is below specified value\n");
+                printf("-L: read live data from shared memory of specified system until the run stops or converges\n");
+                printf("-i: shared memory id for -L (default 1)\n");
                 return(0);
                 break;
             case 'o':
@@ -155,6 +177,18 @@ int main ( int argc, char **argv ) {
             case 'V':
                 triggerevent_format = true;
                 break;
+            case 'a':
+                mean_target = atof(optarg);
+                break;
+            case 'r':
+                sigma_target = atof(optarg);
+                break;
+            case 'L':
+                shared_system = optarg;
+                break;
+            case 'i':
+                shared_id = atoi(optarg);
+                break;
             case '?':
                 printf("Invalid option or missing option argument; -h to list options\n");
                 return(1);
@@ -168,7 +202,13 @@ int main ( int argc, char **argv ) {
         hybrid_type = 1;
     }
 
-    if (evio_format) {
+    BaselineConvergence convergence(mean_target,sigma_target);
+    bool live = (shared_system!="");
+
+    if (live) {
+        dataRead = new DataRead();
+        evio_format = false;
+    } else if (evio_format) {
         DataReadEvio *tmpDataRead = new DataReadEvio();
         if (triggerevent_format)
             tmpDataRead->set_engrun(true);
@@ -192,11 +232,12 @@ int main ( int argc, char **argv ) {
     //   TApplication theApp("App",NULL,NULL);
 
     // Root file is the first and only arg
-    if ( argc-optind != 1 ) {
+    if ( argc-optind != (live?0:1) ) {
         cout << "Usage: meeg_baseline data_file\n";
         return(1);
     }
 
+    if (inname=="" && live) inname = "live";
     if (inname=="")
     {
         inname=argv[optind];
@@ -221,11 +262,24 @@ int main ( int argc, char **argv ) {
     outfile.open(inname+".basecal");
     outfile << "#" << inname << endl;
 
-    cout << "Reading data file " <<argv[optind] << endl;
-    // Attempt to open data file
-    if ( ! dataRead->open(argv[optind]) ) return(2);
+    SvtConditions conditions;
+    conditions.setSource(inname.Data());
 
-    TString confname=argv[optind];
+    if (live) {
+        cout << "Reading shared memory for system " << shared_system << endl;
+        try {
+            dataRead->openShared(shared_system,shared_id);
+        } catch ( string error ) {
+            cout << error << endl;
+            return(2);
+        }
+    } else {
+        cout << "Reading data file " <<argv[optind] << endl;
+        // Attempt to open data file
+        if ( ! dataRead->open(argv[optind]) ) return(2);
+    }
+
+    TString confname=live?inname:argv[optind];
     confname.ReplaceAll(".bin","");
     confname.Append(".conf");
     if (confname.Contains('/')) {
@@ -239,9 +293,13 @@ int main ( int argc, char **argv ) {
     bool readOK;
 
     if (triggerevent_format) {
-        dataRead->next(&triggerevent);
+        readOK = nextEvent(dataRead,&triggerevent,live);
     } else {
-        dataRead->next(&event);
+        readOK = nextEvent(dataRead,&event,live);
+    }
+    if (!readOK) {
+        cout << "No data" << endl;
+        return(2);
     }
     outconfig << dataRead->getConfigXml();
     outconfig << endl;
@@ -344,6 +402,7 @@ int main ( int argc, char **argv ) {
                         channelMean[j][rce][fpga][hyb] = new double[640];
                         channelVariance[j][rce][fpga][hyb] = new double[640];
                     }
+                    channelStats[rce][fpga][hyb] = new RunningStats[640*6];
                     for (int i=0;i<640;i++) {
                         channelCount[rce][fpga][hyb][i] = 0;
                         channelAllCount[rce][fpga][hyb][i] = 0;
@@ -360,6 +419,7 @@ int main ( int argc, char **argv ) {
                     int value = samples[y];
                     if (value<1000)
                         printf("out of range: event %d, rce = %d, feb = %d, hyb = %d, channel = %d, sample[%d] = %d\n",eventCount,rce,fpga,hyb,channel,y,samples[y]);
+                    channelStats[rce][fpga][hyb][channel*6+y].add(value);
                     double delta = value-channelMean[y][rce][fpga][hyb][channel];
                     if (channelCount[rce][fpga][hyb][channel]==1)
                     {
@@ -394,15 +454,39 @@ int main ( int argc, char **argv ) {
            if (channelMean[6][i]<200) printf("event %d, channel %d, %f\n",eventCount,i,channelMean[6][i]);
            }*/
 
+        if (convergence.enabled() && eventCount%100==0) {
+            convergence.begin();
+            for (int rce = 0;rce<MAX_RCE;rce++)
+                for (int fpga = 0;fpga<MAX_FEB;fpga++)
+                    for (int hyb = 0;hyb<MAX_HYB;hyb++) if (hybridCount[rce][fpga][hyb])
+                        convergence.check(channelStats[rce][fpga][hyb],640*6);
+            if (eventCount%1000==0)
+                printf("%d of %d channel samples above target, worst mean error %f, worst relative sigma error %f\n",convergence.pending(),convergence.active(),convergence.worstMeanError(),convergence.worstSigmaError());
+            if (convergence.done()) {
+                printf("Converged after %d events: worst mean error %f, worst relative sigma error %f\n",eventCount,convergence.worstMeanError(),convergence.worstSigmaError());
+                stopped_early = true;
+
+                // Tells the DAQ the calibration run can end
+                if (live) {
+                    ofstream donefile;
+                    cout << "Writing convergence flag to " << inname+".converged" << endl;
+                    donefile.open(inname+".converged");
+                    donefile << eventCount << "\t" << convergence.worstMeanError() << "\t" << convergence.worstSigmaError() << endl;
+                    donefile.close();
+                }
+                break;
+            }
+        }
+
         if (triggerevent_format) {
-            readOK = dataRead->next(&triggerevent);
+            readOK = nextEvent(dataRead,&triggerevent,live);
         } else {
-            readOK = dataRead->next(&event);
+            readOK = nextEvent(dataRead,&event,live);
         }
     } while (readOK);
     dataRead->close();
 
-    if (!evio_format && eventCount != runCount)
+    if (!evio_format && !live && !stopped_early && eventCount != runCount)
     {
         printf("ERROR: events read = %d, runCount = %d\n",eventCount, runCount);
     }
@@ -421,7 +505,7 @@ int main ( int argc, char **argv ) {
                         {
                             printf("Counted %d events on channel %d, even though we thought APV %d was dead\n",channelCount[rce][fpga][hyb][i],i,deadAPV);
                         }
-                        if (!evio_format && channelCount[rce][fpga][hyb][i]!=(int)eventCount-20)
+                        if (!evio_format && !live && channelCount[rce][fpga][hyb][i]!=(int)eventCount-20)
                         {
                             printf("Counted %d events for channel %d; expected %d\n",channelCount[rce][fpga][hyb][i],i,eventCount-20);
                         }
@@ -519,6 +603,7 @@ int main ( int argc, char **argv ) {
                     if (channel == 0)
                         threshfile << fpga << "," << hyb << "," << apv << endl;
                     threshfile << apv*128+channel << "," << channelMean[6][rce][fpga][hyb][i] + threshold_sigma*channelVariance[6][rce][fpga][hyb][i] << endl;
+                    conditions.setThreshold(fpga,hyb,apv*128+channel,channelMean[6][rce][fpga][hyb][i] + threshold_sigma*channelVariance[6][rce][fpga][hyb][i]);
                 }
                 for (int i=0;i<640;i++) if (channelCount[rce][fpga][hyb][i]>0)
                 {
@@ -534,11 +619,48 @@ int main ( int argc, char **argv ) {
                         basefile<<channelMean[j][rce][fpga][hyb][i]<<"\t"<<channelVariance[j][rce][fpga][hyb][i]<<"\t";
                     }
                     basefile<<endl;
+
+                    double mean[7], sigma[7];
+                    for (int j=0;j<7;j++)
+                    {
+                        mean[j] = channelMean[j][rce][fpga][hyb][i];
+                        sigma[j] = channelVariance[j][rce][fpga][hyb][i];
+                    }
+                    conditions.setPedestal(rce,fpga,hyb,sensorChannel,mean,sigma);
                 }
             }
+
+    // Achieved precision, as comment lines so the channel rows keep their format
+    convergence.begin();
+    for (int rce = 0;rce<MAX_RCE;rce++)
+        for (int fpga = 0;fpga<MAX_FEB;fpga++)
+            for (int hyb = 0;hyb<MAX_HYB;hyb++) if (hybridCount[rce][fpga][hyb])
+                convergence.check(channelStats[rce][fpga][hyb],640*6);
+    basefile<<"# events "<<eventCount<<(stopped_early?" (converged)":"")<<", worst mean error "<<convergence.worstMeanError()<<", worst relative sigma error "<<convergence.worstSigmaError();
+    if (convergence.enabled()) basefile<<", "<<convergence.pending()<<" of "<<convergence.active()<<" channel samples above target";
+    basefile<<endl;
+    basefile<<"# rce\tfeb\thyb\tchannel\tmean error\trelative sigma error (worst of 6 samples)"<<endl;
+    for (int rce = 0;rce<MAX_RCE;rce++)
+        for (int fpga = 0;fpga<MAX_FEB;fpga++)
+            for (int hyb = 0;hyb<MAX_HYB;hyb++) if (hybridCount[rce][fpga][hyb])
+                for (int i=0;i<640;i++) if (channelCount[rce][fpga][hyb][i]>0)
+                {
+                    int apv = i/128;
+                    int channel = i%128;
+                    if (!flip_channels) apv = 4-apv; //always use physical numbering
+                    double meanError = 0.0, sigmaError = 0.0;
+                    for (int y=0;y<6;y++) {
+                        meanError = max(meanError,channelStats[rce][fpga][hyb][i*6+y].meanError());
+                        sigmaError = max(sigmaError,channelStats[rce][fpga][hyb][i*6+y].sigmaError());
+                    }
+                    basefile<<"# "<<rce<<"\t"<<fpga<<"\t"<<hyb<<"\t"<<apv*128+channel<<"\t"<<meanError<<"\t"<<sigmaError<<endl;
+                }
     // Start X-Windows
     //theApp.Run();
 
+    cout << "Writing conditions to " << inname+".cond" << endl;
+    conditions.write((inname+".cond").Data());
+
     // Close file
     threshfile.close();
     outfile.close();
@@ -16,6 +16,7 @@
 #include <iostream>
 #include <fstream>
 #include <iomanip>
+#include <algorithm>
 #include <TFile.h>
 #include <TH1F.h>
 #include <TH2S.h>
@@ -38,6 +39,9 @@
 #include <TMultiGraph.h>
 #include <TGraphErrors.h>
 #include <unistd.h>
+#include <pthread.h>
+#include <RunningStats.h>
+#include <SvtConditions.h>
 #include "meeg_utils.hh"
 
 using namespace std;
@@ -50,6 +54,461 @@ using namespace std;
 
 #define N_TIME_CONSTS 2
 
+// Event selection, the same for all input files
+typedef struct {
+    bool debug;
+    bool evio_format;
+    bool triggerevent_format;
+    bool force_cal_grp;
+    bool flip_channels;
+    int use_fpga;
+    int use_hybrid;
+    int num_events;
+    int hybrid_type;
+    int events_per_delay;
+    TString outdir;
+} AllTpSelection;
+
+// One reader thread with its own DataRead and accumulators
+typedef struct {
+    AllTpSelection *sel;
+    DataRead *dataRead;
+    bool hybridFound[MAX_RCE][MAX_FEB][MAX_HYB];
+    RunningStats *allStats[MAX_RCE][MAX_FEB][MAX_HYB]; // [channel*48+bin]
+    int eventCount; // over all files, for the TriggerEvent cal stage and -e (serial only)
+    int cal_grp;
+    int cal_delay;
+    bool read_temp;
+} AllTpReader;
+
+// Input files still to be read, with the cal group and delay each one starts
+// with. tpLock guards tpNextFile.
+static char **tpFiles;
+static int *tpFileGrp;
+static int *tpFileDelay;
+static int tpFileCount;
+static int tpNextFile;
+static pthread_mutex_t tpLock = PTHREAD_MUTEX_INITIALIZER;
+
+// Read one file into the reader's accumulators
+void readFile(AllTpReader *reader, const char *file)
+{
+    DataRead        *dataRead = reader->dataRead;
+    bool (*hybridFound)[MAX_FEB][MAX_HYB] = reader->hybridFound;
+    RunningStats *(*allStats)[MAX_FEB][MAX_HYB] = reader->allStats;
+    int             &eventCount = reader->eventCount;
+    int             &cal_grp = reader->cal_grp;
+    int             &cal_delay = reader->cal_delay;
+    bool            &read_temp = reader->read_temp;
+    bool debug = reader->sel->debug;
+    bool evio_format = reader->sel->evio_format;
+    bool triggerevent_format = reader->sel->triggerevent_format;
+    bool force_cal_grp = reader->sel->force_cal_grp;
+    bool flip_channels = reader->sel->flip_channels;
+    int use_fpga = reader->sel->use_fpga;
+    int use_hybrid = reader->sel->use_hybrid;
+    int num_events = reader->sel->num_events;
+    int hybrid_type = reader->sel->hybrid_type;
+    int events_per_delay = reader->sel->events_per_delay;
+    TString outdir = reader->sel->outdir;
+    DevboardEvent    event;
+    TiTriggerEvent    triggerevent;
+    TriggerSample   *triggersample;
+    int		samples[6];
+    int runCount=0;
+
+    printf("Reading data file %s\n",file);
+    // Attempt to open data file
+    if ( ! dataRead->open(file) ) {
+        printf("bad file: %s\n",file);
+        return;
+    }
+
+    triggersample = new TriggerSample();
+    bool readOK;
+
+    if (triggerevent_format) {
+        dataRead->next(&triggerevent);
+    } else {
+        dataRead->next(&event);
+    }
+
+    if (!evio_format) {
+        TString confname=file;
+        confname.ReplaceAll(".bin","");
+        confname.Append(".conf");
+        if (confname.Contains('/')) {
+            confname.Remove(0,confname.Last('/')+1);
+        }
+
+        ofstream outconfig;
+        printf("Writing configuration to %s%s\n",outdir.Data(),confname.Data());
+        outconfig.open(outdir+confname);
+        outconfig << dataRead->getConfigXml();
+        outconfig << endl;
+        outconfig << dataRead->getStatusXml();
+        outconfig.close();
+
+        runCount = atoi(dataRead->getConfig("RunCount").c_str());
+
+        if (!force_cal_grp)
+        {
+            string cgrp = dataRead->getConfig("cntrlFpga:hybrid:apv25:CalGroup");
+            if (cgrp.length()==0) cgrp = dataRead->getConfig("FrontEndTestFpga:FebCore:Hybrid:apv25:CalGroup");
+            cal_grp = atoi(cgrp.c_str());
+            printf("Read calibration group %d from %s\n",cal_grp,file);
+        }
+
+        string csel = dataRead->getConfig("cntrlFpga:hybrid:apv25:Csel");
+        if (csel.length()==0) csel = dataRead->getConfig("FrontEndTestFpga:FebCore:Hybrid:apv25:Csel");
+        cal_delay = atoi(csel.substr(4,1).c_str());
+        printf("Read calibration delay %d from %s\n",cal_delay,file);
+        if (cal_delay==0)
+        {
+            cal_delay=8;
+            printf("Force cal_delay=8 to keep sample time in range\n");
+        }
+    }
+
+
+    bool found_calgroup = true;
+    //bool checkedGroup[8];
+    // Process each event; the first events skip and the RunCount check count
+    // the events of this file, whatever the number of readers
+    int fileEventCount = 0;
+    do {
+        int rce = 0;
+        int fpga = 0;
+        int samplecount;
+
+        if (triggerevent_format) {
+            samplecount = triggerevent.count();
+        } else {
+            fpga = event.fpgaAddress();
+            samplecount = event.count();
+            if (read_temp && !event.isTiFrame()) for (uint i=0;i<4;i++) {
+                printf("Event %d, temperature #%d: %f\n",eventCount,i,event.temperature(i,hybrid_type==1));
+                read_temp = false;
+            }
+        }
+        if (!triggerevent_format && fpga==7) 
+        {
+            //printf("not a data event\n");
+            continue;
+        }
+        if (eventCount%1000==0) printf("Event %d\n",eventCount);
+        if (num_events!=-1 && eventCount >= num_events) break;
+        //for (int i=0;i<8;i++) {
+        //    checkedGroup[i] = false;
+        //}
+        if (evio_format && triggerevent_format && eventCount%N_ROCS==0) {
+            //found_calgroup = false;
+            int run_stage = eventCount/N_ROCS/events_per_delay;
+            if (force_cal_grp) {
+                cal_delay = (run_stage%8) + 1;
+            } else {
+                cal_grp = run_stage%8;
+                cal_delay = ((run_stage/8)%8) + 1;
+            }
+
+            if( debug ) cout << "cal_grp " << cal_grp << " cal_delay " << cal_delay << " (eventCount " << eventCount << " events_per_delay " << events_per_delay << " run stage " << run_stage << ", N_ROCS " << N_ROCS << ")" << endl;
+
+        }
+        for (int x=0; x < samplecount; x++) {
+            int hyb;
+            int apv;
+            int apvch;
+            int channel;
+
+            bool goodSample = true;
+
+            // Get sample
+            if (triggerevent_format) {
+                triggerevent.sample(x,triggersample);
+                rce = triggersample->rceAddress();
+                fpga = triggersample->febAddress();
+                hyb = triggersample->hybrid();
+                apv = triggersample->apv();
+                apvch = triggersample->channel();
+                goodSample = (!triggersample->head() && !triggersample->tail());
+                for ( int y=0; y < 6; y++ ) {
+                    //printf("%x\n",sample->value(y));
+                    samples[y] = triggersample->value(y);
+                }
+            } else {
+                DevboardSample *sample  = event.sample(x);
+                hyb = sample->hybrid();
+                apv = sample->apv();
+                apvch = sample->channel();
+                for ( int y=0; y < 6; y++ ) {
+                    //printf("%x\n",sample->value(y));
+                    samples[y] = sample->value(y) & 0x3FFF;
+                    if (samples[y]==0) goodSample = false;
+                }
+            }
+            if (use_fpga!=-1 && fpga!=use_fpga) continue;
+            if (use_hybrid!=-1 && hyb!=use_hybrid) continue;
+            if (!goodSample) continue;
+
+            channel = apvch;
+
+            if (flip_channels)
+                channel += (4-apv)*128;
+            else
+                channel += apv*128;
+
+            /*if (rce==0 && fpga==6 && hyb==2 && channel==16) {
+              printf("calgrp %d, caldelay %d, ",cal_grp,cal_delay);
+            */
+            if( debug ) printf("event %8d\tx=%3d\tR%d F%d H%d A%d channel %3d, samples:\t%d\t%d\t%d\t%d\t%d\t%d\n",eventCount,x,rce,fpga,hyb,apv,apvch,samples[0],samples[1],samples[2],samples[3],samples[4],samples[5]);
+        
+            if ( channel >= (5 * 128) ) {
+                printf("Channel %d out of range\n",channel);
+                printf("Apv = %d\n",apv);
+                printf("Chan = %d\n",apvch);
+            }
+
+            if (found_calgroup && (apvch-cal_grp)%8!=0) {
+              if( debug ) cout << "wrong apvch ( apvch " << apvch << " cal_grp " << cal_grp << ": " << (apvch-cal_grp)%8 << ")"  << endl;
+              continue;
+            }
+
+            // Filter APVs
+            //if ( eventCount < 20 ) continue;
+            if (evio_format && triggerevent_format) {
+                if (eventCount%(N_ROCS*events_per_delay)<N_ROCS*8) {
+                    if (debug) cout << " filter out this event  (" << eventCount << ")" << endl;
+                    continue;
+                }
+            } else
+                if (fileEventCount<20) {
+                    if( debug ) cout << " skip first events  (" << fileEventCount << ")" << endl;
+                    continue;
+                }
+            if (!hybridFound[rce][fpga][hyb]) {
+                printf("found new hybrid: rce = %d, feb = %d, hyb = %d\n",rce,fpga,hyb);
+                allStats[rce][fpga][hyb] = new RunningStats[640*48];
+            }
+            hybridFound[rce][fpga][hyb] = true;
+
+            int sum = 0;
+            for ( int y=0; y < 6; y++ ) {
+                sum += samples[y];
+            }
+
+            sum-=6*samples[0];
+            /*if (abs(sum)>8000 && abs(samples[5]-samples[0]) > abs(samples[2]-samples[0])) {
+              printf("event %d, channel %d, sum=%d, %d %d %d %d %d %d\n",eventCount,apvch, sum,samples[0],samples[1],samples[2],samples[3],samples[4],samples[5]);
+              }*/
+            /*
+               if (!checkedGroup[apvch%8] && abs(sum)>5000 && !found_calgroup) {
+            //if (!checkedGroup[apvch%8] && abs(sum)>4500 && abs(samples[5]-samples[0]) < abs(samples[2]-samples[0]) && !found_calgroup) {
+            found_calgroup = true;
+            if (checkedGroup[apvch%8]) printf("sample %d, apvch %d\n",x,apvch);
+            if (apvch%8 != cal_grp)
+            printf("event %d, found calgroup on channel %d, feb %d, hyb %d, apvch %d, sum=%d, %d %d %d %d %d %d\n",eventCount,channel,fpga,hyb,apvch, sum,samples[0],samples[1]-samples[0],samples[2]-samples[0],samples[3]-samples[0],samples[4]-samples[0],samples[5]-samples[0]);
+            }
+            checkedGroup[apvch%8] = true;
+            if (!found_calgroup) continue;*/
+            if (sum<0) continue;
+            //int sgn = eventCount%2;
+            for ( int y=0; y < 6; y++ ) {
+                int bin = 8*y+8-cal_delay;
+                allStats[rce][fpga][hyb][channel*48+bin].add(samples[y]);
+            }
+        }
+        /*
+           if (!found_calgroup && eventCount%N_ROCS!=9) {
+           printf("event %d, didn't find cal group\n",eventCount);
+           }*/
+        eventCount++;
+        fileEventCount++;
+
+        if (triggerevent_format) {
+            readOK = dataRead->next(&triggerevent);
+        } else {
+            readOK = dataRead->next(&event);
+        }
+    } while (readOK);
+    dataRead->close();
+    if (fileEventCount != runCount)
+    {
+        printf("ERROR: %s: events read = %d, runCount = %d\n",file,fileEventCount, runCount);
+    }
+    delete triggersample;
+}
+
+// Reader thread: take files from the list until it is empty
+void *readThread(void *arg)
+{
+    AllTpReader *reader = (AllTpReader *)arg;
+    while (true)
+    {
+        pthread_mutex_lock(&tpLock);
+        int i = tpNextFile++;
+        pthread_mutex_unlock(&tpLock);
+        if (i>=tpFileCount) break;
+        if (!(reader->sel->evio_format && reader->sel->triggerevent_format))
+        {
+            reader->cal_grp = tpFileGrp[i];
+            reader->cal_delay = tpFileDelay[i];
+        }
+        readFile(reader,tpFiles[i]);
+    }
+    return(NULL);
+}
+
+// One channel of the pulse shape fit
+typedef struct {
+    int ni;
+    double ti[48];
+    double yi[48];
+    double ey[48];
+    double noise;
+    double A0;
+    bool fitted;
+    double A;
+    double T0;
+    double Tp[N_TIME_CONSTS];
+    double chisq;
+} AllTpFit;
+
+// Inputs and results of the pulse shape fits
+typedef struct {
+    int nHybrids;
+    int hybFeb[MAX_RCE*MAX_FEB*MAX_HYB];
+    int hybHyb[MAX_RCE*MAX_FEB*MAX_HYB];
+    RunningStats *hybStats[MAX_RCE*MAX_FEB*MAX_HYB];
+    double delay_step;
+    bool move_fitstart;
+    double fit_shift;
+    bool plot_tp_fits;
+    TCanvas *c1;
+    const char *inname;
+    AllTpFit *fits; // [hybrid*640+channel]
+} AllTpFitJob;
+
+// Fit every workers'th channel of all hybrids, starting at worker
+void fitChannels(void *arg, int worker, int workers)
+{
+    AllTpFitJob     *job = (AllTpFitJob *)arg;
+    double delay_step = job->delay_step;
+    bool move_fitstart = job->move_fitstart;
+    double fit_shift = job->fit_shift;
+    bool plot_tp_fits = job->plot_tp_fits;
+    TCanvas         *c1 = job->c1;
+    char            name[100];
+
+    //TF1 *shapingFunction = new TF1("Shaping Function","[0]+[1]*(x>[2])*((x-[2])/[3])*exp(1-((x-[2])/[3]))",-1.0*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL);
+    /*
+       TF1 *shapingFunction = new TF1("Shaping Function",
+       "[0]+\
+       [1]*(x>[2])*\
+       ([3]*[3]/(([3]-[4])*([3]-[4])*([3]-[4])))*(\
+       exp(([2]-x)/[3])-\
+       (1+\
+       (([3]-[4])/([3]*[4]))*(x-[2])+\
+       (([3]-[4])*([3]-[4])/(2*[3]*[4]*[3]*[4]))*(x-[2])*(x-[2]))*exp(([2]-x)/[4]))",
+       -1.0*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL);
+       */
+    TF1 *shapingFunction = new TF1("Shaping Function",fitf_4pole,-1.0*SAMPLE_INTERVAL,5.0*SAMPLE_INTERVAL,5);
+
+    for (int k=worker;k<job->nHybrids*640;k+=workers)
+    {
+        int fpga = job->hybFeb[k/640];
+        int hyb = job->hybHyb[k/640];
+        int i = k%640;
+        RunningStats *stats = &job->hybStats[k/640][i*48];
+        AllTpFit *fit = &job->fits[k];
+        double *yi = fit->yi;
+        double *ey = fit->ey;
+        double *ti = fit->ti;
+        int &ni = fit->ni;
+        TGraphErrors *fitcurve;
+
+        double A, T0, fit_start;
+
+        ni = 0;
+        fit->noise = 0;
+        fit->fitted = false;
+        for (int bin=0;bin<48;bin++)
+        {
+            if (stats[bin].count())
+            {
+                yi[ni] = stats[bin].mean();
+                ey[ni] = stats[bin].rms()/sqrt(stats[bin].count());
+                ti[ni] = (bin-8)*delay_step;
+                ni++;
+                fit->noise+=stats[bin].rms();
+            }
+        }
+        if (ni==0) continue;
+        fit->noise/=ni;
+
+        fitcurve = new TGraphErrors(ni,ti,yi,NULL,ey);
+        shapingFunction->SetParameter(1,TMath::MaxElement(ni,yi)-yi[0]);
+        shapingFunction->SetParameter(2,-10.0);
+        shapingFunction->SetParameter(3,80.0);
+        shapingFunction->SetParameter(4,12.0);
+
+        shapingFunction->FixParameter(0,yi[0]);
+        fit->A0 = yi[0];
+        if (fitcurve->Fit(shapingFunction,"Q0","",-1*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL)==0)
+        {
+            A = shapingFunction->GetParameter(1);
+            T0 = shapingFunction->GetParameter(2);
+            for (int j=0;j<N_TIME_CONSTS;j++) {
+                fit->Tp[j] = shapingFunction->GetParameter(3+j);
+            }
+            if (move_fitstart)
+            {
+                fit_start = T0+fit_shift;
+                fitcurve->Fit(shapingFunction,"Q0","",fit_start,5*SAMPLE_INTERVAL);
+                A = shapingFunction->GetParameter(1);
+                T0 = shapingFunction->GetParameter(2);
+                for (int j=0;j<N_TIME_CONSTS;j++) {
+                    fit->Tp[j] = shapingFunction->GetParameter(3+j);
+                }
+            }
+            fit->fitted = true;
+            fit->A = A;
+            fit->T0 = T0;
+            fit->chisq = shapingFunction->GetChisquare();
+        } else
+        {
+            printf("Could not fit pulse shape for FPGA %d, hybrid %d, channel %d\n",fpga,hyb,i);
+        }
+        if (plot_tp_fits)
+        {
+            c1->Clear();
+            fitcurve->Draw("AL");
+            if (move_fitstart)
+            {
+                shapingFunction->SetLineStyle(1);
+                shapingFunction->SetLineWidth(1);
+                shapingFunction->SetLineColor(2);
+                shapingFunction->SetRange(fit_start,5*SAMPLE_INTERVAL);
+                shapingFunction->DrawCopy("LSAME");
+                shapingFunction->SetRange(-1*SAMPLE_INTERVAL,fit_start);
+                shapingFunction->SetLineStyle(2);
+                shapingFunction->Draw("LSAME");
+            }
+            else
+            {
+                shapingFunction->SetLineStyle(1);
+                shapingFunction->SetLineWidth(1);
+                shapingFunction->SetLineColor(2);
+                shapingFunction->SetRange(-1*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL);
+                shapingFunction->Draw("LSAME");
+            }
+            sprintf(name,"%s_tp_fit_F%d_H%d_%i.png",job->inname,fpga,hyb,i);
+            c1->SaveAs(name);
+        }
+        delete fitcurve;
+    }
+    delete shapingFunction;
+}
+
 // Process the data
 // Pass root file to open as first and only arg.
 int main ( int argc, char **argv ) {
@@ -60,7 +519,6 @@ int main ( int argc, char **argv ) {
     bool force_cal_grp = false;
     bool flip_channels = true;
     bool move_fitstart = false;
-    bool read_temp = true;
     int hybrid_type = 0;
     bool evio_format = false;
     bool triggerevent_format = false;
@@ -76,30 +534,14 @@ int main ( int argc, char **argv ) {
     int events_per_delay = 1000;
     double delay_step = SAMPLE_INTERVAL/8;
     TCanvas         *c1;
-    bool hybridFound[MAX_RCE][MAX_FEB][MAX_HYB];
-    int **allCounts[MAX_RCE][MAX_FEB][MAX_HYB];
-    double **allMeans[MAX_RCE][MAX_FEB][MAX_HYB];
-    double **allVariances[MAX_RCE][MAX_FEB][MAX_HYB];
-    for (int rce = 0;rce<MAX_RCE;rce++)
-        for (int fpga = 0;fpga<MAX_FEB;fpga++)
-            for (int hyb = 0;hyb<MAX_HYB;hyb++) {
-                hybridFound[rce][fpga][hyb] = false;
-            }
-
-    DataRead        *dataRead;
-    DevboardEvent    event;
-    TiTriggerEvent    triggerevent;
-    TriggerSample   *triggersample = new TriggerSample();
-    int		samples[6];
-    int            eventCount=0;
-    int runCount=0;
+    int jobs = 1;
     char            name[100];
     char            name2[100];
     char title[200];
     double chanChan[640];
     for (int i=0;i<640;i++) chanChan[i] = i;
 
-    while ((c = getopt(argc,argv,"hfrg:o:s:nt:H:F:e:EVN:")) !=-1)
+    while ((c = getopt(argc,argv,"hfrg:o:s:nt:H:F:e:EVN:j:")) !=-1)
         switch (c)
         {
             case 'h':
@@ -118,6 +560,7 @@ int main ( int argc, char **argv ) {
                 printf("-V: use TriggerEvent event format\n");
                 printf("-S: use only specified cal group\n");
                 printf("-N: number of events per delay\n");
+                printf("-j: read files in specified number of threads and fit in as many processes (0 for all cores)\n");
                 return(0);
                 break;
             case 'f':
@@ -166,6 +609,10 @@ int main ( int argc, char **argv ) {
             case 'N':
                 events_per_delay = atoi(optarg);
                 break;
+            case 'j':
+                jobs = atoi(optarg);
+                if (jobs<=0) jobs = numCores();
+                break;
             case '?':
                 printf("Invalid option or missing option argument; -h to list options\n");
                 return(1);
@@ -179,14 +626,6 @@ int main ( int argc, char **argv ) {
         hybrid_type = 1;
     }
 
-    if (evio_format) {
-        DataReadEvio *tmpDataRead = new DataReadEvio();
-        if (triggerevent_format)
-            tmpDataRead->set_engrun(true);
-        dataRead = tmpDataRead;
-    } else 
-        dataRead = new DataRead();
-
     gROOT->SetStyle("Plain");
     gStyle->SetPalette(1,0);
     gStyle->SetOptStat("emrou");
@@ -227,437 +666,239 @@ int main ( int argc, char **argv ) {
     noisefile.open(inname+".noise");
     noisefile << "#" << inname << endl;
 
+    SvtConditions conditions;
+    conditions.setSource(inname.Data());
+
+    // Cal group and delay each file starts with; plain EVIO files step through
+    // the groups and delays in file order
+    tpFiles = argv+optind;
+    tpFileCount = argc-optind;
+    tpFileGrp = new int[tpFileCount];
+    tpFileDelay = new int[tpFileCount];
+    tpNextFile = 0;
     if (!force_cal_grp) cal_grp = 0;
     cal_delay = 1;
-
-    while (optind<argc)
+    for (int i=0;i<tpFileCount;i++)
     {
-        cout << "Reading data file " <<argv[optind] << endl;
-        // Attempt to open data file
-        if ( ! dataRead->open(argv[optind]) ) {
-            printf("bad file: %s\n",argv[optind]);
-        }
-
-        bool readOK;
-
-        if (triggerevent_format) {
-            dataRead->next(&triggerevent);
-        } else {
-            dataRead->next(&event);
-        }
-
-        if (!evio_format) {
-            TString confname=argv[optind];
-            confname.ReplaceAll(".bin","");
-            confname.Append(".conf");
-            if (confname.Contains('/')) {
-                confname.Remove(0,confname.Last('/')+1);
-            }
-
-            ofstream outconfig;
-            cout << "Writing configuration to " <<outdir<<confname << endl;
-            outconfig.open(outdir+confname);
-            outconfig << dataRead->getConfigXml();
-            outconfig << endl;
-            outconfig << dataRead->getStatusXml();
-            outconfig.close();
-
-            runCount = atoi(dataRead->getConfig("RunCount").c_str());
-
-            if (!force_cal_grp)
-            {
-                string cgrp = dataRead->getConfig("cntrlFpga:hybrid:apv25:CalGroup");
-                if (cgrp.length()==0) cgrp = dataRead->getConfig("FrontEndTestFpga:FebCore:Hybrid:apv25:CalGroup");
-                cal_grp = atoi(cgrp.c_str());
-                cout<<"Read calibration group "<<cal_grp<<" from data file"<<endl;
-            }
-
-            string csel = dataRead->getConfig("cntrlFpga:hybrid:apv25:Csel");
-            if (csel.length()==0) csel = dataRead->getConfig("FrontEndTestFpga:FebCore:Hybrid:apv25:Csel");
-            cal_delay = atoi(csel.substr(4,1).c_str());
-            cout<<"Read calibration delay "<<cal_delay<<" from data file"<<endl;
-            if (cal_delay==0)
+        tpFileGrp[i] = cal_grp;
+        tpFileDelay[i] = cal_delay;
+        if (evio_format && !triggerevent_format) {
+            if (!force_cal_grp) cal_grp++;
+            if (cal_grp==8)
             {
-                cal_delay=8;
-                cout<<"Force cal_delay=8 to keep sample time in range"<<endl;
+                cal_grp = 0;
+                cal_delay++;
             }
         }
+    }
 
-
-        bool found_calgroup = true;
-        //bool checkedGroup[8];
-        // Process each event
-        //eventCount = 0;
-        do {
-            int rce = 0;
-            int fpga = 0;
-            int samplecount;
-
-            if (triggerevent_format) {
-                samplecount = triggerevent.count();
-            } else {
-                fpga = event.fpgaAddress();
-                samplecount = event.count();
-                if (read_temp && !event.isTiFrame()) for (uint i=0;i<4;i++) {
-                    printf("Event %d, temperature #%d: %f\n",eventCount,i,event.temperature(i,hybrid_type==1));
-                    read_temp = false;
-                }
-            }
-            if (!triggerevent_format && fpga==7) 
-            {
-                //printf("not a data event\n");
-                continue;
-            }
-            if (eventCount%1000==0) printf("Event %d\n",eventCount);
-            if (num_events!=-1 && eventCount >= num_events) break;
-            //for (int i=0;i<8;i++) {
-            //    checkedGroup[i] = false;
-            //}
-            if (evio_format && triggerevent_format && eventCount%N_ROCS==0) {
-                //found_calgroup = false;
-                int run_stage = eventCount/N_ROCS/events_per_delay;
-                if (force_cal_grp) {
-                    cal_delay = (run_stage%8) + 1;
-                } else {
-                    cal_grp = run_stage%8;
-                    cal_delay = ((run_stage/8)%8) + 1;
-                }
-
-                if( debug ) cout << "cal_grp " << cal_grp << " cal_delay " << cal_delay << " (eventCount " << eventCount << " events_per_delay " << events_per_delay << " run stage " << run_stage << ", N_ROCS " << N_ROCS << ")" << endl;
-
-            }
-            for (int x=0; x < samplecount; x++) {
-                int hyb;
-                int apv;
-                int apvch;
-                int channel;
-
-                bool goodSample = true;
-
-                // Get sample
-                if (triggerevent_format) {
-                    triggerevent.sample(x,triggersample);
-                    rce = triggersample->rceAddress();
-                    fpga = triggersample->febAddress();
-                    hyb = triggersample->hybrid();
-                    apv = triggersample->apv();
-                    apvch = triggersample->channel();
-                    goodSample = (!triggersample->head() && !triggersample->tail());
-                    for ( int y=0; y < 6; y++ ) {
-                        //printf("%x\n",sample->value(y));
-                        samples[y] = triggersample->value(y);
-                    }
-                } else {
-                    DevboardSample *sample  = event.sample(x);
-                    hyb = sample->hybrid();
-                    apv = sample->apv();
-                    apvch = sample->channel();
-                    for ( int y=0; y < 6; y++ ) {
-                        //printf("%x\n",sample->value(y));
-                        samples[y] = sample->value(y) & 0x3FFF;
-                        if (samples[y]==0) goodSample = false;
-                    }
-                }
-                if (use_fpga!=-1 && fpga!=use_fpga) continue;
-                if (use_hybrid!=-1 && hyb!=use_hybrid) continue;
-                if (!goodSample) continue;
-
-                channel = apvch;
-
-                if (flip_channels)
-                    channel += (4-apv)*128;
-                else
-                    channel += apv*128;
-
-                /*if (rce==0 && fpga==6 && hyb==2 && channel==16) {
-                  printf("calgrp %d, caldelay %d, ",cal_grp,cal_delay);
-                */
-                if( debug ) printf("event %8d\tx=%3d\tR%d F%d H%d A%d channel %3d, samples:\t%d\t%d\t%d\t%d\t%d\t%d\n",eventCount,x,rce,fpga,hyb,apv,apvch,samples[0],samples[1],samples[2],samples[3],samples[4],samples[5]);
-            
-                if ( channel >= (5 * 128) ) {
-                    cout << "Channel " << dec << channel << " out of range" << endl;
-                    cout << "Apv = " << dec << apv << endl;
-                    cout << "Chan = " << dec << apvch << endl;
-                }
-
-                if (found_calgroup && (apvch-cal_grp)%8!=0) {
-                  if( debug ) cout << "wrong apvch ( apvch " << apvch << " cal_grp " << cal_grp << ": " << (apvch-cal_grp)%8 << ")"  << endl;
-                  continue;
+    AllTpSelection sel;
+    sel.debug = debug;
+    sel.evio_format = evio_format;
+    sel.triggerevent_format = triggerevent_format;
+    sel.force_cal_grp = force_cal_grp;
+    sel.flip_channels = flip_channels;
+    sel.use_fpga = use_fpga;
+    sel.use_hybrid = use_hybrid;
+    sel.num_events = num_events;
+    sel.hybrid_type = hybrid_type;
+    sel.events_per_delay = events_per_delay;
+    sel.outdir = outdir;
+
+    // TriggerEvent runs take the cal stage from the event count across all
+    // files, and -e counts events across all files: those stay serial
+    int readers = jobs;
+    if (readers>tpFileCount) readers = tpFileCount;
+    if ((evio_format && triggerevent_format) || num_events!=-1) readers = 1;
+
+    AllTpReader *reader = new AllTpReader[readers];
+    pthread_t *threads = new pthread_t[readers];
+    for (int r=0;r<readers;r++)
+    {
+        reader[r].sel = &sel;
+        if (evio_format) {
+            DataReadEvio *tmpDataRead = new DataReadEvio();
+            if (triggerevent_format)
+                tmpDataRead->set_engrun(true);
+            reader[r].dataRead = tmpDataRead;
+        } else 
+            reader[r].dataRead = new DataRead();
+        for (int rce = 0;rce<MAX_RCE;rce++)
+            for (int fpga = 0;fpga<MAX_FEB;fpga++)
+                for (int hyb = 0;hyb<MAX_HYB;hyb++) {
+                    reader[r].hybridFound[rce][fpga][hyb] = false;
+                    reader[r].allStats[rce][fpga][hyb] = NULL;
                 }
+        reader[r].eventCount = 0;
+        reader[r].cal_grp = tpFileGrp[0];
+        reader[r].cal_delay = tpFileDelay[0];
+        reader[r].read_temp = (r==0);
+    }
+    if (readers==1) readThread(&reader[0]);
+    else for (int r=0;r<readers;r++)
+    {
+        if (pthread_create(&threads[r],NULL,readThread,&reader[r])!=0)
+        {
+            cout << "Failed to start reader thread " << r << endl;
+            return(2);
+        }
+    }
 
-                // Filter APVs
-                //if ( eventCount < 20 ) continue;
-                if (evio_format && triggerevent_format) {
-                    if (eventCount%(N_ROCS*events_per_delay)<N_ROCS*8) {
-                        if (debug) cout << " filter out this event  (" << eventCount << ")" << endl;
-                        continue;
-                    }
-                } else
-                    if (eventCount<20) {
-                        if( debug ) cout << " skip first events  (" << eventCount << ")" << endl;
-                        continue;
-                    }
-                if (!hybridFound[rce][fpga][hyb]) {
-                    printf("found new hybrid: rce = %d, feb = %d, hyb = %d\n",rce,fpga,hyb);
-                    //allCounts[rce][fpga][hyb] = new int[640][48];
-                    //allMeans[rce][fpga][hyb] = new double[640][48];
-                    //allVariances[rce][fpga][hyb] = new double[640][48];
-                    allCounts[rce][fpga][hyb] = new int*[640];
-                    allMeans[rce][fpga][hyb] = new double*[640];
-                    allVariances[rce][fpga][hyb] = new double*[640];
-                    for (int i=0;i<640;i++) {
-                        allCounts[rce][fpga][hyb][i] = new int[48];
-                        allMeans[rce][fpga][hyb][i] = new double[48];
-                        allVariances[rce][fpga][hyb][i] = new double[48];
-                        for (int j=0;j<48;j++) {
-                            allCounts[rce][fpga][hyb][i][j] = 0;
-                            allMeans[rce][fpga][hyb][i][j] = 0.0;
-                            allVariances[rce][fpga][hyb][i][j] = 0.0;
+    // Merge into the first reader only after all threads are done
+    if (readers>1) for (int r=0;r<readers;r++) pthread_join(threads[r],NULL);
+    bool (*hybridFound)[MAX_FEB][MAX_HYB] = reader[0].hybridFound;
+    RunningStats *(*allStats)[MAX_FEB][MAX_HYB] = reader[0].allStats;
+    for (int r=1;r<readers;r++)
+        for (int rce = 0;rce<MAX_RCE;rce++)
+            for (int fpga = 0;fpga<MAX_FEB;fpga++)
+                for (int hyb = 0;hyb<MAX_HYB;hyb++)
+                    if (reader[r].hybridFound[rce][fpga][hyb])
+                    {
+                        if (!hybridFound[rce][fpga][hyb])
+                        {
+                            hybridFound[rce][fpga][hyb] = true;
+                            allStats[rce][fpga][hyb] = reader[r].allStats[rce][fpga][hyb];
+                            continue;
                         }
+                        for (int k=0;k<640*48;k++)
+                            allStats[rce][fpga][hyb][k].merge(&reader[r].allStats[rce][fpga][hyb][k]);
+                        delete[] reader[r].allStats[rce][fpga][hyb];
                     }
-                }
-                hybridFound[rce][fpga][hyb] = true;
+    for (int r=0;r<readers;r++) delete reader[r].dataRead;
+    delete[] threads;
 
-                int sum = 0;
-                for ( int y=0; y < 6; y++ ) {
-                    sum += samples[y];
-                }
 
-                sum-=6*samples[0];
-                /*if (abs(sum)>8000 && abs(samples[5]-samples[0]) > abs(samples[2]-samples[0])) {
-                  printf("event %d, channel %d, sum=%d, %d %d %d %d %d %d\n",eventCount,apvch, sum,samples[0],samples[1],samples[2],samples[3],samples[4],samples[5]);
-                  }*/
-                /*
-                   if (!checkedGroup[apvch%8] && abs(sum)>5000 && !found_calgroup) {
-                //if (!checkedGroup[apvch%8] && abs(sum)>4500 && abs(samples[5]-samples[0]) < abs(samples[2]-samples[0]) && !found_calgroup) {
-                found_calgroup = true;
-                if (checkedGroup[apvch%8]) printf("sample %d, apvch %d\n",x,apvch);
-                if (apvch%8 != cal_grp)
-                printf("event %d, found calgroup on channel %d, feb %d, hyb %d, apvch %d, sum=%d, %d %d %d %d %d %d\n",eventCount,channel,fpga,hyb,apvch, sum,samples[0],samples[1]-samples[0],samples[2]-samples[0],samples[3]-samples[0],samples[4]-samples[0],samples[5]-samples[0]);
-                }
-                checkedGroup[apvch%8] = true;
-                if (!found_calgroup) continue;*/
-                if (sum<0) continue;
-                //int sgn = eventCount%2;
-                for ( int y=0; y < 6; y++ ) {
-                    int bin = 8*y+8-cal_delay;
-                    allCounts[rce][fpga][hyb][channel][bin]++;
-                    double delta = samples[y]-allMeans[rce][fpga][hyb][channel][bin];
-                    if (allCounts[rce][fpga][hyb][channel][bin]==1)
-                    {
-                        allMeans[rce][fpga][hyb][channel][bin] = samples[y];
-                    }
-                    else
-                    {
-                        allMeans[rce][fpga][hyb][channel][bin] += delta/allCounts[rce][fpga][hyb][channel][bin];
-                    }
-                    allVariances[rce][fpga][hyb][channel][bin] += delta*(samples[y]-allMeans[rce][fpga][hyb][channel][bin]);
+    AllTpFitJob fitJob;
+    fitJob.nHybrids = 0;
+    for (int rce = 0;rce<MAX_RCE;rce++)
+        for (int fpga = 0;fpga<MAX_FEB;fpga++)
+            for (int hyb = 0;hyb<MAX_HYB;hyb++)
+                if (hybridFound[rce][fpga][hyb])
+                {
+                    fitJob.hybFeb[fitJob.nHybrids] = fpga;
+                    fitJob.hybHyb[fitJob.nHybrids] = hyb;
+                    fitJob.hybStats[fitJob.nHybrids] = allStats[rce][fpga][hyb];
+                    fitJob.nHybrids++;
                 }
-            }
-            /*
-               if (!found_calgroup && eventCount%N_ROCS!=9) {
-               printf("event %d, didn't find cal group\n",eventCount);
-               }*/
-            eventCount++;
+    fitJob.delay_step = delay_step;
+    fitJob.move_fitstart = move_fitstart;
+    fitJob.fit_shift = fit_shift;
+    fitJob.plot_tp_fits = plot_tp_fits;
+    fitJob.c1 = c1;
+    fitJob.inname = inname.Data();
+
+    // Fits run in forked processes, plots need the canvas of this one
+    int fit_workers = plot_tp_fits?1:jobs;
+    fitJob.fits = (AllTpFit *)sharedAlloc((fitJob.nHybrids*640+1)*sizeof(AllTpFit));
+    if (fitJob.fits==NULL)
+    {
+        fitJob.fits = new AllTpFit[fitJob.nHybrids*640+1]();
+        fit_workers = 1;
+    }
+    forkWorkers(fit_workers,fitChannels,&fitJob);
 
-            if (triggerevent_format) {
-                readOK = dataRead->next(&triggerevent);
-            } else {
-                readOK = dataRead->next(&event);
-            }
-            } while (readOK);
-                dataRead->close();
-                if (eventCount != runCount)
+    // Write out in hybrid and channel order; shape rows of failed fits use the last good A and T0
+    int k = 0;
+    double A = 0.0, T0 = 0.0;
+    for (int rce = 0;rce<MAX_RCE;rce++)
+        for (int fpga = 0;fpga<MAX_FEB;fpga++)
+            for (int hyb = 0;hyb<MAX_HYB;hyb++)
+                if (hybridFound[rce][fpga][hyb])
                 {
-                    printf("ERROR: events read = %d, runCount = %d\n",eventCount, runCount);
-                }
-                optind++;
-                if (evio_format && !triggerevent_format) {
-                    if (!force_cal_grp) cal_grp++;
-                    if (cal_grp==8)
+                    double chanNoise[640];
+                    double chanTp[N_TIME_CONSTS][640];
+                    double chanT0[640];
+                    double chanA[640];
+                    double chanChisq[640];
+                    for (int i=0;i<640;i++,k++)
                     {
-                        cal_grp = 0;
-                        cal_delay++;
-                    }
-                }
-            }
-
-
-            //TF1 *shapingFunction = new TF1("Shaping Function","[0]+[1]*(x>[2])*((x-[2])/[3])*exp(1-((x-[2])/[3]))",-1.0*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL);
-            /*
-               TF1 *shapingFunction = new TF1("Shaping Function",
-               "[0]+\
-               [1]*(x>[2])*\
-               ([3]*[3]/(([3]-[4])*([3]-[4])*([3]-[4])))*(\
-               exp(([2]-x)/[3])-\
-               (1+\
-               (([3]-[4])/([3]*[4]))*(x-[2])+\
-               (([3]-[4])*([3]-[4])/(2*[3]*[4]*[3]*[4]))*(x-[2])*(x-[2]))*exp(([2]-x)/[4]))",
-               -1.0*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL);
-               */
-            TF1 *shapingFunction = new TF1("Shaping Function",fitf_4pole,-1.0*SAMPLE_INTERVAL,5.0*SAMPLE_INTERVAL,5);
-
-            for (int rce = 0;rce<MAX_RCE;rce++)
-                for (int fpga = 0;fpga<MAX_FEB;fpga++)
-                    for (int hyb = 0;hyb<MAX_HYB;hyb++)
-                        if (hybridFound[rce][fpga][hyb])
+                        AllTpFit *fit = &fitJob.fits[k];
+                        chanNoise[i] = 0;
+                        for (int j=0;j<N_TIME_CONSTS;j++) {
+                            chanTp[j][i] = 0;
+                        }
+                        chanT0[i] = 0;
+                        chanA[i] = 0;
+                        chanChisq[i] = 0;
+                        if (fit->ni==0) continue;
+                        chanNoise[i] = fit->noise;
+                        noisefile << rce << "\t" << fpga << "\t" << hyb << "\t" << i << "\t";
+                        noisefile << chanNoise[i] << endl;
+
+                        if (fit->fitted)
                         {
-                            double chanNoise[640];
-                            double chanTp[N_TIME_CONSTS][640];
-                            double chanT0[640];
-                            double chanA[640];
-                            double chanChisq[640];
-                            for (int i=0;i<640;i++)
-                            {
-                                chanNoise[i] = 0;
-                                for (int j=0;j<N_TIME_CONSTS;j++) {
-                                    chanTp[j][i] = 0;
-                                }
-                                chanT0[i] = 0;
-                                chanA[i] = 0;
-                                chanChisq[i] = 0;
-                                double yi[48], ey[48], ti[48];
-                                int ni = 0;
-                                TGraphErrors *fitcurve;
-
-                                double A, T0, A0, fit_start;
-
-                                for (int bin=0;bin<48;bin++)
-                                {
-                                    if (allCounts[rce][fpga][hyb][i][bin])
-                                    {
-                                        allVariances[rce][fpga][hyb][i][bin]/=allCounts[rce][fpga][hyb][i][bin];
-                                        allVariances[rce][fpga][hyb][i][bin]=sqrt(allVariances[rce][fpga][hyb][i][bin]);
-                                        yi[ni] = allMeans[rce][fpga][hyb][i][bin];
-                                        ey[ni] = allVariances[rce][fpga][hyb][i][bin]/sqrt(allCounts[rce][fpga][hyb][i][bin]);
-                                        ti[ni] = (bin-8)*delay_step;
-                                        ni++;
-                                        chanNoise[i]+=allVariances[rce][fpga][hyb][i][bin];
-                                    }
-                                }
-                                if (ni==0) continue;
-                                chanNoise[i]/=ni;
-                                noisefile << rce << "\t" << fpga << "\t" << hyb << "\t" << i << "\t";
-                                noisefile << chanNoise[i] << endl;
-
-                                fitcurve = new TGraphErrors(ni,ti,yi,NULL,ey);
-                                shapingFunction->SetParameter(1,TMath::MaxElement(ni,yi)-yi[0]);
-                                shapingFunction->SetParameter(2,-10.0);
-                                shapingFunction->SetParameter(3,80.0);
-                                shapingFunction->SetParameter(4,12.0);
-
-                                shapingFunction->FixParameter(0,yi[0]);
-                                A0 = yi[0];
-                                if (fitcurve->Fit(shapingFunction,"Q0","",-1*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL)==0)
-                                {
-                                    A = shapingFunction->GetParameter(1);
-                                    T0 = shapingFunction->GetParameter(2);
-                                    for (int j=0;j<N_TIME_CONSTS;j++) {
-                                        chanTp[j][i] = shapingFunction->GetParameter(3+j);
-                                    }
-                                    if (move_fitstart)
-                                    {
-                                        fit_start = T0+fit_shift;
-                                        fitcurve->Fit(shapingFunction,"Q0","",fit_start,5*SAMPLE_INTERVAL);
-                                        A = shapingFunction->GetParameter(1);
-                                        T0 = shapingFunction->GetParameter(2);
-                                        for (int j=0;j<N_TIME_CONSTS;j++) {
-                                            chanTp[j][i] = shapingFunction->GetParameter(3+j);
-                                        }
-                                    }
-                                    chanA[i] = A;
-                                    chanT0[i] = T0;
-                                    chanChisq[i] = shapingFunction->GetChisquare();
-                                } else
-                                {
-                                    printf("Could not fit pulse shape for FPGA %d, hybrid %d, channel %d\n",fpga,hyb,i);
-                                }
-                                if (plot_tp_fits)
-                                {
-                                    c1->Clear();
-                                    fitcurve->Draw("AL");
-                                    if (move_fitstart)
-                                    {
-                                        shapingFunction->SetLineStyle(1);
-                                        shapingFunction->SetLineWidth(1);
-                                        shapingFunction->SetLineColor(2);
-                                        shapingFunction->SetRange(fit_start,5*SAMPLE_INTERVAL);
-                                        shapingFunction->DrawCopy("LSAME");
-                                        shapingFunction->SetRange(-1*SAMPLE_INTERVAL,fit_start);
-                                        shapingFunction->SetLineStyle(2);
-                                        shapingFunction->Draw("LSAME");
-                                    }
-                                    else
-                                    {
-                                        shapingFunction->SetLineStyle(1);
-                                        shapingFunction->SetLineWidth(1);
-                                        shapingFunction->SetLineColor(2);
-                                        shapingFunction->SetRange(-1*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL);
-                                        shapingFunction->Draw("LSAME");
-                                    }
-                                    sprintf(name,"%s_tp_fit_F%d_H%d_%i.png",inname.Data(),fpga,hyb,i);
-                                    c1->SaveAs(name);
-                                }
-                                delete fitcurve;
-
-                                shapefile << rce << "\t" << fpga << "\t" << hyb << "\t" << i << "\t";
-                                for (int j=0;j<ni;j++)
-                                {
-                                    shapefile<<"\t"<<ti[j]-T0<<"\t"<<(yi[j]-A0)/A<<"\t"<<ey[j]/A;
-                                }
-                                shapefile<<endl;
-
-                                tpfile << rce << "\t" << fpga << "\t" << hyb << "\t" << i << "\t";
-                                tpfile << chanA[i]<<"\t"<<chanT0[i]<<"\t";
-                                for (int j=0;j<N_TIME_CONSTS;j++) {
-                                    if (chanTp[j][i]>1000)
-                                        tpfile <<1000<<"\t";
-                                    else
-                                        tpfile <<chanTp[j][i]<<"\t";
-                                }
-                                tpfile <<chanChisq[i]<<endl;
-                            }
-                            if (plot_fit_results)
-                            {
-                                c1->SetLogy(0);
-                                sprintf(name,"A_R%d_F%d_H%d",rce,fpga,hyb);
-                                sprintf(name2,"%s_tp_R%d_F%d_H%d_A.png",inname.Data(),rce,fpga,hyb);
-                                sprintf(title,"Fitted amplitude;Channel;Amplitude [ADC counts]");
-                                plotResults(title, name, name2, 640, chanChan, chanA, c1);
-
-                                c1->SetLogy(0);
-                                sprintf(name,"T0_R%d_F%d_H%d",rce,fpga,hyb);
-                                sprintf(name2,"%s_tp_R%d_F%d_H%d_T0.png",inname.Data(),rce,fpga,hyb);
-                                sprintf(title,"Fitted T0;Channel;T0 [ns]");
-                                plotResults(title, name, name2, 640, chanChan, chanT0, c1);
-
-                                for (int j=0;j<N_TIME_CONSTS;j++) {
-                                    c1->SetLogy(0);
-                                    sprintf(name,"Tp%d_R%d_F%d_H%d",j+1,rce,fpga,hyb);
-                                    sprintf(name2,"%s_tp_R%d_F%d_H%d_Tp%d.png",inname.Data(),rce,fpga,hyb,j+1);
-                                    sprintf(title,"Fitted Tp%d;Channel;Tp [ns]",j+1);
-                                    plotResults(title, name, name2, 640, chanChan, chanTp[j], c1);
-                                }
-
-                                c1->SetLogy(0);
-                                sprintf(name,"Chisq_R%d_F%d_H%d",rce,fpga,hyb);
-                                sprintf(name2,"%s_tp_R%d_F%d_H%d_Chisq.png",inname.Data(),rce,fpga,hyb);
-                                sprintf(title,"Fit chisq;Channel;Chisq");
-                                plotResults(title, name, name2, 640, chanChan, chanChisq, c1);
-
-                                c1->SetLogy(0);
-                                sprintf(name,"Noise_R%d_F%d_H%d",rce,fpga,hyb);
-                                sprintf(name2,"%s_tp_R%d_F%d_H%d_Noise.png",inname.Data(),rce,fpga,hyb);
-                                sprintf(title,"Mean RMS noise per sample;Channel;Noise [ADC counts]");
-                                plotResults(title, name, name2, 640, chanChan, chanNoise, c1);
+                            A = fit->A;
+                            T0 = fit->T0;
+                            chanA[i] = A;
+                            chanT0[i] = T0;
+                            for (int j=0;j<N_TIME_CONSTS;j++) {
+                                chanTp[j][i] = fit->Tp[j];
                             }
+                            chanChisq[i] = fit->chisq;
+                        }
 
+                        shapefile << rce << "\t" << fpga << "\t" << hyb << "\t" << i << "\t";
+                        for (int j=0;j<fit->ni;j++)
+                        {
+                            shapefile<<"\t"<<fit->ti[j]-T0<<"\t"<<(fit->yi[j]-fit->A0)/A<<"\t"<<fit->ey[j]/A;
+                        }
+                        shapefile<<endl;
+
+                        tpfile << rce << "\t" << fpga << "\t" << hyb << "\t" << i << "\t";
+                        tpfile << chanA[i]<<"\t"<<chanT0[i]<<"\t";
+                        for (int j=0;j<N_TIME_CONSTS;j++) {
+                            if (chanTp[j][i]>1000)
+                                tpfile <<1000<<"\t";
+                            else
+                                tpfile <<chanTp[j][i]<<"\t";
+                        }
+                        tpfile <<chanChisq[i]<<endl;
+                        conditions.setTp(rce,fpga,hyb,i,chanA[i],chanT0[i],min(chanTp[0][i],1000.0),min(chanTp[1][i],1000.0),chanChisq[i]);
+                    }
+                    if (plot_fit_results)
+                    {
+                        c1->SetLogy(0);
+                        sprintf(name,"A_R%d_F%d_H%d",rce,fpga,hyb);
+                        sprintf(name2,"%s_tp_R%d_F%d_H%d_A.png",inname.Data(),rce,fpga,hyb);
+                        sprintf(title,"Fitted amplitude;Channel;Amplitude [ADC counts]");
+                        plotResults(title, name, name2, 640, chanChan, chanA, c1);
+
+                        c1->SetLogy(0);
+                        sprintf(name,"T0_R%d_F%d_H%d",rce,fpga,hyb);
+                        sprintf(name2,"%s_tp_R%d_F%d_H%d_T0.png",inname.Data(),rce,fpga,hyb);
+                        sprintf(title,"Fitted T0;Channel;T0 [ns]");
+                        plotResults(title, name, name2, 640, chanChan, chanT0, c1);
+
+                        for (int j=0;j<N_TIME_CONSTS;j++) {
+                            c1->SetLogy(0);
+                            sprintf(name,"Tp%d_R%d_F%d_H%d",j+1,rce,fpga,hyb);
+                            sprintf(name2,"%s_tp_R%d_F%d_H%d_Tp%d.png",inname.Data(),rce,fpga,hyb,j+1);
+                            sprintf(title,"Fitted Tp%d;Channel;Tp [ns]",j+1);
+                            plotResults(title, name, name2, 640, chanChan, chanTp[j], c1);
                         }
 
-            // Close file
-            tpfile.close();
-            shapefile.close();
-            noisefile.close();
-            return(0);
-        }
+                        c1->SetLogy(0);
+                        sprintf(name,"Chisq_R%d_F%d_H%d",rce,fpga,hyb);
+                        sprintf(name2,"%s_tp_R%d_F%d_H%d_Chisq.png",inname.Data(),rce,fpga,hyb);
+                        sprintf(title,"Fit chisq;Channel;Chisq");
+                        plotResults(title, name, name2, 640, chanChan, chanChisq, c1);
+
+                        c1->SetLogy(0);
+                        sprintf(name,"Noise_R%d_F%d_H%d",rce,fpga,hyb);
+                        sprintf(name2,"%s_tp_R%d_F%d_H%d_Noise.png",inname.Data(),rce,fpga,hyb);
+                        sprintf(title,"Mean RMS noise per sample;Channel;Noise [ADC counts]");
+                        plotResults(title, name, name2, 640, chanChan, chanNoise, c1);
+                    }
+
+                }
+
+    cout << "Writing conditions to " << inname+".cond" << endl;
+    conditions.write((inname+".cond").Data());
+
+    // Close file
+    tpfile.close();
+    shapefile.close();
+    noisefile.close();
+    return(0);
+}
 
@@ -37,6 +37,8 @@
 #include <Data.h>
 #include <DataRead.h>
 #include <DataReadEvio.h>
+#include <RunningStats.h>
+#include <Telemetry.h>
 #include <unistd.h>
 using namespace std;
 
@@ -53,6 +55,8 @@ int main ( int argc, char **argv ) {
     bool skip_corr = false;
     bool read_temp = true;
     int hybrid_type = 0;
+    int telemetry_interval = 0;
+    Telemetry telemetry;
     bool evio_format = false;
     bool triggerevent_format = false;
     bool subtract_reference = false;
@@ -60,6 +64,9 @@ int main ( int argc, char **argv ) {
     int use_hybrid = -1;
     int num_events = -1;
     int ignore_count = 20;
+    double mean_target = 0.0;
+    double sigma_target = 0.0;
+    bool stopped_early = false;
     int c;
     TCanvas         *c1;
     TH2I            *histAll[7];
@@ -102,6 +109,9 @@ int main ( int argc, char **argv ) {
     double apvVariance[5];
     double hybridVariance = 0.0;
 
+    // Per channel and sample precision for early stopping
+    RunningStats channelStats[640][6];
+
     //TH2S *corrHist;
     //corrHist = new TH2S("corrHist","Channel correlation",16384,-0.5,16383.5,16384,-0.5,16383.5);
 
@@ -129,7 +139,7 @@ int main ( int argc, char **argv ) {
     TGraph          *graph[7];
     TMultiGraph *mg;
 
-    while ((c = getopt(argc,argv,"ho:nmct:H:F:e:EdVS")) !=-1)
+    while ((c = getopt(argc,argv,"ho:nmct:H:F:e:EdVSa:r:T:")) !=-1)
         switch (c)
         {
             case 'h':
@@ -146,6 +156,9 @@ int main ( int argc, char **argv ) {
                 printf("-E: use EVIO file format\n");
                 printf("-V: use TriggerEvent event format\n");
                 printf("-S: subtract channel 639\n");
+                printf("-a: stop once the error on every channel's mean is below specified ADC counts\n");
+                printf("-r: stop once the relative error on every channel's sigma is below specified value\n");
+                printf("-T: write header telemetry to <name>.telem, min/max/mean every specified number of events (not with -V)\n");
                 return(0);
                 break;
             case 'o':
@@ -189,6 +202,15 @@ int main ( int argc, char **argv ) {
             case 'd':
                 debug = true;
                 break;
+            case 'a':
+                mean_target = atof(optarg);
+                break;
+            case 'r':
+                sigma_target = atof(optarg);
+                break;
+            case 'T':
+                telemetry_interval = atoi(optarg);
+                break;
             case '?':
                 printf("Invalid option or missing option argument; -h to list options\n");
                 return(1);
@@ -196,12 +218,20 @@ int main ( int argc, char **argv ) {
                 abort();
         }
 
+    // TriggerEvent frames are read without their TI words here, which Telemetry needs
+    if (telemetry_interval > 0 && triggerevent_format) {
+        printf("-T is not supported with -V; use meeg_telemetry -V\n");
+        return(1);
+    }
+
     if (hybrid_type==0) {
         printf("WARNING: no hybrid type set; use -t to specify old or new hybrid\n");
         printf("Configured for old (test run) hybrid\n");
         hybrid_type = 1;
     }
 
+    BaselineConvergence convergence(mean_target,sigma_target);
+
     if (evio_format)
         dataRead = new DataReadEvio();
     else 
@@ -262,6 +292,12 @@ int main ( int argc, char **argv ) {
     cout << "Writing calibration to " << inname+".base" << endl;
     outfile.open(inname+".base");
 
+    if (telemetry_interval > 0) {
+        cout << "Writing telemetry to " << inname+".telem" << endl;
+        telemetry.setSource(argv[optind]);
+        if (!telemetry.open((inname+".telem").Data(),telemetry_interval,hybrid_type==1)) return(1);
+    }
+
     cout << "Reading data file " <<argv[optind] << endl;
     // Attempt to open data file
     if ( ! dataRead->open(argv[optind]) ) return(2);
@@ -315,10 +351,12 @@ int main ( int argc, char **argv ) {
         } else {
             fpga = event.fpgaAddress();
             samplecount = event.count();
-            if (read_temp && !event.isTiFrame()) for (uint i=0;i<4;i++) {
-                printf("Event %d, temperature #%d: %f\n",eventCount,i,event.temperature(i,hybrid_type==1));
+            if (read_temp && !event.isTiFrame()) {
+                for (uint i=0;i<4;i++)
+                    printf("Event %d, temperature #%d: %f\n",eventCount,i,event.temperature(i,hybrid_type==1));
                 read_temp = false;
             }
+            if (telemetry_interval > 0) telemetry.add(&event,eventCount);
         }
 
         if(debug) printf("Event %d\n",eventCount);
@@ -435,6 +473,7 @@ int main ( int argc, char **argv ) {
                 for ( int y=0; y < 6; y++ ) {
                     int value = eventSamples[i][y];
                     channelValue[i]+=value;
+                    if (channelActive[i]) channelStats[i][y].add(value);
 
                     //vhigh = (value << 1) & 0x2AAA;
                     //vlow  = (value >> 1) & 0x1555;
@@ -559,6 +598,16 @@ int main ( int argc, char **argv ) {
 
         eventCount++;
 
+        if (convergence.enabled() && eventCount%100==0) {
+            convergence.begin();
+            convergence.check(&channelStats[0][0],640*6);
+            if (convergence.done()) {
+                printf("Converged after %d events: worst mean error %f, worst relative sigma error %f\n",eventCount,convergence.worstMeanError(),convergence.worstSigmaError());
+                stopped_early = true;
+                break;
+            }
+        }
+
         if (triggerevent_format) {
             readOK = dataRead->next(&triggerevent);
         } else {
@@ -566,8 +615,10 @@ int main ( int argc, char **argv ) {
         }
     } while (readOK);
     dataRead->close();
+    if (telemetry_interval > 0 && telemetry.close())
+        printf("Wrote %llu telemetry records\n",(unsigned long long)telemetry.records());
 
-    if (eventCount != runCount)
+    if (!stopped_early && eventCount != runCount)
     {
         printf("ERROR: events read = %d, runCount = %d\n",eventCount, runCount);
     }
@@ -669,6 +720,23 @@ int main ( int argc, char **argv ) {
         }
     }
 
+    // Achieved precision, as comments after the calibration so readers that
+    // stop at the first non-numeric line are not affected
+    convergence.begin();
+    convergence.check(&channelStats[0][0],640*6);
+    outfile<<"# events "<<eventCount<<(stopped_early?" (converged)":"")<<", worst mean error "<<convergence.worstMeanError()<<", worst relative sigma error "<<convergence.worstSigmaError();
+    if (convergence.enabled()) outfile<<", "<<convergence.pending()<<" of "<<convergence.active()<<" channel samples above target";
+    outfile<<endl;
+    outfile<<"# channel\tmean error\trelative sigma error (worst of 6 samples)"<<endl;
+    for (int channel = 0; channel < 640; channel++) if (channelStats[channel][0].count()>0) {
+        double meanError = 0.0, sigmaError = 0.0;
+        for (int y=0;y<6;y++) {
+            meanError = max(meanError,channelStats[channel][y].meanError());
+            sigmaError = max(sigmaError,channelStats[channel][y].sigmaError());
+        }
+        outfile<<"# "<<channel<<"\t"<<meanError<<"\t"<<sigmaError<<endl;
+    }
+
 
     if (!skip_corr)
     {
@@ -0,0 +1,78 @@
+//-----------------------------------------------------------------------------
+// File          : meeg_cache.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Inspect and maintain the result cache used by meeg_tp, meeg_t0res and
+// meeg_sourcetest (-C option of those tools).
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <ResultCache.h>
+using namespace std;
+
+int main ( int argc, char **argv ) {
+   bool   do_list  = false;
+   bool   do_clear = false;
+   double evict_mb = -1.0;
+   string key      = "";
+   int    c;
+
+   while ((c = getopt(argc,argv,"hlcs:k:")) !=-1)
+      switch (c)
+      {
+         case 'h':
+            printf("Usage: meeg_cache [options] cache_dir\n");
+            printf("-h: print this help\n");
+            printf("-l: list cached products, least recently used first\n");
+            printf("-c: remove all cached products\n");
+            printf("-s: evict least recently used products until the cache is below specified size in MB\n");
+            printf("-k: remove all products for specified key\n");
+            return(0);
+            break;
+         case 'l':
+            do_list = true;
+            break;
+         case 'c':
+            do_clear = true;
+            break;
+         case 's':
+            evict_mb = atof(optarg);
+            break;
+         case 'k':
+            key = optarg;
+            break;
+         case '?':
+            printf("Invalid option or missing option argument; -h to list options\n");
+            return(1);
+         default:
+            abort();
+      }
+
+   if ( argc-optind != 1 ) {
+      cout << "Usage: meeg_cache [options] cache_dir\n";
+      return(1);
+   }
+
+   ResultCache cache(argv[optind]);
+
+   if ( key != "" ) cache.invalidate(key);
+   if ( do_clear ) cache.clear();
+   if ( evict_mb >= 0 ) {
+      unsigned long long bytes = (unsigned long long)(evict_mb * 1024 * 1024);
+      if ( bytes == 0 ) cache.clear();
+      else cout << "Evicted " << cache.evict(bytes) << " bytes" << endl;
+   }
+   if ( do_list ) cache.list();
+   cout << "Cache " << cache.dir() << ": " << cache.totalBytes() << " bytes" << endl;
+   return(0);
+}
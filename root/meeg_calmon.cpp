@@ -0,0 +1,252 @@
+//-----------------------------------------------------------------------------
+// File          : meeg_calmon.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Live calibration monitor: reads the shared memory feed and keeps decayed
+// per channel pedestal, noise, occupancy and APV error rates (CalMonitor),
+// publishing snapshots to a memory mapped results file that local processes
+// read without locking. With -r the tool reads such a file and prints the
+// dead channels and flagged APVs instead.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <Data.h>
+#include <DataRead.h>
+#include <DevboardEvent.h>
+#include <DevboardSample.h>
+#include <TiTriggerEvent.h>
+#include <TriggerSample.h>
+#include <CalMonitor.h>
+using namespace std;
+
+// Wall clock in seconds
+double now ( ) {
+   struct timeval tv;
+   gettimeofday(&tv,NULL);
+   return(tv.tv_sec + tv.tv_usec * 1e-6);
+}
+
+// Print a snapshot
+void printSnapshot ( CalMonitorHeader &header, vector<CalMonitorHybrid> &hybrids, bool channels ) {
+   printf("Snapshot at %.1f: %.0f frames, %.1f Hz, tau %.0f s, %d hybrids\n",header.time,header.frames,
+          header.rate,header.tau,header.hybrids);
+   for (uint i=0; i < hybrids.size(); i++) {
+      CalMonitorHybrid *h = &hybrids[i];
+      printf("RCE %d FEB %d hybrid %d: %.0f events, %d dead, %d noisy",h->rce,h->feb,h->hybrid,h->events,
+             h->deadChannels,h->noisyChannels);
+      for (uint a=0; a < 5; a++) {
+         if ( h->apvFlags[a] == 0 ) continue;
+         printf(", APV %d",a);
+         if ( h->apvFlags[a] & CalMonitorDead ) printf(" dead");
+         if ( h->apvFlags[a] & CalMonitorNoData ) printf(" no data");
+         if ( h->apvFlags[a] & CalMonitorNoisy ) printf(" noisy (%.1f)",h->apvNoise[a]);
+         if ( h->apvFlags[a] & CalMonitorErrors ) printf(" errors (%.2g)",h->apvErrorRate[a]);
+      }
+      printf("\n");
+      if ( ! channels ) continue;
+      for (uint c=0; c < CalMonitor::Channels; c++) {
+         if ( (h->channelFlags[c] & (CalMonitorDead | CalMonitorNoisy)) == 0 ) continue;
+         printf("   channel %d: %s, pedestal %.1f, noise %.2f, occupancy %.3g\n",c,
+                (h->channelFlags[c] & CalMonitorDead) ? "dead" : "noisy",h->pedestal[c],h->noise[c],h->occupancy[c]);
+      }
+   }
+}
+
+int main ( int argc, char **argv ) {
+   bool              triggerevent_format = false;
+   string            shared_system = "";
+   uint              shared_id = 1;
+   string            results_file = "";
+   string            read_file = "";
+   double            tau = 10.0;
+   double            update_sec = 1.0;
+   double            hit_sigma = 5.0;
+   uint              max_hybrids = 128;
+   bool              keep_running = false;
+   bool              verbose = false;
+   DataRead          dataRead;
+   DevboardEvent     event;
+   TiTriggerEvent    triggerevent;
+   TriggerSample     triggersample;
+   Data              *frame;
+   uint              values[6];
+   int               c;
+
+   while ((c = getopt(argc,argv,"hs:i:o:r:t:u:H:M:kpV")) !=-1)
+      switch (c)
+      {
+         case 'h':
+            printf("Usage: meeg_calmon [options] -s system\n");
+            printf("       meeg_calmon [options] -r results_file\n");
+            printf("-h: print this help\n");
+            printf("-s: read live data from shared memory of this system\n");
+            printf("-i: shared memory id (default 1)\n");
+            printf("-o: results file (default /dev/shm/calmon.<system>.<id>)\n");
+            printf("-r: print the snapshot in a results file and exit\n");
+            printf("-t: decay time constant in seconds (default 10)\n");
+            printf("-u: snapshot interval in seconds (default 1)\n");
+            printf("-H: hit cut in noise sigmas (default 5)\n");
+            printf("-M: largest number of hybrids (default 128)\n");
+            printf("-k: keep running across runs instead of stopping at the run stop\n");
+            printf("-p: print the dead and noisy channels with each snapshot\n");
+            printf("-V: use TriggerEvent event format\n");
+            return(0);
+            break;
+         case 's':
+            shared_system = optarg;
+            break;
+         case 'i':
+            shared_id = atoi(optarg);
+            break;
+         case 'o':
+            results_file = optarg;
+            break;
+         case 'r':
+            read_file = optarg;
+            break;
+         case 't':
+            tau = atof(optarg);
+            break;
+         case 'u':
+            update_sec = atof(optarg);
+            break;
+         case 'H':
+            hit_sigma = atof(optarg);
+            break;
+         case 'M':
+            max_hybrids = atoi(optarg);
+            break;
+         case 'k':
+            keep_running = true;
+            break;
+         case 'p':
+            verbose = true;
+            break;
+         case 'V':
+            triggerevent_format = true;
+            break;
+         case '?':
+            printf("Invalid option or missing option argument; -h to list options\n");
+            return(1);
+         default:
+            abort();
+      }
+
+   // Reader mode
+   if ( read_file != "" ) {
+      CalMonitorFile           file;
+      CalMonitorHeader         header;
+      vector<CalMonitorHybrid> hybrids;
+
+      if ( ! file.attach(read_file) ) {
+         cout << "Could not read results file " << read_file << endl;
+         return(1);
+      }
+      if ( ! file.snapshot(header,hybrids) ) {
+         cout << "No snapshot in " << read_file << endl;
+         return(1);
+      }
+      printSnapshot(header,hybrids,verbose);
+      return(0);
+   }
+
+   if ( shared_system == "" ) {
+      cout << "Usage: meeg_calmon [options] -s system\n";
+      return(1);
+   }
+
+   if ( results_file == "" ) {
+      char name[200];
+      sprintf(name,"/dev/shm/calmon.%s.%d",shared_system.c_str(),shared_id);
+      results_file = name;
+   }
+
+   CalMonitorFile file;
+   CalMonitor     monitor(tau,max_hybrids);
+   monitor.setHitSigma(hit_sigma);
+   if ( ! file.create(results_file,max_hybrids) ) return(1);
+   cout << "Writing snapshots to " << results_file << endl;
+
+   try {
+      dataRead.openShared(shared_system,shared_id);
+   } catch ( string error ) {
+      cout << error << endl;
+      return(2);
+   }
+   cout << "Reading shared memory for system " << shared_system << endl;
+
+   if (triggerevent_format) frame = &triggerevent;
+   else frame = &event;
+
+   double last = now();
+   long   frames = 0;
+
+   while ( true ) {
+      bool got = dataRead.next(frame);
+
+      // A run start read with the first frame of the run clears before that frame is added
+      if ( dataRead.sawRunStart() ) {
+         cout << "Run start, clearing" << endl;
+         monitor.clear();
+      }
+
+      if ( got ) {
+         monitor.beginFrame(now());
+         frames++;
+
+         if (triggerevent_format) {
+            for (uint x=0; x < triggerevent.count(); x++) {
+               triggerevent.sample(x,&triggersample);
+               if ( triggersample.head() || triggersample.tail() ) {
+                  monitor.seen(triggersample.rceAddress(),triggersample.febAddress(),triggersample.hybrid());
+                  continue;
+               }
+               for (uint y=0; y < 6; y++) values[y] = triggersample.value(y);
+               monitor.add(triggersample.rceAddress(),triggersample.febAddress(),triggersample.hybrid(),
+                           triggersample.apv(),triggersample.channel(),values,triggersample.error());
+            }
+         }
+         else if ( event.fpgaAddress() != 7 && ! event.isTiFrame() ) {
+            for (uint x=0; x < event.count(); x++) {
+               DevboardSample *sample = event.sample(x);
+               for (uint y=0; y < 6; y++) values[y] = sample->value(y) & 0x3FFF;
+               monitor.add(0,event.fpgaAddress(),sample->hybrid(),sample->apv(),sample->channel(),values,
+                           sample->error());
+            }
+         }
+         monitor.endFrame();
+      }
+      else usleep(1000);
+
+      if ( dataRead.sawRunStop() && ! keep_running ) {
+         cout << "Run stop" << endl;
+         break;
+      }
+      if ( now() - last >= update_sec ) {
+         last = now();
+         monitor.publish(&file,last);
+         cout << frames << " frames, " << monitor.hybrids() << " hybrids, "
+              << dataRead.sharedDropped() << " dropped" << endl;
+         if ( verbose ) {
+            CalMonitorHeader         header;
+            vector<CalMonitorHybrid> hybrids;
+            if ( file.snapshot(header,hybrids) ) printSnapshot(header,hybrids,true);
+         }
+      }
+   }
+   monitor.publish(&file,now());
+   return(0);
+}
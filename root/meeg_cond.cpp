@@ -0,0 +1,138 @@
+//-----------------------------------------------------------------------------
+// File          : meeg_cond.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Builds, merges and exports binary SVT conditions (.cond) files. Inputs are
+// merged in order, later inputs overriding the parts they set: .cond files
+// written by meeg_all_baseline and meeg_all_tp, and .base, .tp and
+// .thresholds files of older calibrations. The result is written as a .cond
+// file and/or as the pedestal and Tp CSV tables of the conditions database.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <SvtConditions.h>
+using namespace std;
+
+// True if the name ends with the suffix
+bool endsWith ( string name, string suffix ) {
+   return(name.size() >= suffix.size() && name.compare(name.size() - suffix.size(),suffix.size(),suffix) == 0);
+}
+
+// Write one CSV table, "-" for the standard output
+bool writeCsv ( SvtConditions &conditions, string file, uint table ) {
+   if ( file == "-" ) {
+      conditions.writeCsv(cout,table);
+      return(true);
+   }
+   ofstream out(file.c_str());
+   if ( ! out.is_open() ) {
+      cout << "Failed to open " << file << endl;
+      return(false);
+   }
+   conditions.writeCsv(out,table);
+   cout << "Wrote " << file << endl;
+   return(true);
+}
+
+int main ( int argc, char **argv ) {
+   string        out_file = "";
+   string        pedestal_csv = "";
+   string        tp_csv = "";
+   string        source = "";
+   bool          list = false;
+   SvtConditions conditions;
+   bool          ok;
+   int           c;
+
+   while ((c = getopt(argc,argv,"ho:p:t:n:l")) !=-1)
+      switch (c)
+      {
+         case 'h':
+            printf("Usage: meeg_cond [options] input_file [input_file ...]\n");
+            printf("Inputs are .cond, .base, .tp or .thresholds files, merged in order\n");
+            printf("-h: print this help\n");
+            printf("-o: write the merged conditions to this .cond file\n");
+            printf("-p: write the pedestal CSV table to this file (- for standard output)\n");
+            printf("-t: write the Tp CSV table to this file (- for standard output)\n");
+            printf("-n: source name stored in the .cond file (default from the first input)\n");
+            printf("-l: list the channels set in the merged conditions\n");
+            return(0);
+            break;
+         case 'o':
+            out_file = optarg;
+            break;
+         case 'p':
+            pedestal_csv = optarg;
+            break;
+         case 't':
+            tp_csv = optarg;
+            break;
+         case 'n':
+            source = optarg;
+            break;
+         case 'l':
+            list = true;
+            break;
+         case '?':
+            printf("Invalid option or missing option argument; -h to list options\n");
+            return(1);
+         default:
+            abort();
+      }
+
+   if ( argc-optind == 0 ) {
+      cout << "Usage: meeg_cond [options] input_file [input_file ...]\n";
+      return(1);
+   }
+
+   if ( source != "" ) conditions.setSource(source);
+   for (int i=optind; i < argc; i++) {
+      string name = argv[i];
+
+      // Text inputs set the source name the way the tools do, binary inputs carry their own
+      if ( source == "" && i == optind && ! endsWith(name,".cond") ) {
+         string base = name.substr(0,name.rfind('.'));
+         if ( base.find('/') != string::npos ) base.erase(0,base.rfind('/')+1);
+         conditions.setSource(base);
+      }
+
+      if ( endsWith(name,".cond") ) ok = conditions.merge(name);
+      else if ( endsWith(name,".base") ) ok = conditions.loadBase(name);
+      else if ( endsWith(name,".tp") ) ok = conditions.loadTp(name);
+      else if ( endsWith(name,".thresholds") ) ok = conditions.loadThresholds(name);
+      else {
+         cout << "Unknown input type: " << name << endl;
+         return(1);
+      }
+      if ( ! ok ) {
+         cout << "Failed to read " << name << endl;
+         return(2);
+      }
+   }
+
+   if ( list || (out_file == "" && pedestal_csv == "" && tp_csv == "") ) {
+      cout << conditions.count() << " channels set, " << conditions.count(SvtConditionsPedestal) << " with pedestals, "
+           << conditions.count(SvtConditionsTp) << " with Tp, " << conditions.count(SvtConditionsThreshold)
+           << " with thresholds" << endl;
+   }
+
+   if ( out_file != "" ) {
+      if ( ! conditions.write(out_file) ) return(2);
+      cout << "Wrote " << out_file << endl;
+   }
+   if ( pedestal_csv != "" && ! writeCsv(conditions,pedestal_csv,SvtConditionsCsvPedestal) ) return(2);
+   if ( tp_csv != "" && ! writeCsv(conditions,tp_csv,SvtConditionsCsvTp) ) return(2);
+   return(0);
+}
@@ -0,0 +1,610 @@
+//-----------------------------------------------------------------------------
+// File          : meeg_cosmic_track.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Straight line cosmic tracks through the modules of the cosmic stand.
+//
+// The geometry file has one line per module (hybrid):
+//    fpga hybrid z offset pitch base_file
+// with z, the position of strip 0 (offset) and the signed strip pitch in mm,
+// and the .base file of the module from meeg_baseline, in the same channel
+// numbering (-n). Lines starting with # are comments.
+//
+// Frames are grouped into events until an FPGA repeats. Events are processed
+// in batches by worker threads: each worker clusters the strips of every
+// module (StripClusterer) and finds the tracks (CosmicTracker). The tool
+// prints the residuals and efficiency of every module and writes their
+// histograms to <name>_cosmic.root, and with -t every track to <name>.tracks.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <TFile.h>
+#include <TH1F.h>
+#include <TString.h>
+#include <DevboardEvent.h>
+#include <DevboardSample.h>
+#include <Data.h>
+#include <DataRead.h>
+#include <DataReadEvio.h>
+#include <RunningStats.h>
+#include <GaussPeak.h>
+#include <StripClusterer.h>
+#include <CosmicTracker.h>
+#include <BaselineFile.h>
+#include "meeg_utils.hh"
+using namespace std;
+
+// Events per batch
+#define BATCH_EVENTS 256
+
+// Residual histogram bins, over +- the search window
+#define RES_BINS 200
+
+// Track histogram bins
+#define CHI2_BINS  100
+#define CHI2_MAX   50.0
+#define SLOPE_BINS 200
+
+// A module of the stand
+typedef struct {
+   int    fpga;
+   int    hybrid;
+   double z;
+   double offset;
+   double pitch;
+   string base;
+   float  pedestal[640][6];
+   double noise[640];
+} StandModule;
+
+// Settings shared by the workers
+typedef struct {
+   vector<StandModule> modules;
+   map<int,int>        moduleOf;      // fpga * 4 + hybrid
+   bool                flip_channels;
+   bool                invert;
+   double              seedThresh;
+   double              neighborThresh;
+   double              window;
+   double              maxSlope;
+   double              maxChi2;
+   uint                minHits;
+   bool                writeTracks;
+} StandSetup;
+
+// Batch of events
+enum { BatchFree, BatchFull, BatchBusy, BatchDone };
+typedef struct {
+   vector<DevboardEvent *> frames;     // Reused
+   uint                    frameCount;
+   vector<uint>            start;      // First frame of each event
+   unsigned long           firstEvent;
+   int                     state;
+   string                  tracks;     // Track lines with -t
+} EventBatch;
+
+// Worker thread, its own clusterers, tracker and results
+typedef struct {
+   pthread_t               thread;
+   vector<StripClusterer*> clusterers;
+   CosmicTracker           tracker;
+   unsigned long long      events;
+   unsigned long long      tracks;
+   vector<unsigned long long> clusters;    // Per module
+   vector<unsigned long long> expected;    // Per layer
+   vector<unsigned long long> found;       // Per layer
+   vector<vector<uint> >   residual;       // Per module, RES_BINS
+   vector<RunningStats>    residualStats;  // Per module
+   vector<uint>            chi2;
+   vector<uint>            slope;
+   vector<uint>            hits;
+} TrackWorker;
+
+// Pipeline between the reader and the workers
+typedef struct {
+   StandSetup         *setup;
+   vector<EventBatch> batches;
+   pthread_mutex_t    lock;
+   pthread_cond_t     cond;
+   bool               done;
+} TrackPipeline;
+
+static TrackPipeline pipeline;
+
+// Read the pedestals and noise of a module
+bool readBase ( StandModule &module ) {
+   BaselineFile    in;
+   BaselineChannel ch;
+   uint            count = 0;
+
+   for (int c=0; c < 640; c++) {
+      for (int y=0; y < 6; y++) module.pedestal[c][y] = 0;
+      module.noise[c] = 0;
+   }
+   if ( ! in.open(module.base) ) return(false);
+   while ( in.next(&ch) ) {
+      if ( ch.channel >= 640 ) continue;
+      for (int y=0; y < 6; y++) module.pedestal[ch.channel][y] = ch.mean[y];
+      module.noise[ch.channel] = ch.sigma[6];
+      count++;
+   }
+   in.close();
+   return(count > 0);
+}
+
+// Read the geometry file and the pedestals of its modules
+bool readGeometry ( const char *file, StandSetup *setup ) {
+   ifstream    in;
+   string      line;
+   StandModule module;
+
+   in.open(file);
+   if ( ! in.is_open() ) {
+      cout << "Could not open geometry file " << file << endl;
+      return(false);
+   }
+   while ( getline(in,line) ) {
+      if ( line.empty() || line[0] == '#' ) continue;
+      istringstream row(line);
+      if ( ! (row >> module.fpga >> module.hybrid >> module.z >> module.offset >> module.pitch >> module.base) ) {
+         cout << "Bad geometry line: " << line << endl;
+         return(false);
+      }
+      if ( ! readBase(module) ) {
+         cout << "Could not read baseline file " << module.base << endl;
+         return(false);
+      }
+      setup->moduleOf[module.fpga * 4 + module.hybrid] = setup->modules.size();
+      setup->modules.push_back(module);
+   }
+   return(setup->modules.size() > 0);
+}
+
+// Cluster the modules and find the tracks of one event
+void processEvent ( TrackWorker *worker, EventBatch *batch, uint event ) {
+   StandSetup     *setup = pipeline.setup;
+   DevboardEvent  *frame;
+   DevboardSample *sample;
+   double         samples[6];
+   uint           first = batch->start[event];
+   uint           last  = (event + 1 < batch->start.size()) ? batch->start[event+1] : batch->frameCount;
+   int            key = -1;
+   int            module = -1;
+   int            channel;
+   uint           apv;
+   bool           good;
+   char           buf[200];
+   map<int,int>::iterator it;
+
+   for (uint m=0; m < worker->clusterers.size(); m++) worker->clusterers[m]->clear();
+
+   // Strips of every module
+   for (uint f=first; f < last; f++) {
+      frame = batch->frames[f];
+      for (uint x=0; x < frame->count(); x++) {
+         sample = frame->sample(x);
+         if ( (int)(frame->fpgaAddress() * 4 + sample->hybrid()) != key ) {
+            key = frame->fpgaAddress() * 4 + sample->hybrid();
+            it = setup->moduleOf.find(key);
+            module = (it == setup->moduleOf.end()) ? -1 : it->second;
+         }
+         if ( module < 0 ) continue;
+
+         apv = sample->apv();
+         if ( setup->flip_channels ) channel = sample->channel() + (4 - apv) * 128;
+         else channel = sample->channel() + apv * 128;
+         if ( channel < 0 || channel >= 640 ) continue;
+
+         good = true;
+         for (uint y=0; y < 6; y++) {
+            uint value = sample->value(y) & 0x3FFF;
+            if ( value == 0 ) good = false;
+            samples[y] = value - setup->modules[module].pedestal[channel][y];
+            if ( setup->invert ) samples[y] = -samples[y];
+         }
+         if ( good ) worker->clusterers[module]->addStrip(channel,samples);
+      }
+   }
+
+   // Hits
+   worker->tracker.clear();
+   for (uint m=0; m < worker->clusterers.size(); m++) {
+      StripClusterer *clusterer = worker->clusterers[m];
+      clusterer->process();
+      worker->clusters[m] += clusterer->count();
+      for (uint c=0; c < clusterer->count(); c++) {
+         const StripCluster *cluster = clusterer->cluster(c);
+         worker->tracker.addHit(m,cluster->position,cluster->amplitude,cluster->t0,cluster->size);
+      }
+   }
+
+   // Tracks
+   worker->events++;
+   worker->tracker.findTracks();
+   for (uint t=0; t < worker->tracker.count(); t++) {
+      const CosmicTrack *track = worker->tracker.track(t);
+      uint layers = worker->tracker.layers();
+      int  bin;
+
+      worker->tracks++;
+      worker->hits[track->hits]++;
+      if ( track->ndf > 0 ) {
+         bin = (int)(track->chi2 / track->ndf / CHI2_MAX * CHI2_BINS);
+         if ( bin >= 0 && bin < CHI2_BINS ) worker->chi2[bin]++;
+      }
+      bin = (int)((track->slope + setup->maxSlope) / (2 * setup->maxSlope) * SLOPE_BINS);
+      if ( bin >= 0 && bin < SLOPE_BINS ) worker->slope[bin]++;
+
+      for (uint l=0; l < layers; l++) {
+         if ( track->hit[l] >= 0 && track->unbiased[l] ) {
+            uint m = worker->tracker.hit(track->hit[l])->module;
+            worker->residualStats[m].add(track->residual[l]);
+            bin = (int)((track->residual[l] + setup->window) / (2 * setup->window) * RES_BINS);
+            if ( bin >= 0 && bin < RES_BINS ) worker->residual[m][bin]++;
+         }
+
+         // Efficiency, on tracks that have enough hits without the layer and cross it
+         if ( track->hits - (track->hit[l] >= 0 ? 1 : 0) >= worker->tracker.minHits() &&
+              worker->tracker.inside(l,track->predicted[l]) ) {
+            worker->expected[l]++;
+            if ( track->hit[l] >= 0 ) worker->found[l]++;
+         }
+      }
+
+      if ( setup->writeTracks ) {
+         sprintf(buf,"%lu\t%u\t%u\t%f\t%f\t%f\t%u",batch->firstEvent + event,t,track->hits,
+                 track->intercept,track->slope,track->chi2,track->ndf);
+         batch->tracks += buf;
+         for (uint l=0; l < layers; l++) {
+            if ( track->hit[l] >= 0 && track->unbiased[l] ) sprintf(buf,"\t%f",track->residual[l]);
+            else sprintf(buf,"\t-");
+            batch->tracks += buf;
+         }
+         batch->tracks += "\n";
+      }
+   }
+}
+
+// Worker thread, processes full batches until the reader is done
+void *trackWorker ( void *arg ) {
+   TrackWorker *worker = (TrackWorker *)arg;
+   EventBatch  *batch;
+
+   pthread_mutex_lock(&pipeline.lock);
+   while ( true ) {
+      batch = NULL;
+      for (uint b=0; b < pipeline.batches.size() && batch == NULL; b++)
+         if ( pipeline.batches[b].state == BatchFull ) batch = &pipeline.batches[b];
+      if ( batch == NULL ) {
+         if ( pipeline.done ) break;
+         pthread_cond_wait(&pipeline.cond,&pipeline.lock);
+         continue;
+      }
+      batch->state = BatchBusy;
+      pthread_mutex_unlock(&pipeline.lock);
+
+      batch->tracks.clear();
+      for (uint e=0; e < batch->start.size(); e++) processEvent(worker,batch,e);
+
+      pthread_mutex_lock(&pipeline.lock);
+      batch->state = BatchDone;
+      pthread_cond_broadcast(&pipeline.cond);
+   }
+   pthread_mutex_unlock(&pipeline.lock);
+   return(NULL);
+}
+
+// Wait until a batch is free or done, write its tracks and hand it to the reader
+EventBatch *claimBatch ( uint index, ofstream &tracks ) {
+   EventBatch *batch = &pipeline.batches[index];
+
+   pthread_mutex_lock(&pipeline.lock);
+   while ( batch->state == BatchFull || batch->state == BatchBusy ) pthread_cond_wait(&pipeline.cond,&pipeline.lock);
+   pthread_mutex_unlock(&pipeline.lock);
+
+   if ( batch->state == BatchDone && tracks.is_open() ) tracks << batch->tracks;
+   batch->state      = BatchFree;
+   batch->frameCount = 0;
+   batch->start.clear();
+   return(batch);
+}
+
+// Hand a batch to the workers
+void submitBatch ( EventBatch *batch ) {
+   pthread_mutex_lock(&pipeline.lock);
+   batch->state = (batch->start.size() > 0) ? BatchFull : BatchFree;
+   pthread_cond_broadcast(&pipeline.cond);
+   pthread_mutex_unlock(&pipeline.lock);
+}
+
+int main ( int argc, char **argv ) {
+   StandSetup      setup;
+   vector<TrackWorker*> workers;
+   DataRead        *dataRead;
+   DevboardEvent   event;
+   EventBatch      *batch;
+   vector<uint>    seen;
+   ofstream        tracks;
+   TString         inname = "";
+   char            *geometry = NULL;
+   bool            evio_format = false;
+   int             num_events = -1;
+   int             jobs = 1;
+   uint            current = 0;
+   unsigned long   eventCount = 0;
+   char            name[200];
+   struct timeval  start, end;
+   int             c;
+
+   setup.flip_channels  = true;
+   setup.invert         = false;
+   setup.seedThresh     = 5.0;
+   setup.neighborThresh = 3.0;
+   setup.window         = 1.0;
+   setup.maxSlope       = 1.0;
+   setup.maxChi2        = 0;
+   setup.minHits        = 3;
+   setup.writeTracks    = false;
+
+   while ((c = getopt(argc,argv,"hg:o:niEe:j:s:b:w:S:c:m:t")) !=-1)
+      switch (c)
+      {
+         case 'h':
+            printf("Usage: meeg_cosmic_track [options] -g geometry_file data_files\n");
+            printf("-h: print this help\n");
+            printf("-g: geometry file, lines of: fpga hybrid z offset pitch base_file (mm)\n");
+            printf("-o: use specified output filename\n");
+            printf("-n: DAQ (Ryan's) channel numbering\n");
+            printf("-i: negative signals\n");
+            printf("-E: use EVIO file format\n");
+            printf("-e: stop after specified number of events\n");
+            printf("-j: process events in specified number of threads (0 for all cores)\n");
+            printf("-s: seed strip threshold in noise sigmas (default 5)\n");
+            printf("-b: neighbor strip threshold in noise sigmas (default 3)\n");
+            printf("-w: search window around the track in mm (default 1)\n");
+            printf("-S: largest track slope (default 1)\n");
+            printf("-c: largest track chi2 per degree of freedom (default none)\n");
+            printf("-m: least number of hits of a track (default 3)\n");
+            printf("-t: write every track to <name>.tracks\n");
+            return(0);
+            break;
+         case 'g':
+            geometry = optarg;
+            break;
+         case 'o':
+            inname = optarg;
+            break;
+         case 'n':
+            setup.flip_channels = false;
+            break;
+         case 'i':
+            setup.invert = true;
+            break;
+         case 'E':
+            evio_format = true;
+            break;
+         case 'e':
+            num_events = atoi(optarg);
+            break;
+         case 'j':
+            jobs = atoi(optarg);
+            if (jobs<=0) jobs = numCores();
+            break;
+         case 's':
+            setup.seedThresh = atof(optarg);
+            break;
+         case 'b':
+            setup.neighborThresh = atof(optarg);
+            break;
+         case 'w':
+            setup.window = atof(optarg);
+            break;
+         case 'S':
+            setup.maxSlope = atof(optarg);
+            break;
+         case 'c':
+            setup.maxChi2 = atof(optarg);
+            break;
+         case 'm':
+            setup.minHits = atoi(optarg);
+            break;
+         case 't':
+            setup.writeTracks = true;
+            break;
+         case '?':
+            printf("Invalid option or missing option argument; -h to list options\n");
+            return(1);
+         default:
+            abort();
+      }
+
+   if ( argc-optind == 0 || geometry == NULL ) {
+      cout << "Usage: meeg_cosmic_track [options] -g geometry_file data_files\n";
+      return(1);
+   }
+   if ( ! readGeometry(geometry,&setup) ) return(1);
+
+   if (inname=="")
+   {
+      inname=argv[optind];
+      inname.ReplaceAll(".bin","");
+      if (inname.Contains('/')) {
+         inname.Remove(0,inname.Last('/')+1);
+      }
+   }
+
+   // Workers
+   pipeline.setup = &setup;
+   pipeline.done  = false;
+   pthread_mutex_init(&pipeline.lock,NULL);
+   pthread_cond_init(&pipeline.cond,NULL);
+   pipeline.batches.resize(2 * jobs + 2);
+   for (uint b=0; b < pipeline.batches.size(); b++) {
+      pipeline.batches[b].frameCount = 0;
+      pipeline.batches[b].state      = BatchFree;
+   }
+
+   for (int j=0; j < jobs; j++) {
+      TrackWorker *worker = new TrackWorker;
+      for (uint m=0; m < setup.modules.size(); m++) {
+         StripClusterer *clusterer = new StripClusterer(setup.seedThresh,setup.neighborThresh);
+         for (uint ch=0; ch < 640; ch++) clusterer->setNoise(ch,setup.modules[m].noise[ch]);
+         clusterer->setTiming(SAMPLE_INTERVAL);
+         worker->clusterers.push_back(clusterer);
+         worker->tracker.addModule(setup.modules[m].z,setup.modules[m].offset,setup.modules[m].pitch);
+      }
+      worker->tracker.setWindow(setup.window);
+      worker->tracker.setMaxSlope(setup.maxSlope);
+      worker->tracker.setMaxChi2(setup.maxChi2);
+      worker->tracker.setMinHits(setup.minHits);
+      worker->events = 0;
+      worker->tracks = 0;
+      worker->clusters.assign(setup.modules.size(),0);
+      worker->expected.assign(CosmicMaxLayers,0);
+      worker->found.assign(CosmicMaxLayers,0);
+      worker->residual.assign(setup.modules.size(),vector<uint>(RES_BINS,0));
+      worker->residualStats.resize(setup.modules.size());
+      worker->chi2.assign(CHI2_BINS,0);
+      worker->slope.assign(SLOPE_BINS,0);
+      worker->hits.assign(CosmicMaxLayers + 1,0);
+      worker->tracker.layers();
+      workers.push_back(worker);
+      pthread_create(&worker->thread,NULL,trackWorker,worker);
+   }
+   if ( workers[0]->tracker.layers() > CosmicMaxLayers ) {
+      cout << "More than " << CosmicMaxLayers << " layers" << endl;
+      return(1);
+   }
+
+   if ( setup.writeTracks ) {
+      tracks.open(inname + ".tracks");
+      tracks << "# event\ttrack\thits\tintercept\tslope\tchi2\tndf";
+      for (uint l=0; l < workers[0]->tracker.layers(); l++) tracks << "\tres_z" << workers[0]->tracker.layerZ(l);
+      tracks << endl;
+   }
+
+   // Read the files, grouping frames into events until an FPGA repeats
+   gettimeofday(&start,NULL);
+   batch = claimBatch(current,tracks);
+   batch->firstEvent = 0;
+   for (int f=optind; f < argc && (num_events < 0 || (long)eventCount < num_events); f++) {
+      if (evio_format) dataRead = new DataReadEvio();
+      else dataRead = new DataRead();
+      cout << "Reading data file " << argv[f] << endl;
+      if ( ! dataRead->open(argv[f]) ) {
+         delete dataRead;
+         continue;
+      }
+      seen.clear();
+      while ( dataRead->next(&event) ) {
+         if ( event.isTiFrame() || event.fpgaAddress() == 7 ) continue;
+
+         bool repeat = false;
+         for (uint i=0; i < seen.size(); i++) if ( seen[i] == event.fpgaAddress() ) repeat = true;
+         if ( repeat || seen.size() == 0 ) {
+            if ( num_events >= 0 && (long)eventCount >= num_events ) break;
+            if ( batch->start.size() == BATCH_EVENTS ) {
+               submitBatch(batch);
+               current = (current + 1) % pipeline.batches.size();
+               batch = claimBatch(current,tracks);
+               batch->firstEvent = eventCount;
+            }
+            if (eventCount%10000==0) printf("Event %lu\n",eventCount);
+            batch->start.push_back(batch->frameCount);
+            eventCount++;
+            seen.clear();
+         }
+         seen.push_back(event.fpgaAddress());
+
+         if ( batch->frameCount == batch->frames.size() ) batch->frames.push_back(new DevboardEvent);
+         batch->frames[batch->frameCount++]->copy(event.data(),event.size());
+      }
+      dataRead->close();
+      delete dataRead;
+
+      // Events do not span files
+      seen.clear();
+   }
+   submitBatch(batch);
+
+   pthread_mutex_lock(&pipeline.lock);
+   pipeline.done = true;
+   pthread_cond_broadcast(&pipeline.cond);
+   pthread_mutex_unlock(&pipeline.lock);
+   for (uint j=0; j < workers.size(); j++) pthread_join(workers[j]->thread,NULL);
+   for (uint b=1; b <= pipeline.batches.size(); b++) claimBatch((current + b) % pipeline.batches.size(),tracks);
+   if ( tracks.is_open() ) tracks.close();
+   gettimeofday(&end,NULL);
+
+   // Merge the workers
+   TrackWorker *total = workers[0];
+   for (uint j=1; j < workers.size(); j++) {
+      TrackWorker *w = workers[j];
+      total->events += w->events;
+      total->tracks += w->tracks;
+      for (uint m=0; m < setup.modules.size(); m++) {
+         total->clusters[m] += w->clusters[m];
+         total->residualStats[m].merge(&w->residualStats[m]);
+         for (uint i=0; i < RES_BINS; i++) total->residual[m][i] += w->residual[m][i];
+      }
+      for (uint l=0; l < CosmicMaxLayers; l++) {
+         total->expected[l] += w->expected[l];
+         total->found[l]    += w->found[l];
+      }
+      for (uint i=0; i < CHI2_BINS; i++) total->chi2[i] += w->chi2[i];
+      for (uint i=0; i < SLOPE_BINS; i++) total->slope[i] += w->slope[i];
+      for (uint i=0; i <= CosmicMaxLayers; i++) total->hits[i] += w->hits[i];
+   }
+
+   printf("%llu events, %llu tracks, in %.1f s with %d threads\n",total->events,total->tracks,
+          (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) * 1e-6,jobs);
+
+   // Histograms and report
+   sprintf(name,"%s_cosmic.root",inname.Data());
+   TFile *myFile = new TFile(name,"RECREATE");
+
+   TH1F *histChi2 = new TH1F("track_chi2","Track chi2/ndf;chi2/ndf",CHI2_BINS,0,CHI2_MAX);
+   TH1F *histSlope = new TH1F("track_slope","Track slope;du/dz",SLOPE_BINS,-setup.maxSlope,setup.maxSlope);
+   TH1F *histHits = new TH1F("track_hits","Hits per track;hits",CosmicMaxLayers + 1,-0.5,CosmicMaxLayers + 0.5);
+   for (uint i=0; i < CHI2_BINS; i++) histChi2->SetBinContent(i+1,total->chi2[i]);
+   for (uint i=0; i < SLOPE_BINS; i++) histSlope->SetBinContent(i+1,total->slope[i]);
+   for (uint i=0; i <= CosmicMaxLayers; i++) histHits->SetBinContent(i+1,total->hits[i]);
+
+   printf("module\tfpga\thybrid\tlayer\tz\tclusters/event\tresiduals\tmean\trms\tfit mean\tfit sigma\tefficiency\n");
+   for (uint m=0; m < setup.modules.size(); m++) {
+      StandModule     &module = setup.modules[m];
+      uint            layer   = total->tracker.moduleLayer(m);
+      GaussPeakResult fit;
+
+      sprintf(name,"residual_F%d_H%d",module.fpga,module.hybrid);
+      TH1F *hist = new TH1F(name,"Unbiased residual;residual [mm]",RES_BINS,-setup.window,setup.window);
+      for (uint i=0; i < RES_BINS; i++) hist->SetBinContent(i+1,total->residual[m][i]);
+
+      GaussPeak::fit(&total->residual[m][0],RES_BINS,-setup.window,2 * setup.window / RES_BINS,fit);
+      printf("%u\t%d\t%d\t%u\t%.2f\t%.3f\t\t%u\t\t%.4f\t%.4f\t%.4f\t\t%.4f\t\t%.4f\n",m,module.fpga,module.hybrid,layer,module.z,
+             total->events > 0 ? (double)total->clusters[m] / total->events : 0.0,total->residualStats[m].count(),
+             total->residualStats[m].mean(),total->residualStats[m].rms(),fit.ok ? fit.mean : 0.0,fit.ok ? fit.sigma : 0.0,
+             total->expected[layer] > 0 ? (double)total->found[layer] / total->expected[layer] : 0.0);
+   }
+
+   myFile->Write();
+   myFile->Close();
+   return(0);
+}
@@ -0,0 +1,202 @@
+//-----------------------------------------------------------------------------
+// File          : meeg_evio_send.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Replay EVIO files as a block stream to a socket, the way the event builder
+// feeds an online reader (DataReadEvio::open("tcp://:port")). Blocks go out as
+// fast as the reader takes them or at a fixed rate. If the reader goes away
+// the block being sent is sent again once it is back, so reconnects can be
+// tested by restarting either side.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <evio.h>
+using namespace std;
+
+// Block header
+#define EVIO_HDSIZ      8
+#define EVIO_MAGIC      0xc0da0100
+#define EVIO_LAST_BLOCK 0x200
+
+// Wall clock in seconds
+double now ( ) {
+   struct timeval tv;
+   gettimeofday(&tv,NULL);
+   return(tv.tv_sec + tv.tv_usec * 1e-6);
+}
+
+// Connect to the reader, retrying every second for up to wait seconds (forever if negative)
+int connectTo ( string address, int wait ) {
+   struct addrinfo hints, *res;
+   string          host = "localhost";
+   string          port = address;
+   size_t          colon = address.rfind(':');
+   int             fd;
+   double          start = now();
+
+   if ( colon != string::npos ) {
+      if ( colon > 0 ) host = address.substr(0,colon);
+      port = address.substr(colon+1);
+   }
+   memset(&hints,0,sizeof(hints));
+   hints.ai_family   = AF_INET;
+   hints.ai_socktype = SOCK_STREAM;
+   if ( getaddrinfo(host.c_str(),port.c_str(),&hints,&res) != 0 ) {
+      cout << "Bad address " << address << endl;
+      return(-1);
+   }
+   while ( true ) {
+      fd = socket(res->ai_family,res->ai_socktype,res->ai_protocol);
+      if ( fd >= 0 && connect(fd,res->ai_addr,res->ai_addrlen) == 0 ) break;
+      if ( fd >= 0 ) close(fd);
+      fd = -1;
+      if ( wait >= 0 && now() - start >= wait ) break;
+      sleep(1);
+   }
+   freeaddrinfo(res);
+   if ( fd >= 0 ) cout << "Connected to " << address << endl;
+   return(fd);
+}
+
+// Send bytes, returns false if the reader went away
+bool sendFully ( int fd, const void *data, size_t size ) {
+   const char *ptr = (const char *)data;
+   ssize_t    ret;
+
+   while ( size > 0 ) {
+      if ( (ret = send(fd,ptr,size,MSG_NOSIGNAL)) <= 0 ) return(false);
+      ptr  += ret;
+      size -= ret;
+   }
+   return(true);
+}
+
+int main ( int argc, char **argv ) {
+   double             rate = 0;
+   int                loops = 1;
+   int                wait = -1;
+   double             interval = 5.0;
+   string             address;
+   vector<uint>       block;
+   uint               header[EVIO_HDSIZ];
+   unsigned long long blocks = 0;
+   unsigned long long bytes = 0;
+   unsigned long long lastBytes = 0;
+   uint               reconnects = 0;
+   double             start, lastReport;
+   int                fd;
+   int                c;
+
+   while ((c = getopt(argc,argv,"hr:l:w:u:")) !=-1)
+      switch (c)
+      {
+         case 'h':
+            printf("Usage: meeg_evio_send [options] [host:]port evio_files\n");
+            printf("-h: print this help\n");
+            printf("-r: send at a fixed rate in blocks per second (default as fast as the reader takes them)\n");
+            printf("-l: send the files this many times (default 1)\n");
+            printf("-w: give up after this many seconds without a reader (default wait forever)\n");
+            printf("-u: report throughput every this many seconds (default 5)\n");
+            return(0);
+            break;
+         case 'r':
+            rate = atof(optarg);
+            break;
+         case 'l':
+            loops = atoi(optarg);
+            break;
+         case 'w':
+            wait = atoi(optarg);
+            break;
+         case 'u':
+            interval = atof(optarg);
+            break;
+         case '?':
+            printf("Invalid option or missing option argument; -h to list options\n");
+            return(1);
+         default:
+            abort();
+      }
+
+   if ( argc-optind < 2 ) {
+      cout << "Usage: meeg_evio_send [options] [host:]port evio_files\n";
+      return(1);
+   }
+   address = argv[optind];
+
+   if ( (fd = connectTo(address,wait)) < 0 ) return(2);
+   start = lastReport = now();
+
+   for (int loop=0; loop < loops; loop++) {
+      for (int f=optind+1; f < argc; f++) {
+         FILE *in = fopen(argv[f],"r");
+         if ( in == NULL ) {
+            cout << "Failed to open " << argv[f] << endl;
+            return(2);
+         }
+
+         while ( fread(header,sizeof(uint),EVIO_HDSIZ,in) == EVIO_HDSIZ ) {
+            bool swapped = (header[7] == EVIO_SWAP32(EVIO_MAGIC));
+            uint size    = swapped ? EVIO_SWAP32(header[0]) : header[0];
+            uint version = swapped ? EVIO_SWAP32(header[5]) : header[5];
+            if ( (! swapped && header[7] != EVIO_MAGIC) || size < EVIO_HDSIZ ) {
+               cout << "Bad block header in " << argv[f] << endl;
+               return(2);
+            }
+            block.resize(size);
+            memcpy(&block[0],header,sizeof(header));
+            if ( fread(&block[EVIO_HDSIZ],sizeof(uint),size-EVIO_HDSIZ,in) != size-EVIO_HDSIZ ) {
+               cout << "Truncated block in " << argv[f] << endl;
+               break;
+            }
+
+            // Only the last block of the last file ends the stream
+            if ( (version & EVIO_LAST_BLOCK) && (loop < loops-1 || f < argc-1) ) {
+               version &= ~EVIO_LAST_BLOCK;
+               block[5] = swapped ? EVIO_SWAP32(version) : version;
+            }
+
+            if ( rate > 0 ) {
+               double wait_s = start + blocks / rate - now();
+               if ( wait_s > 0 ) usleep((useconds_t)(wait_s * 1e6));
+            }
+
+            // The reader drops a partial block, so send the whole block again after a reconnect
+            while ( ! sendFully(fd,&block[0],size * sizeof(uint)) ) {
+               close(fd);
+               cout << "Reader went away, reconnecting" << endl;
+               if ( (fd = connectTo(address,wait)) < 0 ) return(2);
+               reconnects++;
+            }
+            blocks++;
+            bytes += size * sizeof(uint);
+
+            if ( now() - lastReport >= interval ) {
+               printf("%llu blocks, %.1f MB sent, %.1f MB/s\n",blocks,bytes/1e6,(bytes-lastBytes)/1e6/(now()-lastReport));
+               lastReport = now();
+               lastBytes  = bytes;
+            }
+         }
+         fclose(in);
+      }
+   }
+   close(fd);
+   printf("%llu blocks, %.1f MB sent in %.1f s, %u reconnects\n",blocks,bytes/1e6,now()-start,reconnects);
+   return(0);
+}
@@ -0,0 +1,193 @@
+//-----------------------------------------------------------------------------
+// File          : meeg_integrity.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Integrity check of the files of a run set (e.g. the baseline and cal_g?_d?
+// files of a QA run), several files at a time, before the fits are run.
+// Prints one line per file, and the failed checks of each source with -v.
+// The exit status is 3 if any file fails a check.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <meeg_utils.hh>
+#include <DevboardEvent.h>
+#include <TiTriggerEvent.h>
+#include <Data.h>
+#include <DataRead.h>
+#include <DataReadEvio.h>
+#include <IntegrityScan.h>
+using namespace std;
+
+// Files to check
+typedef struct {
+   char            **files;
+   int             count;
+   IntegrityReport *reports;   // sharedAlloc, one per file
+   bool            evio_format;
+   bool            triggerevent_format;
+   uint            hybrids;
+   long            num_events;
+} IntegrityJob;
+
+// Check one file
+void checkFile ( IntegrityJob *job, int index ) {
+   IntegrityReport *report = &job->reports[index];
+   IntegrityScan   scan(report,job->hybrids);
+   DataRead        *dataRead;
+   DataReadEvio    *evioRead = NULL;
+   DevboardEvent   event;
+   TiTriggerEvent  triggerevent;
+   long            eventCount = 0;
+
+   if (job->evio_format) {
+      evioRead = new DataReadEvio();
+      if (job->triggerevent_format) evioRead->set_engrun(true);
+      dataRead = evioRead;
+   } else
+      dataRead = new DataRead();
+
+   report->opened = dataRead->open(job->files[index]);
+   if ( report->opened ) {
+      if ( job->triggerevent_format ) {
+         while ( (job->num_events < 0 || eventCount < job->num_events) && dataRead->next(&triggerevent) ) {
+            scan.scan(&triggerevent,evioRead != NULL ? evioRead->last_bank_tag() : 0);
+            eventCount++;
+         }
+      }
+      else {
+         while ( (job->num_events < 0 || eventCount < job->num_events) && dataRead->next(&event) ) {
+            scan.scan(&event);
+            eventCount++;
+         }
+      }
+      dataRead->close();
+   }
+   delete dataRead;
+}
+
+// Check every workers'th file, starting at worker
+void checkFiles ( void *arg, int worker, int workers ) {
+   IntegrityJob *job = (IntegrityJob *)arg;
+   for (int i=worker; i < job->count; i+=workers) checkFile(job,i);
+}
+
+// Print the report of a file
+void printReport ( const char *file, const IntegrityReport *report, bool verbose ) {
+   unsigned long long missing = 0, badCount = 0, backwards = 0, tiBackwards = 0;
+
+   if ( ! report->opened ) {
+      printf("BAD  %s: could not be opened\n",file);
+      return;
+   }
+   for (uint i=0; i < report->sourceCount; i++) {
+      const IntegritySource &src = report->sources[i];
+      missing     += src.missing;
+      badCount    += src.badCount;
+      backwards   += src.backwards + src.repeats;
+      tiBackwards += src.tiBackwards + src.tsBackwards;
+   }
+   printf("%s %s: %llu frames, %u sources, %llu missing, %llu out of order, %llu TI back, %llu bad counts, "
+          "%llu samples, %llu errors, %llu unpaired, %llu zero, %llu saturated\n",
+          IntegrityScan::clean(report) ? "OK  " : "BAD ",file,report->frames,report->sourceCount,missing,backwards,
+          tiBackwards,badCount,report->samples,report->errorFlags,report->unpaired,report->zeroAdc,report->saturatedAdc);
+   if ( report->overflow > 0 ) printf("     %llu frames of sources beyond the first %u\n",report->overflow,IntegrityReport::MaxSources);
+
+   if ( ! verbose ) return;
+   for (uint i=0; i < report->sourceCount; i++) {
+      const IntegritySource &src = report->sources[i];
+      printf("     source %d: %llu frames, sequence %llu gaps (%llu missing) %llu repeats %llu back, "
+             "TI %llu back, timestamp %llu back, %llu without TI, %llu of %llu frames not %u samples\n",
+             src.id,src.frames,src.gaps,src.missing,src.repeats,src.backwards,src.tiBackwards,src.tsBackwards,
+             src.noTi,src.badCount,src.frames,src.expected);
+   }
+}
+
+int main ( int argc, char **argv ) {
+   IntegrityJob   job;
+   bool           verbose = false;
+   int            jobs = 1;
+   int            bad = 0;
+   struct timeval start, end;
+   int            c;
+
+   job.evio_format         = false;
+   job.triggerevent_format = false;
+   job.hybrids             = 0;
+   job.num_events          = -1;
+
+   while ((c = getopt(argc,argv,"hn:e:EVj:v")) !=-1)
+      switch (c)
+      {
+         case 'h':
+            printf("Usage: meeg_integrity [options] data_files\n");
+            printf("-h: print this help\n");
+            printf("-n: expect 640 samples per hybrid for this many hybrids (default: as the first frame of each FPGA)\n");
+            printf("-e: stop after specified number of events per file\n");
+            printf("-E: use EVIO file format\n");
+            printf("-V: use TriggerEvent event format\n");
+            printf("-j: check in specified number of processes (0 for all cores)\n");
+            printf("-v: print the checks of every FPGA\n");
+            return(0);
+            break;
+         case 'n':
+            job.hybrids = atoi(optarg);
+            break;
+         case 'e':
+            job.num_events = atol(optarg);
+            break;
+         case 'E':
+            job.evio_format = true;
+            break;
+         case 'V':
+            job.triggerevent_format = true;
+            break;
+         case 'j':
+            jobs = atoi(optarg);
+            if (jobs<=0) jobs = numCores();
+            break;
+         case 'v':
+            verbose = true;
+            break;
+         case '?':
+            printf("Invalid option or missing option argument; -h to list options\n");
+            return(1);
+         default:
+            abort();
+      }
+
+   if ( argc-optind == 0 ) {
+      cout << "Usage: meeg_integrity [options] data_files\n";
+      return(1);
+   }
+
+   job.files   = &argv[optind];
+   job.count   = argc - optind;
+   job.reports = (IntegrityReport *)sharedAlloc(job.count * sizeof(IntegrityReport));
+   if ( job.reports == NULL ) {
+      cout << "Could not allocate the reports" << endl;
+      return(2);
+   }
+
+   gettimeofday(&start,NULL);
+   forkWorkers(jobs<job.count?jobs:job.count,checkFiles,&job);
+   gettimeofday(&end,NULL);
+
+   for (int i=0; i < job.count; i++) {
+      printReport(job.files[i],&job.reports[i],verbose);
+      if ( ! IntegrityScan::clean(&job.reports[i]) ) bad++;
+   }
+   printf("%d of %d files failed, checked in %.1f s\n",bad,job.count,
+          (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) * 1e-6);
+   return(bad > 0 ? 3 : 0);
+}
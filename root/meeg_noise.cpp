@@ -0,0 +1,171 @@
+//-----------------------------------------------------------------------------
+// File          : meeg_noise.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Noise power spectra of all channels and APVs in one pass (NoiseSpectrum):
+// per channel sample spectra, APV common mode spectra with the coherent
+// fraction of each frequency, and spectra along the APV readout order, which
+// show pickup shared by the channels of an APV.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <TString.h>
+#include <Data.h>
+#include <DataRead.h>
+#include <DataReadEvio.h>
+#include <DevboardEvent.h>
+#include <DevboardSample.h>
+#include <TiTriggerEvent.h>
+#include <TriggerSample.h>
+#include <NoiseSpectrum.h>
+using namespace std;
+
+int main ( int argc, char **argv ) {
+   bool              evio_format = false;
+   bool              triggerevent_format = false;
+   string            base_file = "";
+   int               warmup = -1;
+   uint              num_peaks = 3;
+   long              num_events = -1;
+   TString           outname = "";
+   DataRead          *dataRead;
+   DevboardEvent     event;
+   TiTriggerEvent    triggerevent;
+   TriggerSample     triggersample;
+   Data              *frame;
+   NoiseSpectrum     spectrum;
+   uint              values[6];
+   long              eventCount = 0;
+   int               c;
+
+   while ((c = getopt(argc,argv,"hb:w:p:EVe:o:")) !=-1)
+      switch (c)
+      {
+         case 'h':
+            printf("Usage: meeg_noise [options] data_files\n");
+            printf("-h: print this help\n");
+            printf("-b: pedestals from this baseline (.base) file instead of running means\n");
+            printf("-w: readouts before a running pedestal is used (default 100)\n");
+            printf("-p: number of readout order peaks to print per APV (default 3)\n");
+            printf("-E: use EVIO file format\n");
+            printf("-V: use TriggerEvent event format\n");
+            printf("-e: stop after specified number of events\n");
+            printf("-o: use specified output filename base\n");
+            printf("Writes the spectra to <name>.noise\n");
+            return(0);
+            break;
+         case 'b':
+            base_file = optarg;
+            break;
+         case 'w':
+            warmup = atoi(optarg);
+            break;
+         case 'p':
+            num_peaks = atoi(optarg);
+            break;
+         case 'E':
+            evio_format = true;
+            break;
+         case 'V':
+            triggerevent_format = true;
+            break;
+         case 'e':
+            num_events = atol(optarg);
+            break;
+         case 'o':
+            outname = optarg;
+            break;
+         case '?':
+            printf("Invalid option or missing option argument; -h to list options\n");
+            return(1);
+         default:
+            abort();
+      }
+
+   if ( argc-optind==0 ) {
+      cout << "Usage: meeg_noise [options] data_files\n";
+      return(1);
+   }
+
+   if ( base_file != "" && ! spectrum.loadBaseline(base_file) ) {
+      cout << "Could not read baseline from " << base_file << endl;
+      return(1);
+   }
+   if ( warmup >= 0 ) spectrum.setWarmup(warmup);
+
+   if (outname == "") {
+      outname = argv[optind];
+      outname.ReplaceAll(".bin","");
+      if (outname.Contains('/')) {
+         outname.Remove(0,outname.Last('/')+1);
+      }
+   }
+
+   if (evio_format) {
+      DataReadEvio *tmpDataRead = new DataReadEvio();
+      if (triggerevent_format)
+         tmpDataRead->set_engrun(true);
+      dataRead = tmpDataRead;
+   } else
+      dataRead = new DataRead();
+
+   if (triggerevent_format) frame = &triggerevent;
+   else frame = &event;
+
+   for (; optind < argc && (num_events < 0 || eventCount < num_events); optind++) {
+      cout << "Reading data file " << argv[optind] << endl;
+      if ( ! dataRead->open(argv[optind]) ) {
+         printf("bad file: %s\n",argv[optind]);
+         continue;
+      }
+
+      while ( (num_events < 0 || eventCount < num_events) && dataRead->next(frame) ) {
+         if (eventCount%1000==0) printf("Event %ld\n",eventCount);
+         eventCount++;
+
+         spectrum.begin();
+         if (triggerevent_format) {
+            for (uint x=0; x < triggerevent.count(); x++) {
+               triggerevent.sample(x,&triggersample);
+               if ( triggersample.head() || triggersample.tail() ) continue;
+               for (uint y=0; y < 6; y++) values[y] = triggersample.value(y);
+               spectrum.add(triggersample.rceAddress(),triggersample.febAddress(),triggersample.hybrid(),
+                            triggersample.apv(),triggersample.channel(),values);
+            }
+         }
+         else if ( event.fpgaAddress() != 7 && ! event.isTiFrame() ) {
+            for (uint x=0; x < event.count(); x++) {
+               DevboardSample *sample = event.sample(x);
+               for (uint y=0; y < 6; y++) values[y] = sample->value(y) & 0x3FFF;
+               spectrum.add(0,event.fpgaAddress(),sample->hybrid(),sample->apv(),sample->channel(),values);
+            }
+         }
+         spectrum.process();
+      }
+      dataRead->close();
+   }
+   delete dataRead;
+
+   ofstream outfile;
+   cout << "Writing noise spectra to " << outname+".noise" << endl;
+   outfile.open(outname+".noise");
+   outfile << "#" << outname << endl;
+   spectrum.report(outfile);
+   outfile.close();
+
+   cout << "Strongest readout order bins (bin k at k/128 of the multiplexing rate):" << endl;
+   spectrum.peaks(cout,num_peaks);
+   return(0);
+}
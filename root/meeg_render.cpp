@@ -0,0 +1,199 @@
+//-----------------------------------------------------------------------------
+// File          : meeg_render.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Draws the plots recorded in a .plots file (e.g. meeg_tp -f -D) in a number
+// of processes. Plots can be selected by image name, and images that already
+// exist can be skipped, so single plots are drawn on demand in about a second.
+// Images go next to the .plots file unless another directory is given.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fnmatch.h>
+#include <sys/stat.h>
+#include <TROOT.h>
+#include <TCanvas.h>
+#include <TStyle.h>
+#include <TH2S.h>
+#include <TF1.h>
+#include <TGraphErrors.h>
+#include <TAxis.h>
+#include <PlotRecord.h>
+#include "meeg_utils.hh"
+using namespace std;
+
+// Plots to draw
+typedef struct {
+   vector<PlotRecord> *plots;
+   string             outdir;
+   TCanvas            *c1;
+} RenderJob;
+
+// Draw one plot
+void renderPlot ( PlotRecord &plot, string file, TCanvas *c1 ) {
+   vector<TObject *> drawn;
+   char              name[50];
+
+   if ( plot.flags & PlotNoStats ) gStyle->SetOptStat(0);
+   else gStyle->SetOptStat("emrou");
+   c1->Clear();
+
+   for (uint i=0; i < plot.items.size(); i++) {
+      PlotRecord::Item &item = plot.items[i];
+      vector<double>   &v    = item.values;
+      sprintf(name,"render_%d",i);
+
+      if ( item.type == PlotItemHist2 && v.size() >= 8 ) {
+         TH2S *hist = new TH2S(name,plot.title.c_str(),(int)v[0],v[1],v[2],(int)v[3],v[4],v[5]);
+         for (uint j=8; j+2 < v.size(); j+=3) hist->Fill(v[j],v[j+1],v[j+2]);
+         hist->GetYaxis()->SetRangeUser(v[6],v[7]);
+         hist->SetLineColor(item.lineColor);
+         hist->Draw(item.option.c_str());
+         drawn.push_back(hist);
+      }
+      else if ( item.type == PlotItemGraph && v.size() >= 1 && v.size() == 1 + 3 * (uint)v[0] ) {
+         uint         n     = (uint)v[0];
+         TGraphErrors *graph = new TGraphErrors(n,&v[1],&v[1+n],NULL,&v[1+2*n]);
+         graph->SetTitle(plot.title.c_str());
+         graph->SetLineColor(item.lineColor);
+         graph->SetLineStyle(item.lineStyle);
+         graph->SetLineWidth(item.lineWidth);
+         graph->Draw(item.option.c_str());
+         drawn.push_back(graph);
+      }
+      else if ( item.type == PlotItemFunction && v.size() >= 3 && (uint)v[0] == PlotFunctionFourPole ) {
+         TF1 *function = new TF1(name,fitf_4pole,v[1],v[2],5);
+         for (uint j=0; j < 5 && 3+j < v.size(); j++) function->SetParameter(j,v[3+j]);
+         function->SetLineColor(item.lineColor);
+         function->SetLineStyle(item.lineStyle);
+         function->SetLineWidth(item.lineWidth);
+         function->Draw(item.option.c_str());
+         drawn.push_back(function);
+      }
+      else printf("Skipping unknown item %d of %s\n",i,plot.name.c_str());
+   }
+   c1->SaveAs(file.c_str());
+   c1->Clear();
+   for (uint i=0; i < drawn.size(); i++) delete drawn[i];
+}
+
+// Draw every workers'th plot, starting at worker
+void renderPlots ( void *arg, int worker, int workers ) {
+   RenderJob *job = (RenderJob *)arg;
+   for (uint i=worker; i < job->plots->size(); i+=workers)
+      renderPlot((*job->plots)[i],job->outdir + (*job->plots)[i].name,job->c1);
+}
+
+int main ( int argc, char **argv ) {
+   vector<string>     patterns;
+   string             outdir = "";
+   bool               missing_only = false;
+   bool               list = false;
+   int                jobs = 1;
+   PlotReader         reader;
+   PlotRecord         plot;
+   vector<PlotRecord> plots;
+   uint               total = 0;
+   struct stat        st;
+   int                c;
+
+   while ((c = getopt(argc,argv,"hm:uo:j:l")) !=-1)
+      switch (c)
+      {
+         case 'h':
+            printf("Usage: meeg_render [options] plots_file [plots_file ...]\n");
+            printf("-h: print this help\n");
+            printf("-m: draw only the plots whose image name matches this pattern (repeatable, e.g. '*_tp_fit_pos_17.png')\n");
+            printf("-u: draw only the plots whose image does not exist yet\n");
+            printf("-o: write the images to this directory (default: that of the plots file)\n");
+            printf("-j: draw in specified number of processes (0 for all cores)\n");
+            printf("-l: list the plots instead of drawing them\n");
+            return(0);
+            break;
+         case 'm':
+            patterns.push_back(optarg);
+            break;
+         case 'u':
+            missing_only = true;
+            break;
+         case 'o':
+            outdir = optarg;
+            if ( outdir != "" && outdir[outdir.size()-1] != '/' ) outdir += "/";
+            break;
+         case 'j':
+            jobs = atoi(optarg);
+            if (jobs<=0) jobs = numCores();
+            break;
+         case 'l':
+            list = true;
+            break;
+         case '?':
+            printf("Invalid option or missing option argument; -h to list options\n");
+            return(1);
+         default:
+            abort();
+      }
+
+   if ( argc-optind == 0 ) {
+      cout << "Usage: meeg_render [options] plots_file [plots_file ...]\n";
+      return(1);
+   }
+
+   gROOT->SetBatch(kTRUE);
+   gROOT->SetStyle("Plain");
+   gStyle->SetPalette(1,0);
+   gStyle->SetOptStat("emrou");
+   gStyle->SetStatW(0.2);
+   gStyle->SetStatH(0.1);
+   gStyle->SetTitleOffset(1.4,"y");
+   gStyle->SetPadLeftMargin(0.15);
+   TCanvas *c1 = new TCanvas("c1","c1",1200,900);
+
+   for (int f=optind; f < argc; f++) {
+      string dir = outdir;
+      if ( dir == "" ) {
+         string file = argv[f];
+         if ( file.find('/') != string::npos ) dir = file.substr(0,file.rfind('/')+1);
+      }
+      if ( ! reader.open(argv[f]) ) {
+         cout << "Failed to open " << argv[f] << endl;
+         return(2);
+      }
+
+      plots.clear();
+      while ( reader.next(plot) ) {
+         total++;
+         if ( ! patterns.empty() ) {
+            uint p;
+            for (p=0; p < patterns.size(); p++) if ( fnmatch(patterns[p].c_str(),plot.name.c_str(),0) == 0 ) break;
+            if ( p == patterns.size() ) continue;
+         }
+         if ( missing_only && stat((dir + plot.name).c_str(),&st) == 0 ) continue;
+         if ( list ) cout << dir + plot.name << "\t" << plot.items.size() << " items" << endl;
+         else plots.push_back(plot);
+      }
+      reader.close();
+      if ( list || plots.empty() ) continue;
+
+      cout << "Drawing " << plots.size() << " plots from " << argv[f] << endl;
+      RenderJob job;
+      job.plots  = &plots;
+      job.outdir = dir;
+      job.c1     = c1;
+      forkWorkers(jobs<(int)plots.size()?jobs:plots.size(),renderPlots,&job);
+   }
+   cout << total << " plots read" << endl;
+   return(0);
+}
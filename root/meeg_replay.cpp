@@ -0,0 +1,349 @@
+//-----------------------------------------------------------------------------
+// File          : meeg_replay.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Replay recorded runs into the live data shared memory, for load and soak
+// tests of the online consumers (DataRead::openShared) without hardware.
+// Records go out as fast as possible, at a fixed rate or in real time from
+// the TI timestamps. Producer throughput is reported periodically; with -m a
+// monitor consumer reads the ring as well and reports its lag and drops.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <iostream>
+#include <string>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <Data.h>
+#include <DataRead.h>
+#include <DataReadEvio.h>
+#include <DataSharedMem.h>
+#include <DevboardEvent.h>
+#include <TiTriggerEvent.h>
+using namespace std;
+
+// Monitor consumer state
+struct ReplayMonitor {
+   string          system;
+   uint            id;
+   pthread_mutex_t mutex;
+   bool            done;
+   bool            failed;
+   unsigned long   frames;
+   unsigned long   dropped;
+   uint            lag;
+   uint            maxLag;
+};
+
+// Wall clock in seconds
+double now ( ) {
+   struct timeval tv;
+   gettimeofday(&tv,NULL);
+   return(tv.tv_sec + tv.tv_usec * 1e-6);
+}
+
+// Wait until the given wall clock time
+void waitUntil ( double target ) {
+   double wait = target - now();
+   if ( wait > 0 ) usleep((useconds_t)(wait * 1e6));
+}
+
+// Write the XML records read so far, returns the number of records written
+uint writeXml ( DataRead *dataRead, DataSharedMemory *smem, unsigned long long &bytes, unsigned long &oversize ) {
+   uint   type;
+   string xml;
+   uint   count = 0;
+   uint   len;
+
+   while ( dataRead->takeXml(type,xml) ) {
+
+      // Same size check as dataSharedWrite
+      len = xml.length()+1;
+      if ( (len+1) >= DATA_BUFF_SIZE ) {
+         oversize++;
+         continue;
+      }
+      dataSharedWrite(smem,(type << 28) | len,xml.c_str(),len);
+      bytes += len;
+      count++;
+   }
+   return(count);
+}
+
+// Monitor consumer thread, reads the ring like an online tool
+void *monitorThread ( void *arg ) {
+   ReplayMonitor *mon = (ReplayMonitor *)arg;
+   DataRead      reader;
+   Data          frame;
+   bool          done;
+
+   try {
+      reader.openShared(mon->system,mon->id);
+   } catch ( string error ) {
+      cout << "Monitor: " << error << endl;
+      pthread_mutex_lock(&mon->mutex);
+      mon->failed = true;
+      pthread_mutex_unlock(&mon->mutex);
+      return(NULL);
+   }
+
+   while ( true ) {
+      bool got = reader.next(&frame);
+
+      pthread_mutex_lock(&mon->mutex);
+      if ( got ) mon->frames++;
+      mon->dropped = reader.sharedDropped();
+      mon->lag     = reader.sharedLag();
+      if ( mon->lag > mon->maxLag ) mon->maxLag = mon->lag;
+      done = mon->done;
+      pthread_mutex_unlock(&mon->mutex);
+
+      if ( ! got ) {
+         if ( done ) break;
+         usleep(100);
+      }
+   }
+   return(NULL);
+}
+
+int main ( int argc, char **argv ) {
+   bool              evio_format = false;
+   bool              triggerevent_format = false;
+   string            shared_system = "";
+   uint              shared_id = 1;
+   double            rate = 0;
+   bool              realtime = false;
+   double            tick_ns = 4.0;
+   double            speed = 1.0;
+   int               loops = 1;
+   long              num_events = -1;
+   bool              monitor = false;
+   double            interval = 5.0;
+   DataRead          *dataRead;
+   DevboardEvent     event;
+   TiTriggerEvent    triggerevent;
+   Data              *frame;
+   DataSharedMemory  *smem;
+   ReplayMonitor     mon;
+   pthread_t         monThread;
+   int               c;
+
+   while ((c = getopt(argc,argv,"hs:i:r:Tk:x:l:e:EVmu:")) !=-1)
+      switch (c)
+      {
+         case 'h':
+            printf("Usage: meeg_replay [options] -s system data_files\n");
+            printf("-h: print this help\n");
+            printf("-s: write to the shared memory of this system\n");
+            printf("-i: shared memory id (default 1)\n");
+            printf("-r: replay at a fixed rate in Hz (default as fast as possible)\n");
+            printf("-T: replay in real time from the TI timestamps (needs -V)\n");
+            printf("-k: TI timestamp tick in ns for -T (default 4)\n");
+            printf("-x: speed factor for -T (default 1)\n");
+            printf("-l: replay the files this many times, 0 for forever (default 1)\n");
+            printf("-e: stop after specified number of events per pass\n");
+            printf("-E: use EVIO file format\n");
+            printf("-V: use TriggerEvent event format\n");
+            printf("-m: run a monitor consumer and report its lag and drops\n");
+            printf("-u: report interval in seconds (default 5)\n");
+            printf("Consumers read the replayed frames without -E\n");
+            return(0);
+            break;
+         case 's':
+            shared_system = optarg;
+            break;
+         case 'i':
+            shared_id = atoi(optarg);
+            break;
+         case 'r':
+            rate = atof(optarg);
+            break;
+         case 'T':
+            realtime = true;
+            break;
+         case 'k':
+            tick_ns = atof(optarg);
+            break;
+         case 'x':
+            speed = atof(optarg);
+            break;
+         case 'l':
+            loops = atoi(optarg);
+            break;
+         case 'e':
+            num_events = atol(optarg);
+            break;
+         case 'E':
+            evio_format = true;
+            break;
+         case 'V':
+            triggerevent_format = true;
+            break;
+         case 'm':
+            monitor = true;
+            break;
+         case 'u':
+            interval = atof(optarg);
+            break;
+         case '?':
+            printf("Invalid option or missing option argument; -h to list options\n");
+            return(1);
+         default:
+            abort();
+      }
+
+   if ( argc-optind==0 || shared_system == "" ) {
+      cout << "Usage: meeg_replay [options] -s system data_files\n";
+      return(1);
+   }
+   if ( realtime && ! triggerevent_format ) {
+      cout << "Real time replay needs the TI timestamps of the TriggerEvent format (-V)" << endl;
+      return(1);
+   }
+   if ( speed <= 0 ) speed = 1.0;
+
+   if ( dataSharedOpenAndMap(&smem,shared_system.c_str(),shared_id) < 0 ) {
+      cout << "Could not open shared memory for system " << shared_system << endl;
+      return(1);
+   }
+   dataSharedInit(smem);
+   cout << "Writing shared memory " << smem->sharedName << endl;
+
+   if ( monitor ) {
+      mon.system  = shared_system;
+      mon.id      = shared_id;
+      mon.done    = false;
+      mon.failed  = false;
+      mon.frames  = 0;
+      mon.dropped = 0;
+      mon.lag     = 0;
+      mon.maxLag  = 0;
+      pthread_mutex_init(&mon.mutex,NULL);
+      pthread_create(&monThread,NULL,monitorThread,&mon);
+   }
+
+   if (evio_format) {
+      DataReadEvio *tmpDataRead = new DataReadEvio();
+      if (triggerevent_format)
+         tmpDataRead->set_engrun(true);
+      dataRead = tmpDataRead;
+   } else
+      dataRead = new DataRead();
+   dataRead->setKeepXml(true);
+
+   if (triggerevent_format) frame = &triggerevent;
+   else frame = &event;
+
+   unsigned long records = 0;
+   unsigned long frames = 0;
+   unsigned long oversize = 0;
+   unsigned long late = 0;
+   unsigned long long bytes = 0;
+   double start = now();
+   double lastReport = start;
+   unsigned long lastFrames = 0;
+   unsigned long long lastBytes = 0;
+
+   for (int pass=0; loops == 0 || pass < loops; pass++) {
+      double        wallRef = now();
+      unsigned long tiRef = 0;
+      bool          haveTiRef = false;
+      long          passCount = 0;
+      bool          readAny = false;
+
+      for (int arg=optind; arg < argc && (num_events < 0 || passCount < num_events); arg++) {
+         if ( pass == 0 ) cout << "Reading data file " << argv[arg] << endl;
+         if ( ! dataRead->open(argv[arg]) ) {
+            printf("bad file: %s\n",argv[arg]);
+            continue;
+         }
+
+         while ( (num_events < 0 || passCount < num_events) && dataRead->next(frame) ) {
+            double target = 0;
+
+            readAny = true;
+
+            // XML records read with the frame go out first
+            records += writeXml(dataRead,smem,bytes,oversize);
+
+            // Pacing
+            if ( realtime ) {
+               if ( triggerevent.hasTiData() ) {
+                  unsigned long ts = triggerevent.timeStamp();
+                  if ( ! haveTiRef || ts < tiRef ) {
+                     tiRef     = ts;
+                     wallRef   = now();
+                     haveTiRef = true;
+                  }
+                  target = wallRef + (ts - tiRef) * tick_ns * 1e-9 / speed;
+               }
+            }
+            else if ( rate > 0 ) target = wallRef + passCount / rate;
+
+            if ( target > 0 ) {
+               if ( now() > target + 0.01 ) late++;
+               waitUntil(target);
+            }
+
+            // Same size check as dataSharedWrite
+            uint size = frame->size();
+            if ( (size*4+1) < DATA_BUFF_SIZE ) {
+               dataSharedWrite(smem,size,(char *)frame->data(),size*4);
+               records++;
+               frames++;
+               bytes += size*4;
+            }
+            else oversize++;
+            passCount++;
+
+            // Periodic report
+            double t = now();
+            if ( t - lastReport >= interval ) {
+               printf("Replay: %lu frames, %.1f Hz, %.2f MB/s",frames,(frames-lastFrames)/(t-lastReport),
+                      (bytes-lastBytes)/(t-lastReport)/1e6);
+               if ( monitor ) {
+                  pthread_mutex_lock(&mon.mutex);
+                  printf(", monitor %lu frames, lag %u (max %u), dropped %lu",mon.frames,mon.lag,mon.maxLag,mon.dropped);
+                  pthread_mutex_unlock(&mon.mutex);
+               }
+               printf("\n");
+               lastReport = t;
+               lastFrames = frames;
+               lastBytes  = bytes;
+            }
+         }
+         records += writeXml(dataRead,smem,bytes,oversize);
+         dataRead->close();
+      }
+      if ( ! readAny ) break;
+   }
+   delete dataRead;
+
+   double elapsed = now() - start;
+
+   if ( monitor ) {
+      pthread_mutex_lock(&mon.mutex);
+      mon.done = true;
+      pthread_mutex_unlock(&mon.mutex);
+      pthread_join(monThread,NULL);
+   }
+
+   printf("Replayed %lu frames (%lu records) in %.1f s: %.1f Hz, %.2f MB/s\n",frames,records,elapsed,
+          elapsed>0?frames/elapsed:0.0,elapsed>0?bytes/elapsed/1e6:0.0);
+   if ( oversize ) printf("Skipped %lu frames and XML records too large for the shared memory buffers\n",oversize);
+   if ( realtime || rate > 0 ) printf("Frames sent more than 10 ms late: %lu\n",late);
+   if ( monitor && ! mon.failed )
+      printf("Monitor consumer: %lu frames, max lag %u, dropped %lu\n",mon.frames,mon.maxLag,mon.dropped);
+
+   dataSharedClose(smem);
+   return(0);
+}
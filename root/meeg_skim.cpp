@@ -0,0 +1,196 @@
+//-----------------------------------------------------------------------------
+// File          : meeg_skim.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Skim and split run files: reads the input once and writes the readouts of
+// the selected RCE/FEB/hybrid, event range, TI timestamp window or error
+// frames to reduced files, or one file per (RCE, FEB, hybrid). The reduced
+// files use the DataRead format with the frames and XML records of the input,
+// or with -E the EVIO format, written through DataWriteEvio.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+// 10/19/2026: EVIO input is skimmed to EVIO files
+//-----------------------------------------------------------------------------
+#include <iostream>
+#include <string>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <TString.h>
+#include <Data.h>
+#include <DataRead.h>
+#include <DataReadEvio.h>
+#include <DevboardEvent.h>
+#include <TiTriggerEvent.h>
+#include <DataSkim.h>
+using namespace std;
+
+// Copy the XML records read so far to the outputs
+void copyXml ( DataRead *dataRead, DataSkim *skim ) {
+   uint   type;
+   string xml;
+
+   while ( dataRead->takeXml(type,xml) ) skim->xml(type,xml);
+}
+
+int main ( int argc, char **argv ) {
+   bool              evio_format = false;
+   bool              triggerevent_format = false;
+   bool              compressed = false;
+   int               rce = -1;
+   int               feb = -1;
+   int               hyb = -1;
+   unsigned long     first = 0;
+   long              num_events = -1;
+   uint              buffer_mb = DataWrite::DefaultBuffer >> 20;
+   TString           outname = "";
+   DataRead          *dataRead;
+   DataReadEvio      *evioRead = NULL;
+   DevboardEvent     event;
+   TiTriggerEvent    triggerevent;
+   Data              *frame;
+   DataSkim          skim;
+   bool              more = true;
+   int               c;
+
+   while ((c = getopt(argc,argv,"hR:F:H:sf:e:t:xzB:EVo:")) !=-1)
+      switch (c)
+      {
+         case 'h':
+            printf("Usage: meeg_skim [options] data_files\n");
+            printf("-h: print this help\n");
+            printf("-R: keep only readouts of this RCE\n");
+            printf("-F: keep only readouts of this FEB (FPGA for DevboardEvent data)\n");
+            printf("-H: keep only readouts of this hybrid\n");
+            printf("-s: write one file per RCE, FEB and hybrid\n");
+            printf("-f: skip this many frames (one per FPGA or ROC bank, not per trigger)\n");
+            printf("-e: stop after specified number of frames (one per FPGA or ROC bank, not per trigger)\n");
+            printf("-t: keep only frames with a TI timestamp in start,end (TriggerEvent format)\n");
+            printf("-x: keep only frames with a readout error flag set\n");
+            printf("-z: write bzip2 compressed files (not with -E)\n");
+            printf("-B: write buffer size in MB, EVIO block size with -E (default %d)\n",buffer_mb);
+            printf("-E: use EVIO file format, for the input and the skimmed files\n");
+            printf("-V: use TriggerEvent event format\n");
+            printf("-o: use specified output filename base\n");
+            printf("Writes <name>.skim.bin or <name>_R<rce>_F<feb>_H<hyb>.skim.bin, .skim.evio with -E\n");
+            return(0);
+            break;
+         case 'R':
+            rce = atoi(optarg);
+            break;
+         case 'F':
+            feb = atoi(optarg);
+            break;
+         case 'H':
+            hyb = atoi(optarg);
+            break;
+         case 's':
+            skim.setSplit(true);
+            break;
+         case 'f':
+            first = atol(optarg);
+            break;
+         case 'e':
+            num_events = atol(optarg);
+            break;
+         case 't': {
+            char *comma;
+            unsigned long long start = strtoull(optarg,&comma,0);
+            if ( *comma != ',' ) {
+               printf("Time window must be start,end\n");
+               return(1);
+            }
+            skim.setTimeWindow(start,strtoull(comma+1,NULL,0));
+            break;
+         }
+         case 'x':
+            skim.setErrorsOnly(true);
+            break;
+         case 'z':
+            compressed = true;
+            break;
+         case 'B':
+            buffer_mb = atoi(optarg);
+            break;
+         case 'E':
+            evio_format = true;
+            break;
+         case 'V':
+            triggerevent_format = true;
+            break;
+         case 'o':
+            outname = optarg;
+            break;
+         case '?':
+            printf("Invalid option or missing option argument; -h to list options\n");
+            return(1);
+         default:
+            abort();
+      }
+
+   if ( argc-optind==0 ) {
+      cout << "Usage: meeg_skim [options] data_files\n";
+      return(1);
+   }
+
+   if (outname == "") {
+      outname = argv[optind];
+      outname.ReplaceAll(".bin","");
+      if (outname.Contains('/')) {
+         outname.Remove(0,outname.Last('/')+1);
+      }
+   }
+
+   if (evio_format) {
+      evioRead = new DataReadEvio();
+      if (triggerevent_format)
+         evioRead->set_engrun(true);
+      dataRead = evioRead;
+      skim.setEvio(true,evioRead->bank_num());
+   } else
+      dataRead = new DataRead();
+
+   skim.select(rce,feb,hyb);
+   skim.setEventRange(first,num_events < 0 ? 0 : first+num_events);
+   if ( ! skim.open(outname.Data(),compressed,buffer_mb << 20) ) {
+      cout << "Could not create output for " << outname << endl;
+      delete dataRead;
+      return(1);
+   }
+   dataRead->setKeepXml(true);
+
+   if (triggerevent_format) frame = &triggerevent;
+   else frame = &event;
+
+   for (; optind < argc && more; optind++) {
+      cout << "Reading data file " << argv[optind] << endl;
+      if ( ! dataRead->open(argv[optind]) ) {
+         printf("bad file: %s\n",argv[optind]);
+         continue;
+      }
+
+      while ( more && dataRead->next(frame) ) {
+         copyXml(dataRead,&skim);
+         if (skim.frames()%1000==0) printf("Frame %lu\n",skim.frames());
+         if (evioRead != NULL) skim.setBank(evioRead->last_bank_tag());
+
+         if (triggerevent_format) more = skim.process(&triggerevent);
+         else more = skim.process(&event);
+      }
+      copyXml(dataRead,&skim);
+      dataRead->close();
+   }
+   delete dataRead;
+
+   bool ok = skim.close();
+   skim.report(cout);
+   printf("Frames %lu, kept %lu\n",skim.frames(),skim.kept());
+   printf("Data volume %llu -> %llu words\n",skim.wordsIn(),skim.wordsOut());
+   return(ok ? 0 : 1);
+}
@@ -33,6 +33,8 @@
 #include <Data.h>
 #include <DataRead.h>
 #include <DataReadEvio.h>
+#include <ResultCache.h>
+#include <StripClusterer.h>
 #include "ShapingCurve.hh"
 #include "SmoothShapingCurve.hh"
 #include "Samples.hh"
@@ -98,6 +100,7 @@ int main ( int argc, char **argv ) {
 	char title[200];
 	ShapingCurve *myShape[640];
 	Fitter *myFitter[640];
+	StripClusterer clusterer(10.0,3.0);
 
 	TH1F *histT0[640];
 	TH1F *histA[640];
@@ -124,9 +127,11 @@ int main ( int argc, char **argv ) {
 	double minT0 = 200.0;
 	TGraph *T0_dist;
 	double T0_dist_b,T0_dist_m;
+	ResultCache *cache = NULL;
+	bool cache_refresh = false;
 
 
-	while ((c = getopt(argc,argv,"hfso:uc:d:tbnH:F:e:E")) !=-1)
+	while ((c = getopt(argc,argv,"hfso:uc:d:tbnH:F:e:EC:R")) !=-1)
 		switch (c)
 		{
 			case 'h':
@@ -144,6 +149,8 @@ int main ( int argc, char **argv ) {
 				printf("-H: use only specified hybrid\n");
 				printf("-e: stop after specified number of events\n");
 				printf("-E: use EVIO file format\n");
+				printf("-C: cache fitted histograms in specified directory\n");
+				printf("-R: recompute and replace cached histograms\n");
 				return(0);
 				break;
 			case 'f':
@@ -191,6 +198,12 @@ int main ( int argc, char **argv ) {
 			case 'E':
 				evio_format = true;
 				break;
+			case 'C':
+				cache = new ResultCache(optarg);
+				break;
+			case 'R':
+				cache_refresh = true;
+				break;
 			case '?':
 				printf("Invalid option or missing option argument; -h to list options\n");
 				return(1);
@@ -225,14 +238,14 @@ int main ( int argc, char **argv ) {
 	cout << "Reading baseline calibration from " << argv[optind] << endl;
 	calfile.open(argv[optind]);
 	while (!calfile.eof()) {
-		calfile >> channel;
-		if (calfile.eof()) break;
+		if (!(calfile >> channel)) break;
 		for (int i=0;i<7;i++)
 		{
 			calfile >> calMean[channel][i];
 			calfile >> calSigma[channel][i];
 		}
 		calSigma_mean[channel] = TMath::Mean(6,calSigma[channel]);
+		clusterer.setNoise(channel,calSigma_mean[channel]);
 	}
 	calfile.close();
 
@@ -480,8 +493,63 @@ int main ( int argc, char **argv ) {
 	double fit_par[2], fit_err[2], chisq, chiprob;
 	int dof;
 
+	// Everything filled in the event loop, cached as one product keyed by the
+	// data, the calibrations and the fit options
+	TObjArray cacheHists;
+	TVectorD cacheState(4);
+	string cache_key;
+	bool have_hists = false;
+	for (int n=0;n<640;n++)
+	{
+		cacheHists.Add(histT0[n]);
+		cacheHists.Add(histA[n]);
+	}
+	cacheHists.Add(histA_all);
+	cacheHists.Add(histA_norm);
+	cacheHists.Add(histA_clusters);
+	cacheHists.Add(histA_clusters_1);
+	cacheHists.Add(histA_clusters_2);
+	cacheHists.Add(histA_clusters_3);
+	cacheHists.Add(histT0_clustering);
+	cacheHists.Add(histA_total);
+	cacheHists.Add(histT0_2d);
+	cacheHists.Add(histA_2d);
+	cacheHists.Add(T0_A);
+	if (cache!=NULL)
+	{
+		CacheKey key;
+		key.addString("meeg_sourcetest");
+		key.addFile(argv[optind-2]);
+		key.addFile(Form("%s.tp_pos",argv[optind-1]));
+		if (use_shape) key.addFile(Form("%s.shape_pos",argv[optind-1]));
+		if (use_dist) key.addFile(Form("%s.dist_pos",argv[optind-1]));
+		for (int i=optind;i<argc;i++) key.addFile(argv[i]);
+		key.addInt(evio_format);
+		key.addInt(flip_channels);
+		key.addInt(single_channel);
+		key.addInt(fpga);
+		key.addInt(hybrid);
+		key.addInt(num_events);
+		key.addInt(use_shape);
+		key.addInt(subtract_T0);
+		key.addInt(use_dist);
+		key.addDouble(use_dist?dist_window:0.0);
+		cache_key = key.str();
+
+		if (cache_refresh) cache->invalidate(cache_key);
+		else if (cache->exists(cache_key,"hists")
+				&& readCachedHists(cache->path(cache_key,"hists").c_str(),&cacheHists,&cacheState))
+		{
+			cout << "Using cached histograms " << cache_key << " from " << cache->dir() << endl;
+			maxA = cacheState[0];
+			minA = cacheState[1];
+			maxT0 = cacheState[2];
+			minT0 = cacheState[3];
+			have_hists = true;
+		}
+	}
 
-	while (optind<argc)
+	while (!have_hists && optind<argc)
 	{
 		cout << "Reading data file " <<argv[optind] << endl;
 		// Attempt to open data file
@@ -512,9 +580,8 @@ int main ( int argc, char **argv ) {
 			if (eventCount%1000==0) printf("Event %d\n",eventCount);
 			if (num_events > 0 && eventCount > num_events) break;
 
-			double hits[640];
-			for (int i=0;i<640;i++) hits[i] = 0.0;
 			double times[640];
+			clusterer.clear();
 
 			for (x=0; x < event.count(); x++) {
 				// Get sample
@@ -601,7 +668,7 @@ int main ( int argc, char **argv ) {
 							histT0_2d->Fill(channel,fit_par[0]);
 							histA_2d->Fill(channel,fit_par[1]);
 							T0_A->Fill(fit_par[0],fit_par[1]);
-							hits[channel] = fit_par[1];
+							clusterer.addHit(channel,fit_par[1],fit_par[0]);
 							times[channel] = fit_par[0];
 						   //histT0_err[n]->Fill(fit_err[0]);
 						   //histA_err[n]->Fill(fit_err[1]);
@@ -625,50 +692,24 @@ int main ( int argc, char **argv ) {
 			}
 
 			double totalSum = 0.0;
-			while (true) {
-				double max_E = 0.0;
-				int seed;
-				bool hits_left = false;
-				for (int i=0;i<640;i++) {
-					if (hits[i] > 10.0*calSigma_mean[i] && hits[i] > max_E) {
-						hits_left = true;
-						max_E = hits[i];
-						seed = i;
-					}
-				}
-				if (!hits_left) break;
-				double clusterSum = hits[seed];
-				int clusterSize = 1;
-				hits[seed] = 0.0;
-				int j = seed-1;
-				while (hits[j] > 3.0*calSigma_mean[j]) {
-					clusterSum += hits[j];
-					clusterSize++;
-					hits[j] = 0.0;
-					if (max_E > 10.0*calSigma_mean[seed])
-					histT0_clustering->Fill(times[seed],times[j]);
-					j--;
-				}
-				j = seed+1;
-				while (hits[j] > 3.0*calSigma_mean[j]) {
-					clusterSum += hits[j];
-					clusterSize++;
-					hits[j] = 0.0;
-					if (max_E > 10.0*calSigma_mean[seed])
-					histT0_clustering->Fill(times[seed],times[j]);
-					j++;
+			clusterer.process();
+			for (uint i=0;i<clusterer.count();i++) {
+				const StripCluster *cluster = clusterer.cluster(i);
+				for (uint j=cluster->first;j<cluster->first+cluster->size;j++) {
+					if (j!=cluster->seed)
+					histT0_clustering->Fill(times[cluster->seed],times[j]);
 				}
-				histA_clusters->Fill(clusterSum);
-				totalSum += clusterSum;
-				switch (clusterSize) {
+				histA_clusters->Fill(cluster->amplitude);
+				totalSum += cluster->amplitude;
+				switch (cluster->size) {
 					case 1:
-						histA_clusters_1->Fill(clusterSum);
+						histA_clusters_1->Fill(cluster->amplitude);
 						break;
 					case 2:
-						histA_clusters_2->Fill(clusterSum);
+						histA_clusters_2->Fill(cluster->amplitude);
 						break;
 					default:
-						histA_clusters_3->Fill(clusterSum);
+						histA_clusters_3->Fill(cluster->amplitude);
 				}
 			}
 			if (totalSum>0)
@@ -694,6 +735,16 @@ int main ( int argc, char **argv ) {
 			printf("ERROR: events read = %d, runCount = %d\n",eventCount, runCount);
 		}
 		optind++;
+
+		if (optind==argc && cache!=NULL)
+		{
+			cacheState[0] = maxA;
+			cacheState[1] = minA;
+			cacheState[2] = maxT0;
+			cacheState[3] = minT0;
+			if (writeCachedHists(cache->tempPath(cache_key,"hists").c_str(),&cacheHists,&cacheState))
+				cache->commit(cache_key,"hists");
+		}
 	}
 
 	/*
@@ -33,6 +33,7 @@
 #include <Data.h>
 #include <DataRead.h>
 #include <DataReadEvio.h>
+#include <ResultCache.h>
 #include "ShapingCurve.hh"
 #include "SmoothShapingCurve.hh"
 #include "Samples.hh"
@@ -117,9 +118,11 @@ int main ( int argc, char **argv ) {
 	double minT0[2] = {200.0, 200.0};
 	TGraph *T0_dist[2];
 	double T0_dist_b[2],T0_dist_m[2];
+	ResultCache *cache = NULL;
+	bool cache_refresh = false;
 
 
-	while ((c = getopt(argc,argv,"hfsg:o:auc:d:tbnH:F:e:E")) !=-1)
+	while ((c = getopt(argc,argv,"hfsg:o:auc:d:tbnH:F:e:EC:R")) !=-1)
 		switch (c)
 		{
 			case 'h':
@@ -139,6 +142,8 @@ int main ( int argc, char **argv ) {
 				printf("-H: use only specified hybrid\n");
 				printf("-e: stop after specified number of events\n");
 				printf("-E: use EVIO file format\n");
+				printf("-C: cache fitted histograms in specified directory\n");
+				printf("-R: recompute and replace cached histograms\n");
 				return(0);
 				break;
 			case 'f':
@@ -193,6 +198,12 @@ int main ( int argc, char **argv ) {
 			case 'E':
 				evio_format = true;
 				break;
+			case 'C':
+				cache = new ResultCache(optarg);
+				break;
+			case 'R':
+				cache_refresh = true;
+				break;
 			case '?':
 				printf("Invalid option or missing option argument; -h to list options\n");
 				return(1);
@@ -227,8 +238,7 @@ int main ( int argc, char **argv ) {
 	cout << "Reading baseline calibration from " << argv[optind] << endl;
 	calfile.open(argv[optind]);
 	while (!calfile.eof()) {
-		calfile >> channel;
-		if (calfile.eof()) break;
+		if (!(calfile >> channel)) break;
 		for (int i=0;i<7;i++)
 		{
 			calfile >> calMean[channel][i];
@@ -467,8 +477,71 @@ int main ( int argc, char **argv ) {
 	double fit_par[2], fit_err[2], chisq, chiprob;
 	int dof;
 
+	// Everything filled in the event loop, cached as one product keyed by the
+	// data, the calibrations and the fit options. Not read back with -f since
+	// the per-fit status lines can only come from the event loop.
+	TObjArray cacheHists;
+	TVectorD cacheState(9);
+	string cache_key;
+	bool have_hists = false;
+	for (int sgn=0;sgn<2;sgn++)
+	{
+		for (int n=0;n<640;n++)
+		{
+			cacheHists.Add(histT0[sgn][n]);
+			cacheHists.Add(histT0_err[sgn][n]);
+			cacheHists.Add(histA[sgn][n]);
+			cacheHists.Add(histA_err[sgn][n]);
+		}
+		cacheHists.Add(histChiProb[sgn]);
+		cacheHists.Add(histT0_2d[sgn]);
+		cacheHists.Add(histA_2d[sgn]);
+		cacheHists.Add(pulse2D[sgn]);
+		cacheHists.Add(T0_A[sgn]);
+	}
+	if (cache!=NULL)
+	{
+		CacheKey key;
+		key.addString("meeg_t0res");
+		key.addFile(argv[optind-2]);
+		for (int sgn=0;sgn<2;sgn++)
+		{
+			key.addFile(Form("%s.tp_%s",argv[optind-1],sgn?"neg":"pos"));
+			if (use_shape) key.addFile(Form("%s.shape_%s",argv[optind-1],sgn?"neg":"pos"));
+			if (use_dist) key.addFile(Form("%s.dist_%s",argv[optind-1],sgn?"neg":"pos"));
+		}
+		for (int i=optind;i<argc;i++) key.addFile(argv[i]);
+		key.addInt(evio_format);
+		key.addInt(flip_channels);
+		key.addInt(force_cal_grp?cal_grp:-1);
+		key.addInt(ignore_cal_grp);
+		key.addInt(single_channel);
+		key.addInt(fpga);
+		key.addInt(hybrid);
+		key.addInt(use_shape);
+		key.addInt(subtract_T0);
+		key.addInt(use_dist);
+		key.addDouble(use_dist?dist_window:0.0);
+		cache_key = key.str();
+
+		if (cache_refresh) cache->invalidate(cache_key);
+		else if (!print_fit_status && cache->exists(cache_key,"hists")
+				&& readCachedHists(cache->path(cache_key,"hists").c_str(),&cacheHists,&cacheState))
+		{
+			cout << "Using cached histograms " << cache_key << " from " << cache->dir() << endl;
+			for (int sgn=0;sgn<2;sgn++)
+			{
+				maxA[sgn] = cacheState[4*sgn];
+				minA[sgn] = cacheState[4*sgn+1];
+				maxT0[sgn] = cacheState[4*sgn+2];
+				minT0[sgn] = cacheState[4*sgn+3];
+			}
+			cal_delay = (int) cacheState[8];
+			have_hists = true;
+		}
+	}
 
-	while (optind<argc)
+	while (!have_hists && optind<argc)
 	{
 		cout << "Reading data file " <<argv[optind] << endl;
 		// Attempt to open data file
@@ -622,6 +695,20 @@ int main ( int argc, char **argv ) {
 			printf("ERROR: events read = %d, runCount = %d\n",eventCount, runCount);
 		}
 		optind++;
+
+		if (optind==argc && cache!=NULL)
+		{
+			for (int sgn=0;sgn<2;sgn++)
+			{
+				cacheState[4*sgn] = maxA[sgn];
+				cacheState[4*sgn+1] = minA[sgn];
+				cacheState[4*sgn+2] = maxT0[sgn];
+				cacheState[4*sgn+3] = minT0[sgn];
+			}
+			cacheState[8] = cal_delay;
+			if (writeCachedHists(cache->tempPath(cache_key,"hists").c_str(),&cacheHists,&cacheState))
+				cache->commit(cache_key,"hists");
+		}
 	}
 
 	for (int n=0;n<640;n++) for (int sgn=0;sgn<2;sgn++) if (histT0[sgn][n]->GetEntries()>0) {
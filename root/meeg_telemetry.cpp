@@ -0,0 +1,195 @@
+//-----------------------------------------------------------------------------
+// File          : meeg_telemetry.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Slow control telemetry of a run from the event headers (Telemetry): hybrid
+// temperatures, sequence counters and TI event numbers and time stamps of
+// every frame, kept as min/max/mean per source over intervals of events, in
+// <name>.telem. TriggerEvent frames are counted per ROC bank, their TI data
+// in one TI source. With -d, prints .telem files as text columns.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+// 10/19/2026: TriggerEvent sequences per ROC bank
+//-----------------------------------------------------------------------------
+#include <iostream>
+#include <string>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <TString.h>
+#include <Data.h>
+#include <DataRead.h>
+#include <DataReadEvio.h>
+#include <DevboardEvent.h>
+#include <TiTriggerEvent.h>
+#include <Telemetry.h>
+using namespace std;
+
+// Print the records of a .telem file, one line per record
+static bool dumpTelemetry ( string file ) {
+   TelemetryFile         in;
+   const TelemetryHeader *header;
+   const TelemetryRecord *r;
+
+   if ( ! in.open(file) ) {
+      printf("bad file: %s\n",file.c_str());
+      return(false);
+   }
+   header = in.header();
+   printf("# %s: source %s, %u events per interval%s, %llu records\n",file.c_str(),header->source,
+          header->interval,(header->flags & TelemetryOldHybrid) ? ", old hybrid" : "",(unsigned long long)in.count());
+   printf("# source first_event last_event frames first_seq last_seq seq_gaps first_ti last_ti first_time last_time temps");
+   for (uint i=0; i < TelemetryTemps; i++) printf(" min%u mean%u max%u",i,i,i);
+   printf("\n");
+
+   for (uint64_t x=0; x < in.count(); x++) {
+      r = in.record(x);
+      printf("%u %llu %llu %u %u %u %u %llu %llu %llu %llu %u",r->source,
+             (unsigned long long)r->firstEvent,(unsigned long long)r->lastEvent,r->frames,
+             r->firstSequence,r->lastSequence,r->sequenceGaps,
+             (unsigned long long)r->firstTiEvent,(unsigned long long)r->lastTiEvent,
+             (unsigned long long)r->firstTimeStamp,(unsigned long long)r->lastTimeStamp,r->temps);
+      for (uint i=0; i < TelemetryTemps; i++) printf(" %.2f %.3f %.2f",r->tempMin[i],r->tempMean[i],r->tempMax[i]);
+      printf("\n");
+   }
+   return(true);
+}
+
+int main ( int argc, char **argv ) {
+   bool              evio_format = false;
+   bool              triggerevent_format = false;
+   bool              old_hybrid = false;
+   bool              dump = false;
+   int               interval = 1000;
+   long              num_events = -1;
+   TString           outname = "";
+   DataRead          *dataRead;
+   DataReadEvio      *evioRead = NULL;
+   DevboardEvent     event;
+   TiTriggerEvent    triggerevent;
+   Data              *frame;
+   Telemetry         telemetry;
+   uint64_t          frames;
+   uint64_t          gaps;
+   long              eventCount = 0;
+   int               c;
+
+   while ((c = getopt(argc,argv,"hi:tdEVe:o:")) !=-1)
+      switch (c)
+      {
+         case 'h':
+            printf("Usage: meeg_telemetry [options] data_files\n");
+            printf("       meeg_telemetry -d telem_files\n");
+            printf("-h: print this help\n");
+            printf("-i: events per interval (default 1000)\n");
+            printf("-t: old (test run) hybrid temperature conversion\n");
+            printf("-d: print .telem files as text columns\n");
+            printf("-E: use EVIO file format\n");
+            printf("-V: use TriggerEvent event format, TI event numbers and time stamps\n");
+            printf("-e: stop after specified number of events\n");
+            printf("-o: use specified output filename base\n");
+            printf("Writes the telemetry to <name>.telem\n");
+            return(0);
+            break;
+         case 'i':
+            interval = atoi(optarg);
+            break;
+         case 't':
+            old_hybrid = true;
+            break;
+         case 'd':
+            dump = true;
+            break;
+         case 'E':
+            evio_format = true;
+            break;
+         case 'V':
+            triggerevent_format = true;
+            break;
+         case 'e':
+            num_events = atol(optarg);
+            break;
+         case 'o':
+            outname = optarg;
+            break;
+         case '?':
+            printf("Invalid option or missing option argument; -h to list options\n");
+            return(1);
+         default:
+            abort();
+      }
+
+   if ( argc-optind==0 ) {
+      cout << "Usage: meeg_telemetry [options] data_files\n";
+      return(1);
+   }
+
+   if ( dump ) {
+      bool ok = true;
+      for (; optind < argc; optind++) ok = dumpTelemetry(argv[optind]) && ok;
+      return(ok ? 0 : 1);
+   }
+
+   if ( interval < 1 ) {
+      cout << "Interval must be at least one event" << endl;
+      return(1);
+   }
+
+   if (outname == "") {
+      outname = argv[optind];
+      outname.ReplaceAll(".bin","");
+      if (outname.Contains('/')) {
+         outname.Remove(0,outname.Last('/')+1);
+      }
+   }
+
+   telemetry.setSource(argv[optind]);
+   cout << "Writing telemetry to " << outname+".telem" << endl;
+   if ( ! telemetry.open((outname+".telem").Data(),interval,old_hybrid) ) return(1);
+
+   if (evio_format) {
+      evioRead = new DataReadEvio();
+      if (triggerevent_format)
+         evioRead->set_engrun(true);
+      dataRead = evioRead;
+   } else
+      dataRead = new DataRead();
+
+   if (triggerevent_format) frame = &triggerevent;
+   else frame = &event;
+
+   for (; optind < argc && (num_events < 0 || eventCount < num_events); optind++) {
+      cout << "Reading data file " << argv[optind] << endl;
+      if ( ! dataRead->open(argv[optind]) ) {
+         printf("bad file: %s\n",argv[optind]);
+         continue;
+      }
+
+      while ( (num_events < 0 || eventCount < num_events) && dataRead->next(frame) ) {
+         if (eventCount%100000==0) printf("Event %ld\n",eventCount);
+         if (triggerevent_format) telemetry.add(&triggerevent,eventCount,evioRead != NULL ? evioRead->last_bank_tag() : 0);
+         else telemetry.add(&event,eventCount);
+         eventCount++;
+      }
+      dataRead->close();
+   }
+   delete dataRead;
+
+   if ( ! telemetry.close() ) return(1);
+
+   printf("%ld events, %llu records\n",eventCount,(unsigned long long)telemetry.records());
+   for (uint x=0; x < telemetry.sources(); x++) {
+      telemetry.sourceCounts(x,frames,gaps);
+      if ( telemetry.sourceId(x) == TelemetryTiSource ) printf("TI");
+      else if ( telemetry.sourceId(x) >= TelemetryRocSource ) printf("ROC %u",telemetry.sourceId(x) - TelemetryRocSource);
+      else printf("FPGA %u",telemetry.sourceId(x));
+      printf(": %llu frames, %llu sequence gaps\n",(unsigned long long)frames,(unsigned long long)gaps);
+   }
+   return(0);
+}
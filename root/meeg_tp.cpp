@@ -15,7 +15,9 @@
 //-----------------------------------------------------------------------------
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <iomanip>
+#include <vector>
 #include <TFile.h>
 #include <TH1F.h>
 #include <TH2S.h>
@@ -34,27 +36,712 @@
 #include <Data.h>
 #include <DataRead.h>
 #include <DataReadEvio.h>
+#include <ResultCache.h>
+#include <PlotRecord.h>
+#include <PulseProfile.h>
 #include <TMath.h>
 #include <TMultiGraph.h>
 #include <TGraphErrors.h>
 #include <unistd.h>
+#include <string.h>
+#include <pthread.h>
 #include "meeg_utils.hh"
 
 #define N_TIME_CONSTS 2
 
 using namespace std;
 
+// Pulse profiles as a cache blob: histMin and histMax, then the packed profiles
+string packSamples(PulseProfileSet *profiles, int *histMin, int *histMax)
+{
+    string blob;
+    blob.append((char*)histMin,640*sizeof(int));
+    blob.append((char*)histMax,640*sizeof(int));
+    profiles->pack(blob);
+    return blob;
+}
+
+bool unpackSamples(const string &blob, PulseProfileSet *profiles, int *histMin, int *histMax)
+{
+    const char *ptr = blob.data();
+    if (blob.size()<2*640*sizeof(int)) return false;
+    memcpy(histMin,ptr,640*sizeof(int));
+    ptr += 640*sizeof(int);
+    memcpy(histMax,ptr,640*sizeof(int));
+    ptr += 640*sizeof(int);
+    return profiles->unpack(ptr,blob.size()-2*640*sizeof(int));
+}
+
+// Fit results as a cache blob: the result arrays followed by the pulse shape text
+string packFits(int *nChan, double grChan[2][640], double grA[2][640], double grT0[2][640], double grTp[N_TIME_CONSTS][2][640], double grChisq[2][640], double chanNoise[2][640], ostringstream *shapeText)
+{
+    string blob;
+    blob.append((char*)nChan,2*sizeof(int));
+    blob.append((char*)grChan,2*640*sizeof(double));
+    blob.append((char*)grA,2*640*sizeof(double));
+    blob.append((char*)grT0,2*640*sizeof(double));
+    blob.append((char*)grTp,N_TIME_CONSTS*2*640*sizeof(double));
+    blob.append((char*)grChisq,2*640*sizeof(double));
+    blob.append((char*)chanNoise,2*640*sizeof(double));
+    for (int sgn=0;sgn<2;sgn++)
+    {
+        string text = shapeText[sgn].str();
+        int len = text.size();
+        blob.append((char*)&len,sizeof(int));
+        blob.append(text);
+    }
+    return blob;
+}
+
+bool unpackFits(const string &blob, int *nChan, double grChan[2][640], double grA[2][640], double grT0[2][640], double grTp[N_TIME_CONSTS][2][640], double grChisq[2][640], double chanNoise[2][640], ostringstream *shapeText)
+{
+    unsigned int fixed = 2*sizeof(int) + (5+N_TIME_CONSTS)*2*640*sizeof(double);
+    if (blob.size()<fixed) return false;
+    const char *ptr = blob.data();
+    memcpy(nChan,ptr,2*sizeof(int)); ptr += 2*sizeof(int);
+    memcpy(grChan,ptr,2*640*sizeof(double)); ptr += 2*640*sizeof(double);
+    memcpy(grA,ptr,2*640*sizeof(double)); ptr += 2*640*sizeof(double);
+    memcpy(grT0,ptr,2*640*sizeof(double)); ptr += 2*640*sizeof(double);
+    memcpy(grTp,ptr,N_TIME_CONSTS*2*640*sizeof(double)); ptr += N_TIME_CONSTS*2*640*sizeof(double);
+    memcpy(grChisq,ptr,2*640*sizeof(double)); ptr += 2*640*sizeof(double);
+    memcpy(chanNoise,ptr,2*640*sizeof(double)); ptr += 2*640*sizeof(double);
+    for (int sgn=0;sgn<2;sgn++)
+    {
+        int len;
+        if (ptr+sizeof(int)>blob.data()+blob.size()) return false;
+        memcpy(&len,ptr,sizeof(int)); ptr += sizeof(int);
+        if (len<0 || ptr+len>blob.data()+blob.size()) return false;
+        shapeText[sgn].str(string(ptr,len));
+        ptr += len;
+    }
+    return true;
+}
+
+// Event selection, the same for all input files
+typedef struct {
+    bool evio_format;
+    bool triggerevent_format;
+    bool force_cal_grp;
+    bool flip_channels;
+    int cal_grp;
+    int use_fpga;
+    int use_hybrid;
+    int num_events;
+    int hybrid_type;
+    TString outdir;
+} TpSelection;
+
+// One reader thread with its own DataRead and pulse profiles
+typedef struct {
+    TpSelection *sel;
+    DataRead *dataRead;
+    PulseProfileSet *profiles;
+    int histMin[640];
+    int histMax[640];
+    bool read_temp;
+    bool ok;
+} TpReader;
+
+// Input files still to be read
+static char **tpFiles;
+static int tpFileCount;
+static int tpNextFile;
+static pthread_mutex_t tpLock = PTHREAD_MUTEX_INITIALIZER;
+
+// Read one cal group/delay file into the reader's profiles
+bool readFile(TpReader *reader, const char *file)
+{
+    DataRead        *dataRead = reader->dataRead;
+    PulseProfileSet *profiles = reader->profiles;
+    int             *histMin = reader->histMin;
+    int             *histMax = reader->histMax;
+    bool            &read_temp = reader->read_temp;
+    bool evio_format = reader->sel->evio_format;
+    bool triggerevent_format = reader->sel->triggerevent_format;
+    bool force_cal_grp = reader->sel->force_cal_grp;
+    bool flip_channels = reader->sel->flip_channels;
+    int cal_grp = reader->sel->cal_grp;
+    int cal_delay = 0;
+    int use_fpga = reader->sel->use_fpga;
+    int use_hybrid = reader->sel->use_hybrid;
+    int num_events = reader->sel->num_events;
+    int hybrid_type = reader->sel->hybrid_type;
+    TString outdir = reader->sel->outdir;
+    DevboardEvent    event;
+    TiTriggerEvent    triggerevent;
+    TriggerSample   *triggersample;
+    int		samples[6];
+    int            eventCount;
+    int runCount;
+    double          sum;
+
+    printf("Reading data file %s\n",file);
+    // Attempt to open data file
+    if ( ! dataRead->open(file) ) return(false);
+
+    triggersample = new TriggerSample();
+    bool readOK;
+
+    if (triggerevent_format) {
+        dataRead->next(&triggerevent);
+    } else {
+        dataRead->next(&event);
+    }
+
+    if (!evio_format) {
+        TString confname=file;
+        confname.ReplaceAll(".bin","");
+        confname.Append(".conf");
+        if (confname.Contains('/')) {
+            confname.Remove(0,confname.Last('/')+1);
+        }
+
+        ofstream outconfig;
+        printf("Writing configuration to %s%s\n",outdir.Data(),confname.Data());
+        outconfig.open(outdir+confname);
+
+        outconfig << dataRead->getConfigXml();
+        outconfig << endl;
+        outconfig << dataRead->getStatusXml();
+        outconfig.close();
+
+        runCount = atoi(dataRead->getConfig("RunCount").c_str());
+
+        if (!force_cal_grp)
+        {
+            string cgrp = dataRead->getConfig("cntrlFpga:hybrid:apv25:CalGroup");
+            if (cgrp.length()==0) cgrp = dataRead->getConfig("FrontEndTestFpga:FebCore:Hybrid:apv25:CalGroup");
+            cal_grp = atoi(cgrp.c_str());
+            printf("Read calibration group %d from %s\n",cal_grp,file);
+        }
+
+        string csel = dataRead->getConfig("cntrlFpga:hybrid:apv25:Csel");
+        if (csel.length()==0) csel = dataRead->getConfig("FrontEndTestFpga:FebCore:Hybrid:apv25:Csel");
+        cal_delay = atoi(csel.substr(4,1).c_str());
+        printf("Read calibration delay %d from %s\n",cal_delay,file);
+        if (cal_delay==0)
+        {
+            cal_delay=8;
+            printf("Force cal_delay=8 to keep sample time in range\n");
+        }
+    } else
+    {
+        runCount = 0;
+        if (!force_cal_grp) cal_grp = 0;
+        cal_delay = 1;
+    }
+
+
+    // Process each event
+    eventCount = 0;
+    //bool goodEvent;
+    int pulsePolarity = -1;
+
+    do {
+        int rce = 0;
+        int fpga = 0;
+        int samplecount;
+
+        if (triggerevent_format) {
+            samplecount = triggerevent.count();
+        } else {
+            fpga = event.fpgaAddress();
+            samplecount = event.count();
+            if (read_temp && !event.isTiFrame()) for (uint i=0;i<4;i++) {
+                printf("Event %d, temperature #%d: %f\n",eventCount,i,event.temperature(i,hybrid_type==1));
+                read_temp = false;
+            }
+        }
+
+        //if(debug) printf("Event %d\n",eventCount);
+
+        if (!triggerevent_format && fpga==7) 
+        {
+            //printf("not a data event\n");
+            continue;
+        }
+
+        //goodEvent = true;
+        //for (x=0; x < event.count(); x++) {
+        //	sample  = event.sample(x);
+        //	channel = (sample->apv() * 128) + sample->channel();
+        //	if (channel==32 && sample->value(1)>8482 && sample->value(1)>7800) goodEvent = false; 
+        //}
+        //if (eventCount%2==0) printf("Event %d is %s\n",eventCount,goodEvent?"good":"bad");
+        //goodEvent = true;
+        if (eventCount%1000==0) printf("Event %d\n",eventCount);
+        if (num_events!=-1 && eventCount >= num_events) break;
+        //if (goodEvent) 
+        for (int x=0; x < samplecount; x++) {
+            int hyb;
+            int apv;
+            int apvch;
+            int channel;
+
+            bool goodSample = true;
+
+            // Get sample
+            if (triggerevent_format) {
+                triggerevent.sample(x,triggersample);
+                rce = triggersample->rceAddress();
+                fpga = triggersample->febAddress();
+                hyb = triggersample->hybrid();
+                apv = triggersample->apv();
+                apvch = triggersample->channel();
+                goodSample = (!triggersample->head() && !triggersample->tail());
+                for ( int y=0; y < 6; y++ ) {
+                    //printf("%x\n",sample->value(y));
+                    samples[y] = triggersample->value(y);
+                }
+            } else {
+                DevboardSample *sample  = event.sample(x);
+                hyb = sample->hybrid();
+                apv = sample->apv();
+                apvch = sample->channel();
+                for ( int y=0; y < 6; y++ ) {
+                    //printf("%x\n",sample->value(y));
+                    samples[y] = sample->value(y) & 0x3FFF;
+                    if (samples[y]==0) goodSample = false;
+                }
+            }
+            //printf("event %d\tx=%d\tF%d H%d A%d channel %d, samples:\t%d\t%d\t%d\t%d\t%d\t%d\n",eventCount,x,rce,hyb,apv,channel,samples[0],samples[1],samples[2],samples[3],samples[4],samples[5]);
+            if (use_fpga!=-1 && fpga!=use_fpga) continue;
+            if (use_hybrid!=-1 && hyb!=use_hybrid) continue;
+            if (!goodSample) continue;
+
+            channel = apvch;
+
+            if (flip_channels)
+                channel += (4-apv)*128;
+            else
+                channel += apv*128;
+
+            //if (eventCount==0) printf("channel %d\n",channel);
+
+            if ( channel >= (5 * 128) ) {
+                printf("Channel %d out of range\n",channel);
+                printf("Apv = %d\n",apv);
+                printf("Chan = %d\n",apvch);
+            }
+
+            if ((apvch-cal_grp)%8!=0) continue;
+
+            // Filter APVs
+            if ( eventCount >= 20 ) {
+                bool bad_event = false;
+                for ( int y=0; y < 6; y++ ) if (samples[y]==0) {
+                    printf("sample is zero: event %d, channel %d, sample %d\n",eventCount,channel,y);
+                    bad_event = true;
+                }
+                if (bad_event) continue;
+
+                sum = 0;
+                for ( int y=0; y < 6; y++ ) {
+                    //vhigh = (value << 1) & 0x2AAA;
+                    //vlow  = (value >> 1) & 0x1555;
+                    //value = vlow | vhigh;
+
+                    //histAll->Fill(value,channel);
+                    //histSng[channel]->Fill(value);
+
+                    if ( samples[y] < histMin[channel] ) histMin[channel] = samples[y];
+                    if ( samples[y] > histMax[channel] ) histMax[channel] = samples[y];
+                    sum+=samples[y];
+                }
+                sum-=6*samples[0];
+                int sgn = sum>0?0:1;
+                if (pulsePolarity==-1)
+                {
+                    pulsePolarity=((sgn-eventCount)%2 + 2)%2;
+                    printf("Saw a %s pulse, event %d, channel %d\n",sgn?"positive":"negative",eventCount,channel);
+                }
+                //int sgn = eventCount%2;
+                for ( int y=0; y < 6; y++ ) {
+                    profiles->add(sgn,channel,8*y+8-cal_delay,samples[y]);
+                }
+                //tpfile<<"T0 " << fit_par[0] <<", A " << fit_par[1] << "Fit chisq " << chisq << ", DOF " << dof << ", prob " << TMath::Prob(chisq,dof) << endl;
+            }
+        }
+        eventCount++;
+
+        if (triggerevent_format) {
+            readOK = dataRead->next(&triggerevent);
+        } else {
+            readOK = dataRead->next(&event);
+        }
+    } while (readOK);
+    dataRead->close();
+    if (eventCount != runCount)
+    {
+        printf("ERROR: %s: events read = %d, runCount = %d\n",file,eventCount, runCount);
+    }
+    delete triggersample;
+    return(true);
+}
+
+// Reader thread: take files from the list until it is empty
+void *readThread(void *arg)
+{
+    TpReader *reader = (TpReader *)arg;
+    while (reader->ok)
+    {
+        pthread_mutex_lock(&tpLock);
+        int i = tpNextFile++;
+        pthread_mutex_unlock(&tpLock);
+        if (i>=tpFileCount) break;
+        reader->ok = readFile(reader,tpFiles[i]);
+    }
+    return(NULL);
+}
+
+// One channel and polarity of the pulse shape fit
+typedef struct {
+    int ni;
+    double ti[48];
+    double yi[48];
+    double ey[48];
+    double noise;
+    double A0;
+    bool fitted;
+    double A;
+    double T0;
+    double Tp[N_TIME_CONSTS];
+    double chisq;
+    // What the fit plot draws: fit function parameters, start of the fit range
+    // and the graph after the sample phase correction
+    double par[5];
+    double fitStart;
+    int plotN;
+    double plotX[48];
+    double plotY[48];
+} TpFit;
+
+// Inputs and results of the pulse shape fits
+typedef struct {
+    PulseProfileSet *profiles;
+    double (*calMean)[7];
+    bool use_baseline_cal;
+    double delay_step;
+    bool move_fitstart;
+    double fit_shift;
+    bool plot_tp_fits;
+    TCanvas *c1;
+    int *histMin;
+    int *histMax;
+    const char *inname;
+    TpFit *fits; // [sgn*640+channel]
+} TpFitJob;
+
+// Fit every workers'th channel, starting at worker
+void fitChannels(void *arg, int worker, int workers)
+{
+    TpFitJob        *job = (TpFitJob *)arg;
+    PulseProfileSet *profiles = job->profiles;
+    double (*calMean)[7] = job->calMean;
+    bool use_baseline_cal = job->use_baseline_cal;
+    double delay_step = job->delay_step;
+    bool move_fitstart = job->move_fitstart;
+    double fit_shift = job->fit_shift;
+    bool plot_tp_fits = job->plot_tp_fits;
+    TCanvas         *c1 = job->c1;
+    int             *histMin = job->histMin;
+    int             *histMax = job->histMax;
+    const char      *inname = job->inname;
+    char            name[100];
+    char title[200];
+    TGraphErrors *fitcurve;
+    /*
+    TF1 *shapingFunction = new TF1("Shaping Function",
+            "[0]+[1]*(x>[2])*((x-[2])/[3])*exp(1-((x-[2])/[3]))",-1.0*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL);
+            */
+
+    //TF1 *shapingFunction = new TF1("Shaping Function",
+            //"[0]+\
+            //[1]*(x>[2])*(\
+                //([3]/(([3]-[4])*([3]-[5])))*exp(([2]-x)/[3])+\
+                //([4]/(([4]-[5])*([4]-[3])))*exp(([2]-x)/[4])+\
+                //([5]/(([5]-[3])*([5]-[4])))*exp(([2]-x)/[5]))",
+            //-1.0*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL);
+
+    //TF1 *shapingFunction = new TF1("Shaping Function",
+            //"[0]+\
+            //[1]*(x>[2])*\
+            //([3]/(([3]-[4])*([3]-[4])))*(\
+                //exp(([2]-x)/[3])-\
+                //(1+(([3]-[4])/([3]*[4]))*(x-[2]))*exp(([2]-x)/[4]))",
+            //-1.0*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL);
+
+    //TF1 *shapingFunction = new TF1("Shaping Function",
+            //"[0]+\
+            //[1]*(x>[2])*(\
+                //([3]*[3]/(([3]-[4])*([3]-[5])*([3]-[6])))*exp(([2]-x)/[3])+\
+                //([4]*[4]/(([4]-[5])*([4]-[6])*([4]-[3])))*exp(([2]-x)/[4])+\
+                //([5]*[5]/(([5]-[6])*([5]-[3])*([5]-[4])))*exp(([2]-x)/[5])+\
+                //([6]*[6]/(([6]-[3])*([6]-[4])*([6]-[5])))*exp(([2]-x)/[6]))",
+            //-1.0*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL);
+
+    //TF1 *shapingFunction = new TF1("Shaping Function",
+            //"[0]+\
+            //[1]*(x>[2])*(\
+                //([3]*[3]/(([3]-[4])*([3]-[5])*([3]-[5])))*exp(([2]-x)/[3])+\
+                //([4]*[4]/(([4]-[5])*([4]-[5])*([4]-[3])))*exp(([2]-x)/[4])+\
+                //(([3]*[3]/(([4]-[3])*([3]-[5])*([3]-[5]))) - ([4]*[4]/(([4]-[3])*([4]-[5])*([4]-[5]))))*exp(([2]-x)/[5])+\
+                //((x-[2])/(([5]-[3])*([5]-[4])))*exp(([2]-x)/[5]))",
+            //-1.0*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL);
+
+    //TF1 *shapingFunction = new TF1("Shaping Function",
+            //"[0]+\
+            //[1]*(x>[2])*\
+            //([3]*[3]/(([3]-[4])*([3]-[4])*([3]-[4])))*(\
+                //exp(([2]-x)/[3])-\
+                //(1+\
+                 //(([3]-[4])/([3]*[4]))*(x-[2])+\
+                 //(([3]-[4])*([3]-[4])/(2*[3]*[4]*[3]*[4]))*(x-[2])*(x-[2]))*exp(([2]-x)/[4]))",
+            //-1.0*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL);
+            
+    TF1 *shapingFunction = new TF1("Shaping Function",fitf_4pole,-1.0*SAMPLE_INTERVAL,5.0*SAMPLE_INTERVAL,5);
+            
+    //TH1S *histSamples1D = new TH1S("h1","h1",16384,-0.5,16383.5);
+    TH2S *histSamples;
+    double A, T0, fit_start = -1*SAMPLE_INTERVAL;
+
+    for (int channel=worker;channel<640;channel+=workers) for (int sgn=0;sgn<2;sgn++) {
+        TpFit *fit = &job->fits[sgn*640+channel];
+        double *yi = fit->yi;
+        double *ey = fit->ey;
+        double *ti = fit->ti;
+        int &ni = fit->ni;
+        fit->noise = 0;
+        fit->fitted = false;
+        ni=0;
+        for (int i=0;i<48;i++) if (profiles->get(sgn,channel,i)!=NULL) 
+        {
+            PulseProfile *profile = profiles->get(sgn,channel,i);
+            int nsamples = profile->count();
+            double rms = profile->rms();
+            yi[ni] = profile->median();
+            if (use_baseline_cal) yi[ni] -= calMean[channel][i/8];
+            //if (use_baseline_cal) yi[ni] += calMean[channel][i/8]-2*calMean[channel][6];
+
+            ey[ni] = rms/sqrt((double)nsamples);
+            fit->noise+=rms;
+            //histSamples1D->Reset();
+            //printf("TH!: %f, %f\n", histSamples1D->GetEntries(),(histSamples1D->GetRMS()*histSamples1D->GetRMS()-yi[ni]*yi[ni]));
+            //for (int j=histMin[channel];j<=histMax[channel];j++)
+            //{
+            //histSamples1D->SetBinContent(j+1,allSamples[sgn][channel][i][j]);
+            //}
+            //if (histSamples1D->Fit("gaus","Q0")==0) {
+            //yi[ni]  = histSamples1D->GetFunction("gaus")->GetParameter(1);
+            //ey[ni]  = histSamples1D->GetFunction("gaus")->GetParError(1);
+            //}
+            //else {
+            //	printf("Could not fit channel %d, polarity %d, sample %d\n",channel,sgn,i);
+            //}
+
+            ti[ni] = (i-8)*delay_step;
+            ni++;
+        }
+        if (ni==0) continue;
+        fit->noise/=ni;
+
+        if (plot_tp_fits)
+        {
+            gStyle->SetOptStat(0);
+            sprintf(name,"samples_%s_%i",sgn?"neg":"pos",channel);
+            sprintf(title,"APV25 pulse shape, channel %d, %s pulses;Time [ns];Amplitude [ADC counts]",channel,sgn?"negative":"positive");
+            if (use_baseline_cal)
+                histSamples = new TH2S(name,title,48,-8.5*delay_step,39.5*delay_step,16384,-0.5-calMean[channel][6],16383.5-calMean[channel][6]);
+            else 
+                histSamples = new TH2S(name,title,48,-8.5*delay_step,39.5*delay_step,16384,-0.5,16383.5);
+            c1->Clear();
+            for (int i=0;i<48;i++) if (profiles->get(sgn,channel,i)!=NULL) 
+            {
+                PulseProfile *profile = profiles->get(sgn,channel,i);
+                for (int j=0;j<PulseProfileBins;j++) if (profile->binCount(j))
+                {
+                    // wide profile bins are drawn at their center
+                    double value = profile->binLow(j)+(profile->binWidth()-1)/2.0;
+                    if (use_baseline_cal)
+                        histSamples->Fill((i-8)*delay_step,value-calMean[channel][i/8],profile->binCount(j));
+                    else
+                        histSamples->Fill((i-8)*delay_step,value,profile->binCount(j));
+                }
+            }
+            if (use_baseline_cal)
+                histSamples->GetYaxis()->SetRangeUser(histMin[channel]-calMean[channel][6],histMax[channel]-calMean[channel][6]);
+            else
+                histSamples->GetYaxis()->SetRangeUser(histMin[channel],histMax[channel]);
+            histSamples->Draw("colz");
+        }
+
+        fitcurve = new TGraphErrors(ni,ti,yi,NULL,ey);
+        if (sgn==0) shapingFunction->SetParameter(1,TMath::MaxElement(ni,yi)-yi[0]);
+        else shapingFunction->SetParameter(1,TMath::MinElement(ni,yi)-yi[0]);
+        shapingFunction->SetParameter(2,-10.0);
+        //shapingFunction->SetParameter(3,50.0);
+        shapingFunction->SetParameter(3,80.0);
+        shapingFunction->SetParameter(4,12.0);
+        //shapingFunction->SetParameter(5,10.0);
+        //shapingFunction->SetParameter(6,70.0);
+        shapingFunction->FixParameter(0,yi[0]);
+        fit->A0 = yi[0];
+        if (ni>0)
+        {
+            if (fitcurve->Fit(shapingFunction,"Q0","",-1*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL)==0)
+            {
+                A = shapingFunction->GetParameter(1);
+                T0 = shapingFunction->GetParameter(2);
+                for (int i=0;i<N_TIME_CONSTS;i++) {
+                    fit->Tp[i]=shapingFunction->GetParameter(3+i);
+                }
+                //printf("%f, %f, %f, %f\n",shapingFunction->GetParameter(0),shapingFunction->GetParameter(1),shapingFunction->GetParameter(2),shapingFunction->GetParameter(3));
+                //printf("%f, %f, %f, %f, %f, %f\n",shapingFunction->GetParameter(0),shapingFunction->GetParameter(1),shapingFunction->GetParameter(2),shapingFunction->GetParameter(3),shapingFunction->GetParameter(4),shapingFunction->GetParameter(5));
+                //printf("%f, %f, %f, %f, %f\n",shapingFunction->GetParameter(0),shapingFunction->GetParameter(1),shapingFunction->GetParameter(2),shapingFunction->GetParameter(3),shapingFunction->GetParameter(4));
+                //printf("%f, %f, %f, %f, %f, %f, %f\n",shapingFunction->GetParameter(0),shapingFunction->GetParameter(1),shapingFunction->GetParameter(2),shapingFunction->GetParameter(3),shapingFunction->GetParameter(4),shapingFunction->GetParameter(5),shapingFunction->GetParameter(6));
+                double residuals[8];
+                //for (int i =0;i<8;i++) {
+                //    residuals[i]=0;
+                //}
+                for (int i =0;i<8;i++) {
+                    double dataX,dataY;
+                    fitcurve->GetPoint(i,dataX,dataY);
+                    double res = dataY - shapingFunction->Eval(dataX);
+                    residuals[i] = res;
+                    //residuals[i] += res/6.0;
+                    //printf("%f, %f, %f\n",dataX,dataY,res);
+                }
+                for (int i =0;i<48;i++) {
+                    double dataX,dataY;
+                    fitcurve->GetPoint(i,dataX,dataY);
+                    fitcurve->SetPoint(i,dataX,dataY-residuals[i%8]);
+                }
+                fitcurve->Fit(shapingFunction,"Q0","",-1*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL);
+                if (move_fitstart)
+                {
+                    fit_start = T0+fit_shift;
+                    fitcurve->Fit(shapingFunction,"Q0","",fit_start,5*SAMPLE_INTERVAL);
+                    A = shapingFunction->GetParameter(1);
+                    T0 = shapingFunction->GetParameter(2);
+                    for (int i=0;i<N_TIME_CONSTS;i++) {
+                        fit->Tp[i]=shapingFunction->GetParameter(3+i);
+                    }
+                }
+                //printf("%f, %f, %f",shapingFunction->GetParameter(0),shapingFunction->GetParameter(1),shapingFunction->GetParameter(2));
+                //for (int i=0;i<N_TIME_CONSTS;i++) {
+                    //printf(", %f",shapingFunction->GetParameter(3+i));
+                //}
+                //printf("\n");
+                fit->fitted = true;
+                fit->A = A;
+                fit->T0 = T0;
+                fit->chisq = shapingFunction->GetChisquare();
+            }
+            else
+            {
+                printf("Could not fit pulse shape for channel %d, polarity %d\n",channel,sgn);
+            }
+        }
+        for (int i=0;i<5;i++) fit->par[i] = shapingFunction->GetParameter(i);
+        fit->fitStart = move_fitstart?fit_start:-1*SAMPLE_INTERVAL;
+        fit->plotN = fitcurve->GetN()<48?fitcurve->GetN():48;
+        for (int i=0;i<fit->plotN;i++)
+        {
+            fit->plotX[i] = fitcurve->GetX()[i];
+            fit->plotY[i] = fitcurve->GetY()[i];
+        }
+        if (plot_tp_fits)
+        {
+            fitcurve->SetLineWidth(3);
+            fitcurve->Draw("SAME");
+            if (move_fitstart)
+            {
+                shapingFunction->SetLineStyle(1);
+                shapingFunction->SetLineWidth(3);
+                shapingFunction->SetLineColor(2);
+                shapingFunction->SetRange(fit_start,5*SAMPLE_INTERVAL);
+                shapingFunction->DrawCopy("LSAME");
+                shapingFunction->SetRange(-1*SAMPLE_INTERVAL,fit_start);
+                shapingFunction->SetLineStyle(2);
+                shapingFunction->Draw("LSAME");
+            }
+            else
+            {
+                shapingFunction->SetLineStyle(1);
+                shapingFunction->SetLineWidth(3);
+                shapingFunction->SetLineColor(2);
+                shapingFunction->SetRange(-1*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL);
+                shapingFunction->Draw("LSAME");
+            }
+            sprintf(name,"%s_tp_fit_%s_%i.png",inname,sgn?"neg":"pos",channel);
+            c1->SaveAs(name);
+            delete histSamples;
+            gStyle->SetOptStat("emrou");
+        }
+        delete fitcurve;
+    }
+    delete shapingFunction;
+}
+
+// Record the Tp fit plot of one channel and polarity, as fitChannels draws it
+void recordFitPlot(PlotRecord &plot, TpFitJob *job, int sgn, int channel)
+{
+    TpFit *fit = &job->fits[sgn*640+channel];
+    PulseProfileSet *profiles = job->profiles;
+    double (*calMean)[7] = job->calMean;
+    double delay_step = job->delay_step;
+    double offset = job->use_baseline_cal?calMean[channel][6]:0.0;
+    const char *base = strrchr(job->inname,'/');
+    char name[200];
+    char title[200];
+
+    plot.clear();
+    sprintf(name,"%s_tp_fit_%s_%i.png",base?base+1:job->inname,sgn?"neg":"pos",channel);
+    sprintf(title,"APV25 pulse shape, channel %d, %s pulses;Time [ns];Amplitude [ADC counts]",channel,sgn?"negative":"positive");
+    plot.name = name;
+    plot.title = title;
+    plot.flags = PlotNoStats;
+
+    plot.addHist2("colz",48,-8.5*delay_step,39.5*delay_step,16384,-0.5-offset,16383.5-offset,
+            job->histMin[channel]-offset,job->histMax[channel]-offset);
+    for (int i=0;i<48;i++) if (profiles->get(sgn,channel,i)!=NULL)
+    {
+        PulseProfile *profile = profiles->get(sgn,channel,i);
+        for (int j=0;j<PulseProfileBins;j++) if (profile->binCount(j))
+        {
+            double value = profile->binLow(j)+(profile->binWidth()-1)/2.0;
+            if (job->use_baseline_cal) value -= calMean[channel][i/8];
+            plot.fillHist2((i-8)*delay_step,value,profile->binCount(j));
+        }
+    }
+
+    plot.addGraph("SAME",fit->plotN,fit->plotX,fit->plotY,fit->ey);
+    plot.setLine(1,1,3);
+    if (job->move_fitstart)
+    {
+        plot.addFunction("LSAME",PlotFunctionFourPole,fit->fitStart,5*SAMPLE_INTERVAL,5,fit->par);
+        plot.setLine(2,1,3);
+        plot.addFunction("LSAME",PlotFunctionFourPole,-1*SAMPLE_INTERVAL,fit->fitStart,5,fit->par);
+        plot.setLine(2,2,3);
+    }
+    else
+    {
+        plot.addFunction("LSAME",PlotFunctionFourPole,-1*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL,5,fit->par);
+        plot.setLine(2,1,3);
+    }
+}
+
 // Process the data
 // Pass root file to open as first and only arg.
 int main ( int argc, char **argv ) {
     int c;
     bool plot_tp_fits = false;
+    bool defer_plots = false;
     bool plot_fit_results = false;
     bool force_cal_grp = false;
     bool use_baseline_cal = false;
     bool flip_channels = true;
     bool move_fitstart = false;
-    bool read_temp = true;
     int hybrid_type = 0;
     bool evio_format = false;
     bool triggerevent_format = false;
@@ -66,11 +753,11 @@ int main ( int argc, char **argv ) {
     TString inname = "";
     TString outdir = "";
     int cal_grp = -1;
-    int cal_delay = 0;
+    int jobs = 1;
     double delay_step = SAMPLE_INTERVAL/8;
     TCanvas         *c1;
     //TH2I            *histAll;
-    short *allSamples[2][640][48] = {{{NULL}}};
+    PulseProfileSet *profiles = new PulseProfileSet();
     //bool hasSamples[2][640][48] = {{{false}}};
     //TH1D            *histSamples1D;
     int          histMin[640];
@@ -79,14 +766,6 @@ int main ( int argc, char **argv ) {
     for (int i=0;i<640;i++) histMax[i]=0;
     //TGraph          *mean;
     //TGraph          *sigma;
-    DataRead        *dataRead;
-    DevboardEvent    event;
-    TiTriggerEvent    triggerevent;
-    TriggerSample   *triggersample = new TriggerSample();
-    int		samples[6];
-    int            eventCount;
-    int runCount;
-    double          sum;
     char            name[100];
     char            name2[100];
     char title[200];
@@ -98,6 +777,9 @@ int main ( int argc, char **argv ) {
     double grChisq[2][640];
     double          calMean[640][7] = {{0.0}};
     double          calSigma[640][7] = {{1.0}};
+    ResultCache *cache = NULL;
+    bool cache_refresh = false;
+    vector<string> cal_files;
     for (int i=0;i<640;i++) {
         for (int j=0;j<7;j++) {
             calMean[i][j] = 0.0;
@@ -105,12 +787,13 @@ int main ( int argc, char **argv ) {
         }
     }
 
-    while ((c = getopt(argc,argv,"hfrg:o:b:d:s:nt:H:F:e:EV")) !=-1)
+    while ((c = getopt(argc,argv,"hfDrg:o:b:d:s:nt:H:F:e:EVC:Rj:")) !=-1)
         switch (c)
         {
             case 'h':
                 printf("-h: print this help\n");
                 printf("-f: plot Tp fits for each channel\n");
+                printf("-D: with -f, record the Tp fit plots to <output>.plots for meeg_render instead of drawing them\n");
                 printf("-g: force use of specified cal group\n");
                 printf("-r: plot fit results\n");
                 printf("-o: use specified output filename\n");
@@ -124,11 +807,17 @@ int main ( int argc, char **argv ) {
                 printf("-e: stop after specified number of events\n");
                 printf("-E: use EVIO file format\n");
                 printf("-V: use TriggerEvent event format\n");
+                printf("-C: cache sample histograms and fit results in specified directory\n");
+                printf("-R: recompute and replace cached results\n");
+                printf("-j: read files in specified number of threads and fit in as many processes (0 for all cores)\n");
                 return(0);
                 break;
             case 'f':
                 plot_tp_fits = true;
                 break;
+            case 'D':
+                defer_plots = true;
+                break;
             case 'r':
                 plot_fit_results = true;
                 break;
@@ -149,11 +838,12 @@ int main ( int argc, char **argv ) {
                 break;
             case 'b':
                 use_baseline_cal = true;
+                cal_files.push_back(string("b:")+optarg);
                 cout << "Reading baseline calibration from " << optarg << endl;
                 calfile.open(optarg);
                 while (!calfile.eof()) {
                     int channel;
-                    calfile >> channel;
+                    if (!(calfile >> channel)) break;
                     for (int i=0;i<7;i++)
                     {
                         double temp;
@@ -165,11 +855,12 @@ int main ( int argc, char **argv ) {
                 calfile.close();
                 break;
             case 'd':
+                cal_files.push_back(string("d:")+optarg);
                 cout << "Reading dtrig baseline calibration from " << optarg << endl;
                 calfile.open(optarg);
                 while (!calfile.eof()) {
                     int channel;
-                    calfile >> channel;
+                    if (!(calfile >> channel)) break;
                     double temp;
                     for (int i=0;i<6;i++)
                     {
@@ -208,6 +899,16 @@ int main ( int argc, char **argv ) {
             case 'V':
                 triggerevent_format = true;
                 break;
+            case 'C':
+                cache = new ResultCache(optarg);
+                break;
+            case 'R':
+                cache_refresh = true;
+                break;
+            case 'j':
+                jobs = atoi(optarg);
+                if (jobs<=0) jobs = numCores();
+                break;
             case '?':
                 printf("Invalid option or missing option argument; -h to list options\n");
                 return(1);
@@ -221,14 +922,6 @@ int main ( int argc, char **argv ) {
         hybrid_type = 1;
     }
 
-    if (evio_format) {
-        DataReadEvio *tmpDataRead = new DataReadEvio();
-        if (triggerevent_format)
-            tmpDataRead->set_engrun(true);
-        dataRead = tmpDataRead;
-    } else 
-        dataRead = new DataRead();
-
     gROOT->SetStyle("Plain");
     gStyle->SetPalette(1,0);
     gStyle->SetOptStat("emrou");
@@ -279,446 +972,206 @@ int main ( int argc, char **argv ) {
     cout << "Writing pulse noise to " << inname+".noise_neg" << endl;
     noisefile[1].open(inname+".noise_neg");
 
-
-    while (optind<argc)
+    double chanNoise[2][640]={{0.0}};
+    ostringstream shapeText[2];
+
+    // Sample histograms depend on the data and the event selection, fit
+    // results also on the calibration files and fit options.
+    string sample_key, fit_key;
+    bool have_samples = false;
+    bool have_fits = false;
+    if (cache!=NULL)
     {
-        cout << "Reading data file " <<argv[optind] << endl;
-        // Attempt to open data file
-        if ( ! dataRead->open(argv[optind]) ) return(2);
-
-        bool readOK;
-
-        if (triggerevent_format) {
-            dataRead->next(&triggerevent);
-        } else {
-            dataRead->next(&event);
+        CacheKey key;
+        key.addString("meeg_tp profiles");
+        for (int i=optind;i<argc;i++) key.addFile(argv[i]);
+        key.addInt(evio_format);
+        key.addInt(triggerevent_format);
+        key.addInt(flip_channels);
+        key.addInt(force_cal_grp?cal_grp:-1);
+        key.addInt(use_fpga);
+        key.addInt(use_hybrid);
+        key.addInt(num_events);
+        sample_key = key.str();
+
+        key.addString("meeg_tp fits");
+        for (unsigned int i=0;i<cal_files.size();i++) {
+            key.addString(cal_files[i].substr(0,2));
+            key.addFile(cal_files[i].substr(2));
         }
+        key.addInt(move_fitstart);
+        key.addDouble(move_fitstart?fit_shift:0.0);
+        fit_key = key.str();
 
-        if (!evio_format) {
-            TString confname=argv[optind];
-            confname.ReplaceAll(".bin","");
-            confname.Append(".conf");
-            if (confname.Contains('/')) {
-                confname.Remove(0,confname.Last('/')+1);
-            }
-
-            ofstream outconfig;
-            cout << "Writing configuration to " <<outdir<<confname << endl;
-            outconfig.open(outdir+confname);
-
-            outconfig << dataRead->getConfigXml();
-            outconfig << endl;
-            outconfig << dataRead->getStatusXml();
-            outconfig.close();
-
-            runCount = atoi(dataRead->getConfig("RunCount").c_str());
-
-            if (!force_cal_grp)
-            {
-                string cgrp = dataRead->getConfig("cntrlFpga:hybrid:apv25:CalGroup");
-                if (cgrp.length()==0) cgrp = dataRead->getConfig("FrontEndTestFpga:FebCore:Hybrid:apv25:CalGroup");
-                cal_grp = atoi(cgrp.c_str());
-                cout<<"Read calibration group "<<cal_grp<<" from data file"<<endl;
-            }
-
-            string csel = dataRead->getConfig("cntrlFpga:hybrid:apv25:Csel");
-            if (csel.length()==0) csel = dataRead->getConfig("FrontEndTestFpga:FebCore:Hybrid:apv25:Csel");
-            cal_delay = atoi(csel.substr(4,1).c_str());
-            cout<<"Read calibration delay "<<cal_delay<<" from data file"<<endl;
-            if (cal_delay==0)
-            {
-                cal_delay=8;
-                cout<<"Force cal_delay=8 to keep sample time in range"<<endl;
-            }
-        } else
+        string blob;
+        if (cache_refresh)
         {
-            runCount = 0;
-            if (!force_cal_grp) cal_grp = 0;
-            cal_delay = 1;
+            cache->invalidate(sample_key);
+            cache->invalidate(fit_key);
         }
+        else if (!plot_tp_fits && cache->read(fit_key,"fits",blob) && unpackFits(blob,nChan,grChan,grA,grT0,grTp,grChisq,chanNoise,shapeText))
+        {
+            cout << "Using cached fit results " << fit_key << " from " << cache->dir() << endl;
+            have_fits = true;
+            have_samples = true;
+        }
+        else if (cache->read(sample_key,"profiles",blob) && unpackSamples(blob,profiles,histMin,histMax))
+        {
+            cout << "Using cached pulse profiles " << sample_key << " from " << cache->dir() << endl;
+            have_samples = true;
+        }
+    }
 
-
-        // Process each event
-        eventCount = 0;
-        //bool goodEvent;
-        int pulsePolarity = -1;
-
-        do {
-            int rce = 0;
-            int fpga = 0;
-            int samplecount;
-
-            if (triggerevent_format) {
-                samplecount = triggerevent.count();
-            } else {
-                fpga = event.fpgaAddress();
-                samplecount = event.count();
-                if (read_temp && !event.isTiFrame()) for (uint i=0;i<4;i++) {
-                    printf("Event %d, temperature #%d: %f\n",eventCount,i,event.temperature(i,hybrid_type==1));
-                    read_temp = false;
-                }
-            }
-
-            //if(debug) printf("Event %d\n",eventCount);
-
-            if (!triggerevent_format && fpga==7) 
+    if (!have_samples)
+    {
+        TpSelection sel;
+        sel.evio_format = evio_format;
+        sel.triggerevent_format = triggerevent_format;
+        sel.force_cal_grp = force_cal_grp;
+        sel.flip_channels = flip_channels;
+        sel.cal_grp = cal_grp;
+        sel.use_fpga = use_fpga;
+        sel.use_hybrid = use_hybrid;
+        sel.num_events = num_events;
+        sel.hybrid_type = hybrid_type;
+        sel.outdir = outdir;
+
+        // Each reader thread takes the next file and fills its own profiles
+        int readers = jobs;
+        if (readers>argc-optind) readers = argc-optind;
+        TpReader *reader = new TpReader[readers];
+        pthread_t *threads = new pthread_t[readers];
+        tpFiles = argv+optind;
+        tpFileCount = argc-optind;
+        tpNextFile = 0;
+        for (int r=0;r<readers;r++)
+        {
+            reader[r].sel = &sel;
+            if (evio_format) {
+                DataReadEvio *tmpDataRead = new DataReadEvio();
+                if (triggerevent_format)
+                    tmpDataRead->set_engrun(true);
+                reader[r].dataRead = tmpDataRead;
+            } else 
+                reader[r].dataRead = new DataRead();
+            reader[r].profiles = (readers==1)?profiles:new PulseProfileSet();
+            for (int i=0;i<640;i++) reader[r].histMin[i]=16384;
+            for (int i=0;i<640;i++) reader[r].histMax[i]=0;
+            reader[r].read_temp = (r==0);
+            reader[r].ok = true;
+        }
+        if (readers==1) readThread(&reader[0]);
+        else for (int r=0;r<readers;r++)
+        {
+            if (pthread_create(&threads[r],NULL,readThread,&reader[r])!=0)
             {
-                //printf("not a data event\n");
-                continue;
+                cout << "Failed to start reader thread " << r << endl;
+                return(2);
             }
+        }
 
-            //goodEvent = true;
-            //for (x=0; x < event.count(); x++) {
-            //	sample  = event.sample(x);
-            //	channel = (sample->apv() * 128) + sample->channel();
-            //	if (channel==32 && sample->value(1)>8482 && sample->value(1)>7800) goodEvent = false; 
-            //}
-            //if (eventCount%2==0) printf("Event %d is %s\n",eventCount,goodEvent?"good":"bad");
-            //goodEvent = true;
-            if (eventCount%1000==0) printf("Event %d\n",eventCount);
-            if (num_events!=-1 && eventCount >= num_events) break;
-            //if (goodEvent) 
-            for (int x=0; x < samplecount; x++) {
-                int hyb;
-                int apv;
-                int apvch;
-                int channel;
-
-                bool goodSample = true;
-
-                // Get sample
-                if (triggerevent_format) {
-                    triggerevent.sample(x,triggersample);
-                    rce = triggersample->rceAddress();
-                    fpga = triggersample->febAddress();
-                    hyb = triggersample->hybrid();
-                    apv = triggersample->apv();
-                    apvch = triggersample->channel();
-                    goodSample = (!triggersample->head() && !triggersample->tail());
-                    for ( int y=0; y < 6; y++ ) {
-                        //printf("%x\n",sample->value(y));
-                        samples[y] = triggersample->value(y);
-                    }
-                } else {
-                    DevboardSample *sample  = event.sample(x);
-                    hyb = sample->hybrid();
-                    apv = sample->apv();
-                    apvch = sample->channel();
-                    for ( int y=0; y < 6; y++ ) {
-                        //printf("%x\n",sample->value(y));
-                        samples[y] = sample->value(y) & 0x3FFF;
-                        if (samples[y]==0) goodSample = false;
-                    }
-                }
-                //printf("event %d\tx=%d\tF%d H%d A%d channel %d, samples:\t%d\t%d\t%d\t%d\t%d\t%d\n",eventCount,x,rce,hyb,apv,channel,samples[0],samples[1],samples[2],samples[3],samples[4],samples[5]);
-                if (use_fpga!=-1 && fpga!=use_fpga) continue;
-                if (use_hybrid!=-1 && hyb!=use_hybrid) continue;
-                if (!goodSample) continue;
-
-                channel = apvch;
-
-                if (flip_channels)
-                    channel += (4-apv)*128;
-                else
-                    channel += apv*128;
-
-                //if (eventCount==0) printf("channel %d\n",channel);
-
-                if ( channel >= (5 * 128) ) {
-                    cout << "Channel " << dec << channel << " out of range" << endl;
-                    cout << "Apv = " << dec << apv << endl;
-                    cout << "Chan = " << dec << apvch << endl;
-                }
-
-                if ((apvch-cal_grp)%8!=0) continue;
-
-                // Filter APVs
-                if ( eventCount >= 20 ) {
-                    bool bad_event = false;
-                    for ( int y=0; y < 6; y++ ) if (samples[y]==0) {
-                        printf("sample is zero: event %d, channel %d, sample %d\n",eventCount,channel,y);
-                        bad_event = true;
-                    }
-                    if (bad_event) continue;
-
-                    sum = 0;
-                    for ( int y=0; y < 6; y++ ) {
-                        //vhigh = (value << 1) & 0x2AAA;
-                        //vlow  = (value >> 1) & 0x1555;
-                        //value = vlow | vhigh;
-
-                        //histAll->Fill(value,channel);
-                        //histSng[channel]->Fill(value);
-
-                        if ( samples[y] < histMin[channel] ) histMin[channel] = samples[y];
-                        if ( samples[y] > histMax[channel] ) histMax[channel] = samples[y];
-                        sum+=samples[y];
-                    }
-                    sum-=6*samples[0];
-                    int sgn = sum>0?0:1;
-                    if (pulsePolarity==-1)
-                    {
-                        pulsePolarity=((sgn-eventCount)%2 + 2)%2;
-                        printf("Saw a %s pulse, event %d, channel %d\n",sgn?"positive":"negative",eventCount,channel);
-                    }
-                    //int sgn = eventCount%2;
-                    for ( int y=0; y < 6; y++ ) {
-                        if (allSamples[sgn][channel][8*y+8-cal_delay]==NULL)
-                        {
-                            allSamples[sgn][channel][8*y+8-cal_delay] = new short[16384];
-                            for (int i=0;i<16384;i++) allSamples[sgn][channel][8*y+8-cal_delay][i]=0;
-                        }
-                        allSamples[sgn][channel][8*y+8-cal_delay][samples[y]]++;
-                    }
-                    //tpfile<<"T0 " << fit_par[0] <<", A " << fit_par[1] << "Fit chisq " << chisq << ", DOF " << dof << ", prob " << TMath::Prob(chisq,dof) << endl;
-                }
+        // Merge only after all threads are done
+        if (readers>1) for (int r=0;r<readers;r++) pthread_join(threads[r],NULL);
+        bool readOK = true;
+        for (int r=0;r<readers;r++)
+        {
+            if (reader[r].profiles!=profiles)
+            {
+                profiles->merge(reader[r].profiles);
+                delete reader[r].profiles;
             }
-            eventCount++;
-
-            if (triggerevent_format) {
-                readOK = dataRead->next(&triggerevent);
-            } else {
-                readOK = dataRead->next(&event);
+            for (int i=0;i<640;i++)
+            {
+                if (reader[r].histMin[i]<histMin[i]) histMin[i] = reader[r].histMin[i];
+                if (reader[r].histMax[i]>histMax[i]) histMax[i] = reader[r].histMax[i];
             }
-        } while (readOK);
-        dataRead->close();
-        if (eventCount != runCount)
-        {
-            printf("ERROR: events read = %d, runCount = %d\n",eventCount, runCount);
+            delete reader[r].dataRead;
+            if (!reader[r].ok) readOK = false;
         }
-        optind++;
+        delete[] reader;
+        delete[] threads;
+        if (!readOK) return(2);
+        if (cache!=NULL) cache->write(sample_key,"profiles",packSamples(profiles,histMin,histMax));
     }
 
-    double yi[48], ey[48], ti[48];
-    int ni;
-    TGraphErrors *fitcurve;
-    /*
-    TF1 *shapingFunction = new TF1("Shaping Function",
-            "[0]+[1]*(x>[2])*((x-[2])/[3])*exp(1-((x-[2])/[3]))",-1.0*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL);
-            */
-
-    //TF1 *shapingFunction = new TF1("Shaping Function",
-            //"[0]+\
-            //[1]*(x>[2])*(\
-                //([3]/(([3]-[4])*([3]-[5])))*exp(([2]-x)/[3])+\
-                //([4]/(([4]-[5])*([4]-[3])))*exp(([2]-x)/[4])+\
-                //([5]/(([5]-[3])*([5]-[4])))*exp(([2]-x)/[5]))",
-            //-1.0*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL);
-
-    //TF1 *shapingFunction = new TF1("Shaping Function",
-            //"[0]+\
-            //[1]*(x>[2])*\
-            //([3]/(([3]-[4])*([3]-[4])))*(\
-                //exp(([2]-x)/[3])-\
-                //(1+(([3]-[4])/([3]*[4]))*(x-[2]))*exp(([2]-x)/[4]))",
-            //-1.0*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL);
-
-    //TF1 *shapingFunction = new TF1("Shaping Function",
-            //"[0]+\
-            //[1]*(x>[2])*(\
-                //([3]*[3]/(([3]-[4])*([3]-[5])*([3]-[6])))*exp(([2]-x)/[3])+\
-                //([4]*[4]/(([4]-[5])*([4]-[6])*([4]-[3])))*exp(([2]-x)/[4])+\
-                //([5]*[5]/(([5]-[6])*([5]-[3])*([5]-[4])))*exp(([2]-x)/[5])+\
-                //([6]*[6]/(([6]-[3])*([6]-[4])*([6]-[5])))*exp(([2]-x)/[6]))",
-            //-1.0*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL);
-
-    //TF1 *shapingFunction = new TF1("Shaping Function",
-            //"[0]+\
-            //[1]*(x>[2])*(\
-                //([3]*[3]/(([3]-[4])*([3]-[5])*([3]-[5])))*exp(([2]-x)/[3])+\
-                //([4]*[4]/(([4]-[5])*([4]-[5])*([4]-[3])))*exp(([2]-x)/[4])+\
-                //(([3]*[3]/(([4]-[3])*([3]-[5])*([3]-[5]))) - ([4]*[4]/(([4]-[3])*([4]-[5])*([4]-[5]))))*exp(([2]-x)/[5])+\
-                //((x-[2])/(([5]-[3])*([5]-[4])))*exp(([2]-x)/[5]))",
-            //-1.0*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL);
-
-    //TF1 *shapingFunction = new TF1("Shaping Function",
-            //"[0]+\
-            //[1]*(x>[2])*\
-            //([3]*[3]/(([3]-[4])*([3]-[4])*([3]-[4])))*(\
-                //exp(([2]-x)/[3])-\
-                //(1+\
-                 //(([3]-[4])/([3]*[4]))*(x-[2])+\
-                 //(([3]-[4])*([3]-[4])/(2*[3]*[4]*[3]*[4]))*(x-[2])*(x-[2]))*exp(([2]-x)/[4]))",
-            //-1.0*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL);
-            
-    TF1 *shapingFunction = new TF1("Shaping Function",fitf_4pole,-1.0*SAMPLE_INTERVAL,5.0*SAMPLE_INTERVAL,5);
-            
-    double chanNoise[2][640]={{0.0}};
     double chanChan[640];
-    //TH1S *histSamples1D = new TH1S("h1","h1",16384,-0.5,16383.5);
-    TH2S *histSamples;
-    double A, T0, A0, fit_start;
-
     for (int i=0;i<640;i++) chanChan[i] = i;
 
-    for (int channel=0;channel<640;channel++) for (int sgn=0;sgn<2;sgn++) {
-        ni=0;
-        for (int i=0;i<48;i++) if (allSamples[sgn][channel][i]!=NULL) 
-        {
-            int nsamples = 0;
-            double rms;
-            doStats(16384, histMin[channel], histMax[channel], allSamples[sgn][channel][i], nsamples, yi[ni], rms);
-            if (use_baseline_cal) yi[ni] -= calMean[channel][i/8];
-            //if (use_baseline_cal) yi[ni] += calMean[channel][i/8]-2*calMean[channel][6];
-
-            ey[ni] = rms/sqrt((double)nsamples);
-            chanNoise[sgn][channel]+=rms;
-            //histSamples1D->Reset();
-            //printf("TH!: %f, %f\n", histSamples1D->GetEntries(),(histSamples1D->GetRMS()*histSamples1D->GetRMS()-yi[ni]*yi[ni]));
-            //for (int j=histMin[channel];j<=histMax[channel];j++)
-            //{
-            //histSamples1D->SetBinContent(j+1,allSamples[sgn][channel][i][j]);
-            //}
-            //if (histSamples1D->Fit("gaus","Q0")==0) {
-            //yi[ni]  = histSamples1D->GetFunction("gaus")->GetParameter(1);
-            //ey[ni]  = histSamples1D->GetFunction("gaus")->GetParError(1);
-            //}
-            //else {
-            //	printf("Could not fit channel %d, polarity %d, sample %d\n",channel,sgn,i);
-            //}
-
-            ti[ni] = (i-8)*delay_step;
-            ni++;
-        }
-        if (ni==0) continue;
-        chanNoise[sgn][channel]/=ni;
-
-        if (plot_tp_fits)
+    if (!have_fits)
+    {
+        TpFitJob fitJob;
+        fitJob.profiles = profiles;
+        fitJob.calMean = calMean;
+        fitJob.use_baseline_cal = use_baseline_cal;
+        fitJob.delay_step = delay_step;
+        fitJob.move_fitstart = move_fitstart;
+        fitJob.fit_shift = fit_shift;
+        fitJob.plot_tp_fits = plot_tp_fits && !defer_plots;
+        fitJob.c1 = c1;
+        fitJob.histMin = histMin;
+        fitJob.histMax = histMax;
+        fitJob.inname = inname.Data();
+
+        // Fits run in forked processes, plots need the canvas of this one
+        int fit_workers = fitJob.plot_tp_fits?1:jobs;
+        fitJob.fits = (TpFit *)sharedAlloc(2*640*sizeof(TpFit));
+        if (fitJob.fits==NULL)
         {
-            gStyle->SetOptStat(0);
-            sprintf(name,"samples_%s_%i",sgn?"neg":"pos",channel);
-            sprintf(title,"APV25 pulse shape, channel %d, %s pulses;Time [ns];Amplitude [ADC counts]",channel,sgn?"negative":"positive");
-            if (use_baseline_cal)
-                histSamples = new TH2S(name,title,48,-8.5*delay_step,39.5*delay_step,16384,-0.5-calMean[channel][6],16383.5-calMean[channel][6]);
-            else 
-                histSamples = new TH2S(name,title,48,-8.5*delay_step,39.5*delay_step,16384,-0.5,16383.5);
-            c1->Clear();
-            for (int i=0;i<48;i++) if (allSamples[sgn][channel][i]!=NULL) 
-            {
-                for (int j=histMin[channel];j<=histMax[channel];j++)
-                {
-                    if (use_baseline_cal)
-                        histSamples->Fill((i-8)*delay_step,j-calMean[channel][i/8],allSamples[sgn][channel][i][j]);
-                    //histSamples->Fill((i-8)*delay_step,j+calMean[channel][i/8]-2*calMean[channel][6],allSamples[sgn][channel][i][j]);
-                    else
-                        histSamples->Fill((i-8)*delay_step,j,allSamples[sgn][channel][i][j]);
-                }
-            }
-            if (use_baseline_cal)
-                histSamples->GetYaxis()->SetRangeUser(histMin[channel]-calMean[channel][6],histMax[channel]-calMean[channel][6]);
-            else
-                histSamples->GetYaxis()->SetRangeUser(histMin[channel],histMax[channel]);
-            histSamples->Draw("colz");
+            fitJob.fits = new TpFit[2*640]();
+            fit_workers = 1;
         }
-
-        fitcurve = new TGraphErrors(ni,ti,yi,NULL,ey);
-        if (sgn==0) shapingFunction->SetParameter(1,TMath::MaxElement(ni,yi)-yi[0]);
-        else shapingFunction->SetParameter(1,TMath::MinElement(ni,yi)-yi[0]);
-        shapingFunction->SetParameter(2,-10.0);
-        //shapingFunction->SetParameter(3,50.0);
-        shapingFunction->SetParameter(3,80.0);
-        shapingFunction->SetParameter(4,12.0);
-        //shapingFunction->SetParameter(5,10.0);
-        //shapingFunction->SetParameter(6,70.0);
-        shapingFunction->FixParameter(0,yi[0]);
-        A0 = yi[0];
-        if (ni>0)
-        {
-            if (fitcurve->Fit(shapingFunction,"Q0","",-1*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL)==0)
+        forkWorkers(fit_workers,fitChannels,&fitJob);
+
+        // Collect in channel order; shape rows of failed fits use the last good A and T0
+        double A = 0.0, T0 = 0.0;
+        for (int channel=0;channel<640;channel++) for (int sgn=0;sgn<2;sgn++) {
+            TpFit *fit = &fitJob.fits[sgn*640+channel];
+            if (fit->ni==0) continue;
+            chanNoise[sgn][channel] = fit->noise;
+            if (fit->fitted)
             {
-                A = shapingFunction->GetParameter(1);
-                T0 = shapingFunction->GetParameter(2);
-                for (int i=0;i<N_TIME_CONSTS;i++) {
-                    grTp[i][sgn][nChan[sgn]]=shapingFunction->GetParameter(3+i);
-                }
-                //printf("%f, %f, %f, %f\n",shapingFunction->GetParameter(0),shapingFunction->GetParameter(1),shapingFunction->GetParameter(2),shapingFunction->GetParameter(3));
-                //printf("%f, %f, %f, %f, %f, %f\n",shapingFunction->GetParameter(0),shapingFunction->GetParameter(1),shapingFunction->GetParameter(2),shapingFunction->GetParameter(3),shapingFunction->GetParameter(4),shapingFunction->GetParameter(5));
-                //printf("%f, %f, %f, %f, %f\n",shapingFunction->GetParameter(0),shapingFunction->GetParameter(1),shapingFunction->GetParameter(2),shapingFunction->GetParameter(3),shapingFunction->GetParameter(4));
-                //printf("%f, %f, %f, %f, %f, %f, %f\n",shapingFunction->GetParameter(0),shapingFunction->GetParameter(1),shapingFunction->GetParameter(2),shapingFunction->GetParameter(3),shapingFunction->GetParameter(4),shapingFunction->GetParameter(5),shapingFunction->GetParameter(6));
-                double residuals[8];
-                //for (int i =0;i<8;i++) {
-                //    residuals[i]=0;
-                //}
-                for (int i =0;i<8;i++) {
-                    double dataX,dataY;
-                    fitcurve->GetPoint(i,dataX,dataY);
-                    double res = dataY - shapingFunction->Eval(dataX);
-                    residuals[i] = res;
-                    //residuals[i] += res/6.0;
-                    //printf("%f, %f, %f\n",dataX,dataY,res);
-                }
-                for (int i =0;i<48;i++) {
-                    double dataX,dataY;
-                    fitcurve->GetPoint(i,dataX,dataY);
-                    fitcurve->SetPoint(i,dataX,dataY-residuals[i%8]);
-                }
-                fitcurve->Fit(shapingFunction,"Q0","",-1*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL);
-                if (move_fitstart)
-                {
-                    fit_start = T0+fit_shift;
-                    fitcurve->Fit(shapingFunction,"Q0","",fit_start,5*SAMPLE_INTERVAL);
-                    A = shapingFunction->GetParameter(1);
-                    T0 = shapingFunction->GetParameter(2);
-                    for (int i=0;i<N_TIME_CONSTS;i++) {
-                        grTp[i][sgn][nChan[sgn]]=shapingFunction->GetParameter(3+i);
-                    }
-                }
-                //printf("%f, %f, %f",shapingFunction->GetParameter(0),shapingFunction->GetParameter(1),shapingFunction->GetParameter(2));
-                //for (int i=0;i<N_TIME_CONSTS;i++) {
-                    //printf(", %f",shapingFunction->GetParameter(3+i));
-                //}
-                //printf("\n");
+                A = fit->A;
+                T0 = fit->T0;
                 grChan[sgn][nChan[sgn]]=channel;
                 grA[sgn][nChan[sgn]]=A;
                 if (sgn==1) grA[sgn][nChan[sgn]]*=-1;
                 grT0[sgn][nChan[sgn]]=T0;
-                grChisq[sgn][nChan[sgn]]=shapingFunction->GetChisquare();
+                for (int i=0;i<N_TIME_CONSTS;i++) {
+                    grTp[i][sgn][nChan[sgn]]=fit->Tp[i];
+                }
+                grChisq[sgn][nChan[sgn]]=fit->chisq;
                 nChan[sgn]++;
             }
-            else
+
+            shapeText[sgn]<<channel<<"\t"<<fit->ni;
+            for (int i=0;i<fit->ni;i++)
             {
-                printf("Could not fit pulse shape for channel %d, polarity %d\n",channel,sgn);
+                shapeText[sgn]<<"\t"<<fit->ti[i]-T0<<"\t"<<(fit->yi[i]-fit->A0)/A<<"\t"<<fit->ey[i]/A;
             }
+            shapeText[sgn]<<endl;
         }
-        if (plot_tp_fits)
+
+        if (plot_tp_fits && defer_plots)
         {
-            fitcurve->SetLineWidth(3);
-            fitcurve->Draw("SAME");
-            if (move_fitstart)
-            {
-                shapingFunction->SetLineStyle(1);
-                shapingFunction->SetLineWidth(3);
-                shapingFunction->SetLineColor(2);
-                shapingFunction->SetRange(fit_start,5*SAMPLE_INTERVAL);
-                shapingFunction->DrawCopy("LSAME");
-                shapingFunction->SetRange(-1*SAMPLE_INTERVAL,fit_start);
-                shapingFunction->SetLineStyle(2);
-                shapingFunction->Draw("LSAME");
-            }
-            else
+            PlotWriter plots;
+            PlotRecord plot;
+            cout << "Writing Tp fit plots to " << inname+".plots" << endl;
+            if (plots.open((inname+".plots").Data()))
             {
-                shapingFunction->SetLineStyle(1);
-                shapingFunction->SetLineWidth(3);
-                shapingFunction->SetLineColor(2);
-                shapingFunction->SetRange(-1*SAMPLE_INTERVAL,5*SAMPLE_INTERVAL);
-                shapingFunction->Draw("LSAME");
+                for (int sgn=0;sgn<2;sgn++) for (int channel=0;channel<640;channel++)
+                {
+                    if (fitJob.fits[sgn*640+channel].ni==0) continue;
+                    recordFitPlot(plot,&fitJob,sgn,channel);
+                    plots.write(plot);
+                }
+                if (!plots.close()) cout << "Failed to write " << inname+".plots" << endl;
             }
-            sprintf(name,"%s_tp_fit_%s_%i.png",inname.Data(),sgn?"neg":"pos",channel);
-            c1->SaveAs(name);
-            delete histSamples;
-            gStyle->SetOptStat("emrou");
-        }
-        delete fitcurve;
-
-        shapefile[sgn]<<channel<<"\t"<<ni;
-        for (int i=0;i<ni;i++)
-        {
-            shapefile[sgn]<<"\t"<<ti[i]-T0<<"\t"<<(yi[i]-A0)/A<<"\t"<<ey[i]/A;
         }
-        shapefile[sgn]<<endl;
     }
+    if (!have_fits && cache!=NULL) cache->write(fit_key,"fits",packFits(nChan,grChan,grA,grT0,grTp,grChisq,chanNoise,shapeText));
     for (int sgn=0;sgn<2;sgn++)
     {
+        shapefile[sgn]<<shapeText[sgn].str();
         for (int i=0;i<nChan[sgn];i++)
         {
             tpfile[sgn] <<grChan[sgn][i]<<"\t"<<grA[sgn][i]<<"\t"<<grT0[sgn][i]<<"\t";
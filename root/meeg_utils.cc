@@ -19,6 +19,10 @@
 #include <TMultiGraph.h>
 #include <TGraphErrors.h>
 #include <unistd.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
 #include <TLatex.h>
 
 /*
@@ -259,3 +263,137 @@ void myText(Double_t x,Double_t y,TString text, Double_t tsize=0.05,Color_t colo
    const char* t = text.Data();
    myText(x,y,t,tsize,color);
 }
+
+///===================================================
+/// Cached histogram snapshots
+///===================================================
+bool writeCachedHists(const char *filename, TObjArray *hists, TVectorD *state)
+{
+	TDirectory *saveDir = gDirectory;
+	TFile *file = new TFile(filename,"RECREATE");
+	bool ok = !file->IsZombie();
+	for (int i=0;ok && i<=hists->GetLast();i++)
+	{
+		ok = file->WriteTObject(hists->At(i),Form("h%d",i))>0;
+	}
+	if (ok && state!=NULL) ok = file->WriteTObject(state,"state")>0;
+	file->Close();
+	delete file;
+	saveDir->cd();
+	return ok;
+}
+
+bool readCachedHists(const char *filename, TObjArray *hists, TVectorD *state)
+{
+	TDirectory *saveDir = gDirectory;
+	TFile *file = new TFile(filename,"READ");
+	bool ok = !file->IsZombie();
+	TH1 **cached = new TH1*[hists->GetLast()+1];
+
+	// check everything before touching hists
+	for (int i=0;ok && i<=hists->GetLast();i++)
+	{
+		TH1 *hist = (TH1*) hists->At(i);
+		cached[i] = (TH1*) file->Get(Form("h%d",i));
+		ok = cached[i]!=NULL && cached[i]->IsA()==hist->IsA() && cached[i]->GetNcells()==hist->GetNcells();
+	}
+	TVectorD *cachedState = NULL;
+	if (ok && state!=NULL)
+	{
+		cachedState = (TVectorD*) file->Get("state");
+		ok = cachedState!=NULL && cachedState->GetNrows()==state->GetNrows();
+	}
+	if (ok)
+	{
+		for (int i=0;i<=hists->GetLast();i++) ((TH1*) hists->At(i))->Add(cached[i]);
+		if (state!=NULL) *state = *cachedState;
+	}
+	delete[] cached;
+	delete cachedState;
+	file->Close();
+	delete file;
+	saveDir->cd();
+	return ok;
+}
+
+void forkWorkers(int workers, void (*work)(void *arg, int worker, int workers), void *arg)
+{
+	if (workers<=1)
+	{
+		work(arg,0,1);
+		return;
+	}
+
+	// buffered output would be written again by every child
+	fflush(stdout);
+	std::cout.flush();
+
+	pid_t *pids = new pid_t[workers];
+	for (int w=0;w<workers;w++)
+	{
+		pids[w] = fork();
+		if (pids[w]==0)
+		{
+			work(arg,w,workers);
+			fflush(stdout);
+			std::cout.flush();
+			_exit(0); // skip ROOT's exit handlers, the parent owns the open files
+		}
+		if (pids[w]<0) printf("Could not fork fit worker %d\n",w);
+	}
+	for (int w=0;w<workers;w++)
+	{
+		int status = 0;
+		if (pids[w]>0 && waitpid(pids[w],&status,0)==pids[w] && WIFEXITED(status) && WEXITSTATUS(status)==0) continue;
+		printf("Fit worker %d failed, running it again\n",w);
+		work(arg,w,workers);
+	}
+	delete[] pids;
+}
+
+void *sharedAlloc(size_t size)
+{
+	void *ptr = mmap(NULL,size,PROT_READ|PROT_WRITE,MAP_SHARED|MAP_ANONYMOUS,-1,0);
+	if (ptr==MAP_FAILED) return NULL;
+	memset(ptr,0,size);
+	return ptr;
+}
+
+int numCores()
+{
+	long cores = sysconf(_SC_NPROCESSORS_ONLN);
+	return cores>0?cores:1;
+}
+
+void fitGausPeaks(int n, TH1F **hists, GaussPeakResult *results, bool attach)
+{
+	const float **counts = new const float*[n];
+	TH1F *first = NULL;
+	for (int i=0;i<n;i++)
+	{
+		counts[i] = (hists[i]!=NULL && hists[i]->GetEntries()>0) ? hists[i]->GetArray()+1 : NULL;
+		if (first==NULL && hists[i]!=NULL) first = hists[i];
+	}
+	if (first!=NULL)
+	{
+		TAxis *axis = first->GetXaxis();
+		GaussPeak::fitMany(n,counts,axis->GetNbins(),axis->GetXmin(),axis->GetBinWidth(1),results,true,numCores());
+	}
+	else memset(results,0,n*sizeof(GaussPeakResult));
+	delete[] counts;
+
+	if (!attach) return;
+	for (int i=0;i<n;i++) if (results[i].ok)
+	{
+		// One function per histogram, a new TF1 replaces the global one of the same name
+		TString name = TString("gaus_") + hists[i]->GetName();
+		TF1 *gaus = new TF1(name,"gaus",hists[i]->GetXaxis()->GetXmin(),hists[i]->GetXaxis()->GetXmax());
+		gaus->SetParameters(results[i].norm,results[i].mean,results[i].sigma);
+		gaus->SetParError(0,results[i].normError);
+		gaus->SetParError(1,results[i].meanError);
+		gaus->SetParError(2,results[i].sigmaError);
+		gaus->SetChisquare(results[i].chi2);
+		gaus->SetNDF(results[i].ndf);
+		hists[i]->GetListOfFunctions()->Add(gaus);
+	}
+}
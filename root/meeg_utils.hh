@@ -1,6 +1,10 @@
 #ifndef MEEG_HH
 #define MEEG_HH
 #include <TCanvas.h>
+#include <TObjArray.h>
+#include <TVectorD.h>
+#include <TH1F.h>
+#include <GaussPeak.h>
 
 #define SAMPLE_INTERVAL 24.0
 void doStats(int n, int nmin, int nmax, int *y, int &count, double &center, double &spread);
@@ -16,5 +20,23 @@ Double_t fitf_4pole_intnorm(Double_t *x, Double_t *par);
 void myText(Double_t x,Double_t y,const char *text, Double_t tsize,Color_t color);
 void myText(Double_t x,Double_t y,TString text, Double_t tsize,Color_t color);
 
+// Histogram snapshots for ResultCache products: hists holds TH1 pointers in a fixed order,
+// state holds any scalars that go with them. Reading adds the stored contents to hists.
+bool writeCachedHists(const char *filename, TObjArray *hists, TVectorD *state);
+bool readCachedHists(const char *filename, TObjArray *hists, TVectorD *state);
+
+// Parallel loop over worker processes: work(arg,worker,workers) runs in a forked child
+// for every worker, or in this process if workers is 1. ROOT fitting is not thread safe,
+// so fits run in processes and write their results to memory from sharedAlloc().
+// A worker whose process fails is run again in this process.
+void forkWorkers(int workers, void (*work)(void *arg, int worker, int workers), void *arg);
+void *sharedAlloc(size_t size);
+int numCores();
+
+// Gaussian fits of histograms of the same binning, as Fit("gaus") but without Minuit and in threads
+// (GaussPeak). hists may hold NULLs, whose results have ok false. With attach, each fitted histogram
+// gets a "gaus" function with the result so it draws as after Fit("gaus").
+void fitGausPeaks(int n, TH1F **hists, GaussPeakResult *results, bool attach = false);
+
 
 #endif
@@ -0,0 +1,275 @@
+//-----------------------------------------------------------------------------
+// File          : meeg_zs.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Zero suppression emulation on full rate data: applies the thresholds of a
+// .thresholds file (N of 6 samples over threshold, optional FIR filter) to
+// every readout, writes the surviving readouts to a reduced data file and
+// reports the data volume reduction and the signal efficiency per channel.
+// The reduced file uses the DataRead format, with the frames of the input.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <TString.h>
+#include <Data.h>
+#include <DataRead.h>
+#include <DataReadEvio.h>
+#include <DevboardEvent.h>
+#include <DevboardSample.h>
+#include <TiTriggerEvent.h>
+#include <TriggerSample.h>
+#include <ThresholdEmulator.h>
+#include <FrameLayout.h>
+using namespace std;
+
+
+// Write one record in the DataRead format
+bool writeRecord ( int fd, uint type, const void *data, uint size, uint bytes ) {
+   uint header = (type << 28) | (size & 0x0FFFFFFF);
+   if ( ::write(fd,&header,4) != 4 ) return(false);
+   return(::write(fd,data,bytes) == (int)bytes);
+}
+
+int main ( int argc, char **argv ) {
+   bool              evio_format = false;
+   bool              triggerevent_format = false;
+   string            thresh_file = "";
+   string            base_file = "";
+   string            filter_file = "";
+   uint              min_samples = 1;
+   double            signal_sigma = 5.0;
+   long              num_events = -1;
+   TString           outname = "";
+   DataRead          *dataRead;
+   DevboardEvent     event;
+   TiTriggerEvent    triggerevent;
+   TriggerSample     triggersample;
+   Data              *frame;
+   ThresholdEmulator emulator;
+   vector<int>       readout;
+   uint              *out = NULL;
+   uint              outAlloc = 0;
+   uint              values[6];
+   long              eventCount = 0;
+   unsigned long long inWords = 0;
+   unsigned long long outWords = 0;
+   int               c;
+
+   while ((c = getopt(argc,argv,"hT:b:f:N:S:EVe:o:")) !=-1)
+      switch (c)
+      {
+         case 'h':
+            printf("Usage: meeg_zs [options] -T thresholds_file data_files\n");
+            printf("-h: print this help\n");
+            printf("-T: thresholds file from meeg_all_baseline\n");
+            printf("-b: baseline (.base) file from meeg_all_baseline, needed for the signal efficiency\n");
+            printf("-f: apply FIR filter from specified file (meeg_sync format)\n");
+            printf("-N: number of samples that must be above threshold (default 1)\n");
+            printf("-S: signal cut in noise sigmas for the efficiency (default 5)\n");
+            printf("-E: use EVIO file format\n");
+            printf("-V: use TriggerEvent event format\n");
+            printf("-e: stop after specified number of events\n");
+            printf("-o: use specified output filename base\n");
+            printf("Writes <name>.zs.bin with the kept readouts (read it back without -E) and the <name>.zs report\n");
+            return(0);
+            break;
+         case 'T':
+            thresh_file = optarg;
+            break;
+         case 'b':
+            base_file = optarg;
+            break;
+         case 'f':
+            filter_file = optarg;
+            break;
+         case 'N':
+            min_samples = atoi(optarg);
+            break;
+         case 'S':
+            signal_sigma = atof(optarg);
+            break;
+         case 'E':
+            evio_format = true;
+            break;
+         case 'V':
+            triggerevent_format = true;
+            break;
+         case 'e':
+            num_events = atol(optarg);
+            break;
+         case 'o':
+            outname = optarg;
+            break;
+         case '?':
+            printf("Invalid option or missing option argument; -h to list options\n");
+            return(1);
+         default:
+            abort();
+      }
+
+   if ( argc-optind==0 || thresh_file == "" ) {
+      cout << "Usage: meeg_zs [options] -T thresholds_file data_files\n";
+      return(1);
+   }
+
+   if ( ! emulator.loadThresholds(thresh_file) ) {
+      cout << "Could not read thresholds from " << thresh_file << endl;
+      return(1);
+   }
+   if ( base_file != "" && ! emulator.loadBaseline(base_file) ) {
+      cout << "Could not read baseline from " << base_file << endl;
+      return(1);
+   }
+   if ( filter_file != "" && ! emulator.loadFilter(filter_file) ) {
+      cout << "Could not read filter from " << filter_file << endl;
+      return(1);
+   }
+   emulator.setMinSamples(min_samples);
+   emulator.setSignalSigma(signal_sigma);
+
+   if (outname == "") {
+      outname = argv[optind];
+      outname.ReplaceAll(".bin","");
+      if (outname.Contains('/')) {
+         outname.Remove(0,outname.Last('/')+1);
+      }
+   }
+
+   int outFd = ::open((outname+".zs.bin").Data(),O_WRONLY|O_CREAT|O_TRUNC,0644);
+   if ( outFd < 0 ) {
+      cout << "Could not open " << outname+".zs.bin" << endl;
+      return(1);
+   }
+   cout << "Writing kept readouts to " << outname+".zs.bin" << endl;
+
+   if (evio_format) {
+      DataReadEvio *tmpDataRead = new DataReadEvio();
+      if (triggerevent_format)
+         tmpDataRead->set_engrun(true);
+      dataRead = tmpDataRead;
+   } else
+      dataRead = new DataRead();
+
+   if (triggerevent_format) frame = &triggerevent;
+   else frame = &event;
+
+   for (; optind < argc && (num_events < 0 || eventCount < num_events); optind++) {
+      cout << "Reading data file " << argv[optind] << endl;
+      if ( ! dataRead->open(argv[optind]) ) {
+         printf("bad file: %s\n",argv[optind]);
+         continue;
+      }
+      bool first = true;
+
+      while ( (num_events < 0 || eventCount < num_events) && dataRead->next(frame) ) {
+         uint size = frame->size();
+         uint *data = frame->data();
+         uint head, sampleSize, count;
+
+         // Carry the configuration over, it is parsed by the time the first frame is read
+         if ( first ) {
+            string xml = dataRead->getConfigXml();
+            writeRecord(outFd,Data::XmlConfig,xml.c_str(),xml.length()+1,xml.length()+1);
+            first = false;
+         }
+
+         inWords += size + 1;
+         if (eventCount%1000==0) printf("Event %ld\n",eventCount);
+         eventCount++;
+
+         // Frames without readouts go through unchanged
+         if (triggerevent_format) {
+            head = TrackerHeadWords;
+            sampleSize = TriggerSampleWords;
+            count = triggerevent.count();
+         } else {
+            head = DevboardHeadWords;
+            sampleSize = DevboardSampleWords;
+            count = (event.fpgaAddress()==7 || event.isTiFrame()) ? 0 : event.count();
+         }
+         if ( count == 0 ) {
+            writeRecord(outFd,Data::RawData,data,size,size*4);
+            outWords += size + 1;
+            continue;
+         }
+
+         // Cut all readouts of the frame together, APV head and tail words are always kept
+         emulator.begin();
+         readout.resize(count);
+         for (uint x=0; x < count; x++) {
+            if (triggerevent_format) {
+               triggerevent.sample(x,&triggersample);
+               if ( triggersample.head() || triggersample.tail() ) {
+                  readout[x] = -1;
+                  continue;
+               }
+               for (uint y=0; y < 6; y++) values[y] = triggersample.value(y);
+               readout[x] = emulator.add(triggersample.rceAddress(),triggersample.febAddress(),triggersample.hybrid(),
+                                         triggersample.apv(),triggersample.channel(),values);
+            } else {
+               DevboardSample *sample = event.sample(x);
+               for (uint y=0; y < 6; y++) values[y] = sample->value(y) & 0x3FFF;
+               readout[x] = emulator.add(0,event.fpgaAddress(),sample->hybrid(),sample->apv(),sample->channel(),values);
+            }
+         }
+         emulator.process();
+
+         // Header, kept readouts, then the trailing words (tail, TI data)
+         if ( size > outAlloc ) {
+            outAlloc = size;
+            out = (uint *)realloc(out,outAlloc*sizeof(uint));
+         }
+         uint outSize = head;
+         memcpy(out,data,head*sizeof(uint));
+         for (uint x=0; x < count; x++) {
+            if ( readout[x] >= 0 && ! emulator.keep(readout[x]) ) continue;
+            memcpy(out+outSize,data+head+x*sampleSize,sampleSize*sizeof(uint));
+            outSize += sampleSize;
+         }
+         uint tail = size - head - count*sampleSize;
+         memcpy(out+outSize,data+head+count*sampleSize,tail*sizeof(uint));
+         outSize += tail;
+
+         writeRecord(outFd,Data::RawData,out,outSize,outSize*4);
+         outWords += outSize + 1;
+      }
+      dataRead->close();
+   }
+   ::close(outFd);
+   free(out);
+   delete dataRead;
+
+   // Report
+   ofstream reportfile;
+   cout << "Writing zero suppression report to " << outname+".zs" << endl;
+   reportfile.open(outname+".zs");
+   reportfile << "#" << outname << endl;
+   reportfile << "# thresholds " << thresh_file << endl;
+   reportfile << "# events " << eventCount << ", readouts " << emulator.readouts() << ", kept " << emulator.kept();
+   reportfile << ", without threshold " << emulator.unknown() << ", APV or channel out of range " << emulator.invalid() << endl;
+   reportfile << "# words in " << inWords << ", out " << outWords;
+   if ( outWords > 0 ) reportfile << ", reduction " << (double)inWords/outWords;
+   reportfile << endl;
+   emulator.report(reportfile);
+   reportfile.close();
+
+   printf("Events %ld, readouts %lu, kept %lu (%.2f%%), %lu without threshold, %lu out of range\n",eventCount,emulator.readouts(),emulator.kept(),
+          emulator.readouts()?100.0*emulator.kept()/emulator.readouts():0.0,emulator.unknown(),emulator.invalid());
+   printf("Data volume %llu -> %llu words, reduction %.2f\n",inWords,outWords,outWords?(double)inWords/outWords:0.0);
+   return(0);
+}
@@ -0,0 +1,275 @@
+//-----------------------------------------------------------------------------
+// File          : trigger_timing.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Single pass trigger timing analysis for all RCEs/FEBs: inter-trigger time,
+// TI timestamp phase modulo any clock period, rate vs. time and deadtime.
+// Input files are processed in parallel, one thread per file. With -s the
+// live shared memory feed is read and the summary is refreshed every few
+// seconds until the run stops.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <DataRead.h>
+#include <DataReadEvio.h>
+#include <TiTriggerEvent.h>
+#include <TriggerTiming.h>
+using namespace std;
+
+// One input file, processed by its own thread
+typedef struct {
+   const char    *file;
+   DataRead      *dataRead;
+   long           maxEvents;
+   TriggerTiming *timing;
+   long           banks;
+   long           noTi;
+} TimingJob;
+
+// Read one file into the job's accumulator, banks without TI data are counted and skipped
+void *timingThread ( void *arg ) {
+   TimingJob      *job = (TimingJob *)arg;
+   TiTriggerEvent  event;
+
+   job->banks = 0;
+   job->noTi  = 0;
+   while ( (job->maxEvents < 0 || job->banks < job->maxEvents) && job->dataRead->next(&event) ) {
+      job->banks++;
+      if ( ! event.hasTiData() ) {
+         job->noTi++;
+         continue;
+      }
+      job->timing->process(&event);
+   }
+   return(NULL);
+}
+
+// Write summary and histograms
+void writeResults ( TriggerTiming *timing, string name ) {
+   ofstream out;
+
+   timing->dump();
+
+   out.open((name + ".timing").c_str());
+   timing->dump(out);
+   out.close();
+
+   out.open((name + ".timing_hist").c_str());
+   timing->dumpHistograms(out);
+   out.close();
+}
+
+TriggerTiming *newTiming ( double diffMax, uint diffBins, double rateSec, uint *periods, uint periodCount ) {
+   TriggerTiming *timing = new TriggerTiming(diffMax,diffBins,rateSec);
+   for (uint i=0; i < periodCount; i++) timing->addPeriod(periods[i]);
+   return(timing);
+}
+
+int main ( int argc, char **argv ) {
+   bool            evio_format = false;
+   int             bank_num = 51;
+   int             bank_range = 16;
+   long            num_events = -1;
+   double          diff_max = 100.0;
+   uint            diff_bins = 100;
+   double          rate_sec = 1.0;
+   double          update_sec = 5.0;
+   string          shared_system = "";
+   uint            shared_id = 1;
+   uint            periods[TriggerTiming::MaxPeriods];
+   uint            period_count = 0;
+   string          outname = "";
+   int             c;
+
+   while ((c = getopt(argc,argv,"hEb:r:e:m:n:w:p:s:i:u:o:")) !=-1)
+      switch (c)
+      {
+         case 'h':
+            printf("Usage: trigger_timing [options] data_files\n");
+            printf("-h: print this help\n");
+            printf("-E: use EVIO file format\n");
+            printf("-b: first EVIO bank number for SVT (default 51)\n");
+            printf("-r: number of EVIO SVT banks (default 16)\n");
+            printf("-e: stop after specified number of banks per file\n");
+            printf("-m: inter-trigger time histogram range in us (default 100)\n");
+            printf("-n: inter-trigger time histogram bins (default 100)\n");
+            printf("-w: rate time series bin width in s (default 1)\n");
+            printf("-p: add phase histogram modulo this many 4 ns TI clocks, may be repeated (default 6, 12, 24)\n");
+            printf("-s: read live data from shared memory of this system instead of files\n");
+            printf("-i: shared memory id (default 1)\n");
+            printf("-u: live summary update interval in s (default 5)\n");
+            printf("-o: output file name base\n");
+            printf("Files are processed in parallel, one thread per file. Banks without TI data are counted and skipped.\n");
+            return(0);
+            break;
+         case 'E':
+            evio_format = true;
+            break;
+         case 'b':
+            bank_num = atoi(optarg);
+            break;
+         case 'r':
+            bank_range = atoi(optarg);
+            break;
+         case 'e':
+            num_events = atol(optarg);
+            break;
+         case 'm':
+            diff_max = atof(optarg);
+            break;
+         case 'n':
+            diff_bins = atoi(optarg);
+            break;
+         case 'w':
+            rate_sec = atof(optarg);
+            break;
+         case 'p':
+            if ( period_count < TriggerTiming::MaxPeriods ) periods[period_count++] = atoi(optarg);
+            else printf("Too many periods, ignoring %s\n",optarg);
+            break;
+         case 's':
+            shared_system = optarg;
+            break;
+         case 'i':
+            shared_id = atoi(optarg);
+            break;
+         case 'u':
+            update_sec = atof(optarg);
+            break;
+         case 'o':
+            outname = optarg;
+            break;
+         case '?':
+            printf("Invalid option or missing option argument; -h to list options\n");
+            return(1);
+         default:
+            abort();
+      }
+
+   if ( period_count == 0 ) {
+      periods[period_count++] = 6;
+      periods[period_count++] = 12;
+      periods[period_count++] = 24;
+   }
+
+   // Live mode
+   if ( shared_system != "" ) {
+      DataRead       dataRead;
+      TiTriggerEvent event;
+      TriggerTiming *timing = newTiming(diff_max,diff_bins,rate_sec,periods,period_count);
+      long           banks = 0;
+      long           noTi = 0;
+      time_t         last = time(NULL);
+
+      if ( outname == "" ) outname = "live";
+
+      try {
+         dataRead.openShared(shared_system,shared_id);
+      } catch ( string error ) {
+         cout << error << endl;
+         return(2);
+      }
+      cout << "Reading shared memory for system " << shared_system << endl;
+
+      while ( num_events < 0 || banks < num_events ) {
+         if ( dataRead.next(&event) ) {
+            banks++;
+            if ( event.hasTiData() ) timing->process(&event);
+            else noTi++;
+         }
+         else usleep(1000);
+
+         if ( dataRead.sawRunStart() ) {
+            cout << "Run start, clearing" << endl;
+            timing->clear();
+         }
+         if ( dataRead.sawRunStop() ) {
+            cout << "Run stop" << endl;
+            break;
+         }
+         if ( difftime(time(NULL),last) >= update_sec ) {
+            last = time(NULL);
+            cout << banks << " banks, " << noTi << " without TI data" << endl;
+            writeResults(timing,outname);
+         }
+      }
+      cout << banks << " banks, " << noTi << " without TI data" << endl;
+      writeResults(timing,outname);
+      delete timing;
+      return(0);
+   }
+
+   if ( argc-optind < 1 ) {
+      cout << "Usage: trigger_timing [options] data_files\n";
+      return(1);
+   }
+
+   if ( outname == "" ) {
+      outname = argv[optind];
+      if ( outname.find_last_of('/') != string::npos ) outname.erase(0,outname.find_last_of('/')+1);
+      if ( outname.find_last_of('.') != string::npos ) outname.erase(outname.find_last_of('.'));
+   }
+
+   // One thread and one accumulator per file
+   int        nfiles  = argc-optind;
+   TimingJob *jobs    = new TimingJob[nfiles];
+   pthread_t *threads = new pthread_t[nfiles];
+
+   for (int i=0; i < nfiles; i++) {
+      jobs[i].file      = argv[optind+i];
+      jobs[i].maxEvents = num_events;
+      jobs[i].timing    = newTiming(diff_max,diff_bins,rate_sec,periods,period_count);
+      if ( evio_format ) {
+         DataReadEvio *tmpDataRead = new DataReadEvio();
+         tmpDataRead->set_engrun(true);
+         tmpDataRead->set_bank_num(bank_num);
+         tmpDataRead->set_bank_range(bank_range);
+         jobs[i].dataRead = tmpDataRead;
+      }
+      else jobs[i].dataRead = new DataRead();
+
+      cout << "Reading data file " << jobs[i].file << endl;
+      if ( ! jobs[i].dataRead->open(jobs[i].file) ) return(2);
+   }
+
+   for (int i=0; i < nfiles; i++) {
+      if ( pthread_create(&threads[i],NULL,timingThread,&jobs[i]) != 0 ) {
+         cout << "Failed to start thread for " << jobs[i].file << endl;
+         return(2);
+      }
+   }
+
+   // Merge into the first accumulator
+   for (int i=0; i < nfiles; i++) {
+      pthread_join(threads[i],NULL);
+      jobs[i].dataRead->close();
+      delete jobs[i].dataRead;
+      cout << jobs[i].file << ": " << jobs[i].banks << " banks, " << jobs[i].noTi << " without TI data" << endl;
+      if ( i > 0 ) {
+         jobs[0].timing->merge(jobs[i].timing);
+         delete jobs[i].timing;
+      }
+   }
+
+   writeResults(jobs[0].timing,outname);
+
+   delete jobs[0].timing;
+   delete[] jobs;
+   delete[] threads;
+   return(0);
+}
@@ -23,6 +23,7 @@ for calgroup in `seq 0 7`
 	done
 done
 
+$binpath/meeg_integrity -j0 "${datadir}/${device}_${runnum}_baseline_dtrig.bin" $tpfiles > "${plotsdir}/${device}_${runnum}_integrity.txt" || echo "Integrity check failed, see ${plotsdir}/${device}_${runnum}_integrity.txt"
 $binpath/meeg_valid "${datadir}/${device}_${runnum}_baseline_dtrig.bin" $tpfiles -t1 > "${plotsdir}/${device}_${runnum}_summary.txt"
 
 $binpath/meeg_baseline "${datadir}/${device}_${runnum}_baseline_dtrig.bin" -t1 -o "${plotsdir}/${device}_${runnum}"
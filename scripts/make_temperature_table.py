@@ -0,0 +1,62 @@
+#!/usr/bin/env python
+# Writes tracker/DevboardTemperature.h, the hybrid thermistor ADC to
+# temperature tables used by DevboardEvent::temperature().
+# usage: make_temperature_table.py > tracker/DevboardTemperature.h
+import math
+
+beta = 3750.0
+constA = 0.03448533
+k0 = 273.15
+vmax = 2.5
+vref = 2.5
+vrefNew = 2.048
+rdiv = 10000.0
+minTemp = -50.0
+maxTemp = 150.0
+incTemp = 0.01
+adcCnt = 4096
+
+def make_table(vfull, counts):
+    table = [None] * adcCnt
+    temp = minTemp
+    while temp < maxTemp:
+        tk = k0 + temp
+        res = constA * math.exp(beta / tk)
+        volt = (res * vmax) / (rdiv + res)
+        idx = int((volt / vfull) * counts)
+        if idx < adcCnt:
+            table[idx] = temp
+        temp += incTemp
+    # ADC counts outside the thermistor range read as the nearest end of the range
+    filled = [i for i in range(adcCnt) if table[i] is not None]
+    for i in range(0, filled[0]):
+        table[i] = table[filled[0]]
+    for i in range(filled[-1] + 1, adcCnt):
+        table[i] = table[filled[-1]]
+    return table
+
+def print_table(name, comment, table):
+    print "// %s" % comment
+    print "static const double %s[%d] = {" % (name, adcCnt)
+    for i in range(0, adcCnt, 8):
+        line = ",".join("%7.2f" % t for t in table[i:i + 8])
+        print "   " + line + ("," if i + 8 < adcCnt else "")
+    print "};"
+    print ""
+
+print "//-----------------------------------------------------------------------------"
+print "// File          : DevboardTemperature.h"
+print "// Project       : Heavy Photon API"
+print "//-----------------------------------------------------------------------------"
+print "// Description :"
+print "// Hybrid thermistor ADC count to temperature (C) tables."
+print "// Generated by scripts/make_temperature_table.py, do not edit."
+print "//-----------------------------------------------------------------------------"
+print "#ifndef __DEVBOARD_TEMPERATURE_H__"
+print "#define __DEVBOARD_TEMPERATURE_H__"
+print ""
+print_table("devboardTempTable", "Old hybrids, 12 bit ADC with a %g V reference" % vref,
+            make_table(vref, adcCnt - 1))
+print_table("devboardTempTableNew", "New hybrids, 12 bit ADC with a %g V reference" % vrefNew,
+            make_table(vrefNew, adcCnt))
+print "#endif"
@@ -23,4 +23,5 @@ python $scriptpath/run_cal.py -t1 -c3 "${datadir}/${device}_${runnum}"
 
 #$binpath/meeg_baseline "${datadir}/${device}_${runnum}_baseline_dtrig.bin" -t1 -m -o "${plotsdir}/${device}_${runnum}_mux"
 
-#$binpath/meeg_tp "${datadir}/${device}_${runnum}_cal_g?_d?.bin" -t1 -fr -s20 -o "${plotsdir}/${device}_${runnum}"
+#$binpath/meeg_tp "${datadir}/${device}_${runnum}_cal_g?_d?.bin" -t1 -fDr -s20 -o "${plotsdir}/${device}_${runnum}"
+#$binpath/meeg_render -j0 -m "*_tp_fit_*_0.png" "${plotsdir}/${device}_${runnum}.plots"
@@ -0,0 +1,74 @@
+//-----------------------------------------------------------------------------
+// File          : test_baseline_file.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// BaselineFile on both .base layouts: lines with rce, feb, hybrid and channel
+// (meeg_all_baseline) and lines with the channel only (meeg_baseline).
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <stdio.h>
+#include <unistd.h>
+#include <BaselineFile.h>
+using namespace std;
+
+static int failures = 0;
+
+static void check ( bool ok, const char *what ) {
+   if ( ! ok ) {
+      printf("FAIL: %s\n",what);
+      failures++;
+   }
+}
+
+int main ( int argc, char **argv ) {
+   BaselineFile    base;
+   BaselineChannel channel;
+   char            name[] = "/tmp/test_baseline_fileXXXXXX";
+   int             fd;
+
+   if ( (fd = mkstemp(name)) < 0 ) {
+      printf("FAIL: temporary file\n");
+      return(1);
+   }
+   close(fd);
+
+   ofstream out(name);
+   out << "# rce feb hybrid channel mean sigma ...\n";
+   out << "2 5 1 17";
+   for (uint i=0; i < BaselineValues; i++) out << " " << 1000+i << " " << 10+i;
+   out << "\n\n";
+   out << "42";
+   for (uint i=0; i < BaselineValues; i++) out << " " << 2000+i << " " << 20+i;
+   out << "\n";
+   out << "43 1 2 3\n";
+   out.close();
+
+   check(base.open(name),"open");
+
+   check(base.next(&channel),"address line read");
+   check(channel.rce == 2 && channel.feb == 5 && channel.hybrid == 1 && channel.channel == 17,"address line address");
+   check(channel.mean[0] == 1000 && channel.sigma[6] == 16,"address line values");
+
+   check(base.next(&channel),"channel line read");
+   check(channel.rce == 0 && channel.feb == 0 && channel.hybrid == 0 && channel.channel == 42,"channel line address");
+   check(channel.mean[6] == 2006 && channel.sigma[0] == 20,"channel line values");
+
+   check(! base.next(&channel),"short line skipped, end of file");
+   base.close();
+   unlink(name);
+
+   check(! base.open("/nonexistent/file.base"),"missing file");
+
+   if ( failures == 0 ) printf("test_baseline_file: OK\n");
+   return(failures == 0 ? 0 : 1);
+}
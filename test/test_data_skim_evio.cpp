@@ -0,0 +1,128 @@
+//-----------------------------------------------------------------------------
+// File          : test_data_skim_evio.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// DataSkim EVIO outputs: DevboardEvent and TriggerEvent frames and a config
+// record are skimmed to EVIO files through DataWriteEvio and must read back
+// unchanged through DataReadEvio.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <iostream>
+#include <string>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <Data.h>
+#include <DataReadEvio.h>
+#include <DataSkim.h>
+#include <DevboardEvent.h>
+#include <TiTriggerEvent.h>
+using namespace std;
+
+static int failures = 0;
+
+static void check ( bool ok, const char *what ) {
+   if ( ! ok ) {
+      printf("FAIL: %s\n",what);
+      failures++;
+   }
+}
+
+// True if a frame holds the given words
+static bool same ( Data *frame, const uint *data, uint size ) {
+   return(frame->size() == size && memcmp(frame->data(),data,size * sizeof(uint)) == 0);
+}
+
+// DevboardEvent frames, data and TI frame, in ROC bank 3
+static void devboard ( string base ) {
+   DataSkim       skim;
+   DataReadEvio   in;
+   DevboardEvent  event;
+   uint           data[14];
+   uint           ti[5] = {0x80000007,1,2,3,4};
+   string         xml = "<config><Mode>skim</Mode></config>";
+   string         got;
+   uint           type;
+
+   for (uint i=0; i < 14; i++) data[i] = 0x100 + i;
+   data[0] = 2;
+
+   skim.setEvio(true,3);
+   check(skim.open(base),"devboard open");
+   skim.xml(Data::XmlConfig,xml);
+   event.copy(data,14);
+   skim.process(&event);
+   event.copy(ti,5);
+   skim.process(&event);
+   check(skim.close(),"devboard close");
+   check(skim.kept() == 2,"devboard frames kept");
+
+   in.setKeepXml(true);
+   check(in.open(base + ".skim.evio"),"devboard read open");
+   check(in.next(&event) && same(&event,data,14),"data frame read back");
+   check(in.last_bank_tag() == 3,"data frame ROC bank");
+   check(in.takeXml(type,got) && type == Data::XmlConfig && got == xml,"config record read back");
+   check(in.next(&event) && same(&event,ti,5) && event.isTiFrame(),"TI frame read back");
+   check(! in.next(&event),"devboard end of file");
+   in.close();
+   unlink((base + ".skim.evio").c_str());
+}
+
+// TriggerEvent frames with and without TI data, in ROC bank 52
+static void trigger ( string base ) {
+   DataSkim       skim;
+   DataReadEvio   in;
+   TiTriggerEvent event;
+   uint           data[14];
+   uint           noTi[14];
+
+   // Header, 2 samples, tail, TI words
+   for (uint i=0; i < 14; i++) data[i] = 0x200 + i;
+   memcpy(noTi,data,sizeof(data));
+   for (uint i=10; i < 14; i++) noTi[i] = 0xFFFFFFFF;
+
+   skim.setEvio(true,51);
+   check(skim.open(base),"trigger open");
+   skim.setBank(52);
+   event.copy(data,14);
+   skim.process(&event);
+   event.copy(noTi,14);
+   skim.process(&event);
+   check(skim.close(),"trigger close");
+
+   in.set_engrun(true);
+   check(in.open(base + ".skim.evio"),"trigger read open");
+   check(in.next(&event) && same(&event,data,14) && event.hasTiData(),"frame with TI data read back");
+   check(in.last_bank_tag() == 52,"trigger ROC bank");
+   check(in.next(&event) && same(&event,noTi,14) && ! event.hasTiData(),"frame without TI data read back");
+   check(! in.next(&event),"trigger end of file");
+   in.close();
+   unlink((base + ".skim.evio").c_str());
+}
+
+int main ( int argc, char **argv ) {
+   char     dir[] = "/tmp/test_data_skim_evioXXXXXX";
+   DataSkim skim;
+
+   if ( mkdtemp(dir) == NULL ) {
+      printf("FAIL: temporary directory\n");
+      return(1);
+   }
+   devboard(string(dir) + "/devboard");
+   trigger(string(dir) + "/trigger");
+
+   skim.setEvio(true);
+   check(! skim.open(string(dir) + "/compressed",true),"compressed EVIO output refused");
+   rmdir(dir);
+
+   if ( failures == 0 ) printf("test_data_skim_evio: OK\n");
+   return(failures == 0 ? 0 : 1);
+}
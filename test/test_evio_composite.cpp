@@ -0,0 +1,141 @@
+//-----------------------------------------------------------------------------
+// File          : test_evio_composite.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// EvioComposite round trip: an FADC style composite payload with the format
+// "c,i,l,N(c,Ns)", whose group count is taken from the data (eviofmt code
+// 15), is built in both byte orders and decoded back column by column.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <EvioComposite.h>
+using namespace std;
+
+static int failures = 0;
+
+static void check ( bool ok, const char *what ) {
+   if ( ! ok ) {
+      printf("FAIL: %s\n",what);
+      failures++;
+   }
+}
+
+// Append a value of size bytes, in the other byte order if swapped
+static void put ( vector<unsigned char> &data, uint64_t value, uint size, bool swapped ) {
+   unsigned char bytes[8];
+
+   memcpy(bytes,&value,size);
+   for (uint i=0; i < size; i++) data.push_back(bytes[swapped ? size - 1 - i : i]);
+}
+
+// Header word, in the other byte order if swapped
+static uint word ( uint value, bool swapped ) {
+   if ( ! swapped ) return(value);
+   return(((value & 0xff) << 24) | ((value & 0xff00) << 8) | ((value >> 8) & 0xff00) | (value >> 24));
+}
+
+// Build the payload: format tagsegment, then the data bank
+static void build ( vector<uint> &buf, bool swapped ) {
+   const char            *format = "c,i,l,N(c,Ns)";
+   vector<unsigned char> data;
+   uint                  fmtWords;
+   uint                  padding;
+
+   // Slot 3: two channels, of 3 and 1 samples
+   put(data,3,1,swapped);
+   put(data,100,4,swapped);
+   put(data,123456789012ULL,8,swapped);
+   put(data,2,4,swapped);
+   put(data,0,1,swapped);
+   put(data,3,4,swapped);
+   put(data,10,2,swapped);
+   put(data,11,2,swapped);
+   put(data,12,2,swapped);
+   put(data,1,1,swapped);
+   put(data,1,4,swapped);
+   put(data,20,2,swapped);
+
+   // Slot 4: no channels
+   put(data,4,1,swapped);
+   put(data,101,4,swapped);
+   put(data,5,8,swapped);
+   put(data,0,4,swapped);
+
+   padding = (4 - data.size() % 4) % 4;
+   data.resize(data.size() + padding,0);
+
+   fmtWords = (strlen(format) + 1 + 3) / 4;
+   buf.assign(1 + fmtWords + 2 + data.size() / 4,0);
+   buf[0] = word((6 << 16) | fmtWords,swapped);
+   memset(&buf[1],4,fmtWords * 4);
+   memcpy(&buf[1],format,strlen(format));
+   buf[1+fmtWords] = word(1 + data.size() / 4,swapped);
+   buf[2+fmtWords] = word((0xe101 << 16) | (padding << 14) | (0xb << 8) | 7,swapped);
+   memcpy(&buf[3+fmtWords],&data[0],data.size());
+}
+
+static void run ( bool swapped ) {
+   EvioComposite          composite;
+   EvioComposite::Column  *col;
+   vector<uint>           buf;
+
+   build(buf,swapped);
+   check(composite.decode(&buf[0],buf.size(),swapped),"payload decoded");
+   check(composite.format() == "c,i,l,N(c,Ns)","format");
+   check(composite.tag() == 0xe101 && composite.num() == 7,"data bank tag and num");
+   check(composite.columns() == 7,"seven columns");
+   if ( composite.columns() != 7 ) return;
+
+   col = composite.column(0);
+   check(col->type == 'c' && col->count == 2 && col->values<char>()[0] == 3 && col->values<char>()[1] == 4,"slots");
+
+   col = composite.column(1);
+   check(col->type == 'i' && col->count == 2 && col->values<int32_t>()[0] == 100 && col->values<int32_t>()[1] == 101,"triggers");
+
+   col = composite.column(2);
+   check(col->type == 'l' && col->count == 2 && col->values<int64_t>()[0] == 123456789012LL && col->values<int64_t>()[1] == 5,"times");
+
+   // Group count from the data, one per slot
+   col = composite.column(3);
+   check(col->type == 'N' && col->count == 2 && col->values<int32_t>()[0] == 2 && col->values<int32_t>()[1] == 0,"channel counts");
+
+   col = composite.column(4);
+   check(col->type == 'c' && col->count == 2 && col->values<char>()[0] == 0 && col->values<char>()[1] == 1,"channels");
+
+   col = composite.column(5);
+   check(col->type == 'N' && col->count == 2 && col->values<int32_t>()[0] == 3 && col->values<int32_t>()[1] == 1,"sample counts");
+
+   col = composite.column(6);
+   check(col->type == 's' && col->count == 4,"sample count");
+   if ( col->count == 4 ) {
+      const int16_t *s = col->values<int16_t>();
+      check(s[0] == 10 && s[1] == 11 && s[2] == 12 && s[3] == 20,"samples");
+   }
+
+   // Data ending inside the channel count of slot 3 (bytes 13 to 16)
+   check(! composite.decode("c,i,l,N(c,Ns)",&buf[1+4+2],15,swapped),"truncated count rejected");
+
+   // Payload shorter than its data bank
+   buf.resize(buf.size() - 1);
+   check(! composite.decode(&buf[0],buf.size(),swapped),"truncated payload rejected");
+}
+
+int main ( int argc, char **argv ) {
+   run(false);
+   run(true);
+
+   if ( failures == 0 ) printf("test_evio_composite: OK\n");
+   return(failures == 0 ? 0 : 1);
+}
@@ -0,0 +1,94 @@
+//-----------------------------------------------------------------------------
+// File          : test_telemetry.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Telemetry of TriggerEvent frames from two ROC banks, interleaved as
+// DataReadEvio returns them: the sequence counters of the banks are kept
+// apart, a 24 bit counter wrapping around is not a gap, and the TI data of
+// both banks goes to the one TI source.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <iostream>
+#include <string>
+#include <stdio.h>
+#include <unistd.h>
+#include <TiTriggerEvent.h>
+#include <Telemetry.h>
+using namespace std;
+
+static int failures = 0;
+
+static void check ( bool ok, const char *what ) {
+   if ( ! ok ) {
+      printf("FAIL: %s\n",what);
+      failures++;
+   }
+}
+
+// Frame of header, tail and TI words
+static void fill ( TiTriggerEvent *event, uint sequence, uint ti ) {
+   uint data[6];
+
+   data[0] = sequence;
+   data[1] = 0;
+   data[2] = ti;
+   data[3] = ti;
+   data[4] = 1000 + ti;
+   data[5] = 0;
+   event->copy(data,6);
+}
+
+// Frames and sequence gaps of a source id
+static bool counts ( Telemetry &telemetry, uint id, uint64_t &frames, uint64_t &gaps ) {
+   for (uint x=0; x < telemetry.sources(); x++) {
+      if ( telemetry.sourceId(x) != id ) continue;
+      telemetry.sourceCounts(x,frames,gaps);
+      return(true);
+   }
+   return(false);
+}
+
+int main ( int argc, char **argv ) {
+   Telemetry      telemetry;
+   TiTriggerEvent event;
+   char           name[] = "/tmp/test_telemetryXXXXXX";
+   uint64_t       frames;
+   uint64_t       gaps;
+   int            fd;
+
+   if ( (fd = mkstemp(name)) < 0 ) {
+      printf("FAIL: temporary file\n");
+      return(1);
+   }
+   close(fd);
+   check(telemetry.open(name,10),"open");
+
+   // Bank 51 wraps from 0xFFFFFE, bank 52 counts from 100 and misses 102
+   uint seq51[4] = {0xFFFFFE,0xFFFFFF,0,1};
+   uint seq52[4] = {100,101,103,104};
+   for (uint i=0; i < 4; i++) {
+      fill(&event,seq51[i],i+1);
+      telemetry.add(&event,i,51);
+      fill(&event,seq52[i],i+1);
+      telemetry.add(&event,i,52);
+   }
+
+   check(counts(telemetry,TelemetryRocSource + 51,frames,gaps) && frames == 4 && gaps == 0,"bank 51 wraps without gaps");
+   check(counts(telemetry,TelemetryRocSource + 52,frames,gaps) && frames == 4 && gaps == 1,"bank 52 has one gap");
+   check(counts(telemetry,TelemetryTiSource,frames,gaps) && frames == 8 && gaps == 0,"TI source has the frames of both banks");
+   check(telemetry.sources() == 3,"three sources");
+
+   check(telemetry.close(),"close");
+   check(telemetry.records() == 3,"one record per source");
+   unlink(name);
+
+   if ( failures == 0 ) printf("test_telemetry: OK\n");
+   return(failures == 0 ? 0 : 1);
+}
@@ -0,0 +1,171 @@
+//-----------------------------------------------------------------------------
+// File          : test_threshold_emulator.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// ThresholdEmulator: readouts whose APV or channel is out of range must be
+// counted as invalid and never reach the per channel counters; thresholds
+// are taken with the .thresholds channel numbering, (4-apv)*128+channel; the
+// N-of-6 cut keeps a readout from N samples above threshold on, not N-1; and
+// a frame cut 8 readouts at a time (SSE2) gives the same result as the same
+// readouts cut one at a time by the scalar loop.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <fstream>
+#include <stdio.h>
+#include <unistd.h>
+#include <ThresholdEmulator.h>
+using namespace std;
+
+static int failures = 0;
+
+static void check ( bool ok, const char *what ) {
+   if ( ! ok ) {
+      printf("FAIL: %s\n",what);
+      failures++;
+   }
+}
+
+// Thresholds of FEB 2, hybrid 1, by APV and APV channel
+static const uint Apv[3]       = { 0, 0, 4 };
+static const uint Channel[3]   = { 0, 1, 0 };
+static const int  Threshold[3] = { 100, 200, 50 };
+
+// Samples of test readout k: around the threshold of its channel, 0 to 6 of them above
+static void sampleValues ( uint k, uint *values ) {
+   int thr = Threshold[k % 3];
+   for (uint y=0; y < 6; y++) values[y] = thr + (((k * 7 + y * 3) % 5) < (k % 4) ? 1 : 0);
+}
+
+// Reference N-of-6 cut
+static bool expected ( uint k, uint minSamples ) {
+   uint values[6];
+   uint above = 0;
+
+   sampleValues(k,values);
+   for (uint y=0; y < 6; y++) if ( (int)values[y] > Threshold[k % 3] ) above++;
+   return(above >= minSamples);
+}
+
+// Thresholds, cuts and the SSE2 and scalar paths
+static void cuts ( ) {
+   ThresholdEmulator emulator;
+   char              name[] = "/tmp/test_threshold_emulatorXXXXXX";
+   uint              values[6];
+   uint              index[19];
+   bool              block[19];
+   int               fd;
+
+   if ( (fd = mkstemp(name)) < 0 ) {
+      check(false,"temporary file");
+      return;
+   }
+   close(fd);
+   ofstream out(name);
+   out << "% feb,hyb,apv then channel,threshold\n";
+   for (uint a=0; a < 3; a++) {
+      out << "2,1," << Apv[a] << "\n";
+      out << (4 - Apv[a]) * 128 + Channel[a] << "," << Threshold[a] << ".5\n";
+   }
+   out.close();
+   check(emulator.loadThresholds(name),"thresholds loaded");
+   unlink(name);
+   emulator.setMinSamples(3);
+
+   // Per channel thresholds: 150 passes channel 512 (100) and 0 (50) but not 513 (200);
+   // 75 passes only channel 0, i.e. APV 4 channel 0, not APV 0 channel 0
+   emulator.begin();
+   for (uint y=0; y < 6; y++) values[y] = 150;
+   index[0] = emulator.add(0,2,1,0,0,values);
+   index[1] = emulator.add(0,2,1,0,1,values);
+   index[2] = emulator.add(0,2,1,4,0,values);
+   for (uint y=0; y < 6; y++) values[y] = 75;
+   index[3] = emulator.add(0,2,1,0,0,values);
+   index[4] = emulator.add(0,2,1,4,0,values);
+   emulator.process();
+   check(emulator.keep(index[0]) && ! emulator.keep(index[1]) && emulator.keep(index[2]),"thresholds by channel at 150");
+   check(! emulator.keep(index[3]) && emulator.keep(index[4]),"APV 4 channel 0 is .thresholds channel 0");
+   check(emulator.unknown() == 0,"all channels have a threshold");
+
+   // N-of-6 boundary, at 3 samples: 2 above rejected, 3 above kept, equal to the threshold is not above
+   emulator.begin();
+   uint two[6]   = {101,101,0,0,0,0};
+   uint three[6] = {101,101,101,100,100,100};
+   uint equal[6] = {101,101,100,100,100,100};
+   index[0] = emulator.add(0,2,1,0,0,two);
+   index[1] = emulator.add(0,2,1,0,0,three);
+   index[2] = emulator.add(0,2,1,0,0,equal);
+   emulator.process();
+   check(! emulator.keep(index[0]),"N-1 samples above threshold rejected");
+   check(emulator.keep(index[1]),"N samples above threshold kept");
+   check(! emulator.keep(index[2]),"sample equal to the threshold not above it");
+
+   // A frame of 19 readouts, two blocks of 8 then 3 for the scalar loop,
+   // against the same readouts one per frame, all scalar
+   emulator.begin();
+   for (uint k=0; k < 19; k++) {
+      sampleValues(k,values);
+      index[k] = emulator.add(0,2,1,Apv[k % 3],Channel[k % 3],values);
+   }
+   emulator.process();
+   uint kept = 0;
+   for (uint k=0; k < 19; k++) {
+      block[k] = emulator.keep(index[k]);
+      if ( block[k] ) kept++;
+      check(block[k] == expected(k,3),"frame cut matches the reference");
+   }
+   check(kept > 0 && kept < 19,"frame has kept and dropped readouts");
+   for (uint k=0; k < 19; k++) {
+      emulator.begin();
+      sampleValues(k,values);
+      uint single = emulator.add(0,2,1,Apv[k % 3],Channel[k % 3],values);
+      emulator.process();
+      check(emulator.keep(single) == block[k],"scalar cut matches the frame cut");
+   }
+}
+
+int main ( int argc, char **argv ) {
+   ThresholdEmulator emulator;
+   ostringstream     report;
+   string            line;
+   uint              values[6] = {1000,1000,1000,1000,1000,1000};
+   uint              lines = 0;
+   uint              good;
+   uint              badApv;
+   uint              badChannel;
+
+   emulator.begin();
+   good       = emulator.add(0,2,1,4,0,values);
+   badApv     = emulator.add(0,2,1,5,3,values);
+   badChannel = emulator.add(0,2,1,0,128,values);
+   emulator.process();
+
+   check(emulator.readouts() == 3,"all readouts counted");
+   check(emulator.invalid() == 2,"apv 5 and channel 128 counted as invalid");
+   check(emulator.unknown() == 1,"valid readout without threshold counted as unknown");
+   check(emulator.keep(good) && emulator.keep(badApv) && emulator.keep(badChannel),"readouts without threshold kept");
+
+   // Only the valid readout shows up in the per channel report, as channel (4-4)*128+0
+   emulator.report(report);
+   istringstream in(report.str());
+   while ( getline(in,line) ) {
+      if ( line.empty() || line[0] == '#' ) continue;
+      lines++;
+      check(line.compare(0,8,"0\t2\t1\t0\t") == 0,"report line is the valid channel");
+   }
+   check(lines == 1,"one report line");
+
+   cuts();
+
+   if ( failures == 0 ) printf("test_threshold_emulator: OK\n");
+   return(failures == 0 ? 0 : 1);
+}
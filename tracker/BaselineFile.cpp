@@ -0,0 +1,67 @@
+//-----------------------------------------------------------------------------
+// File          : BaselineFile.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Reader of .base pedestal files.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <sstream>
+#include "BaselineFile.h"
+using namespace std;
+
+// Columns of a line with the channel only, and with the full address
+#define BASELINE_CHANNEL_COLUMNS (1 + 2 * BaselineValues)
+#define BASELINE_ADDRESS_COLUMNS (4 + 2 * BaselineValues)
+
+// Constructor
+BaselineFile::BaselineFile ( ) { }
+
+// Open a .base file
+bool BaselineFile::open ( string file ) {
+   close();
+   in_.clear();
+   in_.open(file.c_str());
+   return(in_.is_open());
+}
+
+// Read the next channel
+bool BaselineFile::next ( BaselineChannel *channel ) {
+   string line;
+   string word;
+   uint   columns;
+   uint   i;
+
+   while ( getline(in_,line) ) {
+      if ( line.empty() || line[0] == '#' ) continue;
+
+      columns = 0;
+      istringstream count(line);
+      while ( count >> word ) columns++;
+      if ( columns < BASELINE_CHANNEL_COLUMNS ) continue;
+
+      istringstream row(line);
+      channel->rce    = 0;
+      channel->feb    = 0;
+      channel->hybrid = 0;
+      if ( columns >= BASELINE_ADDRESS_COLUMNS ) {
+         if ( ! (row >> channel->rce >> channel->feb >> channel->hybrid) ) continue;
+      }
+      if ( ! (row >> channel->channel) ) continue;
+      for (i=0; i < BaselineValues; i++)
+         if ( ! (row >> channel->mean[i] >> channel->sigma[i]) ) break;
+      if ( i == BaselineValues ) return(true);
+   }
+   return(false);
+}
+
+// Close the file
+void BaselineFile::close ( ) {
+   if ( in_.is_open() ) in_.close();
+}
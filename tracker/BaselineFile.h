@@ -0,0 +1,69 @@
+//-----------------------------------------------------------------------------
+// File          : BaselineFile.h
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Reader of .base pedestal files.
+//
+// A line holds the channel address, then the mean and sigma of each of the
+// 6 samples and of all samples. meeg_all_baseline writes the address as
+// rce, feb, hybrid and channel; meeg_baseline calibrates one hybrid and
+// writes the channel only, which reads as rce, feb and hybrid 0. The layout
+// is told from the number of columns of each line. Lines starting with #,
+// and lines with fewer columns, are skipped.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#ifndef __BASELINE_FILE_H__
+#define __BASELINE_FILE_H__
+
+#include <string>
+#include <fstream>
+#include <sys/types.h>
+using namespace std;
+
+//! Mean and sigma pairs of a .base line, the 6 samples then all samples
+#define BaselineValues 7
+
+//! One channel of a .base file
+struct BaselineChannel {
+   uint   rce;
+   uint   feb;
+   uint   hybrid;
+   uint   channel;
+   double mean[BaselineValues];    //!< Pedestal of each sample, then of all samples
+   double sigma[BaselineValues];   //!< Noise of each sample, then of all samples
+};
+
+//! Reader of .base files
+class BaselineFile {
+
+      ifstream in_;
+
+   public:
+
+      //! Constructor
+      BaselineFile ( );
+
+      //! Open a .base file, returns false if it can not be read
+      /*!
+       * \param file File name
+      */
+      bool open ( string file );
+
+      //! Read the next channel, returns false at the end of the file
+      /*!
+       * \param channel Channel to fill
+      */
+      bool next ( BaselineChannel *channel );
+
+      //! Close the file
+      void close ( );
+};
+
+#endif
@@ -0,0 +1,407 @@
+//-----------------------------------------------------------------------------
+// File          : CalMonitor.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Incremental calibration monitor for live data.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <math.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <iostream>
+#include "CalMonitor.h"
+using namespace std;
+
+// Rescale the sums when the sample weight passes this
+#define CAL_MONITOR_RESCALE 1e30
+
+// Constructor
+CalMonitorFile::CalMonitorFile ( ) {
+   fd_      = -1;
+   map_     = NULL;
+   size_    = 0;
+   writer_  = false;
+   header_  = NULL;
+   hybrids_ = NULL;
+}
+
+// Deconstructor
+CalMonitorFile::~CalMonitorFile ( ) {
+   close();
+}
+
+// Create the file for writing
+bool CalMonitorFile::create ( string file, uint maxHybrids ) {
+   close();
+
+   size_ = sizeof(CalMonitorHeader) + maxHybrids * sizeof(CalMonitorHybrid);
+   if ( (fd_ = ::open(file.c_str(),O_RDWR | O_CREAT | O_TRUNC,0644)) < 0 ) {
+      cout << "CalMonitorFile::create -> Failed to open file: " << file << endl;
+      return(false);
+   }
+   if ( ftruncate(fd_,size_) != 0 ||
+        (map_ = mmap(NULL,size_,PROT_READ | PROT_WRITE,MAP_SHARED,fd_,0)) == MAP_FAILED ) {
+      cout << "CalMonitorFile::create -> Failed to map file: " << file << endl;
+      map_ = NULL;
+      close();
+      return(false);
+   }
+   writer_  = true;
+   header_  = (CalMonitorHeader *)map_;
+   hybrids_ = (CalMonitorHybrid *)((char *)map_ + sizeof(CalMonitorHeader));
+
+   // The magic goes in last, readers ignore the file until then
+   header_->version    = CalMonitorVersion;
+   header_->sequence   = 0;
+   header_->hybrids    = 0;
+   header_->maxHybrids = maxHybrids;
+   __sync_synchronize();
+   header_->magic      = CalMonitorMagic;
+   return(true);
+}
+
+// Attach to an existing file
+bool CalMonitorFile::attach ( string file ) {
+   struct stat st;
+   CalMonitorHeader *header;
+
+   close();
+
+   if ( (fd_ = ::open(file.c_str(),O_RDONLY)) < 0 ) return(false);
+   if ( fstat(fd_,&st) != 0 || st.st_size < (off_t)sizeof(CalMonitorHeader) ) {
+      close();
+      return(false);
+   }
+   size_ = st.st_size;
+   if ( (map_ = mmap(NULL,size_,PROT_READ,MAP_SHARED,fd_,0)) == MAP_FAILED ) {
+      map_ = NULL;
+      close();
+      return(false);
+   }
+   header = (CalMonitorHeader *)map_;
+   if ( header->magic != CalMonitorMagic || header->version != CalMonitorVersion ||
+        size_ < sizeof(CalMonitorHeader) + header->maxHybrids * sizeof(CalMonitorHybrid) ) {
+      close();
+      return(false);
+   }
+   writer_  = false;
+   header_  = header;
+   hybrids_ = (CalMonitorHybrid *)((char *)map_ + sizeof(CalMonitorHeader));
+   return(true);
+}
+
+// Unmap and close
+void CalMonitorFile::close ( ) {
+   if ( map_ != NULL ) munmap(map_,size_);
+   if ( fd_ >= 0 ) ::close(fd_);
+   fd_      = -1;
+   map_     = NULL;
+   header_  = NULL;
+   hybrids_ = NULL;
+   writer_  = false;
+}
+
+// Start writing a snapshot
+CalMonitorHybrid *CalMonitorFile::begin ( ) {
+   if ( ! writer_ ) return(NULL);
+   header_->sequence++;
+   __sync_synchronize();
+   return(hybrids_);
+}
+
+// Finish writing a snapshot
+void CalMonitorFile::end ( uint hybrids, double time, double tau, double frames, double rate ) {
+   if ( ! writer_ ) return;
+   header_->hybrids = hybrids;
+   header_->time    = time;
+   header_->tau     = tau;
+   header_->frames  = frames;
+   header_->rate    = rate;
+   __sync_synchronize();
+   header_->sequence++;
+}
+
+// Copy a consistent snapshot
+bool CalMonitorFile::snapshot ( CalMonitorHeader &header, vector<CalMonitorHybrid> &hybrids ) {
+   uint seq;
+
+   if ( header_ == NULL ) return(false);
+
+   for (uint tries=0; tries < 1000; tries++) {
+      seq = header_->sequence;
+      if ( seq == 0 ) return(false);
+      if ( seq & 0x1 ) {
+         usleep(100);
+         continue;
+      }
+      __sync_synchronize();
+      memcpy(&header,header_,sizeof(CalMonitorHeader));
+      if ( header.hybrids > header.maxHybrids ) continue;
+      hybrids.resize(header.hybrids);
+      if ( header.hybrids > 0 ) memcpy(&hybrids[0],hybrids_,header.hybrids * sizeof(CalMonitorHybrid));
+      __sync_synchronize();
+      if ( header_->sequence == seq ) return(true);
+   }
+   return(false);
+}
+
+// Key from rce, feb and hybrid
+uint CalMonitor::key ( uint rce, uint feb, uint hyb ) {
+   return(((rce & 0xFF) << 10) | ((feb & 0xFF) << 2) | (hyb & 0x3));
+}
+
+// Constructor
+CalMonitor::CalMonitor ( double tau, uint maxHybrids ) {
+   tau_          = tau > 0 ? tau : 10.0;
+   maxHybrids_   = maxHybrids;
+   hitSigma_     = 5.0;
+   minSamples_   = 30.0;
+   deadFraction_ = 0.3;
+   noisyFactor_  = 2.0;
+   errorLimit_   = 0.001;
+   index_.resize(1 << 18,-1);
+   t0_           = -1;
+   clear();
+}
+
+// Deconstructor
+CalMonitor::~CalMonitor ( ) {
+   for (uint i=0; i < hybrids_.size(); i++) delete hybrids_[i];
+}
+
+// Hit cut
+void CalMonitor::setHitSigma ( double sigma ) {
+   hitSigma_ = sigma;
+}
+
+// Flag limits
+void CalMonitor::setLimits ( double deadFraction, double noisyFactor, double errorLimit ) {
+   deadFraction_ = deadFraction;
+   noisyFactor_  = noisyFactor;
+   errorLimit_   = errorLimit;
+}
+
+// Clear all sums
+void CalMonitor::clear ( ) {
+   for (uint i=0; i < hybrids_.size(); i++) {
+      index_[key(hybrids_[i]->rce,hybrids_[i]->feb,hybrids_[i]->hyb)] = -1;
+      delete hybrids_[i];
+   }
+   hybrids_.clear();
+   t0_          = -1;
+   weight_      = 1.0;
+   totalFrames_ = 0;
+   frames_      = 0;
+}
+
+// Hybrid for a key
+CalMonitor::Hybrid *CalMonitor::hybrid ( uint rce, uint feb, uint hyb ) {
+   uint   k = key(rce,feb,hyb);
+   Hybrid *h;
+
+   if ( index_[k] >= 0 ) return(hybrids_[index_[k]]);
+   if ( hybrids_.size() >= maxHybrids_ ) return(NULL);
+
+   h = new Hybrid;
+   memset(h,0,sizeof(Hybrid));
+   h->rce = rce;
+   h->feb = feb;
+   h->hyb = hyb;
+   index_[k] = hybrids_.size();
+   hybrids_.push_back(h);
+   return(h);
+}
+
+// Rescale all sums
+void CalMonitor::rescale ( double factor ) {
+   Hybrid *h;
+
+   frames_ *= factor;
+   for (uint i=0; i < hybrids_.size(); i++) {
+      h = hybrids_[i];
+      h->events *= factor;
+      for (uint a=0; a < Apvs; a++) {
+         h->apvReadouts[a] *= factor;
+         h->apvErrors[a]   *= factor;
+      }
+      for (uint c=0; c < Channels; c++) {
+         h->channels[c].weight   *= factor;
+         h->channels[c].m2       *= factor;
+         h->channels[c].readouts *= factor;
+         h->channels[c].hits     *= factor;
+      }
+   }
+}
+
+// Start a frame
+void CalMonitor::beginFrame ( double time ) {
+   if ( t0_ < 0 ) t0_ = time;
+   weight_ = exp((time - t0_) / tau_);
+
+   // Move the reference time up, this keeps the ratios of all sums
+   if ( weight_ > CAL_MONITOR_RESCALE ) {
+      rescale(1.0 / weight_);
+      t0_     = time;
+      weight_ = 1.0;
+   }
+
+   for (uint i=0; i < hybrids_.size(); i++) hybrids_[i]->seen = false;
+   totalFrames_++;
+   frames_ += weight_;
+}
+
+// Mark a hybrid as present
+void CalMonitor::seen ( uint rce, uint feb, uint hyb ) {
+   Hybrid *h = hybrid(rce,feb,hyb);
+   if ( h != NULL ) h->seen = true;
+}
+
+// Add a readout
+void CalMonitor::add ( uint rce, uint feb, uint hyb, uint apv, uint channel, uint *values, bool error ) {
+   Hybrid  *h;
+   Channel *ch;
+   double  delta;
+   double  peak;
+   double  sigma;
+
+   if ( apv >= Apvs || channel >= 128 ) return;
+   if ( (h = hybrid(rce,feb,hyb)) == NULL ) return;
+   h->seen = true;
+
+   h->apvReadouts[apv] += weight_;
+   if ( error ) h->apvErrors[apv] += weight_;
+
+   ch = &(h->channels[(4-apv)*128+channel]);
+   ch->readouts += weight_;
+
+   // Hits stay out of the pedestal once the channel has an estimate
+   if ( ch->weight / weight_ >= minSamples_ ) {
+      sigma = sqrt(ch->m2 / ch->weight);
+      peak  = values[0];
+      for (uint y=1; y < 6; y++) if ( values[y] > peak ) peak = values[y];
+      if ( peak - ch->mean > hitSigma_ * sigma ) {
+         ch->hits += weight_;
+         return;
+      }
+   }
+
+   // Weighted Welford update, all samples have the frame weight
+   for (uint y=0; y < 6; y++) {
+      ch->weight += weight_;
+      delta       = values[y] - ch->mean;
+      ch->mean   += delta * weight_ / ch->weight;
+      ch->m2     += weight_ * delta * (values[y] - ch->mean);
+   }
+}
+
+// Finish the current frame
+void CalMonitor::endFrame ( ) {
+   for (uint i=0; i < hybrids_.size(); i++)
+      if ( hybrids_[i]->seen ) hybrids_[i]->events += weight_;
+}
+
+// Hybrids seen
+uint CalMonitor::hybrids ( ) {
+   return(hybrids_.size());
+}
+
+// Median of the positive values, 0 if there are none
+static float medianOf ( vector<float> &values ) {
+   if ( values.empty() ) return(0);
+   nth_element(values.begin(),values.begin()+values.size()/2,values.end());
+   return(values[values.size()/2]);
+}
+
+// Write a snapshot
+void CalMonitor::publish ( CalMonitorFile *file, double time ) {
+   CalMonitorHybrid *out;
+   Hybrid           *h;
+   Channel          *ch;
+   vector<float>    values;
+   vector<float>    apvMedians;
+   uint             count;
+   double           now;
+   float            hybMedian;
+
+   if ( (out = file->begin()) == NULL ) return;
+
+   // Sums in units of the current weight, the decayed counts
+   now   = (t0_ < 0) ? 1.0 : exp((time - t0_) / tau_);
+   count = 0;
+
+   for (uint i=0; i < hybrids_.size(); i++, count++) {
+      h = hybrids_[i];
+      out[count].rce           = h->rce;
+      out[count].feb           = h->feb;
+      out[count].hybrid        = h->hyb;
+      out[count].events        = h->events / now;
+      out[count].deadChannels  = 0;
+      out[count].noisyChannels = 0;
+
+      for (uint c=0; c < Channels; c++) {
+         ch = &(h->channels[c]);
+         out[count].channelFlags[c] = 0;
+         out[count].occupancy[c]    = (h->events > 0) ? ch->readouts / h->events : 0;
+         out[count].hitRate[c]      = (h->events > 0) ? ch->hits / h->events : 0;
+         if ( ch->weight / now >= minSamples_ ) {
+            out[count].pedestal[c] = ch->mean;
+            out[count].noise[c]    = sqrt(ch->m2 / ch->weight);
+         } else {
+            out[count].pedestal[c] = 0;
+            out[count].noise[c]    = 0;
+            out[count].channelFlags[c] |= CalMonitorNoData;
+         }
+      }
+
+      // APV medians, then channels against their APV and APVs against the hybrid
+      apvMedians.clear();
+      for (uint a=0; a < Apvs; a++) {
+         values.clear();
+         for (uint c=(4-a)*128; c < (5-a)*128; c++)
+            if ( out[count].noise[c] > 0 ) values.push_back(out[count].noise[c]);
+         out[count].apvNoise[a]     = medianOf(values);
+         out[count].apvErrorRate[a] = (h->apvReadouts[a] > 0) ? h->apvErrors[a] / h->apvReadouts[a] : 0;
+         out[count].apvFlags[a]     = 0;
+         if ( out[count].apvNoise[a] > 0 ) apvMedians.push_back(out[count].apvNoise[a]);
+      }
+      values = apvMedians;
+      hybMedian = medianOf(values);
+
+      for (uint a=0; a < Apvs; a++) {
+         float apvNoise = out[count].apvNoise[a];
+
+         if ( apvNoise == 0 ) {
+            out[count].apvFlags[a] |= (h->apvReadouts[a] > 0) ? CalMonitorNoData : CalMonitorDead;
+         }
+         else if ( hybMedian > 0 && apvNoise > noisyFactor_ * hybMedian ) out[count].apvFlags[a] |= CalMonitorNoisy;
+         if ( out[count].apvErrorRate[a] > errorLimit_ ) out[count].apvFlags[a] |= CalMonitorErrors;
+
+         for (uint c=(4-a)*128; c < (5-a)*128; c++) {
+            ch = &(h->channels[c]);
+
+            // No readouts in a while on an APV that reads out
+            if ( ch->readouts == 0 || (h->apvReadouts[a] / now >= minSamples_ * 128 && ch->readouts / now < 1) ) {
+               out[count].channelFlags[c] |= CalMonitorDead;
+            }
+            else if ( apvNoise > 0 && out[count].noise[c] > 0 ) {
+               if ( out[count].noise[c] < deadFraction_ * apvNoise ) out[count].channelFlags[c] |= CalMonitorDead;
+               if ( out[count].noise[c] > noisyFactor_ * apvNoise ) out[count].channelFlags[c] |= CalMonitorNoisy;
+            }
+            if ( out[count].channelFlags[c] & CalMonitorDead ) out[count].deadChannels++;
+            if ( out[count].channelFlags[c] & CalMonitorNoisy ) out[count].noisyChannels++;
+         }
+      }
+   }
+   file->end(count,time,tau_,totalFrames_,frames_ / now / tau_);
+}
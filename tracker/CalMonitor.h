@@ -0,0 +1,272 @@
+//-----------------------------------------------------------------------------
+// File          : CalMonitor.h
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Incremental calibration monitor for live data.
+//
+// CalMonitor keeps per channel pedestal, noise, readout occupancy and hit
+// rate, and per APV error rate, over an exponentially decayed window with
+// time constant tau. Instead of decaying every accumulator, new values get
+// the weight exp((t - t0) / tau), so an update costs the same as with plain
+// sums; all sums are rescaled when the weight grows large. Memory is fixed:
+// one block per hybrid, up to a maximum number of hybrids.
+//
+// Readouts whose largest sample is more than the hit cut above the pedestal
+// count as hits and are kept out of the pedestal and noise. Channels are
+// numbered (4-apv)*128+channel, as in the .base files.
+//
+// CalMonitorFile is the results file: a header followed by one record per
+// hybrid, mapped into memory by the monitor and by any number of readers.
+// Snapshots are published with a sequence counter that is odd while the
+// records are being written, so readers copy the file without locking and
+// retry when the counter changed under them.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#ifndef __CAL_MONITOR_H__
+#define __CAL_MONITOR_H__
+
+#include <string>
+#include <vector>
+#include <sys/types.h>
+using namespace std;
+
+//! Results file identifier
+#define CalMonitorMagic 0x43414C4D
+
+//! Results file layout version
+#define CalMonitorVersion 1
+
+//! Channel and APV flags in the results file
+enum CalMonitorFlags {
+   CalMonitorNoData = 0x1,   //!< Too few values for an estimate
+   CalMonitorDead   = 0x2,   //!< Channel: no readouts or noise far below its APV, APV: no readouts
+   CalMonitorNoisy  = 0x4,   //!< Channel: noise far above its APV, APV: noise far above its hybrid
+   CalMonitorErrors = 0x8    //!< APV: error rate above the limit
+};
+
+//! Results file header
+struct CalMonitorHeader {
+   uint          magic;
+   uint          version;
+   volatile uint sequence;     //!< Odd while a snapshot is written
+   uint          hybrids;      //!< Hybrid records in the snapshot
+   uint          maxHybrids;   //!< Hybrid records in the file
+   uint          pad;
+   double        time;         //!< Unix time of the snapshot
+   double        tau;          //!< Decay time constant in seconds
+   double        frames;       //!< Frames since start
+   double        rate;         //!< Decayed frame rate in Hz
+};
+
+//! Results of one hybrid
+struct CalMonitorHybrid {
+   uint          rce;
+   uint          feb;
+   uint          hybrid;
+   uint          deadChannels;
+   uint          noisyChannels;
+   uint          apvFlags[5];
+   float         events;             //!< Decayed number of events with this hybrid
+   float         apvNoise[5];        //!< Median channel noise
+   float         apvErrorRate[5];    //!< Readouts with the error flag set per readout
+   float         pedestal[640];
+   float         noise[640];
+   float         occupancy[640];     //!< Readouts per event
+   float         hitRate[640];       //!< Hits per event
+   unsigned char channelFlags[640];
+};
+
+//! Memory mapped results file
+class CalMonitorFile {
+
+      // Mapping
+      int              fd_;
+      void             *map_;
+      uint             size_;
+      bool             writer_;
+      CalMonitorHeader *header_;
+      CalMonitorHybrid *hybrids_;
+
+   public:
+
+      //! Constructor
+      CalMonitorFile ( );
+
+      //! Deconstructor
+      ~CalMonitorFile ( );
+
+      //! Create the file for writing, returns false on failure
+      /*!
+       * \param file File name
+       * \param maxHybrids Hybrid records in the file
+      */
+      bool create ( string file, uint maxHybrids );
+
+      //! Attach to an existing file for reading, returns false on failure
+      /*!
+       * \param file File name
+      */
+      bool attach ( string file );
+
+      //! Unmap and close
+      void close ( );
+
+      //! Start writing a snapshot, returns the hybrid records
+      CalMonitorHybrid *begin ( );
+
+      //! Finish writing a snapshot
+      /*!
+       * \param hybrids Hybrid records written
+       * \param time Snapshot time
+       * \param tau Decay time constant
+       * \param frames Frames since start
+       * \param rate Decayed frame rate
+      */
+      void end ( uint hybrids, double time, double tau, double frames, double rate );
+
+      //! Copy a consistent snapshot, returns false if none is available
+      /*!
+       * \param header Header copy
+       * \param hybrids Hybrid records copy
+      */
+      bool snapshot ( CalMonitorHeader &header, vector<CalMonitorHybrid> &hybrids );
+};
+
+//! Decayed per channel statistics of the live data
+class CalMonitor {
+
+   public:
+
+      //! Channels per hybrid
+      static const uint Channels = 640;
+
+      //! APVs per hybrid
+      static const uint Apvs = 5;
+
+   private:
+
+      // Sums of one channel, all weighted
+      struct Channel {
+         double weight;     // pedestal samples
+         double mean;
+         double m2;
+         double readouts;
+         double hits;
+      };
+
+      // Sums of one hybrid
+      struct Hybrid {
+         uint    rce;
+         uint    feb;
+         uint    hyb;
+         bool    seen;
+         double  events;
+         double  apvReadouts[Apvs];
+         double  apvErrors[Apvs];
+         Channel channels[Channels];
+      };
+
+      // Hybrids in order of appearance, index by key
+      vector<Hybrid *> hybrids_;
+      vector<int>      index_;
+      uint             maxHybrids_;
+
+      // Decay
+      double tau_;
+      double t0_;
+      double weight_;
+
+      // Frames
+      double totalFrames_;
+      double frames_;
+
+      // Cuts
+      double hitSigma_;
+      double minSamples_;
+      double deadFraction_;
+      double noisyFactor_;
+      double errorLimit_;
+
+      // Key from rce, feb and hybrid
+      static uint key ( uint rce, uint feb, uint hyb );
+
+      // Hybrid for a key, NULL if the hybrid limit is reached
+      Hybrid *hybrid ( uint rce, uint feb, uint hyb );
+
+      // Rescale all sums by a factor
+      void rescale ( double factor );
+
+   public:
+
+      //! Constructor
+      /*!
+       * \param tau Decay time constant in seconds
+       * \param maxHybrids Largest number of hybrids kept
+      */
+      CalMonitor ( double tau = 10.0, uint maxHybrids = 128 );
+
+      //! Deconstructor
+      ~CalMonitor ( );
+
+      //! Set the hit cut in noise sigmas, default 5
+      void setHitSigma ( double sigma );
+
+      //! Set the flag limits
+      /*!
+       * \param deadFraction Channel noise below this fraction of the APV median is dead, default 0.3
+       * \param noisyFactor Noise above this factor times the median is noisy, default 2
+       * \param errorLimit APV error rate limit, default 0.001
+      */
+      void setLimits ( double deadFraction, double noisyFactor, double errorLimit );
+
+      //! Clear all sums
+      void clear ( );
+
+      //! Start a frame
+      /*!
+       * \param time Arrival time in seconds
+      */
+      void beginFrame ( double time );
+
+      //! Mark a hybrid as present in the current frame
+      /*!
+       * \param rce RCE address
+       * \param feb FEB address
+       * \param hyb Hybrid
+      */
+      void seen ( uint rce, uint feb, uint hyb );
+
+      //! Add a readout of the current frame
+      /*!
+       * \param rce RCE address
+       * \param feb FEB address
+       * \param hyb Hybrid
+       * \param apv APV
+       * \param channel APV channel
+       * \param values The 6 ADC samples
+       * \param error Error flag of the readout
+      */
+      void add ( uint rce, uint feb, uint hyb, uint apv, uint channel, uint *values, bool error );
+
+      //! Finish the current frame
+      void endFrame ( );
+
+      //! Hybrids seen
+      uint hybrids ( );
+
+      //! Write a snapshot to the results file
+      /*!
+       * \param file Results file
+       * \param time Snapshot time
+      */
+      void publish ( CalMonitorFile *file, double time );
+};
+
+#endif
@@ -0,0 +1,389 @@
+//-----------------------------------------------------------------------------
+// File          : CosmicTracker.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Straight line track finding of cosmics through a stack of modules.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <math.h>
+#include <algorithm>
+#include <CosmicTracker.h>
+using namespace std;
+
+// Strips of a module
+#define MODULE_STRIPS 640
+
+// Constructor
+CosmicTracker::CosmicTracker ( ) {
+   ready_    = false;
+   window_   = 1.0;
+   maxSlope_ = 1.0;
+   minHits_  = 3;
+   maxChi2_  = 0;
+}
+
+// Add a module
+uint CosmicTracker::addModule ( double z, double offset, double pitch, double sigma ) {
+   Module module;
+
+   module.layer  = 0;
+   module.z      = z;
+   module.offset = offset;
+   module.pitch  = pitch;
+   module.sigma  = (sigma > 0) ? sigma : fabs(pitch) / sqrt(12.0);
+   modules_.push_back(module);
+   ready_ = false;
+   return(modules_.size() - 1);
+}
+
+// Set the search window
+void CosmicTracker::setWindow ( double window ) {
+   if ( window <= 0 ) return;
+   window_ = window;
+   ready_  = false;
+}
+
+// Set the largest slope
+void CosmicTracker::setMaxSlope ( double slope ) {
+   maxSlope_ = slope;
+}
+
+// Set the least number of hits
+void CosmicTracker::setMinHits ( uint hits ) {
+   minHits_ = (hits < 2) ? 2 : hits;
+}
+
+// Set the largest chi2 per degree of freedom
+void CosmicTracker::setMaxChi2 ( double chi2 ) {
+   maxChi2_ = chi2;
+}
+
+// Number of modules
+uint CosmicTracker::modules ( ) {
+   return(modules_.size());
+}
+
+// Number of layers
+uint CosmicTracker::layers ( ) {
+   if ( ! ready_ ) prepare();
+   return(layers_.size());
+}
+
+// Layer of a module
+uint CosmicTracker::moduleLayer ( uint module ) {
+   if ( ! ready_ ) prepare();
+   return((module < modules_.size()) ? modules_[module].layer : 0);
+}
+
+// z of a layer
+double CosmicTracker::layerZ ( uint layer ) {
+   if ( ! ready_ ) prepare();
+   return((layer < layers_.size()) ? layers_[layer].z : 0);
+}
+
+// True if a module of the layer covers u
+bool CosmicTracker::inside ( uint layer, double u ) {
+   double first;
+   double last;
+
+   if ( ! ready_ ) prepare();
+   for (uint m=0; m < modules_.size(); m++) {
+      if ( modules_[m].layer != layer ) continue;
+      first = modules_[m].offset - 0.5 * modules_[m].pitch;
+      last  = modules_[m].offset + (MODULE_STRIPS - 0.5) * modules_[m].pitch;
+      if ( u >= min(first,last) && u <= max(first,last) ) return(true);
+   }
+   return(false);
+}
+
+// Least number of hits of a track
+uint CosmicTracker::minHits ( ) {
+   return(minHits_);
+}
+
+// Build the layers from the modules, in z order
+void CosmicTracker::prepare ( ) {
+   vector<double> z;
+   double         first;
+   double         last;
+
+   for (uint m=0; m < modules_.size(); m++) z.push_back(modules_[m].z);
+   sort(z.begin(),z.end());
+   z.erase(unique(z.begin(),z.end()),z.end());
+
+   layers_.resize(z.size());
+   for (uint l=0; l < layers_.size(); l++) {
+      layers_[l].z    = z[l];
+      layers_[l].low  = 0;
+      layers_[l].high = 0;
+   }
+   for (uint m=0; m < modules_.size(); m++) {
+      Module &module = modules_[m];
+      module.layer = lower_bound(z.begin(),z.end(),module.z) - z.begin();
+      Layer &layer = layers_[module.layer];
+      first = module.offset - 0.5 * module.pitch;
+      last  = module.offset + (MODULE_STRIPS - 0.5) * module.pitch;
+      if ( layer.low == layer.high ) {
+         layer.low  = min(first,last);
+         layer.high = max(first,last);
+      } else {
+         layer.low  = min(layer.low,min(first,last));
+         layer.high = max(layer.high,max(first,last));
+      }
+   }
+   for (uint l=0; l < layers_.size(); l++) {
+      layers_[l].bins = (uint)((layers_[l].high - layers_[l].low) / window_) + 1;
+      layers_[l].start.assign(layers_[l].bins + 1,0);
+      layers_[l].order.clear();
+   }
+   ready_ = true;
+}
+
+// Sort the hits of the event into their bins
+void CosmicTracker::index ( ) {
+   int b;
+
+   hitBin_.resize(hits_.size());
+   fill_.resize(layers_.size());
+
+   for (uint l=0; l < layers_.size(); l++) layers_[l].start.assign(layers_[l].bins + 1,0);
+
+   for (uint h=0; h < hits_.size(); h++) {
+      Layer &layer = layers_[hits_[h].layer];
+      b = (int)floor((hits_[h].u - layer.low) / window_);
+      if ( b < 0 ) b = 0;
+      if ( b >= (int)layer.bins ) b = layer.bins - 1;
+      hitBin_[h] = b;
+      layer.start[b+1]++;
+   }
+
+   for (uint l=0; l < layers_.size(); l++) {
+      Layer &layer = layers_[l];
+      for (uint i=0; i < layer.bins; i++) layer.start[i+1] += layer.start[i];
+      layer.order.resize(layer.start[layer.bins]);
+      fill_[l].assign(layer.start.begin(),layer.start.end() - 1);
+   }
+   for (uint h=0; h < hits_.size(); h++)
+      layers_[hits_[h].layer].order[fill_[hits_[h].layer][hitBin_[h]]++] = h;
+}
+
+// Nearest unused hit of a layer within the window
+int CosmicTracker::lookup ( uint layer, double u ) {
+   Layer  &lay = layers_[layer];
+   int    b    = (int)floor((u - lay.low) / window_);
+   int    best = -1;
+   double dist = window_;
+   double d;
+
+   for (int i=b-1; i <= b+1; i++) {
+      if ( i < 0 || i >= (int)lay.bins ) continue;
+      for (uint j=lay.start[i]; j < lay.start[i+1]; j++) {
+         CosmicHit &hit = hits_[lay.order[j]];
+         if ( hit.used ) continue;
+         d = fabs(hit.u - u);
+         if ( d <= dist ) {
+            dist = d;
+            best = lay.order[j];
+         }
+      }
+   }
+   return(best);
+}
+
+// Weighted straight line through the hits of a track, skipping a layer
+bool CosmicTracker::fitLine ( const int *hit, int skip, double &intercept, double &slope, double &chi2 ) {
+   double s = 0, sz = 0, su = 0, szz = 0, szu = 0;
+   double w, z, u, det, r;
+   uint   n = 0;
+
+   for (uint l=0; l < layers_.size(); l++) {
+      if ( hit[l] < 0 || (int)l == skip ) continue;
+      w = 1.0 / (hits_[hit[l]].sigma * hits_[hit[l]].sigma);
+      z = layers_[l].z;
+      u = hits_[hit[l]].u;
+      s   += w;
+      sz  += w * z;
+      su  += w * u;
+      szz += w * z * z;
+      szu += w * z * u;
+      n++;
+   }
+   det = s * szz - sz * sz;
+   if ( n < 2 || det <= 0 ) return(false);
+   slope     = (s * szu - sz * su) / det;
+   intercept = (szz * su - sz * szu) / det;
+
+   chi2 = 0;
+   for (uint l=0; l < layers_.size(); l++) {
+      if ( hit[l] < 0 || (int)l == skip ) continue;
+      r = (hits_[hit[l]].u - intercept - slope * layers_[l].z) / hits_[hit[l]].sigma;
+      chi2 += r * r;
+   }
+   return(true);
+}
+
+// Fit an accepted track and its residuals
+bool CosmicTracker::fitTrack ( CosmicTrack &track ) {
+   double intercept;
+   double slope;
+   double chi2;
+
+   if ( ! fitLine(track.hit,-1,track.intercept,track.slope,track.chi2) ) return(false);
+   track.ndf = track.hits - 2;
+
+   for (uint l=0; l < layers_.size(); l++) {
+      track.unbiased[l] = (track.hit[l] >= 0 && track.hits >= 3 && fitLine(track.hit,l,intercept,slope,chi2));
+      if ( track.unbiased[l] ) track.predicted[l] = intercept + slope * layers_[l].z;
+      else track.predicted[l] = track.intercept + track.slope * layers_[l].z;
+      track.residual[l] = (track.hit[l] >= 0) ? hits_[track.hit[l]].u - track.predicted[l] : 0;
+   }
+   return(true);
+}
+
+// Start an event
+void CosmicTracker::clear ( ) {
+   hits_.clear();
+   tracks_.clear();
+}
+
+// Add a hit
+void CosmicTracker::addHit ( uint module, double strip, double amplitude, double t0, uint size ) {
+   CosmicHit hit;
+
+   if ( module >= modules_.size() ) return;
+   if ( ! ready_ ) prepare();
+   hit.module    = module;
+   hit.layer     = modules_[module].layer;
+   hit.u         = modules_[module].offset + modules_[module].pitch * strip;
+   hit.sigma     = modules_[module].sigma;
+   hit.amplitude = amplitude;
+   hit.t0        = t0;
+   hit.size      = size;
+   hit.used      = false;
+   hits_.push_back(hit);
+}
+
+// Candidates with more hits, then smaller residuals, first
+static bool betterCandidate ( const CosmicTrack &a, const CosmicTrack &b ) {
+   return(a.hits > b.hits || (a.hits == b.hits && a.chi2 < b.chi2));
+}
+
+// Find the tracks of the event
+uint CosmicTracker::findTracks ( ) {
+   CosmicTrack track;
+   int         hit[CosmicMaxLayers];
+   int         h;
+   uint        nl;
+   uint        allowed;
+   uint        last;
+   uint        n;
+   uint        miss;
+   uint        best;
+   double      bestSum;
+   double      sum;
+   double      slope;
+   double      pred;
+   bool        free;
+
+   tracks_.clear();
+   if ( ! ready_ ) prepare();
+   nl = layers_.size();
+   if ( nl < minHits_ || nl > CosmicMaxLayers || hits_.size() < minHits_ ) return(0);
+   allowed = nl - minHits_;
+   index();
+
+   // Seed layer pairs, the furthest apart first
+   for (uint gap=nl-1; gap > 0; gap--) {
+      candidates_.clear();
+
+      for (uint first=0; first + gap < nl; first++) {
+         last = first + gap;
+         if ( first + (nl - 1 - last) > allowed ) continue;
+         Layer &la = layers_[first];
+         Layer &lb = layers_[last];
+
+         for (uint i=0; i < la.order.size(); i++) {
+            CosmicHit &a = hits_[la.order[i]];
+            if ( a.used ) continue;
+            best    = 0;
+            bestSum = 0;
+
+            for (uint j=0; j < lb.order.size(); j++) {
+               CosmicHit &b = hits_[lb.order[j]];
+               if ( b.used ) continue;
+               slope = (b.u - a.u) / (lb.z - la.z);
+               if ( fabs(slope) > maxSlope_ ) continue;
+
+               for (uint l=0; l < nl; l++) hit[l] = -1;
+               hit[first] = la.order[i];
+               hit[last]  = lb.order[j];
+               n    = 2;
+               miss = 0;
+               sum  = 0;
+
+               // Extend to the other layers, dropping the candidate once it can not win
+               for (uint l=0; l < nl && miss <= allowed && n + (nl - l) >= best; l++) {
+                  if ( l == first || l == last ) continue;
+                  pred = a.u + slope * (layers_[l].z - la.z);
+                  if ( (h = lookup(l,pred)) < 0 ) miss++;
+                  else {
+                     hit[l] = h;
+                     sum += (hits_[h].u - pred) * (hits_[h].u - pred);
+                     n++;
+                  }
+               }
+               if ( miss > allowed || n < minHits_ ) continue;
+               if ( n > best || (n == best && sum < bestSum) ) {
+                  best    = n;
+                  bestSum = sum;
+                  for (uint l=0; l < nl; l++) track.hit[l] = hit[l];
+               }
+            }
+            if ( best < minHits_ ) continue;
+            track.hits = best;
+            track.chi2 = bestSum;
+            candidates_.push_back(track);
+         }
+      }
+
+      // Accept the best candidates whose hits are still free
+      sort(candidates_.begin(),candidates_.end(),betterCandidate);
+      for (uint c=0; c < candidates_.size(); c++) {
+         CosmicTrack &cand = candidates_[c];
+         free = true;
+         for (uint l=0; l < nl; l++) if ( cand.hit[l] >= 0 && hits_[cand.hit[l]].used ) free = false;
+         if ( ! free || ! fitTrack(cand) ) continue;
+         if ( maxChi2_ > 0 && cand.ndf > 0 && cand.chi2 / cand.ndf > maxChi2_ ) continue;
+         for (uint l=0; l < nl; l++) if ( cand.hit[l] >= 0 ) hits_[cand.hit[l]].used = true;
+         tracks_.push_back(cand);
+      }
+   }
+   return(tracks_.size());
+}
+
+// Number of tracks
+uint CosmicTracker::count ( ) {
+   return(tracks_.size());
+}
+
+// Get a track
+const CosmicTrack *CosmicTracker::track ( uint index ) {
+   return((index < tracks_.size()) ? &tracks_[index] : NULL);
+}
+
+// Number of hits
+uint CosmicTracker::hitCount ( ) {
+   return(hits_.size());
+}
+
+// Get a hit
+const CosmicHit *CosmicTracker::hit ( uint index ) {
+   return((index < hits_.size()) ? &hits_[index] : NULL);
+}
@@ -0,0 +1,192 @@
+//-----------------------------------------------------------------------------
+// File          : CosmicTracker.h
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Straight line track finding of cosmics through a stack of modules.
+//
+// Each module measures one coordinate u, offset + pitch * strip, at its z.
+// Modules at the same z form a layer, and layers are numbered in z order.
+// The hits of an event (strip clusters) are sorted into bins of the search
+// window along u, per layer. Track candidates are the lines through a hit
+// pair of two layers, outermost pairs first, within the largest slope; the
+// line is extended to the other layers by looking up the nearest unused hit
+// in the bins around the prediction. A candidate is dropped as soon as it
+// misses more layers than the minimum number of hits allows, and the seed
+// hit keeps the candidate with the most hits, then the smallest residuals.
+// The candidates of all pairs of the same layer distance are then accepted
+// best first, as long as their hits are not on a track yet.
+//
+// The accepted track is a weighted least squares line through its hits. For
+// every layer the track is also fitted without that layer's hit, giving the
+// prediction and the unbiased residual used for alignment and efficiency.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#ifndef __COSMIC_TRACKER_H__
+#define __COSMIC_TRACKER_H__
+
+#include <vector>
+#include <sys/types.h>
+using namespace std;
+
+//! Most layers of a track
+#define CosmicMaxLayers 16
+
+//! Hit of a module
+struct CosmicHit {
+   uint   module;
+   uint   layer;
+   double u;          //!< Measured coordinate, mm
+   double sigma;      //!< Resolution, mm
+   double amplitude;  //!< Cluster amplitude
+   double t0;         //!< Cluster T0, ns
+   uint   size;       //!< Strips of the cluster
+   bool   used;       //!< Hit is on a track
+};
+
+//! Straight line track, u = intercept + slope * z
+struct CosmicTrack {
+   double intercept;                     //!< u at z = 0, mm
+   double slope;                         //!< du/dz
+   double chi2;
+   uint   ndf;
+   uint   hits;                          //!< Layers with a hit
+   int    hit[CosmicMaxLayers];          //!< Hit of each layer, -1 if none
+   double predicted[CosmicMaxLayers];    //!< u of the track fitted without the layer
+   bool   unbiased[CosmicMaxLayers];     //!< The prediction excludes the layer
+   double residual[CosmicMaxLayers];     //!< u of the hit less the prediction
+};
+
+//! Straight line cosmic track finder
+class CosmicTracker {
+
+      // A module
+      struct Module {
+         uint   layer;
+         double z;
+         double offset;
+         double pitch;
+         double sigma;
+      };
+
+      // A layer and the bins of its hits
+      struct Layer {
+         double       z;
+         double       low;
+         double       high;
+         uint         bins;
+         vector<uint> start;   // First entry of each bin in order, bins + 1
+         vector<uint> order;   // Hits by bin
+      };
+
+      vector<Module>      modules_;
+      vector<Layer>       layers_;
+      vector<CosmicHit>   hits_;
+      vector<CosmicTrack> tracks_;
+      vector<CosmicTrack> candidates_;
+      bool                ready_;
+
+      // Bin of each hit and next entry of each bin, while indexing
+      vector<uint>          hitBin_;
+      vector<vector<uint> > fill_;
+
+      double window_;
+      double maxSlope_;
+      uint   minHits_;
+      double maxChi2_;
+
+      // Build the layers from the modules
+      void prepare ( );
+
+      // Sort the hits of the event into their bins
+      void index ( );
+
+      // Nearest unused hit of a layer within the window, -1 if none
+      int lookup ( uint layer, double u );
+
+      // Weighted straight line through the hits of a track, skipping a layer
+      bool fitLine ( const int *hit, int skip, double &intercept, double &slope, double &chi2 );
+
+      // Fit an accepted track and its residuals
+      bool fitTrack ( CosmicTrack &track );
+
+   public:
+
+      //! Constructor
+      CosmicTracker ( );
+
+      //! Add a module, returns its index
+      /*!
+       * \param z Position along the stack, mm
+       * \param offset u of strip 0, mm
+       * \param pitch Strip pitch, mm, negative if u decreases with the strip
+       * \param sigma Resolution, mm, 0 for pitch / sqrt(12)
+      */
+      uint addModule ( double z, double offset, double pitch, double sigma = 0 );
+
+      //! Set the search window around the predictions, mm, default 1
+      void setWindow ( double window );
+
+      //! Set the largest slope du/dz, default 1
+      void setMaxSlope ( double slope );
+
+      //! Set the least number of hits of a track, default 3
+      void setMinHits ( uint hits );
+
+      //! Set the largest chi2 per degree of freedom, 0 for no cut (default)
+      void setMaxChi2 ( double chi2 );
+
+      //! Number of modules
+      uint modules ( );
+
+      //! Number of layers
+      uint layers ( );
+
+      //! Layer of a module
+      uint moduleLayer ( uint module );
+
+      //! z of a layer
+      double layerZ ( uint layer );
+
+      //! True if a module of the layer covers u
+      bool inside ( uint layer, double u );
+
+      //! Least number of hits of a track
+      uint minHits ( );
+
+      //! Start an event
+      void clear ( );
+
+      //! Add a hit
+      /*!
+       * \param module Module
+       * \param strip Cluster position in strips
+       * \param amplitude Cluster amplitude
+       * \param t0 Cluster T0, ns
+       * \param size Strips of the cluster
+      */
+      void addHit ( uint module, double strip, double amplitude = 0, double t0 = 0, uint size = 1 );
+
+      //! Find the tracks of the event, returns their number
+      uint findTracks ( );
+
+      //! Number of tracks
+      uint count ( );
+
+      //! Get a track
+      const CosmicTrack *track ( uint index );
+
+      //! Number of hits
+      uint hitCount ( );
+
+      //! Get a hit
+      const CosmicHit *hit ( uint index );
+};
+
+#endif
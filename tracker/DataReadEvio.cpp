@@ -12,6 +12,9 @@
 //-----------------------------------------------------------------------------
 // Modification history :
 // 04/12/2011: created
+// 10/19/2026: reads through a private EVIO context, so readers can run in parallel threads
+// 10/19/2026: only the SVT banks of byte swapped files are swapped
+// 10/19/2026: events can be received from a socket or a pipe
 //-----------------------------------------------------------------------------
 
 #include <DataReadEvio.h>
@@ -28,8 +31,15 @@ using namespace std;
 DataReadEvio::DataReadEvio ( ) {
   debug_=false;
   //debug_=true;
-	fd_ = -1;
+	evio_ = NULL;
+	receiver_ = NULL;
+	stream_buffers = 16;
+	stream_persistent = false;
+	swapped_ = 0;
 	maxbuf=MAXEVIOBUF;
+	evio_buf = (unsigned int*)malloc(maxbuf*sizeof(unsigned int));
+	fpga_bank_alloc = 0;
+	bank_tag = -1;
 	fragment_offset[0] = 2;//BANK
 	fragment_offset[1]=1;//SEGMENT
 	fragment_offset[2]=1;//TAGSEGMENT
@@ -42,10 +52,15 @@ DataReadEvio::DataReadEvio ( ) {
     svt_ti_data_size = 4;
     svt_config_tag = 57614;
     is_engrun = false;
+    read_composite = false;
+    composite_count = 0;
 }
 
 // Deconstructor
-DataReadEvio::~DataReadEvio ( ) { }
+DataReadEvio::~DataReadEvio ( ) {
+    close();
+    free(evio_buf);
+}
 
 void DataReadEvio::set_engrun(bool engrun) {
 	is_engrun = engrun;
@@ -66,22 +81,94 @@ void DataReadEvio::set_bank_range(int bank_num) {
     svt_bank_range = bank_num;
 }
 
+int DataReadEvio::bank_num() {
+    return svt_bank_min;
+}
+
+int DataReadEvio::bank_range() {
+    return svt_bank_range;
+}
+
+int DataReadEvio::last_bank_tag() {
+    return bank_tag;
+}
+
+void DataReadEvio::set_composite(bool composite) {
+    read_composite = composite;
+}
+
+int DataReadEvio::composite_bank_count() {
+    return composite_count;
+}
+
+EvioComposite *DataReadEvio::composite_bank(int index) {
+    if (index<0 || index>=composite_count) return(NULL);
+    return(&composite_banks[index]);
+}
+
+int DataReadEvio::composite_bank_tag(int index) {
+    if (index<0 || index>=composite_count) return(-1);
+    return(composite_bank_tags[index]);
+}
+
+void DataReadEvio::set_stream_buffers(int buffers) {
+    stream_buffers = buffers;
+}
+
+void DataReadEvio::set_stream_persistent(bool persistent) {
+    stream_persistent = persistent;
+}
+
+EvioReceiver *DataReadEvio::stream_receiver() {
+    return receiver_;
+}
+
 // Open file
 bool DataReadEvio::open ( string file, bool compressed ) {
     int status;
+    close();
+
+    // Block stream: the receiver thread fills a ring of blocks, next() takes the events
+    if (file=="-" || file.compare(0,6,"tcp://")==0) {
+        bool ok;
+        receiver_ = new EvioReceiver(stream_buffers);
+        receiver_->setPersistent(stream_persistent);
+        if (file=="-") ok = receiver_->attach(0,"stdin");
+        else {
+            cout<<"Listening for EVIO blocks on "<<file<<endl;
+            ok = receiver_->listen(file.substr(6));
+        }
+        if (!ok) {
+            delete receiver_;
+            receiver_ = NULL;
+            return(false);
+        }
+        return(true);
+    }
+
     char * filename = (char *) malloc((file.size()+1)*sizeof(char));
     strcpy(filename,file.c_str());
-    if((status=evOpen(filename,"r",&fd_))!=0) {
+    status=evOpen_r(filename,(char *)"r",&evio_);
+    free(filename);
+    if(status!=0) {
         //      printf("\n ?Unable to open file %s, status=%d\n\n",file,status);
         cout<<"Unable to open file "<<file<<", status="<<status<<endl;
+        evio_ = NULL;
         return(false);
     }
+
+    // Banks other than the SVT ones are never looked at, so leave them unswapped
+    int lazy = 1;
+    evIoctl_r(evio_,(char *)"l",&lazy);
+    evIoctl_r(evio_,(char *)"e",&swapped_);
     return(true);
 }
 
 void DataReadEvio::close () {
-    evClose(fd_);
-    fd_ = -1;
+    if ( evio_ != NULL ) evClose_r(evio_);
+    evio_ = NULL;
+    if ( receiver_ != NULL ) delete receiver_;
+    receiver_ = NULL;
 }
 
 bool DataReadEvio::next(Data *data) {
@@ -89,14 +176,13 @@ bool DataReadEvio::next(Data *data) {
     if (fpga_count>fpga_it)
     {
         if(debug_)printf("pulling a bank out of cache\n");
-        Data *source_data = fpga_banks[fpga_it++];
+        bank_tag = fpga_bank_tags[fpga_it];
+        Data *source_data = &fpga_banks[fpga_it++];
+        if (source_data->size()>fpga_bank_alloc) fpga_bank_alloc = source_data->size();
         data->copy(source_data->data(),source_data->size());
         if (fpga_it==fpga_count)
         {
-            for (int i=0;i<fpga_count;i++)
-            {
-                delete fpga_banks[i];
-            }
+            // Banks stay allocated in the pool for the next event
             fpga_count = 0;
             fpga_it = 0;
         }
@@ -106,14 +192,25 @@ bool DataReadEvio::next(Data *data) {
     bool nodata = true;
     int nevents=0;
     int status;
-    if ( fd_ < 0 ) {
-        cout<<"DataReadEvio::next error fd_<0...no file open"<<endl;
+    if ( evio_ == NULL && receiver_ == NULL ) {
+        cout<<"DataReadEvio::next error...no file open"<<endl;
         return(false);
     }
 
     do{    
-        unsigned int *buf = (unsigned int*)malloc(maxbuf*sizeof(unsigned int));
-        status = evRead(fd_,buf,maxbuf);
+        unsigned int *buf = evio_buf;
+        if (receiver_!=NULL) {
+            // Stream events come unswapped; swap their headers as the lazy EVIO context does
+            bool swapped = false;
+            status = receiver_->nextEvent(buf,maxbuf,swapped);
+            swapped_ = swapped;
+            if (status==S_SUCCESS && swapped) evioswap_headers(buf,1,NULL);
+            else if (status==S_EVFILE_TRUNC) {
+                cout<<"Event larger than "<<maxbuf<<" words...skipping"<<endl;
+                continue;
+            }
+        }
+        else status = evRead_r(evio_,buf,maxbuf);
         if(status==S_SUCCESS){
             nevents++;
             //  here, get the offset and the length of the SVT data in the buffer (buf)
@@ -122,25 +219,21 @@ bool DataReadEvio::next(Data *data) {
             eventInfo(buf);
             if(debug_)printf("evtTag = %d\n",evtTag);
             if(evtTag>=32 || evtTag<16){
+                composite_count = 0;
                 parse_event(buf);
                 //fpga_it = fpga_banks.begin();
                 nodata=false;  
-                free(buf);
             }else{
                 if(evtTag==20)return(false); //this is the end of data
                 //otherwise, just skip it. 
                 cout<<"Not a data event...skipping"<<endl;
-                free(buf);
             }
         } else if (status==EOF)
         {
             cout << "end of file" << endl;
-            free(buf);
             return(false);
         }else{
             cout<<"oops...broke trying to evRead; error code "<<status<<endl;
-
-            free(buf);
             return(false);
         }
     }  while(nodata);
@@ -200,21 +293,12 @@ void DataReadEvio::parse_eventBank(unsigned int *buf, int bank_length) {
         {
             if (tag>=svt_bank_min && tag<svt_bank_min+svt_bank_range) {
                 if (debug_) printf("found SVT bank, tag %d\n",tag);
-                parse_SVTBank(&buf[ptr+2],length-2);
+                parse_SVTBank(&buf[ptr+2],length-2,tag);
+            }
+            else if (read_composite) {
+                if (debug_) printf("ROC bank %d\n",tag);
+                parse_ECalBank(&buf[ptr+2],length-2,tag);
             }
-            /*else switch (tag) {
-              case 1:
-              if (debug_) printf("ECal top bank\n");
-              parse_ECalBank(&buf[ptr+2],length-2);
-              break;
-              case 2:
-              if (debug_) printf("ECal bottom bank\n");
-              parse_ECalBank(&buf[ptr+2],length-2);
-              break;
-              default:
-              printf("Unexpected bank tag %d\n",tag);
-              break;
-              }*/
         }
         else
             if (debug_) printf("looking for event bank of type BANK but found %d\n",type);
@@ -222,14 +306,14 @@ void DataReadEvio::parse_eventBank(unsigned int *buf, int bank_length) {
     }
 }
 
-void DataReadEvio::parse_SVTBank(unsigned int *buf, int bank_length) {
+void DataReadEvio::parse_SVTBank(unsigned int *buf, int bank_length, int roc_tag) {
     int ptr = 0;
     int length,type, padding=0;
     unsigned short tag;
     unsigned short num;
-    // Pointer to the data structure that will be passed out
+    // Pointer to the pooled data structure that will be passed out
     Data* tb = NULL; 
-    // Pointer to the TI data for this bank
+    // Pointer to the TI data for this bank, points into the event buffer
     uint* tiDataPtr = NULL;
     uint tiDataLen = 0;
     // Pointer to the config string
@@ -255,6 +339,9 @@ void DataReadEvio::parse_SVTBank(unsigned int *buf, int bank_length) {
             cout<<"padding: "<<padding<<", type: "<<type<<", num: "<<num<<endl;
         }
         int fragType = getFragType(type);
+
+        // Data of byte swapped files is swapped once, in the event buffer
+        if (swapped_ && fragType==UINT32) evioswap_data(&buf[ptr+2],type,length-2,1,NULL);
         
         // Found the different banks inside the SVT.
         // This can be a SVT data, TI information or a config/status bank. 
@@ -264,29 +351,20 @@ void DataReadEvio::parse_SVTBank(unsigned int *buf, int bank_length) {
         {
             if(debug_ || debug_local) printf("Got data (fpga_count %d)\n",fpga_count);
           
-            // create the new data object
-            tb=new Data();
-
-            if (!is_engrun){
-              uint *data_  = (uint *)malloc((length-1) * sizeof(uint));
-                memcpy(data_+1,&buf[ptr+2],(length-2)*sizeof(uint));
-                data_[0] = tag;
-                if (tag==7) data_[0]+=0x80000000;
-                tb->copy(data_,length-1);
-                free(data_);
-            } else {
-              
+            // take the next data object from the pool
+            tb = nextPoolBank(roc_tag);
+
+            if (tb!=NULL) {
+              if (!is_engrun){
+                uint header = tag;
+                if (tag==7) header+=0x80000000;
+                tb->copy(&header,1);
+                tb->append(&buf[ptr+2],length-2);
+              } else {
                 if(debug_ || debug_local) printf("copy %d data words into the data object buffer\n",length-2);
                 tb->copy(&buf[ptr+2],length-2);
-
-                //if( debug_local ) {
-                //  printf("the data words copied were:\n");
-                //  for(int iw=0; iw < tb->size(); ++iw )  printf("0x%u\n",(tb->data()[iw]));                  
-                //}
-
-
+              }
             }
-            fpga_banks[fpga_count++] = tb;
         }
         else if (fragType==UINT32 && (!is_engrun || tag==svt_ti_data_tag))  {
 
@@ -303,28 +381,21 @@ void DataReadEvio::parse_SVTBank(unsigned int *buf, int bank_length) {
             exit(1);            
           }
           
-          // Allocate memory for the TI data
-          // Keep this around until the Data structure is done so that we can copy it in at the end.
-          
-          // Check that there is nothing at that memory pointer
+          // Check that we haven't seen a TI bank already
           if( tiDataPtr != NULL) {
             cout << "the TI data pointer is not NULL?" << endl;
             exit(1);
           }
           
-          tiDataPtr = (uint*) malloc(tiDataLen * sizeof(uint));
-          if(debug_local) printf("Allocated %d words of TI data space at %p\n",tiDataLen, tiDataPtr);
-          
-          // Actually do the copy
-          memcpy(tiDataPtr,&buf[ptr+2],tiDataLen*sizeof(uint));
-          if(debug_local) printf("Done memcpy of the TI data\n");
-          
+          // The event buffer outlives this function, so just keep a pointer.
+          // The words are appended to the data object at the end.
+          tiDataPtr = &buf[ptr+2];
         }
         else if (fragType==CHARSTAR8 && tag==svt_config_tag)  {
-          //if(debug_local) {
+          if(debug_ || debug_local) {
             printf("Found config/status bank\n");
             printf("Actual config lengths: %d (%lu, %lu)\n",length-2,sizeof(uint),sizeof(char));
-            //}
+          }
 
           // allocate memory for the string
           if(debug_local) cout << "The config string pointer is "  << (str == NULL ? "NULL " : "not NULL ") << endl;            
@@ -334,15 +405,14 @@ void DataReadEvio::parse_SVTBank(unsigned int *buf, int bank_length) {
           str_length += l_new_str;
           
           if( debug_local) printf("allocate %d memory for config str (existing str is %d long)\n",str_length,l_old_str);
-          more_str = (char*) realloc(str, str_length);
+          more_str = (char*) realloc(str, str_length+1);
           str = more_str;          
-          //str = (char*) malloc((length-2)*sizeof(uint)*sizeof(uint)/sizeof(char));
           
           // Copy the string
           if(debug_local) printf("memcpy the config str of length %d to tmp place pointer at %p (offset from %p)\n",l_new_str,str+l_old_str,str);
           
-          //memcpy(str,&buf[ptr+2],(length-2)*sizeof(uint)*sizeof(uint)/sizeof(char));
           memcpy(str+l_old_str, &buf[ptr+2], l_new_str);
+          str[str_length] = 0;
           
           if( debug_local ) {
             printf("Config bank is:\n");
@@ -360,91 +430,60 @@ void DataReadEvio::parse_SVTBank(unsigned int *buf, int bank_length) {
         ptr+=length;
     }
 
-    // Create a new Data structure that includes the TI data if it's found
-    // way to complicated but whatever
+    // Attach the TI data to the back of the data object, in place
 
     if (debug_local) printf("Done parsing bank. Now add on the TI data and config string if found\n");
 
     if( tb!=NULL ) {
-      
-      if (debug_local) printf("There was a data structure built for this bank. \n");
-      
       if(tiDataPtr!=NULL) {
-
-        if(debug_local) printf("Found TI data. Copy it to the data object");
-        
-        // Attach the TI data to the "back" of the data already there
-        
-        // find the new size of the data
-        uint len = tb->size()+tiDataLen;
-
-        if(debug_local) printf("Allocate %d for the new data\n", len);
-        
-        // allocate memory to hold all of the data in a temporary location
-        uint *d  = (uint *)malloc(len * sizeof(uint));
-        
-        if(debug_local) printf("Copy the existing %d data words into the temporary buffer at %p\n", tb->size(),d);
-
-        memcpy(d,tb->data(),tb->size()*sizeof(uint));
-
-        if(debug_local) printf("Copy the TI %d data words from %p into the temporary buffer at %p\n", tiDataLen, tiDataPtr,d+tb->size());
-        
-        memcpy(d+tb->size(),tiDataPtr,tiDataLen*sizeof(uint));
-
-        if( debug_local ) printf(" Now copy the temporary %d data at %p to the data object, it should take care of space \n",len,d);
-        tb->copy(d,len);
-        
-        if(debug_local) printf("Done copy the TI data to the data object.");
-
-        // delete the temporary data
-        if(debug_local) printf("Free memory that held all the data temporarily at %p\n",d);
-        free(d);
-        
-        
-      } else {        
-        if(is_engrun) {
-          if(debug_local) printf("Inject empty TI data.");
-          uint len = tb->size()+svt_ti_data_size;
-          uint *d  = (uint *)malloc(len * sizeof(uint));
-          if(debug_local) printf("Allocated %d for the new data\n", len);
-          memcpy(d,tb->data(),tb->size()*sizeof(uint));
-          memset(d+tb->size(),0xff,svt_ti_data_size*sizeof(uint));
-          if(debug_local) printf("Done memcpy\n");
-          tb->copy(d,len);
-          if(debug_local) printf("Done copy the fake TI data to the data object");      
-          // free temporary memory
-          free(d);
-        }
+        if(debug_local) printf("Append %d TI data words to the data object\n",tiDataLen);
+        tb->append(tiDataPtr,tiDataLen);
+      } else if(is_engrun) {
+        if(debug_local) printf("Inject empty TI data.\n");
+        memset(tb->extend(svt_ti_data_size),0xff,svt_ti_data_size*sizeof(uint));
       }
     } else {
       if(debug_local) printf("No tb object built.\n");
     }
     
     if( str != NULL) {
-      //if( debug_local ) {
+      if( debug_ || debug_local ) {
         printf("Config bank is:\n");
         printf("\"%s\"\n",str);
-        //}
+      }
+
+      // Update the config/status store; repeated identical banks are not parsed again
+      const char *xml = str;
+      while (*xml==' ' || *xml=='\n' || *xml=='\r' || *xml=='\t') xml++;
+      if (*xml=='<') parseXml(xml);
       if( debug_local ) printf("delete memory for the config str\n");
       free( str );
     } else {
       if( debug_local ) printf("no config str memory was allocated\n");
     }
 
-    if( tiDataPtr != NULL) {
-      if( debug_local ) printf("delete memory for the tiDataPtr\n");
-      free(tiDataPtr);
-    } else {
-      if( debug_local ) printf("no toDataPtr memory was allocated\n");
-    }
-    
-    
     if(debug_local) {
       cout<<"\n DONE parsing SVT bank\n===="<<endl;
     }
 }
 
-void DataReadEvio::parse_ECalBank(unsigned int *buf, int bank_length) {
+// Get the next free bank buffer from the pool, NULL if the pool is full
+Data *DataReadEvio::nextPoolBank(int tag) {
+    Data *tb;
+
+    if (fpga_count>=MAXFPGABANKS) {
+        printf("DataReadEvio: more than %d SVT banks in one event, dropping bank\n",MAXFPGABANKS);
+        return(NULL);
+    }
+    fpga_bank_tags[fpga_count] = tag;
+    tb = &fpga_banks[fpga_count++];
+
+    // Size the buffer for the largest bank seen so far, so appends don't reallocate
+    tb->reserve(fpga_bank_alloc);
+    return(tb);
+}
+
+void DataReadEvio::parse_ECalBank(unsigned int *buf, int bank_length, int roc_tag) {
     int ptr = 0;
     int length,type, padding=0;
     unsigned short tag;
@@ -466,59 +505,33 @@ void DataReadEvio::parse_ECalBank(unsigned int *buf, int bank_length) {
 
         if (fragType==COMPOSITE)
         {
-            parse_ECalCompositeData(&buf[ptr+2],length-2);
+            parse_ECalCompositeData(&buf[ptr+2],length-2,roc_tag);
         }
-        else
+        else if (debug_)
             printf("data type of ECal bank should be COMPOSITE but was %d\n",type);
         ptr+=length;
     }
 }
 
-void DataReadEvio::parse_ECalCompositeData(unsigned int *buf, int bank_length) {
-    int ptr = 0;
-    int length,type, padding=0;
-    unsigned short tag;
-    unsigned short num;
-    int fragType; 
-
-    if (debug_) printf("ptr = %d, bank_length = %d\n",ptr,bank_length);
-    tag         = (buf[ptr]>>20)&0xfff;
-    type        = (buf[ptr]>>16)&0xf;
-    length      = (buf[ptr]&0xffff) + 1;
-    fragType = getFragType(type);
-    if(debug_)
-    {
-        cout<<"Spitting out ECal composite data sub-TAGSEGMENT header data: "<<endl;
-        cout<<"length: "<<length<<", tag: "<<tag<<", type: "<<type<<endl;
-        for (int i=1;i<length;i++)
-        {
-            char c;
-            //printf("%x\n",buf[ptr+i]);
-            c = (buf[ptr+i])&0xff;
-            printf("%c",c);
-            c = (buf[ptr+i]>>8)&0xff;
-            printf("%c",c);
-            c = (buf[ptr+i]>>16)&0xff;
-            printf("%c",c);
-            c = (buf[ptr+i]>>24)&0xff;
-            printf("%c",c);
-        }
-        printf("\n");
+void DataReadEvio::parse_ECalCompositeData(unsigned int *buf, int bank_length, int roc_tag) {
+    if (composite_count>=MAXCOMPOSITEBANKS) {
+        printf("DataReadEvio: more than %d composite banks in one event, dropping bank\n",MAXCOMPOSITEBANKS);
+        return;
     }
 
-    ptr+=length;
-    if (debug_) printf("ptr = %d, bank_length = %d\n",ptr,bank_length);
-    length      = buf[ptr]+1;
-    tag         = (buf[ptr+1]>>16)&0xffff;
-    type        = (buf[ptr+1]>>8)&0x3f;
-    padding     = (buf[ptr+1]>>14)&0x3;
-    num         = buf[ptr+1]&0xff;
+    // Lazily swapped files still have the composite payload in the other byte order; the decoder swaps it
+    EvioComposite *composite = &composite_banks[composite_count];
+    if (!composite->decode(buf,bank_length,swapped_!=0)) {
+        if (debug_) printf("DataReadEvio: bad composite bank (format \"%s\") in ROC bank %d\n",composite->format().c_str(),roc_tag);
+        return;
+    }
     if(debug_)
     {
-        cout<<"Spitting out ECal composite data sub-BANK header data: "<<endl;
-        cout<<"length: "<<length<<", tag: "<<tag<<endl;
-        cout<<"padding: "<<padding<<", type: "<<type<<", num: "<<num<<endl;
+        cout<<"ECal composite data, format "<<composite->format()<<", tag: "<<composite->tag()<<", num: "<<composite->num()<<endl;
+        for (uint i=0;i<composite->columns();i++)
+            cout<<"column "<<i<<": "<<composite->column(i)->type<<", "<<composite->column(i)->count<<" values"<<endl;
     }
+    composite_bank_tags[composite_count++] = roc_tag;
 }
 
 int DataReadEvio::getFragType(int type){
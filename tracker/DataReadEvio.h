@@ -13,6 +13,8 @@
 //-----------------------------------------------------------------------------
 // Modification history :
 // 04/12/2011: created
+// 10/19/2026: composite banks of the other ROCs can be decoded
+// 10/19/2026: events can be received from a socket or a pipe
 //-----------------------------------------------------------------------------
 #ifndef __DATA_READ_EVIO_H__
 #define __DATA_READ_EVIO_H__
@@ -24,8 +26,12 @@
 #include <sys/types.h>
 #include <DataRead.h>
 #include <Data.h>
+#include <EvioComposite.h>
+#include <EvioReceiver.h>
 using namespace std;
 #define MAXEVIOBUF   1000000
+#define MAXFPGABANKS 64
+#define MAXCOMPOSITEBANKS 64
 
 // Define variable holder
 typedef map<string,string> VariableHolder;
@@ -34,10 +40,33 @@ typedef map<string,string> VariableHolder;
 class DataReadEvio : public DataRead {
 	bool debug_;
 
+	// Private EVIO context, independent of other readers
+	EVFILE *evio_;
+
+	// Block stream receiver, instead of the EVIO context when reading a stream
+	EvioReceiver *receiver_;
+	int stream_buffers;
+	bool stream_persistent;
+
+	// File is byte swapped: only bank headers are swapped on read, SVT data is swapped here
+	int swapped_;
+
 	int maxbuf ;
-	Data *fpga_banks[16];
+	unsigned int *evio_buf;
+
+	// Pool of bank buffers, reused from one event to the next
+	Data fpga_banks[MAXFPGABANKS];
+	int fpga_bank_tags[MAXFPGABANKS];
+	uint fpga_bank_alloc;
 	int fpga_count, fpga_it;
+	int bank_tag;
 	int svt_bank_min,svt_bank_range;
+
+	// Decoded composite (ECal, trigger) banks of the current event, reused from one event to the next
+	bool read_composite;
+	EvioComposite composite_banks[MAXCOMPOSITEBANKS];
+	int composite_bank_tags[MAXCOMPOSITEBANKS];
+	int composite_count;
     
     bool is_engrun;
     int svt_data_tag;
@@ -48,12 +77,14 @@ class DataReadEvio : public DataRead {
 
 	void parse_event( unsigned int *buf);
 	void parse_eventBank( unsigned int *buf,int bank_length);
-	void parse_SVTBank( unsigned int *buf,int bank_length);
-	void parse_ECalBank( unsigned int *buf,int bank_length);
-	void parse_ECalCompositeData( unsigned int *buf,int bank_length);
+	void parse_SVTBank( unsigned int *buf,int bank_length,int roc_tag);
+	void parse_ECalBank( unsigned int *buf,int bank_length,int roc_tag);
+	void parse_ECalCompositeData( unsigned int *buf,int bank_length,int roc_tag);
 
 	void eventInfo(unsigned int *buf);
 
+	Data *nextPoolBank(int tag);
+
 	int getFragType(int type);
 
 	enum {
@@ -83,6 +114,47 @@ class DataReadEvio : public DataRead {
 	void set_bank_num(int bank_num);
 	void set_bank_range(int bank_num);
 
+	//! First SVT bank tag
+	int bank_num();
+
+	//! Number of SVT bank tags
+	int bank_range();
+
+	//! Bank tag (ROC) of the last record returned by next()
+	int last_bank_tag();
+
+	//! Also decode the composite banks of the other ROCs (ECal, trigger)
+	void set_composite(bool composite);
+
+	//! Number of composite banks in the event of the last record returned by next()
+	int composite_bank_count();
+
+	//! Decoded composite bank, valid until the next event is read
+	/*!
+	 * \param index Bank index, less than composite_bank_count()
+	 */
+	EvioComposite *composite_bank(int index);
+
+	//! Bank tag (ROC) of a composite bank
+	int composite_bank_tag(int index);
+
+	//! Number of block buffers of the stream receiver, before open
+	void set_stream_buffers(int buffers);
+
+	//! Keep waiting for the next producer after one ends its stream, before open
+	void set_stream_persistent(bool persistent);
+
+	//! Stream receiver, NULL when reading a file
+	EvioReceiver *stream_receiver();
+
+	//! Open a file or a stream
+	/*!
+	 * Returns true on success.
+	 * \param file Filename, "tcp://[host]:port" to listen for an EVIO block
+	 * stream (e.g. from the event builder or meeg_evio_send) or "-" to read
+	 * the stream from stdin
+	 * \param compressed Unused
+	 */
 	bool open ( string file, bool compressed = false );
 
 	void close();
@@ -0,0 +1,459 @@
+//-----------------------------------------------------------------------------
+// File          : DataSkim.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Skim and split of a data stream into reduced run files.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+// 10/19/2026: EVIO outputs through DataWriteEvio
+//-----------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include "DataSkim.h"
+#include "DevboardEvent.h"
+#include "DevboardSample.h"
+#include "TiTriggerEvent.h"
+#include "TriggerSample.h"
+#include "FrameLayout.h"
+using namespace std;
+
+// EVIO banks of the outputs, as read by DataReadEvio
+#define SKIM_EVIO_EVENT_TAG 1
+#define SKIM_EVIO_BANK      0x0e
+#define SKIM_EVIO_UINT32    0x01
+#define SKIM_EVIO_CHARSTAR8 0x03
+#define SKIM_EVIO_DATA_TAG  3
+#define SKIM_EVIO_TI_TAG    57610
+#define SKIM_EVIO_TI_WORDS  4
+#define SKIM_EVIO_XML_TAG   57614
+
+// Append an EVIO bank header, returns the index of its length word
+static uint evioBank ( vector<uint> &event, uint tag, uint type ) {
+   event.push_back(1);
+   event.push_back((tag << 16) | (type << 8));
+   return(event.size() - 2);
+}
+
+// Append an EVIO bank of words
+static void evioWords ( vector<uint> &event, uint tag, const uint *data, uint size ) {
+   evioBank(event,tag,SKIM_EVIO_UINT32);
+   event[event.size()-2] += size;
+   event.insert(event.end(),data,data+size);
+}
+
+// Key from rce, feb and hybrid
+uint DataSkim::key ( uint rce, uint feb, uint hyb ) {
+   return(((rce & 0xFF) << 16) | ((feb & 0xFF) << 8) | (hyb & 0xFF));
+}
+
+// Constructor
+DataSkim::DataSkim ( ) {
+   compressed_ = false;
+   bufferSize_ = DataWrite::DefaultBuffer;
+   split_      = false;
+   evio_       = false;
+   pool_       = NULL;
+   bank_       = 3;
+   tiFrames_   = false;
+   rce_        = -1;
+   feb_        = -1;
+   hyb_        = -1;
+   first_      = 0;
+   last_       = 0;
+   useTime_    = false;
+   timeStart_  = 0;
+   timeEnd_    = 0;
+   errorsOnly_ = false;
+   frames_     = 0;
+   kept_       = 0;
+   wordsIn_    = 0;
+}
+
+// Deconstructor
+DataSkim::~DataSkim ( ) {
+   close();
+   clear();
+}
+
+// Delete the outputs
+void DataSkim::clear ( ) {
+   map<uint,Output *>::iterator it;
+
+   for (it=outputs_.begin(); it != outputs_.end(); it++) {
+      if ( it->second == NULL ) continue;
+      if ( it->second->writer != NULL ) delete it->second->writer;
+      if ( it->second->evio != NULL ) delete it->second->evio;
+      delete it->second;
+   }
+   outputs_.clear();
+
+   // Streams first, they drain into the pool when deleted
+   if ( pool_ != NULL ) delete pool_;
+   pool_ = NULL;
+}
+
+// Readout selection
+void DataSkim::select ( int rce, int feb, int hyb ) {
+   rce_ = rce;
+   feb_ = feb;
+   hyb_ = hyb;
+}
+
+// Split outputs
+void DataSkim::setSplit ( bool split ) {
+   split_ = split;
+}
+
+// EVIO outputs
+void DataSkim::setEvio ( bool evio, uint bank ) {
+   evio_ = evio;
+   bank_ = bank;
+}
+
+// ROC bank tag of the next frames
+void DataSkim::setBank ( uint bank ) {
+   bank_ = bank;
+}
+
+// Event range
+void DataSkim::setEventRange ( unsigned long first, unsigned long last ) {
+   first_ = first;
+   last_  = last;
+}
+
+// TI timestamp window
+void DataSkim::setTimeWindow ( unsigned long long start, unsigned long long end ) {
+   useTime_   = true;
+   timeStart_ = start;
+   timeEnd_   = end;
+}
+
+// Error frames only
+void DataSkim::setErrorsOnly ( bool errorsOnly ) {
+   errorsOnly_ = errorsOnly;
+}
+
+// Set the output base name
+bool DataSkim::open ( string base, bool compressed, uint bufferSize ) {
+   close();
+   clear();
+   base_       = base;
+   compressed_ = compressed;
+   bufferSize_ = bufferSize;
+   xml_.clear();
+   frames_  = 0;
+   kept_    = 0;
+   wordsIn_ = 0;
+
+   if ( evio_ ) {
+      if ( compressed ) {
+         cout << "DataSkim::open -> EVIO outputs can not be compressed" << endl;
+         return(false);
+      }
+      pool_ = new DataWriteEvioPool(8,bufferSize / sizeof(uint));
+      if ( ! pool_->ok() ) return(false);
+   }
+
+   // A single output is created now so that it gets every XML record in order
+   if ( ! split_ ) return(output(0) != NULL);
+   return(true);
+}
+
+// Output for a key
+DataSkim::Output *DataSkim::output ( uint key ) {
+   map<uint,Output *>::iterator it;
+   map<uint,string>::iterator   xit;
+   Output *out;
+   char   name[100];
+   bool   ok;
+
+   it = outputs_.find(key);
+   if ( it != outputs_.end() ) return(it->second);
+
+   if ( split_ ) sprintf(name,"_R%d_F%d_H%d.skim",(key >> 16) & 0xFF,(key >> 8) & 0xFF,key & 0xFF);
+   else strcpy(name,".skim");
+
+   out = new Output;
+   out->name   = base_ + name + (evio_ ? ".evio" : ".bin") + (compressed_ ? ".bz2" : "");
+   out->writer = NULL;
+   out->evio   = NULL;
+   out->frames = 0;
+   if ( evio_ ) {
+      out->evio = new DataWriteEvio;
+      ok = out->evio->open(out->name,pool_);
+   }
+   else {
+      out->writer = new DataWrite;
+      ok = out->writer->open(out->name,compressed_,bufferSize_);
+   }
+   if ( ! ok ) {
+      if ( out->writer != NULL ) delete out->writer;
+      if ( out->evio != NULL ) delete out->evio;
+      delete out;
+      outputs_[key] = NULL;
+      return(NULL);
+   }
+   cout << "DataSkim::output -> Writing " << out->name << endl;
+
+   // State records seen so far
+   for (xit=xml_.begin(); xit != xml_.end(); xit++) {
+      if ( xit->first == Data::XmlConfig || xit->first == Data::XmlStatus || xit->first == Data::XmlRunStart )
+         writeXml(out,xit->first,xit->second);
+   }
+   outputs_[key] = out;
+   return(out);
+}
+
+// True if a readout is selected
+bool DataSkim::selected ( uint rce, uint feb, uint hyb ) {
+   if ( rce_ >= 0 && (uint)rce_ != rce ) return(false);
+   if ( feb_ >= 0 && (uint)feb_ != feb ) return(false);
+   if ( hyb_ >= 0 && (uint)hyb_ != hyb ) return(false);
+   return(true);
+}
+
+// Copy an XML record to the outputs
+void DataSkim::xml ( uint type, string xml ) {
+   map<uint,Output *>::iterator it;
+
+   xml_[type] = xml;
+   for (it=outputs_.begin(); it != outputs_.end(); it++)
+      if ( it->second != NULL ) writeXml(it->second,type,xml);
+}
+
+// Write a frame to an output
+void DataSkim::writeFrame ( Output *out, const uint *data, uint size ) {
+   uint roc;
+   uint words;
+
+   if ( out->evio == NULL ) {
+      out->writer->writeData(data,size);
+      return;
+   }
+
+   // Event bank, then the ROC bank with the frame
+   event_.clear();
+   evioBank(event_,SKIM_EVIO_EVENT_TAG,SKIM_EVIO_BANK);
+   roc = evioBank(event_,bank_,SKIM_EVIO_BANK);
+
+   // TriggerEvent frames: data bank, then the TI words unless they are the filler of a bank without TI data
+   if ( tiFrames_ ) {
+      words = (size < SKIM_EVIO_TI_WORDS) ? size : size - SKIM_EVIO_TI_WORDS;
+      evioWords(event_,SKIM_EVIO_DATA_TAG,data,words);
+      for (uint i=words; i < size; i++) {
+         if ( data[i] == 0xFFFFFFFF ) continue;
+         evioWords(event_,SKIM_EVIO_TI_TAG,data+words,size-words);
+         break;
+      }
+   }
+
+   // DevboardEvent frames: the header word is the bank tag, the TI flag comes back from tag 7
+   else if ( size > 0 ) evioWords(event_,data[0] & 0xFFFF,data+1,size-1);
+
+   event_[roc] = event_.size() - roc - 1;
+   event_[0]   = event_.size() - 1;
+   out->evio->writeEvent(&event_[0]);
+}
+
+// Write an XML record to an output
+void DataSkim::writeXml ( Output *out, uint type, const string &xml ) {
+   uint roc;
+   uint bank;
+   uint words;
+
+   if ( out->evio == NULL ) {
+      out->writer->writeXml(type,xml);
+      return;
+   }
+   if ( type != Data::XmlConfig && type != Data::XmlStatus ) return;
+
+   // Config bank in a ROC bank, the string padded with at least one NUL
+   words = xml.size() / sizeof(uint) + 1;
+   event_.clear();
+   evioBank(event_,SKIM_EVIO_EVENT_TAG,SKIM_EVIO_BANK);
+   roc  = evioBank(event_,bank_,SKIM_EVIO_BANK);
+   bank = evioBank(event_,SKIM_EVIO_XML_TAG,SKIM_EVIO_CHARSTAR8);
+   event_.resize(event_.size() + words,0);
+   memcpy(&event_[bank+2],xml.data(),xml.size());
+   event_[bank] = words + 1;
+   event_[roc]  = event_.size() - roc - 1;
+   event_[0]    = event_.size() - 1;
+   out->evio->writeEvent(&event_[0]);
+}
+
+// Bytes written to an output
+unsigned long long DataSkim::bytes ( Output *out ) {
+   if ( out->evio != NULL ) return(out->evio->bytes());
+   return(out->writer->bytes());
+}
+
+// Write the readouts of a frame
+void DataSkim::write ( uint *data, uint size, uint head, uint sampleSize, uint count ) {
+   map<uint,Output *>::iterator it;
+   Output *out;
+   uint   tail;
+   bool   written = false;
+
+   // Frames without readouts go to the open outputs
+   if ( count == 0 ) {
+      for (it=outputs_.begin(); it != outputs_.end(); it++) {
+         if ( it->second == NULL ) continue;
+         writeFrame(it->second,data,size);
+         it->second->frames++;
+         written = true;
+      }
+      if ( written ) kept_++;
+      return;
+   }
+
+   frameKeys_.clear();
+   for (uint x=0; x < count; x++) {
+      if ( sampleKeys_[x] < 0 ) continue;
+      if ( find(frameKeys_.begin(),frameKeys_.end(),(uint)sampleKeys_[x]) == frameKeys_.end() )
+         frameKeys_.push_back(sampleKeys_[x]);
+   }
+
+   // Header, readouts of the output, then the trailing words
+   tail = size - head - count*sampleSize;
+   for (uint k=0; k < frameKeys_.size(); k++) {
+      if ( (out = output(frameKeys_[k])) == NULL ) continue;
+
+      out_.resize(size);
+      uint outSize = head;
+      memcpy(&out_[0],data,head*sizeof(uint));
+      for (uint x=0; x < count; x++) {
+         if ( sampleKeys_[x] != (int)frameKeys_[k] ) continue;
+         memcpy(&out_[outSize],data+head+x*sampleSize,sampleSize*sizeof(uint));
+         outSize += sampleSize;
+      }
+      memcpy(&out_[outSize],data+head+count*sampleSize,tail*sizeof(uint));
+      outSize += tail;
+
+      writeFrame(out,&out_[0],outSize);
+      out->frames++;
+      written = true;
+   }
+   if ( written ) kept_++;
+}
+
+// Skim a DevboardEvent frame
+bool DataSkim::process ( DevboardEvent *event ) {
+   unsigned long  index = frames_++;
+   DevboardSample *sample;
+   uint           count;
+   uint           fpga;
+   bool           error;
+
+   wordsIn_ += event->size() + 1;
+   if ( last_ != 0 && index >= last_ ) return(false);
+   if ( index < first_ ) return(true);
+
+   fpga  = event->fpgaAddress();
+   count = (fpga == 7 || event->isTiFrame()) ? 0 : event->count();
+
+   error = false;
+   sampleKeys_.resize(count);
+   for (uint x=0; x < count; x++) {
+      sample = event->sample(x);
+      if ( sample->error() ) error = true;
+      if ( selected(0,fpga,sample->hybrid()) ) sampleKeys_[x] = split_ ? key(0,fpga,sample->hybrid()) : 0;
+      else sampleKeys_[x] = -1;
+   }
+   if ( errorsOnly_ && ! error ) return(true);
+
+   tiFrames_ = false;
+   write(event->data(),event->size(),DevboardHeadWords,DevboardSampleWords,count);
+   return(true);
+}
+
+// Skim a TriggerEvent frame
+bool DataSkim::process ( TiTriggerEvent *event ) {
+   unsigned long index = frames_++;
+   TriggerSample sample;
+   uint          count;
+   bool          error;
+
+   wordsIn_ += event->size() + 1;
+   if ( last_ != 0 && index >= last_ ) return(false);
+   if ( index < first_ ) return(true);
+
+   if ( useTime_ ) {
+      if ( ! event->hasTiData() ) return(true);
+      if ( event->timeStamp() < timeStart_ || event->timeStamp() >= timeEnd_ ) return(true);
+   }
+
+   count = event->count();
+
+   error = false;
+   sampleKeys_.resize(count);
+   for (uint x=0; x < count; x++) {
+      event->sample(x,&sample);
+      if ( sample.error() ) error = true;
+      if ( selected(sample.rceAddress(),sample.febAddress(),sample.hybrid()) )
+         sampleKeys_[x] = split_ ? key(sample.rceAddress(),sample.febAddress(),sample.hybrid()) : 0;
+      else sampleKeys_[x] = -1;
+   }
+   if ( errorsOnly_ && ! error ) return(true);
+
+   tiFrames_ = true;
+   write(event->data(),event->size(),TrackerHeadWords,TriggerSampleWords,count);
+   return(true);
+}
+
+// Close all outputs
+bool DataSkim::close ( ) {
+   map<uint,Output *>::iterator it;
+   bool ok = true;
+
+   for (it=outputs_.begin(); it != outputs_.end(); it++) {
+      if ( it->second == NULL ) continue;
+      if ( ! (it->second->evio != NULL ? it->second->evio->close() : it->second->writer->close()) ) {
+         cout << "DataSkim::close -> Write error on " << it->second->name << endl;
+         ok = false;
+      }
+   }
+   return(ok);
+}
+
+// Frames passed in
+unsigned long DataSkim::frames ( ) {
+   return(frames_);
+}
+
+// Frames written
+unsigned long DataSkim::kept ( ) {
+   return(kept_);
+}
+
+// Words passed in
+unsigned long long DataSkim::wordsIn ( ) {
+   return(wordsIn_);
+}
+
+// Words written
+unsigned long long DataSkim::wordsOut ( ) {
+   map<uint,Output *>::iterator it;
+   unsigned long long ret = 0;
+
+   for (it=outputs_.begin(); it != outputs_.end(); it++)
+      if ( it->second != NULL ) ret += bytes(it->second) / 4;
+   return(ret);
+}
+
+// Per output report
+void DataSkim::report ( ostream &out ) {
+   map<uint,Output *>::iterator it;
+
+   for (it=outputs_.begin(); it != outputs_.end(); it++) {
+      if ( it->second == NULL ) continue;
+      out << it->second->name << " " << it->second->frames << " frames, "
+          << bytes(it->second) << " bytes" << endl;
+   }
+}
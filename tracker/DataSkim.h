@@ -0,0 +1,240 @@
+//-----------------------------------------------------------------------------
+// File          : DataSkim.h
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Skim and split of a data stream into reduced run files.
+//
+// Frames are passed in once, in file order. A frame is kept if it is inside
+// the event range, inside the TI timestamp window (TriggerEvent frames) and,
+// if requested, has a readout with the error flag set. Readouts of the kept
+// frames are filtered by RCE, FEB and hybrid and written either to a single
+// output or, in split mode, to one output per (RCE, FEB, hybrid). Frame
+// header and trailing words (APV tail, TI data) are copied unchanged, so the
+// outputs are DataRead files holding the frame format of the input.
+//
+// With setEvio(), the outputs are EVIO files written through DataWriteEvio,
+// all of them sharing one buffer pool and I/O thread, and read back by
+// DataReadEvio. Each kept frame is an event with one ROC bank, holding the
+// frame as DataReadEvio finds it: a bank tagged with the FPGA address for
+// DevboardEvent frames, a data bank and a TI data bank for TriggerEvent
+// frames. Config and status XML records go to config banks; the other XML
+// records have no EVIO form and are not written.
+//
+// Frames without readouts (DevboardEvent TI frames) go to every output that
+// is open. XML records are copied to every output in stream order; outputs
+// opened later in split mode first get the last config, status and run start
+// record seen.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+// 10/19/2026: EVIO outputs through DataWriteEvio
+//-----------------------------------------------------------------------------
+#ifndef __DATA_SKIM_H__
+#define __DATA_SKIM_H__
+
+#include <string>
+#include <map>
+#include <vector>
+#include <iostream>
+#include <sys/types.h>
+#include <Data.h>
+#include <DataWrite.h>
+#include <DataWriteEvio.h>
+using namespace std;
+
+class DevboardEvent;
+class TiTriggerEvent;
+
+//! Skim writer
+class DataSkim {
+
+      // One output file
+      struct Output {
+         string        name;
+         DataWrite     *writer;   // NULL for EVIO outputs
+         DataWriteEvio *evio;     // NULL for DataRead outputs
+         unsigned long frames;
+      };
+
+      // Outputs by key, a single output has key 0
+      map<uint,Output *> outputs_;
+
+      // Output file base name and options
+      string base_;
+      bool   compressed_;
+      uint   bufferSize_;
+      bool   split_;
+
+      // EVIO outputs, their pool, the ROC bank tag of the next frames and the frame format
+      bool              evio_;
+      DataWriteEvioPool *pool_;
+      uint              bank_;
+      bool              tiFrames_;
+      vector<uint>      event_;
+
+      // Readout selection, -1 for any
+      int rce_;
+      int feb_;
+      int hyb_;
+
+      // Frame selection
+      unsigned long      first_;
+      unsigned long      last_;
+      bool               useTime_;
+      unsigned long long timeStart_;
+      unsigned long long timeEnd_;
+      bool               errorsOnly_;
+
+      // Last XML record of each type, for outputs opened late
+      map<uint,string> xml_;
+
+      // Counters
+      unsigned long      frames_;
+      unsigned long      kept_;
+      unsigned long long wordsIn_;
+
+      // Readouts of the current frame: output key, -1 if dropped
+      vector<int>  sampleKeys_;
+      vector<uint> frameKeys_;
+
+      // Output frame
+      vector<uint> out_;
+
+      // Key from rce, feb and hybrid
+      static uint key ( uint rce, uint feb, uint hyb );
+
+      // Delete the outputs
+      void clear ( );
+
+      // Output for a key, opened on first use
+      Output *output ( uint key );
+
+      // True if a readout is selected
+      bool selected ( uint rce, uint feb, uint hyb );
+
+      // Write a frame to an output
+      void writeFrame ( Output *out, const uint *data, uint size );
+
+      // Write an XML record to an output
+      void writeXml ( Output *out, uint type, const string &xml );
+
+      // Bytes written to an output
+      static unsigned long long bytes ( Output *out );
+
+      // Write the readouts of a frame
+      void write ( uint *data, uint size, uint head, uint sampleSize, uint count );
+
+   public:
+
+      //! Constructor
+      DataSkim ( );
+
+      //! Deconstructor
+      ~DataSkim ( );
+
+      //! Only keep readouts of one RCE, FEB and hybrid, -1 for any
+      /*!
+       * \param rce RCE address
+       * \param feb FEB address
+       * \param hyb Hybrid
+      */
+      void select ( int rce, int feb, int hyb );
+
+      //! Write one output per RCE, FEB and hybrid
+      /*!
+       * \param split Split outputs
+      */
+      void setSplit ( bool split );
+
+      //! Write EVIO files instead of DataRead files, before open()
+      /*!
+       * \param evio EVIO outputs
+       * \param bank ROC bank tag of the frames, until setBank()
+      */
+      void setEvio ( bool evio, uint bank = 3 );
+
+      //! Set the ROC bank tag of the next frames of EVIO outputs
+      /*!
+       * \param bank ROC bank tag, as DataReadEvio::last_bank_tag()
+      */
+      void setBank ( uint bank );
+
+      //! Only keep frames first to last-1, counted from 0 over all frames passed in
+      /*!
+       * \param first First frame
+       * \param last Frame after the last one, 0 for no limit
+      */
+      void setEventRange ( unsigned long first, unsigned long last );
+
+      //! Only keep TriggerEvent frames with a TI timestamp in start to end-1
+      /*!
+       * \param start First timestamp
+       * \param end Timestamp after the window
+      */
+      void setTimeWindow ( unsigned long long start, unsigned long long end );
+
+      //! Only keep frames with a readout error flag set
+      /*!
+       * \param errorsOnly Errors only
+      */
+      void setErrorsOnly ( bool errorsOnly );
+
+      //! Set the output base name, returns false if the output can not be created
+      /*!
+       * Names are base.skim.bin, or base_R<rce>_F<feb>_H<hyb>.skim.bin when
+       * split, with .bz2 appended when compressed and .evio in place of .bin
+       * for EVIO outputs. Split outputs are created when their first readout
+       * arrives. EVIO outputs can not be compressed.
+       * \param base Output base name
+       * \param compressed Write bzip2 compressed files
+       * \param bufferSize Write buffer size in bytes, the EVIO block size for EVIO outputs
+      */
+      bool open ( string base, bool compressed = false, uint bufferSize = DataWrite::DefaultBuffer );
+
+      //! Copy an XML record to the outputs
+      /*!
+       * \param type Record type, Data::XmlConfig ... Data::XmlRunTime
+       * \param xml XML document
+      */
+      void xml ( uint type, string xml );
+
+      //! Skim a DevboardEvent frame, returns false once past the event range
+      /*!
+       * \param event Frame
+      */
+      bool process ( DevboardEvent *event );
+
+      //! Skim a TriggerEvent frame with TI data, returns false once past the event range
+      /*!
+       * \param event Frame
+      */
+      bool process ( TiTriggerEvent *event );
+
+      //! Close all outputs, returns false if a write failed, counters stay valid until the next open()
+      bool close ( );
+
+      //! Frames passed in
+      unsigned long frames ( );
+
+      //! Frames written to at least one output
+      unsigned long kept ( );
+
+      //! Words passed in, including record headers
+      unsigned long long wordsIn ( );
+
+      //! Words written to all outputs, including record headers
+      unsigned long long wordsOut ( );
+
+      //! Write a line per output with its name and frame count
+      /*!
+       * \param out Output stream
+      */
+      void report ( ostream &out );
+};
+
+#endif
@@ -0,0 +1,361 @@
+//-----------------------------------------------------------------------------
+// File          : DataWriteEvio.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Write EVIO (version 4) files without waiting for the disk.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+
+#include <DataWriteEvio.h>
+#include <evio.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <iostream>
+using namespace std;
+
+// Buffer alignment
+#define DATA_WRITE_EVIO_ALIGN 4096
+
+// Block header, as written by evWrite
+#define EVIO_HDSIZ      8
+#define EVIO_MAGIC      0xc0da0100
+#define EVIO_LAST_BLOCK 0x200
+
+// Allocate an aligned block buffer
+static uint *allocBlock ( uint words ) {
+   void *buffer;
+   if ( posix_memalign(&buffer,DATA_WRITE_EVIO_ALIGN,words * sizeof(uint)) != 0 ) return(NULL);
+   return((uint *)buffer);
+}
+
+// Constructor
+DataWriteEvioPool::DataWriteEvioPool ( uint buffers, uint blockWords ) {
+   uint *buffer;
+
+   blockWords_ = (blockWords < EVIO_HDSIZ + 1024) ? EVIO_HDSIZ + 1024 : blockWords;
+   running_    = false;
+   stop_       = false;
+   inFlight_   = 0;
+   pthread_mutex_init(&mutex_,NULL);
+   pthread_cond_init(&queueCond_,NULL);
+   pthread_cond_init(&doneCond_,NULL);
+
+   if ( buffers < 2 ) buffers = 2;
+   for (uint i=0; i < buffers; i++) {
+      if ( (buffer = allocBlock(blockWords_)) == NULL ) {
+         cout << "DataWriteEvioPool::DataWriteEvioPool -> Failed to allocate buffers" << endl;
+         return;
+      }
+      buffers_.push_back(buffer);
+      free_.push_back(buffer);
+   }
+
+   if ( pthread_create(&thread_,NULL,run,this) != 0 ) {
+      cout << "DataWriteEvioPool::DataWriteEvioPool -> Failed to start I/O thread" << endl;
+      return;
+   }
+   running_ = true;
+}
+
+// Deconstructor
+DataWriteEvioPool::~DataWriteEvioPool ( ) {
+   if ( running_ ) {
+      pthread_mutex_lock(&mutex_);
+      stop_ = true;
+      pthread_cond_broadcast(&queueCond_);
+      pthread_mutex_unlock(&mutex_);
+      pthread_join(thread_,NULL);
+      running_ = false;
+   }
+   for (uint i=0; i < buffers_.size(); i++) free(buffers_[i]);
+   pthread_mutex_destroy(&mutex_);
+   pthread_cond_destroy(&queueCond_);
+   pthread_cond_destroy(&doneCond_);
+}
+
+// I/O thread, writes the queued blocks in order until stopped and empty
+void *DataWriteEvioPool::run ( void *arg ) {
+   DataWriteEvioPool *pool = (DataWriteEvioPool *)arg;
+   Block             block;
+   bool              ok;
+
+   pthread_mutex_lock(&pool->mutex_);
+   while ( true ) {
+      while ( pool->queue_.empty() && ! pool->stop_ ) pthread_cond_wait(&pool->queueCond_,&pool->mutex_);
+      if ( pool->queue_.empty() ) break;
+
+      block = pool->queue_.front();
+      pool->queue_.pop_front();
+      pool->inFlight_++;
+      pthread_mutex_unlock(&pool->mutex_);
+
+      ok = pool->writeBlock(block);
+
+      pthread_mutex_lock(&pool->mutex_);
+      pool->inFlight_--;
+      if ( ! ok ) block.stream->error_ = true;
+      if ( block.owned ) free(block.buffer);
+      else pool->free_.push_back(block.buffer);
+      block.stream->pending_--;
+      pthread_cond_broadcast(&pool->doneCond_);
+   }
+   pthread_mutex_unlock(&pool->mutex_);
+   return(NULL);
+}
+
+// Write a block to its stream
+bool DataWriteEvioPool::writeBlock ( Block &block ) {
+   const char *data = (const char *)block.buffer;
+   size_t     size  = block.words * sizeof(uint);
+   int        ret;
+
+   if ( block.stream->hook_ != NULL ) {
+      hookOut_.clear();
+      if ( ! block.stream->hook_->process(block.buffer,block.words,hookOut_) ) return(false);
+      data = hookOut_.empty() ? NULL : &hookOut_[0];
+      size = hookOut_.size();
+   }
+   while ( size > 0 ) {
+      ret = ::write(block.stream->fd_,data,size);
+      if ( ret <= 0 ) return(false);
+      data += ret;
+      size -= ret;
+   }
+   return(true);
+}
+
+// Take a free buffer; if every buffer is held by a stream filling it, the pool grows
+uint *DataWriteEvioPool::acquire ( ) {
+   uint *buffer;
+
+   pthread_mutex_lock(&mutex_);
+   while ( free_.empty() && (! queue_.empty() || inFlight_ > 0) ) pthread_cond_wait(&doneCond_,&mutex_);
+   if ( free_.empty() ) {
+      if ( (buffer = allocBlock(blockWords_)) != NULL ) buffers_.push_back(buffer);
+   }
+   else {
+      buffer = free_.back();
+      free_.pop_back();
+   }
+   pthread_mutex_unlock(&mutex_);
+   return(buffer);
+}
+
+// Queue a block of a stream
+void DataWriteEvioPool::submit ( DataWriteEvio *stream, uint *buffer, uint words, bool owned ) {
+   Block block;
+
+   block.stream = stream;
+   block.buffer = buffer;
+   block.words  = words;
+   block.owned  = owned;
+
+   pthread_mutex_lock(&mutex_);
+   stream->pending_++;
+   queue_.push_back(block);
+   pthread_cond_signal(&queueCond_);
+   pthread_mutex_unlock(&mutex_);
+}
+
+// Wait until the queued blocks of a stream are written
+void DataWriteEvioPool::drain ( DataWriteEvio *stream ) {
+   pthread_mutex_lock(&mutex_);
+   while ( stream->pending_ > 0 ) pthread_cond_wait(&doneCond_,&mutex_);
+   pthread_mutex_unlock(&mutex_);
+}
+
+// Size of a block in 32 bit words
+uint DataWriteEvioPool::blockWords ( ) {
+   return(blockWords_);
+}
+
+// True if the buffers were allocated and the I/O thread is running
+bool DataWriteEvioPool::ok ( ) {
+   return(running_);
+}
+
+// Constructor
+DataWriteEvio::DataWriteEvio ( ) {
+   pool_        = NULL;
+   ownPool_     = false;
+   fd_          = -1;
+   block_       = NULL;
+   fill_        = 0;
+   count_       = 0;
+   blockNumber_ = 1;
+   pending_     = 0;
+   error_       = false;
+   hook_        = NULL;
+   events_      = 0;
+   bytes_       = 0;
+}
+
+// Deconstructor
+DataWriteEvio::~DataWriteEvio ( ) {
+   close();
+}
+
+// Fill in the header of a block and queue it
+void DataWriteEvio::submitBlock ( uint *block, uint words, uint events, bool last, bool owned ) {
+   block[0] = words;
+   block[1] = blockNumber_++;
+   block[2] = EVIO_HDSIZ;
+   block[3] = events;
+   block[4] = 0;
+   block[5] = EV_VERSION | (last ? EVIO_LAST_BLOCK : 0);
+   block[6] = events_;
+   block[7] = EVIO_MAGIC;
+   bytes_ += words * sizeof(uint);
+   pool_->submit(this,block,words,owned);
+}
+
+// Queue the current block; the last block is written even if empty
+bool DataWriteEvio::flushBlock ( bool last ) {
+   if ( block_ == NULL ) {
+      if ( ! last ) return(true);
+      if ( (block_ = pool_->acquire()) == NULL ) {
+         cout << "DataWriteEvio::close -> Failed to allocate the last block" << endl;
+         return(false);
+      }
+      fill_  = EVIO_HDSIZ;
+      count_ = 0;
+   }
+   submitBlock(block_,fill_,count_,last,false);
+   block_ = NULL;
+   fill_  = 0;
+   count_ = 0;
+   return(true);
+}
+
+// Open file
+bool DataWriteEvio::open ( string file, DataWriteEvioPool *pool ) {
+   close();
+
+   if ( pool == NULL ) {
+      pool_    = new DataWriteEvioPool(4);
+      ownPool_ = true;
+   }
+   else pool_ = pool;
+   if ( ! pool_->ok() ) {
+      cout << "DataWriteEvio::open -> No buffer pool" << endl;
+      close();
+      return(false);
+   }
+
+#ifdef O_LARGEFILE
+   fd_ = ::open(file.c_str(),O_WRONLY | O_CREAT | O_TRUNC | O_LARGEFILE,0644);
+#else
+   fd_ = ::open(file.c_str(),O_WRONLY | O_CREAT | O_TRUNC,0644);
+#endif
+   if ( fd_ < 0 ) {
+      cout << "DataWriteEvio::open -> Failed to open file: " << file << endl;
+      close();
+      return(false);
+   }
+   name_        = file;
+   block_       = NULL;
+   fill_        = 0;
+   count_       = 0;
+   blockNumber_ = 1;
+   pending_     = 0;
+   error_       = false;
+   events_      = 0;
+   bytes_       = 0;
+   return(true);
+}
+
+// Set the block hook
+void DataWriteEvio::setHook ( DataWriteEvioHook *hook ) {
+   hook_ = hook;
+}
+
+// Write an event
+bool DataWriteEvio::writeEvent ( const uint *event ) {
+   uint words;
+   uint *big;
+
+   if ( fd_ < 0 || error() ) return(false);
+   words = event[0] + 1;
+
+   // Block full
+   if ( block_ != NULL && count_ > 0 && (fill_ + words > pool_->blockWords() || count_ >= MaxBlockEvents) )
+      flushBlock(false);
+
+   // Event larger than a block goes in a block of its own
+   if ( EVIO_HDSIZ + words > pool_->blockWords() ) {
+      if ( (big = allocBlock(EVIO_HDSIZ + words)) == NULL ) {
+         cout << "DataWriteEvio::writeEvent -> Failed to allocate a block of " << words << " words" << endl;
+         return(false);
+      }
+      memcpy(big + EVIO_HDSIZ,event,words * sizeof(uint));
+      events_++;
+      submitBlock(big,EVIO_HDSIZ + words,1,false,true);
+      return(true);
+   }
+
+   if ( block_ == NULL ) {
+      if ( (block_ = pool_->acquire()) == NULL ) {
+         cout << "DataWriteEvio::writeEvent -> Failed to allocate a block" << endl;
+         return(false);
+      }
+      fill_  = EVIO_HDSIZ;
+      count_ = 0;
+   }
+   memcpy(block_ + fill_,event,words * sizeof(uint));
+   fill_ += words;
+   count_++;
+   events_++;
+   return(true);
+}
+
+// Queue the current block
+void DataWriteEvio::flush ( ) {
+   if ( fd_ >= 0 && count_ > 0 ) flushBlock(false);
+}
+
+// Close file
+bool DataWriteEvio::close ( ) {
+   bool ok = true;
+
+   if ( fd_ >= 0 ) {
+      ok = flushBlock(true);
+      pool_->drain(this);
+      if ( error() ) ok = false;
+      if ( ::close(fd_) != 0 ) ok = false;
+      fd_ = -1;
+   }
+   if ( ownPool_ ) delete pool_;
+   pool_    = NULL;
+   ownPool_ = false;
+   return(ok);
+}
+
+// Events written
+unsigned long long DataWriteEvio::events ( ) {
+   return(events_);
+}
+
+// Bytes given to the I/O thread
+unsigned long long DataWriteEvio::bytes ( ) {
+   return(bytes_);
+}
+
+// True if a write failed
+bool DataWriteEvio::error ( ) {
+   bool err;
+
+   if ( pool_ == NULL ) return(error_);
+   pthread_mutex_lock(&pool_->mutex_);
+   err = error_;
+   pthread_mutex_unlock(&pool_->mutex_);
+   return(err);
+}
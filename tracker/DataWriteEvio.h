@@ -0,0 +1,209 @@
+//-----------------------------------------------------------------------------
+// File          : DataWriteEvio.h
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Write EVIO (version 4) files without waiting for the disk.
+//
+// Each output stream packs events into EVIO blocks, in buffers taken from a
+// pool that is allocated once. A full block gets its header and is queued
+// to the I/O thread of the pool, which writes the blocks of all its streams
+// in order while the callers fill the next ones. Streams only wait when every
+// buffer of the pool is queued, which holds back producers that are faster
+// than the disk. There is no limit on the number of streams of a pool, unlike
+// the handles of evOpen.
+//
+// A stream opened without a pool gets a private one of a few buffers, which
+// makes it double buffered like DataWrite. A hook can replace each block by
+// other bytes (compression) on the I/O thread; the files are then only
+// readable by a reader undoing it. Files written without a hook are read by
+// evOpen and DataReadEvio.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#ifndef __DATA_WRITE_EVIO_H__
+#define __DATA_WRITE_EVIO_H__
+
+#include <string>
+#include <deque>
+#include <vector>
+#include <pthread.h>
+#include <sys/types.h>
+using namespace std;
+
+class DataWriteEvio;
+
+//! Transform of the blocks of a stream before they are written
+class DataWriteEvioHook {
+
+   public:
+
+      //! Deconstructor
+      virtual ~DataWriteEvioHook ( ) { }
+
+      //! Replace a block by the bytes to write, called on the I/O thread
+      /*!
+       * Returns false on failure, which marks the stream in error.
+       * \param block Block, header included
+       * \param words Block length in 32 bit words
+       * \param out Bytes to write
+      */
+      virtual bool process ( const uint *block, uint words, vector<char> &out ) = 0;
+};
+
+//! Block buffers and I/O thread shared by output streams
+class DataWriteEvioPool {
+
+      friend class DataWriteEvio;
+
+      // One queued block
+      struct Block {
+         DataWriteEvio *stream;
+         uint          *buffer;
+         uint          words;
+         bool          owned;    // Larger than a pool buffer, freed after writing
+      };
+
+      // Buffers
+      uint          blockWords_;
+      vector<uint*> buffers_;
+      vector<uint*> free_;
+
+      // Queue and I/O thread
+      deque<Block>    queue_;
+      pthread_t       thread_;
+      pthread_mutex_t mutex_;
+      pthread_cond_t  queueCond_;
+      pthread_cond_t  doneCond_;
+      uint            inFlight_;
+      bool            running_;
+      bool            stop_;
+
+      // Hook output buffer, used by the I/O thread only
+      vector<char> hookOut_;
+
+      // I/O thread
+      static void *run ( void *arg );
+
+      // Write a block to its stream, called by the I/O thread
+      bool writeBlock ( Block &block );
+
+      // Take a free buffer, waiting for one if all are queued
+      uint *acquire ( );
+
+      // Queue a block of a stream
+      void submit ( DataWriteEvio *stream, uint *buffer, uint words, bool owned );
+
+      // Wait until the queued blocks of a stream are written
+      void drain ( DataWriteEvio *stream );
+
+   public:
+
+      //! Default block size in 32 bit words, as evWrite
+      static const uint DefaultBlock = 500000;
+
+      //! Constructor
+      /*!
+       * \param buffers Number of block buffers, at least 2
+       * \param blockWords Size of a block in 32 bit words, header included
+      */
+      DataWriteEvioPool ( uint buffers = 8, uint blockWords = DefaultBlock );
+
+      //! Deconstructor, streams must be closed first
+      ~DataWriteEvioPool ( );
+
+      //! Size of a block in 32 bit words
+      uint blockWords ( );
+
+      //! True if the buffers were allocated and the I/O thread is running
+      bool ok ( );
+};
+
+//! One EVIO output stream
+class DataWriteEvio {
+
+      friend class DataWriteEvioPool;
+
+      // Pool, owned if the stream made it
+      DataWriteEvioPool *pool_;
+      bool              ownPool_;
+
+      // Output file
+      int    fd_;
+      string name_;
+
+      // Block being filled
+      uint *block_;
+      uint fill_;
+      uint count_;
+      uint blockNumber_;
+
+      // Blocks queued, protected by the pool mutex
+      uint pending_;
+      bool error_;
+
+      // Hook, NULL for none
+      DataWriteEvioHook *hook_;
+
+      // Counters
+      unsigned long long events_;
+      unsigned long long bytes_;
+
+      // Fill in the header of a block and queue it
+      void submitBlock ( uint *block, uint words, uint events, bool last, bool owned );
+
+      // Queue the current block, returns false if the last block can not be allocated
+      bool flushBlock ( bool last );
+
+   public:
+
+      //! Events per block at most, as evWrite
+      static const uint MaxBlockEvents = 10000;
+
+      //! Constructor
+      DataWriteEvio ( );
+
+      //! Deconstructor
+      ~DataWriteEvio ( );
+
+      //! Open file, returns false if it can not be created
+      /*!
+       * \param file Filename
+       * \param pool Shared pool, NULL for a private pool of 4 buffers
+      */
+      bool open ( string file, DataWriteEvioPool *pool = NULL );
+
+      //! Set the block hook, before writing the first event
+      void setHook ( DataWriteEvioHook *hook );
+
+      //! Write an event, returns false if the stream is in error
+      /*!
+       * \param event Event bank, event[0]+1 words
+      */
+      bool writeEvent ( const uint *event );
+
+      //! Queue the current block, even if not full
+      void flush ( );
+
+      //! Write the last block, wait for the queued blocks and close the file
+      /*!
+       * Returns false if a write failed.
+      */
+      bool close ( );
+
+      //! Events written
+      unsigned long long events ( );
+
+      //! Bytes given to the I/O thread, before the hook
+      unsigned long long bytes ( );
+
+      //! True if a write failed
+      bool error ( );
+};
+
+#endif
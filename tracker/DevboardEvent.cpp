@@ -13,6 +13,7 @@
 // Modification history :
 // 08/26/2011: created
 // 02/14/2012: Updates to match FPGA. Added hooks for future TI frames.
+// 10/19/2026: Temperature tables generated at build time and shared.
 //-----------------------------------------------------------------------------
 #include <iostream>
 #include <string>
@@ -23,42 +24,13 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include "DevboardEvent.h"
+#include "DevboardTemperature.h"
 using namespace std;
 
 void DevboardEvent::update() { }
 
 // Constructor
-DevboardEvent::DevboardEvent () : Data() {
-   double       temp;
-   double       tk;
-   double       res;
-   double       volt;
-   unsigned int idx;
-
-   // Fill temperature lookup table
-   temp = minTemp_;
-   while ( temp < maxTemp_ ) {
-      tk = k0_ + temp;
-      //res = t25_ * exp(coeffA_+(coeffB_/tk)+(coeffC_/(tk*tk))+(coeffD_/(tk*tk*tk)));      
-      res = constA_ * exp(beta_/tk);
-      volt = (res*vmax_)/(rdiv_+res);
-      idx = (uint)((volt / vref_) * (double)(adcCnt_-1));
-      if ( idx < adcCnt_ ) tempTable_[idx] = temp; 
-      temp += incTemp_;
-   }
-
-   // Fill new temperature lookup table
-   temp = minTemp_;
-   while ( temp < maxTemp_ ) {
-      tk = k0_ + temp;
-      //res = t25_ * exp(coeffA_+(coeffB_/tk)+(coeffC_/(tk*tk))+(coeffD_/(tk*tk*tk)));      
-      res = constA_ * exp(beta_/tk);
-      volt = (res*vmax_)/(rdiv_+res);
-      idx = (uint)((volt / vrefNew_) * (double)adcCnt_);
-      if ( idx < adcCnt_ ) tempTableNew_[idx] = temp; 
-      temp += incTemp_;
-   }
-}
+DevboardEvent::DevboardEvent () : Data() { }
 
 // Deconstructor
 DevboardEvent::~DevboardEvent () {
@@ -125,12 +97,12 @@ double DevboardEvent::temperature ( uint index, bool oldHybrid ) {
    }
 
    if (oldHybrid) {
-      return (tempTable_[adcValue]);
+      return (devboardTempTable[adcValue]);
    } else {
       if ( adcValue & 0x8000 ) convValue = ((adcValue >> 3) & 0xFFF);
       else convValue = adcValue & 0xFFF;
 
-      return (tempTableNew_[convValue]);
+      return (devboardTempTableNew[convValue]);
    }
 }
 
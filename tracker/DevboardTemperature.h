@@ -0,0 +1,1044 @@
+//-----------------------------------------------------------------------------
+// File          : DevboardTemperature.h
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Hybrid thermistor ADC count to temperature (C) tables.
+// Generated by scripts/make_temperature_table.py, do not edit.
+//-----------------------------------------------------------------------------
+#ifndef __DEVBOARD_TEMPERATURE_H__
+#define __DEVBOARD_TEMPERATURE_H__
+
+// Old hybrids, 12 bit ADC with a 2.5 V reference
+static const double devboardTempTable[4096] = {
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.66, 149.16, 148.67, 148.19, 147.71, 147.24,
+    146.77, 146.31, 145.85, 145.40, 144.96, 144.52, 144.08, 143.65,
+    143.22, 142.80, 142.38, 141.97, 141.56, 141.15, 140.75, 140.36,
+    139.96, 139.58, 139.19, 138.81, 138.43, 138.06, 137.69, 137.32,
+    136.96, 136.60, 136.24, 135.89, 135.54, 135.19, 134.85, 134.51,
+    134.17, 133.83, 133.50, 133.17, 132.84, 132.52, 132.20, 131.88,
+    131.57, 131.25, 130.94, 130.63, 130.33, 130.03, 129.72, 129.43,
+    129.13, 128.84, 128.55, 128.26, 127.97, 127.68, 127.40, 127.12,
+    126.84, 126.57, 126.29, 126.02, 125.75, 125.48, 125.21, 124.95,
+    124.69, 124.42, 124.16, 123.91, 123.65, 123.40, 123.15, 122.90,
+    122.65, 122.40, 122.15, 121.91, 121.67, 121.43, 121.19, 120.95,
+    120.71, 120.48, 120.25, 120.01, 119.78, 119.55, 119.33, 119.10,
+    118.88, 118.65, 118.43, 118.21, 117.99, 117.77, 117.56, 117.34,
+    117.13, 116.91, 116.70, 116.49, 116.28, 116.07, 115.87, 115.66,
+    115.46, 115.25, 115.05, 114.85, 114.65, 114.45, 114.25, 114.06,
+    113.86, 113.67, 113.47, 113.28, 113.09, 112.90, 112.71, 112.52,
+    112.33, 112.15, 111.96, 111.78, 111.59, 111.41, 111.23, 111.05,
+    110.87, 110.69, 110.51, 110.33, 110.15, 109.98, 109.80, 109.63,
+    109.46, 109.28, 109.11, 108.94, 108.77, 108.60, 108.43, 108.27,
+    108.10, 107.93, 107.77, 107.60, 107.44, 107.28, 107.12, 106.95,
+    106.79, 106.63, 106.47, 106.31, 106.16, 106.00, 105.84, 105.69,
+    105.53, 105.38, 105.22, 105.07, 104.92, 104.77, 104.62, 104.46,
+    104.31, 104.17, 104.02, 103.87, 103.72, 103.57, 103.43, 103.28,
+    103.14, 102.99, 102.85, 102.71, 102.56, 102.42, 102.28, 102.14,
+    102.00, 101.86, 101.72, 101.58, 101.44, 101.30, 101.17, 101.03,
+    100.89, 100.76, 100.62, 100.49, 100.35, 100.22, 100.09,  99.96,
+     99.82,  99.69,  99.56,  99.43,  99.30,  99.17,  99.04,  98.91,
+     98.78,  98.66,  98.53,  98.40,  98.28,  98.15,  98.02,  97.90,
+     97.77,  97.65,  97.53,  97.40,  97.28,  97.16,  97.04,  96.91,
+     96.79,  96.67,  96.55,  96.43,  96.31,  96.19,  96.08,  95.96,
+     95.84,  95.72,  95.60,  95.49,  95.37,  95.26,  95.14,  95.02,
+     94.91,  94.80,  94.68,  94.57,  94.45,  94.34,  94.23,  94.12,
+     94.00,  93.89,  93.78,  93.67,  93.56,  93.45,  93.34,  93.23,
+     93.12,  93.01,  92.90,  92.80,  92.69,  92.58,  92.47,  92.37,
+     92.26,  92.15,  92.05,  91.94,  91.84,  91.73,  91.63,  91.52,
+     91.42,  91.32,  91.21,  91.11,  91.01,  90.91,  90.80,  90.70,
+     90.60,  90.50,  90.40,  90.30,  90.20,  90.10,  90.00,  89.90,
+     89.80,  89.70,  89.60,  89.50,  89.40,  89.31,  89.21,  89.11,
+     89.01,  88.92,  88.82,  88.72,  88.63,  88.53,  88.44,  88.34,
+     88.25,  88.15,  88.06,  87.96,  87.87,  87.78,  87.68,  87.59,
+     87.50,  87.40,  87.31,  87.22,  87.13,  87.04,  86.94,  86.85,
+     86.76,  86.67,  86.58,  86.49,  86.40,  86.31,  86.22,  86.13,
+     86.04,  85.95,  85.86,  85.78,  85.69,  85.60,  85.51,  85.42,
+     85.34,  85.25,  85.16,  85.08,  84.99,  84.90,  84.82,  84.73,
+     84.65,  84.56,  84.47,  84.39,  84.31,  84.22,  84.14,  84.05,
+     83.97,  83.88,  83.80,  83.72,  83.63,  83.55,  83.47,  83.39,
+     83.30,  83.22,  83.14,  83.06,  82.97,  82.89,  82.81,  82.73,
+     82.65,  82.57,  82.49,  82.41,  82.33,  82.25,  82.17,  82.09,
+     82.01,  81.93,  81.85,  81.77,  81.69,  81.61,  81.54,  81.46,
+     81.38,  81.30,  81.22,  81.15,  81.07,  80.99,  80.91,  80.84,
+     80.76,  80.68,  80.61,  80.53,  80.46,  80.38,  80.30,  80.23,
+     80.15,  80.08,  80.00,  79.93,  79.85,  79.78,  79.70,  79.63,
+     79.56,  79.48,  79.41,  79.33,  79.26,  79.19,  79.11,  79.04,
+     78.97,  78.90,  78.82,  78.75,  78.68,  78.61,  78.53,  78.46,
+     78.39,  78.32,  78.25,  78.18,  78.11,  78.03,  77.96,  77.89,
+     77.82,  77.75,  77.68,  77.61,  77.54,  77.47,  77.40,  77.33,
+     77.26,  77.19,  77.12,  77.05,  76.99,  76.92,  76.85,  76.78,
+     76.71,  76.64,  76.57,  76.51,  76.44,  76.37,  76.30,  76.24,
+     76.17,  76.10,  76.03,  75.97,  75.90,  75.83,  75.77,  75.70,
+     75.63,  75.57,  75.50,  75.44,  75.37,  75.30,  75.24,  75.17,
+     75.11,  75.04,  74.98,  74.91,  74.85,  74.78,  74.72,  74.65,
+     74.59,  74.52,  74.46,  74.40,  74.33,  74.27,  74.20,  74.14,
+     74.08,  74.01,  73.95,  73.89,  73.82,  73.76,  73.70,  73.64,
+     73.57,  73.51,  73.45,  73.39,  73.32,  73.26,  73.20,  73.14,
+     73.08,  73.01,  72.95,  72.89,  72.83,  72.77,  72.71,  72.65,
+     72.58,  72.52,  72.46,  72.40,  72.34,  72.28,  72.22,  72.16,
+     72.10,  72.04,  71.98,  71.92,  71.86,  71.80,  71.74,  71.68,
+     71.62,  71.56,  71.50,  71.45,  71.39,  71.33,  71.27,  71.21,
+     71.15,  71.09,  71.03,  70.98,  70.92,  70.86,  70.80,  70.74,
+     70.69,  70.63,  70.57,  70.51,  70.46,  70.40,  70.34,  70.28,
+     70.23,  70.17,  70.11,  70.06,  70.00,  69.94,  69.89,  69.83,
+     69.77,  69.72,  69.66,  69.60,  69.55,  69.49,  69.44,  69.38,
+     69.32,  69.27,  69.21,  69.16,  69.10,  69.05,  68.99,  68.94,
+     68.88,  68.83,  68.77,  68.72,  68.66,  68.61,  68.55,  68.50,
+     68.44,  68.39,  68.34,  68.28,  68.23,  68.17,  68.12,  68.07,
+     68.01,  67.96,  67.91,  67.85,  67.80,  67.74,  67.69,  67.64,
+     67.58,  67.53,  67.48,  67.43,  67.37,  67.32,  67.27,  67.22,
+     67.16,  67.11,  67.06,  67.01,  66.95,  66.90,  66.85,  66.80,
+     66.74,  66.69,  66.64,  66.59,  66.54,  66.49,  66.43,  66.38,
+     66.33,  66.28,  66.23,  66.18,  66.13,  66.08,  66.02,  65.97,
+     65.92,  65.87,  65.82,  65.77,  65.72,  65.67,  65.62,  65.57,
+     65.52,  65.47,  65.42,  65.37,  65.32,  65.27,  65.22,  65.17,
+     65.12,  65.07,  65.02,  64.97,  64.92,  64.87,  64.82,  64.77,
+     64.72,  64.67,  64.63,  64.58,  64.53,  64.48,  64.43,  64.38,
+     64.33,  64.28,  64.24,  64.19,  64.14,  64.09,  64.04,  63.99,
+     63.95,  63.90,  63.85,  63.80,  63.75,  63.70,  63.66,  63.61,
+     63.56,  63.51,  63.47,  63.42,  63.37,  63.32,  63.28,  63.23,
+     63.18,  63.13,  63.09,  63.04,  62.99,  62.95,  62.90,  62.85,
+     62.81,  62.76,  62.71,  62.67,  62.62,  62.57,  62.53,  62.48,
+     62.43,  62.39,  62.34,  62.30,  62.25,  62.20,  62.16,  62.11,
+     62.07,  62.02,  61.97,  61.93,  61.88,  61.84,  61.79,  61.75,
+     61.70,  61.65,  61.61,  61.56,  61.52,  61.47,  61.43,  61.38,
+     61.34,  61.29,  61.25,  61.20,  61.16,  61.11,  61.07,  61.02,
+     60.98,  60.94,  60.89,  60.85,  60.80,  60.76,  60.71,  60.67,
+     60.62,  60.58,  60.54,  60.49,  60.45,  60.40,  60.36,  60.32,
+     60.27,  60.23,  60.19,  60.14,  60.10,  60.05,  60.01,  59.97,
+     59.92,  59.88,  59.84,  59.79,  59.75,  59.71,  59.66,  59.62,
+     59.58,  59.54,  59.49,  59.45,  59.41,  59.36,  59.32,  59.28,
+     59.24,  59.19,  59.15,  59.11,  59.07,  59.02,  58.98,  58.94,
+     58.90,  58.85,  58.81,  58.77,  58.73,  58.69,  58.64,  58.60,
+     58.56,  58.52,  58.48,  58.43,  58.39,  58.35,  58.31,  58.27,
+     58.23,  58.18,  58.14,  58.10,  58.06,  58.02,  57.98,  57.94,
+     57.89,  57.85,  57.81,  57.77,  57.73,  57.69,  57.65,  57.61,
+     57.57,  57.52,  57.48,  57.44,  57.40,  57.36,  57.32,  57.28,
+     57.24,  57.20,  57.16,  57.12,  57.08,  57.04,  57.00,  56.96,
+     56.92,  56.88,  56.84,  56.80,  56.76,  56.72,  56.68,  56.64,
+     56.60,  56.56,  56.52,  56.48,  56.44,  56.40,  56.36,  56.32,
+     56.28,  56.24,  56.20,  56.16,  56.12,  56.08,  56.04,  56.00,
+     55.96,  55.92,  55.88,  55.84,  55.81,  55.77,  55.73,  55.69,
+     55.65,  55.61,  55.57,  55.53,  55.49,  55.45,  55.42,  55.38,
+     55.34,  55.30,  55.26,  55.22,  55.18,  55.15,  55.11,  55.07,
+     55.03,  54.99,  54.95,  54.91,  54.88,  54.84,  54.80,  54.76,
+     54.72,  54.69,  54.65,  54.61,  54.57,  54.53,  54.50,  54.46,
+     54.42,  54.38,  54.34,  54.31,  54.27,  54.23,  54.19,  54.16,
+     54.12,  54.08,  54.04,  54.01,  53.97,  53.93,  53.89,  53.86,
+     53.82,  53.78,  53.74,  53.71,  53.67,  53.63,  53.59,  53.56,
+     53.52,  53.48,  53.45,  53.41,  53.37,  53.34,  53.30,  53.26,
+     53.23,  53.19,  53.15,  53.12,  53.08,  53.04,  53.01,  52.97,
+     52.93,  52.90,  52.86,  52.82,  52.79,  52.75,  52.71,  52.68,
+     52.64,  52.60,  52.57,  52.53,  52.50,  52.46,  52.42,  52.39,
+     52.35,  52.32,  52.28,  52.24,  52.21,  52.17,  52.14,  52.10,
+     52.06,  52.03,  51.99,  51.96,  51.92,  51.88,  51.85,  51.81,
+     51.78,  51.74,  51.71,  51.67,  51.64,  51.60,  51.57,  51.53,
+     51.49,  51.46,  51.42,  51.39,  51.35,  51.32,  51.28,  51.25,
+     51.21,  51.18,  51.14,  51.11,  51.07,  51.04,  51.00,  50.97,
+     50.93,  50.90,  50.86,  50.83,  50.79,  50.76,  50.72,  50.69,
+     50.65,  50.62,  50.58,  50.55,  50.52,  50.48,  50.45,  50.41,
+     50.38,  50.34,  50.31,  50.27,  50.24,  50.21,  50.17,  50.14,
+     50.10,  50.07,  50.03,  50.00,  49.97,  49.93,  49.90,  49.86,
+     49.83,  49.80,  49.76,  49.73,  49.69,  49.66,  49.63,  49.59,
+     49.56,  49.52,  49.49,  49.46,  49.42,  49.39,  49.36,  49.32,
+     49.29,  49.25,  49.22,  49.19,  49.15,  49.12,  49.09,  49.05,
+     49.02,  48.99,  48.95,  48.92,  48.89,  48.85,  48.82,  48.79,
+     48.75,  48.72,  48.69,  48.65,  48.62,  48.59,  48.55,  48.52,
+     48.49,  48.46,  48.42,  48.39,  48.36,  48.32,  48.29,  48.26,
+     48.22,  48.19,  48.16,  48.13,  48.09,  48.06,  48.03,  48.00,
+     47.96,  47.93,  47.90,  47.86,  47.83,  47.80,  47.77,  47.73,
+     47.70,  47.67,  47.64,  47.60,  47.57,  47.54,  47.51,  47.48,
+     47.44,  47.41,  47.38,  47.35,  47.31,  47.28,  47.25,  47.22,
+     47.19,  47.15,  47.12,  47.09,  47.06,  47.02,  46.99,  46.96,
+     46.93,  46.90,  46.86,  46.83,  46.80,  46.77,  46.74,  46.71,
+     46.67,  46.64,  46.61,  46.58,  46.55,  46.52,  46.48,  46.45,
+     46.42,  46.39,  46.36,  46.33,  46.29,  46.26,  46.23,  46.20,
+     46.17,  46.14,  46.10,  46.07,  46.04,  46.01,  45.98,  45.95,
+     45.92,  45.89,  45.85,  45.82,  45.79,  45.76,  45.73,  45.70,
+     45.67,  45.64,  45.60,  45.57,  45.54,  45.51,  45.48,  45.45,
+     45.42,  45.39,  45.36,  45.33,  45.30,  45.26,  45.23,  45.20,
+     45.17,  45.14,  45.11,  45.08,  45.05,  45.02,  44.99,  44.96,
+     44.93,  44.90,  44.86,  44.83,  44.80,  44.77,  44.74,  44.71,
+     44.68,  44.65,  44.62,  44.59,  44.56,  44.53,  44.50,  44.47,
+     44.44,  44.41,  44.38,  44.35,  44.32,  44.29,  44.26,  44.23,
+     44.20,  44.17,  44.13,  44.10,  44.07,  44.04,  44.01,  43.98,
+     43.95,  43.92,  43.89,  43.86,  43.83,  43.80,  43.77,  43.74,
+     43.71,  43.68,  43.65,  43.62,  43.59,  43.56,  43.53,  43.50,
+     43.48,  43.45,  43.42,  43.39,  43.36,  43.33,  43.30,  43.27,
+     43.24,  43.21,  43.18,  43.15,  43.12,  43.09,  43.06,  43.03,
+     43.00,  42.97,  42.94,  42.91,  42.88,  42.85,  42.82,  42.79,
+     42.76,  42.74,  42.71,  42.68,  42.65,  42.62,  42.59,  42.56,
+     42.53,  42.50,  42.47,  42.44,  42.41,  42.38,  42.36,  42.33,
+     42.30,  42.27,  42.24,  42.21,  42.18,  42.15,  42.12,  42.09,
+     42.06,  42.04,  42.01,  41.98,  41.95,  41.92,  41.89,  41.86,
+     41.83,  41.80,  41.78,  41.75,  41.72,  41.69,  41.66,  41.63,
+     41.60,  41.57,  41.54,  41.52,  41.49,  41.46,  41.43,  41.40,
+     41.37,  41.34,  41.32,  41.29,  41.26,  41.23,  41.20,  41.17,
+     41.14,  41.12,  41.09,  41.06,  41.03,  41.00,  40.97,  40.94,
+     40.92,  40.89,  40.86,  40.83,  40.80,  40.77,  40.75,  40.72,
+     40.69,  40.66,  40.63,  40.61,  40.58,  40.55,  40.52,  40.49,
+     40.46,  40.44,  40.41,  40.38,  40.35,  40.32,  40.30,  40.27,
+     40.24,  40.21,  40.18,  40.16,  40.13,  40.10,  40.07,  40.04,
+     40.02,  39.99,  39.96,  39.93,  39.90,  39.88,  39.85,  39.82,
+     39.79,  39.76,  39.74,  39.71,  39.68,  39.65,  39.63,  39.60,
+     39.57,  39.54,  39.51,  39.49,  39.46,  39.43,  39.40,  39.38,
+     39.35,  39.32,  39.29,  39.27,  39.24,  39.21,  39.18,  39.16,
+     39.13,  39.10,  39.07,  39.05,  39.02,  38.99,  38.96,  38.94,
+     38.91,  38.88,  38.85,  38.83,  38.80,  38.77,  38.74,  38.72,
+     38.69,  38.66,  38.63,  38.61,  38.58,  38.55,  38.53,  38.50,
+     38.47,  38.44,  38.42,  38.39,  38.36,  38.34,  38.31,  38.28,
+     38.25,  38.23,  38.20,  38.17,  38.15,  38.12,  38.09,  38.06,
+     38.04,  38.01,  37.98,  37.96,  37.93,  37.90,  37.88,  37.85,
+     37.82,  37.79,  37.77,  37.74,  37.71,  37.69,  37.66,  37.63,
+     37.61,  37.58,  37.55,  37.53,  37.50,  37.47,  37.45,  37.42,
+     37.39,  37.37,  37.34,  37.31,  37.29,  37.26,  37.23,  37.21,
+     37.18,  37.15,  37.13,  37.10,  37.07,  37.05,  37.02,  36.99,
+     36.97,  36.94,  36.91,  36.89,  36.86,  36.83,  36.81,  36.78,
+     36.75,  36.73,  36.70,  36.67,  36.65,  36.62,  36.60,  36.57,
+     36.54,  36.52,  36.49,  36.46,  36.44,  36.41,  36.38,  36.36,
+     36.33,  36.31,  36.28,  36.25,  36.23,  36.20,  36.17,  36.15,
+     36.12,  36.10,  36.07,  36.04,  36.02,  35.99,  35.96,  35.94,
+     35.91,  35.89,  35.86,  35.83,  35.81,  35.78,  35.76,  35.73,
+     35.70,  35.68,  35.65,  35.63,  35.60,  35.57,  35.55,  35.52,
+     35.50,  35.47,  35.44,  35.42,  35.39,  35.37,  35.34,  35.31,
+     35.29,  35.26,  35.24,  35.21,  35.18,  35.16,  35.13,  35.11,
+     35.08,  35.06,  35.03,  35.00,  34.98,  34.95,  34.93,  34.90,
+     34.88,  34.85,  34.82,  34.80,  34.77,  34.75,  34.72,  34.70,
+     34.67,  34.64,  34.62,  34.59,  34.57,  34.54,  34.52,  34.49,
+     34.46,  34.44,  34.41,  34.39,  34.36,  34.34,  34.31,  34.29,
+     34.26,  34.23,  34.21,  34.18,  34.16,  34.13,  34.11,  34.08,
+     34.06,  34.03,  34.01,  33.98,  33.95,  33.93,  33.90,  33.88,
+     33.85,  33.83,  33.80,  33.78,  33.75,  33.73,  33.70,  33.68,
+     33.65,  33.63,  33.60,  33.57,  33.55,  33.52,  33.50,  33.47,
+     33.45,  33.42,  33.40,  33.37,  33.35,  33.32,  33.30,  33.27,
+     33.25,  33.22,  33.20,  33.17,  33.15,  33.12,  33.10,  33.07,
+     33.05,  33.02,  33.00,  32.97,  32.95,  32.92,  32.90,  32.87,
+     32.85,  32.82,  32.80,  32.77,  32.75,  32.72,  32.70,  32.67,
+     32.65,  32.62,  32.60,  32.57,  32.55,  32.52,  32.50,  32.47,
+     32.45,  32.42,  32.40,  32.37,  32.35,  32.32,  32.30,  32.27,
+     32.25,  32.22,  32.20,  32.17,  32.15,  32.12,  32.10,  32.07,
+     32.05,  32.02,  32.00,  31.97,  31.95,  31.92,  31.90,  31.88,
+     31.85,  31.83,  31.80,  31.78,  31.75,  31.73,  31.70,  31.68,
+     31.65,  31.63,  31.60,  31.58,  31.55,  31.53,  31.51,  31.48,
+     31.46,  31.43,  31.41,  31.38,  31.36,  31.33,  31.31,  31.28,
+     31.26,  31.23,  31.21,  31.19,  31.16,  31.14,  31.11,  31.09,
+     31.06,  31.04,  31.01,  30.99,  30.97,  30.94,  30.92,  30.89,
+     30.87,  30.84,  30.82,  30.79,  30.77,  30.75,  30.72,  30.70,
+     30.67,  30.65,  30.62,  30.60,  30.57,  30.55,  30.53,  30.50,
+     30.48,  30.45,  30.43,  30.40,  30.38,  30.36,  30.33,  30.31,
+     30.28,  30.26,  30.23,  30.21,  30.19,  30.16,  30.14,  30.11,
+     30.09,  30.06,  30.04,  30.02,  29.99,  29.97,  29.94,  29.92,
+     29.90,  29.87,  29.85,  29.82,  29.80,  29.77,  29.75,  29.73,
+     29.70,  29.68,  29.65,  29.63,  29.61,  29.58,  29.56,  29.53,
+     29.51,  29.49,  29.46,  29.44,  29.41,  29.39,  29.37,  29.34,
+     29.32,  29.29,  29.27,  29.25,  29.22,  29.20,  29.17,  29.15,
+     29.13,  29.10,  29.08,  29.05,  29.03,  29.01,  28.98,  28.96,
+     28.93,  28.91,  28.89,  28.86,  28.84,  28.81,  28.79,  28.77,
+     28.74,  28.72,  28.69,  28.67,  28.65,  28.62,  28.60,  28.58,
+     28.55,  28.53,  28.50,  28.48,  28.46,  28.43,  28.41,  28.38,
+     28.36,  28.34,  28.31,  28.29,  28.27,  28.24,  28.22,  28.19,
+     28.17,  28.15,  28.12,  28.10,  28.08,  28.05,  28.03,  28.00,
+     27.98,  27.96,  27.93,  27.91,  27.89,  27.86,  27.84,  27.81,
+     27.79,  27.77,  27.74,  27.72,  27.70,  27.67,  27.65,  27.63,
+     27.60,  27.58,  27.55,  27.53,  27.51,  27.48,  27.46,  27.44,
+     27.41,  27.39,  27.37,  27.34,  27.32,  27.30,  27.27,  27.25,
+     27.22,  27.20,  27.18,  27.15,  27.13,  27.11,  27.08,  27.06,
+     27.04,  27.01,  26.99,  26.97,  26.94,  26.92,  26.90,  26.87,
+     26.85,  26.82,  26.80,  26.78,  26.75,  26.73,  26.71,  26.68,
+     26.66,  26.64,  26.61,  26.59,  26.57,  26.54,  26.52,  26.50,
+     26.47,  26.45,  26.43,  26.40,  26.38,  26.36,  26.33,  26.31,
+     26.29,  26.26,  26.24,  26.22,  26.19,  26.17,  26.15,  26.12,
+     26.10,  26.08,  26.05,  26.03,  26.01,  25.98,  25.96,  25.94,
+     25.91,  25.89,  25.87,  25.84,  25.82,  25.80,  25.77,  25.75,
+     25.73,  25.70,  25.68,  25.66,  25.63,  25.61,  25.59,  25.56,
+     25.54,  25.52,  25.49,  25.47,  25.45,  25.42,  25.40,  25.38,
+     25.35,  25.33,  25.31,  25.28,  25.26,  25.24,  25.22,  25.19,
+     25.17,  25.15,  25.12,  25.10,  25.08,  25.05,  25.03,  25.01,
+     24.98,  24.96,  24.94,  24.91,  24.89,  24.87,  24.84,  24.82,
+     24.80,  24.78,  24.75,  24.73,  24.71,  24.68,  24.66,  24.64,
+     24.61,  24.59,  24.57,  24.54,  24.52,  24.50,  24.47,  24.45,
+     24.43,  24.41,  24.38,  24.36,  24.34,  24.31,  24.29,  24.27,
+     24.24,  24.22,  24.20,  24.18,  24.15,  24.13,  24.11,  24.08,
+     24.06,  24.04,  24.01,  23.99,  23.97,  23.94,  23.92,  23.90,
+     23.88,  23.85,  23.83,  23.81,  23.78,  23.76,  23.74,  23.72,
+     23.69,  23.67,  23.65,  23.62,  23.60,  23.58,  23.55,  23.53,
+     23.51,  23.49,  23.46,  23.44,  23.42,  23.39,  23.37,  23.35,
+     23.32,  23.30,  23.28,  23.26,  23.23,  23.21,  23.19,  23.16,
+     23.14,  23.12,  23.10,  23.07,  23.05,  23.03,  23.00,  22.98,
+     22.96,  22.94,  22.91,  22.89,  22.87,  22.84,  22.82,  22.80,
+     22.78,  22.75,  22.73,  22.71,  22.68,  22.66,  22.64,  22.62,
+     22.59,  22.57,  22.55,  22.52,  22.50,  22.48,  22.46,  22.43,
+     22.41,  22.39,  22.36,  22.34,  22.32,  22.30,  22.27,  22.25,
+     22.23,  22.20,  22.18,  22.16,  22.14,  22.11,  22.09,  22.07,
+     22.05,  22.02,  22.00,  21.98,  21.95,  21.93,  21.91,  21.89,
+     21.86,  21.84,  21.82,  21.79,  21.77,  21.75,  21.73,  21.70,
+     21.68,  21.66,  21.64,  21.61,  21.59,  21.57,  21.54,  21.52,
+     21.50,  21.48,  21.45,  21.43,  21.41,  21.39,  21.36,  21.34,
+     21.32,  21.29,  21.27,  21.25,  21.23,  21.20,  21.18,  21.16,
+     21.14,  21.11,  21.09,  21.07,  21.04,  21.02,  21.00,  20.98,
+     20.95,  20.93,  20.91,  20.89,  20.86,  20.84,  20.82,  20.79,
+     20.77,  20.75,  20.73,  20.70,  20.68,  20.66,  20.64,  20.61,
+     20.59,  20.57,  20.55,  20.52,  20.50,  20.48,  20.45,  20.43,
+     20.41,  20.39,  20.36,  20.34,  20.32,  20.30,  20.27,  20.25,
+     20.23,  20.21,  20.18,  20.16,  20.14,  20.11,  20.09,  20.07,
+     20.05,  20.02,  20.00,  19.98,  19.96,  19.93,  19.91,  19.89,
+     19.87,  19.84,  19.82,  19.80,  19.77,  19.75,  19.73,  19.71,
+     19.68,  19.66,  19.64,  19.62,  19.59,  19.57,  19.55,  19.53,
+     19.50,  19.48,  19.46,  19.44,  19.41,  19.39,  19.37,  19.35,
+     19.32,  19.30,  19.28,  19.25,  19.23,  19.21,  19.19,  19.16,
+     19.14,  19.12,  19.10,  19.07,  19.05,  19.03,  19.01,  18.98,
+     18.96,  18.94,  18.92,  18.89,  18.87,  18.85,  18.83,  18.80,
+     18.78,  18.76,  18.73,  18.71,  18.69,  18.67,  18.64,  18.62,
+     18.60,  18.58,  18.55,  18.53,  18.51,  18.49,  18.46,  18.44,
+     18.42,  18.40,  18.37,  18.35,  18.33,  18.31,  18.28,  18.26,
+     18.24,  18.22,  18.19,  18.17,  18.15,  18.12,  18.10,  18.08,
+     18.06,  18.03,  18.01,  17.99,  17.97,  17.94,  17.92,  17.90,
+     17.88,  17.85,  17.83,  17.81,  17.79,  17.76,  17.74,  17.72,
+     17.70,  17.67,  17.65,  17.63,  17.61,  17.58,  17.56,  17.54,
+     17.51,  17.49,  17.47,  17.45,  17.42,  17.40,  17.38,  17.36,
+     17.33,  17.31,  17.29,  17.27,  17.24,  17.22,  17.20,  17.18,
+     17.15,  17.13,  17.11,  17.09,  17.06,  17.04,  17.02,  17.00,
+     16.97,  16.95,  16.93,  16.90,  16.88,  16.86,  16.84,  16.81,
+     16.79,  16.77,  16.75,  16.72,  16.70,  16.68,  16.66,  16.63,
+     16.61,  16.59,  16.57,  16.54,  16.52,  16.50,  16.48,  16.45,
+     16.43,  16.41,  16.38,  16.36,  16.34,  16.32,  16.29,  16.27,
+     16.25,  16.23,  16.20,  16.18,  16.16,  16.14,  16.11,  16.09,
+     16.07,  16.05,  16.02,  16.00,  15.98,  15.96,  15.93,  15.91,
+     15.89,  15.86,  15.84,  15.82,  15.80,  15.77,  15.75,  15.73,
+     15.71,  15.68,  15.66,  15.64,  15.62,  15.59,  15.57,  15.55,
+     15.53,  15.50,  15.48,  15.46,  15.43,  15.41,  15.39,  15.37,
+     15.34,  15.32,  15.30,  15.28,  15.25,  15.23,  15.21,  15.19,
+     15.16,  15.14,  15.12,  15.09,  15.07,  15.05,  15.03,  15.00,
+     14.98,  14.96,  14.94,  14.91,  14.89,  14.87,  14.85,  14.82,
+     14.80,  14.78,  14.75,  14.73,  14.71,  14.69,  14.66,  14.64,
+     14.62,  14.60,  14.57,  14.55,  14.53,  14.50,  14.48,  14.46,
+     14.44,  14.41,  14.39,  14.37,  14.35,  14.32,  14.30,  14.28,
+     14.25,  14.23,  14.21,  14.19,  14.16,  14.14,  14.12,  14.10,
+     14.07,  14.05,  14.03,  14.00,  13.98,  13.96,  13.94,  13.91,
+     13.89,  13.87,  13.85,  13.82,  13.80,  13.78,  13.75,  13.73,
+     13.71,  13.69,  13.66,  13.64,  13.62,  13.60,  13.57,  13.55,
+     13.53,  13.50,  13.48,  13.46,  13.44,  13.41,  13.39,  13.37,
+     13.34,  13.32,  13.30,  13.28,  13.25,  13.23,  13.21,  13.18,
+     13.16,  13.14,  13.12,  13.09,  13.07,  13.05,  13.02,  13.00,
+     12.98,  12.96,  12.93,  12.91,  12.89,  12.86,  12.84,  12.82,
+     12.80,  12.77,  12.75,  12.73,  12.70,  12.68,  12.66,  12.64,
+     12.61,  12.59,  12.57,  12.54,  12.52,  12.50,  12.48,  12.45,
+     12.43,  12.41,  12.38,  12.36,  12.34,  12.32,  12.29,  12.27,
+     12.25,  12.22,  12.20,  12.18,  12.15,  12.13,  12.11,  12.09,
+     12.06,  12.04,  12.02,  11.99,  11.97,  11.95,  11.93,  11.90,
+     11.88,  11.86,  11.83,  11.81,  11.79,  11.76,  11.74,  11.72,
+     11.70,  11.67,  11.65,  11.63,  11.60,  11.58,  11.56,  11.53,
+     11.51,  11.49,  11.46,  11.44,  11.42,  11.40,  11.37,  11.35,
+     11.33,  11.30,  11.28,  11.26,  11.23,  11.21,  11.19,  11.17,
+     11.14,  11.12,  11.10,  11.07,  11.05,  11.03,  11.00,  10.98,
+     10.96,  10.93,  10.91,  10.89,  10.86,  10.84,  10.82,  10.80,
+     10.77,  10.75,  10.73,  10.70,  10.68,  10.66,  10.63,  10.61,
+     10.59,  10.56,  10.54,  10.52,  10.49,  10.47,  10.45,  10.42,
+     10.40,  10.38,  10.35,  10.33,  10.31,  10.28,  10.26,  10.24,
+     10.22,  10.19,  10.17,  10.15,  10.12,  10.10,  10.08,  10.05,
+     10.03,  10.01,   9.98,   9.96,   9.94,   9.91,   9.89,   9.87,
+      9.84,   9.82,   9.80,   9.77,   9.75,   9.73,   9.70,   9.68,
+      9.66,   9.63,   9.61,   9.59,   9.56,   9.54,   9.52,   9.49,
+      9.47,   9.45,   9.42,   9.40,   9.38,   9.35,   9.33,   9.31,
+      9.28,   9.26,   9.23,   9.21,   9.19,   9.16,   9.14,   9.12,
+      9.09,   9.07,   9.05,   9.02,   9.00,   8.98,   8.95,   8.93,
+      8.91,   8.88,   8.86,   8.84,   8.81,   8.79,   8.77,   8.74,
+      8.72,   8.69,   8.67,   8.65,   8.62,   8.60,   8.58,   8.55,
+      8.53,   8.51,   8.48,   8.46,   8.44,   8.41,   8.39,   8.36,
+      8.34,   8.32,   8.29,   8.27,   8.25,   8.22,   8.20,   8.18,
+      8.15,   8.13,   8.10,   8.08,   8.06,   8.03,   8.01,   7.99,
+      7.96,   7.94,   7.91,   7.89,   7.87,   7.84,   7.82,   7.80,
+      7.77,   7.75,   7.72,   7.70,   7.68,   7.65,   7.63,   7.61,
+      7.58,   7.56,   7.53,   7.51,   7.49,   7.46,   7.44,   7.41,
+      7.39,   7.37,   7.34,   7.32,   7.30,   7.27,   7.25,   7.22,
+      7.20,   7.18,   7.15,   7.13,   7.10,   7.08,   7.06,   7.03,
+      7.01,   6.98,   6.96,   6.94,   6.91,   6.89,   6.86,   6.84,
+      6.82,   6.79,   6.77,   6.74,   6.72,   6.70,   6.67,   6.65,
+      6.62,   6.60,   6.58,   6.55,   6.53,   6.50,   6.48,   6.46,
+      6.43,   6.41,   6.38,   6.36,   6.33,   6.31,   6.29,   6.26,
+      6.24,   6.21,   6.19,   6.17,   6.14,   6.12,   6.09,   6.07,
+      6.04,   6.02,   6.00,   5.97,   5.95,   5.92,   5.90,   5.87,
+      5.85,   5.83,   5.80,   5.78,   5.75,   5.73,   5.70,   5.68,
+      5.66,   5.63,   5.61,   5.58,   5.56,   5.53,   5.51,   5.49,
+      5.46,   5.44,   5.41,   5.39,   5.36,   5.34,   5.31,   5.29,
+      5.27,   5.24,   5.22,   5.19,   5.17,   5.14,   5.12,   5.09,
+      5.07,   5.04,   5.02,   5.00,   4.97,   4.95,   4.92,   4.90,
+      4.87,   4.85,   4.82,   4.80,   4.77,   4.75,   4.72,   4.70,
+      4.68,   4.65,   4.63,   4.60,   4.58,   4.55,   4.53,   4.50,
+      4.48,   4.45,   4.43,   4.40,   4.38,   4.35,   4.33,   4.30,
+      4.28,   4.25,   4.23,   4.21,   4.18,   4.16,   4.13,   4.11,
+      4.08,   4.06,   4.03,   4.01,   3.98,   3.96,   3.93,   3.91,
+      3.88,   3.86,   3.83,   3.81,   3.78,   3.76,   3.73,   3.71,
+      3.68,   3.66,   3.63,   3.61,   3.58,   3.56,   3.53,   3.51,
+      3.48,   3.46,   3.43,   3.41,   3.38,   3.36,   3.33,   3.31,
+      3.28,   3.26,   3.23,   3.20,   3.18,   3.15,   3.13,   3.10,
+      3.08,   3.05,   3.03,   3.00,   2.98,   2.95,   2.93,   2.90,
+      2.88,   2.85,   2.83,   2.80,   2.77,   2.75,   2.72,   2.70,
+      2.67,   2.65,   2.62,   2.60,   2.57,   2.55,   2.52,   2.50,
+      2.47,   2.44,   2.42,   2.39,   2.37,   2.34,   2.32,   2.29,
+      2.27,   2.24,   2.21,   2.19,   2.16,   2.14,   2.11,   2.09,
+      2.06,   2.03,   2.01,   1.98,   1.96,   1.93,   1.91,   1.88,
+      1.85,   1.83,   1.80,   1.78,   1.75,   1.73,   1.70,   1.67,
+      1.65,   1.62,   1.60,   1.57,   1.54,   1.52,   1.49,   1.47,
+      1.44,   1.42,   1.39,   1.36,   1.34,   1.31,   1.29,   1.26,
+      1.23,   1.21,   1.18,   1.16,   1.13,   1.10,   1.08,   1.05,
+      1.02,   1.00,   0.97,   0.95,   0.92,   0.89,   0.87,   0.84,
+      0.82,   0.79,   0.76,   0.74,   0.71,   0.68,   0.66,   0.63,
+      0.61,   0.58,   0.55,   0.53,   0.50,   0.47,   0.45,   0.42,
+      0.39,   0.37,   0.34,   0.32,   0.29,   0.26,   0.24,   0.21,
+      0.18,   0.16,   0.13,   0.10,   0.08,   0.05,   0.02,  -0.00,
+     -0.03,  -0.06,  -0.08,  -0.11,  -0.14,  -0.16,  -0.19,  -0.22,
+     -0.24,  -0.27,  -0.30,  -0.32,  -0.35,  -0.38,  -0.40,  -0.43,
+     -0.46,  -0.48,  -0.51,  -0.54,  -0.57,  -0.59,  -0.62,  -0.65,
+     -0.67,  -0.70,  -0.73,  -0.75,  -0.78,  -0.81,  -0.83,  -0.86,
+     -0.89,  -0.92,  -0.94,  -0.97,  -1.00,  -1.02,  -1.05,  -1.08,
+     -1.11,  -1.13,  -1.16,  -1.19,  -1.22,  -1.24,  -1.27,  -1.30,
+     -1.32,  -1.35,  -1.38,  -1.41,  -1.43,  -1.46,  -1.49,  -1.52,
+     -1.54,  -1.57,  -1.60,  -1.63,  -1.65,  -1.68,  -1.71,  -1.74,
+     -1.76,  -1.79,  -1.82,  -1.85,  -1.87,  -1.90,  -1.93,  -1.96,
+     -1.98,  -2.01,  -2.04,  -2.07,  -2.09,  -2.12,  -2.15,  -2.18,
+     -2.21,  -2.23,  -2.26,  -2.29,  -2.32,  -2.35,  -2.37,  -2.40,
+     -2.43,  -2.46,  -2.48,  -2.51,  -2.54,  -2.57,  -2.60,  -2.63,
+     -2.65,  -2.68,  -2.71,  -2.74,  -2.77,  -2.79,  -2.82,  -2.85,
+     -2.88,  -2.91,  -2.93,  -2.96,  -2.99,  -3.02,  -3.05,  -3.08,
+     -3.10,  -3.13,  -3.16,  -3.19,  -3.22,  -3.25,  -3.28,  -3.30,
+     -3.33,  -3.36,  -3.39,  -3.42,  -3.45,  -3.47,  -3.50,  -3.53,
+     -3.56,  -3.59,  -3.62,  -3.65,  -3.68,  -3.70,  -3.73,  -3.76,
+     -3.79,  -3.82,  -3.85,  -3.88,  -3.91,  -3.93,  -3.96,  -3.99,
+     -4.02,  -4.05,  -4.08,  -4.11,  -4.14,  -4.17,  -4.20,  -4.22,
+     -4.25,  -4.28,  -4.31,  -4.34,  -4.37,  -4.40,  -4.43,  -4.46,
+     -4.49,  -4.52,  -4.55,  -4.58,  -4.60,  -4.63,  -4.66,  -4.69,
+     -4.72,  -4.75,  -4.78,  -4.81,  -4.84,  -4.87,  -4.90,  -4.93,
+     -4.96,  -4.99,  -5.02,  -5.05,  -5.08,  -5.11,  -5.14,  -5.17,
+     -5.20,  -5.23,  -5.26,  -5.29,  -5.32,  -5.34,  -5.37,  -5.40,
+     -5.43,  -5.46,  -5.49,  -5.52,  -5.55,  -5.58,  -5.61,  -5.64,
+     -5.67,  -5.71,  -5.74,  -5.77,  -5.80,  -5.83,  -5.86,  -5.89,
+     -5.92,  -5.95,  -5.98,  -6.01,  -6.04,  -6.07,  -6.10,  -6.13,
+     -6.16,  -6.19,  -6.22,  -6.25,  -6.28,  -6.31,  -6.34,  -6.37,
+     -6.40,  -6.44,  -6.47,  -6.50,  -6.53,  -6.56,  -6.59,  -6.62,
+     -6.65,  -6.68,  -6.71,  -6.74,  -6.77,  -6.81,  -6.84,  -6.87,
+     -6.90,  -6.93,  -6.96,  -6.99,  -7.02,  -7.05,  -7.09,  -7.12,
+     -7.15,  -7.18,  -7.21,  -7.24,  -7.27,  -7.31,  -7.34,  -7.37,
+     -7.40,  -7.43,  -7.46,  -7.49,  -7.53,  -7.56,  -7.59,  -7.62,
+     -7.65,  -7.68,  -7.72,  -7.75,  -7.78,  -7.81,  -7.84,  -7.87,
+     -7.91,  -7.94,  -7.97,  -8.00,  -8.03,  -8.07,  -8.10,  -8.13,
+     -8.16,  -8.20,  -8.23,  -8.26,  -8.29,  -8.32,  -8.36,  -8.39,
+     -8.42,  -8.45,  -8.49,  -8.52,  -8.55,  -8.58,  -8.62,  -8.65,
+     -8.68,  -8.71,  -8.75,  -8.78,  -8.81,  -8.84,  -8.88,  -8.91,
+     -8.94,  -8.98,  -9.01,  -9.04,  -9.08,  -9.11,  -9.14,  -9.17,
+     -9.21,  -9.24,  -9.27,  -9.31,  -9.34,  -9.37,  -9.41,  -9.44,
+     -9.47,  -9.51,  -9.54,  -9.57,  -9.61,  -9.64,  -9.67,  -9.71,
+     -9.74,  -9.77,  -9.81,  -9.84,  -9.88,  -9.91,  -9.94,  -9.98,
+    -10.01, -10.05, -10.08, -10.11, -10.15, -10.18, -10.22, -10.25,
+    -10.28, -10.32, -10.35, -10.39, -10.42, -10.45, -10.49, -10.52,
+    -10.56, -10.59, -10.63, -10.66, -10.70, -10.73, -10.77, -10.80,
+    -10.83, -10.87, -10.90, -10.94, -10.97, -11.01, -11.04, -11.08,
+    -11.11, -11.15, -11.18, -11.22, -11.25, -11.29, -11.32, -11.36,
+    -11.40, -11.43, -11.47, -11.50, -11.54, -11.57, -11.61, -11.64,
+    -11.68, -11.71, -11.75, -11.79, -11.82, -11.86, -11.89, -11.93,
+    -11.97, -12.00, -12.04, -12.07, -12.11, -12.15, -12.18, -12.22,
+    -12.25, -12.29, -12.33, -12.36, -12.40, -12.44, -12.47, -12.51,
+    -12.55, -12.58, -12.62, -12.66, -12.69, -12.73, -12.77, -12.80,
+    -12.84, -12.88, -12.92, -12.95, -12.99, -13.03, -13.06, -13.10,
+    -13.14, -13.18, -13.21, -13.25, -13.29, -13.33, -13.36, -13.40,
+    -13.44, -13.48, -13.51, -13.55, -13.59, -13.63, -13.67, -13.70,
+    -13.74, -13.78, -13.82, -13.86, -13.89, -13.93, -13.97, -14.01,
+    -14.05, -14.09, -14.13, -14.16, -14.20, -14.24, -14.28, -14.32,
+    -14.36, -14.40, -14.44, -14.47, -14.51, -14.55, -14.59, -14.63,
+    -14.67, -14.71, -14.75, -14.79, -14.83, -14.87, -14.91, -14.95,
+    -14.99, -15.03, -15.07, -15.11, -15.15, -15.19, -15.23, -15.27,
+    -15.31, -15.35, -15.39, -15.43, -15.47, -15.51, -15.55, -15.59,
+    -15.63, -15.67, -15.71, -15.75, -15.79, -15.83, -15.87, -15.92,
+    -15.96, -16.00, -16.04, -16.08, -16.12, -16.16, -16.20, -16.25,
+    -16.29, -16.33, -16.37, -16.41, -16.45, -16.50, -16.54, -16.58,
+    -16.62, -16.66, -16.71, -16.75, -16.79, -16.83, -16.88, -16.92,
+    -16.96, -17.00, -17.05, -17.09, -17.13, -17.18, -17.22, -17.26,
+    -17.30, -17.35, -17.39, -17.43, -17.48, -17.52, -17.56, -17.61,
+    -17.65, -17.70, -17.74, -17.78, -17.83, -17.87, -17.92, -17.96,
+    -18.00, -18.05, -18.09, -18.14, -18.18, -18.23, -18.27, -18.32,
+    -18.36, -18.41, -18.45, -18.50, -18.54, -18.59, -18.63, -18.68,
+    -18.72, -18.77, -18.81, -18.86, -18.91, -18.95, -19.00, -19.04,
+    -19.09, -19.14, -19.18, -19.23, -19.27, -19.32, -19.37, -19.41,
+    -19.46, -19.51, -19.55, -19.60, -19.65, -19.70, -19.74, -19.79,
+    -19.84, -19.89, -19.93, -19.98, -20.03, -20.08, -20.13, -20.17,
+    -20.22, -20.27, -20.32, -20.37, -20.42, -20.46, -20.51, -20.56,
+    -20.61, -20.66, -20.71, -20.76, -20.81, -20.86, -20.91, -20.96,
+    -21.01, -21.06, -21.10, -21.16, -21.21, -21.26, -21.31, -21.36,
+    -21.41, -21.46, -21.51, -21.56, -21.61, -21.66, -21.71, -21.76,
+    -21.81, -21.87, -21.92, -21.97, -22.02, -22.07, -22.13, -22.18,
+    -22.23, -22.28, -22.33, -22.39, -22.44, -22.49, -22.55, -22.60,
+    -22.65, -22.71, -22.76, -22.81, -22.87, -22.92, -22.97, -23.03,
+    -23.08, -23.14, -23.19, -23.24, -23.30, -23.35, -23.41, -23.46,
+    -23.52, -23.57, -23.63, -23.69, -23.74, -23.80, -23.85, -23.91,
+    -23.97, -24.02, -24.08, -24.14, -24.19, -24.25, -24.31, -24.36,
+    -24.42, -24.48, -24.54, -24.59, -24.65, -24.71, -24.77, -24.83,
+    -24.88, -24.94, -25.00, -25.06, -25.12, -25.18, -25.24, -25.30,
+    -25.36, -25.42, -25.48, -25.54, -25.60, -25.66, -25.72, -25.78,
+    -25.84, -25.90, -25.96, -26.03, -26.09, -26.15, -26.21, -26.27,
+    -26.34, -26.40, -26.46, -26.52, -26.59, -26.65, -26.71, -26.78,
+    -26.84, -26.91, -26.97, -27.03, -27.10, -27.16, -27.23, -27.29,
+    -27.36, -27.42, -27.49, -27.56, -27.62, -27.69, -27.76, -27.82,
+    -27.89, -27.96, -28.02, -28.09, -28.16, -28.23, -28.30, -28.36,
+    -28.43, -28.50, -28.57, -28.64, -28.71, -28.78, -28.85, -28.92,
+    -28.99, -29.06, -29.13, -29.20, -29.27, -29.35, -29.42, -29.49,
+    -29.56, -29.64, -29.71, -29.78, -29.86, -29.93, -30.00, -30.08,
+    -30.15, -30.23, -30.30, -30.38, -30.45, -30.53, -30.61, -30.68,
+    -30.76, -30.84, -30.91, -30.99, -31.07, -31.15, -31.23, -31.30,
+    -31.38, -31.46, -31.54, -31.62, -31.70, -31.78, -31.86, -31.95,
+    -32.03, -32.11, -32.19, -32.28, -32.36, -32.44, -32.53, -32.61,
+    -32.69, -32.78, -32.86, -32.95, -33.04, -33.12, -33.21, -33.30,
+    -33.38, -33.47, -33.56, -33.65, -33.74, -33.83, -33.92, -34.01,
+    -34.10, -34.19, -34.28, -34.37, -34.47, -34.56, -34.65, -34.75,
+    -34.84, -34.93, -35.03, -35.13, -35.22, -35.32, -35.42, -35.51,
+    -35.61, -35.71, -35.81, -35.91, -36.01, -36.11, -36.21, -36.31,
+    -36.42, -36.52, -36.62, -36.73, -36.83, -36.94, -37.04, -37.15,
+    -37.26, -37.36, -37.47, -37.58, -37.69, -37.80, -37.91, -38.03,
+    -38.14, -38.25, -38.36, -38.48, -38.59, -38.71, -38.83, -38.95,
+    -39.06, -39.18, -39.30, -39.42, -39.55, -39.67, -39.79, -39.91,
+    -40.04, -40.17, -40.29, -40.42, -40.55, -40.68, -40.81, -40.94,
+    -41.07, -41.21, -41.34, -41.48, -41.61, -41.75, -41.89, -42.03,
+    -42.17, -42.31, -42.46, -42.60, -42.75, -42.89, -43.04, -43.19,
+    -43.34, -43.50, -43.65, -43.81, -43.96, -44.12, -44.28, -44.44,
+    -44.60, -44.77, -44.93, -45.10, -45.27, -45.44, -45.62, -45.79,
+    -45.97, -46.15, -46.33, -46.51, -46.69, -46.88, -47.07, -47.26,
+    -47.45, -47.65, -47.85, -48.05, -48.25, -48.46, -48.67, -48.88,
+    -49.09, -49.31, -49.53, -49.75, -49.98, -49.98, -49.98, -49.98,
+    -49.98, -49.98, -49.98, -49.98, -49.98, -49.98, -49.98, -49.98,
+    -49.98, -49.98, -49.98, -49.98, -49.98, -49.98, -49.98, -49.98,
+    -49.98, -49.98, -49.98, -49.98, -49.98, -49.98, -49.98, -49.98,
+    -49.98, -49.98, -49.98, -49.98, -49.98, -49.98, -49.98, -49.98,
+    -49.98, -49.98, -49.98, -49.98, -49.98, -49.98, -49.98, -49.98,
+    -49.98, -49.98, -49.98, -49.98, -49.98, -49.98, -49.98, -49.98,
+    -49.98, -49.98, -49.98, -49.98, -49.98, -49.98, -49.98, -49.98
+};
+
+// New hybrids, 12 bit ADC with a 2.048 V reference
+static const double devboardTempTableNew[4096] = {
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99,
+    149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.99, 149.92,
+    149.52, 149.11, 148.71, 148.31, 147.92, 147.53, 147.15, 146.76,
+    146.39, 146.01, 145.64, 145.27, 144.91, 144.55, 144.19, 143.84,
+    143.48, 143.14, 142.79, 142.45, 142.11, 141.77, 141.44, 141.11,
+    140.78, 140.45, 140.13, 139.81, 139.49, 139.18, 138.87, 138.56,
+    138.25, 137.94, 137.64, 137.34, 137.04, 136.75, 136.45, 136.16,
+    135.87, 135.59, 135.30, 135.02, 134.74, 134.46, 134.18, 133.91,
+    133.64, 133.36, 133.10, 132.83, 132.56, 132.30, 132.04, 131.78,
+    131.52, 131.26, 131.01, 130.76, 130.51, 130.26, 130.01, 129.76,
+    129.52, 129.27, 129.03, 128.79, 128.55, 128.32, 128.08, 127.85,
+    127.61, 127.38, 127.15, 126.92, 126.70, 126.47, 126.25, 126.02,
+    125.80, 125.58, 125.36, 125.14, 124.93, 124.71, 124.50, 124.29,
+    124.07, 123.86, 123.65, 123.45, 123.24, 123.03, 122.83, 122.63,
+    122.42, 122.22, 122.02, 121.82, 121.62, 121.43, 121.23, 121.04,
+    120.84, 120.65, 120.46, 120.27, 120.08, 119.89, 119.70, 119.51,
+    119.33, 119.14, 118.96, 118.77, 118.59, 118.41, 118.23, 118.05,
+    117.87, 117.69, 117.51, 117.34, 117.16, 116.99, 116.81, 116.64,
+    116.47, 116.30, 116.13, 115.96, 115.79, 115.62, 115.45, 115.29,
+    115.12, 114.95, 114.79, 114.63, 114.46, 114.30, 114.14, 113.98,
+    113.82, 113.66, 113.50, 113.34, 113.19, 113.03, 112.87, 112.72,
+    112.56, 112.41, 112.26, 112.10, 111.95, 111.80, 111.65, 111.50,
+    111.35, 111.20, 111.05, 110.91, 110.76, 110.61, 110.47, 110.32,
+    110.18, 110.03, 109.89, 109.75, 109.60, 109.46, 109.32, 109.18,
+    109.04, 108.90, 108.76, 108.62, 108.48, 108.35, 108.21, 108.07,
+    107.94, 107.80, 107.67, 107.53, 107.40, 107.27, 107.13, 107.00,
+    106.87, 106.74, 106.61, 106.48, 106.35, 106.22, 106.09, 105.96,
+    105.83, 105.70, 105.58, 105.45, 105.32, 105.20, 105.07, 104.95,
+    104.82, 104.70, 104.57, 104.45, 104.33, 104.21, 104.08, 103.96,
+    103.84, 103.72, 103.60, 103.48, 103.36, 103.24, 103.12, 103.00,
+    102.89, 102.77, 102.65, 102.54, 102.42, 102.30, 102.19, 102.07,
+    101.96, 101.84, 101.73, 101.62, 101.50, 101.39, 101.28, 101.16,
+    101.05, 100.94, 100.83, 100.72, 100.61, 100.50, 100.39, 100.28,
+    100.17, 100.06,  99.95,  99.84,  99.74,  99.63,  99.52,  99.41,
+     99.31,  99.20,  99.10,  98.99,  98.88,  98.78,  98.67,  98.57,
+     98.47,  98.36,  98.26,  98.16,  98.05,  97.95,  97.85,  97.75,
+     97.64,  97.54,  97.44,  97.34,  97.24,  97.14,  97.04,  96.94,
+     96.84,  96.74,  96.64,  96.55,  96.45,  96.35,  96.25,  96.15,
+     96.06,  95.96,  95.86,  95.77,  95.67,  95.58,  95.48,  95.38,
+     95.29,  95.19,  95.10,  95.01,  94.91,  94.82,  94.72,  94.63,
+     94.54,  94.45,  94.35,  94.26,  94.17,  94.08,  93.99,  93.89,
+     93.80,  93.71,  93.62,  93.53,  93.44,  93.35,  93.26,  93.17,
+     93.08,  92.99,  92.90,  92.82,  92.73,  92.64,  92.55,  92.46,
+     92.38,  92.29,  92.20,  92.12,  92.03,  91.94,  91.86,  91.77,
+     91.68,  91.60,  91.51,  91.43,  91.34,  91.26,  91.17,  91.09,
+     91.01,  90.92,  90.84,  90.75,  90.67,  90.59,  90.51,  90.42,
+     90.34,  90.26,  90.18,  90.09,  90.01,  89.93,  89.85,  89.77,
+     89.69,  89.61,  89.53,  89.44,  89.36,  89.28,  89.20,  89.13,
+     89.05,  88.97,  88.89,  88.81,  88.73,  88.65,  88.57,  88.49,
+     88.42,  88.34,  88.26,  88.18,  88.10,  88.03,  87.95,  87.87,
+     87.80,  87.72,  87.64,  87.57,  87.49,  87.42,  87.34,  87.26,
+     87.19,  87.11,  87.04,  86.96,  86.89,  86.81,  86.74,  86.67,
+     86.59,  86.52,  86.44,  86.37,  86.30,  86.22,  86.15,  86.08,
+     86.00,  85.93,  85.86,  85.79,  85.71,  85.64,  85.57,  85.50,
+     85.43,  85.35,  85.28,  85.21,  85.14,  85.07,  85.00,  84.93,
+     84.86,  84.79,  84.72,  84.65,  84.58,  84.51,  84.44,  84.37,
+     84.30,  84.23,  84.16,  84.09,  84.02,  83.95,  83.88,  83.82,
+     83.75,  83.68,  83.61,  83.54,  83.47,  83.41,  83.34,  83.27,
+     83.20,  83.14,  83.07,  83.00,  82.94,  82.87,  82.80,  82.74,
+     82.67,  82.60,  82.54,  82.47,  82.41,  82.34,  82.28,  82.21,
+     82.14,  82.08,  82.01,  81.95,  81.88,  81.82,  81.76,  81.69,
+     81.63,  81.56,  81.50,  81.43,  81.37,  81.31,  81.24,  81.18,
+     81.12,  81.05,  80.99,  80.93,  80.86,  80.80,  80.74,  80.67,
+     80.61,  80.55,  80.49,  80.43,  80.36,  80.30,  80.24,  80.18,
+     80.12,  80.05,  79.99,  79.93,  79.87,  79.81,  79.75,  79.69,
+     79.63,  79.57,  79.50,  79.44,  79.38,  79.32,  79.26,  79.20,
+     79.14,  79.08,  79.02,  78.96,  78.90,  78.84,  78.79,  78.73,
+     78.67,  78.61,  78.55,  78.49,  78.43,  78.37,  78.31,  78.26,
+     78.20,  78.14,  78.08,  78.02,  77.96,  77.91,  77.85,  77.79,
+     77.73,  77.68,  77.62,  77.56,  77.50,  77.45,  77.39,  77.33,
+     77.28,  77.22,  77.16,  77.10,  77.05,  76.99,  76.94,  76.88,
+     76.82,  76.77,  76.71,  76.65,  76.60,  76.54,  76.49,  76.43,
+     76.38,  76.32,  76.27,  76.21,  76.16,  76.10,  76.05,  75.99,
+     75.94,  75.88,  75.83,  75.77,  75.72,  75.66,  75.61,  75.55,
+     75.50,  75.45,  75.39,  75.34,  75.28,  75.23,  75.18,  75.12,
+     75.07,  75.02,  74.96,  74.91,  74.86,  74.80,  74.75,  74.70,
+     74.64,  74.59,  74.54,  74.49,  74.43,  74.38,  74.33,  74.28,
+     74.22,  74.17,  74.12,  74.07,  74.02,  73.96,  73.91,  73.86,
+     73.81,  73.76,  73.71,  73.65,  73.60,  73.55,  73.50,  73.45,
+     73.40,  73.35,  73.30,  73.25,  73.20,  73.14,  73.09,  73.04,
+     72.99,  72.94,  72.89,  72.84,  72.79,  72.74,  72.69,  72.64,
+     72.59,  72.54,  72.49,  72.44,  72.39,  72.34,  72.29,  72.24,
+     72.19,  72.15,  72.10,  72.05,  72.00,  71.95,  71.90,  71.85,
+     71.80,  71.75,  71.70,  71.66,  71.61,  71.56,  71.51,  71.46,
+     71.41,  71.37,  71.32,  71.27,  71.22,  71.17,  71.12,  71.08,
+     71.03,  70.98,  70.93,  70.89,  70.84,  70.79,  70.74,  70.70,
+     70.65,  70.60,  70.55,  70.51,  70.46,  70.41,  70.37,  70.32,
+     70.27,  70.23,  70.18,  70.13,  70.09,  70.04,  69.99,  69.95,
+     69.90,  69.85,  69.81,  69.76,  69.72,  69.67,  69.62,  69.58,
+     69.53,  69.49,  69.44,  69.39,  69.35,  69.30,  69.26,  69.21,
+     69.17,  69.12,  69.08,  69.03,  68.99,  68.94,  68.89,  68.85,
+     68.80,  68.76,  68.71,  68.67,  68.63,  68.58,  68.54,  68.49,
+     68.45,  68.40,  68.36,  68.31,  68.27,  68.22,  68.18,  68.14,
+     68.09,  68.05,  68.00,  67.96,  67.92,  67.87,  67.83,  67.78,
+     67.74,  67.70,  67.65,  67.61,  67.57,  67.52,  67.48,  67.44,
+     67.39,  67.35,  67.31,  67.26,  67.22,  67.18,  67.13,  67.09,
+     67.05,  67.01,  66.96,  66.92,  66.88,  66.84,  66.79,  66.75,
+     66.71,  66.67,  66.62,  66.58,  66.54,  66.50,  66.45,  66.41,
+     66.37,  66.33,  66.29,  66.24,  66.20,  66.16,  66.12,  66.08,
+     66.03,  65.99,  65.95,  65.91,  65.87,  65.83,  65.78,  65.74,
+     65.70,  65.66,  65.62,  65.58,  65.54,  65.50,  65.45,  65.41,
+     65.37,  65.33,  65.29,  65.25,  65.21,  65.17,  65.13,  65.09,
+     65.05,  65.01,  64.96,  64.92,  64.88,  64.84,  64.80,  64.76,
+     64.72,  64.68,  64.64,  64.60,  64.56,  64.52,  64.48,  64.44,
+     64.40,  64.36,  64.32,  64.28,  64.24,  64.20,  64.16,  64.12,
+     64.08,  64.04,  64.00,  63.96,  63.93,  63.89,  63.85,  63.81,
+     63.77,  63.73,  63.69,  63.65,  63.61,  63.57,  63.53,  63.49,
+     63.45,  63.42,  63.38,  63.34,  63.30,  63.26,  63.22,  63.18,
+     63.14,  63.11,  63.07,  63.03,  62.99,  62.95,  62.91,  62.87,
+     62.84,  62.80,  62.76,  62.72,  62.68,  62.65,  62.61,  62.57,
+     62.53,  62.49,  62.46,  62.42,  62.38,  62.34,  62.30,  62.27,
+     62.23,  62.19,  62.15,  62.12,  62.08,  62.04,  62.00,  61.97,
+     61.93,  61.89,  61.85,  61.82,  61.78,  61.74,  61.70,  61.67,
+     61.63,  61.59,  61.56,  61.52,  61.48,  61.44,  61.41,  61.37,
+     61.33,  61.30,  61.26,  61.22,  61.19,  61.15,  61.11,  61.08,
+     61.04,  61.00,  60.97,  60.93,  60.89,  60.86,  60.82,  60.78,
+     60.75,  60.71,  60.68,  60.64,  60.60,  60.57,  60.53,  60.49,
+     60.46,  60.42,  60.39,  60.35,  60.32,  60.28,  60.24,  60.21,
+     60.17,  60.14,  60.10,  60.06,  60.03,  59.99,  59.96,  59.92,
+     59.89,  59.85,  59.82,  59.78,  59.74,  59.71,  59.67,  59.64,
+     59.60,  59.57,  59.53,  59.50,  59.46,  59.43,  59.39,  59.36,
+     59.32,  59.29,  59.25,  59.22,  59.18,  59.15,  59.11,  59.08,
+     59.04,  59.01,  58.97,  58.94,  58.90,  58.87,  58.84,  58.80,
+     58.77,  58.73,  58.70,  58.66,  58.63,  58.59,  58.56,  58.53,
+     58.49,  58.46,  58.42,  58.39,  58.35,  58.32,  58.29,  58.25,
+     58.22,  58.18,  58.15,  58.12,  58.08,  58.05,  58.01,  57.98,
+     57.95,  57.91,  57.88,  57.85,  57.81,  57.78,  57.74,  57.71,
+     57.68,  57.64,  57.61,  57.58,  57.54,  57.51,  57.48,  57.44,
+     57.41,  57.38,  57.34,  57.31,  57.28,  57.24,  57.21,  57.18,
+     57.14,  57.11,  57.08,  57.04,  57.01,  56.98,  56.95,  56.91,
+     56.88,  56.85,  56.81,  56.78,  56.75,  56.71,  56.68,  56.65,
+     56.62,  56.58,  56.55,  56.52,  56.49,  56.45,  56.42,  56.39,
+     56.36,  56.32,  56.29,  56.26,  56.23,  56.19,  56.16,  56.13,
+     56.10,  56.06,  56.03,  56.00,  55.97,  55.94,  55.90,  55.87,
+     55.84,  55.81,  55.77,  55.74,  55.71,  55.68,  55.65,  55.61,
+     55.58,  55.55,  55.52,  55.49,  55.46,  55.42,  55.39,  55.36,
+     55.33,  55.30,  55.27,  55.23,  55.20,  55.17,  55.14,  55.11,
+     55.08,  55.04,  55.01,  54.98,  54.95,  54.92,  54.89,  54.86,
+     54.82,  54.79,  54.76,  54.73,  54.70,  54.67,  54.64,  54.61,
+     54.57,  54.54,  54.51,  54.48,  54.45,  54.42,  54.39,  54.36,
+     54.33,  54.30,  54.26,  54.23,  54.20,  54.17,  54.14,  54.11,
+     54.08,  54.05,  54.02,  53.99,  53.96,  53.93,  53.90,  53.87,
+     53.83,  53.80,  53.77,  53.74,  53.71,  53.68,  53.65,  53.62,
+     53.59,  53.56,  53.53,  53.50,  53.47,  53.44,  53.41,  53.38,
+     53.35,  53.32,  53.29,  53.26,  53.23,  53.20,  53.17,  53.14,
+     53.11,  53.08,  53.05,  53.02,  52.99,  52.96,  52.93,  52.90,
+     52.87,  52.84,  52.81,  52.78,  52.75,  52.72,  52.69,  52.66,
+     52.63,  52.60,  52.57,  52.54,  52.51,  52.48,  52.45,  52.42,
+     52.39,  52.36,  52.33,  52.30,  52.27,  52.24,  52.21,  52.19,
+     52.16,  52.13,  52.10,  52.07,  52.04,  52.01,  51.98,  51.95,
+     51.92,  51.89,  51.86,  51.83,  51.80,  51.78,  51.75,  51.72,
+     51.69,  51.66,  51.63,  51.60,  51.57,  51.54,  51.51,  51.49,
+     51.46,  51.43,  51.40,  51.37,  51.34,  51.31,  51.28,  51.25,
+     51.23,  51.20,  51.17,  51.14,  51.11,  51.08,  51.05,  51.02,
+     51.00,  50.97,  50.94,  50.91,  50.88,  50.85,  50.82,  50.80,
+     50.77,  50.74,  50.71,  50.68,  50.65,  50.63,  50.60,  50.57,
+     50.54,  50.51,  50.48,  50.46,  50.43,  50.40,  50.37,  50.34,
+     50.31,  50.29,  50.26,  50.23,  50.20,  50.17,  50.15,  50.12,
+     50.09,  50.06,  50.03,  50.01,  49.98,  49.95,  49.92,  49.89,
+     49.87,  49.84,  49.81,  49.78,  49.75,  49.73,  49.70,  49.67,
+     49.64,  49.62,  49.59,  49.56,  49.53,  49.50,  49.48,  49.45,
+     49.42,  49.39,  49.37,  49.34,  49.31,  49.28,  49.26,  49.23,
+     49.20,  49.17,  49.15,  49.12,  49.09,  49.06,  49.04,  49.01,
+     48.98,  48.95,  48.93,  48.90,  48.87,  48.85,  48.82,  48.79,
+     48.76,  48.74,  48.71,  48.68,  48.65,  48.63,  48.60,  48.57,
+     48.55,  48.52,  48.49,  48.46,  48.44,  48.41,  48.38,  48.36,
+     48.33,  48.30,  48.28,  48.25,  48.22,  48.20,  48.17,  48.14,
+     48.11,  48.09,  48.06,  48.03,  48.01,  47.98,  47.95,  47.93,
+     47.90,  47.87,  47.85,  47.82,  47.79,  47.77,  47.74,  47.71,
+     47.69,  47.66,  47.63,  47.61,  47.58,  47.55,  47.53,  47.50,
+     47.47,  47.45,  47.42,  47.40,  47.37,  47.34,  47.32,  47.29,
+     47.26,  47.24,  47.21,  47.18,  47.16,  47.13,  47.11,  47.08,
+     47.05,  47.03,  47.00,  46.97,  46.95,  46.92,  46.90,  46.87,
+     46.84,  46.82,  46.79,  46.77,  46.74,  46.71,  46.69,  46.66,
+     46.63,  46.61,  46.58,  46.56,  46.53,  46.50,  46.48,  46.45,
+     46.43,  46.40,  46.38,  46.35,  46.32,  46.30,  46.27,  46.25,
+     46.22,  46.19,  46.17,  46.14,  46.12,  46.09,  46.07,  46.04,
+     46.01,  45.99,  45.96,  45.94,  45.91,  45.89,  45.86,  45.84,
+     45.81,  45.78,  45.76,  45.73,  45.71,  45.68,  45.66,  45.63,
+     45.61,  45.58,  45.55,  45.53,  45.50,  45.48,  45.45,  45.43,
+     45.40,  45.38,  45.35,  45.33,  45.30,  45.28,  45.25,  45.23,
+     45.20,  45.17,  45.15,  45.12,  45.10,  45.07,  45.05,  45.02,
+     45.00,  44.97,  44.95,  44.92,  44.90,  44.87,  44.85,  44.82,
+     44.80,  44.77,  44.75,  44.72,  44.70,  44.67,  44.65,  44.62,
+     44.60,  44.57,  44.55,  44.52,  44.50,  44.47,  44.45,  44.42,
+     44.40,  44.37,  44.35,  44.32,  44.30,  44.27,  44.25,  44.22,
+     44.20,  44.18,  44.15,  44.13,  44.10,  44.08,  44.05,  44.03,
+     44.00,  43.98,  43.95,  43.93,  43.90,  43.88,  43.85,  43.83,
+     43.81,  43.78,  43.76,  43.73,  43.71,  43.68,  43.66,  43.63,
+     43.61,  43.58,  43.56,  43.54,  43.51,  43.49,  43.46,  43.44,
+     43.41,  43.39,  43.37,  43.34,  43.32,  43.29,  43.27,  43.24,
+     43.22,  43.20,  43.17,  43.15,  43.12,  43.10,  43.07,  43.05,
+     43.03,  43.00,  42.98,  42.95,  42.93,  42.90,  42.88,  42.86,
+     42.83,  42.81,  42.78,  42.76,  42.74,  42.71,  42.69,  42.66,
+     42.64,  42.62,  42.59,  42.57,  42.54,  42.52,  42.50,  42.47,
+     42.45,  42.42,  42.40,  42.38,  42.35,  42.33,  42.30,  42.28,
+     42.26,  42.23,  42.21,  42.19,  42.16,  42.14,  42.11,  42.09,
+     42.07,  42.04,  42.02,  42.00,  41.97,  41.95,  41.92,  41.90,
+     41.88,  41.85,  41.83,  41.81,  41.78,  41.76,  41.74,  41.71,
+     41.69,  41.66,  41.64,  41.62,  41.59,  41.57,  41.55,  41.52,
+     41.50,  41.48,  41.45,  41.43,  41.41,  41.38,  41.36,  41.34,
+     41.31,  41.29,  41.27,  41.24,  41.22,  41.19,  41.17,  41.15,
+     41.12,  41.10,  41.08,  41.05,  41.03,  41.01,  40.98,  40.96,
+     40.94,  40.92,  40.89,  40.87,  40.85,  40.82,  40.80,  40.78,
+     40.75,  40.73,  40.71,  40.68,  40.66,  40.64,  40.61,  40.59,
+     40.57,  40.54,  40.52,  40.50,  40.48,  40.45,  40.43,  40.41,
+     40.38,  40.36,  40.34,  40.31,  40.29,  40.27,  40.24,  40.22,
+     40.20,  40.18,  40.15,  40.13,  40.11,  40.08,  40.06,  40.04,
+     40.02,  39.99,  39.97,  39.95,  39.92,  39.90,  39.88,  39.86,
+     39.83,  39.81,  39.79,  39.76,  39.74,  39.72,  39.70,  39.67,
+     39.65,  39.63,  39.61,  39.58,  39.56,  39.54,  39.51,  39.49,
+     39.47,  39.45,  39.42,  39.40,  39.38,  39.36,  39.33,  39.31,
+     39.29,  39.27,  39.24,  39.22,  39.20,  39.17,  39.15,  39.13,
+     39.11,  39.08,  39.06,  39.04,  39.02,  38.99,  38.97,  38.95,
+     38.93,  38.90,  38.88,  38.86,  38.84,  38.82,  38.79,  38.77,
+     38.75,  38.73,  38.70,  38.68,  38.66,  38.64,  38.61,  38.59,
+     38.57,  38.55,  38.52,  38.50,  38.48,  38.46,  38.44,  38.41,
+     38.39,  38.37,  38.35,  38.32,  38.30,  38.28,  38.26,  38.24,
+     38.21,  38.19,  38.17,  38.15,  38.12,  38.10,  38.08,  38.06,
+     38.04,  38.01,  37.99,  37.97,  37.95,  37.93,  37.90,  37.88,
+     37.86,  37.84,  37.81,  37.79,  37.77,  37.75,  37.73,  37.70,
+     37.68,  37.66,  37.64,  37.62,  37.59,  37.57,  37.55,  37.53,
+     37.51,  37.48,  37.46,  37.44,  37.42,  37.40,  37.38,  37.35,
+     37.33,  37.31,  37.29,  37.27,  37.24,  37.22,  37.20,  37.18,
+     37.16,  37.14,  37.11,  37.09,  37.07,  37.05,  37.03,  37.00,
+     36.98,  36.96,  36.94,  36.92,  36.90,  36.87,  36.85,  36.83,
+     36.81,  36.79,  36.77,  36.74,  36.72,  36.70,  36.68,  36.66,
+     36.64,  36.61,  36.59,  36.57,  36.55,  36.53,  36.51,  36.48,
+     36.46,  36.44,  36.42,  36.40,  36.38,  36.35,  36.33,  36.31,
+     36.29,  36.27,  36.25,  36.23,  36.20,  36.18,  36.16,  36.14,
+     36.12,  36.10,  36.08,  36.05,  36.03,  36.01,  35.99,  35.97,
+     35.95,  35.93,  35.90,  35.88,  35.86,  35.84,  35.82,  35.80,
+     35.78,  35.75,  35.73,  35.71,  35.69,  35.67,  35.65,  35.63,
+     35.60,  35.58,  35.56,  35.54,  35.52,  35.50,  35.48,  35.46,
+     35.43,  35.41,  35.39,  35.37,  35.35,  35.33,  35.31,  35.29,
+     35.26,  35.24,  35.22,  35.20,  35.18,  35.16,  35.14,  35.12,
+     35.10,  35.07,  35.05,  35.03,  35.01,  34.99,  34.97,  34.95,
+     34.93,  34.91,  34.88,  34.86,  34.84,  34.82,  34.80,  34.78,
+     34.76,  34.74,  34.72,  34.70,  34.67,  34.65,  34.63,  34.61,
+     34.59,  34.57,  34.55,  34.53,  34.51,  34.49,  34.46,  34.44,
+     34.42,  34.40,  34.38,  34.36,  34.34,  34.32,  34.30,  34.28,
+     34.25,  34.23,  34.21,  34.19,  34.17,  34.15,  34.13,  34.11,
+     34.09,  34.07,  34.05,  34.03,  34.00,  33.98,  33.96,  33.94,
+     33.92,  33.90,  33.88,  33.86,  33.84,  33.82,  33.80,  33.78,
+     33.76,  33.73,  33.71,  33.69,  33.67,  33.65,  33.63,  33.61,
+     33.59,  33.57,  33.55,  33.53,  33.51,  33.49,  33.47,  33.44,
+     33.42,  33.40,  33.38,  33.36,  33.34,  33.32,  33.30,  33.28,
+     33.26,  33.24,  33.22,  33.20,  33.18,  33.16,  33.14,  33.11,
+     33.09,  33.07,  33.05,  33.03,  33.01,  32.99,  32.97,  32.95,
+     32.93,  32.91,  32.89,  32.87,  32.85,  32.83,  32.81,  32.79,
+     32.77,  32.75,  32.72,  32.70,  32.68,  32.66,  32.64,  32.62,
+     32.60,  32.58,  32.56,  32.54,  32.52,  32.50,  32.48,  32.46,
+     32.44,  32.42,  32.40,  32.38,  32.36,  32.34,  32.32,  32.30,
+     32.28,  32.26,  32.24,  32.21,  32.19,  32.17,  32.15,  32.13,
+     32.11,  32.09,  32.07,  32.05,  32.03,  32.01,  31.99,  31.97,
+     31.95,  31.93,  31.91,  31.89,  31.87,  31.85,  31.83,  31.81,
+     31.79,  31.77,  31.75,  31.73,  31.71,  31.69,  31.67,  31.65,
+     31.63,  31.61,  31.59,  31.57,  31.55,  31.53,  31.51,  31.49,
+     31.47,  31.45,  31.43,  31.41,  31.39,  31.37,  31.35,  31.32,
+     31.30,  31.28,  31.26,  31.24,  31.22,  31.20,  31.18,  31.16,
+     31.14,  31.12,  31.10,  31.08,  31.06,  31.04,  31.02,  31.00,
+     30.98,  30.96,  30.94,  30.92,  30.90,  30.88,  30.86,  30.84,
+     30.82,  30.80,  30.78,  30.76,  30.74,  30.72,  30.70,  30.68,
+     30.66,  30.64,  30.62,  30.60,  30.58,  30.56,  30.54,  30.52,
+     30.50,  30.48,  30.46,  30.44,  30.42,  30.40,  30.38,  30.36,
+     30.34,  30.32,  30.30,  30.29,  30.27,  30.25,  30.23,  30.21,
+     30.19,  30.17,  30.15,  30.13,  30.11,  30.09,  30.07,  30.05,
+     30.03,  30.01,  29.99,  29.97,  29.95,  29.93,  29.91,  29.89,
+     29.87,  29.85,  29.83,  29.81,  29.79,  29.77,  29.75,  29.73,
+     29.71,  29.69,  29.67,  29.65,  29.63,  29.61,  29.59,  29.57,
+     29.55,  29.53,  29.51,  29.49,  29.47,  29.45,  29.43,  29.41,
+     29.39,  29.38,  29.36,  29.34,  29.32,  29.30,  29.28,  29.26,
+     29.24,  29.22,  29.20,  29.18,  29.16,  29.14,  29.12,  29.10,
+     29.08,  29.06,  29.04,  29.02,  29.00,  28.98,  28.96,  28.94,
+     28.92,  28.90,  28.88,  28.86,  28.84,  28.83,  28.81,  28.79,
+     28.77,  28.75,  28.73,  28.71,  28.69,  28.67,  28.65,  28.63,
+     28.61,  28.59,  28.57,  28.55,  28.53,  28.51,  28.49,  28.47,
+     28.45,  28.43,  28.42,  28.40,  28.38,  28.36,  28.34,  28.32,
+     28.30,  28.28,  28.26,  28.24,  28.22,  28.20,  28.18,  28.16,
+     28.14,  28.12,  28.10,  28.08,  28.06,  28.05,  28.03,  28.01,
+     27.99,  27.97,  27.95,  27.93,  27.91,  27.89,  27.87,  27.85,
+     27.83,  27.81,  27.79,  27.77,  27.75,  27.73,  27.72,  27.70,
+     27.68,  27.66,  27.64,  27.62,  27.60,  27.58,  27.56,  27.54,
+     27.52,  27.50,  27.48,  27.46,  27.44,  27.43,  27.41,  27.39,
+     27.37,  27.35,  27.33,  27.31,  27.29,  27.27,  27.25,  27.23,
+     27.21,  27.19,  27.17,  27.15,  27.14,  27.12,  27.10,  27.08,
+     27.06,  27.04,  27.02,  27.00,  26.98,  26.96,  26.94,  26.92,
+     26.90,  26.89,  26.87,  26.85,  26.83,  26.81,  26.79,  26.77,
+     26.75,  26.73,  26.71,  26.69,  26.67,  26.65,  26.64,  26.62,
+     26.60,  26.58,  26.56,  26.54,  26.52,  26.50,  26.48,  26.46,
+     26.44,  26.42,  26.41,  26.39,  26.37,  26.35,  26.33,  26.31,
+     26.29,  26.27,  26.25,  26.23,  26.21,  26.19,  26.18,  26.16,
+     26.14,  26.12,  26.10,  26.08,  26.06,  26.04,  26.02,  26.00,
+     25.98,  25.97,  25.95,  25.93,  25.91,  25.89,  25.87,  25.85,
+     25.83,  25.81,  25.79,  25.77,  25.76,  25.74,  25.72,  25.70,
+     25.68,  25.66,  25.64,  25.62,  25.60,  25.58,  25.57,  25.55,
+     25.53,  25.51,  25.49,  25.47,  25.45,  25.43,  25.41,  25.39,
+     25.37,  25.36,  25.34,  25.32,  25.30,  25.28,  25.26,  25.24,
+     25.22,  25.20,  25.18,  25.17,  25.15,  25.13,  25.11,  25.09,
+     25.07,  25.05,  25.03,  25.01,  24.99,  24.98,  24.96,  24.94,
+     24.92,  24.90,  24.88,  24.86,  24.84,  24.82,  24.81,  24.79,
+     24.77,  24.75,  24.73,  24.71,  24.69,  24.67,  24.65,  24.64,
+     24.62,  24.60,  24.58,  24.56,  24.54,  24.52,  24.50,  24.48,
+     24.46,  24.45,  24.43,  24.41,  24.39,  24.37,  24.35,  24.33,
+     24.31,  24.29,  24.28,  24.26,  24.24,  24.22,  24.20,  24.18,
+     24.16,  24.14,  24.13,  24.11,  24.09,  24.07,  24.05,  24.03,
+     24.01,  23.99,  23.97,  23.96,  23.94,  23.92,  23.90,  23.88,
+     23.86,  23.84,  23.82,  23.80,  23.79,  23.77,  23.75,  23.73,
+     23.71,  23.69,  23.67,  23.65,  23.64,  23.62,  23.60,  23.58,
+     23.56,  23.54,  23.52,  23.50,  23.49,  23.47,  23.45,  23.43,
+     23.41,  23.39,  23.37,  23.35,  23.33,  23.32,  23.30,  23.28,
+     23.26,  23.24,  23.22,  23.20,  23.18,  23.17,  23.15,  23.13,
+     23.11,  23.09,  23.07,  23.05,  23.03,  23.02,  23.00,  22.98,
+     22.96,  22.94,  22.92,  22.90,  22.88,  22.87,  22.85,  22.83,
+     22.81,  22.79,  22.77,  22.75,  22.73,  22.72,  22.70,  22.68,
+     22.66,  22.64,  22.62,  22.60,  22.59,  22.57,  22.55,  22.53,
+     22.51,  22.49,  22.47,  22.45,  22.44,  22.42,  22.40,  22.38,
+     22.36,  22.34,  22.32,  22.30,  22.29,  22.27,  22.25,  22.23,
+     22.21,  22.19,  22.17,  22.16,  22.14,  22.12,  22.10,  22.08,
+     22.06,  22.04,  22.02,  22.01,  21.99,  21.97,  21.95,  21.93,
+     21.91,  21.89,  21.88,  21.86,  21.84,  21.82,  21.80,  21.78,
+     21.76,  21.74,  21.73,  21.71,  21.69,  21.67,  21.65,  21.63,
+     21.61,  21.60,  21.58,  21.56,  21.54,  21.52,  21.50,  21.48,
+     21.47,  21.45,  21.43,  21.41,  21.39,  21.37,  21.35,  21.33,
+     21.32,  21.30,  21.28,  21.26,  21.24,  21.22,  21.20,  21.19,
+     21.17,  21.15,  21.13,  21.11,  21.09,  21.07,  21.06,  21.04,
+     21.02,  21.00,  20.98,  20.96,  20.94,  20.93,  20.91,  20.89,
+     20.87,  20.85,  20.83,  20.81,  20.80,  20.78,  20.76,  20.74,
+     20.72,  20.70,  20.68,  20.67,  20.65,  20.63,  20.61,  20.59,
+     20.57,  20.55,  20.54,  20.52,  20.50,  20.48,  20.46,  20.44,
+     20.42,  20.41,  20.39,  20.37,  20.35,  20.33,  20.31,  20.29,
+     20.28,  20.26,  20.24,  20.22,  20.20,  20.18,  20.16,  20.15,
+     20.13,  20.11,  20.09,  20.07,  20.05,  20.03,  20.02,  20.00,
+     19.98,  19.96,  19.94,  19.92,  19.90,  19.89,  19.87,  19.85,
+     19.83,  19.81,  19.79,  19.77,  19.76,  19.74,  19.72,  19.70,
+     19.68,  19.66,  19.65,  19.63,  19.61,  19.59,  19.57,  19.55,
+     19.53,  19.52,  19.50,  19.48,  19.46,  19.44,  19.42,  19.40,
+     19.39,  19.37,  19.35,  19.33,  19.31,  19.29,  19.27,  19.26,
+     19.24,  19.22,  19.20,  19.18,  19.16,  19.15,  19.13,  19.11,
+     19.09,  19.07,  19.05,  19.03,  19.02,  19.00,  18.98,  18.96,
+     18.94,  18.92,  18.90,  18.89,  18.87,  18.85,  18.83,  18.81,
+     18.79,  18.77,  18.76,  18.74,  18.72,  18.70,  18.68,  18.66,
+     18.65,  18.63,  18.61,  18.59,  18.57,  18.55,  18.53,  18.52,
+     18.50,  18.48,  18.46,  18.44,  18.42,  18.40,  18.39,  18.37,
+     18.35,  18.33,  18.31,  18.29,  18.28,  18.26,  18.24,  18.22,
+     18.20,  18.18,  18.16,  18.15,  18.13,  18.11,  18.09,  18.07,
+     18.05,  18.03,  18.02,  18.00,  17.98,  17.96,  17.94,  17.92,
+     17.91,  17.89,  17.87,  17.85,  17.83,  17.81,  17.79,  17.78,
+     17.76,  17.74,  17.72,  17.70,  17.68,  17.66,  17.65,  17.63,
+     17.61,  17.59,  17.57,  17.55,  17.54,  17.52,  17.50,  17.48,
+     17.46,  17.44,  17.42,  17.41,  17.39,  17.37,  17.35,  17.33,
+     17.31,  17.29,  17.28,  17.26,  17.24,  17.22,  17.20,  17.18,
+     17.17,  17.15,  17.13,  17.11,  17.09,  17.07,  17.05,  17.04,
+     17.02,  17.00,  16.98,  16.96,  16.94,  16.92,  16.91,  16.89,
+     16.87,  16.85,  16.83,  16.81,  16.79,  16.78,  16.76,  16.74,
+     16.72,  16.70,  16.68,  16.67,  16.65,  16.63,  16.61,  16.59,
+     16.57,  16.55,  16.54,  16.52,  16.50,  16.48,  16.46,  16.44,
+     16.42,  16.41,  16.39,  16.37,  16.35,  16.33,  16.31,  16.30,
+     16.28,  16.26,  16.24,  16.22,  16.20,  16.18,  16.17,  16.15,
+     16.13,  16.11,  16.09,  16.07,  16.05,  16.04,  16.02,  16.00,
+     15.98,  15.96,  15.94,  15.92,  15.91,  15.89,  15.87,  15.85,
+     15.83,  15.81,  15.79,  15.78,  15.76,  15.74,  15.72,  15.70,
+     15.68,  15.67,  15.65,  15.63,  15.61,  15.59,  15.57,  15.55,
+     15.54,  15.52,  15.50,  15.48,  15.46,  15.44,  15.42,  15.41,
+     15.39,  15.37,  15.35,  15.33,  15.31,  15.29,  15.28,  15.26,
+     15.24,  15.22,  15.20,  15.18,  15.16,  15.15,  15.13,  15.11,
+     15.09,  15.07,  15.05,  15.03,  15.02,  15.00,  14.98,  14.96,
+     14.94,  14.92,  14.90,  14.89,  14.87,  14.85,  14.83,  14.81,
+     14.79,  14.77,  14.76,  14.74,  14.72,  14.70,  14.68,  14.66,
+     14.64,  14.63,  14.61,  14.59,  14.57,  14.55,  14.53,  14.51,
+     14.50,  14.48,  14.46,  14.44,  14.42,  14.40,  14.38,  14.37,
+     14.35,  14.33,  14.31,  14.29,  14.27,  14.25,  14.23,  14.22,
+     14.20,  14.18,  14.16,  14.14,  14.12,  14.10,  14.09,  14.07,
+     14.05,  14.03,  14.01,  13.99,  13.97,  13.96,  13.94,  13.92,
+     13.90,  13.88,  13.86,  13.84,  13.83,  13.81,  13.79,  13.77,
+     13.75,  13.73,  13.71,  13.69,  13.68,  13.66,  13.64,  13.62,
+     13.60,  13.58,  13.56,  13.55,  13.53,  13.51,  13.49,  13.47,
+     13.45,  13.43,  13.41,  13.40,  13.38,  13.36,  13.34,  13.32,
+     13.30,  13.28,  13.27,  13.25,  13.23,  13.21,  13.19,  13.17,
+     13.15,  13.13,  13.12,  13.10,  13.08,  13.06,  13.04,  13.02,
+     13.00,  12.98,  12.97,  12.95,  12.93,  12.91,  12.89,  12.87,
+     12.85,  12.83,  12.82,  12.80,  12.78,  12.76,  12.74,  12.72,
+     12.70,  12.68,  12.67,  12.65,  12.63,  12.61,  12.59,  12.57,
+     12.55,  12.54,  12.52,  12.50,  12.48,  12.46,  12.44,  12.42,
+     12.40,  12.38,  12.37,  12.35,  12.33,  12.31,  12.29,  12.27,
+     12.25,  12.23,  12.22,  12.20,  12.18,  12.16,  12.14,  12.12,
+     12.10,  12.08,  12.07,  12.05,  12.03,  12.01,  11.99,  11.97,
+     11.95,  11.93,  11.92,  11.90,  11.88,  11.86,  11.84,  11.82,
+     11.80,  11.78,  11.76,  11.75,  11.73,  11.71,  11.69,  11.67,
+     11.65,  11.63,  11.61,  11.59,  11.58,  11.56,  11.54,  11.52,
+     11.50,  11.48,  11.46,  11.44,  11.42,  11.41,  11.39,  11.37,
+     11.35,  11.33,  11.31,  11.29,  11.27,  11.25,  11.24,  11.22,
+     11.20,  11.18,  11.16,  11.14,  11.12,  11.10,  11.08,  11.07,
+     11.05,  11.03,  11.01,  10.99,  10.97,  10.95,  10.93,  10.91,
+     10.90,  10.88,  10.86,  10.84,  10.82,  10.80,  10.78,  10.76,
+     10.74,  10.72,  10.71,  10.69,  10.67,  10.65,  10.63,  10.61,
+     10.59,  10.57,  10.55,  10.54,  10.52,  10.50,  10.48,  10.46,
+     10.44,  10.42,  10.40,  10.38,  10.36,  10.34,  10.33,  10.31,
+     10.29,  10.27,  10.25,  10.23,  10.21,  10.19,  10.17,  10.15,
+     10.14,  10.12,  10.10,  10.08,  10.06,  10.04,  10.02,  10.00,
+      9.98,   9.96,   9.94,   9.93,   9.91,   9.89,   9.87,   9.85,
+      9.83,   9.81,   9.79,   9.77,   9.75,   9.73,   9.72,   9.70,
+      9.68,   9.66,   9.64,   9.62,   9.60,   9.58,   9.56,   9.54,
+      9.52,   9.51,   9.49,   9.47,   9.45,   9.43,   9.41,   9.39,
+      9.37,   9.35,   9.33,   9.31,   9.29,   9.28,   9.26,   9.24,
+      9.22,   9.20,   9.18,   9.16,   9.14,   9.12,   9.10,   9.08,
+      9.06,   9.04,   9.03,   9.01,   8.99,   8.97,   8.95,   8.93,
+      8.91,   8.89,   8.87,   8.85,   8.83,   8.81,   8.79,   8.78,
+      8.76,   8.74,   8.72,   8.70,   8.68,   8.66,   8.64,   8.62,
+      8.60,   8.58,   8.56,   8.54,   8.52,   8.51,   8.49,   8.47,
+      8.45,   8.43,   8.41,   8.39,   8.37,   8.35,   8.33,   8.31,
+      8.29,   8.27,   8.25,   8.23,   8.21,   8.20,   8.18,   8.16,
+      8.14,   8.12,   8.10,   8.08,   8.06,   8.04,   8.02,   8.00,
+      7.98,   7.96,   7.94,   7.92,   7.90,   7.88,   7.87,   7.85,
+      7.83,   7.81,   7.79,   7.77,   7.75,   7.73,   7.71,   7.69,
+      7.67,   7.65,   7.63,   7.61,   7.59,   7.57,   7.55,   7.53,
+      7.51,   7.50,   7.48,   7.46,   7.44,   7.42,   7.40,   7.38,
+      7.36,   7.34,   7.32,   7.30,   7.28,   7.26,   7.24,   7.22,
+      7.20,   7.18,   7.16,   7.14,   7.12,   7.10,   7.08,   7.06,
+      7.05,   7.03,   7.01,   6.99,   6.97,   6.95,   6.93,   6.91,
+      6.89,   6.87,   6.85,   6.83,   6.81,   6.79,   6.77,   6.75,
+      6.73,   6.71,   6.69,   6.67,   6.65,   6.63,   6.61,   6.59,
+      6.57,   6.55,   6.53,   6.51,   6.49,   6.47,   6.45,   6.43,
+      6.41,   6.40,   6.38,   6.36,   6.34,   6.32,   6.30,   6.28,
+      6.26,   6.24,   6.22,   6.20,   6.18,   6.16,   6.14,   6.12,
+      6.10,   6.08,   6.06,   6.04,   6.02,   6.00,   5.98,   5.96,
+      5.94,   5.92,   5.90,   5.88,   5.86,   5.84,   5.82,   5.80,
+      5.78,   5.76,   5.74,   5.72,   5.70,   5.68,   5.66,   5.64,
+      5.62,   5.60,   5.58,   5.56,   5.54,   5.52,   5.50,   5.48,
+      5.46,   5.44,   5.42,   5.40,   5.38,   5.36,   5.34,   5.32,
+      5.30,   5.28,   5.26,   5.24,   5.22,   5.20,   5.18,   5.16,
+      5.14,   5.12,   5.10,   5.08,   5.06,   5.04,   5.02,   5.00,
+      4.98,   4.96,   4.94,   4.92,   4.90,   4.88,   4.86,   4.84,
+      4.82,   4.80,   4.78,   4.76,   4.74,   4.72,   4.70,   4.68,
+      4.66,   4.64,   4.62,   4.60,   4.58,   4.56,   4.54,   4.52,
+      4.50,   4.47,   4.45,   4.43,   4.41,   4.39,   4.37,   4.35,
+      4.33,   4.31,   4.29,   4.27,   4.25,   4.23,   4.21,   4.19,
+      4.17,   4.15,   4.13,   4.11,   4.09,   4.07,   4.05,   4.03,
+      4.01,   3.99,   3.97,   3.95,   3.93,   3.91,   3.88,   3.86,
+      3.84,   3.82,   3.80,   3.78,   3.76,   3.74,   3.72,   3.70,
+      3.68,   3.66,   3.64,   3.62,   3.60,   3.58,   3.56,   3.54,
+      3.52,   3.50,   3.48,   3.45,   3.43,   3.41,   3.39,   3.37,
+      3.35,   3.33,   3.31,   3.29,   3.27,   3.25,   3.23,   3.21,
+      3.19,   3.17,   3.15,   3.12,   3.10,   3.08,   3.06,   3.04,
+      3.02,   3.00,   2.98,   2.96,   2.94,   2.92,   2.90,   2.88,
+      2.86,   2.83,   2.81,   2.79,   2.77,   2.75,   2.73,   2.71,
+      2.69,   2.67,   2.65,   2.63,   2.61,   2.59,   2.56,   2.54,
+      2.52,   2.50,   2.48,   2.46,   2.44,   2.42,   2.40,   2.38,
+      2.36,   2.33,   2.31,   2.29,   2.27,   2.25,   2.23,   2.21,
+      2.19,   2.17,   2.15,   2.13,   2.10,   2.08,   2.06,   2.04,
+      2.02,   2.00,   1.98,   1.96,   1.94,   1.91,   1.89,   1.87,
+      1.85,   1.83,   1.81,   1.79,   1.77,   1.75,   1.72,   1.70,
+      1.68,   1.66,   1.64,   1.62,   1.60,   1.58,   1.56,   1.53,
+      1.51,   1.49,   1.47,   1.45,   1.43,   1.41,   1.39,   1.36,
+      1.34,   1.32,   1.30,   1.28,   1.26,   1.24,   1.22,   1.19,
+      1.17,   1.15,   1.13,   1.11,   1.09,   1.07,   1.04,   1.02,
+      1.00,   0.98,   0.96,   0.94,   0.92,   0.89,   0.87,   0.85,
+      0.83,   0.81,   0.79,   0.77,   0.74,   0.72,   0.70,   0.68,
+      0.66,   0.64,   0.62,   0.59,   0.57,   0.55,   0.53,   0.51,
+      0.49,   0.46,   0.44,   0.42,   0.40,   0.38,   0.36,   0.33,
+      0.31,   0.29,   0.27,   0.25,   0.23,   0.20,   0.18,   0.16,
+      0.14,   0.12,   0.10,   0.07,   0.05,   0.03,   0.01,  -0.01,
+     -0.04,  -0.06,  -0.08,  -0.10,  -0.12,  -0.14,  -0.17,  -0.19,
+     -0.21,  -0.23,  -0.25,  -0.28,  -0.30,  -0.32,  -0.34,  -0.36,
+     -0.39,  -0.41,  -0.43,  -0.45,  -0.47,  -0.50,  -0.52,  -0.54,
+     -0.56,  -0.58,  -0.61,  -0.63,  -0.65,  -0.67,  -0.69,  -0.72,
+     -0.74,  -0.76,  -0.78,  -0.80,  -0.83,  -0.85,  -0.87,  -0.89,
+     -0.92,  -0.94,  -0.96,  -0.98,  -1.00,  -1.03,  -1.05,  -1.07,
+     -1.09,  -1.12,  -1.14,  -1.16,  -1.18,  -1.20,  -1.23,  -1.25,
+     -1.27,  -1.29,  -1.32,  -1.34,  -1.36,  -1.38,  -1.41,  -1.43,
+     -1.45,  -1.47,  -1.50,  -1.52,  -1.54,  -1.56,  -1.59,  -1.61,
+     -1.63,  -1.65,  -1.68,  -1.70,  -1.72,  -1.74,  -1.77,  -1.79,
+     -1.81,  -1.83,  -1.86,  -1.88,  -1.90,  -1.92,  -1.95,  -1.97,
+     -1.99,  -2.01,  -2.04,  -2.06,  -2.08,  -2.11,  -2.13,  -2.15,
+     -2.17,  -2.20,  -2.22,  -2.24,  -2.26,  -2.29,  -2.31,  -2.33,
+     -2.36,  -2.38,  -2.40,  -2.42,  -2.45,  -2.47,  -2.49,  -2.52,
+     -2.54,  -2.56,  -2.58,  -2.61,  -2.63,  -2.65,  -2.68,  -2.70,
+     -2.72,  -2.75,  -2.77,  -2.79,  -2.82,  -2.84,  -2.86,  -2.88,
+     -2.91,  -2.93,  -2.95,  -2.98,  -3.00,  -3.02,  -3.05,  -3.07,
+     -3.09,  -3.12,  -3.14,  -3.16,  -3.19,  -3.21,  -3.23,  -3.26,
+     -3.28,  -3.30,  -3.33,  -3.35,  -3.37,  -3.40,  -3.42,  -3.44,
+     -3.47,  -3.49,  -3.51,  -3.54,  -3.56,  -3.58,  -3.61,  -3.63,
+     -3.65,  -3.68,  -3.70,  -3.72,  -3.75,  -3.77,  -3.79,  -3.82,
+     -3.84,  -3.87,  -3.89,  -3.91,  -3.94,  -3.96,  -3.98,  -4.01,
+     -4.03,  -4.06,  -4.08,  -4.10,  -4.13,  -4.15,  -4.17,  -4.20,
+     -4.22,  -4.25,  -4.27,  -4.29,  -4.32,  -4.34,  -4.36,  -4.39,
+     -4.41,  -4.44,  -4.46,  -4.48,  -4.51,  -4.53,  -4.56,  -4.58,
+     -4.60,  -4.63,  -4.65,  -4.68,  -4.70,  -4.72,  -4.75,  -4.77,
+     -4.80,  -4.82,  -4.85,  -4.87,  -4.89,  -4.92,  -4.94,  -4.97,
+     -4.99,  -5.02,  -5.04,  -5.06,  -5.09,  -5.11,  -5.14,  -5.16,
+     -5.19,  -5.21,  -5.23,  -5.26,  -5.28,  -5.31,  -5.33,  -5.36,
+     -5.38,  -5.41,  -5.43,  -5.45,  -5.48,  -5.50,  -5.53,  -5.55,
+     -5.58,  -5.60,  -5.63,  -5.65,  -5.68,  -5.70,  -5.73,  -5.75,
+     -5.77,  -5.80,  -5.82,  -5.85,  -5.87,  -5.90,  -5.92,  -5.95,
+     -5.97,  -6.00,  -6.02,  -6.05,  -6.07,  -6.10,  -6.12,  -6.15,
+     -6.17,  -6.20,  -6.22,  -6.25,  -6.27,  -6.30,  -6.32,  -6.35,
+     -6.37,  -6.40,  -6.42,  -6.45,  -6.47,  -6.50,  -6.52,  -6.55,
+     -6.57,  -6.60,  -6.62,  -6.65,  -6.68,  -6.70,  -6.73,  -6.75,
+     -6.78,  -6.80,  -6.83,  -6.85,  -6.88,  -6.90,  -6.93,  -6.95
+};
+
+#endif
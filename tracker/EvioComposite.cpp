@@ -0,0 +1,301 @@
+//-----------------------------------------------------------------------------
+// File          : EvioComposite.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Decoder of EVIO COMPOSITE data.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <string.h>
+#include <stdint.h>
+#include <evio.h>
+#include "EvioComposite.h"
+using namespace std;
+
+// Format string translation of the EVIO library
+extern "C" int eviofmt ( char *fmt, unsigned char *ifmt, int ifmtLen );
+
+// Format characters and value sizes by eviofmt code
+static const char CodeType[13] = { 0, 'i', 'F', 'a', 'S', 's', 'C', 'c', 'D', 'L', 'l', 'I', 'A' };
+static const uint CodeSize[13] = { 0,  4,   4,   1,   2,   2,   1,   1,   8,   8,   8,   4,   4  };
+
+// Constructor
+EvioComposite::EvioComposite ( ) {
+   columnCount_ = 0;
+   tag_         = 0;
+   num_         = 0;
+}
+
+// Compile a format: the eviofmt codes, with the groups matched, the columns
+// assigned and the repeat rules resolved once
+void EvioComposite::compile ( const string &format, Plan &plan ) {
+   unsigned char ifmt[1024];
+   vector<char>  fmt(format.begin(),format.end());
+   vector<uint>  opens;
+   int           nfmt;
+
+   plan.ops.clear();
+   plan.types.clear();
+   plan.sizes.clear();
+   plan.valid   = false;
+
+   fmt.push_back(0);
+   if ( (nfmt = eviofmt(&fmt[0],ifmt,sizeof(ifmt))) <= 0 ) return;
+
+   for (int k=0; k < nfmt; k++) {
+      uint n    = ifmt[k] / 16;
+      uint code = ifmt[k] % 16;
+      Op   op;
+
+      op.kind        = OpLeaf;
+      op.type        = 0;
+      op.size        = 0;
+      op.count       = n;
+      op.column      = -1;
+      op.countColumn = -1;
+      op.match       = 0;
+
+      // Right parenthesis
+      if ( ifmt[k] == 0 ) {
+         if ( opens.empty() ) return;
+         op.kind  = OpClose;
+         op.match = opens.back();
+         plan.ops[opens.back()].match = k;
+         opens.pop_back();
+      }
+
+      // Left parenthesis, repeats fixed or from the data
+      else if ( code == 0 || code == 15 ) {
+         if ( opens.size() >= MaxDepth ) return;
+         op.kind = OpOpen;
+         if ( code == 15 ) {
+            op.count       = CountFromData;
+            op.countColumn = plan.types.size();
+            plan.types.push_back('N');
+            plan.sizes.push_back(4);
+         }
+         opens.push_back(k);
+      }
+
+      // Values
+      else {
+         if ( code > 12 ) return;
+         op.type = CodeType[code];
+         op.size = CodeSize[code];
+
+         // The only item of a last parenthesis takes the rest of the data, as in eviofmtswap
+         if ( ! opens.empty() && k == nfmt - 2 && opens.back() == (uint)(k - 1) ) op.count = CountToEnd;
+         else if ( n == 0 ) {
+            op.count       = CountFromData;
+            op.countColumn = plan.types.size();
+            plan.types.push_back('N');
+            plan.sizes.push_back(4);
+         }
+         op.column = plan.types.size();
+         plan.types.push_back(op.type);
+         plan.sizes.push_back(op.size);
+      }
+      plan.ops.push_back(op);
+   }
+   plan.valid = opens.empty() && ! plan.ops.empty();
+}
+
+// Read a count from the data
+bool EvioComposite::readCount ( const unsigned char *data, uint bytes, uint &pos, bool swapped, int column, int &count ) {
+   int32_t value;
+
+   if ( pos + 4 > bytes ) return(false);
+   memcpy(&value,data + pos,4);
+   if ( swapped ) value = EVIO_SWAP32(value);
+   pos += 4;
+   if ( value < 0 ) return(false);
+   append(column,(const unsigned char *)&value,1,false);
+   count = value;
+   return(true);
+}
+
+// Append values to a column, swapping them if needed
+void EvioComposite::append ( uint column, const unsigned char *data, uint count, bool swapped ) {
+   Column        &col  = columns_[column];
+   uint          need = (col.count + count) * col.size;
+   unsigned char *dst;
+   uint          i;
+
+   if ( count == 0 ) return;
+   if ( need > col.bytes.size() ) col.bytes.resize(need > 2 * col.bytes.size() ? need : 2 * col.bytes.size());
+   dst = &col.bytes[col.count * col.size];
+   col.count += count;
+
+   if ( ! swapped || col.size == 1 ) {
+      memcpy(dst,data,count * col.size);
+      return;
+   }
+
+   // Data is not aligned in composite payloads
+   if ( col.size == 2 ) {
+      uint16_t v;
+      for (i=0; i < count; i++) {
+         memcpy(&v,data + 2 * i,2);
+         v = EVIO_SWAP16(v);
+         memcpy(dst + 2 * i,&v,2);
+      }
+   }
+   else if ( col.size == 4 ) {
+      uint32_t v;
+      for (i=0; i < count; i++) {
+         memcpy(&v,data + 4 * i,4);
+         v = EVIO_SWAP32(v);
+         memcpy(dst + 4 * i,&v,4);
+      }
+   }
+   else {
+      uint64_t v;
+      for (i=0; i < count; i++) {
+         memcpy(&v,data + 8 * i,8);
+         v = EVIO_SWAP64(v);
+         memcpy(dst + 8 * i,&v,8);
+      }
+   }
+}
+
+// Run a plan over data
+bool EvioComposite::run ( const Plan &plan, const unsigned char *data, uint bytes, bool swapped ) {
+   uint pos   = 0;
+   uint start = 0;
+   uint op    = 0;
+   uint depth = 0;
+   uint open[MaxDepth];
+   int  left[MaxDepth];
+   int  count;
+
+   while ( pos < bytes ) {
+
+      // Format ended before the data, next record
+      if ( op >= plan.ops.size() ) {
+         if ( pos == start ) return(false);
+         start = pos;
+         op    = 0;
+         continue;
+      }
+
+      const Op &o = plan.ops[op];
+      switch ( o.kind ) {
+
+         case OpOpen:
+            count = o.count;
+            if ( count == CountFromData && ! readCount(data,bytes,pos,swapped,o.countColumn,count) ) return(false);
+
+            // Unlike eviofmtswap, a group repeated 0 times is skipped
+            if ( count == 0 ) {
+               op = o.match + 1;
+               break;
+            }
+            open[depth]   = op;
+            left[depth++] = count;
+            op++;
+            break;
+
+         case OpClose:
+            if ( --left[depth-1] > 0 ) op = open[depth-1] + 1;
+            else {
+               depth--;
+               op++;
+            }
+            break;
+
+         default:
+            count = o.count;
+            if ( count == CountFromData && ! readCount(data,bytes,pos,swapped,o.countColumn,count) ) return(false);
+            if ( count == CountToEnd || (uint)count > (bytes - pos) / o.size ) count = (bytes - pos) / o.size;
+            append(o.column,data + pos,count,swapped);
+            pos += count * o.size;
+            op++;
+            break;
+      }
+   }
+   return(true);
+}
+
+// Decode a composite payload
+bool EvioComposite::decode ( const uint *buf, uint words, bool swapped ) {
+   uint   header, length, padding;
+   string format;
+
+   format_      = "";
+   columnCount_ = 0;
+   if ( words < 1 ) return(false);
+
+   // Format tagsegment: the string is bytes, never swapped
+   header = swapped ? EVIO_SWAP32(buf[0]) : buf[0];
+   length = header & 0xffff;
+   if ( 1 + length + 2 > words ) return(false);
+   const char *str = (const char *)&buf[1];
+   for (uint i=0; i < length * 4 && str[i] != 0 && str[i] != 4; i++) format += str[i];
+
+   // Data bank
+   header  = swapped ? EVIO_SWAP32(buf[1+length]) : buf[1+length];
+   if ( header < 1 || 1 + length + header + 1 > words ) return(false);
+   uint bytes = (header - 1) * 4;
+   header  = swapped ? EVIO_SWAP32(buf[2+length]) : buf[2+length];
+   tag_    = (header >> 16) & 0xffff;
+   num_    = header & 0xff;
+   padding = (header >> 14) & 0x3;
+
+   return(decode(format,&buf[3+length],bytes - padding,swapped));
+}
+
+// Decode composite data with a given format
+bool EvioComposite::decode ( string format, const void *data, uint bytes, bool swapped ) {
+   map<string,Plan>::iterator it;
+
+   format_      = format;
+   columnCount_ = 0;
+
+   if ( (it = plans_.find(format)) == plans_.end() ) {
+      it = plans_.insert(make_pair(format,Plan())).first;
+      compile(format,it->second);
+   }
+   const Plan &plan = it->second;
+   if ( ! plan.valid ) return(false);
+
+   if ( columns_.size() < plan.types.size() ) columns_.resize(plan.types.size());
+   columnCount_ = plan.types.size();
+   for (uint i=0; i < columnCount_; i++) {
+      columns_[i].type  = plan.types[i];
+      columns_[i].size  = plan.sizes[i];
+      columns_[i].count = 0;
+   }
+   return(run(plan,(const unsigned char *)data,bytes,swapped));
+}
+
+// Format of the last payload
+string EvioComposite::format ( ) {
+   return(format_);
+}
+
+// Tag of the data bank of the last payload
+uint EvioComposite::tag ( ) {
+   return(tag_);
+}
+
+// Num of the data bank of the last payload
+uint EvioComposite::num ( ) {
+   return(num_);
+}
+
+// Number of columns
+uint EvioComposite::columns ( ) {
+   return(columnCount_);
+}
+
+// Column of the last payload
+EvioComposite::Column *EvioComposite::column ( uint index ) {
+   if ( index >= columnCount_ ) return(NULL);
+   return(&columns_[index]);
+}
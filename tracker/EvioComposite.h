@@ -0,0 +1,168 @@
+//-----------------------------------------------------------------------------
+// File          : EvioComposite.h
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Decoder of EVIO COMPOSITE data (ECal FADC and trigger banks).
+//
+// A composite payload is a tagsegment holding a format string such as
+// "c,i,l,N(c,Ns)" followed by a bank holding the data. The format string is
+// compiled once into a plan of copy and repeat operations, kept by format
+// string, and each payload is then decoded in one pass into one column per
+// format item (structure of arrays), byte swapping on the fly when the data
+// is of the other endianness.
+//
+// Columns are numbered in the order the items appear in the format. A count
+// taken from the data ('N') gets a column of its own, just before the item
+// or group it counts, so "c,i,l,N(c,Ns)" gives the columns
+//    0 c (slot), 1 i (trigger), 2 l (time), 3 N (channels),
+//    4 c (channel), 5 N (samples), 6 s (samples of all channels)
+// and the counts tell which values belong to which repeat. The format is
+// repeated from its start until the data ends, one record per FADC slot, the
+// way the ROCs write these banks and the Java EVIO reader reads them
+// (eviofmtswap repeats the last parenthesis instead).
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#ifndef __EVIO_COMPOSITE_H__
+#define __EVIO_COMPOSITE_H__
+
+#include <string>
+#include <map>
+#include <vector>
+#include <sys/types.h>
+using namespace std;
+
+//! Decoded composite data
+class EvioComposite {
+
+   public:
+
+      //! One column of values, all of one format item
+      class Column {
+
+         public:
+
+            //! Format character: i F a S s C c D L l I A, or N for a count
+            char type;
+
+            //! Bytes per value
+            uint size;
+
+            //! Number of values
+            uint count;
+
+            //! Values, native byte order, in the first count * size bytes
+            vector<unsigned char> bytes;
+
+            //! Values as an array of the C type of the format character
+            template <class T> const T *values ( ) const {
+               return((const T *)(bytes.empty() ? NULL : &bytes[0]));
+            }
+      };
+
+   private:
+
+      // Plan operations
+      enum OpKind { OpLeaf, OpOpen, OpClose };
+
+      // Count taken from the data
+      static const int CountFromData = 0;
+
+      // Repeat until the data ends
+      static const int CountToEnd = -1;
+
+      // One operation
+      struct Op {
+         uint kind;
+         char type;
+         uint size;
+         int  count;        // Fixed count, CountFromData or CountToEnd
+         int  column;       // Column of the values, -1 for groups
+         int  countColumn;  // Column of the count from data, -1 if fixed
+         uint match;        // Matching open or close of a group
+      };
+
+      // Compiled format
+      struct Plan {
+         vector<Op>   ops;
+         vector<char> types;     // Column types
+         vector<uint> sizes;     // Column value sizes
+         bool         valid;
+      };
+
+      // Deepest parenthesis nesting, as in eviofmtswap
+      static const uint MaxDepth = 10;
+
+      // Plans by format string
+      map<string,Plan> plans_;
+
+      // Columns of the last payload
+      vector<Column> columns_;
+      uint           columnCount_;
+
+      // Last payload
+      string format_;
+      uint   tag_;
+      uint   num_;
+
+      // Compile a format
+      static void compile ( const string &format, Plan &plan );
+
+      // Run a plan over data
+      bool run ( const Plan &plan, const unsigned char *data, uint bytes, bool swapped );
+
+      // Read a count from the data
+      bool readCount ( const unsigned char *data, uint bytes, uint &pos, bool swapped, int column, int &count );
+
+      // Append values to a column
+      void append ( uint column, const unsigned char *data, uint count, bool swapped );
+
+   public:
+
+      //! Constructor
+      EvioComposite ( );
+
+      //! Decode a composite payload
+      /*!
+       * Returns false if the payload or its format is malformed.
+       * \param buf Payload, starting at the format tagsegment header
+       * \param words Payload length in 32 bit words
+       * \param swapped True if the payload, headers included, is of the other endianness
+      */
+      bool decode ( const uint *buf, uint words, bool swapped );
+
+      //! Decode composite data with a given format
+      /*!
+       * \param format Format string
+       * \param data Data, without bank header
+       * \param bytes Data length in bytes
+       * \param swapped True if the data is of the other endianness
+      */
+      bool decode ( string format, const void *data, uint bytes, bool swapped );
+
+      //! Format of the last payload
+      string format ( );
+
+      //! Tag of the data bank of the last payload
+      uint tag ( );
+
+      //! Num of the data bank of the last payload
+      uint num ( );
+
+      //! Number of columns
+      uint columns ( );
+
+      //! Column of the last payload
+      /*!
+       * \param index Column index, in the order of the format items
+      */
+      Column *column ( uint index );
+};
+
+#endif
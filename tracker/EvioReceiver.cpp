@@ -0,0 +1,427 @@
+//-----------------------------------------------------------------------------
+// File          : EvioReceiver.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Receive an EVIO (version 4) block stream from a socket or a pipe.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+
+#include <EvioReceiver.h>
+#include <evio.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <poll.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <iostream>
+using namespace std;
+
+// Block header, as written by evWrite
+#define EVIO_HDSIZ      8
+#define EVIO_MAGIC      0xc0da0100
+#define EVIO_LAST_BLOCK 0x200
+
+// Poll period, bounds the time to notice a stop
+#define EVIO_RECEIVER_POLL_MS 200
+
+// Constructor
+EvioReceiver::EvioReceiver ( uint slots ) {
+   ring_.resize(slots < 2 ? 2 : slots);
+   head_        = 0;
+   count_       = 0;
+   listenFd_    = -1;
+   fd_          = -1;
+   ownFd_       = false;
+   persistent_  = false;
+   running_     = false;
+   stop_        = false;
+   ended_       = false;
+   blocks_      = 0;
+   bytes_       = 0;
+   connections_ = 0;
+   drops_       = 0;
+   stalls_      = 0;
+   pthread_mutex_init(&mutex_,NULL);
+   pthread_cond_init(&dataCond_,NULL);
+   pthread_cond_init(&freeCond_,NULL);
+}
+
+// Deconstructor
+EvioReceiver::~EvioReceiver ( ) {
+   close();
+   pthread_mutex_destroy(&mutex_);
+   pthread_cond_destroy(&dataCond_);
+   pthread_cond_destroy(&freeCond_);
+}
+
+// Keep waiting for producers after one sends the last block
+void EvioReceiver::setPersistent ( bool persistent ) {
+   persistent_ = persistent;
+}
+
+// Listen for producers
+bool EvioReceiver::listen ( string address ) {
+   struct addrinfo hints, *res;
+   string          host, port;
+   size_t          colon;
+   int             on = 1;
+
+   close();
+
+   colon = address.rfind(':');
+   if ( colon == string::npos ) port = address;
+   else {
+      host = address.substr(0,colon);
+      port = address.substr(colon+1);
+   }
+
+   memset(&hints,0,sizeof(hints));
+   hints.ai_family   = AF_INET;
+   hints.ai_socktype = SOCK_STREAM;
+   hints.ai_flags    = AI_PASSIVE;
+   if ( getaddrinfo(host == "" ? NULL : host.c_str(),port.c_str(),&hints,&res) != 0 ) {
+      cout << "EvioReceiver::listen -> Bad address: " << address << endl;
+      return(false);
+   }
+   listenFd_ = socket(res->ai_family,res->ai_socktype,res->ai_protocol);
+   if ( listenFd_ >= 0 ) setsockopt(listenFd_,SOL_SOCKET,SO_REUSEADDR,&on,sizeof(on));
+   if ( listenFd_ < 0 || bind(listenFd_,res->ai_addr,res->ai_addrlen) != 0 || ::listen(listenFd_,1) != 0 ) {
+      cout << "EvioReceiver::listen -> Failed to listen on " << address << ": " << strerror(errno) << endl;
+      freeaddrinfo(res);
+      close();
+      return(false);
+   }
+   freeaddrinfo(res);
+
+   name_  = "tcp://" + address;
+   ownFd_ = true;
+   return(start());
+}
+
+// Read from an open pipe or socket
+bool EvioReceiver::attach ( int fd, string name ) {
+   close();
+   fd_    = fd;
+   ownFd_ = false;
+   name_  = name;
+   return(start());
+}
+
+// Start the receiver thread
+bool EvioReceiver::start ( ) {
+   head_  = 0;
+   count_ = 0;
+   stop_  = false;
+   ended_ = false;
+   if ( pthread_create(&thread_,NULL,run,this) != 0 ) {
+      cout << "EvioReceiver::start -> Failed to start receiver thread" << endl;
+      close();
+      return(false);
+   }
+   running_ = true;
+   return(true);
+}
+
+// Stop receiving and close the input
+void EvioReceiver::close ( ) {
+   if ( running_ ) {
+      pthread_mutex_lock(&mutex_);
+      stop_ = true;
+      pthread_cond_broadcast(&freeCond_);
+      pthread_mutex_unlock(&mutex_);
+      pthread_join(thread_,NULL);
+      running_ = false;
+   }
+   if ( fd_ >= 0 && ownFd_ ) ::close(fd_);
+   if ( listenFd_ >= 0 ) ::close(listenFd_);
+   fd_       = -1;
+   listenFd_ = -1;
+   head_     = 0;
+   count_    = 0;
+   ended_    = true;
+}
+
+// Receiver thread
+void *EvioReceiver::run ( void *arg ) {
+   EvioReceiver *receiver = (EvioReceiver *)arg;
+
+   receiver->receive();
+
+   pthread_mutex_lock(&receiver->mutex_);
+   receiver->ended_ = true;
+   pthread_cond_broadcast(&receiver->dataCond_);
+   pthread_mutex_unlock(&receiver->mutex_);
+   return(NULL);
+}
+
+// Wait for a producer
+bool EvioReceiver::accept ( ) {
+   struct sockaddr_in addr;
+   socklen_t          len;
+   struct pollfd      pfd;
+
+   pfd.fd     = listenFd_;
+   pfd.events = POLLIN;
+   while ( true ) {
+      pthread_mutex_lock(&mutex_);
+      bool stop = stop_;
+      pthread_mutex_unlock(&mutex_);
+      if ( stop ) return(false);
+      if ( poll(&pfd,1,EVIO_RECEIVER_POLL_MS) <= 0 ) continue;
+
+      len = sizeof(addr);
+      if ( (fd_ = ::accept(listenFd_,(struct sockaddr *)&addr,&len)) < 0 ) continue;
+
+      pthread_mutex_lock(&mutex_);
+      connections_++;
+      pthread_mutex_unlock(&mutex_);
+      cout << "EvioReceiver::accept -> Producer connected from " << inet_ntoa(addr.sin_addr) << " on " << name_ << endl;
+      return(true);
+   }
+}
+
+// Read bytes, returns 1 when done, 0 on end of file before the first byte, -1 otherwise
+int EvioReceiver::readFully ( void *data, uint size ) {
+   char          *ptr = (char *)data;
+   uint          got  = 0;
+   struct pollfd pfd;
+   int           ret;
+
+   pfd.fd     = fd_;
+   pfd.events = POLLIN;
+   while ( got < size ) {
+      pthread_mutex_lock(&mutex_);
+      bool stop = stop_;
+      pthread_mutex_unlock(&mutex_);
+      if ( stop ) return(-1);
+      if ( poll(&pfd,1,EVIO_RECEIVER_POLL_MS) == 0 ) continue;
+
+      ret = ::read(fd_,ptr + got,size - got);
+      if ( ret == 0 ) return(got == 0 ? 0 : -1);
+      if ( ret < 0 ) {
+         if ( errno == EINTR || errno == EAGAIN ) continue;
+         return(-1);
+      }
+      got += ret;
+   }
+   return(1);
+}
+
+// Take the next free slot, waiting if the ring is full
+EvioReceiver::Slot *EvioReceiver::waitFree ( ) {
+   Slot *slot;
+
+   pthread_mutex_lock(&mutex_);
+   if ( count_ == ring_.size() && ! stop_ ) stalls_++;
+   while ( count_ == ring_.size() && ! stop_ ) pthread_cond_wait(&freeCond_,&mutex_);
+   slot = stop_ ? NULL : &ring_[(head_ + count_) % ring_.size()];
+   pthread_mutex_unlock(&mutex_);
+   return(slot);
+}
+
+// Receive blocks until the stream ends or the receiver is stopped
+void EvioReceiver::receive ( ) {
+   uint header[EVIO_HDSIZ];
+   uint size, headerSize;
+   bool swapped, last;
+   bool sawLast = false;
+   Slot *slot;
+   int  ret;
+
+   while ( true ) {
+
+      // Wait for a producer; a pipe is not reopened
+      if ( fd_ < 0 ) {
+         if ( listenFd_ < 0 || ! accept() ) return;
+         sawLast = false;
+      }
+
+      // Block header
+      ret = readFully(header,sizeof(header));
+      if ( ret == 1 ) {
+         if ( header[7] == EVIO_MAGIC ) swapped = false;
+         else if ( header[7] == EVIO_SWAP32(EVIO_MAGIC) ) {
+            swapped = true;
+            for (uint i=0; i < EVIO_HDSIZ; i++) header[i] = EVIO_SWAP32(header[i]);
+         }
+         else {
+            cout << "EvioReceiver::receive -> Bad block header from " << name_ << ", dropping the connection" << endl;
+            ret = -1;
+         }
+         size       = header[0];
+         headerSize = header[2];
+         last       = (header[5] & EVIO_LAST_BLOCK) != 0;
+         if ( ret == 1 && (headerSize < EVIO_HDSIZ || size < headerSize || size > MaxBlockWords) ) {
+            cout << "EvioReceiver::receive -> Bad block size " << size << " from " << name_ << ", dropping the connection" << endl;
+            ret = -1;
+         }
+      }
+
+      // Block data, in the next free slot
+      if ( ret == 1 ) {
+         if ( (slot = waitFree()) == NULL ) return;
+         if ( slot->words.size() < size ) slot->words.resize(size);
+         memcpy(&slot->words[0],header,sizeof(header));
+         if ( size > EVIO_HDSIZ ) ret = readFully(&slot->words[EVIO_HDSIZ],(size - EVIO_HDSIZ) * sizeof(uint));
+         if ( ret == 0 ) ret = -1;
+      }
+
+      // Producer went away or sent garbage: drop the partial block and wait for the next one
+      if ( ret != 1 ) {
+         pthread_mutex_lock(&mutex_);
+         bool stop = stop_;
+         if ( ret < 0 && ! stop ) drops_++;
+         pthread_mutex_unlock(&mutex_);
+         if ( ownFd_ ) ::close(fd_);
+         fd_ = -1;
+         if ( stop || listenFd_ < 0 ) return;
+         if ( ret < 0 || ! sawLast ) cout << "EvioReceiver::receive -> Producer disconnected from " << name_ << ", waiting for it" << endl;
+         continue;
+      }
+
+      // Hand the block to the reader
+      slot->size    = size;
+      slot->pos     = headerSize;
+      slot->swapped = swapped;
+      pthread_mutex_lock(&mutex_);
+      count_++;
+      blocks_++;
+      bytes_ += size * sizeof(uint);
+      pthread_cond_signal(&dataCond_);
+      pthread_mutex_unlock(&mutex_);
+
+      if ( last ) {
+         sawLast = true;
+         if ( ! persistent_ ) return;
+      }
+   }
+}
+
+// Copy the next event, waiting for it
+int EvioReceiver::nextEvent ( uint *buffer, uint words, bool &swapped, int timeout ) {
+   struct timespec deadline;
+   uint            length;
+   int             ret;
+
+   if ( timeout >= 0 ) {
+      clock_gettime(CLOCK_REALTIME,&deadline);
+      deadline.tv_sec  += timeout / 1000;
+      deadline.tv_nsec += (timeout % 1000) * 1000000L;
+      if ( deadline.tv_nsec >= 1000000000L ) {
+         deadline.tv_sec++;
+         deadline.tv_nsec -= 1000000000L;
+      }
+   }
+
+   pthread_mutex_lock(&mutex_);
+   while ( true ) {
+      while ( count_ == 0 ) {
+         if ( ended_ ) {
+            pthread_mutex_unlock(&mutex_);
+            return(EOF);
+         }
+         if ( timeout < 0 ) pthread_cond_wait(&dataCond_,&mutex_);
+         else if ( pthread_cond_timedwait(&dataCond_,&mutex_,&deadline) == ETIMEDOUT && count_ == 0 && ! ended_ ) {
+            pthread_mutex_unlock(&mutex_);
+            return(Timeout);
+         }
+      }
+
+      // Events of the oldest block, then its slot goes back to the receiver
+      Slot &slot = ring_[head_];
+      ret = EOF;
+      if ( slot.pos < slot.size ) {
+         length = slot.swapped ? EVIO_SWAP32(slot.words[slot.pos]) : slot.words[slot.pos];
+         if ( length >= slot.size - slot.pos ) {
+            cout << "EvioReceiver::nextEvent -> Event overruns its block, dropping the rest of the block" << endl;
+            drops_++;
+            slot.pos = slot.size;
+         }
+         else {
+            length++;
+            if ( length > words ) ret = S_EVFILE_TRUNC;
+            else {
+               memcpy(buffer,&slot.words[slot.pos],length * sizeof(uint));
+               swapped = slot.swapped;
+               ret     = S_SUCCESS;
+            }
+            slot.pos += length;
+         }
+      }
+      if ( slot.pos >= slot.size ) {
+         head_ = (head_ + 1) % ring_.size();
+         count_--;
+         pthread_cond_signal(&freeCond_);
+      }
+      if ( ret != EOF ) {
+         pthread_mutex_unlock(&mutex_);
+         return(ret);
+      }
+   }
+}
+
+// Complete blocks received
+unsigned long long EvioReceiver::blocks ( ) {
+   unsigned long long ret;
+   pthread_mutex_lock(&mutex_);
+   ret = blocks_;
+   pthread_mutex_unlock(&mutex_);
+   return(ret);
+}
+
+// Bytes of the complete blocks received
+unsigned long long EvioReceiver::bytes ( ) {
+   unsigned long long ret;
+   pthread_mutex_lock(&mutex_);
+   ret = bytes_;
+   pthread_mutex_unlock(&mutex_);
+   return(ret);
+}
+
+// Producers connected so far
+uint EvioReceiver::connections ( ) {
+   uint ret;
+   pthread_mutex_lock(&mutex_);
+   ret = connections_;
+   pthread_mutex_unlock(&mutex_);
+   return(ret);
+}
+
+// Blocks dropped
+uint EvioReceiver::drops ( ) {
+   uint ret;
+   pthread_mutex_lock(&mutex_);
+   ret = drops_;
+   pthread_mutex_unlock(&mutex_);
+   return(ret);
+}
+
+// Times the ring was full
+uint EvioReceiver::stalls ( ) {
+   uint ret;
+   pthread_mutex_lock(&mutex_);
+   ret = stalls_;
+   pthread_mutex_unlock(&mutex_);
+   return(ret);
+}
+
+// Blocks waiting in the ring
+uint EvioReceiver::queued ( ) {
+   uint ret;
+   pthread_mutex_lock(&mutex_);
+   ret = count_;
+   pthread_mutex_unlock(&mutex_);
+   return(ret);
+}
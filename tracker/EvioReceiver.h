@@ -0,0 +1,160 @@
+//-----------------------------------------------------------------------------
+// File          : EvioReceiver.h
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Receive an EVIO (version 4) block stream from a socket or a pipe.
+//
+// A receiver thread reads whole blocks from the event builder (or any
+// producer writing the blocks of an EVIO file, e.g. meeg_evio_send) into a
+// ring of block buffers, and the reader takes the events out of the oldest
+// block as soon as it is complete. When the ring is full the receiver stops
+// reading, so the socket buffers fill and the producer is held back instead
+// of events being dropped.
+//
+// In listening mode a producer that goes away is waited for again: a block
+// cut short by the disconnect is dropped and the next connection starts on a
+// block boundary. The stream ends when a producer sends the last block (unless
+// the receiver is persistent) or, for a pipe, at end of file.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#ifndef __EVIO_RECEIVER_H__
+#define __EVIO_RECEIVER_H__
+
+#include <string>
+#include <vector>
+#include <pthread.h>
+#include <sys/types.h>
+using namespace std;
+
+//! EVIO block stream receiver
+class EvioReceiver {
+
+      // One block buffer of the ring
+      struct Slot {
+         vector<uint> words;
+         uint         size;      // Block length in words
+         uint         pos;       // Next event, used by the reader
+         bool         swapped;   // Block is of the other endianness
+      };
+
+      // Ring, protected by mutex_
+      vector<Slot>    ring_;
+      uint            head_;
+      uint            count_;
+      pthread_mutex_t mutex_;
+      pthread_cond_t  dataCond_;
+      pthread_cond_t  freeCond_;
+
+      // Input
+      int    listenFd_;
+      int    fd_;
+      bool   ownFd_;
+      string name_;
+      bool   persistent_;
+
+      // Receiver thread
+      pthread_t thread_;
+      bool      running_;
+      bool      stop_;
+      bool      ended_;
+
+      // Counters, protected by mutex_
+      unsigned long long blocks_;
+      unsigned long long bytes_;
+      uint               connections_;
+      uint               drops_;
+      uint               stalls_;
+
+      // Receiver thread
+      static void *run ( void *arg );
+
+      // Receive blocks until the stream ends or the receiver is stopped
+      void receive ( );
+
+      // Wait for a producer, returns false if stopped
+      bool accept ( );
+
+      // Read bytes, returns 1 when done, 0 on end of file before the first byte, -1 otherwise
+      int readFully ( void *data, uint size );
+
+      // Take the next free slot, waiting if the ring is full; NULL if stopped
+      Slot *waitFree ( );
+
+      // Start the receiver thread
+      bool start ( );
+
+   public:
+
+      //! Largest block accepted, in 32 bit words
+      static const uint MaxBlockWords = 64 * 1024 * 1024;
+
+      //! Status of nextEvent when the timeout expires
+      static const int Timeout = -2;
+
+      //! Constructor
+      /*!
+       * \param slots Number of block buffers in the ring, at least 2
+      */
+      EvioReceiver ( uint slots = 16 );
+
+      //! Deconstructor
+      ~EvioReceiver ( );
+
+      //! Keep waiting for producers after one sends the last block
+      void setPersistent ( bool persistent );
+
+      //! Listen for producers, returns false if the address can not be bound
+      /*!
+       * \param address "[host]:port" or "port"
+      */
+      bool listen ( string address );
+
+      //! Read from an open pipe or socket, returns false if the thread can not start
+      /*!
+       * \param fd Descriptor, not closed by the receiver
+       * \param name Name used in messages
+      */
+      bool attach ( int fd, string name );
+
+      //! Stop receiving and close the input
+      void close ( );
+
+      //! Copy the next event, waiting for it
+      /*!
+       * Returns S_SUCCESS, EOF at the end of the stream, Timeout, or
+       * S_EVFILE_TRUNC if the event is larger than the buffer (it is skipped).
+       * The event is as received: if swapped is set, none of it is swapped.
+       * \param buffer Event buffer
+       * \param words Size of the buffer in 32 bit words
+       * \param swapped Set if the event is of the other endianness
+       * \param timeout Milliseconds to wait, negative to wait until an event or the end
+      */
+      int nextEvent ( uint *buffer, uint words, bool &swapped, int timeout = -1 );
+
+      //! Complete blocks received
+      unsigned long long blocks ( );
+
+      //! Bytes of the complete blocks received
+      unsigned long long bytes ( );
+
+      //! Producers connected so far
+      uint connections ( );
+
+      //! Blocks dropped, cut short by a disconnect or malformed
+      uint drops ( );
+
+      //! Times the ring was full and the producer held back
+      uint stalls ( );
+
+      //! Blocks waiting in the ring
+      uint queued ( );
+};
+
+#endif
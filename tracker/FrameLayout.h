@@ -0,0 +1,37 @@
+//-----------------------------------------------------------------------------
+// File          : FrameLayout.h
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Word layout of the event frames, for code that walks the raw words of a
+// frame instead of going through the event classes.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#ifndef __FRAME_LAYOUT_H__
+#define __FRAME_LAYOUT_H__
+
+//! Words before the first sample of a DevboardEvent frame
+#define DevboardHeadWords 8
+
+//! Words after the last sample of a DevboardEvent frame
+#define DevboardTailWords 1
+
+//! Words of a DevboardEvent sample
+#define DevboardSampleWords 4
+
+//! Words before the first sample of a TrackerEvent frame
+#define TrackerHeadWords 1
+
+//! Words after the last sample of a TrackerEvent frame, before any TI data
+#define TrackerTailWords 1
+
+//! Words of a TriggerEvent sample
+#define TriggerSampleWords 4
+
+#endif
@@ -0,0 +1,306 @@
+//-----------------------------------------------------------------------------
+// File          : GaussPeak.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Gaussian peak fits of histograms without Minuit.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <math.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <vector>
+#include "GaussPeak.h"
+#include "RunningStats.h"
+using namespace std;
+
+// Window of the log-parabola fits, in sigmas
+#define GAUSS_PEAK_WINDOW 2.5
+
+// Iterations of the window cut and of the refinement
+#define GAUSS_PEAK_CUTS    20
+#define GAUSS_PEAK_LM_ITER 100
+
+// Inverse of a symmetric 3x3 matrix, false if singular
+static bool invert3 ( const double m[3][3], double inv[3][3] ) {
+   double det;
+
+   inv[0][0] = m[1][1]*m[2][2] - m[1][2]*m[2][1];
+   inv[0][1] = m[0][2]*m[2][1] - m[0][1]*m[2][2];
+   inv[0][2] = m[0][1]*m[1][2] - m[0][2]*m[1][1];
+   det = m[0][0]*inv[0][0] + m[1][0]*inv[0][1] + m[2][0]*inv[0][2];
+   if ( det == 0 || ! isfinite(det) ) return(false);
+
+   inv[1][0] = m[1][2]*m[2][0] - m[1][0]*m[2][2];
+   inv[1][1] = m[0][0]*m[2][2] - m[0][2]*m[2][0];
+   inv[1][2] = m[0][2]*m[1][0] - m[0][0]*m[1][2];
+   inv[2][0] = m[1][0]*m[2][1] - m[1][1]*m[2][0];
+   inv[2][1] = m[0][1]*m[2][0] - m[0][0]*m[2][1];
+   inv[2][2] = m[0][0]*m[1][1] - m[0][1]*m[1][0];
+   for (uint i=0; i < 3; i++) for (uint j=0; j < 3; j++) inv[i][j] /= det;
+   return(true);
+}
+
+// Solve m x = v for a symmetric 3x3 matrix
+static bool solve3 ( const double m[3][3], const double v[3], double x[3] ) {
+   double inv[3][3];
+
+   if ( ! invert3(m,inv) ) return(false);
+   for (uint i=0; i < 3; i++) x[i] = inv[i][0]*v[0] + inv[i][1]*v[1] + inv[i][2]*v[2];
+   return(true);
+}
+
+// Chi^2 of the gaussian p over the non-empty bins, with J^T W J and J^T W r if asked
+static double chi2Gauss ( const vector<double> &x, const vector<double> &y, const double p[3],
+                          double jtj[3][3], double jtr[3] ) {
+   double chi2 = 0;
+
+   if ( jtj != NULL ) {
+      memset(jtj,0,9*sizeof(double));
+      memset(jtr,0,3*sizeof(double));
+   }
+   for (uint i=0; i < x.size(); i++) {
+      double u = (x[i] - p[1]) / p[2];
+      double e = exp(-0.5 * u * u);
+      double r = y[i] - p[0] * e;
+      double w = 1.0 / y[i];
+      chi2 += r * r * w;
+      if ( jtj != NULL ) {
+         double d[3];
+         d[0] = e;
+         d[1] = p[0] * e * u / p[2];
+         d[2] = p[0] * e * u * u / p[2];
+         for (uint j=0; j < 3; j++) {
+            jtr[j] += d[j] * r * w;
+            for (uint k=0; k < 3; k++) jtj[j][k] += d[j] * d[k] * w;
+         }
+      }
+   }
+   return(chi2);
+}
+
+// Fit of one histogram, for any count type
+template <class T> bool GaussPeak::fitCounts ( const T *counts, uint bins, double xmin, double binWidth,
+                                               GaussPeakResult &result, bool refine ) {
+   vector<double> x, y;
+   double         ymax = 0;
+   uint           mode = 0;
+   uint           lo, hi;
+   double         mean, sigma, norm;
+   double         p[3], jtj[3][3], jtr[3], cov[3][3];
+
+   memset(&result,0,sizeof(result));
+
+   // Non-empty bins and the mode
+   for (uint i=0; i < bins; i++) {
+      if ( counts[i] <= 0 ) continue;
+      x.push_back(xmin + (i + 0.5) * binWidth);
+      y.push_back(counts[i]);
+      if ( counts[i] > ymax ) {
+         ymax = counts[i];
+         mode = i;
+      }
+   }
+   if ( x.empty() ) return(false);
+
+   // Start from the width at half maximum
+   lo = hi = mode;
+   while ( lo > 0 && counts[lo-1] > ymax / 2 ) lo--;
+   while ( hi + 1 < bins && counts[hi+1] > ymax / 2 ) hi++;
+   mean  = xmin + (mode + 0.5) * binWidth;
+   sigma = (hi - lo + 1) * binWidth / 2.3548;
+   if ( sigma < 0.5 * binWidth ) sigma = 0.5 * binWidth;
+   norm  = ymax;
+
+   // Log-parabola around the mode, cutting the window until it stops moving
+   for (uint cut=0; cut < GAUSS_PEAK_CUTS; cut++) {
+      double half = GAUSS_PEAK_WINDOW * sigma;
+      double s[5] = { 0, 0, 0, 0, 0 };
+      double t[3] = { 0, 0, 0 };
+      double m[3][3], abc[3];
+      double sw = 0, sx = 0, sxx = 0;
+      uint   used = 0;
+      int    first, last;
+
+      if ( half < 1.5 * binWidth ) half = 1.5 * binWidth;
+      first = (int)floor((mean - half - xmin) / binWidth);
+      last  = (int)ceil((mean + half - xmin) / binWidth);
+      if ( first < 0 ) first = 0;
+      if ( last > (int)bins - 1 ) last = bins - 1;
+
+      // Coordinates in bins from the current mean, for conditioning
+      for (int i=first; i <= last; i++) {
+         if ( counts[i] <= 0 ) continue;
+         double u  = (xmin + (i + 0.5) * binWidth - mean) / binWidth;
+         double yi = counts[i];
+         double ly = log(yi);
+         double uk = yi;
+         for (uint k=0; k < 5; k++) {
+            s[k] += uk;
+            if ( k < 3 ) t[k] += uk * ly;
+            uk *= u;
+         }
+         sw  += yi;
+         sx  += yi * u;
+         sxx += yi * u * u;
+         used++;
+      }
+
+      bool fitted = false;
+      if ( used >= 3 ) {
+         for (uint j=0; j < 3; j++) for (uint k=0; k < 3; k++) m[j][k] = s[j+k];
+         if ( solve3(m,t,abc) && abc[2] < 0 ) {
+            double newMean  = mean + binWidth * (-abc[1] / (2 * abc[2]));
+            double newSigma = binWidth * sqrt(-1.0 / (2 * abc[2]));
+            if ( isfinite(newMean) && isfinite(newSigma) && fabs(newMean - mean) <= half ) {
+               bool done = fabs(newMean - mean) < 1e-3 * sigma && fabs(newSigma - sigma) < 1e-3 * sigma;
+               norm   = exp(abc[0] - abc[1] * abc[1] / (4 * abc[2]));
+               mean   = newMean;
+               sigma  = newSigma;
+               fitted = true;
+               if ( done ) break;
+            }
+         }
+      }
+
+      // Too narrow for a parabola: moments of the window
+      if ( ! fitted ) {
+         double var = sxx / sw - (sx / sw) * (sx / sw);
+         mean  += binWidth * sx / sw;
+         sigma  = binWidth * sqrt(var > 1.0 / 12 ? var : 1.0 / 12);
+         norm   = ymax;
+         break;
+      }
+   }
+
+   p[0] = norm;
+   p[1] = mean;
+   p[2] = sigma;
+
+   // Chi^2 fit as TH1::Fit("gaus")
+   if ( refine && x.size() > 3 ) {
+      double lambda = 1e-3;
+      double chi2   = chi2Gauss(x,y,p,jtj,jtr);
+
+      for (uint iter=0; iter < GAUSS_PEAK_LM_ITER && lambda < 1e10; iter++) {
+         double m[3][3], step[3], q[3], next;
+
+         memcpy(m,jtj,sizeof(m));
+         for (uint j=0; j < 3; j++) m[j][j] *= 1 + lambda;
+         if ( ! solve3(m,jtr,step) ) break;
+         for (uint j=0; j < 3; j++) q[j] = p[j] + step[j];
+         if ( q[2] <= 0 || (next = chi2Gauss(x,y,q,NULL,NULL)) > chi2 || ! isfinite(next) ) {
+            lambda *= 10;
+            continue;
+         }
+         memcpy(p,q,sizeof(p));
+         lambda /= 10;
+         if ( chi2 - next < 1e-9 * chi2 + 1e-12 ) {
+            chi2 = next;
+            break;
+         }
+         chi2 = chi2Gauss(x,y,p,jtj,jtr);
+      }
+   }
+
+   // Errors as Minuit: the inverse of J^T W J
+   result.chi2 = chi2Gauss(x,y,p,jtj,jtr);
+   result.ndf  = (int)x.size() - 3;
+   if ( invert3(jtj,cov) ) {
+      result.normError  = sqrt(fabs(cov[0][0]));
+      result.meanError  = sqrt(fabs(cov[1][1]));
+      result.sigmaError = sqrt(fabs(cov[2][2]));
+   }
+   result.norm  = p[0];
+   result.mean  = p[1];
+   result.sigma = fabs(p[2]);
+   result.ok    = true;
+   return(true);
+}
+
+// Fit a histogram
+bool GaussPeak::fit ( const float *counts, uint bins, double xmin, double binWidth, GaussPeakResult &result, bool refine ) {
+   return(fitCounts(counts,bins,xmin,binWidth,result,refine));
+}
+
+// Fit a histogram of double counts
+bool GaussPeak::fit ( const double *counts, uint bins, double xmin, double binWidth, GaussPeakResult &result, bool refine ) {
+   return(fitCounts(counts,bins,xmin,binWidth,result,refine));
+}
+
+// Fit a histogram of integer counts
+bool GaussPeak::fit ( const uint *counts, uint bins, double xmin, double binWidth, GaussPeakResult &result, bool refine ) {
+   return(fitCounts(counts,bins,xmin,binWidth,result,refine));
+}
+
+// Histograms shared by the threads of fitMany
+struct GaussPeakJob {
+   const float * const *counts;
+   uint                count;
+   uint                bins;
+   double              xmin;
+   double              binWidth;
+   GaussPeakResult     *results;
+   bool                refine;
+   uint                next;
+};
+
+// Fit histograms until none is left
+static void *gaussPeakThread ( void *arg ) {
+   GaussPeakJob *job = (GaussPeakJob *)arg;
+   uint         i;
+
+   while ( (i = __sync_fetch_and_add(&job->next,1)) < job->count ) {
+      if ( job->counts[i] == NULL ) memset(&job->results[i],0,sizeof(GaussPeakResult));
+      else GaussPeak::fit(job->counts[i],job->bins,job->xmin,job->binWidth,job->results[i],job->refine);
+   }
+   return(NULL);
+}
+
+// Fit many histograms of the same binning in threads
+void GaussPeak::fitMany ( uint count, const float * const *counts, uint bins, double xmin, double binWidth,
+                          GaussPeakResult *results, bool refine, uint threads ) {
+   GaussPeakJob      job;
+   vector<pthread_t> ids;
+   pthread_t         id;
+
+   job.counts   = counts;
+   job.count    = count;
+   job.bins     = bins;
+   job.xmin     = xmin;
+   job.binWidth = binWidth;
+   job.results  = results;
+   job.refine   = refine;
+   job.next     = 0;
+
+   if ( threads == 0 ) {
+      long cores = sysconf(_SC_NPROCESSORS_ONLN);
+      threads = cores > 0 ? cores : 1;
+   }
+   if ( threads > count ) threads = count;
+   for (uint t=1; t < threads; t++) if ( pthread_create(&id,NULL,gaussPeakThread,&job) == 0 ) ids.push_back(id);
+   gaussPeakThread(&job);
+   for (uint t=0; t < ids.size(); t++) pthread_join(ids[t],NULL);
+}
+
+// Gaussian with the moments of unbinned values
+bool GaussPeak::fromMoments ( RunningStats *stats, GaussPeakResult &result ) {
+   memset(&result,0,sizeof(result));
+   if ( stats->count() < 2 || stats->sigma() <= 0 ) return(false);
+
+   result.mean       = stats->mean();
+   result.sigma      = stats->sigma();
+   result.norm       = stats->count() / (sqrt(2 * M_PI) * result.sigma);
+   result.meanError  = stats->meanError();
+   result.sigmaError = stats->sigmaError() * result.sigma;
+   result.normError  = result.norm / sqrt((double)stats->count());
+   result.ok         = true;
+   return(true);
+}
@@ -0,0 +1,105 @@
+//-----------------------------------------------------------------------------
+// File          : GaussPeak.h
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Gaussian peak fits of histograms without Minuit.
+//
+// The peak is first found in closed form: ln(counts) of a gaussian is a
+// parabola, so a weighted linear least squares fit of ln(y) = a + b x + c x^2
+// (weights y, the inverse variance of ln(y)) over the bins around the mode
+// gives mean = -b/2c and sigma^2 = -1/2c. The window is then cut to mean +-
+// 2.5 sigma and the parabola fitted again until it stops moving, so tails and
+// pickup far from the peak do not pull it. Peaks one or two bins wide fall back
+// to the moments of the window.
+//
+// The optional refinement is a Levenberg-Marquardt fit of
+// [0]*exp(-0.5*((x-[1])/[2])^2) minimizing the same chi^2 as TH1::Fit("gaus")
+// (non-empty bins, errors sqrt(counts), bin centers). The errors are those of
+// Minuit for that chi^2: the square roots of the diagonal of the inverse of
+// J^T W J at the result, also given without the refinement.
+//
+// Everything works on plain count arrays (e.g. TH1F::GetArray()+1), so many
+// channels can be fitted in threads.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#ifndef __GAUSS_PEAK_H__
+#define __GAUSS_PEAK_H__
+#include <sys/types.h>
+using namespace std;
+
+class RunningStats;
+
+//! Result of a peak fit, parameters as the ROOT "gaus" function
+struct GaussPeakResult {
+   bool   ok;         //!< False if there was no peak to fit
+   double norm;       //!< Height of the peak, in counts per bin
+   double mean;
+   double sigma;
+   double normError;
+   double meanError;
+   double sigmaError;
+   double chi2;       //!< Chi^2 of the non-empty bins used
+   int    ndf;
+};
+
+//! Gaussian peak fits
+class GaussPeak {
+
+      // Fit of one histogram, for any count type
+      template <class T> static bool fitCounts ( const T *counts, uint bins, double xmin, double binWidth,
+                                                 GaussPeakResult &result, bool refine );
+
+   public:
+
+      //! Fit a histogram
+      /*!
+       * Returns false if the histogram is empty.
+       * \param counts Bin contents, without underflow
+       * \param bins Number of bins
+       * \param xmin Low edge of the first bin
+       * \param binWidth Bin width
+       * \param result Fit result
+       * \param refine Refine with a chi^2 fit, as TH1::Fit("gaus")
+      */
+      static bool fit ( const float *counts, uint bins, double xmin, double binWidth,
+                        GaussPeakResult &result, bool refine = true );
+
+      //! Fit a histogram of double counts
+      static bool fit ( const double *counts, uint bins, double xmin, double binWidth,
+                        GaussPeakResult &result, bool refine = true );
+
+      //! Fit a histogram of integer counts
+      static bool fit ( const uint *counts, uint bins, double xmin, double binWidth,
+                        GaussPeakResult &result, bool refine = true );
+
+      //! Fit many histograms of the same binning in threads
+      /*!
+       * \param count Number of histograms
+       * \param counts Bin contents of each histogram, NULL to skip one
+       * \param bins Number of bins
+       * \param xmin Low edge of the first bin
+       * \param binWidth Bin width
+       * \param results One result per histogram
+       * \param refine Refine with a chi^2 fit
+       * \param threads Number of threads, 0 for all cores
+      */
+      static void fitMany ( uint count, const float * const *counts, uint bins, double xmin, double binWidth,
+                            GaussPeakResult *results, bool refine = true, uint threads = 0 );
+
+      //! Gaussian with the moments of unbinned values
+      /*!
+       * The mean and sigma are those of the values, with their statistical
+       * errors; norm is the height for a bin width of 1.
+       * Returns false for less than 2 values.
+      */
+      static bool fromMoments ( RunningStats *stats, GaussPeakResult &result );
+};
+
+#endif
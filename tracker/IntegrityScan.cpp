@@ -0,0 +1,184 @@
+//-----------------------------------------------------------------------------
+// File          : IntegrityScan.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Data integrity checks of a run, frame by frame.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <string.h>
+#include <IntegrityScan.h>
+#include <DevboardEvent.h>
+#include <TiTriggerEvent.h>
+#include <TriggerSample.h>
+#include <FrameLayout.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+using namespace std;
+
+// Channels read out per hybrid
+#define HYBRID_CHANNELS 640
+
+// 14 bit ADC
+#define ADC_MASK 0x3FFF
+
+// Constructor
+IntegrityScan::IntegrityScan ( IntegrityReport *report, uint hybrids ) {
+   report_  = report;
+   hybrids_ = hybrids;
+   memset(report_,0,sizeof(IntegrityReport));
+}
+
+// Source of an id
+IntegritySource *IntegrityScan::source ( int id ) {
+   IntegritySource *src;
+
+   for (uint i=0; i < report_->sourceCount; i++)
+      if ( report_->sources[i].id == id ) return(&report_->sources[i]);
+
+   if ( report_->sourceCount == IntegrityReport::MaxSources ) {
+      report_->overflow++;
+      return(NULL);
+   }
+   src = &report_->sources[report_->sourceCount++];
+   memset(src,0,sizeof(IntegritySource));
+   src->id = id;
+   return(src);
+}
+
+// Sequence continuity, the counter wrapping at mask
+void IntegrityScan::checkSequence ( IntegritySource *src, uint seq, uint mask ) {
+   uint diff;
+
+   if ( src->frames > 1 ) {
+      diff = (seq - src->lastSeq) & mask;
+      if ( diff == 0 ) src->repeats++;
+      else if ( diff > mask / 2 ) src->backwards++;
+      else if ( diff > 1 ) {
+         src->gaps++;
+         src->missing += diff - 1;
+      }
+   }
+   src->lastSeq = seq;
+}
+
+// Sample count
+void IntegrityScan::checkCount ( IntegritySource *src, uint count ) {
+   if ( src->expected == 0 ) src->expected = (hybrids_ > 0) ? hybrids_ * HYBRID_CHANNELS : count;
+   if ( count != src->expected ) src->badCount++;
+}
+
+// Check a devboard frame
+void IntegrityScan::scan ( DevboardEvent *event ) {
+   IntegritySource *src;
+   DevboardSample  *sample;
+   uint            count;
+
+   report_->frames++;
+   if ( (src = source(event->fpgaAddress())) == NULL ) return;
+   src->frames++;
+   checkSequence(src,event->sequence(),0xFFFFFFFF);
+   if ( event->isTiFrame() ) return;
+
+   count = event->count();
+   checkCount(src,count);
+   report_->samples += count;
+   for (uint x=0; x < count; x++) {
+      sample = event->sample(x);
+      if ( sample->error() ) report_->errorFlags++;
+   }
+   scanAdc(event->data() + DevboardHeadWords,count,0,report_->zeroAdc,report_->saturatedAdc);
+}
+
+// Check a TriggerEvent frame
+void IntegrityScan::scan ( TiTriggerEvent *event, int id ) {
+   IntegritySource *src;
+   TriggerSample   sample;
+   uint            count;
+   uint            heads = 0;
+   uint            tails = 0;
+
+   report_->frames++;
+   if ( (src = source(id)) == NULL ) return;
+   src->frames++;
+   checkSequence(src,event->sequence(),0xFFFFFF);
+
+   if ( event->hasTiData() ) {
+      unsigned long ti = event->tiEventNumber();
+      unsigned long ts = event->timeStamp();
+      if ( src->haveTi ) {
+         if ( ti < src->lastTi ) src->tiBackwards++;
+         if ( ts < src->lastTs ) src->tsBackwards++;
+      }
+      src->lastTi = ti;
+      src->lastTs = ts;
+      src->haveTi = true;
+   }
+   else src->noTi++;
+
+   if ( ! event->eventCodeMatch() ) return;
+   count = event->count();
+   checkCount(src,count);
+   report_->samples += count;
+   for (uint x=0; x < count; x++) {
+      event->sample(x,&sample);
+      if ( sample.error() ) report_->errorFlags++;
+      if ( sample.head() ) heads++;
+      if ( sample.tail() ) tails++;
+   }
+   report_->headFlags += heads;
+   report_->tailFlags += tails;
+   if ( heads != tails ) report_->unpaired++;
+   scanAdc(event->data() + TrackerHeadWords,count,3,report_->zeroAdc,report_->saturatedAdc);
+}
+
+// Count zero and saturated ADC values of 4 word samples
+void IntegrityScan::scanAdc ( const uint *samples, uint count, uint headerWord,
+                              unsigned long long &zeros, unsigned long long &saturated ) {
+   uint x = 0;
+
+#ifdef __SSE2__
+   // One sample is 8 16 bit lanes: two for the header word, six ADC values
+   const __m128i adc  = _mm_set1_epi16(ADC_MASK);
+   const __m128i zero = _mm_setzero_si128();
+   const uint    keep = 0xFFFF & ~(0xF << (4 * headerWord));
+   uint          z = 0;
+   uint          s = 0;
+
+   for (; x < count; x++) {
+      __m128i v = _mm_and_si128(_mm_loadu_si128((const __m128i *)(samples + 4 * x)),adc);
+      z += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi16(v,zero)) & keep);
+      s += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi16(v,adc)) & keep);
+   }
+   zeros     += z / 2;
+   saturated += s / 2;
+#endif
+
+   for (; x < count; x++) {
+      for (uint w=0; w < 4; w++) {
+         if ( w == headerWord ) continue;
+         uint lo = samples[4 * x + w] & ADC_MASK;
+         uint hi = (samples[4 * x + w] >> 16) & ADC_MASK;
+         zeros     += (lo == 0) + (hi == 0);
+         saturated += (lo == ADC_MASK) + (hi == ADC_MASK);
+      }
+   }
+}
+
+// True if the report shows no data corruption
+bool IntegrityScan::clean ( const IntegrityReport *report ) {
+   if ( ! report->opened || report->unpaired > 0 || report->errorFlags > 0 || report->overflow > 0 ) return(false);
+   for (uint i=0; i < report->sourceCount; i++) {
+      const IntegritySource &src = report->sources[i];
+      if ( src.gaps > 0 || src.repeats > 0 || src.backwards > 0 || src.tiBackwards > 0 || src.tsBackwards > 0 || src.badCount > 0 )
+         return(false);
+   }
+   return(true);
+}
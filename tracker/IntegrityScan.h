@@ -0,0 +1,127 @@
+//-----------------------------------------------------------------------------
+// File          : IntegrityScan.h
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Data integrity checks of a run, frame by frame.
+//
+// For every source (FPGA address, or ROC bank tag for TriggerEvent frames)
+// the scan checks that the frame sequence counter counts up by one, that the
+// TI event number and timestamp never go back, and that every data frame has
+// the expected number of samples (640 per hybrid when the number of hybrids
+// is given, else that of the first frame of the source). Over all samples it
+// counts the APV error flags, head and tail flags (frames where they do not
+// pair up) and ADC values that are zero or saturated; the ADC values are
+// compared 8 at a time with SSE2 when available.
+//
+// The report is a plain structure so it can be filled in a worker process,
+// in memory from sharedAlloc().
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#ifndef __INTEGRITY_SCAN_H__
+#define __INTEGRITY_SCAN_H__
+
+#include <sys/types.h>
+using namespace std;
+
+class DevboardEvent;
+class TiTriggerEvent;
+
+//! Checks of one source of frames
+struct IntegritySource {
+   int                id;           //!< FPGA address or ROC bank tag
+   unsigned long long frames;       //!< Frames read
+   unsigned long long gaps;         //!< Sequence jumps forward
+   unsigned long long missing;      //!< Frames skipped by the jumps
+   unsigned long long repeats;      //!< Same sequence twice in a row
+   unsigned long long backwards;    //!< Sequence going back
+   unsigned long long tiBackwards;  //!< TI event number going back
+   unsigned long long tsBackwards;  //!< TI timestamp going back
+   unsigned long long noTi;         //!< Frames without TI data
+   unsigned long long badCount;     //!< Data frames with an unexpected number of samples
+   uint               expected;     //!< Expected samples per data frame
+   uint               lastSeq;
+   unsigned long      lastTi;
+   unsigned long      lastTs;
+   bool               haveTi;
+};
+
+//! Checks of one file
+struct IntegrityReport {
+
+   //! Most sources tracked, further ones are counted together
+   static const uint MaxSources = 64;
+
+   bool               opened;        //!< File could be opened
+   unsigned long long frames;        //!< Frames read
+   unsigned long long samples;       //!< Samples of the data frames
+   unsigned long long errorFlags;    //!< Samples with the APV error flag
+   unsigned long long headFlags;     //!< Samples with the APV head flag
+   unsigned long long tailFlags;     //!< Samples with the APV tail flag
+   unsigned long long unpaired;      //!< Frames with unequal head and tail flags
+   unsigned long long zeroAdc;       //!< ADC values of 0
+   unsigned long long saturatedAdc;  //!< ADC values of 0x3FFF
+   unsigned long long overflow;      //!< Frames of sources beyond MaxSources
+   uint               sourceCount;
+   IntegritySource    sources[MaxSources];
+};
+
+//! Integrity scan of a run
+class IntegrityScan {
+
+      // Report being filled
+      IntegrityReport *report_;
+
+      // Expected hybrids per frame, 0 to take the first frame of each source
+      uint hybrids_;
+
+      // Source of an id, NULL if there are too many
+      IntegritySource *source ( int id );
+
+      // Sequence continuity
+      void checkSequence ( IntegritySource *src, uint seq, uint mask );
+
+      // Sample count
+      void checkCount ( IntegritySource *src, uint count );
+
+   public:
+
+      //! Constructor
+      /*!
+       * \param report Report to fill, cleared
+       * \param hybrids Hybrids read out per frame, 0 if not known
+      */
+      IntegrityScan ( IntegrityReport *report, uint hybrids = 0 );
+
+      //! Check a devboard (test run) frame
+      void scan ( DevboardEvent *event );
+
+      //! Check a TriggerEvent frame
+      /*!
+       * \param event Frame, with the TI words of DataReadEvio in engineering run mode
+       * \param id Source, the ROC bank tag
+      */
+      void scan ( TiTriggerEvent *event, int id );
+
+      //! Count zero and saturated ADC values of 4 word samples
+      /*!
+       * \param samples First sample
+       * \param count Number of samples
+       * \param headerWord Word of each sample holding the flags instead of ADC values
+       * \param zeros Incremented by the zero values
+       * \param saturated Incremented by the saturated values
+      */
+      static void scanAdc ( const uint *samples, uint count, uint headerWord,
+                            unsigned long long &zeros, unsigned long long &saturated );
+
+      //! True if the report shows no data corruption (zero and saturated ADC values aside)
+      static bool clean ( const IntegrityReport *report );
+};
+
+#endif
@@ -0,0 +1,327 @@
+//-----------------------------------------------------------------------------
+// File          : NoiseSpectrum.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Averaged noise power spectra of all channels, in one pass over the data.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <algorithm>
+#include <string.h>
+#include "NoiseSpectrum.h"
+#include "BaselineFile.h"
+using namespace std;
+
+// Constructor
+RealFft::RealFft ( uint n ) {
+   n_         = n;
+   wavetable_ = gsl_fft_real_wavetable_alloc(n);
+   workspace_ = gsl_fft_real_workspace_alloc(n);
+}
+
+// Deconstructor
+RealFft::~RealFft ( ) {
+   gsl_fft_real_wavetable_free(wavetable_);
+   gsl_fft_real_workspace_free(workspace_);
+}
+
+// Sequence length
+uint RealFft::size ( ) {
+   return(n_);
+}
+
+// Number of frequency bins
+uint RealFft::bins ( ) {
+   return(n_ / 2 + 1);
+}
+
+// Transform count contiguous sequences
+void RealFft::transform ( double *data, uint count ) {
+   for (uint i=0; i < count; i++) gsl_fft_real_transform(data + i*n_,1,n_,wavetable_,workspace_);
+}
+
+// Add the power of a halfcomplex transform: data[0] = Re(0), data[2k-1] = Re(k),
+// data[2k] = Im(k), and data[n-1] = Re(n/2) for even n
+void RealFft::addPower ( const double *data, double *power ) {
+   uint k;
+
+   power[0] += data[0] * data[0] / n_;
+   for (k=1; k < (n_ + 1) / 2; k++)
+      power[k] += (data[2*k-1] * data[2*k-1] + data[2*k] * data[2*k]) / n_;
+   if ( n_ % 2 == 0 ) power[n_/2] += data[n_-1] * data[n_-1] / n_;
+}
+
+// Key from rce, feb and hybrid
+uint NoiseSpectrum::key ( uint rce, uint feb, uint hyb ) {
+   return((rce << 16) | (feb << 8) | hyb);
+}
+
+// Constructor
+NoiseSpectrum::NoiseSpectrum ( ) : sampleFft_(Samples), muxFft_(ApvChannels) {
+   uint chan;
+
+   // Readout position to channel, see meeg_utils
+   for (uint idx=0; idx < ApvChannels; idx++) {
+      chan = (32*(idx%4)) + (8*(idx/4)) - (31*(idx/16));
+      muxChannel_[idx] = chan;
+   }
+   warmup_ = 100;
+}
+
+// Deconstructor
+NoiseSpectrum::~NoiseSpectrum ( ) {
+   map<uint,Hybrid *>::iterator   it;
+   map<uint,Baseline *>::iterator bit;
+
+   for (it=hybrids_.begin(); it != hybrids_.end(); it++) delete it->second;
+   for (bit=baselines_.begin(); bit != baselines_.end(); bit++) delete [] bit->second;
+}
+
+// Load a .base file
+bool NoiseSpectrum::loadBaseline ( string file ) {
+   BaselineFile    in;
+   BaselineChannel ch;
+   uint            baseKey;
+   uint            i;
+   Baseline        *base;
+
+   if ( ! in.open(file) ) return(false);
+
+   while ( in.next(&ch) ) {
+      if ( ch.channel >= Channels ) continue;
+
+      baseKey = key(ch.rce,ch.feb,ch.hybrid);
+      if ( baselines_.find(baseKey) == baselines_.end() ) {
+         baselines_[baseKey] = new Baseline[Channels];
+         for (i=0; i < Channels; i++) baselines_[baseKey][i].loaded = false;
+      }
+      base = &(baselines_[baseKey][ch.channel]);
+      for (i=0; i < Samples; i++) base->mean[i] = ch.mean[i];
+      base->loaded = true;
+   }
+   in.close();
+   return(true);
+}
+
+// Warm up
+void NoiseSpectrum::setWarmup ( uint readouts ) {
+   warmup_ = readouts;
+}
+
+// Start a new frame
+void NoiseSpectrum::begin ( ) {
+   for (uint i=0; i < touched_.size(); i++) {
+      touched_[i]->touched = false;
+      memset(touched_[i]->present,0,sizeof(touched_[i]->present));
+      memset(touched_[i]->presentCount,0,sizeof(touched_[i]->presentCount));
+   }
+   touched_.clear();
+}
+
+// Add a readout
+void NoiseSpectrum::add ( uint rce, uint feb, uint hyb, uint apv, uint channel, uint *values ) {
+   map<uint,Hybrid *>::iterator it;
+   Hybrid *h;
+   uint   k = key(rce,feb,hyb);
+
+   if ( apv >= 5 || channel >= ApvChannels ) return;
+
+   if ( (it = hybrids_.find(k)) == hybrids_.end() ) {
+      h = new Hybrid;
+      memset(h,0,sizeof(Hybrid));
+      h->rce = rce;
+      h->feb = feb;
+      h->hyb = hyb;
+      hybrids_[k] = h;
+   }
+   else h = it->second;
+
+   if ( ! h->touched ) {
+      h->touched = true;
+      touched_.push_back(h);
+   }
+   if ( ! h->present[apv][channel] ) {
+      h->present[apv][channel] = true;
+      h->presentCount[apv]++;
+   }
+   for (uint y=0; y < Samples; y++) h->values[apv][channel][y] = values[y];
+}
+
+// Transform the current frame of one APV
+void NoiseSpectrum::processApv ( Hybrid *h, uint apv ) {
+   map<uint,Baseline *>::iterator bit;
+   Baseline *base = NULL;
+   Apv      *a = &(h->apvs[apv]);
+   uint     used[ApvChannels];
+   uint     count = 0;
+   uint     ch;
+   uint     idx;
+   double   cm[Samples];
+   double   sum;
+
+   if ( (bit = baselines_.find(key(h->rce,h->feb,h->hyb))) != baselines_.end() ) base = bit->second;
+
+   // Pedestal subtract in place the channels that have a pedestal
+   for (uint c=0; c < ApvChannels; c++) {
+      if ( ! h->present[apv][c] ) continue;
+      idx = (4-apv)*128+c;
+      if ( base != NULL ) {
+         if ( ! base[idx].loaded ) continue;
+         for (uint y=0; y < Samples; y++) h->values[apv][c][y] -= base[idx].mean[y];
+      }
+      else {
+         // Running pedestal, including this readout
+         sum = 0;
+         for (uint y=0; y < Samples; y++) sum += h->values[apv][c][y];
+         h->readouts[idx]++;
+         h->pedestal[idx] += (sum / Samples - h->pedestal[idx]) / h->readouts[idx];
+         if ( h->readouts[idx] <= warmup_ ) continue;
+         for (uint y=0; y < Samples; y++) h->values[apv][c][y] -= h->pedestal[idx];
+      }
+      used[count++] = c;
+   }
+   if ( count == 0 ) return;
+
+   // Readout order sequences, complete APVs only
+   if ( count == ApvChannels ) {
+      for (uint y=0; y < Samples; y++)
+         for (uint p=0; p < ApvChannels; p++) mux_[y*ApvChannels+p] = h->values[apv][muxChannel_[p]][y];
+      muxFft_.transform(mux_,Samples);
+      for (uint y=0; y < Samples; y++) muxFft_.addPower(mux_+y*ApvChannels,a->muxPower);
+      a->muxCount += Samples;
+   }
+   else a->skipped++;
+
+   // Common mode over the channels
+   for (uint y=0; y < Samples; y++) {
+      cm[y] = 0;
+      for (uint i=0; i < count; i++) cm[y] += h->values[apv][used[i]][y];
+      cm[y] /= count;
+   }
+   sampleFft_.transform(cm,1);
+   sampleFft_.addPower(cm,a->cmPower);
+   a->cmCount++;
+
+   // Channel sample sequences, one batch for the APV
+   batch_.resize(count*Samples);
+   for (uint i=0; i < count; i++)
+      memcpy(&batch_[i*Samples],h->values[apv][used[i]],Samples*sizeof(double));
+   sampleFft_.transform(&batch_[0],count);
+   for (uint i=0; i < count; i++) {
+      ch = (4-apv)*128+used[i];
+      sampleFft_.addPower(&batch_[i*Samples],h->power[ch]);
+      h->count[ch]++;
+   }
+}
+
+// Transform and accumulate the current frame
+void NoiseSpectrum::process ( ) {
+   for (uint i=0; i < touched_.size(); i++)
+      for (uint apv=0; apv < 5; apv++)
+         if ( touched_[i]->presentCount[apv] > 0 ) processApv(touched_[i],apv);
+}
+
+// Hybrids seen
+uint NoiseSpectrum::hybrids ( ) {
+   return(hybrids_.size());
+}
+
+// Write the averaged spectra
+void NoiseSpectrum::report ( ostream &out ) {
+   map<uint,Hybrid *>::iterator it;
+   Hybrid *h;
+   Apv    *a;
+   double chMean[SampleBins];
+   uint   chCount;
+
+   out << "# readout order spectra, bin k at k/" << ApvChannels << " of the multiplexing rate" << endl;
+   out << "# rce feb hyb apv sequences skipped_frames power[0.." << MuxBins-1 << "]" << endl;
+   for (it=hybrids_.begin(); it != hybrids_.end(); it++) {
+      h = it->second;
+      for (uint apv=0; apv < 5; apv++) {
+         a = &(h->apvs[apv]);
+         if ( a->muxCount == 0 && a->skipped == 0 ) continue;
+         out << "mux " << h->rce << " " << h->feb << " " << h->hyb << " " << apv << " " << a->muxCount << " " << a->skipped;
+         for (uint k=0; k < MuxBins; k++) out << " " << (a->muxCount > 0 ? a->muxPower[k] / a->muxCount : 0);
+         out << endl;
+      }
+   }
+
+   out << "# sample spectra of the APV average, bin k at k/" << Samples << " of the sampling rate" << endl;
+   out << "# rce feb hyb apv frames common_mode[0.." << SampleBins-1 << "] channel_mean[0.." << SampleBins-1
+       << "] coherent_fraction[0.." << SampleBins-1 << "]" << endl;
+   for (it=hybrids_.begin(); it != hybrids_.end(); it++) {
+      h = it->second;
+      for (uint apv=0; apv < 5; apv++) {
+         a = &(h->apvs[apv]);
+         if ( a->cmCount == 0 ) continue;
+
+         chCount = 0;
+         for (uint k=0; k < SampleBins; k++) chMean[k] = 0;
+         for (uint c=(4-apv)*128; c < (5-apv)*128; c++) {
+            if ( h->count[c] == 0 ) continue;
+            for (uint k=0; k < SampleBins; k++) chMean[k] += h->power[c][k] / h->count[c];
+            chCount++;
+         }
+         out << "cm " << h->rce << " " << h->feb << " " << h->hyb << " " << apv << " " << a->cmCount;
+         for (uint k=0; k < SampleBins; k++) out << " " << a->cmPower[k] / a->cmCount;
+         for (uint k=0; k < SampleBins; k++) out << " " << (chCount > 0 ? chMean[k] / chCount : 0);
+         for (uint k=0; k < SampleBins; k++)
+            out << " " << (chMean[k] > 0 ? (a->cmPower[k] / a->cmCount) / (chMean[k] / chCount / chCount) : 0);
+         out << endl;
+      }
+   }
+
+   out << "# channel sample spectra" << endl;
+   out << "# rce feb hyb channel readouts power[0.." << SampleBins-1 << "]" << endl;
+   for (it=hybrids_.begin(); it != hybrids_.end(); it++) {
+      h = it->second;
+      for (uint c=0; c < Channels; c++) {
+         if ( h->count[c] == 0 ) continue;
+         out << "ch " << h->rce << " " << h->feb << " " << h->hyb << " " << c << " " << h->count[c];
+         for (uint k=0; k < SampleBins; k++) out << " " << h->power[c][k] / h->count[c];
+         out << endl;
+      }
+   }
+}
+
+// Write the strongest readout order bins
+void NoiseSpectrum::peaks ( ostream &out, uint count ) {
+   map<uint,Hybrid *>::iterator it;
+   vector< pair<double,uint> >  bins;
+   vector<double>               sorted;
+   Hybrid *h;
+   Apv    *a;
+   double median;
+
+   for (it=hybrids_.begin(); it != hybrids_.end(); it++) {
+      h = it->second;
+      for (uint apv=0; apv < 5; apv++) {
+         a = &(h->apvs[apv]);
+         if ( a->muxCount == 0 ) continue;
+
+         // Bin 0 is the common mode, it is not a pickup frequency
+         bins.clear();
+         sorted.clear();
+         for (uint k=1; k < MuxBins; k++) {
+            bins.push_back(make_pair(a->muxPower[k],k));
+            sorted.push_back(a->muxPower[k]);
+         }
+         nth_element(sorted.begin(),sorted.begin()+sorted.size()/2,sorted.end());
+         median = sorted[sorted.size()/2];
+         sort(bins.rbegin(),bins.rend());
+
+         out << "RCE " << h->rce << " FEB " << h->feb << " hybrid " << h->hyb << " APV " << apv << ":";
+         for (uint i=0; i < count && i < bins.size(); i++) {
+            out << " bin " << bins[i].second << " (" << (median > 0 ? bins[i].first / median : 0) << "x)";
+         }
+         out << endl;
+      }
+   }
+}
@@ -0,0 +1,215 @@
+//-----------------------------------------------------------------------------
+// File          : NoiseSpectrum.h
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Averaged noise power spectra of all channels, in one pass over the data.
+//
+// Readouts of a frame are collected with add() and transformed together by
+// process(), using one real FFT plan (GSL wavetable and workspace) per
+// sequence length for the whole run:
+//    - per channel, the 6 samples of each readout (4 frequency bins),
+//    - per APV, the 6 sample spectrum of the APV average (common mode),
+//    - per APV, for each sample, the 128 channel values in the order the
+//      APV multiplexes them out (65 bins), which shows pickup that is
+//      coherent over the readout of an APV frame.
+// Power is |X_k|^2 / n, so white noise of width sigma gives sigma^2 in every
+// bin. Comparing the common mode spectrum to the average channel spectrum
+// divided by the number of channels gives the coherent fraction of each
+// frequency: 1 for independent channels, up to 128 for common pickup.
+//
+// Values are pedestal subtracted with a .base file if one is loaded and with
+// the running mean of the channel otherwise; without a .base file a channel
+// is used once it has a number of readouts (warm up).
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#ifndef __NOISE_SPECTRUM_H__
+#define __NOISE_SPECTRUM_H__
+
+#include <string>
+#include <map>
+#include <vector>
+#include <iostream>
+#include <sys/types.h>
+#include <gsl/gsl_fft_real.h>
+using namespace std;
+
+//! Real FFT plan for one sequence length
+class RealFft {
+
+      uint                   n_;
+      gsl_fft_real_wavetable *wavetable_;
+      gsl_fft_real_workspace *workspace_;
+
+   public:
+
+      //! Constructor
+      /*!
+       * \param n Sequence length
+      */
+      RealFft ( uint n );
+
+      //! Deconstructor
+      ~RealFft ( );
+
+      //! Sequence length
+      uint size ( );
+
+      //! Number of frequency bins, n/2+1
+      uint bins ( );
+
+      //! Transform count contiguous sequences in place
+      /*!
+       * \param data Sequences, replaced by their GSL halfcomplex transforms
+       * \param count Number of sequences
+      */
+      void transform ( double *data, uint count );
+
+      //! Add the power of a transformed sequence
+      /*!
+       * \param data Halfcomplex transform
+       * \param power Power per bin, bins() values, added to
+      */
+      void addPower ( const double *data, double *power );
+};
+
+//! Averaged noise spectra
+class NoiseSpectrum {
+
+   public:
+
+      //! Channels per hybrid
+      static const uint Channels = 640;
+
+      //! Channels per APV
+      static const uint ApvChannels = 128;
+
+      //! Samples per readout
+      static const uint Samples = 6;
+
+      //! Bins of the sample spectra
+      static const uint SampleBins = Samples / 2 + 1;
+
+      //! Bins of the readout order spectra
+      static const uint MuxBins = ApvChannels / 2 + 1;
+
+   private:
+
+      // Sums of one APV
+      struct Apv {
+         double muxPower[MuxBins];
+         double muxCount;
+         double cmPower[SampleBins];
+         double cmCount;
+         uint   skipped;
+      };
+
+      // Sums and the current frame of one hybrid
+      struct Hybrid {
+         uint   rce;
+         uint   feb;
+         uint   hyb;
+         double power[Channels][SampleBins];
+         double count[Channels];
+         double pedestal[Channels];
+         double readouts[Channels];
+         Apv    apvs[5];
+
+         // Current frame, by APV and channel
+         bool   touched;
+         bool   present[5][ApvChannels];
+         uint   presentCount[5];
+         double values[5][ApvChannels][Samples];
+      };
+
+      // Pedestals of one channel from a .base file
+      struct Baseline {
+         float mean[Samples];
+         bool  loaded;
+      };
+
+      // Hybrids by key
+      map<uint,Hybrid *> hybrids_;
+      vector<Hybrid *>   touched_;
+
+      // Baselines by key, Channels entries each
+      map<uint,Baseline *> baselines_;
+
+      // Plans
+      RealFft sampleFft_;
+      RealFft muxFft_;
+
+      // Channel of each readout position
+      uint muxChannel_[ApvChannels];
+
+      // Readouts needed before a running pedestal is used
+      uint warmup_;
+
+      // Work buffers
+      vector<double> batch_;
+      double         mux_[Samples * ApvChannels];
+
+      // Key from rce, feb and hybrid
+      static uint key ( uint rce, uint feb, uint hyb );
+
+      // Transform the current frame of one APV
+      void processApv ( Hybrid *h, uint apv );
+
+   public:
+
+      //! Constructor
+      NoiseSpectrum ( );
+
+      //! Deconstructor
+      ~NoiseSpectrum ( );
+
+      //! Load a .base file for the pedestals, returns false if it can not be read
+      /*!
+       * \param file File name
+      */
+      bool loadBaseline ( string file );
+
+      //! Set the readouts needed before a running pedestal is used, default 100
+      void setWarmup ( uint readouts );
+
+      //! Start a new frame
+      void begin ( );
+
+      //! Add a readout to the current frame
+      /*!
+       * \param rce RCE address
+       * \param feb FEB address
+       * \param hyb Hybrid
+       * \param apv APV
+       * \param channel APV channel
+       * \param values The 6 ADC samples
+      */
+      void add ( uint rce, uint feb, uint hyb, uint apv, uint channel, uint *values );
+
+      //! Transform and accumulate the current frame
+      void process ( );
+
+      //! Hybrids seen
+      uint hybrids ( );
+
+      //! Write the averaged spectra
+      /*!
+       * \param out Output stream
+      */
+      void report ( ostream &out );
+
+      //! Write the strongest readout order bins of each APV, relative to the median bin
+      /*!
+       * \param out Output stream
+       * \param count Bins per APV
+      */
+      void peaks ( ostream &out, uint count );
+};
+
+#endif
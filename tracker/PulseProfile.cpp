@@ -0,0 +1,286 @@
+//-----------------------------------------------------------------------------
+// File          : PulseProfile.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Compact accumulator for calibration pulse samples.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <string.h>
+#include "PulseProfile.h"
+using namespace std;
+
+// Round down to a multiple of 1 << shift
+static int alignDown ( int value, uint shift ) {
+   int width = 1 << shift;
+   if ( value >= 0 ) return((value / width) * width);
+   return(-(((-value) + width - 1) / width) * width);
+}
+
+// Constructor
+PulseProfile::PulseProfile ( ) {
+   clear();
+}
+
+// Clear
+void PulseProfile::clear ( ) {
+   stats_.clear();
+   origin_ = 0;
+   shift_  = 0;
+   low_    = 0;
+   high_   = 0;
+   memset(bins_,0,sizeof(bins_));
+}
+
+// Rebin so that low-high fits
+void PulseProfile::cover ( int low, int high, uint shift ) {
+   uint newBins[PulseProfileBins];
+   int  origin;
+   int  span;
+
+   if ( shift < shift_ ) shift = shift_;
+
+   // Center the window on the range, widen only if it does not fit
+   while ( true ) {
+      span   = PulseProfileBins << shift;
+      origin = alignDown(low + (high - low) / 2 - span / 2,shift);
+      if ( origin > low ) origin = alignDown(low,shift);
+      if ( high < origin + span ) break;
+      shift++;
+   }
+   if ( origin == origin_ && shift == shift_ ) return;
+
+   // Old bins are aligned to a smaller or equal width, each lands in one new bin
+   memset(newBins,0,sizeof(newBins));
+   for (uint i=0; i < PulseProfileBins; i++) {
+      if ( bins_[i] == 0 ) continue;
+      newBins[(binLow(i) - origin) >> shift] += bins_[i];
+   }
+   memcpy(bins_,newBins,sizeof(bins_));
+   origin_ = origin;
+   shift_  = shift;
+}
+
+// Add a sample
+void PulseProfile::add ( int value ) {
+   if ( stats_.count() == 0 ) {
+      origin_ = value - PulseProfileBins / 2;
+      shift_  = 0;
+      low_    = value;
+      high_   = value;
+   }
+   else {
+      if ( value < low_ ) low_ = value;
+      if ( value > high_ ) high_ = value;
+      if ( value < origin_ || value >= origin_ + (int)(PulseProfileBins << shift_) )
+         cover(low_,high_,shift_);
+   }
+   bins_[(value - origin_) >> shift_]++;
+   stats_.add(value);
+}
+
+// Add the contents of another profile
+void PulseProfile::merge ( PulseProfile *other ) {
+   if ( other->count() == 0 ) return;
+   if ( count() == 0 ) {
+      *this = *other;
+      return;
+   }
+
+   if ( other->low_ < low_ ) low_ = other->low_;
+   if ( other->high_ > high_ ) high_ = other->high_;
+   cover(low_,high_,other->shift_);
+
+   for (uint i=0; i < PulseProfileBins; i++) {
+      if ( other->bins_[i] == 0 ) continue;
+      bins_[(other->binLow(i) - origin_) >> shift_] += other->bins_[i];
+   }
+   stats_.merge(&(other->stats_));
+}
+
+// Number of samples
+uint PulseProfile::count ( ) {
+   return(stats_.count());
+}
+
+// Mean
+double PulseProfile::mean ( ) {
+   return(stats_.mean());
+}
+
+// RMS about the mean
+double PulseProfile::rms ( ) {
+   return(stats_.rms());
+}
+
+// Median
+double PulseProfile::median ( ) {
+   uint   total = stats_.count();
+   uint   below = 0;
+   double frac;
+   uint   i;
+
+   if ( total == 0 ) return(0.0);
+
+   for (i=0; i < PulseProfileBins; i++) {
+      if ( bins_[i] == 0 ) continue;
+      if ( 2 * (below + bins_[i]) >= total ) break;
+      below += bins_[i];
+   }
+
+   // Unit bins: exact median, averaging the two middle values for even counts
+   if ( shift_ == 0 ) {
+      if ( 2 * (below + bins_[i]) > total ) return(binLow(i));
+      uint j = i + 1;
+      while ( j < PulseProfileBins && bins_[j] == 0 ) j++;
+      return((binLow(i) + binLow(j)) / 2.0);
+   }
+
+   // Wide bins: an even split between bins averages the nearest possible values
+   if ( 2 * (below + bins_[i]) == total ) {
+      uint j = i + 1;
+      while ( j < PulseProfileBins && bins_[j] == 0 ) j++;
+      int upper = binLow(i) + (int)binWidth() - 1;
+      int lower = binLow(j);
+      if ( upper > high_ ) upper = high_;
+      if ( lower < low_ ) lower = low_;
+      return((upper + lower) / 2.0);
+   }
+
+   // Otherwise interpolate within the bin holding the median
+   frac = (total / 2.0 - below) / bins_[i];
+   return(binLow(i) - 0.5 + frac * binWidth());
+}
+
+// Smallest sample
+int PulseProfile::low ( ) {
+   return(low_);
+}
+
+// Largest sample
+int PulseProfile::high ( ) {
+   return(high_);
+}
+
+// Bin width
+uint PulseProfile::binWidth ( ) {
+   return(1 << shift_);
+}
+
+// First value of a bin
+int PulseProfile::binLow ( uint bin ) {
+   return(origin_ + (int)(bin << shift_));
+}
+
+// Samples in a bin
+uint PulseProfile::binCount ( uint bin ) {
+   if ( bin >= PulseProfileBins ) return(0);
+   return(bins_[bin]);
+}
+
+// Constructor
+PulseProfileSet::PulseProfileSet ( ) {
+   memset(profiles_,0,sizeof(profiles_));
+}
+
+// Deconstructor
+PulseProfileSet::~PulseProfileSet ( ) {
+   clear();
+}
+
+// Remove all profiles
+void PulseProfileSet::clear ( ) {
+   for (uint p=0; p < Polarities; p++)
+      for (uint c=0; c < Channels; c++)
+         for (uint b=0; b < TimeBins; b++) {
+            if ( profiles_[p][c][b] != NULL ) delete profiles_[p][c][b];
+            profiles_[p][c][b] = NULL;
+         }
+}
+
+// Add a sample
+void PulseProfileSet::add ( uint polarity, uint channel, uint bin, int value ) {
+   if ( polarity >= Polarities || channel >= Channels || bin >= TimeBins ) return;
+   if ( profiles_[polarity][channel][bin] == NULL ) profiles_[polarity][channel][bin] = new PulseProfile;
+   profiles_[polarity][channel][bin]->add(value);
+}
+
+// Get a profile
+PulseProfile *PulseProfileSet::get ( uint polarity, uint channel, uint bin ) {
+   if ( polarity >= Polarities || channel >= Channels || bin >= TimeBins ) return(NULL);
+   return(profiles_[polarity][channel][bin]);
+}
+
+// Add the contents of another set
+void PulseProfileSet::merge ( PulseProfileSet *other ) {
+   for (uint p=0; p < Polarities; p++)
+      for (uint c=0; c < Channels; c++)
+         for (uint b=0; b < TimeBins; b++) {
+            if ( other->profiles_[p][c][b] == NULL ) continue;
+            if ( profiles_[p][c][b] == NULL ) profiles_[p][c][b] = new PulseProfile;
+            profiles_[p][c][b]->merge(other->profiles_[p][c][b]);
+         }
+}
+
+// Number of allocated profiles
+uint PulseProfileSet::filled ( ) {
+   uint ret = 0;
+
+   for (uint p=0; p < Polarities; p++)
+      for (uint c=0; c < Channels; c++)
+         for (uint b=0; b < TimeBins; b++)
+            if ( profiles_[p][c][b] != NULL ) ret++;
+   return(ret);
+}
+
+// Append the filled profiles to a blob: profile size, then index and profile
+void PulseProfileSet::pack ( string &blob ) {
+   uint size = sizeof(PulseProfile);
+   uint idx;
+
+   blob.append((char *)&size,sizeof(size));
+   for (uint p=0; p < Polarities; p++)
+      for (uint c=0; c < Channels; c++)
+         for (uint b=0; b < TimeBins; b++) {
+            if ( profiles_[p][c][b] == NULL ) continue;
+            idx = (p * Channels + c) * TimeBins + b;
+            blob.append((char *)&idx,sizeof(idx));
+            blob.append((char *)profiles_[p][c][b],sizeof(PulseProfile));
+         }
+}
+
+// Read profiles written by pack()
+bool PulseProfileSet::unpack ( const char *data, uint size ) {
+   const char *end = data + size;
+   uint       profileSize;
+   uint       idx;
+   PulseProfile *profile;
+
+   clear();
+   if ( size < sizeof(profileSize) ) return(false);
+   memcpy(&profileSize,data,sizeof(profileSize));
+   data += sizeof(profileSize);
+   if ( profileSize != sizeof(PulseProfile) ) return(false);
+
+   while ( data < end ) {
+      if ( data + sizeof(idx) + sizeof(PulseProfile) > end ) return(false);
+      memcpy(&idx,data,sizeof(idx));
+      data += sizeof(idx);
+      if ( idx >= Polarities * Channels * TimeBins ) return(false);
+
+      profile = new PulseProfile;
+      memcpy((void *)profile,data,sizeof(PulseProfile));
+      data += sizeof(PulseProfile);
+
+      if ( profiles_[idx / (Channels * TimeBins)][(idx / TimeBins) % Channels][idx % TimeBins] != NULL )
+         delete profiles_[idx / (Channels * TimeBins)][(idx / TimeBins) % Channels][idx % TimeBins];
+      profiles_[idx / (Channels * TimeBins)][(idx / TimeBins) % Channels][idx % TimeBins] = profile;
+   }
+   return(true);
+}
@@ -0,0 +1,159 @@
+//-----------------------------------------------------------------------------
+// File          : PulseProfile.h
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Compact accumulator for calibration pulse samples.
+//
+// A PulseProfile replaces a full 16384 bin ADC histogram for one
+// (polarity, channel, time bin). It keeps the running moments of the samples
+// and a 64 bin histogram whose bin width is a power of two. The histogram is
+// re-centered on the occupied range when a sample falls outside of it, and
+// the bin width is doubled only when the range no longer fits, so the median
+// is exact while the spread stays within 64 ADC counts and is interpolated
+// within one bin otherwise.
+//
+// PulseProfileSet holds the profiles of one hybrid, allocated on first use.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#ifndef __PULSE_PROFILE_H__
+#define __PULSE_PROFILE_H__
+
+#include <string>
+#include <sys/types.h>
+#include "RunningStats.h"
+using namespace std;
+
+//! Number of histogram bins in a profile
+#define PulseProfileBins 64
+
+//! Samples of one polarity, channel and time bin
+class PulseProfile {
+
+      // Running moments
+      RunningStats stats_;
+
+      // First value of bin 0, a multiple of the bin width
+      int origin_;
+
+      // Log2 of the bin width
+      uint shift_;
+
+      // Smallest and largest value
+      int low_;
+      int high_;
+
+      // Histogram
+      uint bins_[PulseProfileBins];
+
+      // Rebin so that low-high fits, with at least the given bin width
+      void cover ( int low, int high, uint shift );
+
+   public:
+
+      //! Constructor
+      PulseProfile ( );
+
+      //! Clear
+      void clear ( );
+
+      //! Add a sample
+      void add ( int value );
+
+      //! Add the contents of another profile
+      void merge ( PulseProfile *other );
+
+      //! Number of samples
+      uint count ( );
+
+      //! Mean
+      double mean ( );
+
+      //! RMS about the mean
+      double rms ( );
+
+      //! Median, same as doStats() while the bin width is 1
+      double median ( );
+
+      //! Smallest sample
+      int low ( );
+
+      //! Largest sample
+      int high ( );
+
+      //! Bin width in ADC counts
+      uint binWidth ( );
+
+      //! First value of a bin
+      int binLow ( uint bin );
+
+      //! Samples in a bin
+      uint binCount ( uint bin );
+};
+
+//! Profiles of one hybrid, by polarity, channel and time bin
+class PulseProfileSet {
+
+   public:
+
+      //! Polarities
+      static const uint Polarities = 2;
+
+      //! Channels
+      static const uint Channels = 640;
+
+      //! Time bins, 8 delay steps for each of the 6 samples
+      static const uint TimeBins = 48;
+
+   private:
+
+      // Profiles, NULL until filled
+      PulseProfile *profiles_[Polarities][Channels][TimeBins];
+
+   public:
+
+      //! Constructor
+      PulseProfileSet ( );
+
+      //! Deconstructor
+      ~PulseProfileSet ( );
+
+      //! Remove all profiles
+      void clear ( );
+
+      //! Add a sample
+      /*!
+       * \param polarity Pulse polarity, 0 or 1
+       * \param channel Channel number
+       * \param bin Time bin
+       * \param value ADC value
+      */
+      void add ( uint polarity, uint channel, uint bin, int value );
+
+      //! Get a profile, NULL if it has no samples
+      PulseProfile *get ( uint polarity, uint channel, uint bin );
+
+      //! Add the contents of another set
+      void merge ( PulseProfileSet *other );
+
+      //! Number of allocated profiles
+      uint filled ( );
+
+      //! Append the filled profiles to a binary blob
+      void pack ( string &blob );
+
+      //! Read profiles written by pack(), returns false if the blob is invalid
+      /*!
+       * \param data Start of the packed profiles
+       * \param size Size of the packed profiles
+      */
+      bool unpack ( const char *data, uint size );
+};
+
+#endif
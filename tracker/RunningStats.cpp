@@ -0,0 +1,210 @@
+//-----------------------------------------------------------------------------
+// File          : RunningStats.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Single pass statistics for one channel, and a convergence test for
+// pedestal/noise runs.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <math.h>
+#include "RunningStats.h"
+using namespace std;
+
+// Constructor
+RunningStats::RunningStats ( ) {
+   clear();
+}
+
+// Clear
+void RunningStats::clear ( ) {
+   count_ = 0;
+   mean_  = 0.0;
+   m2_    = 0.0;
+   m3_    = 0.0;
+   m4_    = 0.0;
+}
+
+// Add a value
+void RunningStats::add ( double value ) {
+   double n1 = count_;
+   double n;
+   double delta;
+   double deltaN;
+   double deltaN2;
+   double term;
+
+   count_++;
+   n       = count_;
+   delta   = value - mean_;
+   deltaN  = delta / n;
+   deltaN2 = deltaN * deltaN;
+   term    = delta * deltaN * n1;
+
+   mean_ += deltaN;
+   m4_   += term * deltaN2 * (n*n - 3*n + 3) + 6 * deltaN2 * m2_ - 4 * deltaN * m3_;
+   m3_   += term * deltaN * (n - 2) - 3 * deltaN * m2_;
+   m2_   += term;
+}
+
+// Add the contents of another accumulator
+void RunningStats::merge ( RunningStats *other ) {
+   double na;
+   double nb;
+   double n;
+   double delta;
+   double delta2;
+   double m2;
+   double m3;
+   double m4;
+
+   if ( other->count_ == 0 ) return;
+   if ( count_ == 0 ) {
+      *this = *other;
+      return;
+   }
+
+   na     = count_;
+   nb     = other->count_;
+   n      = na + nb;
+   delta  = other->mean_ - mean_;
+   delta2 = delta * delta;
+
+   m2 = m2_ + other->m2_ + delta2 * na * nb / n;
+   m3 = m3_ + other->m3_ + delta * delta2 * na * nb * (na - nb) / (n*n)
+      + 3 * delta * (na * other->m2_ - nb * m2_) / n;
+   m4 = m4_ + other->m4_ + delta2 * delta2 * na * nb * (na*na - na*nb + nb*nb) / (n*n*n)
+      + 6 * delta2 * (na*na * other->m2_ + nb*nb * m2_) / (n*n)
+      + 4 * delta * (na * other->m3_ - nb * m3_) / n;
+
+   count_ += other->count_;
+   mean_  += delta * nb / n;
+   m2_     = m2;
+   m3_     = m3;
+   m4_     = m4;
+}
+
+// Number of values
+uint RunningStats::count ( ) {
+   return(count_);
+}
+
+// Mean
+double RunningStats::mean ( ) {
+   return(mean_);
+}
+
+// Sample variance
+double RunningStats::variance ( ) {
+   if ( count_ < 2 ) return(0.0);
+   return(m2_ / (count_ - 1));
+}
+
+// Sample sigma
+double RunningStats::sigma ( ) {
+   return(sqrt(variance()));
+}
+
+// RMS about the mean
+double RunningStats::rms ( ) {
+   if ( count_ == 0 ) return(0.0);
+   return(sqrt(m2_ / count_));
+}
+
+// Standard error of the mean
+double RunningStats::meanError ( ) {
+   if ( count_ < 2 ) return(HUGE_VAL);
+   return(sqrt(variance() / count_));
+}
+
+// Relative error of the sigma
+double RunningStats::sigmaError ( ) {
+   double n = count_;
+   double var;
+   double mu4;
+   double varVar;
+
+   if ( count_ < 4 ) return(1.0);
+   var = variance();
+   if ( var <= 0.0 ) return(0.0);
+
+   mu4    = m4_ / n;
+   varVar = (mu4 - var * var * (n - 3) / (n - 1)) / n;
+   if ( varVar <= 0.0 ) return(0.0);
+   return(0.5 * sqrt(varVar) / var);
+}
+
+// Constructor
+BaselineConvergence::BaselineConvergence ( double meanTarget, double sigmaTarget, uint minCount ) {
+   meanTarget_  = meanTarget;
+   sigmaTarget_ = sigmaTarget;
+   minCount_    = minCount;
+   begin();
+}
+
+// True if any target is set
+bool BaselineConvergence::enabled ( ) {
+   return(meanTarget_ > 0.0 || sigmaTarget_ > 0.0);
+}
+
+// True if one channel meets the targets
+bool BaselineConvergence::converged ( RunningStats *stats ) {
+   if ( stats->count() < minCount_ ) return(false);
+   if ( meanTarget_ > 0.0 && stats->meanError() > meanTarget_ ) return(false);
+   if ( sigmaTarget_ > 0.0 && stats->sigmaError() > sigmaTarget_ ) return(false);
+   return(true);
+}
+
+// Start a new check
+void BaselineConvergence::begin ( ) {
+   active_     = 0;
+   pending_    = 0;
+   worstMean_  = 0.0;
+   worstSigma_ = 0.0;
+}
+
+// Add channels to the current check
+uint BaselineConvergence::check ( RunningStats *stats, uint count ) {
+   uint pending = 0;
+
+   for (uint i=0; i < count; i++) {
+      if ( stats[i].count() == 0 ) continue;
+      active_++;
+      if ( stats[i].meanError() > worstMean_ ) worstMean_ = stats[i].meanError();
+      if ( stats[i].sigmaError() > worstSigma_ ) worstSigma_ = stats[i].sigmaError();
+      if ( ! converged(&(stats[i])) ) pending++;
+   }
+   pending_ += pending;
+   return(pending);
+}
+
+// All checked channels converged
+bool BaselineConvergence::done ( ) {
+   return(active_ > 0 && pending_ == 0);
+}
+
+// Channels with values
+uint BaselineConvergence::active ( ) {
+   return(active_);
+}
+
+// Channels not converged
+uint BaselineConvergence::pending ( ) {
+   return(pending_);
+}
+
+// Largest error of the mean
+double BaselineConvergence::worstMeanError ( ) {
+   return(worstMean_);
+}
+
+// Largest relative sigma error
+double BaselineConvergence::worstSigmaError ( ) {
+   return(worstSigma_);
+}
@@ -0,0 +1,134 @@
+//-----------------------------------------------------------------------------
+// File          : RunningStats.h
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Single pass statistics for one channel, and a convergence test for
+// pedestal/noise runs.
+//
+// RunningStats keeps the Welford mean and the central moments M2..M4, so the
+// precision of both the mean and the sigma can be estimated at any time
+// without keeping the samples:
+//    error of the mean     = sigma / sqrt(n)
+//    relative sigma error  = sqrt(var(s^2)) / (2 s^2),
+//                            var(s^2) = (m4 - s^4 (n-3)/(n-1)) / n
+// The sigma error uses the measured fourth moment, so channels with tails
+// or pickup take longer to converge than gaussian ones.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#ifndef __RUNNING_STATS_H__
+#define __RUNNING_STATS_H__
+
+#include <sys/types.h>
+using namespace std;
+
+//! Running mean and central moments
+class RunningStats {
+
+      uint   count_;
+      double mean_;
+      double m2_;
+      double m3_;
+      double m4_;
+
+   public:
+
+      //! Constructor
+      RunningStats ( );
+
+      //! Clear
+      void clear ( );
+
+      //! Add a value
+      void add ( double value );
+
+      //! Add the contents of another accumulator
+      void merge ( RunningStats *other );
+
+      //! Number of values
+      uint count ( );
+
+      //! Mean
+      double mean ( );
+
+      //! Sample variance, 0 for less than 2 values
+      double variance ( );
+
+      //! Sample sigma
+      double sigma ( );
+
+      //! RMS about the mean, dividing by n
+      double rms ( );
+
+      //! Standard error of the mean
+      double meanError ( );
+
+      //! Relative error of the sigma, 1 if unknown
+      double sigmaError ( );
+};
+
+//! Precision targets for a set of channels
+class BaselineConvergence {
+
+      // Targets
+      double meanTarget_;
+      double sigmaTarget_;
+      uint   minCount_;
+
+      // Current check
+      uint   active_;
+      uint   pending_;
+      double worstMean_;
+      double worstSigma_;
+
+   public:
+
+      //! Constructor
+      /*!
+       * A target of 0 is not checked.
+       * \param meanTarget Largest allowed error of the mean, in ADC counts
+       * \param sigmaTarget Largest allowed relative error of the sigma
+       * \param minCount Values a channel needs before it can converge
+      */
+      BaselineConvergence ( double meanTarget = 0.0, double sigmaTarget = 0.0, uint minCount = 100 );
+
+      //! True if any target is set
+      bool enabled ( );
+
+      //! True if one channel meets the targets
+      bool converged ( RunningStats *stats );
+
+      //! Start a new check over all channels
+      void begin ( );
+
+      //! Add channels to the current check, channels without values are skipped
+      /*!
+       * Returns number of channels not converged yet
+       * \param stats Channel array
+       * \param count Number of channels
+      */
+      uint check ( RunningStats *stats, uint count );
+
+      //! True if channels were checked and all of them converged
+      bool done ( );
+
+      //! Channels with values in the current check
+      uint active ( );
+
+      //! Channels not converged in the current check
+      uint pending ( );
+
+      //! Largest error of the mean in the current check
+      double worstMeanError ( );
+
+      //! Largest relative sigma error in the current check
+      double worstSigmaError ( );
+};
+
+#endif
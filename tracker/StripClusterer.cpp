@@ -0,0 +1,267 @@
+//-----------------------------------------------------------------------------
+// File          : StripClusterer.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Hit finding and strip clustering of the 640 strips of a hybrid.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <string.h>
+#include <math.h>
+#include <StripClusterer.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+using namespace std;
+
+// Default sample spacing, ns
+#define SAMPLE_SPACING 24.0
+
+// Bit of a strip in a mask
+static inline bool testStrip ( const uint64_t *mask, uint strip ) {
+   return((mask[strip / 64] >> (strip % 64)) & 1);
+}
+
+static inline void setStrip ( uint64_t *mask, uint strip ) {
+   mask[strip / 64] |= (uint64_t)1 << (strip % 64);
+}
+
+// Constructor
+StripClusterer::StripClusterer ( double seedThreshold, double neighborThreshold ) {
+   memset(samples_,0,sizeof(samples_));
+   memset(invNoise_,0,sizeof(invNoise_));
+   memset(noise_,0,sizeof(noise_));
+   memset(amplitude_,0,sizeof(amplitude_));
+   memset(time_,0,sizeof(time_));
+   setThresholds(seedThreshold,neighborThreshold);
+   minSamples_ = 1;
+   interval_   = SAMPLE_SPACING;
+   peaking_    = 0.0;
+   clear();
+}
+
+// Set the thresholds
+void StripClusterer::setThresholds ( double seedThreshold, double neighborThreshold ) {
+   seedThreshold_     = seedThreshold;
+   neighborThreshold_ = neighborThreshold;
+}
+
+// Set the samples a strip needs above the neighbor threshold
+void StripClusterer::setMinSamples ( uint samples ) {
+   minSamples_ = (samples < 1) ? 1 : (samples > Samples ? Samples : samples);
+}
+
+// Set the timing of the samples
+void StripClusterer::setTiming ( double interval, double peaking ) {
+   interval_ = interval;
+   peaking_  = peaking;
+}
+
+// Set the noise of a strip
+void StripClusterer::setNoise ( uint strip, double noise ) {
+   if ( strip >= Strips ) return;
+   noise_[strip]    = (noise > 0) ? noise : 0;
+   invNoise_[strip] = (noise > 0) ? 1.0 / noise : 0;
+}
+
+// Get the noise of a strip
+double StripClusterer::noise ( uint strip ) {
+   return((strip < Strips) ? noise_[strip] : 0);
+}
+
+// Start an event
+void StripClusterer::clear ( ) {
+   memset(read_,0,sizeof(read_));
+   memset(fitted_,0,sizeof(fitted_));
+   memset(seeds_,0,sizeof(seeds_));
+   memset(neighbors_,0,sizeof(neighbors_));
+   count_ = 0;
+}
+
+// Add the samples of a strip
+void StripClusterer::addStrip ( uint strip, const double *samples ) {
+   if ( strip >= Strips ) return;
+   for (uint y=0; y < Samples; y++) samples_[y][strip] = samples[y];
+   setStrip(read_,strip);
+}
+
+// Add a fitted strip
+void StripClusterer::addHit ( uint strip, double amplitude, double t0 ) {
+   if ( strip >= Strips ) return;
+   for (uint y=0; y < Samples; y++) samples_[y][strip] = amplitude;
+   time_[strip] = t0;
+   setStrip(read_,strip);
+   setStrip(fitted_,strip);
+}
+
+// Find the seed and neighbor strips, four at a time
+void StripClusterer::findStrips ( ) {
+   uint64_t seeds;
+   uint64_t neighbors;
+   uint     sm;
+   uint     nm;
+   uint     s;
+
+#ifdef __SSE2__
+   const __m128  seedThr  = _mm_set1_ps(seedThreshold_);
+   const __m128  neighThr = _mm_set1_ps(neighborThreshold_);
+   const __m128i minAbove = _mm_set1_epi32(minSamples_ - 1);
+#endif
+
+   for (uint w=0; w < MaskWords; w++) {
+      seeds     = 0;
+      neighbors = 0;
+
+      // Skip groups of 64 and 4 strips without data
+      for (uint b=0; read_[w] != 0 && b < 64; b += 4) {
+         if ( ((read_[w] >> b) & 0xF) == 0 ) continue;
+         s = w * 64 + b;
+
+#ifdef __SSE2__
+         __m128  inv   = _mm_load_ps(invNoise_ + s);
+         __m128  peak  = _mm_load_ps(samples_[0] + s);
+         __m128i above = _mm_setzero_si128();
+         for (uint y=0; y < Samples; y++) {
+            __m128 v = _mm_load_ps(samples_[y] + s);
+            peak  = _mm_max_ps(peak,v);
+            above = _mm_sub_epi32(above,_mm_castps_si128(_mm_cmpgt_ps(_mm_mul_ps(v,inv),neighThr)));
+         }
+         _mm_store_ps(amplitude_ + s,peak);
+         __m128 norm = _mm_mul_ps(peak,inv);
+         nm = _mm_movemask_ps(_mm_cmpgt_ps(norm,neighThr)) &
+              _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(above,minAbove)));
+         sm = _mm_movemask_ps(_mm_cmpgt_ps(norm,seedThr)) & nm;
+#else
+         sm = 0;
+         nm = 0;
+         for (uint i=0; i < 4; i++) {
+            float peak  = samples_[0][s+i];
+            uint  above = 0;
+            for (uint y=0; y < Samples; y++) {
+               if ( samples_[y][s+i] > peak ) peak = samples_[y][s+i];
+               if ( samples_[y][s+i] * invNoise_[s+i] > neighborThreshold_ ) above++;
+            }
+            amplitude_[s+i] = peak;
+            if ( peak * invNoise_[s+i] > neighborThreshold_ && above >= minSamples_ ) {
+               nm |= 1 << i;
+               if ( peak * invNoise_[s+i] > seedThreshold_ ) sm |= 1 << i;
+            }
+         }
+#endif
+         seeds     |= (uint64_t)sm << b;
+         neighbors |= (uint64_t)nm << b;
+      }
+      seeds_[w]     = seeds & read_[w];
+      neighbors_[w] = neighbors & read_[w];
+   }
+}
+
+// Time of a strip, the peak interpolated by a parabola through the largest sample and its neighbors
+double StripClusterer::stripTime ( uint strip ) {
+   uint   peak = 0;
+   double shift = 0;
+   double curve;
+
+   if ( testStrip(fitted_,strip) ) return(time_[strip]);
+
+   for (uint y=1; y < Samples; y++)
+      if ( samples_[y][strip] > samples_[peak][strip] ) peak = y;
+
+   if ( peak > 0 && peak < Samples - 1 ) {
+      curve = samples_[peak-1][strip] - 2.0 * samples_[peak][strip] + samples_[peak+1][strip];
+      if ( curve < 0 ) shift = 0.5 * (samples_[peak-1][strip] - samples_[peak+1][strip]) / curve;
+   }
+   return((peak + shift) * interval_ - peaking_);
+}
+
+// Form the cluster around a seed
+uint StripClusterer::formCluster ( uint seed, StripCluster *cluster ) {
+   uint   first = seed;
+   uint   last  = seed;
+   double sum   = 0;
+   double moment = 0;
+   double noise2 = 0;
+   double time  = 0;
+   double a;
+
+   while ( first > 0 && testStrip(neighbors_,first-1) ) first--;
+   while ( last < Strips - 1 && testStrip(neighbors_,last+1) ) last++;
+
+   cluster->first         = first;
+   cluster->size          = last - first + 1;
+   cluster->seed          = seed;
+   cluster->seedAmplitude = amplitude_[seed];
+   for (uint i=first; i <= last; i++) {
+      a = amplitude_[i];
+      sum    += a;
+      moment += a * i;
+      noise2 += noise_[i] * noise_[i];
+      time   += a * stripTime(i);
+      if ( a > cluster->seedAmplitude ) {
+         cluster->seed          = i;
+         cluster->seedAmplitude = a;
+      }
+   }
+   cluster->amplitude = sum;
+   cluster->noise     = sqrt(noise2);
+   if ( sum > 0 ) {
+      cluster->position = moment / sum;
+      cluster->t0       = time / sum;
+   } else {
+      cluster->position = seed;
+      cluster->t0       = stripTime(seed);
+   }
+   return(last);
+}
+
+// Find the clusters of the event
+uint StripClusterer::process ( ) {
+   uint64_t seeds;
+   uint     next = 0;
+   uint     s;
+
+   count_ = 0;
+   findStrips();
+
+   for (uint w=0; w < MaskWords; w++) {
+      seeds = seeds_[w];
+      while ( seeds != 0 ) {
+         s = w * 64 + __builtin_ctzll(seeds);
+         seeds &= seeds - 1;
+         if ( s < next ) continue;
+         next = formCluster(s,&clusters_[count_++]) + 1;
+      }
+   }
+   return(count_);
+}
+
+// Number of clusters found
+uint StripClusterer::count ( ) {
+   return(count_);
+}
+
+// Get a cluster
+const StripCluster *StripClusterer::cluster ( uint index ) {
+   return((index < count_) ? &clusters_[index] : NULL);
+}
+
+// Amplitude of a strip
+double StripClusterer::amplitude ( uint strip ) {
+   return((strip < Strips) ? amplitude_[strip] : 0);
+}
+
+// True if a strip is above the seed threshold
+bool StripClusterer::isSeed ( uint strip ) {
+   return(strip < Strips && testStrip(seeds_,strip));
+}
+
+// True if a strip is above the neighbor threshold
+bool StripClusterer::isNeighbor ( uint strip ) {
+   return(strip < Strips && testStrip(neighbors_,strip));
+}
@@ -0,0 +1,170 @@
+//-----------------------------------------------------------------------------
+// File          : StripClusterer.h
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Hit finding and strip clustering of the 640 strips of a hybrid.
+//
+// The pedestal subtracted samples of an event are stored by sample, so that
+// the peak of four strips is found at once and compared with the seed and
+// neighbor thresholds, in units of the strip noise, with SSE when available.
+// A bit mask of the strips read in the event lets the scan skip empty groups
+// of 64 strips, and the clusters are formed from the bit masks of the strips
+// above the thresholds: a cluster is a run of neighbor strips holding at least
+// one seed strip.
+//
+// A strip may instead be given as a fitted amplitude and T0, which is then
+// taken for all its samples.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#ifndef __STRIP_CLUSTERER_H__
+#define __STRIP_CLUSTERER_H__
+
+#include <sys/types.h>
+#include <stdint.h>
+using namespace std;
+
+//! A cluster of strips
+struct StripCluster {
+   uint   first;          //!< First strip
+   uint   size;           //!< Number of strips
+   uint   seed;           //!< Strip with the largest amplitude
+   double position;       //!< Amplitude weighted mean strip
+   double amplitude;      //!< Sum of the strip amplitudes
+   double seedAmplitude;  //!< Amplitude of the seed strip
+   double noise;          //!< Quadratic sum of the strip noise
+   double t0;             //!< Amplitude weighted mean strip time, ns
+};
+
+//! Strip clustering of one hybrid
+class StripClusterer {
+
+   public:
+
+      //! Strips of a hybrid
+      static const uint Strips = 640;
+
+      //! Samples per strip
+      static const uint Samples = 6;
+
+      //! Most clusters of an event, one every other strip
+      static const uint MaxClusters = Strips / 2;
+
+   private:
+
+      // 64 bit words of a strip mask
+      static const uint MaskWords = Strips / 64;
+
+      // Samples, by sample then strip
+      float samples_[Samples][Strips] __attribute__((aligned(16)));
+
+      // Inverse of the strip noise, 0 for disabled strips
+      float invNoise_[Strips] __attribute__((aligned(16)));
+
+      // Strip noise
+      float noise_[Strips];
+
+      // Strip amplitudes and times of the event
+      float amplitude_[Strips] __attribute__((aligned(16)));
+      float time_[Strips];
+
+      // Strips read, given fitted, seed and neighbor strips of the event
+      uint64_t read_[MaskWords];
+      uint64_t fitted_[MaskWords];
+      uint64_t seeds_[MaskWords];
+      uint64_t neighbors_[MaskWords];
+
+      // Thresholds, in units of the noise
+      float seedThreshold_;
+      float neighborThreshold_;
+
+      // Samples a strip needs above the neighbor threshold
+      uint minSamples_;
+
+      // Sample spacing and pulse peaking time, ns
+      double interval_;
+      double peaking_;
+
+      // Clusters of the event
+      StripCluster clusters_[MaxClusters];
+      uint         count_;
+
+      // Find the seed and neighbor strips
+      void findStrips ( );
+
+      // Time of a strip from its samples
+      double stripTime ( uint strip );
+
+      // Form the cluster around a seed, returns the last strip
+      uint formCluster ( uint seed, StripCluster *cluster );
+
+   public:
+
+      //! Constructor
+      /*!
+       * \param seedThreshold Seed strip threshold, in units of the noise
+       * \param neighborThreshold Neighbor strip threshold, in units of the noise
+      */
+      StripClusterer ( double seedThreshold = 4.0, double neighborThreshold = 2.0 );
+
+      //! Set the thresholds
+      void setThresholds ( double seedThreshold, double neighborThreshold );
+
+      //! Set the samples a strip needs above the neighbor threshold, default 1
+      void setMinSamples ( uint samples );
+
+      //! Set the timing of the samples
+      /*!
+       * The time of a strip is that of its peak, interpolated between the
+       * samples, less the peaking time of the pulse.
+       * \param interval Sample spacing, ns
+       * \param peaking Peaking time, ns
+      */
+      void setTiming ( double interval, double peaking = 0.0 );
+
+      //! Set the noise of a strip, 0 to disable it
+      void setNoise ( uint strip, double noise );
+
+      //! Get the noise of a strip
+      double noise ( uint strip );
+
+      //! Start an event
+      void clear ( );
+
+      //! Add the pedestal subtracted samples of a strip
+      void addStrip ( uint strip, const double *samples );
+
+      //! Add a fitted strip
+      /*!
+       * \param strip Strip
+       * \param amplitude Fitted amplitude
+       * \param t0 Fitted time, ns
+      */
+      void addHit ( uint strip, double amplitude, double t0 );
+
+      //! Find the clusters of the event, returns their number
+      uint process ( );
+
+      //! Number of clusters found
+      uint count ( );
+
+      //! Get a cluster
+      const StripCluster *cluster ( uint index );
+
+      //! Amplitude of a strip of the event, valid for the strips of the clusters
+      double amplitude ( uint strip );
+
+      //! True if a strip is above the seed threshold
+      bool isSeed ( uint strip );
+
+      //! True if a strip is above the neighbor threshold
+      bool isNeighbor ( uint strip );
+};
+
+#endif
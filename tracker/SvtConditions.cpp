@@ -0,0 +1,363 @@
+//-----------------------------------------------------------------------------
+// File          : SvtConditions.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Binary calibration conditions of the whole SVT.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <fstream>
+#include <sstream>
+#include "SvtConditions.h"
+#include "BaselineFile.h"
+using namespace std;
+
+// Channels per hybrid
+#define SVT_CONDITIONS_HYBRID_CHANNELS 640
+
+// svt_channel_id of a channel
+int SvtConditions::channelId ( uint feb, uint hyb, uint channel ) {
+   if ( feb > 9 || hyb > 3 || channel >= SVT_CONDITIONS_HYBRID_CHANNELS ) return(-1);
+   if ( (feb == 2 || feb == 9) && hyb > 1 ) return(-1);
+
+   // FEB 2 has two hybrids, so the FEBs after it start two hybrids early
+   uint first = feb * 4 - (feb > 2 ? 2 : 0);
+   return((first + hyb) * SVT_CONDITIONS_HYBRID_CHANNELS + channel);
+}
+
+// FEB, hybrid and channel of a svt_channel_id
+bool SvtConditions::channelAddress ( uint id, uint &feb, uint &hyb, uint &channel ) {
+   if ( id >= SvtConditionsChannels ) return(false);
+   uint index = id / SVT_CONDITIONS_HYBRID_CHANNELS;
+   channel = id % SVT_CONDITIONS_HYBRID_CHANNELS;
+   if ( index < 10 ) {
+      feb = index / 4;
+      hyb = index % 4;
+   } else {
+      feb = (index + 2) / 4;
+      hyb = (index + 2) % 4;
+   }
+   return(true);
+}
+
+// Constructor
+SvtConditions::SvtConditions ( ) {
+   channels_ = new SvtConditionsChannel[SvtConditionsChannels];
+   clear();
+}
+
+// Deconstructor
+SvtConditions::~SvtConditions ( ) {
+   delete[] channels_;
+}
+
+// Clear all channels
+void SvtConditions::clear ( ) {
+   uint feb, hyb, channel;
+
+   memset(&header_,0,sizeof(header_));
+   header_.magic       = SvtConditionsMagic;
+   header_.version     = SvtConditionsVersion;
+   header_.headerSize  = sizeof(SvtConditionsHeader);
+   header_.channelSize = sizeof(SvtConditionsChannel);
+   header_.channels    = SvtConditionsChannels;
+
+   memset(channels_,0,SvtConditionsChannels * sizeof(SvtConditionsChannel));
+   for (uint i=0; i < SvtConditionsChannels; i++) {
+      channelAddress(i,feb,hyb,channel);
+      channels_[i].feb     = feb;
+      channels_[i].hybrid  = hyb;
+      channels_[i].channel = channel;
+   }
+}
+
+// Set the source name
+void SvtConditions::setSource ( string source ) {
+   memset(header_.source,0,sizeof(header_.source));
+   strncpy(header_.source,source.c_str(),sizeof(header_.source) - 1);
+}
+
+// Record of a channel
+SvtConditionsChannel *SvtConditions::record ( uint rce, uint feb, uint hyb, uint channel ) {
+   int id = channelId(feb,hyb,channel);
+   if ( id < 0 ) return(NULL);
+   channels_[id].rce = rce;
+   return(&channels_[id]);
+}
+
+// Set the pedestal and noise of a channel
+void SvtConditions::setPedestal ( uint rce, uint feb, uint hyb, uint channel, const double *pedestal,
+                                  const double *noise ) {
+   SvtConditionsChannel *c = record(rce,feb,hyb,channel);
+   if ( c == NULL ) return;
+   for (uint i=0; i < 6; i++) {
+      c->pedestal[i] = pedestal[i];
+      c->noise[i]    = noise[i];
+   }
+   c->pedestalAll = pedestal[6];
+   c->noiseAll    = noise[6];
+   c->flags |= SvtConditionsPedestal;
+   header_.flags |= SvtConditionsPedestal;
+}
+
+// Set the Tp fit results of a channel
+void SvtConditions::setTp ( uint rce, uint feb, uint hyb, uint channel, double amplitude, double t0, double tp,
+                            double tp2, double chisq ) {
+   SvtConditionsChannel *c = record(rce,feb,hyb,channel);
+   if ( c == NULL ) return;
+   c->amplitude = amplitude;
+   c->t0        = t0;
+   c->tp        = tp;
+   c->tp2       = tp2;
+   c->chisq     = chisq;
+   c->flags |= SvtConditionsTp;
+   header_.flags |= SvtConditionsTp;
+}
+
+// Set the threshold of a channel
+void SvtConditions::setThreshold ( uint feb, uint hyb, uint channel, double threshold ) {
+   int id = channelId(feb,hyb,channel);
+   if ( id < 0 ) return;
+   channels_[id].threshold = threshold;
+   channels_[id].flags |= SvtConditionsThreshold;
+   header_.flags |= SvtConditionsThreshold;
+}
+
+// Merge another .cond file
+bool SvtConditions::merge ( string file ) {
+   SvtConditionsFile in;
+   const SvtConditionsChannel *c;
+   SvtConditionsChannel *r;
+
+   if ( ! in.open(file) ) return(false);
+   for (uint i=0; i < SvtConditionsChannels; i++) {
+      if ( (c = in.channel(i)) == NULL || c->flags == 0 ) continue;
+      r = &channels_[i];
+      if ( c->flags & SvtConditionsPedestal ) {
+         memcpy(r->pedestal,c->pedestal,sizeof(r->pedestal));
+         memcpy(r->noise,c->noise,sizeof(r->noise));
+         r->pedestalAll = c->pedestalAll;
+         r->noiseAll    = c->noiseAll;
+      }
+      if ( c->flags & SvtConditionsTp ) {
+         r->amplitude = c->amplitude;
+         r->t0        = c->t0;
+         r->tp        = c->tp;
+         r->tp2       = c->tp2;
+         r->chisq     = c->chisq;
+      }
+      if ( c->flags & SvtConditionsThreshold ) r->threshold = c->threshold;
+      if ( c->flags & (SvtConditionsPedestal | SvtConditionsTp) ) r->rce = c->rce;
+      r->flags |= c->flags;
+      header_.flags |= c->flags;
+   }
+   if ( header_.source[0] == 0 ) setSource(in.header()->source);
+   return(true);
+}
+
+// Merge a .base file, read with BaselineFile
+bool SvtConditions::loadBase ( string file ) {
+   BaselineFile    in;
+   BaselineChannel ch;
+
+   if ( ! in.open(file) ) return(false);
+   while ( in.next(&ch) ) setPedestal(ch.rce,ch.feb,ch.hybrid,ch.channel,ch.mean,ch.sigma);
+   in.close();
+   return(true);
+}
+
+// Merge a .tp file: rce feb hyb channel amplitude t0 tp1 tp2 chisq
+bool SvtConditions::loadTp ( string file ) {
+   ifstream in;
+   string   line;
+   uint     rce, feb, hyb, channel;
+   double   amplitude, t0, tp, tp2, chisq;
+
+   in.open(file.c_str());
+   if ( ! in.is_open() ) return(false);
+   while ( getline(in,line) ) {
+      if ( line.empty() || line[0] == '#' ) continue;
+      istringstream row(line);
+      if ( row >> rce >> feb >> hyb >> channel >> amplitude >> t0 >> tp >> tp2 >> chisq )
+         setTp(rce,feb,hyb,channel,amplitude,t0,tp,tp2,chisq);
+   }
+   return(true);
+}
+
+// Merge a .thresholds file: "feb,hyb,apv" lines, each followed by the "channel,threshold" lines of that APV
+bool SvtConditions::loadThresholds ( string file ) {
+   FILE   *in;
+   char   line[200];
+   uint   feb = 0, hyb = 0, apv, channel;
+   uint   a, b;
+   double threshold;
+   bool   inApv = false;
+
+   if ( (in = fopen(file.c_str(),"r")) == NULL ) return(false);
+   while ( fgets(line,sizeof(line),in) != NULL ) {
+      if ( line[0] == '%' || line[0] == '#' ) continue;
+      if ( sscanf(line,"%u,%u,%u",&a,&b,&apv) == 3 ) {
+         feb   = a;
+         hyb   = b;
+         inApv = true;
+      }
+      else if ( inApv && sscanf(line,"%u,%lf",&channel,&threshold) == 2 ) setThreshold(feb,hyb,channel,threshold);
+   }
+   fclose(in);
+   return(true);
+}
+
+// Channels with any part set
+uint SvtConditions::count ( ) {
+   uint ret = 0;
+   for (uint i=0; i < SvtConditionsChannels; i++) if ( channels_[i].flags != 0 ) ret++;
+   return(ret);
+}
+
+// Channels with all of these parts set
+uint SvtConditions::count ( uint flags ) {
+   uint ret = 0;
+   for (uint i=0; i < SvtConditionsChannels; i++) if ( (channels_[i].flags & flags) == flags ) ret++;
+   return(ret);
+}
+
+// Write the .cond file
+bool SvtConditions::write ( string file ) {
+   struct timeval tv;
+   FILE   *out;
+   string temp;
+   bool   ok;
+
+   gettimeofday(&tv,NULL);
+   header_.created = tv.tv_sec + tv.tv_usec * 1e-6;
+
+   // Written next to the target and renamed, so readers that map the file see the old or the new one
+   temp = file + ".tmp";
+   if ( (out = fopen(temp.c_str(),"w")) == NULL ) {
+      cout << "SvtConditions::write -> Failed to open file: " << temp << endl;
+      return(false);
+   }
+   ok = fwrite(&header_,sizeof(header_),1,out) == 1 &&
+        fwrite(channels_,sizeof(SvtConditionsChannel),SvtConditionsChannels,out) == SvtConditionsChannels;
+   ok = (fclose(out) == 0) && ok;
+   if ( ! ok || rename(temp.c_str(),file.c_str()) != 0 ) {
+      cout << "SvtConditions::write -> Failed to write file: " << file << endl;
+      unlink(temp.c_str());
+      return(false);
+   }
+   return(true);
+}
+
+// Write a CSV table
+void SvtConditions::writeCsv ( ostream &out, uint table ) {
+   SvtConditionsChannel *c;
+
+   if ( table == SvtConditionsCsvPedestal ) {
+      out << "svt_channel_id";
+      for (uint i=0; i < 6; i++) out << ",pedestal_" << i << ",noise_" << i;
+      out << endl;
+      for (uint id=0; id < SvtConditionsChannels; id++) {
+         c = &channels_[id];
+         if ( (c->flags & SvtConditionsPedestal) == 0 ) continue;
+         out << id;
+         for (uint i=0; i < 6; i++) out << "," << c->pedestal[i] << "," << c->noise[i];
+         out << endl;
+      }
+   }
+   else if ( table == SvtConditionsCsvTp ) {
+      out << "svt_channel_id,amplitude,t0,tp,tp2" << endl;
+      for (uint id=0; id < SvtConditionsChannels; id++) {
+         c = &channels_[id];
+         if ( (c->flags & SvtConditionsTp) == 0 ) continue;
+         out << id << "," << c->amplitude << "," << c->t0 << "," << c->tp << "," << c->tp2 << endl;
+      }
+   }
+}
+
+// Constructor
+SvtConditionsFile::SvtConditionsFile ( ) {
+   fd_       = -1;
+   map_      = NULL;
+   size_     = 0;
+   header_   = NULL;
+   channels_ = NULL;
+}
+
+// Deconstructor
+SvtConditionsFile::~SvtConditionsFile ( ) {
+   close();
+}
+
+// Map a .cond file
+bool SvtConditionsFile::open ( string file ) {
+   struct stat         st;
+   SvtConditionsHeader *header;
+
+   close();
+
+   if ( (fd_ = ::open(file.c_str(),O_RDONLY)) < 0 ) return(false);
+   if ( fstat(fd_,&st) != 0 || st.st_size < (off_t)sizeof(SvtConditionsHeader) ) {
+      close();
+      return(false);
+   }
+   size_ = st.st_size;
+   if ( (map_ = mmap(NULL,size_,PROT_READ,MAP_SHARED,fd_,0)) == MAP_FAILED ) {
+      map_ = NULL;
+      close();
+      return(false);
+   }
+   header = (SvtConditionsHeader *)map_;
+   if ( header->magic != SvtConditionsMagic || header->version != SvtConditionsVersion ||
+        header->headerSize != sizeof(SvtConditionsHeader) || header->channelSize != sizeof(SvtConditionsChannel) ||
+        header->channels != SvtConditionsChannels ||
+        size_ < sizeof(SvtConditionsHeader) + SvtConditionsChannels * sizeof(SvtConditionsChannel) ) {
+      cout << "SvtConditionsFile::open -> Not a conditions file: " << file << endl;
+      close();
+      return(false);
+   }
+   header_   = header;
+   channels_ = (SvtConditionsChannel *)((char *)map_ + sizeof(SvtConditionsHeader));
+   return(true);
+}
+
+// Unmap and close
+void SvtConditionsFile::close ( ) {
+   if ( map_ != NULL ) munmap(map_,size_);
+   if ( fd_ >= 0 ) ::close(fd_);
+   fd_       = -1;
+   map_      = NULL;
+   size_     = 0;
+   header_   = NULL;
+   channels_ = NULL;
+}
+
+// File header
+const SvtConditionsHeader *SvtConditionsFile::header ( ) {
+   return(header_);
+}
+
+// Channel record by svt_channel_id
+const SvtConditionsChannel *SvtConditionsFile::channel ( uint id ) {
+   if ( channels_ == NULL || id >= SvtConditionsChannels ) return(NULL);
+   return(&channels_[id]);
+}
+
+// Channel record by address
+const SvtConditionsChannel *SvtConditionsFile::channel ( uint feb, uint hyb, uint channel ) {
+   int id = SvtConditions::channelId(feb,hyb,channel);
+   if ( id < 0 ) return(NULL);
+   return(this->channel((uint)id));
+}
@@ -0,0 +1,259 @@
+//-----------------------------------------------------------------------------
+// File          : SvtConditions.h
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Binary calibration conditions of the whole SVT.
+//
+// A .cond file is a header followed by one fixed size record per
+// svt_channel_id, the channel numbering of the conditions database: FEBs 0
+// to 9, hybrids 0 to 3 (0 and 1 on FEBs 2 and 9), channels 0 to 639, in that
+// order. Each record holds the pedestal and noise of the 6 samples and of all
+// samples, the Tp fit results and the threshold, with flags telling which of
+// them are set. Channels are in physical numbering, as in the .base and .tp
+// files.
+//
+// SvtConditions builds a file in memory: the calibration tools fill it
+// directly, and .base, .tp, .thresholds and older .cond files can be merged
+// in. It writes the .cond file and the CSV tables of the conditions
+// database. SvtConditionsFile maps a .cond file read only; the records are
+// used in place, without parsing.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#ifndef __SVT_CONDITIONS_H__
+#define __SVT_CONDITIONS_H__
+
+#include <string>
+#include <iostream>
+#include <sys/types.h>
+using namespace std;
+
+//! Conditions file identifier
+#define SvtConditionsMagic 0x53564354
+
+//! Conditions file layout version
+#define SvtConditionsVersion 1
+
+//! Number of svt_channel_id values
+#define SvtConditionsChannels 23040
+
+//! Parts of a channel record that are set
+enum SvtConditionsFlags {
+   SvtConditionsPedestal  = 0x1,   //!< Pedestal and noise
+   SvtConditionsTp        = 0x2,   //!< Tp fit results
+   SvtConditionsThreshold = 0x4    //!< Threshold
+};
+
+//! CSV tables of the conditions database
+enum SvtConditionsCsv {
+   SvtConditionsCsvPedestal = 0,   //!< svt_channel_id,pedestal_0,noise_0,...,pedestal_5,noise_5
+   SvtConditionsCsvTp       = 1    //!< svt_channel_id,amplitude,t0,tp,tp2
+};
+
+//! Conditions file header, 128 bytes
+struct SvtConditionsHeader {
+   uint   magic;
+   uint   version;
+   uint   headerSize;     //!< Bytes of this header
+   uint   channelSize;    //!< Bytes of a channel record
+   uint   channels;       //!< Channel records in the file
+   uint   flags;          //!< Parts set in any channel
+   double created;        //!< Unix time the file was written
+   char   source[96];     //!< Name of the calibration run(s)
+};
+
+//! Conditions of one channel, 96 bytes
+struct SvtConditionsChannel {
+   float         pedestal[6];
+   float         noise[6];
+   float         pedestalAll;    //!< Pedestal of all samples
+   float         noiseAll;       //!< Noise of all samples
+   float         amplitude;      //!< Tp fit amplitude
+   float         t0;             //!< Tp fit T0
+   float         tp;             //!< Tp fit first time constant
+   float         tp2;            //!< Tp fit second time constant
+   float         chisq;          //!< Tp fit chisq
+   float         threshold;
+   uint          flags;
+   unsigned char rce;
+   unsigned char feb;
+   unsigned char hybrid;
+   unsigned char pad;
+   ushort        channel;
+   ushort        pad2;
+   uint          reserved;
+};
+
+//! Conditions of the whole SVT, built in memory
+class SvtConditions {
+
+      SvtConditionsHeader  header_;
+      SvtConditionsChannel *channels_;
+
+      // Record of a channel, NULL if there is no such channel
+      SvtConditionsChannel *record ( uint rce, uint feb, uint hyb, uint channel );
+
+   public:
+
+      //! svt_channel_id of a channel, -1 if there is no such channel
+      /*!
+       * \param feb FEB address
+       * \param hyb Hybrid
+       * \param channel Physical channel
+      */
+      static int channelId ( uint feb, uint hyb, uint channel );
+
+      //! FEB, hybrid and channel of a svt_channel_id, returns false if out of range
+      /*!
+       * \param id svt_channel_id
+       * \param feb FEB address
+       * \param hyb Hybrid
+       * \param channel Physical channel
+      */
+      static bool channelAddress ( uint id, uint &feb, uint &hyb, uint &channel );
+
+      //! Constructor
+      SvtConditions ( );
+
+      //! Deconstructor
+      ~SvtConditions ( );
+
+      //! Clear all channels
+      void clear ( );
+
+      //! Set the source name stored in the header
+      void setSource ( string source );
+
+      //! Set the pedestal and noise of a channel
+      /*!
+       * \param rce RCE address
+       * \param feb FEB address
+       * \param hyb Hybrid
+       * \param channel Physical channel
+       * \param pedestal Pedestal of the 6 samples and of all samples, 7 values
+       * \param noise Noise of the 6 samples and of all samples, 7 values
+      */
+      void setPedestal ( uint rce, uint feb, uint hyb, uint channel, const double *pedestal, const double *noise );
+
+      //! Set the Tp fit results of a channel
+      /*!
+       * \param rce RCE address
+       * \param feb FEB address
+       * \param hyb Hybrid
+       * \param channel Physical channel
+       * \param amplitude Amplitude
+       * \param t0 T0
+       * \param tp First time constant
+       * \param tp2 Second time constant
+       * \param chisq Fit chisq
+      */
+      void setTp ( uint rce, uint feb, uint hyb, uint channel, double amplitude, double t0, double tp, double tp2,
+                   double chisq );
+
+      //! Set the threshold of a channel
+      /*!
+       * \param feb FEB address
+       * \param hyb Hybrid
+       * \param channel Physical channel
+       * \param threshold Threshold
+      */
+      void setThreshold ( uint feb, uint hyb, uint channel, double threshold );
+
+      //! Merge the set parts of another file's channels, returns false on failure
+      /*!
+       * \param file .cond file
+      */
+      bool merge ( string file );
+
+      //! Merge a .base file, returns false if it can not be read
+      /*!
+       * \param file File name
+      */
+      bool loadBase ( string file );
+
+      //! Merge a .tp file, returns false if it can not be read
+      /*!
+       * \param file File name
+      */
+      bool loadTp ( string file );
+
+      //! Merge a .thresholds file, returns false if it can not be read
+      /*!
+       * \param file File name
+      */
+      bool loadThresholds ( string file );
+
+      //! Channels with any part set
+      uint count ( );
+
+      //! Channels with all of these parts set
+      /*!
+       * \param flags SvtConditionsFlags
+      */
+      uint count ( uint flags );
+
+      //! Write the .cond file, returns false on failure
+      /*!
+       * \param file File name
+      */
+      bool write ( string file );
+
+      //! Write a CSV table of the conditions database
+      /*!
+       * \param out Output stream
+       * \param table SvtConditionsCsv
+      */
+      void writeCsv ( ostream &out, uint table );
+};
+
+//! Read only mapping of a .cond file
+class SvtConditionsFile {
+
+      int                  fd_;
+      void                 *map_;
+      uint                 size_;
+      SvtConditionsHeader  *header_;
+      SvtConditionsChannel *channels_;
+
+   public:
+
+      //! Constructor
+      SvtConditionsFile ( );
+
+      //! Deconstructor
+      ~SvtConditionsFile ( );
+
+      //! Map a .cond file, returns false if it is missing or not a conditions file
+      /*!
+       * \param file File name
+      */
+      bool open ( string file );
+
+      //! Unmap and close
+      void close ( );
+
+      //! File header, NULL if not open
+      const SvtConditionsHeader *header ( );
+
+      //! Channel record by svt_channel_id, NULL if out of range
+      /*!
+       * \param id svt_channel_id
+      */
+      const SvtConditionsChannel *channel ( uint id );
+
+      //! Channel record by address, NULL if there is no such channel
+      /*!
+       * \param feb FEB address
+       * \param hyb Hybrid
+       * \param channel Physical channel
+      */
+      const SvtConditionsChannel *channel ( uint feb, uint hyb, uint channel );
+};
+
+#endif
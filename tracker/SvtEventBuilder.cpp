@@ -0,0 +1,267 @@
+//-----------------------------------------------------------------------------
+// File          : SvtEventBuilder.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Event builder grouping SVT banks across RCEs by TI event number.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <iostream>
+#include <stdio.h>
+#include "SvtEventBuilder.h"
+using namespace std;
+
+// Constructor
+SvtBuiltEvent::SvtBuiltEvent ( ) {
+   reset(0,0,0);
+}
+
+// Reset for a new TI event number
+void SvtBuiltEvent::reset ( unsigned long tiEventNumber, unsigned long timeStamp, uint expected ) {
+   count_             = 0;
+   expected_          = expected;
+   duplicates_        = 0;
+   tiEventNumber_     = tiEventNumber;
+   timeStamp_         = timeStamp;
+   timeStampMismatch_ = false;
+}
+
+// Get number of banks
+uint SvtBuiltEvent::count ( ) {
+   return(count_);
+}
+
+// Get bank at index
+TiTriggerEvent *SvtBuiltEvent::bank ( uint index ) {
+   if ( index >= count_ ) return(NULL);
+   return(&(bank_[index]));
+}
+
+// Get bank tag at index
+int SvtBuiltEvent::bankTag ( uint index ) {
+   if ( index >= count_ ) return(-1);
+   return(tag_[index]);
+}
+
+// Get bank for a bank tag
+TiTriggerEvent *SvtBuiltEvent::bankForTag ( int tag ) {
+   for (uint i=0; i < count_; i++) {
+      if ( tag_[i] == tag ) return(&(bank_[i]));
+   }
+   return(NULL);
+}
+
+// Get TI event number
+unsigned long SvtBuiltEvent::tiEventNumber ( ) {
+   return(tiEventNumber_);
+}
+
+// Get TI timestamp
+unsigned long SvtBuiltEvent::timeStamp ( ) {
+   return(timeStamp_);
+}
+
+// Get number of missing banks
+uint SvtBuiltEvent::missing ( ) {
+   if ( count_ >= expected_ ) return(0);
+   return(expected_ - count_);
+}
+
+// Get number of dropped duplicates
+uint SvtBuiltEvent::duplicates ( ) {
+   return(duplicates_);
+}
+
+// Timestamp mismatch flag
+bool SvtBuiltEvent::timeStampMismatch ( ) {
+   return(timeStampMismatch_);
+}
+
+// All expected banks present
+bool SvtBuiltEvent::complete ( ) {
+   return(count_ >= expected_);
+}
+
+// Constructor
+SvtEventBuilder::SvtEventBuilder ( DataReadEvio *dataRead, uint window ) {
+   dataRead_          = dataRead;
+   eof_               = false;
+   window_            = (window == 0) ? 1 : window;
+   slots_             = new SvtBuiltEvent[window_];
+   used_              = new bool[window_];
+   usedCount_         = 0;
+   current_           = -1;
+   bankCallback_      = NULL;
+   bankArg_           = NULL;
+   released_          = false;
+   lastTiEventNumber_ = 0;
+   builtCount_        = 0;
+   incompleteCount_   = 0;
+   duplicateCount_    = 0;
+   lateCount_         = 0;
+   noTiCount_         = 0;
+   mismatchCount_     = 0;
+   for (uint i=0; i < window_; i++) used_[i] = false;
+}
+
+// Deconstructor
+SvtEventBuilder::~SvtEventBuilder ( ) {
+   delete[] slots_;
+   delete[] used_;
+}
+
+// Find oldest open event
+int SvtEventBuilder::oldest ( ) {
+   int ret = -1;
+
+   for (uint i=0; i < window_; i++) {
+      if ( used_[i] && (ret < 0 || slots_[i].tiEventNumber_ < slots_[ret].tiEventNumber_) ) ret = i;
+   }
+   return(ret);
+}
+
+// Add bank to its open event
+void SvtEventBuilder::addBank ( int tag ) {
+   SvtBuiltEvent *event;
+   unsigned long  tiEventNumber;
+   unsigned long  timeStamp;
+   int            slot;
+   int            empty;
+
+   if ( ! input_.hasTiData() ) {
+      noTiCount_++;
+      return;
+   }
+
+   tiEventNumber = input_.tiEventNumber();
+   timeStamp     = input_.timeStamp();
+
+   if ( released_ && tiEventNumber <= lastTiEventNumber_ ) {
+      lateCount_++;
+      return;
+   }
+
+   // Look for the open event, remember a free slot on the way
+   slot = -1;
+   empty = -1;
+   for (uint i=0; i < window_; i++) {
+      if ( used_[i] ) {
+         if ( slots_[i].tiEventNumber_ == tiEventNumber ) slot = i;
+      }
+      else if ( empty < 0 ) empty = i;
+   }
+
+   // Open a new event, next() makes sure there is room
+   if ( slot < 0 ) {
+      slot = empty;
+      slots_[slot].reset(tiEventNumber,timeStamp,dataRead_->bank_range());
+      used_[slot] = true;
+      usedCount_++;
+   }
+   event = &(slots_[slot]);
+
+   if ( event->bankForTag(tag) != NULL ) {
+      event->duplicates_++;
+      duplicateCount_++;
+      return;
+   }
+   if ( event->count_ >= MAXFPGABANKS ) {
+      duplicateCount_++;
+      return;
+   }
+   if ( timeStamp != event->timeStamp_ ) event->timeStampMismatch_ = true;
+
+   event->tag_[event->count_] = tag;
+   event->bank_[event->count_].copy(input_.data(),input_.size());
+   event->count_++;
+}
+
+// Release an open event
+SvtBuiltEvent *SvtEventBuilder::release ( int slot ) {
+   SvtBuiltEvent *event = &(slots_[slot]);
+
+   current_           = slot;
+   released_          = true;
+   lastTiEventNumber_ = event->tiEventNumber_;
+
+   builtCount_++;
+   if ( ! event->complete() ) incompleteCount_++;
+   if ( event->timeStampMismatch_ ) mismatchCount_++;
+   return(event);
+}
+
+// Set a function called for every bank read
+void SvtEventBuilder::setBankCallback ( void (*callback)(TiTriggerEvent *bank, int tag, void *arg), void *arg ) {
+   bankCallback_ = callback;
+   bankArg_      = arg;
+}
+
+// Get next built event
+SvtBuiltEvent *SvtEventBuilder::next ( ) {
+   int slot;
+
+   // Free the event handed out last time
+   if ( current_ >= 0 ) {
+      used_[current_] = false;
+      usedCount_--;
+      current_ = -1;
+   }
+
+   while ( true ) {
+      slot = oldest();
+
+      // Release when complete, at end of data, or to make room in the window
+      if ( slot >= 0 && (slots_[slot].complete() || eof_ || usedCount_ == window_) )
+         return(release(slot));
+
+      if ( eof_ ) return(NULL);
+
+      if ( ! dataRead_->next(&input_) ) eof_ = true;
+      else {
+         if ( bankCallback_ != NULL ) bankCallback_(&input_,dataRead_->last_bank_tag(),bankArg_);
+         addBank(dataRead_->last_bank_tag());
+      }
+   }
+}
+
+// Statistics
+uint SvtEventBuilder::builtCount ( ) {
+   return(builtCount_);
+}
+
+uint SvtEventBuilder::incompleteCount ( ) {
+   return(incompleteCount_);
+}
+
+uint SvtEventBuilder::duplicateCount ( ) {
+   return(duplicateCount_);
+}
+
+uint SvtEventBuilder::lateCount ( ) {
+   return(lateCount_);
+}
+
+uint SvtEventBuilder::noTiCount ( ) {
+   return(noTiCount_);
+}
+
+uint SvtEventBuilder::mismatchCount ( ) {
+   return(mismatchCount_);
+}
+
+// Dump statistics
+void SvtEventBuilder::dumpStats ( ostream &out ) {
+   out << "Event builder statistics:" << endl;
+   out << "   Built events:        " << builtCount_ << endl;
+   out << "   Incomplete events:   " << incompleteCount_ << endl;
+   out << "   Timestamp mismatch:  " << mismatchCount_ << endl;
+   out << "   Duplicate banks:     " << duplicateCount_ << endl;
+   out << "   Late banks:          " << lateCount_ << endl;
+   out << "   Banks without TI:    " << noTiCount_ << endl;
+}
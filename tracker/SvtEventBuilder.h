@@ -0,0 +1,190 @@
+//-----------------------------------------------------------------------------
+// File          : SvtEventBuilder.h
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Event builder on top of DataReadEvio. Groups the SVT banks of all RCEs
+// (bank tags bank_num() .. bank_num()+bank_range()-1) that carry the same
+// TI event number into one detector-wide event.
+//
+// Banks are collected in a fixed number of open events (the out-of-order
+// window). The oldest open event is released once all expected banks have
+// arrived, or when the window is full and a new TI event number shows up,
+// or at the end of the file. Banks that arrive for an event that was
+// already released are counted as late and dropped. Memory use is bounded
+// by the window size; bank buffers are reused between events.
+//
+// Requires engineering run format (DataReadEvio::set_engrun), where each
+// bank has the TI words appended.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#ifndef __SVT_EVENT_BUILDER_H__
+#define __SVT_EVENT_BUILDER_H__
+
+#include <iostream>
+#include <sys/types.h>
+#include "DataReadEvio.h"
+#include "TiTriggerEvent.h"
+using namespace std;
+
+//! Detector-wide SVT event, all banks for one TI event number
+class SvtBuiltEvent {
+      friend class SvtEventBuilder;
+
+      // Bank containers, reused
+      TiTriggerEvent bank_[MAXFPGABANKS];
+      int            tag_[MAXFPGABANKS];
+      uint           count_;
+      uint           expected_;
+      uint           duplicates_;
+      unsigned long  tiEventNumber_;
+      unsigned long  timeStamp_;
+      bool           timeStampMismatch_;
+
+      // Reset for a new TI event number
+      void reset ( unsigned long tiEventNumber, unsigned long timeStamp, uint expected );
+
+   public:
+
+      //! Constructor
+      SvtBuiltEvent ( );
+
+      //! Get number of banks in the event
+      uint count ( );
+
+      //! Get bank at index
+      /*!
+       * \param index Bank index. 0 - count()-1.
+      */
+      TiTriggerEvent *bank ( uint index );
+
+      //! Get bank tag (ROC) of bank at index
+      /*!
+       * \param index Bank index. 0 - count()-1.
+      */
+      int bankTag ( uint index );
+
+      //! Get bank for a bank tag, NULL if the bank is missing
+      /*!
+       * \param tag Bank tag
+      */
+      TiTriggerEvent *bankForTag ( int tag );
+
+      //! Get TI event number
+      unsigned long tiEventNumber ( );
+
+      //! Get TI timestamp, taken from the first bank
+      unsigned long timeStamp ( );
+
+      //! Get number of expected banks that are missing
+      uint missing ( );
+
+      //! Get number of duplicated banks that were dropped
+      uint duplicates ( );
+
+      //! True if banks disagree on the TI timestamp
+      bool timeStampMismatch ( );
+
+      //! True if all expected banks are present
+      bool complete ( );
+};
+
+//! Builds SvtBuiltEvents from a DataReadEvio stream in a single pass
+class SvtEventBuilder {
+
+      // Input
+      DataReadEvio   *dataRead_;
+      TiTriggerEvent  input_;
+      bool            eof_;
+
+      // Open events
+      uint            window_;
+      SvtBuiltEvent  *slots_;
+      bool           *used_;
+      uint            usedCount_;
+
+      // Event handed out by the last call to next()
+      int             current_;
+
+      // Called for every bank read
+      void          (*bankCallback_)(TiTriggerEvent *bank, int tag, void *arg);
+      void           *bankArg_;
+
+      // Last released TI event number
+      bool            released_;
+      unsigned long   lastTiEventNumber_;
+
+      // Statistics
+      uint builtCount_;
+      uint incompleteCount_;
+      uint duplicateCount_;
+      uint lateCount_;
+      uint noTiCount_;
+      uint mismatchCount_;
+
+      // Find the open event with the lowest TI event number, -1 if none
+      int oldest ( );
+
+      // Add the bank in input_ to its open event
+      void addBank ( int tag );
+
+      // Release an open event
+      SvtBuiltEvent *release ( int slot );
+
+   public:
+
+      //! Constructor
+      /*!
+       * \param dataRead Open EVIO reader, engineering run format
+       * \param window Number of TI events that can be open at the same time
+      */
+      SvtEventBuilder ( DataReadEvio *dataRead, uint window = 8 );
+
+      //! Deconstructor
+      ~SvtEventBuilder ( );
+
+      //! Set a function called for every bank read, before it is built into an event
+      /*!
+       * Banks the builder drops (no TI data, late or duplicated) are passed
+       * too, so per bank checks cover the whole input.
+       * \param callback Function, NULL for none
+       * \param arg Argument passed to the function
+      */
+      void setBankCallback ( void (*callback)(TiTriggerEvent *bank, int tag, void *arg), void *arg = NULL );
+
+      //! Get next built event
+      /*!
+       * Returns pointer to internal event object, NULL at end of data.
+       * Contents of returned object will change next time next() is called.
+      */
+      SvtBuiltEvent *next ( );
+
+      //! Number of events built
+      uint builtCount ( );
+
+      //! Number of events released with missing banks
+      uint incompleteCount ( );
+
+      //! Number of duplicated banks dropped
+      uint duplicateCount ( );
+
+      //! Number of banks dropped because their event was already released
+      uint lateCount ( );
+
+      //! Number of banks dropped because they had no TI data
+      uint noTiCount ( );
+
+      //! Number of events with inconsistent TI timestamps
+      uint mismatchCount ( );
+
+      //! Dump statistics
+      void dumpStats ( ostream &out=cout );
+};
+
+#endif
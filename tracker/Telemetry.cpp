@@ -0,0 +1,290 @@
+//-----------------------------------------------------------------------------
+// File          : Telemetry.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Slow control telemetry of a run, taken from the event headers.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+// 10/19/2026: TriggerEvent sequences kept per ROC bank, in their own sources
+//-----------------------------------------------------------------------------
+#include <iostream>
+#include <iterator>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include "Telemetry.h"
+#include "DevboardEvent.h"
+#include "TiTriggerEvent.h"
+using namespace std;
+
+// Constructor
+Telemetry::Telemetry ( ) {
+   memset(&header_,0,sizeof(header_));
+   header_.magic      = TelemetryMagic;
+   header_.version    = TelemetryVersion;
+   header_.headerSize = sizeof(TelemetryHeader);
+   header_.recordSize = sizeof(TelemetryRecord);
+   header_.interval   = 1;
+   out_       = NULL;
+   records_   = 0;
+   oldHybrid_ = false;
+}
+
+// Deconstructor
+Telemetry::~Telemetry ( ) {
+   close();
+}
+
+// Set the source name
+void Telemetry::setSource ( string source ) {
+   memset(header_.source,0,sizeof(header_.source));
+   strncpy(header_.source,source.c_str(),sizeof(header_.source)-1);
+}
+
+// Open the .telem file
+bool Telemetry::open ( string file, uint interval, bool oldHybrid ) {
+   struct timeval tv;
+
+   close();
+   sources_.clear();
+   index_.clear();
+   records_ = 0;
+
+   oldHybrid_         = oldHybrid;
+   header_.interval   = (interval < 1) ? 1 : interval;
+   header_.flags      = oldHybrid ? TelemetryOldHybrid : 0;
+   gettimeofday(&tv,NULL);
+   header_.created    = tv.tv_sec + tv.tv_usec * 1e-6;
+
+   if ( (out_ = fopen(file.c_str(),"w")) == NULL ) {
+      cout << "Telemetry::open -> Failed to open file: " << file << endl;
+      return(false);
+   }
+   if ( fwrite(&header_,sizeof(header_),1,out_) != 1 ) {
+      cout << "Telemetry::open -> Failed to write file: " << file << endl;
+      fclose(out_);
+      out_ = NULL;
+      return(false);
+   }
+   return(true);
+}
+
+// Source of a frame
+Telemetry::Source *Telemetry::source ( uint id ) {
+   map<uint,uint>::iterator it;
+   Source                   s;
+
+   if ( (it = index_.find(id)) != index_.end() ) return(&sources_[it->second]);
+
+   memset(&s,0,sizeof(s));
+   index_[id] = sources_.size();
+   sources_.push_back(s);
+   return(&sources_.back());
+}
+
+// Add the counters of a frame
+Telemetry::Source *Telemetry::frame ( uint id, uint64_t event, uint sequence, uint mask ) {
+   Source          *s = source(id);
+   TelemetryRecord *r = &s->record;
+   uint64_t        interval = event / header_.interval;
+
+   sequence &= mask;
+   if ( s->open && s->interval != interval ) flush(s);
+   if ( ! s->open ) {
+      memset(r,0,sizeof(TelemetryRecord));
+      memset(s->sum,0,sizeof(s->sum));
+      r->source        = id;
+      r->firstEvent    = event;
+      r->firstSequence = sequence;
+      s->interval      = interval;
+      s->open          = true;
+      s->ti            = false;
+   }
+   if ( mask != 0 && s->frames > 0 && ((sequence - s->sequence) & mask) != 1 ) {
+      r->sequenceGaps++;
+      s->gaps++;
+   }
+   r->lastEvent    = event;
+   r->lastSequence = sequence;
+   r->frames++;
+   s->sequence = sequence;
+   s->frames++;
+   return(s);
+}
+
+// Write the record of a source
+void Telemetry::flush ( Source *s ) {
+   TelemetryRecord *r = &s->record;
+
+   for (uint i=0; i < TelemetryTemps; i++) r->tempMean[i] = (r->temps > 0) ? s->sum[i] / r->temps : 0;
+   if ( out_ != NULL && fwrite(r,sizeof(TelemetryRecord),1,out_) == 1 ) records_++;
+   s->open = false;
+}
+
+// Add a data frame
+void Telemetry::add ( DevboardEvent *event, uint64_t number ) {
+   Source          *s = frame(event->fpgaAddress(),number,event->sequence(),0xFFFFFFFF);
+   TelemetryRecord *r = &s->record;
+   float           t;
+
+   if ( event->isTiFrame() ) return;
+
+   for (uint i=0; i < TelemetryTemps; i++) {
+      t = event->temperature(i,oldHybrid_);
+      if ( r->temps == 0 || t < r->tempMin[i] ) r->tempMin[i] = t;
+      if ( r->temps == 0 || t > r->tempMax[i] ) r->tempMax[i] = t;
+      s->sum[i] += t;
+   }
+   r->temps++;
+}
+
+// Add a trigger frame, and its TI data to the TI source
+void Telemetry::add ( TiTriggerEvent *event, uint64_t number, uint bank ) {
+   Source          *s;
+   TelemetryRecord *r;
+
+   frame(TelemetryRocSource + (bank & 0xFFFF),number,event->sequence(),0xFFFFFF);
+   if ( ! event->hasTiData() ) return;
+
+   s = frame(TelemetryTiSource,number,0,0);
+   r = &s->record;
+
+   r->lastTiEvent   = event->tiEventNumber();
+   r->lastTimeStamp = event->timeStamp();
+   if ( ! s->ti ) {
+      r->firstTiEvent   = r->lastTiEvent;
+      r->firstTimeStamp = r->lastTimeStamp;
+      s->ti = true;
+   }
+}
+
+// Write the open intervals and close the file
+bool Telemetry::close ( ) {
+   map<uint,uint>::iterator it;
+   bool                     ok;
+
+   if ( out_ == NULL ) return(true);
+
+   for (it = index_.begin(); it != index_.end(); it++)
+      if ( sources_[it->second].open ) flush(&sources_[it->second]);
+
+   ok = (ferror(out_) == 0);
+   ok = (fclose(out_) == 0) && ok;
+   out_ = NULL;
+   if ( ! ok ) cout << "Telemetry::close -> Failed to write telemetry file" << endl;
+   return(ok);
+}
+
+// Records written
+uint64_t Telemetry::records ( ) {
+   return(records_);
+}
+
+// Sources seen
+uint Telemetry::sources ( ) {
+   return(index_.size());
+}
+
+// Source id of a source, in id order
+uint Telemetry::sourceId ( uint index ) {
+   map<uint,uint>::iterator it = index_.begin();
+
+   if ( index >= index_.size() ) return(0);
+   advance(it,index);
+   return(it->first);
+}
+
+// Frames and sequence gaps of a source over the run
+void Telemetry::sourceCounts ( uint index, uint64_t &frames, uint64_t &gaps ) {
+   map<uint,uint>::iterator it = index_.begin();
+
+   frames = 0;
+   gaps   = 0;
+   if ( index >= index_.size() ) return;
+   advance(it,index);
+   frames = sources_[it->second].frames;
+   gaps   = sources_[it->second].gaps;
+}
+
+// Constructor
+TelemetryFile::TelemetryFile ( ) {
+   fd_      = -1;
+   map_     = NULL;
+   size_    = 0;
+   header_  = NULL;
+   records_ = NULL;
+   count_   = 0;
+}
+
+// Deconstructor
+TelemetryFile::~TelemetryFile ( ) {
+   close();
+}
+
+// Map a .telem file
+bool TelemetryFile::open ( string file ) {
+   struct stat     st;
+   TelemetryHeader *header;
+
+   close();
+
+   if ( (fd_ = ::open(file.c_str(),O_RDONLY)) < 0 ) return(false);
+   if ( fstat(fd_,&st) != 0 || st.st_size < (off_t)sizeof(TelemetryHeader) ) {
+      close();
+      return(false);
+   }
+   size_ = st.st_size;
+   if ( (map_ = mmap(NULL,size_,PROT_READ,MAP_SHARED,fd_,0)) == MAP_FAILED ) {
+      map_ = NULL;
+      close();
+      return(false);
+   }
+   header = (TelemetryHeader *)map_;
+   if ( header->magic != TelemetryMagic || header->version != TelemetryVersion ||
+        header->headerSize != sizeof(TelemetryHeader) || header->recordSize != sizeof(TelemetryRecord) ) {
+      cout << "TelemetryFile::open -> Not a telemetry file: " << file << endl;
+      close();
+      return(false);
+   }
+   header_  = header;
+   records_ = (TelemetryRecord *)((char *)map_ + sizeof(TelemetryHeader));
+   count_   = (size_ - sizeof(TelemetryHeader)) / sizeof(TelemetryRecord);
+   return(true);
+}
+
+// Unmap and close
+void TelemetryFile::close ( ) {
+   if ( map_ != NULL ) munmap(map_,size_);
+   if ( fd_ >= 0 ) ::close(fd_);
+   fd_      = -1;
+   map_     = NULL;
+   size_    = 0;
+   header_  = NULL;
+   records_ = NULL;
+   count_   = 0;
+}
+
+// File header
+const TelemetryHeader *TelemetryFile::header ( ) {
+   return(header_);
+}
+
+// Number of records
+uint64_t TelemetryFile::count ( ) {
+   return(count_);
+}
+
+// Record by index
+const TelemetryRecord *TelemetryFile::record ( uint64_t index ) {
+   if ( records_ == NULL || index >= count_ ) return(NULL);
+   return(&records_[index]);
+}
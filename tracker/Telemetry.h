@@ -0,0 +1,221 @@
+//-----------------------------------------------------------------------------
+// File          : Telemetry.h
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Slow control telemetry of a run, taken from the event headers.
+//
+// Every frame header carries the FPGA address, a sequence counter and, for
+// data frames, the 12 hybrid thermistor readings; trigger frames with TI
+// data carry the TI event number and time stamp. Telemetry keeps, for each
+// source, the first and last counters and the min, max and mean of each
+// temperature over intervals of a fixed number of events, and writes one
+// record per source and interval as soon as the interval is complete.
+//
+// The sources are the FPGA address of DevboardEvent frames, the ROC bank of
+// TriggerEvent frames (TelemetryRocSource plus the bank tag), each with its
+// own sequence counter, and TelemetryTiSource for the TI event numbers and
+// time stamps of all trigger frames with TI data. Sequence gaps are counted
+// modulo the counter width (24 bits for TriggerEvent frames), so a counter
+// wrapping around is not a gap. A run is summarized in the same pass
+// that reads its data, in a file a small fraction of the data size.
+//
+// A .telem file is a header followed by fixed size records. Records of a
+// source are in event order; records of different sources are in the order
+// their intervals ended. The record count follows from the file size, so a
+// file cut short by a crash is still readable. TelemetryFile maps a .telem
+// file read only; the records are used in place, without parsing.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+// 10/19/2026: TriggerEvent sequences kept per ROC bank, in their own sources
+//-----------------------------------------------------------------------------
+#ifndef __TELEMETRY_H__
+#define __TELEMETRY_H__
+
+#include <string>
+#include <vector>
+#include <map>
+#include <stdio.h>
+#include <stdint.h>
+#include <sys/types.h>
+using namespace std;
+
+class DevboardEvent;
+class TiTriggerEvent;
+
+//! Telemetry file identifier
+#define TelemetryMagic 0x54454C4D
+
+//! Telemetry file layout version
+#define TelemetryVersion 1
+
+//! Temperature channels of a frame header
+#define TelemetryTemps 12
+
+//! Source of the TI records
+#define TelemetryTiSource 0x10000
+
+//! Source of the TriggerEvent frames of a ROC bank, plus the bank tag
+#define TelemetryRocSource 0x20000
+
+//! Telemetry file header flags
+enum TelemetryFlags {
+   TelemetryOldHybrid = 0x1   //!< Temperatures converted for old hybrids
+};
+
+//! Telemetry file header, 128 bytes
+struct TelemetryHeader {
+   uint   magic;
+   uint   version;
+   uint   headerSize;     //!< Bytes of this header
+   uint   recordSize;     //!< Bytes of a record
+   uint   interval;       //!< Events per interval
+   uint   flags;          //!< TelemetryFlags
+   double created;        //!< Unix time the file was written
+   char   source[96];     //!< Name of the run
+};
+
+//! Telemetry of one source over one interval, 216 bytes
+struct TelemetryRecord {
+   uint64_t firstEvent;              //!< Event of the first frame
+   uint64_t lastEvent;               //!< Event of the last frame
+   uint64_t firstTiEvent;            //!< TI event number of the first frame, 0 without TI data
+   uint64_t lastTiEvent;
+   uint64_t firstTimeStamp;          //!< TI time stamp of the first frame, 0 without TI data
+   uint64_t lastTimeStamp;
+   uint     source;                  //!< FPGA address, TelemetryRocSource + ROC bank, or TelemetryTiSource
+   uint     frames;                  //!< Frames in the interval
+   uint     firstSequence;           //!< Sequence count of the first frame
+   uint     lastSequence;
+   uint     sequenceGaps;            //!< Frames whose sequence does not follow the previous frame's, 0 for the TI
+   uint     temps;                   //!< Frames with temperatures
+   float    tempMin[TelemetryTemps];
+   float    tempMax[TelemetryTemps];
+   float    tempMean[TelemetryTemps];
+};
+
+//! Telemetry writer
+class Telemetry {
+
+      // A source and its open interval
+      struct Source {
+         TelemetryRecord record;
+         uint64_t        interval;       // Interval of the record
+         bool            open;           // Record has frames
+         bool            ti;             // Record has TI data
+         uint            sequence;       // Sequence of the last frame
+         uint64_t        frames;         // Frames over the run
+         uint64_t        gaps;           // Sequence gaps over the run
+         double          sum[TelemetryTemps];
+      };
+
+      TelemetryHeader  header_;
+      FILE             *out_;
+      vector<Source>   sources_;
+      map<uint,uint>   index_;
+      uint64_t         records_;
+      bool             oldHybrid_;
+
+      // Source of a frame, started with its first frame
+      Source *source ( uint id );
+
+      // Add the counters of a frame, closing the previous interval if this is a new one;
+      // sequences are compared modulo mask + 1, a mask of 0 for sources without sequence
+      Source *frame ( uint id, uint64_t event, uint sequence, uint mask );
+
+      // Write the record of a source
+      void flush ( Source *s );
+
+   public:
+
+      //! Constructor
+      Telemetry ( );
+
+      //! Deconstructor, closes the file
+      ~Telemetry ( );
+
+      //! Set the source name stored in the header
+      void setSource ( string source );
+
+      //! Open the .telem file, returns false on failure
+      /*!
+       * \param file File name
+       * \param interval Events per interval
+       * \param oldHybrid Convert temperatures for old hybrids
+      */
+      bool open ( string file, uint interval, bool oldHybrid = false );
+
+      //! Add a data frame
+      /*!
+       * \param event Frame
+       * \param number Event number, counting from 0 over the run
+      */
+      void add ( DevboardEvent *event, uint64_t number );
+
+      //! Add a trigger frame, and its TI data to the TI source
+      /*!
+       * \param event Frame
+       * \param number Event number, counting from 0 over the run
+       * \param bank ROC bank tag, as DataReadEvio::last_bank_tag()
+      */
+      void add ( TiTriggerEvent *event, uint64_t number, uint bank );
+
+      //! Write the open intervals and close the file, returns false on a write error
+      bool close ( );
+
+      //! Records written
+      uint64_t records ( );
+
+      //! Sources seen
+      uint sources ( );
+
+      //! Source id of a source
+      uint sourceId ( uint index );
+
+      //! Frames and sequence gaps of a source over the run
+      void sourceCounts ( uint index, uint64_t &frames, uint64_t &gaps );
+};
+
+//! Read only mapping of a .telem file
+class TelemetryFile {
+
+      int             fd_;
+      void            *map_;
+      size_t          size_;
+      TelemetryHeader *header_;
+      TelemetryRecord *records_;
+      uint64_t        count_;
+
+   public:
+
+      //! Constructor
+      TelemetryFile ( );
+
+      //! Deconstructor
+      ~TelemetryFile ( );
+
+      //! Map a .telem file, returns false if it is missing or not a telemetry file
+      /*!
+       * \param file File name
+      */
+      bool open ( string file );
+
+      //! Unmap and close
+      void close ( );
+
+      //! File header, NULL if not open
+      const TelemetryHeader *header ( );
+
+      //! Number of records
+      uint64_t count ( );
+
+      //! Record by index, NULL if out of range
+      const TelemetryRecord *record ( uint64_t index );
+};
+
+#endif
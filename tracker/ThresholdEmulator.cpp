@@ -0,0 +1,371 @@
+//-----------------------------------------------------------------------------
+// File          : ThresholdEmulator.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Offline emulation of the FEB/RCE zero suppression.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "ThresholdEmulator.h"
+#include "BaselineFile.h"
+using namespace std;
+
+// Key from rce, feb and hybrid
+uint ThresholdEmulator::key ( uint rce, uint feb, uint hyb ) {
+   return(((rce & 0xFFFF) << 16) | ((feb & 0xFF) << 8) | (hyb & 0xFF));
+}
+
+// Constructor
+ThresholdEmulator::ThresholdEmulator ( ) {
+   uint i;
+
+   useFilter_   = false;
+   minSamples_  = 1;
+   signalSigma_ = 5.0;
+   count_       = 0;
+   alloc_       = 0;
+   for (i=0; i < Samples; i++) values_[i] = NULL;
+   thresholds_  = NULL;
+   keep_        = NULL;
+   readouts_        = 0;
+   keptReadouts_    = 0;
+   unknownReadouts_ = 0;
+   invalidReadouts_ = 0;
+}
+
+// Deconstructor
+ThresholdEmulator::~ThresholdEmulator ( ) {
+   map<uint,Table *>::iterator    tableIter;
+   map<uint,Baseline *>::iterator baseIter;
+   map<uint,Counts *>::iterator   countIter;
+   uint i;
+
+   for (tableIter = tables_.begin(); tableIter != tables_.end(); tableIter++) delete tableIter->second;
+   for (baseIter = baselines_.begin(); baseIter != baselines_.end(); baseIter++) delete[] baseIter->second;
+   for (countIter = counts_.begin(); countIter != counts_.end(); countIter++) delete countIter->second;
+   for (i=0; i < Samples; i++) free(values_[i]);
+   free(thresholds_);
+   free(keep_);
+}
+
+// Load thresholds: a "feb,hyb,apv" line starts each APV, then "channel,threshold" lines
+bool ThresholdEmulator::loadThresholds ( string file ) {
+   ifstream is;
+   string   line;
+   Table    *table = NULL;
+   int      feb, hyb, apv, channel;
+   double   threshold;
+   uint     tableKey;
+
+   is.open(file.c_str());
+   if ( ! is.is_open() ) return(false);
+
+   while ( getline(is,line) ) {
+      if ( line.length() == 0 || line[0] == '%' || line[0] == '#' ) continue;
+      if ( sscanf(line.c_str(),"%d,%d,%d",&feb,&hyb,&apv) == 3 ) {
+         tableKey = key(0,feb,hyb);
+         if ( tables_.find(tableKey) == tables_.end() ) {
+            table = new Table;
+            memset(table,0,sizeof(Table));
+            tables_[tableKey] = table;
+         }
+         table = tables_[tableKey];
+      }
+      else if ( sscanf(line.c_str(),"%d,%lf",&channel,&threshold) == 2 && table != NULL ) {
+         if ( channel < 0 || channel >= (int)Channels ) continue;
+
+         // Samples are integers: above threshold means above its floor
+         threshold = floor(threshold);
+         if ( threshold < -1 ) threshold = -1;
+         if ( threshold > 32767 ) threshold = 32767;
+         table->threshold[channel] = (short)threshold;
+         table->loaded[channel]    = true;
+      }
+   }
+   is.close();
+   return(true);
+}
+
+// Load baseline, read with BaselineFile
+bool ThresholdEmulator::loadBaseline ( string file ) {
+   BaselineFile    in;
+   BaselineChannel ch;
+   uint            baseKey;
+   uint            i;
+   Baseline        *base;
+
+   if ( ! in.open(file) ) return(false);
+
+   while ( in.next(&ch) ) {
+      if ( ch.channel >= Channels ) continue;
+
+      baseKey = key(ch.rce,ch.feb,ch.hybrid);
+      if ( baselines_.find(baseKey) == baselines_.end() ) {
+         baselines_[baseKey] = new Baseline[Channels];
+         for (i=0; i < Channels; i++) baselines_[baseKey][i].loaded = false;
+      }
+      base = &(baselines_[baseKey][ch.channel]);
+      for (i=0; i < Samples; i++) base->mean[i] = ch.mean[i];
+      base->sigma  = ch.sigma[Samples];
+      base->loaded = true;
+   }
+   in.close();
+   return(true);
+}
+
+// Load filter: ID line, then "fpga hyb apv" and the coefficients
+bool ThresholdEmulator::loadFilter ( string file ) {
+   ifstream is;
+   string   line;
+   uint     fpga, hyb, apv, i;
+
+   for (fpga=0; fpga < Filter::FpgaCount; fpga++)
+      for (hyb=0; hyb < Filter::HybridCount; hyb++)
+         for (apv=0; apv < Filter::ApvCount; apv++) {
+            filter_.filterData[fpga][hyb][apv][0] = 1;
+            for (i=1; i < Filter::CoefCount; i++) filter_.filterData[fpga][hyb][apv][i] = 0;
+         }
+
+   is.open(file.c_str());
+   if ( ! is.is_open() ) return(false);
+
+   while ( getline(is,line) ) {
+      if ( line[0] != '#' ) break;
+   }
+   memset(filter_.filterId,0,Filter::IdLength);
+   line.copy(filter_.filterId,Filter::IdLength-1);
+
+   while ( getline(is,line) ) {
+      if ( line.length() == 0 || line[0] == '#' ) continue;
+      istringstream iss(line);
+      if ( ! (iss >> fpga >> hyb >> apv) ) return(false);
+      if ( fpga >= Filter::FpgaCount || hyb >= Filter::HybridCount || apv >= Filter::ApvCount ) continue;
+      for (i=0; i < Filter::CoefCount; i++)
+         if ( ! (iss >> filter_.filterData[fpga][hyb][apv][i]) ) return(false);
+   }
+   is.close();
+   useFilter_ = true;
+   return(true);
+}
+
+// Set N of N-of-6
+void ThresholdEmulator::setMinSamples ( uint samples ) {
+   minSamples_ = samples;
+}
+
+// Set signal cut
+void ThresholdEmulator::setSignalSigma ( double sigma ) {
+   signalSigma_ = sigma;
+}
+
+// Make room for count readouts, rounded up to whole compare blocks
+void ThresholdEmulator::reserve ( uint count ) {
+   uint i;
+
+   if ( count <= alloc_ ) return;
+   alloc_ = ((count * 2 + 7) / 8) * 8;
+   for (i=0; i < Samples; i++) values_[i] = (short *)realloc(values_[i],alloc_ * sizeof(short));
+   thresholds_ = (short *)realloc(thresholds_,alloc_ * sizeof(short));
+   keep_       = (unsigned char *)realloc(keep_,alloc_);
+}
+
+// Start a new frame
+void ThresholdEmulator::begin ( ) {
+   count_ = 0;
+   keys_.clear();
+   apvs_.clear();
+   channels_.clear();
+   peaks_.clear();
+}
+
+// Add a readout
+uint ThresholdEmulator::add ( uint rce, uint feb, uint hyb, uint apv, uint channel, uint *values ) {
+   map<uint,Table *>::iterator    tableIter;
+   map<uint,Baseline *>::iterator baseIter;
+   Baseline *base;
+   bool     valid = (apv <= 4 && channel < 128);
+   uint     index = valid ? (4 - apv) * 128 + channel : Channels;
+   uint     i;
+   float    peak;
+
+   reserve(count_ + 1);
+   for (i=0; i < Samples; i++) values_[i][count_] = (values[i] > 32767) ? 32767 : values[i];
+
+   // Threshold, -1 keeps every sample
+   thresholds_[count_] = -1;
+   tableIter = tables_.find(key(0,feb,hyb));
+   if ( ! valid ) invalidReadouts_++;
+   else if ( tableIter != tables_.end() && tableIter->second->loaded[index] )
+      thresholds_[count_] = tableIter->second->threshold[index];
+   else unknownReadouts_++;
+
+   // Signal size from the raw samples
+   peak = -1;
+   baseIter = baselines_.find(key(rce,feb,hyb));
+   if ( valid && baseIter != baselines_.end() ) {
+      base = &(baseIter->second[index]);
+      if ( base->loaded && base->sigma > 0 ) {
+         for (i=0; i < Samples; i++)
+            if ( (values_[i][count_] - base->mean[i]) / base->sigma > peak )
+               peak = (values_[i][count_] - base->mean[i]) / base->sigma;
+      }
+   }
+
+   keys_.push_back(key(rce,feb,hyb));
+   apvs_.push_back(apv);
+   channels_.push_back(index);
+   peaks_.push_back(peak);
+   return(count_++);
+}
+
+// Filter each sample along the readout order of its APV, like meeg_sync
+void ThresholdEmulator::applyFilter ( ) {
+   short  history[Samples][Filter::CoefCount];
+   uint   pos = 0;
+   uint   k, y, i;
+   uint   feb, hyb, apv;
+   double value;
+
+   for (k=0; k < count_; k++) {
+      if ( k == 0 || keys_[k] != keys_[k-1] || apvs_[k] != apvs_[k-1] ) pos = 0;
+      feb = (keys_[k] >> 8) & 0xFF;
+      hyb = keys_[k] & 0xFF;
+      apv = apvs_[k];
+
+      for (y=0; y < Samples; y++) {
+         history[y][pos % Filter::CoefCount] = values_[y][k];
+         if ( pos + 1 < Filter::CoefCount ) continue;
+         if ( feb >= Filter::FpgaCount || hyb >= Filter::HybridCount || apv >= Filter::ApvCount ) continue;
+
+         value = 0;
+         for (i=0; i < Filter::CoefCount; i++)
+            value += filter_.filterData[feb][hyb][apv][i] * history[y][(pos - i) % Filter::CoefCount];
+         value = floor(value + 0.5);
+         if ( value < 0 ) value = 0;
+         if ( value > 32767 ) value = 32767;
+         values_[y][k] = (short)value;
+      }
+      pos++;
+   }
+}
+
+// Apply the cuts
+void ThresholdEmulator::process ( ) {
+   map<uint,Counts *>::iterator countIter;
+   Counts *counts = NULL;
+   uint   lastKey = 0;
+   uint   k = 0;
+   uint   y;
+   uint   above;
+
+   if ( useFilter_ ) applyFilter();
+
+#ifdef __SSE2__
+   // Count samples over threshold for 8 readouts at once
+   __m128i minus = _mm_set1_epi16((short)(minSamples_ - 1));
+   for (k=0; k + 8 <= count_; k += 8) {
+      __m128i thr   = _mm_loadu_si128((__m128i *)(thresholds_ + k));
+      __m128i count = _mm_setzero_si128();
+      for (y=0; y < Samples; y++)
+         count = _mm_sub_epi16(count,_mm_cmpgt_epi16(_mm_loadu_si128((__m128i *)(values_[y] + k)),thr));
+      __m128i pass = _mm_cmpgt_epi16(count,minus);
+      _mm_storel_epi64((__m128i *)(keep_ + k),_mm_packs_epi16(pass,pass));
+   }
+#endif
+   for (; k < count_; k++) {
+      above = 0;
+      for (y=0; y < Samples; y++) if ( values_[y][k] > thresholds_[k] ) above++;
+      keep_[k] = (above >= minSamples_) ? 0xFF : 0;
+   }
+
+   // Counters, readouts out of range have no channel
+   for (k=0; k < count_; k++) {
+      readouts_++;
+      if ( keep_[k] ) keptReadouts_++;
+      if ( channels_[k] >= Channels ) continue;
+      if ( counts == NULL || keys_[k] != lastKey ) {
+         lastKey   = keys_[k];
+         countIter = counts_.find(lastKey);
+         if ( countIter == counts_.end() ) {
+            counts = new Counts();
+            counts_[lastKey] = counts;
+         }
+         else counts = countIter->second;
+      }
+      counts->readouts[channels_[k]]++;
+      if ( keep_[k] ) counts->kept[channels_[k]]++;
+      if ( peaks_[k] >= signalSigma_ ) {
+         counts->signal[channels_[k]]++;
+         if ( keep_[k] ) counts->signalKept[channels_[k]]++;
+      }
+   }
+}
+
+// True if kept
+bool ThresholdEmulator::keep ( uint index ) {
+   if ( index >= count_ ) return(false);
+   return(keep_[index] != 0);
+}
+
+// Readouts seen
+unsigned long ThresholdEmulator::readouts ( ) {
+   return(readouts_);
+}
+
+// Readouts kept
+unsigned long ThresholdEmulator::kept ( ) {
+   return(keptReadouts_);
+}
+
+// Readouts without threshold
+unsigned long ThresholdEmulator::unknown ( ) {
+   return(unknownReadouts_);
+}
+
+// Readouts out of range
+unsigned long ThresholdEmulator::invalid ( ) {
+   return(invalidReadouts_);
+}
+
+// Per channel report
+void ThresholdEmulator::report ( ostream &out ) {
+   map<uint,Counts *>::iterator countIter;
+   Counts *counts;
+   uint   i;
+
+   out << "# kept if at least " << minSamples_ << " of " << Samples << " samples are above threshold";
+   if ( useFilter_ ) out << ", filter " << filter_.filterId;
+   out << endl;
+   out << "# signal: largest sample above pedestal by at least " << signalSigma_ << " sigma (needs baseline)" << endl;
+   out << "# rce\tfeb\thyb\tchannel\treadouts\tkept\tkept fraction\tsignal\tsignal kept\tefficiency" << endl;
+
+   for (countIter = counts_.begin(); countIter != counts_.end(); countIter++) {
+      counts = countIter->second;
+      for (i=0; i < Channels; i++) {
+         if ( counts->readouts[i] == 0 ) continue;
+         out << (countIter->first >> 16) << "\t" << ((countIter->first >> 8) & 0xFF) << "\t" << (countIter->first & 0xFF) << "\t" << i;
+         out << "\t" << counts->readouts[i] << "\t" << counts->kept[i];
+         out << "\t" << (double)counts->kept[i] / counts->readouts[i];
+         out << "\t" << counts->signal[i] << "\t" << counts->signalKept[i];
+         if ( counts->signal[i] > 0 ) out << "\t" << (double)counts->signalKept[i] / counts->signal[i];
+         else out << "\t-";
+         out << endl;
+      }
+   }
+}
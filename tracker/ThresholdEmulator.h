@@ -0,0 +1,194 @@
+//-----------------------------------------------------------------------------
+// File          : ThresholdEmulator.h
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Offline emulation of the FEB/RCE zero suppression.
+//
+// A channel readout (6 samples) is kept if at least N of its samples are
+// above the channel threshold. Thresholds come from the .thresholds files
+// written by meeg_all_baseline (pedestal + n sigma, one table per FEB and
+// hybrid, channels numbered (4-apv)*128+channel as in those files). An
+// optional FIR filter in the Filter container layout used by meeg_sync is
+// applied along the readout order of each APV before the compare, like the
+// firmware filter.
+//
+// Readouts of one frame are collected with add() and cut together by
+// process(), which compares 8 channels at a time with SSE2. With a .base
+// file loaded, readouts whose largest pedestal subtracted sample is above
+// a signal cut are counted as signal, giving the per channel efficiency of
+// the thresholds.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#ifndef __THRESHOLD_EMULATOR_H__
+#define __THRESHOLD_EMULATOR_H__
+
+#include <string>
+#include <map>
+#include <vector>
+#include <iostream>
+#include <sys/types.h>
+#include "Filter.h"
+using namespace std;
+
+//! Zero suppression emulator
+class ThresholdEmulator {
+
+   public:
+
+      //! Channels per hybrid
+      static const uint Channels = 640;
+
+      //! Samples per readout
+      static const uint Samples = 6;
+
+   private:
+
+      // Thresholds of one FEB and hybrid, by channel
+      struct Table {
+         short threshold[Channels];
+         bool  loaded[Channels];
+      };
+
+      // Pedestals and noise of one channel
+      struct Baseline {
+         float mean[Samples];
+         float sigma;
+         bool  loaded;
+      };
+
+      // Counters of one hybrid, by channel
+      struct Counts {
+         unsigned long readouts[Channels];
+         unsigned long kept[Channels];
+         unsigned long signal[Channels];
+         unsigned long signalKept[Channels];
+      };
+
+      // Key from rce, feb and hybrid
+      static uint key ( uint rce, uint feb, uint hyb );
+
+      // Thresholds by key with rce 0, the files have no rce
+      map<uint,Table *> tables_;
+
+      // Baselines by key, Channels entries each
+      map<uint,Baseline *> baselines_;
+
+      // Counters by key
+      map<uint,Counts *> counts_;
+
+      // Filter
+      Filter filter_;
+      bool   useFilter_;
+
+      // Cuts
+      uint   minSamples_;
+      double signalSigma_;
+
+      // Readouts of the current frame, samples stored by sample index
+      uint           count_;
+      uint           alloc_;
+      short          *values_[Samples];
+      short          *thresholds_;
+      unsigned char  *keep_;
+      vector<uint>   keys_;
+      vector<uint>   apvs_;
+      vector<uint>   channels_;  // Channel of each readout, Channels if the APV or channel is out of range
+      vector<float>  peaks_;   // largest raw sample over pedestal in sigmas, -1 without baseline
+
+      // Totals
+      unsigned long readouts_;
+      unsigned long keptReadouts_;
+      unsigned long unknownReadouts_;
+      unsigned long invalidReadouts_;
+
+      // Make room for count readouts
+      void reserve ( uint count );
+
+      // Apply the filter to the current frame
+      void applyFilter ( );
+
+   public:
+
+      //! Constructor
+      ThresholdEmulator ( );
+
+      //! Deconstructor
+      ~ThresholdEmulator ( );
+
+      //! Load a .thresholds file, returns false if it can not be read
+      /*!
+       * \param file File name
+      */
+      bool loadThresholds ( string file );
+
+      //! Load a .base file for the signal efficiency, returns false if it can not be read
+      /*!
+       * \param file File name
+      */
+      bool loadBaseline ( string file );
+
+      //! Load FIR coefficients in the meeg_sync filter file format, returns false if it can not be read
+      /*!
+       * \param file File name
+      */
+      bool loadFilter ( string file );
+
+      //! Set the number of samples that must be above threshold, default 1
+      void setMinSamples ( uint samples );
+
+      //! Set the signal cut in noise sigmas, default 5
+      void setSignalSigma ( double sigma );
+
+      //! Start a new frame
+      void begin ( );
+
+      //! Add a readout to the current frame, returns its index
+      /*!
+       * Channels without a threshold pass every sample compare. Readouts with
+       * an APV above 4 or a channel above 127 pass too, and are counted by
+       * invalid() instead of per channel.
+       * \param rce RCE address
+       * \param feb FEB address
+       * \param hyb Hybrid
+       * \param apv APV
+       * \param channel APV channel
+       * \param values The 6 ADC samples
+      */
+      uint add ( uint rce, uint feb, uint hyb, uint apv, uint channel, uint *values );
+
+      //! Apply the cuts to the readouts of the current frame
+      void process ( );
+
+      //! True if a readout of the current frame is kept
+      /*!
+       * \param index Readout index from add()
+      */
+      bool keep ( uint index );
+
+      //! Readouts seen
+      unsigned long readouts ( );
+
+      //! Readouts kept
+      unsigned long kept ( );
+
+      //! Readouts of channels without a threshold
+      unsigned long unknown ( );
+
+      //! Readouts with an APV or channel out of range
+      unsigned long invalid ( );
+
+      //! Write the per channel report
+      /*!
+       * \param out Output stream
+      */
+      void report ( ostream &out );
+};
+
+#endif
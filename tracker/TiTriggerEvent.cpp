@@ -44,3 +44,12 @@ unsigned long TiTriggerEvent::tiEventNumber() {
   return t;
 
 }
+
+// Check for the 0xFF filler DataReadEvio injects when there is no TI bank
+bool TiTriggerEvent::hasTiData() {
+  if ( size_ < _tiDataSize ) return false;
+  for (uint i = size_ - _tiDataSize; i < size_; i++) {
+    if ( data_[i] != 0xFFFFFFFF ) return true;
+  }
+  return false;
+}
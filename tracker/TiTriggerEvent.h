@@ -19,6 +19,9 @@ class TiTriggerEvent : public TriggerEvent {
 
   unsigned long timeStamp();
   unsigned long tiEventNumber();
+
+  //! False if the TI words are the filler injected for banks without TI data
+  bool hasTiData();
   
  private:
 
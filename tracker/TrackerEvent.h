@@ -13,6 +13,7 @@
 // Modification history :
 // 08/26/2011: created
 // 02/14/2012: Updates to match FPGA. Added hooks for future TI frames.
+// 10/19/2026: Frame layout constants from FrameLayout.h.
 //----------------------------------------------------------------------------
 // Description :
 // Event Container
@@ -60,6 +61,7 @@
 #include <unistd.h>
 #include <sys/types.h>
 #include "TrackerSample.h"
+#include "FrameLayout.h"
 #include <Data.h>
 using namespace std;
 
@@ -74,8 +76,8 @@ class TrackerEvent : public Data {
 
  protected:
   // Frame Constants
-  static const uint kHeadSize   = 1;
-  static const uint kTailSize   = 1;
+  static const uint kHeadSize   = TrackerHeadWords;
+  static const uint kTailSize   = TrackerTailWords;
   
   uint eventCode_;
   uint sampleSize_;
@@ -27,7 +27,7 @@
 using namespace std;
 
 // Constructor
-TriggerEvent::TriggerEvent () : TrackerEvent(1, 4) {}
+TriggerEvent::TriggerEvent () : TrackerEvent(1, TriggerSampleWords) {}
 
 // Deconstructor
 TriggerEvent::~TriggerEvent () {}
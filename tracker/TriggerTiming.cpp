@@ -0,0 +1,373 @@
+//-----------------------------------------------------------------------------
+// File          : TriggerTiming.cpp
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Streaming trigger timing accumulator.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include "TriggerTiming.h"
+using namespace std;
+
+const double TriggerTiming::TickNs = 4.0;
+
+// Constructor
+TriggerTiming::TriggerTiming ( double diffMaxUs, uint diffBins, double rateSec ) {
+   diffMaxUs_   = diffMaxUs;
+   diffBins_    = (diffBins == 0) ? 1 : diffBins;
+   periodCount_ = 0;
+   phaseSize_   = 0;
+   rateTicks_   = (unsigned long)(rateSec * 1.0e9 / TickNs);
+   if ( rateTicks_ == 0 ) rateTicks_ = 1;
+   baseTicks_   = rateTicks_;
+
+   diffHist_  = (uint *)malloc(SourceCount * (diffBins_+1) * sizeof(uint));
+   phaseHist_ = (uint *)malloc(sizeof(uint));
+   rateHist_  = (uint *)malloc(SourceCount * RateBins * sizeof(uint));
+   clear();
+}
+
+// Deconstructor
+TriggerTiming::~TriggerTiming ( ) {
+   free(diffHist_);
+   free(phaseHist_);
+   free(rateHist_);
+}
+
+// Add a phase histogram, the phases already accumulated are kept
+bool TriggerTiming::addPeriod ( uint ticks ) {
+   uint *hist;
+   uint  newSize;
+
+   if ( periodCount_ >= MaxPeriods || ticks == 0 ) return(false);
+   newSize = phaseSize_ + ticks;
+   hist    = (uint *)calloc(SourceCount * newSize, sizeof(uint));
+   for (uint s=0; s < SourceCount; s++)
+      memcpy(&(hist[s*newSize]), &(phaseHist_[s*phaseSize_]), phaseSize_ * sizeof(uint));
+   free(phaseHist_);
+   phaseHist_ = hist;
+   phaseSize_ = newSize;
+   periods_[periodCount_++] = ticks;
+   return(true);
+}
+
+// Clear accumulated data
+void TriggerTiming::clear ( ) {
+   haveOrigin_ = false;
+   origin_     = 0;
+   rateLen_    = 0;
+   rateTicks_  = baseTicks_;
+   for (uint i=0; i < SourceCount; i++) {
+      triggers_[i]     = 0;
+      missed_[i]       = 0;
+      firstStamp_[i]   = 0;
+      lastStamp_[i]    = 0;
+      lastTiNumber_[i] = 0;
+      minDiff_[i]      = 0;
+      sumDiff_[i]      = 0.0;
+   }
+   memset(diffHist_, 0, SourceCount * (diffBins_+1) * sizeof(uint));
+   memset(phaseHist_, 0, SourceCount * phaseSize_ * sizeof(uint));
+   memset(rateHist_, 0, SourceCount * RateBins * sizeof(uint));
+}
+
+// Process one RCE bank
+void TriggerTiming::process ( TiTriggerEvent *event ) {
+   unsigned long stamp;
+   unsigned long tiNumber;
+   uint          count;
+   uint          febMask;
+   uint          feb;
+   uint          rce;
+
+   if ( ! event->hasTiData() ) return;
+   count = event->count();
+   if ( count == 0 ) return;
+
+   stamp    = event->timeStamp();
+   tiNumber = event->tiEventNumber();
+
+   // Find the FEBs read out in this bank
+   febMask = 0;
+   rce     = RceCount;
+   for (uint x=0; x < count; x++) {
+      event->sample(x,&sample_);
+      feb = sample_.febAddress();
+      if ( feb < FebCount ) febMask |= (1 << feb);
+      rce = sample_.rceAddress();
+   }
+   if ( rce >= RceCount ) return;
+
+   for (feb=0; feb < FebCount; feb++) {
+      if ( febMask & (1 << feb) ) fill(rce*FebCount+feb,tiNumber,stamp);
+   }
+}
+
+// Update one source
+void TriggerTiming::fill ( uint src, unsigned long tiNumber, unsigned long stamp ) {
+   unsigned long diff;
+   uint          bin;
+   uint          offset;
+
+   if ( triggers_[src] > 0 ) {
+
+      // Repeated or out of order event
+      if ( tiNumber <= lastTiNumber_[src] ) return;
+      missed_[src] += tiNumber - lastTiNumber_[src] - 1;
+
+      if ( stamp >= lastStamp_[src] ) {
+         diff = stamp - lastStamp_[src];
+         bin  = (uint)((double)diff * TickNs * 1.0e-3 / diffMaxUs_ * (double)diffBins_);
+         if ( bin > diffBins_ ) bin = diffBins_;
+         diffHist_[src*(diffBins_+1)+bin]++;
+         sumDiff_[src] += diff;
+         if ( triggers_[src] == 1 || diff < minDiff_[src] ) minDiff_[src] = diff;
+      }
+   }
+   else firstStamp_[src] = stamp;
+
+   triggers_[src]++;
+   lastStamp_[src]    = stamp;
+   lastTiNumber_[src] = tiNumber;
+
+   // Phase histograms
+   offset = 0;
+   for (uint p=0; p < periodCount_; p++) {
+      phaseHist_[src*phaseSize_+offset+(stamp%periods_[p])]++;
+      offset += periods_[p];
+   }
+
+   fillRate(src,stamp,1);
+}
+
+// Fill rate series
+void TriggerTiming::fillRate ( uint src, unsigned long stamp, uint count ) {
+   unsigned long newOrigin;
+   unsigned long shift;
+   uint          bin;
+
+   if ( ! haveOrigin_ ) {
+      origin_     = stamp - (stamp % rateTicks_);
+      haveOrigin_ = true;
+   }
+
+   // Stamp before the start of the series, move the series to the right
+   if ( stamp < origin_ ) {
+      while ( true ) {
+         newOrigin = stamp - (stamp % rateTicks_);
+         shift     = (origin_ - newOrigin) / rateTicks_;
+         if ( rateLen_ + shift <= RateBins ) break;
+         coarsenRate();
+      }
+      for (uint s=0; s < SourceCount; s++) {
+         uint *h = &(rateHist_[s*RateBins]);
+         for (int i=rateLen_-1; i >= 0; i--) h[i+shift] = h[i];
+         for (uint i=0; i < shift; i++) h[i] = 0;
+      }
+      origin_   = newOrigin;
+      rateLen_ += shift;
+   }
+
+   while ( (stamp - origin_) / rateTicks_ >= RateBins ) coarsenRate();
+
+   bin = (stamp - origin_) / rateTicks_;
+   rateHist_[src*RateBins+bin] += count;
+   if ( bin >= rateLen_ ) rateLen_ = bin + 1;
+}
+
+// Double the rate bin width
+void TriggerTiming::coarsenRate ( ) {
+   unsigned long newTicks;
+   unsigned long newOrigin;
+   uint          off;
+   uint          v;
+
+   newTicks  = 2 * rateTicks_;
+   newOrigin = origin_ - (origin_ % newTicks);
+   off       = (origin_ - newOrigin) / rateTicks_;
+
+   // New bin index never exceeds the old one, so merge in place
+   for (uint s=0; s < SourceCount; s++) {
+      uint *h = &(rateHist_[s*RateBins]);
+      for (uint i=0; i < rateLen_; i++) {
+         v = h[i];
+         h[i] = 0;
+         h[(i+off)/2] += v;
+      }
+   }
+   if ( rateLen_ > 0 ) rateLen_ = (rateLen_ - 1 + off) / 2 + 1;
+   rateTicks_ = newTicks;
+   origin_    = newOrigin;
+}
+
+// Merge another accumulator
+bool TriggerTiming::merge ( TriggerTiming *other ) {
+   unsigned long stamp;
+   uint          offset;
+
+   if ( other->diffBins_ != diffBins_ || other->diffMaxUs_ != diffMaxUs_ ) return(false);
+   if ( other->baseTicks_ != baseTicks_ || other->periodCount_ != periodCount_ ) return(false);
+   for (uint p=0; p < periodCount_; p++) if ( other->periods_[p] != periods_[p] ) return(false);
+
+   for (uint s=0; s < SourceCount; s++) {
+      if ( other->triggers_[s] == 0 ) continue;
+
+      if ( triggers_[s] == 0 ) {
+         firstStamp_[s]   = other->firstStamp_[s];
+         lastStamp_[s]    = other->lastStamp_[s];
+         lastTiNumber_[s] = other->lastTiNumber_[s];
+         minDiff_[s]      = other->minDiff_[s];
+      }
+      else {
+         if ( other->firstStamp_[s] < firstStamp_[s] ) firstStamp_[s] = other->firstStamp_[s];
+         if ( other->lastTiNumber_[s] > lastTiNumber_[s] ) {
+            lastStamp_[s]    = other->lastStamp_[s];
+            lastTiNumber_[s] = other->lastTiNumber_[s];
+         }
+         if ( other->triggers_[s] > 1 && (triggers_[s] == 1 || other->minDiff_[s] < minDiff_[s]) )
+            minDiff_[s] = other->minDiff_[s];
+      }
+      triggers_[s] += other->triggers_[s];
+      missed_[s]   += other->missed_[s];
+      sumDiff_[s]  += other->sumDiff_[s];
+
+      for (uint i=0; i <= diffBins_; i++)
+         diffHist_[s*(diffBins_+1)+i] += other->diffHist_[s*(diffBins_+1)+i];
+
+      offset = s * phaseSize_;
+      for (uint i=0; i < phaseSize_; i++) phaseHist_[offset+i] += other->phaseHist_[offset+i];
+   }
+
+   // Rate series, bring this one to at least the other bin width first
+   if ( other->haveOrigin_ ) {
+      while ( rateTicks_ < other->rateTicks_ ) coarsenRate();
+      for (uint s=0; s < SourceCount; s++) {
+         for (uint i=0; i < other->rateLen_; i++) {
+            if ( other->rateHist_[s*RateBins+i] == 0 ) continue;
+            stamp = other->origin_ + i * other->rateTicks_;
+            fillRate(s,stamp,other->rateHist_[s*RateBins+i]);
+         }
+      }
+   }
+   return(true);
+}
+
+// Number of triggers
+unsigned long TriggerTiming::triggers ( uint rce, uint feb ) {
+   if ( rce >= RceCount || feb >= FebCount ) return(0);
+   return(triggers_[rce*FebCount+feb]);
+}
+
+// Deadtime estimate
+double TriggerTiming::deadtime ( uint rce, uint feb ) {
+   uint src;
+
+   if ( rce >= RceCount || feb >= FebCount ) return(0.0);
+   src = rce*FebCount+feb;
+   if ( triggers_[src] == 0 ) return(0.0);
+   return((double)missed_[src] / (double)(triggers_[src] + missed_[src]));
+}
+
+// Average rate
+double TriggerTiming::rate ( uint rce, uint feb ) {
+   uint src;
+
+   if ( rce >= RceCount || feb >= FebCount ) return(0.0);
+   src = rce*FebCount+feb;
+   if ( triggers_[src] < 2 || lastStamp_[src] <= firstStamp_[src] ) return(0.0);
+   return((double)(triggers_[src] - 1) / ((double)(lastStamp_[src] - firstStamp_[src]) * TickNs * 1.0e-9));
+}
+
+// Dump summary
+void TriggerTiming::dump ( ostream &out ) {
+   uint   offset;
+   uint   pmin;
+   uint   pmax;
+   double chi2;
+   double expect;
+   double sum;
+
+   out << "Trigger timing summary:" << endl;
+   for (uint s=0; s < SourceCount; s++) {
+      if ( triggers_[s] == 0 ) continue;
+
+      uint rce = s / FebCount;
+      uint feb = s % FebCount;
+      out << "   RCE " << setw(2) << rce << " FEB " << setw(2) << feb
+          << ": triggers " << triggers_[s]
+          << ", rate " << rate(rce,feb) << " Hz"
+          << ", min dT " << (minDiff_[s] * TickNs * 1.0e-3) << " us";
+      if ( triggers_[s] > 1 )
+         out << ", mean dT " << (sumDiff_[s] / (triggers_[s]-1) * TickNs * 1.0e-3) << " us";
+      out << ", missed " << missed_[s]
+          << ", deadtime " << (100.0 * deadtime(rce,feb)) << " %" << endl;
+
+      // Flatness of each phase histogram
+      offset = s * phaseSize_;
+      for (uint p=0; p < periodCount_; p++) {
+         sum  = 0;
+         pmin = phaseHist_[offset];
+         pmax = phaseHist_[offset];
+         for (uint i=0; i < periods_[p]; i++) {
+            uint v = phaseHist_[offset+i];
+            sum += v;
+            if ( v < pmin ) pmin = v;
+            if ( v > pmax ) pmax = v;
+         }
+         expect = sum / periods_[p];
+         chi2   = 0;
+         if ( expect > 0 ) {
+            for (uint i=0; i < periods_[p]; i++) {
+               double d = phaseHist_[offset+i] - expect;
+               chi2 += d*d/expect;
+            }
+         }
+         out << "      phase mod " << setw(4) << periods_[p]
+             << ": min " << pmin << ", max " << pmax;
+         if ( periods_[p] > 1 ) out << ", chi2/ndf " << (chi2 / (periods_[p]-1));
+         out << endl;
+         offset += periods_[p];
+      }
+   }
+}
+
+// Dump histograms
+void TriggerTiming::dumpHistograms ( ostream &out ) {
+   uint offset;
+
+   for (uint s=0; s < SourceCount; s++) {
+      if ( triggers_[s] == 0 ) continue;
+
+      uint rce = s / FebCount;
+      uint feb = s % FebCount;
+
+      // Inter-trigger time, last bin is overflow
+      out << "dT\t" << rce << "\t" << feb << "\t" << (diffMaxUs_ / diffBins_);
+      for (uint i=0; i <= diffBins_; i++) out << "\t" << diffHist_[s*(diffBins_+1)+i];
+      out << endl;
+
+      offset = s * phaseSize_;
+      for (uint p=0; p < periodCount_; p++) {
+         out << "phase\t" << rce << "\t" << feb << "\t" << periods_[p];
+         for (uint i=0; i < periods_[p]; i++) out << "\t" << phaseHist_[offset+i];
+         out << endl;
+         offset += periods_[p];
+      }
+
+      // Rate series, counts per bin
+      out << "rate\t" << rce << "\t" << feb << "\t" << (rateTicks_ * TickNs * 1.0e-9);
+      for (uint i=0; i < rateLen_; i++) out << "\t" << rateHist_[s*RateBins+i];
+      out << endl;
+   }
+}
@@ -0,0 +1,148 @@
+//-----------------------------------------------------------------------------
+// File          : TriggerTiming.h
+// Created       : 10/19/2026
+// Project       : Heavy Photon API
+//-----------------------------------------------------------------------------
+// Description :
+// Streaming trigger timing accumulator. Fed one TiTriggerEvent (RCE bank) at
+// a time, keeps for every RCE/FEB seen in the data:
+//    - inter-trigger time distribution
+//    - TI timestamp phase histograms modulo any number of clock periods
+//    - trigger rate time series
+//    - TI event numbers that never showed up, as a deadtime estimate
+//
+// Memory is fixed at construction. The rate series keeps a fixed number of
+// bins and doubles the bin width when the run outgrows it.
+//
+// An accumulator is owned by one thread and never locked. To process several
+// inputs in parallel give each thread its own accumulator (constructed with
+// the same settings) and merge() them when done.
+//
+// TI timestamps count 4 ns clock ticks.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2011 by SLAC. All rights reserved.
+// Proprietary and confidential to SLAC.
+//-----------------------------------------------------------------------------
+// Modification history :
+// 10/19/2026: created
+//-----------------------------------------------------------------------------
+#ifndef __TRIGGER_TIMING_H__
+#define __TRIGGER_TIMING_H__
+
+#include <iostream>
+#include <sys/types.h>
+#include "TiTriggerEvent.h"
+#include "TriggerSample.h"
+using namespace std;
+
+//! Trigger timing accumulator for all RCEs/FEBs
+class TriggerTiming {
+
+   public:
+
+      // Constants
+      static const uint RceCount    = 16;
+      static const uint FebCount    = 16;
+      static const uint SourceCount = RceCount * FebCount;
+      static const uint MaxPeriods  = 16;
+      static const uint RateBins    = 1024;
+
+      //! TI clock tick in ns
+      static const double TickNs;
+
+   private:
+
+      // Settings
+      double diffMaxUs_;
+      uint   diffBins_;
+      uint   periodCount_;
+      uint   periods_[MaxPeriods];
+      uint   phaseSize_;
+
+      // Rate series binning, shared by all sources
+      bool          haveOrigin_;
+      unsigned long origin_;
+      unsigned long rateTicks_;
+      unsigned long baseTicks_;
+      uint          rateLen_;
+
+      // Per source state
+      unsigned long triggers_[SourceCount];
+      unsigned long missed_[SourceCount];
+      unsigned long firstStamp_[SourceCount];
+      unsigned long lastStamp_[SourceCount];
+      unsigned long lastTiNumber_[SourceCount];
+      unsigned long minDiff_[SourceCount];
+      double        sumDiff_[SourceCount];
+
+      // Per source histograms, flat arrays indexed by source
+      uint *diffHist_;
+      uint *phaseHist_;
+      uint *rateHist_;
+
+      // Sample decoder
+      TriggerSample sample_;
+
+      // Update one source with a trigger
+      void fill ( uint src, unsigned long tiNumber, unsigned long stamp );
+
+      // Fill the rate series, coarsening if needed
+      void fillRate ( uint src, unsigned long stamp, uint count );
+
+      // Double the rate bin width
+      void coarsenRate ( );
+
+   public:
+
+      //! Constructor
+      /*!
+       * \param diffMaxUs Range of the inter-trigger time histogram in us
+       * \param diffBins Number of inter-trigger time bins, plus one overflow bin
+       * \param rateSec Initial width of the rate series bins in s
+      */
+      TriggerTiming ( double diffMaxUs = 100.0, uint diffBins = 100, double rateSec = 1.0 );
+
+      //! Deconstructor
+      ~TriggerTiming ( );
+
+      //! Add a phase histogram
+      /*!
+       * The new histogram starts empty, the others keep their contents.
+       * Returns false if too many periods were added
+       * \param ticks Period in TI clock ticks
+      */
+      bool addPeriod ( uint ticks );
+
+      //! Clear all accumulated data, keeps settings
+      void clear ( );
+
+      //! Process one RCE bank
+      /*!
+       * \param event Bank with TI data appended
+      */
+      void process ( TiTriggerEvent *event );
+
+      //! Add the contents of another accumulator with the same settings
+      /*!
+       * Returns false if the settings differ
+       * \param other Accumulator to merge in
+      */
+      bool merge ( TriggerTiming *other );
+
+      //! Number of triggers seen by a RCE/FEB
+      unsigned long triggers ( uint rce, uint feb );
+
+      //! Deadtime estimate for a RCE/FEB, fraction of TI events not seen
+      double deadtime ( uint rce, uint feb );
+
+      //! Average trigger rate for a RCE/FEB in Hz
+      double rate ( uint rce, uint feb );
+
+      //! Dump per RCE/FEB summary
+      void dump ( ostream &out=cout );
+
+      //! Dump histograms and rate series as tab separated text
+      void dumpHistograms ( ostream &out );
+};
+
+#endif